@@ -15,6 +15,7 @@
 #include "AudioCommon/PulseAudioStream.h"
 #include "AudioCommon/WASAPIStream.h"
 #include "Common/Common.h"
+#include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Core/Config/MainSettings.h"
@@ -27,6 +28,8 @@ namespace AudioCommon
 {
 static bool s_audio_dump_start = false;
 static bool s_sound_stream_running = false;
+// Read on every buffer sent to the mixer
+static Config::CachedInfo<bool> s_dump_audio{Config::MAIN_DUMP_AUDIO};
 
 constexpr int AUDIO_VOLUME_MIN = 0;
 constexpr int AUDIO_VOLUME_MAX = 100;
@@ -191,9 +194,10 @@ void SendAIBuffer(const short* samples, unsigned int num_samples)
   if (!g_sound_stream)
     return;
 
-  if (Config::Get(Config::MAIN_DUMP_AUDIO) && !s_audio_dump_start)
+  const bool dump_audio = s_dump_audio.Get();
+  if (dump_audio && !s_audio_dump_start)
     StartAudioDump();
-  else if (!Config::Get(Config::MAIN_DUMP_AUDIO) && s_audio_dump_start)
+  else if (!dump_audio && s_audio_dump_start)
     StopAudioDump();
 
   Mixer* pMixer = g_sound_stream->GetMixer();
@@ -12,6 +12,37 @@
 
 namespace AudioCommon
 {
+namespace
+{
+struct StretchParameters
+{
+  int sequence_ms;
+  int seek_window_ms;
+  int overlap_ms;
+  bool quick_seek;
+};
+
+// SoundTouch's defaults, which pick the sequence and seek window lengths from the tempo
+constexpr StretchParameters DEFAULT_PARAMETERS{0, 0, 8, false};
+
+// SoundTouch holds on to about a sequence and a seek window of audio, so the low latency mode
+// uses much shorter ones. The faster the audio plays, the shorter the sequences can get without
+// sounding choppy.
+struct SpeedBand
+{
+  double max_ratio;
+  StretchParameters parameters;
+};
+constexpr std::array<SpeedBand, 3> LOW_LATENCY_BANDS{{
+    {0.8, {30, 12, 6, true}},
+    {1.25, {20, 8, 4, true}},
+    {HUGE_VAL, {15, 6, 4, true}},
+}};
+
+// How far the ratio has to leave a band before switching, as changing the parameters is audible
+constexpr double BAND_HYSTERESIS = 0.05;
+}  // namespace
+
 AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_rate)
 {
   m_sound_touch.setChannels(2);
@@ -23,6 +54,43 @@ AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_
 void AudioStretcher::Clear()
 {
   m_sound_touch.clear();
+  m_buffered_latency.store(0.0, std::memory_order_relaxed);
+}
+
+void AudioStretcher::UpdateParameters(bool low_latency)
+{
+  int band = -1;
+  if (low_latency)
+  {
+    band = 0;
+    while (m_stretch_ratio > LOW_LATENCY_BANDS[band].max_ratio)
+      ++band;
+
+    // Stay in the current band until the ratio is clearly outside of it
+    if (m_band >= 0 && band != m_band)
+    {
+      const double min_ratio = m_band == 0 ? 0.0 : LOW_LATENCY_BANDS[m_band - 1].max_ratio;
+      const double max_ratio = LOW_LATENCY_BANDS[m_band].max_ratio;
+      if (m_stretch_ratio > min_ratio * (1.0 - BAND_HYSTERESIS) &&
+          m_stretch_ratio < max_ratio * (1.0 + BAND_HYSTERESIS))
+      {
+        band = m_band;
+      }
+    }
+  }
+
+  if (band == m_band)
+    return;
+
+  const StretchParameters& parameters =
+      band < 0 ? DEFAULT_PARAMETERS : LOW_LATENCY_BANDS[band].parameters;
+  m_sound_touch.setSetting(SETTING_SEQUENCE_MS, parameters.sequence_ms);
+  m_sound_touch.setSetting(SETTING_SEEKWINDOW_MS, parameters.seek_window_ms);
+  m_sound_touch.setSetting(SETTING_OVERLAP_MS, parameters.overlap_ms);
+  m_sound_touch.setSetting(SETTING_USE_QUICKSEEK, parameters.quick_seek);
+  m_band = band;
+
+  DEBUG_LOG_FMT(AUDIO, "Audio stretching: switched to speed band {}", band);
 }
 
 void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out)
@@ -56,7 +124,9 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
   // Place a lower limit of 10% speed.  When a game boots up, there will be
   // many silence samples.  These do not need to be timestretched.
   m_stretch_ratio = std::max(m_stretch_ratio, 0.1);
+  UpdateParameters(Config::Get(Config::MAIN_AUDIO_STRETCH_LOW_LATENCY));
   m_sound_touch.setTempo(m_stretch_ratio);
+  m_reported_stretch_ratio.store(m_stretch_ratio, std::memory_order_relaxed);
 
   DEBUG_LOG_FMT(AUDIO, "Audio stretching: samples:{}/{} ratio:{} backlog:{} gain: {}", num_in,
                 num_out, m_stretch_ratio, backlog_fullness, lpf_gain);
@@ -68,6 +138,10 @@ void AudioStretcher::GetStretchedSamples(short* out, unsigned int num_out)
 {
   const size_t samples_received = m_sound_touch.receiveSamples(out, num_out);
 
+  const unsigned int buffered_samples =
+      m_sound_touch.numSamples() + m_sound_touch.numUnprocessedSamples();
+  m_buffered_latency.store(buffered_samples * 1000.0 / m_sample_rate, std::memory_order_relaxed);
+
   if (samples_received != 0)
   {
     m_last_stretched_sample[0] = out[samples_received * 2 - 2];
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
 #include <SoundTouch.h>
 
@@ -17,11 +18,27 @@ public:
   void GetStretchedSamples(short* out, unsigned int num_out);
   void Clear();
 
+  // How much audio SoundTouch holds on to, in milliseconds, and the tempo it plays at. These can
+  // be called from any thread.
+  double GetBufferedLatency() const { return m_buffered_latency.load(std::memory_order_relaxed); }
+  double GetStretchRatio() const
+  {
+    return m_reported_stretch_ratio.load(std::memory_order_relaxed);
+  }
+
 private:
+  void UpdateParameters(bool low_latency);
+
   unsigned int m_sample_rate;
   std::array<short, 2> m_last_stretched_sample = {};
   soundtouch::SoundTouch m_sound_touch;
   double m_stretch_ratio = 1.0;
+
+  // The speed band whose SoundTouch parameters are in use, or -1 for the default parameters
+  int m_band = -1;
+
+  std::atomic<double> m_buffered_latency{0.0};
+  std::atomic<double> m_reported_stretch_ratio{1.0};
 };
 
 }  // namespace AudioCommon
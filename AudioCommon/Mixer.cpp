@@ -4,12 +4,15 @@
 #include "AudioCommon/Mixer.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 
 #include "AudioCommon/Enums.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -68,9 +71,9 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // The writing pointer will be modified outside, but it will only increase,
   // so we will just ignore new written data while interpolating.
   // Without this cache, the compiler wouldn't be allowed to optimize the
-  // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
+  // interpolation loop. Acquiring the write index makes the samples before it visible.
+  u32 indexR = m_indexR.load(std::memory_order_relaxed);
+  const u32 indexW = m_indexW.load(std::memory_order_acquire);
 
   // render numleft sample pairs to samples[]
   // advance indexR with sample position
@@ -96,37 +99,122 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
   const u32 ratio = (u32)(65536.0f * aid_sample_rate / (float)m_mixer->m_sampleRate);
 
-  s32 lvolume = m_LVolume.load();
-  s32 rvolume = m_RVolume.load();
+  const s32 lvolume = m_LVolume.load();
+  const s32 rvolume = m_RVolume.load();
 
   const auto read_buffer = [this](auto index) {
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
+  // Each output sample is interpolated between the input sample at <frame>, counted from indexR,
+  // and the one after it. Stop before reaching the last input sample, so that there is always a
+  // next one.
+  const u32 available_frames = ((indexW - indexR) & INDEX_MASK) / 2;
+  u32 frame = 0;
+  u32 frac = m_frac;
+
   // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+#ifdef _M_X86
+  const __m128i volumes = _mm_setr_epi16(rvolume, lvolume, rvolume, lvolume, rvolume, lvolume,
+                                         rvolume, lvolume);
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  const __m128i zero = _mm_setzero_si128();
+  while (currentSample + 8 <= numSamples * 2)
+  {
+    // Read four pairs of stereo samples, and their fractional positions, at a time. A pair never
+    // wraps around the end of the buffer.
+    if (frame + static_cast<u32>((frac + u64(ratio) * 3) >> 16) + 2 > available_frames)
+      break;
+
+    std::array<u32, 4> current;
+    std::array<u32, 4> next;
+    std::array<u16, 8> fracs;
+    u64 position = frac;
+    for (u32 i = 0; i < 4; ++i, position += ratio)
+    {
+      const u32 index = indexR + (frame + static_cast<u32>(position >> 16)) * 2;
+      std::memcpy(&current[i], &m_buffer[index & INDEX_MASK], sizeof(u32));
+      std::memcpy(&next[i], &m_buffer[(index + 2) & INDEX_MASK], sizeof(u32));
+      fracs[i * 2] = fracs[i * 2 + 1] = static_cast<u16>(position);
+    }
+
+    // The input is stored left first, the output right first
+    __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current.data()));
+    __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(next.data()));
+    s1 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s1, 0xB1), 0xB1);
+    s2 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s2, 0xB1), 0xB1);
+    if (!m_little_endian)
+    {
+      s1 = _mm_or_si128(_mm_slli_epi16(s1, 8), _mm_srli_epi16(s1, 8));
+      s2 = _mm_or_si128(_mm_slli_epi16(s2, 8), _mm_srli_epi16(s2, 8));
+    }
+
+    // ((s1 << 16) + (s2 - s1) * frac) >> 16, with the products of the samples and the unsigned
+    // fractions done as 32-bit. The signed high halves are short by the sample wherever the top
+    // bit of the fraction is set.
+    const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(fracs.data()));
+    const __m128i f_sign = _mm_srai_epi16(f, 15);
+    const __m128i s1f_lo = _mm_mullo_epi16(s1, f);
+    const __m128i s1f_hi = _mm_add_epi16(_mm_mulhi_epi16(s1, f), _mm_and_si128(s1, f_sign));
+    const __m128i s2f_lo = _mm_mullo_epi16(s2, f);
+    const __m128i s2f_hi = _mm_add_epi16(_mm_mulhi_epi16(s2, f), _mm_and_si128(s2, f_sign));
+    const __m128i delta_lo = _mm_sub_epi32(_mm_unpacklo_epi16(s2f_lo, s2f_hi),
+                                           _mm_unpacklo_epi16(s1f_lo, s1f_hi));
+    const __m128i delta_hi = _mm_sub_epi32(_mm_unpackhi_epi16(s2f_lo, s2f_hi),
+                                           _mm_unpackhi_epi16(s1f_lo, s1f_hi));
+    const __m128i interpolated_lo =
+        _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(zero, s1), delta_lo), 16);
+    const __m128i interpolated_hi =
+        _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(zero, s1), delta_hi), 16);
+
+    // The interpolated samples are between the two input samples, so they fit in 16 bits
+    const __m128i interpolated = _mm_packs_epi32(interpolated_lo, interpolated_hi);
+    const __m128i scaled_lo = _mm_mullo_epi16(interpolated, volumes);
+    const __m128i scaled_hi = _mm_mulhi_epi16(interpolated, volumes);
+    __m128i* const dest = reinterpret_cast<__m128i*>(&samples[currentSample]);
+    const __m128i mixed = _mm_loadu_si128(dest);
+    const __m128i result_lo =
+        _mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(scaled_lo, scaled_hi), 8),
+                      _mm_srai_epi32(_mm_unpacklo_epi16(mixed, mixed), 16));
+    const __m128i result_hi =
+        _mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(scaled_lo, scaled_hi), 8),
+                      _mm_srai_epi32(_mm_unpackhi_epi16(mixed, mixed), 16));
+    _mm_storeu_si128(dest, _mm_max_epi16(_mm_packs_epi32(result_lo, result_hi), min_sample));
+
+    currentSample += 8;
+    frame += static_cast<u32>(position >> 16);
+    frac = static_cast<u32>(position & 0xffff);
+  }
+#endif
+
+  for (; currentSample < numSamples * 2 && frame + 2 <= available_frames; currentSample += 2)
   {
-    u32 indexR2 = indexR + 2;  // next sample
+    const u32 index = indexR + frame * 2;
 
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
+    s16 l1 = read_buffer(index & INDEX_MASK);        // current
+    s16 l2 = read_buffer((index + 2) & INDEX_MASK);  // next
+    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)frac) >> 16;
     sampleL = (sampleL * lvolume) >> 8;
     sampleL += samples[currentSample + 1];
     samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
 
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
+    s16 r1 = read_buffer((index + 1) & INDEX_MASK);  // current
+    s16 r2 = read_buffer((index + 3) & INDEX_MASK);  // next
+    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)frac) >> 16;
     sampleR = (sampleR * rvolume) >> 8;
     sampleR += samples[currentSample];
     samples[currentSample] = std::clamp(sampleR, -32767, 32767);
 
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    frac += ratio;
+    frame += frac >> 16;
+    frac &= 0xffff;
   }
 
+  // A large ratio can step past the samples that have been written. Don't let the read index
+  // pass the write index, which would make the FIFO look full.
+  indexR += std::min(frame, available_frames) * 2;
+  m_frac = frac;
+
   // Actual number of samples written to the buffer without padding.
   unsigned int actual_sample_count = currentSample / 2;
 
@@ -145,8 +233,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     samples[currentSample + 1] = sampleL;
   }
 
-  // Flush cached variable
-  m_indexR.store(indexR);
+  // Flush cached variable. Releasing it lets PushSamples reuse the space that was read.
+  m_indexR.store(indexR, std::memory_order_release);
 
   return actual_sample_count;
 }
@@ -156,6 +244,8 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   if (!samples)
     return 0;
 
+  const auto start_time = std::chrono::steady_clock::now();
+
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
   const float emulation_speed = m_config_emulation_speed;
@@ -194,12 +284,36 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     for (auto& mixer : m_gba_mixers)
       mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    if (m_is_stretching)
+      m_stretcher.Clear();
     m_is_stretching = false;
   }
 
+  const u64 mix_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start_time)
+                         .count();
+  m_mix_calls.fetch_add(1, std::memory_order_relaxed);
+  m_mix_total_ns.fetch_add(mix_ns, std::memory_order_relaxed);
+  if (mix_ns > m_mix_max_ns.load(std::memory_order_relaxed))
+    m_mix_max_ns.store(mix_ns, std::memory_order_relaxed);
+
   return num_samples;
 }
 
+Mixer::MixTimingStats Mixer::GetMixTimingStats() const
+{
+  return {m_mix_calls.load(std::memory_order_relaxed),
+          m_mix_total_ns.load(std::memory_order_relaxed),
+          m_mix_max_ns.load(std::memory_order_relaxed)};
+}
+
+void Mixer::ResetMixTimingStats()
+{
+  m_mix_calls.store(0, std::memory_order_relaxed);
+  m_mix_total_ns.store(0, std::memory_order_relaxed);
+  m_mix_max_ns.store(0, std::memory_order_relaxed);
+}
+
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 {
   if (!num_samples)
@@ -229,11 +343,12 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
   // Cache access in non-volatile variable
   // indexR isn't allowed to cache in the audio throttling loop as it
   // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
+  u32 indexW = m_indexW.load(std::memory_order_relaxed);
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  if (num_samples * 2 + ((indexW - m_indexR.load(std::memory_order_acquire)) & INDEX_MASK) >=
+      MAX_SAMPLES * 2)
     return;
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
@@ -250,7 +365,7 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
     memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
   }
 
-  m_indexW.fetch_add(num_samples * 2);
+  m_indexW.store(indexW + num_samples * 2, std::memory_order_release);
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
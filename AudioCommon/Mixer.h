@@ -16,6 +16,14 @@ class PointerWrap;
 class Mixer final
 {
 public:
+  // How long the audio callbacks spent in Mix, to find what makes them miss their deadline.
+  struct MixTimingStats
+  {
+    u64 calls;
+    u64 total_ns;
+    u64 max_ns;
+  };
+
   explicit Mixer(unsigned int BackendSampleRate);
   ~Mixer();
 
@@ -48,6 +56,12 @@ public:
   void StartLogDSPAudio(const std::string& filename);
   void StopLogDSPAudio();
 
+  MixTimingStats GetMixTimingStats() const;
+  void ResetMixTimingStats();
+
+  // The latency added by audio stretching, in milliseconds, or 0 when it's off
+  double GetStretchLatency() const { return m_stretcher.GetBufferedLatency(); }
+
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
 
@@ -114,6 +128,10 @@ private:
   // Current rate of emulation (1.0 = 100% speed)
   std::atomic<float> m_speed{0.0f};
 
+  std::atomic<u64> m_mix_calls{0};
+  std::atomic<u64> m_mix_total_ns{0};
+  std::atomic<u64> m_mix_max_ns{0};
+
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
@@ -4,13 +4,38 @@
 #include "AudioCommon/SurroundDecoder.h"
 
 #include <FreeSurround/FreeSurroundDecoder.h>
+#include <algorithm>
+#include <cstring>
 #include <limits>
 
+#include "Common/Intrinsics.h"
+
 namespace AudioCommon
 {
 constexpr size_t STEREO_CHANNELS = 2;
 constexpr size_t SURROUND_CHANNELS = 6;
 
+static void ConvertToFloat(const short* in, float* out, size_t count)
+{
+  constexpr float scale = static_cast<float>(std::numeric_limits<short>::max());
+
+  size_t i = 0;
+#ifdef _M_X86
+  const __m128 divisor = _mm_set1_ps(scale);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    _mm_store_ps(out + i, _mm_div_ps(_mm_cvtepi32_ps(lo), divisor));
+    _mm_store_ps(out + i + 4, _mm_div_ps(_mm_cvtepi32_ps(hi), divisor));
+  }
+#endif
+
+  for (; i < count; ++i)
+    out[i] = in[i] / scale;
+}
+
 SurroundDecoder::SurroundDecoder(u32 sample_rate, u32 frame_block_size)
     : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size)
 {
@@ -23,17 +48,21 @@ SurroundDecoder::~SurroundDecoder() = default;
 void SurroundDecoder::Clear()
 {
   m_fsdecoder->flush();
-  m_decoded_fifo.clear();
+  m_pending_frames = 0;
+  m_decoded_sample_count = 0;
 }
 
 // Currently only 6 channels are supported.
 size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_frames) const
 {
-  if (m_decoded_fifo.size() < output_frames * SURROUND_CHANNELS)
+  if (m_decoded_sample_count < output_frames * SURROUND_CHANNELS)
   {
-    // Output stereo frames needed to have at least the desired number of surround frames
-    size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
-    return frames_needed + m_frame_block_size - frames_needed % m_frame_block_size;
+    // Output stereo frames needed to have at least the desired number of surround frames. The
+    // frames that are waiting for a block to fill up count towards it.
+    size_t frames_needed =
+        output_frames - m_decoded_sample_count / SURROUND_CHANNELS + m_pending_frames;
+    frames_needed += m_frame_block_size - frames_needed % m_frame_block_size;
+    return frames_needed - m_pending_frames;
   }
 
   return 0;
@@ -42,51 +71,65 @@ size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_f
 // Receive and decode samples
 void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
 {
-  // Maybe check if it is really power-of-2?
-  s64 remaining_frames = static_cast<s64>(num_frames_in);
-  size_t frame_index = 0;
-
+  // Each call can decode any number of blocks. Frames that don't fill a block are kept until
+  // the next call.
+  size_t remaining_frames = num_frames_in;
   while (remaining_frames > 0)
   {
-    // Convert to float
-    for (size_t i = 0, end = m_frame_block_size * STEREO_CHANNELS; i < end; ++i)
-    {
-      m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] /
-                                     static_cast<float>(std::numeric_limits<short>::max());
-    }
+    const size_t frames = std::min<size_t>(remaining_frames, m_frame_block_size - m_pending_frames);
+    ConvertToFloat(in, &m_float_conversion_buffer[m_pending_frames * STEREO_CHANNELS],
+                   frames * STEREO_CHANNELS);
+    in += frames * STEREO_CHANNELS;
+    remaining_frames -= frames;
+    m_pending_frames += frames;
+    if (m_pending_frames < m_frame_block_size)
+      break;
+    m_pending_frames = 0;
 
     // Decode
     const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
 
-    // Add to ring buffer and fix channel mapping
+    // Drop the oldest samples if the output isn't being read fast enough
+    const size_t block_samples = m_frame_block_size * SURROUND_CHANNELS;
+    if (m_decoded_sample_count + block_samples > m_decoded_samples.size())
+    {
+      const size_t dropped = m_decoded_sample_count + block_samples - m_decoded_samples.size();
+      std::memmove(m_decoded_samples.data(), m_decoded_samples.data() + dropped,
+                   (m_decoded_sample_count - dropped) * sizeof(float));
+      m_decoded_sample_count -= dropped;
+    }
+
+    // Add to the decoded samples and fix channel mapping
     // Maybe modify FreeSurround to output the correct mapping?
     // FreeSurround:
     // FL | FC | FR | BL | BR | LFE
     // Most backends:
     // FL | FR | FC | LFE | BL | BR
+    float* out = &m_decoded_samples[m_decoded_sample_count];
     for (size_t i = 0; i < m_frame_block_size; ++i)
     {
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 0]);  // LEFTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 2]);  // RIGHTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 1]);  // CENTREFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 5]);  // sub/lfe
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 3]);  // LEFTREAR
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 4]);  // RIGHTREAR
+      out[i * SURROUND_CHANNELS + 0] = dpl2_fs[i * SURROUND_CHANNELS + 0];  // LEFTFRONT
+      out[i * SURROUND_CHANNELS + 1] = dpl2_fs[i * SURROUND_CHANNELS + 2];  // RIGHTFRONT
+      out[i * SURROUND_CHANNELS + 2] = dpl2_fs[i * SURROUND_CHANNELS + 1];  // CENTREFRONT
+      out[i * SURROUND_CHANNELS + 3] = dpl2_fs[i * SURROUND_CHANNELS + 5];  // sub/lfe
+      out[i * SURROUND_CHANNELS + 4] = dpl2_fs[i * SURROUND_CHANNELS + 3];  // LEFTREAR
+      out[i * SURROUND_CHANNELS + 5] = dpl2_fs[i * SURROUND_CHANNELS + 4];  // RIGHTREAR
     }
-
-    remaining_frames = remaining_frames - static_cast<int>(m_frame_block_size);
-    frame_index = frame_index + m_frame_block_size;
+    m_decoded_sample_count += block_samples;
   }
 }
 
 void SurroundDecoder::ReceiveFrames(float* out, const size_t num_frames_out)
 {
-  // Copy to output array with desired num_frames_out
-  for (size_t i = 0, num_samples_output = num_frames_out * SURROUND_CHANNELS;
-       i < num_samples_output; ++i)
-  {
-    out[i] = m_decoded_fifo.pop_front();
-  }
+  // Copy to output array with desired num_frames_out, and pad with silence if there isn't enough
+  const size_t num_samples_output = num_frames_out * SURROUND_CHANNELS;
+  const size_t num_samples_copied = std::min(num_samples_output, m_decoded_sample_count);
+  std::memcpy(out, m_decoded_samples.data(), num_samples_copied * sizeof(float));
+  std::fill(out + num_samples_copied, out + num_samples_output, 0.0f);
+
+  m_decoded_sample_count -= num_samples_copied;
+  std::memmove(m_decoded_samples.data(), m_decoded_samples.data() + num_samples_copied,
+               m_decoded_sample_count * sizeof(float));
 }
 
 }  // namespace AudioCommon
@@ -7,7 +7,6 @@
 #include <memory>
 
 #include "Common/CommonTypes.h"
-#include "Common/FixedSizeQueue.h"
 
 class DPL2FSDecoder;
 
@@ -28,8 +27,14 @@ private:
   u32 m_frame_block_size;
 
   std::unique_ptr<DPL2FSDecoder> m_fsdecoder;
-  std::array<float, 32768> m_float_conversion_buffer;
-  FixedSizeQueue<float, 32768> m_decoded_fifo;
+
+  // The stereo input of the block that is being filled, and how many frames of it are there
+  alignas(16) std::array<float, 32768> m_float_conversion_buffer;
+  size_t m_pending_frames = 0;
+
+  // Decoded samples that haven't been received yet, oldest first
+  std::array<float, 32768> m_decoded_samples;
+  size_t m_decoded_sample_count = 0;
 };
 
 }  // namespace AudioCommon
@@ -0,0 +1,75 @@
+# Runs the perf-regress campaign: generates MUTANTS mutants of CARD, diffed against OTHER_CARD,
+# and then runs as many in ISO for FRAMES frames each, all from SEED. Each campaign writes its
+# stage timings with --stats and its spans with --trace, and the timings of both end up in
+# OUTPUT_DIR/summary.json, so runs on different commits can be compared on the same inputs.
+#
+# Invoked with cmake -P by the perf-regress target, which passes all of the above along with
+# SMASHCARDLOADER, the binary to run, SOURCE_DIR and TRACING.
+
+foreach(var SMASHCARDLOADER CARD OTHER_CARD SEED MUTANTS FRAMES OUTPUT_DIR)
+  if(NOT DEFINED ${var} OR "${${var}}" STREQUAL "")
+    message(FATAL_ERROR "perf-regress needs ${var}; set PERF_REGRESS_CARD and "
+        "PERF_REGRESS_OTHER_CARD when configuring")
+  endif()
+endforeach()
+if(NOT TRACING)
+  message(WARNING "Configured without ENABLE_TRACING, the traces will be empty")
+endif()
+
+file(REMOVE_RECURSE "${OUTPUT_DIR}")
+file(MAKE_DIRECTORY "${OUTPUT_DIR}/generate" "${OUTPUT_DIR}/run" "${OUTPUT_DIR}/user")
+
+# Runs one campaign, leaving its timings in OUTPUT_DIR/<name>-stats.json
+function(run_campaign name)
+  message(STATUS "perf-regress: ${name} campaign")
+  execute_process(
+    COMMAND "${SMASHCARDLOADER}" "${CARD}" "${OTHER_CARD}"
+        --count ${MUTANTS} --seed ${SEED} --output-pattern "${OUTPUT_DIR}/${name}/mutant-%d.raw"
+        --stats "${OUTPUT_DIR}/${name}-stats.json" --trace "${OUTPUT_DIR}/${name}-trace.json"
+        ${ARGN}
+    OUTPUT_FILE "${OUTPUT_DIR}/${name}.log"
+    ERROR_FILE "${OUTPUT_DIR}/${name}.log"
+    RESULT_VARIABLE result)
+  # The harness exits with how the last mutant fared, which isn't a failure of the campaign
+  if(NOT EXISTS "${OUTPUT_DIR}/${name}-stats.json")
+    message(FATAL_ERROR "perf-regress: ${name} campaign failed (${result}), "
+        "see ${OUTPUT_DIR}/${name}.log")
+  endif()
+endfunction()
+
+run_campaign(generate)
+file(READ "${OUTPUT_DIR}/generate-stats.json" generate_stats)
+set(run_stats "null")
+if(ISO)
+  run_campaign(run --run "${ISO}" --frames ${FRAMES} --user "${OUTPUT_DIR}/user")
+  file(READ "${OUTPUT_DIR}/run-stats.json" run_stats)
+else()
+  message(STATUS "perf-regress: no PERF_REGRESS_ISO, skipping the run campaign")
+endif()
+
+set(commit "unknown")
+find_package(Git QUIET)
+if(GIT_FOUND)
+  execute_process(COMMAND "${GIT_EXECUTABLE}" rev-parse HEAD
+    WORKING_DIRECTORY "${SOURCE_DIR}"
+    OUTPUT_VARIABLE commit
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET)
+endif()
+
+set(summary "{}")
+string(JSON summary SET "${summary}" commit "\"${commit}\"")
+string(JSON summary SET "${summary}" seed "${SEED}")
+string(JSON summary SET "${summary}" mutants "${MUTANTS}")
+string(JSON summary SET "${summary}" frames "${FRAMES}")
+string(JSON summary SET "${summary}" generate "${generate_stats}")
+string(JSON summary SET "${summary}" run "${run_stats}")
+file(WRITE "${OUTPUT_DIR}/summary.json" "${summary}\n")
+
+string(JSON generate_rate GET "${generate_stats}" executions_per_second)
+message(STATUS "perf-regress: generated ${generate_rate} mutants per second")
+if(ISO)
+  string(JSON run_rate GET "${run_stats}" executions_per_second)
+  message(STATUS "perf-regress: ran ${run_rate} mutants per second")
+endif()
+message(STATUS "perf-regress: summary written to ${OUTPUT_DIR}/summary.json")
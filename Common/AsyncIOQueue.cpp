@@ -0,0 +1,97 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/AsyncIOQueue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Common/IOFile.h"
+#include "Common/Thread.h"
+
+namespace File
+{
+AsyncIOQueue::AsyncIOQueue(u32 thread_count)
+{
+  for (u32 i = 0; i < std::max(thread_count, 1u); ++i)
+    m_workers.emplace_back(&AsyncIOQueue::WorkerLoop, this);
+}
+
+AsyncIOQueue::~AsyncIOQueue()
+{
+  Wait();
+  {
+    std::lock_guard lk(m_mutex);
+    m_exiting = true;
+  }
+  m_request_available.notify_all();
+  for (std::thread& worker : m_workers)
+    worker.join();
+}
+
+void AsyncIOQueue::SubmitRead(IOFile& file, u64 offset, void* data, size_t size,
+                              Callback callback)
+{
+  std::vector<Request> requests;
+  requests.push_back({&file, offset, data, size, false, std::move(callback)});
+  Submit(std::move(requests));
+}
+
+void AsyncIOQueue::SubmitWrite(IOFile& file, u64 offset, const void* data, size_t size,
+                               Callback callback)
+{
+  std::vector<Request> requests;
+  requests.push_back({&file, offset, const_cast<void*>(data), size, true, std::move(callback)});
+  Submit(std::move(requests));
+}
+
+void AsyncIOQueue::Submit(std::vector<Request> requests)
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_outstanding += requests.size();
+    for (Request& request : requests)
+      m_requests.push_back(std::move(request));
+  }
+  if (requests.size() == 1)
+    m_request_available.notify_one();
+  else
+    m_request_available.notify_all();
+}
+
+bool AsyncIOQueue::Wait()
+{
+  std::unique_lock lk(m_mutex);
+  m_idle.wait(lk, [this] { return m_outstanding == 0; });
+  return !std::exchange(m_failed, false);
+}
+
+void AsyncIOQueue::WorkerLoop()
+{
+  Common::SetCurrentThreadName("Async I/O");
+  Common::PlaceCurrentThread(Common::ThreadRole::IO);
+
+  std::unique_lock lk(m_mutex);
+  while (true)
+  {
+    m_request_available.wait(lk, [this] { return m_exiting || !m_requests.empty(); });
+    if (m_requests.empty())
+      return;
+
+    Request request = std::move(m_requests.front());
+    m_requests.pop_front();
+    lk.unlock();
+
+    const bool success = request.write ?
+                             request.file->WriteAt(request.data, request.size, request.offset) :
+                             request.file->ReadAt(request.data, request.size, request.offset);
+    if (request.callback)
+      request.callback(success);
+
+    lk.lock();
+    m_failed |= !success;
+    if (--m_outstanding == 0)
+      m_idle.notify_all();
+  }
+}
+}  // namespace File
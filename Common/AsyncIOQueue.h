@@ -0,0 +1,66 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+
+// Runs positional reads and writes on worker threads, so the submitting thread can keep computing
+// while they complete. With a single worker, requests complete in the order they were submitted.
+class AsyncIOQueue
+{
+public:
+  // Called on a worker thread once a request completes.
+  using Callback = std::function<void(bool success)>;
+
+  struct Request
+  {
+    IOFile* file;
+    u64 offset;
+    void* data;
+    size_t size;
+    bool write;
+    Callback callback;
+  };
+
+  explicit AsyncIOQueue(u32 thread_count = 1);
+  ~AsyncIOQueue();
+
+  AsyncIOQueue(const AsyncIOQueue&) = delete;
+  AsyncIOQueue& operator=(const AsyncIOQueue&) = delete;
+
+  // The buffer has to stay valid until the request's callback was called.
+  void SubmitRead(IOFile& file, u64 offset, void* data, size_t size, Callback callback = {});
+  void SubmitWrite(IOFile& file, u64 offset, const void* data, size_t size,
+                   Callback callback = {});
+  void Submit(std::vector<Request> requests);
+
+  // Blocks until every submitted request has completed. Returns false if any request failed since
+  // the last call.
+  bool Wait();
+
+private:
+  void WorkerLoop();
+
+  std::mutex m_mutex;
+  std::condition_variable m_request_available;
+  std::condition_variable m_idle;
+  std::deque<Request> m_requests;
+  size_t m_outstanding = 0;
+  bool m_failed = false;
+  bool m_exiting = false;
+  std::vector<std::thread> m_workers;
+};
+}  // namespace File
@@ -12,6 +12,7 @@
 // - Zero backwards/forwards compatibility
 // - Serialization code for anything complex has to be manually written.
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
@@ -50,6 +51,7 @@ private:
   u8** m_ptr_current;
   u8* m_ptr_end;
   Mode m_mode;
+  std::vector<u8>* m_growable = nullptr;
 
 public:
   PointerWrap(u8** ptr, size_t size, Mode mode)
@@ -57,6 +59,16 @@ public:
   {
   }
 
+  // Writes into buffer from its start in a single pass, growing it whenever it runs out of space,
+  // so nothing needs to be measured first. *ptr is kept pointing into the buffer as it moves, and
+  // the bytes written are *ptr - buffer.data() once done.
+  PointerWrap(u8** ptr, std::vector<u8>& buffer)
+      : m_ptr_current(ptr), m_mode(Mode::Write), m_growable(&buffer)
+  {
+    *ptr = buffer.data();
+    m_ptr_end = *ptr + buffer.size();
+  }
+
   void SetMeasureMode() { m_mode = Mode::Measure; }
   void SetVerifyMode() { m_mode = Mode::Verify; }
   bool IsReadMode() const { return m_mode == Mode::Read; }
@@ -219,13 +231,10 @@ public:
   [[nodiscard]] u8* DoExternal(u32& count)
   {
     Do(count);
+    if (!IsMeasureMode() && *m_ptr_current + count > m_ptr_end)
+      OnOverflow(count);
     u8* current = *m_ptr_current;
     *m_ptr_current += count;
-    if (!IsMeasureMode() && *m_ptr_current > m_ptr_end)
-    {
-      // trying to read/write past the end of the buffer, prevent this
-      SetMeasureMode();
-    }
     return current;
   }
 
@@ -333,14 +342,26 @@ private:
     DoEachElement(x, [](PointerWrap& p, typename T::value_type& elem) { p.Do(elem); });
   }
 
-  DOLPHIN_FORCE_INLINE void DoVoid(void* data, u32 size)
+  void OnOverflow(size_t size)
   {
-    if (!IsMeasureMode() && (*m_ptr_current + size) > m_ptr_end)
+    if (!m_growable || !IsWriteMode())
     {
       // trying to read/write past the end of the buffer, prevent this
       SetMeasureMode();
+      return;
     }
 
+    const size_t offset = *m_ptr_current - m_growable->data();
+    m_growable->resize(std::max(offset + size, m_growable->size() * 2));
+    *m_ptr_current = m_growable->data() + offset;
+    m_ptr_end = m_growable->data() + m_growable->size();
+  }
+
+  DOLPHIN_FORCE_INLINE void DoVoid(void* data, u32 size)
+  {
+    if (!IsMeasureMode() && (*m_ptr_current + size) > m_ptr_end)
+      OnOverflow(size);
+
     switch (m_mode)
     {
     case Mode::Read:
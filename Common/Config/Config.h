@@ -3,11 +3,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <type_traits>
 
 #include "Common/Config/ConfigInfo.h"
 #include "Common/Config/Enums.h"
@@ -80,6 +84,45 @@ T GetUncached(const Info<T>& info)
   return detail::TryParse<T>(*str).value_or(info.GetDefaultValue());
 }
 
+// Resolves a setting again only once the config has changed since it last did, so that reading
+// it costs a couple of atomic loads instead of the lock and layer lookups of Get(). Meant for
+// settings that hot paths read over and over. It only keeps a reference to the Info, so it can be
+// a static next to its users even when the Info is defined in another file.
+template <typename T>
+class CachedInfo
+{
+  static_assert(std::is_trivially_copyable_v<T>, "CachedInfo holds its value in an atomic");
+
+public:
+  explicit CachedInfo(const Info<T>& info) : m_info(info) {}
+
+  CachedInfo(const CachedInfo&) = delete;
+  CachedInfo& operator=(const CachedInfo&) = delete;
+
+  T Get() const
+  {
+    if (m_config_version.load(std::memory_order_acquire) != GetConfigVersion())
+    {
+      // Refreshes are serialized and read the version under the lock, so a thread that saw an
+      // older version can't store its value over a newer one after the newer version is published.
+      std::lock_guard lock(m_refresh_mutex);
+      const u64 config_version = GetConfigVersion();
+      if (m_config_version.load(std::memory_order_relaxed) != config_version)
+      {
+        m_value.store(Config::Get(m_info), std::memory_order_relaxed);
+        m_config_version.store(config_version, std::memory_order_release);
+      }
+    }
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  const Info<T>& m_info;
+  mutable std::mutex m_refresh_mutex;
+  mutable std::atomic<T> m_value{};
+  mutable std::atomic<u64> m_config_version{std::numeric_limits<u64>::max()};
+};
+
 template <typename T>
 T GetBase(const Info<T>& info)
 {
@@ -3,8 +3,27 @@
 
 #include "Common/Crypto/AES.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include <mbedtls/aes.h>
 
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+#if defined(_M_ARM_64) && defined(__clang__)
+#define FUNCTION_TARGET_ARM_CRYPTO [[gnu::target("aes")]]
+#elif defined(_M_ARM_64) && defined(__GNUC__)
+#define FUNCTION_TARGET_ARM_CRYPTO [[gnu::target("+crypto")]]
+#else
+#define FUNCTION_TARGET_ARM_CRYPTO
+#endif
+
 namespace Common::AES
 {
 std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode)
@@ -32,4 +51,229 @@ std::vector<u8> Encrypt(const u8* key, u8* iv, const u8* src, size_t size)
 {
   return DecryptEncrypt(key, iv, src, size, Mode::Encrypt);
 }
+
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+// AES instructions take several cycles to complete but a new one can start every cycle,
+// so this many independent buffers are enough to keep the pipeline full
+constexpr size_t INTERLEAVED_BUFFERS = 8;
+constexpr size_t ROUNDS = 10;
+
+using RoundKeys = std::array<std::array<u8, 16>, ROUNDS + 1>;
+
+static RoundKeys ExpandKey(const u8* key)
+{
+  // mbedtls stores the round keys as little endian words, which in memory is the same byte order
+  // as the AES instructions use
+  mbedtls_aes_context aes_ctx;
+  mbedtls_aes_init(&aes_ctx);
+  mbedtls_aes_setkey_enc(&aes_ctx, key, 128);
+
+  RoundKeys round_keys;
+  std::memcpy(round_keys.data(), aes_ctx.rk, sizeof(round_keys));
+
+  mbedtls_aes_free(&aes_ctx);
+  return round_keys;
+}
+
+#ifdef _M_X86_64
+// The round keys for the equivalent inverse cipher, which is what AESDEC works with
+static RoundKeys ExpandDecryptionKey(const u8* key)
+{
+  mbedtls_aes_context aes_ctx;
+  mbedtls_aes_init(&aes_ctx);
+  mbedtls_aes_setkey_dec(&aes_ctx, key, 128);
+
+  RoundKeys round_keys;
+  std::memcpy(round_keys.data(), aes_ctx.rk, sizeof(round_keys));
+
+  mbedtls_aes_free(&aes_ctx);
+  return round_keys;
+}
+#endif
+
+// Buffers that are shorter than the others in their batch keep going through the rounds once
+// they're done, but nothing is loaded into them or stored from them anymore.
+#ifdef _M_X86_64
+FUNCTION_TARGET_AES
+static void EncryptCBCMultipleHardware(const RoundKeys& round_keys, const CBCBuffer* buffers,
+                                       size_t count)
+{
+  __m128i keys[ROUNDS + 1];
+  for (size_t i = 0; i <= ROUNDS; ++i)
+    keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(round_keys[i].data()));
+
+  for (size_t first = 0; first < count; first += INTERLEAVED_BUFFERS)
+  {
+    const CBCBuffer* batch = buffers + first;
+    const size_t batch_count = std::min(INTERLEAVED_BUFFERS, count - first);
+
+    __m128i state[INTERLEAVED_BUFFERS];
+    size_t max_size = 0;
+    for (size_t i = 0; i < batch_count; ++i)
+    {
+      state[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch[i].iv));
+      max_size = std::max(max_size, batch[i].size);
+    }
+
+    for (size_t offset = 0; offset < max_size; offset += 16)
+    {
+      for (size_t i = 0; i < batch_count; ++i)
+      {
+        __m128i plaintext = _mm_setzero_si128();
+        if (offset < batch[i].size)
+          plaintext = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch[i].src + offset));
+        state[i] = _mm_xor_si128(_mm_xor_si128(state[i], plaintext), keys[0]);
+      }
+
+      for (size_t round = 1; round < ROUNDS; ++round)
+      {
+        for (size_t i = 0; i < batch_count; ++i)
+          state[i] = _mm_aesenc_si128(state[i], keys[round]);
+      }
+
+      for (size_t i = 0; i < batch_count; ++i)
+      {
+        state[i] = _mm_aesenclast_si128(state[i], keys[ROUNDS]);
+        if (offset < batch[i].size)
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(batch[i].dst + offset), state[i]);
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AES
+static void DecryptCBCHardware(const RoundKeys& round_keys, const u8* iv, const u8* src, u8* dst,
+                               size_t size)
+{
+  __m128i keys[ROUNDS + 1];
+  for (size_t i = 0; i <= ROUNDS; ++i)
+    keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(round_keys[i].data()));
+
+  __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+  size_t offset = 0;
+  for (; offset + 16 * INTERLEAVED_BUFFERS <= size; offset += 16 * INTERLEAVED_BUFFERS)
+  {
+    // All ciphertext blocks are loaded before anything is stored, for decrypting in place
+    __m128i ciphertext[INTERLEAVED_BUFFERS];
+    __m128i state[INTERLEAVED_BUFFERS];
+    for (size_t i = 0; i < INTERLEAVED_BUFFERS; ++i)
+    {
+      ciphertext[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset + 16 * i));
+      state[i] = _mm_xor_si128(ciphertext[i], keys[0]);
+    }
+
+    for (size_t round = 1; round < ROUNDS; ++round)
+    {
+      for (size_t i = 0; i < INTERLEAVED_BUFFERS; ++i)
+        state[i] = _mm_aesdec_si128(state[i], keys[round]);
+    }
+
+    for (size_t i = 0; i < INTERLEAVED_BUFFERS; ++i)
+    {
+      state[i] = _mm_xor_si128(_mm_aesdeclast_si128(state[i], keys[ROUNDS]),
+                               i == 0 ? previous : ciphertext[i - 1]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset + 16 * i), state[i]);
+    }
+    previous = ciphertext[INTERLEAVED_BUFFERS - 1];
+  }
+
+  for (; offset < size; offset += 16)
+  {
+    const __m128i ciphertext = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+    __m128i state = _mm_xor_si128(ciphertext, keys[0]);
+    for (size_t round = 1; round < ROUNDS; ++round)
+      state = _mm_aesdec_si128(state, keys[round]);
+    state = _mm_xor_si128(_mm_aesdeclast_si128(state, keys[ROUNDS]), previous);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), state);
+    previous = ciphertext;
+  }
+}
+#else
+FUNCTION_TARGET_ARM_CRYPTO
+static void EncryptCBCMultipleHardware(const RoundKeys& round_keys, const CBCBuffer* buffers,
+                                       size_t count)
+{
+  uint8x16_t keys[ROUNDS + 1];
+  for (size_t i = 0; i <= ROUNDS; ++i)
+    keys[i] = vld1q_u8(round_keys[i].data());
+
+  for (size_t first = 0; first < count; first += INTERLEAVED_BUFFERS)
+  {
+    const CBCBuffer* batch = buffers + first;
+    const size_t batch_count = std::min(INTERLEAVED_BUFFERS, count - first);
+
+    uint8x16_t state[INTERLEAVED_BUFFERS];
+    size_t max_size = 0;
+    for (size_t i = 0; i < batch_count; ++i)
+    {
+      state[i] = vld1q_u8(batch[i].iv);
+      max_size = std::max(max_size, batch[i].size);
+    }
+
+    for (size_t offset = 0; offset < max_size; offset += 16)
+    {
+      for (size_t i = 0; i < batch_count; ++i)
+      {
+        if (offset < batch[i].size)
+          state[i] = veorq_u8(state[i], vld1q_u8(batch[i].src + offset));
+      }
+
+      // AESE includes the AddRoundKey step at the start of each round rather than at the end
+      for (size_t round = 0; round < ROUNDS - 1; ++round)
+      {
+        for (size_t i = 0; i < batch_count; ++i)
+          state[i] = vaesmcq_u8(vaeseq_u8(state[i], keys[round]));
+      }
+
+      for (size_t i = 0; i < batch_count; ++i)
+      {
+        state[i] = veorq_u8(vaeseq_u8(state[i], keys[ROUNDS - 1]), keys[ROUNDS]);
+        if (offset < batch[i].size)
+          vst1q_u8(batch[i].dst + offset, state[i]);
+      }
+    }
+  }
+}
+#endif
+#endif
+
+void EncryptCBCMultiple(const u8* key, const CBCBuffer* buffers, size_t count)
+{
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+  if (cpu_info.bAES)
+  {
+    EncryptCBCMultipleHardware(ExpandKey(key), buffers, count);
+    return;
+  }
+#endif
+
+  mbedtls_aes_context aes_ctx;
+  mbedtls_aes_setkey_enc(&aes_ctx, key, 128);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    u8 iv[16];
+    std::memcpy(iv, buffers[i].iv, sizeof(iv));
+    mbedtls_aes_crypt_cbc(&aes_ctx, MBEDTLS_AES_ENCRYPT, buffers[i].size, iv, buffers[i].src,
+                          buffers[i].dst);
+  }
+}
+
+void DecryptCBC(const u8* key, const u8* iv, const u8* src, u8* dst, size_t size)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bAES)
+  {
+    DecryptCBCHardware(ExpandDecryptionKey(key), iv, src, dst, size);
+    return;
+  }
+#endif
+
+  mbedtls_aes_context aes_ctx;
+  mbedtls_aes_setkey_dec(&aes_ctx, key, 128);
+
+  u8 iv_copy[16];
+  std::memcpy(iv_copy, iv, sizeof(iv_copy));
+  mbedtls_aes_crypt_cbc(&aes_ctx, MBEDTLS_AES_DECRYPT, size, iv_copy, src, dst);
+}
 }  // namespace Common::AES
@@ -20,4 +20,24 @@ std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size
 // Convenience functions
 std::vector<u8> Decrypt(const u8* key, u8* iv, const u8* src, size_t size);
 std::vector<u8> Encrypt(const u8* key, u8* iv, const u8* src, size_t size);
+
+// One buffer to encrypt with EncryptCBCMultiple. size must be a multiple of 16.
+// src and dst may be the same, but must not overlap otherwise.
+struct CBCBuffer
+{
+  const u8* src;
+  u8* dst;
+  size_t size;
+  const u8* iv;
+};
+
+// Encrypts several independent buffers in CBC mode, using the same key for all of them.
+// Encrypting one buffer in CBC mode can't be parallelized, but with AES-NI or the ARMv8 crypto
+// extensions, the buffers are encrypted interleaved with each other to keep the AES units busy.
+void EncryptCBCMultiple(const u8* key, const CBCBuffer* buffers, size_t count);
+
+// Decrypts a buffer in CBC mode. Unlike encryption, every block can be decrypted independently,
+// so with AES-NI several of them go through the AES unit at once. size must be a multiple of 16.
+// src and dst may be the same, but must not overlap otherwise.
+void DecryptCBC(const u8* key, const u8* iv, const u8* src, u8* dst, size_t size);
 }  // namespace Common::AES
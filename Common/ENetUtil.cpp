@@ -35,4 +35,18 @@ int ENET_CALLBACK InterceptCallback(ENetHost* host, ENetEvent* event)
   }
   return 0;
 }
+
+void PacketReleaser::operator()(ENetPacket* packet) const
+{
+  if (--packet->referenceCount == 0)
+    enet_packet_destroy(packet);
+}
+
+PacketPtr CreatePacket(const void* data, size_t size, u32 flags)
+{
+  ENetPacket* packet = enet_packet_create(data, size, flags);
+  if (packet)
+    ++packet->referenceCount;
+  return PacketPtr(packet);
+}
 }  // namespace ENetUtil
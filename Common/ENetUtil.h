@@ -3,10 +3,29 @@
 //
 #pragma once
 
+#include <cstddef>
+#include <memory>
+
 #include <enet/enet.h>
 
+#include "Common/CommonTypes.h"
+
 namespace ENetUtil
 {
 void WakeupThread(ENetHost* host);
 int ENET_CALLBACK InterceptCallback(ENetHost* host, ENetEvent* event);
+
+struct PacketReleaser
+{
+  void operator()(ENetPacket* packet) const;
+};
+
+// Holds a reference to a packet. Every peer it's sent to takes a reference of its own, so one
+// packet can go to any number of peers without copying it, and it's freed once the last peer is
+// done with it and the PacketPtr is gone. Like the peers, it may only be released on the thread
+// that services the host once the packet has been sent.
+using PacketPtr = std::unique_ptr<ENetPacket, PacketReleaser>;
+
+// Leaves the data to be written by the caller if data is null
+PacketPtr CreatePacket(const void* data, size_t size, u32 flags);
 }  // namespace ENetUtil
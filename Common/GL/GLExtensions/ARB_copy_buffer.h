@@ -0,0 +1,14 @@
+/*
+** Copyright (c) 2013-2015 The Khronos Group Inc.
+** SPDX-License-Identifier: MIT
+*/
+
+#include "Common/GL/GLExtensions/gl_common.h"
+
+typedef void(APIENTRYP PFNDOLCOPYBUFFERSUBDATAPROC)(GLenum readTarget, GLenum writeTarget,
+                                                    GLintptr readOffset, GLintptr writeOffset,
+                                                    GLsizeiptr size);
+
+extern PFNDOLCOPYBUFFERSUBDATAPROC dolCopyBufferSubData;
+
+#define glCopyBufferSubData dolCopyBufferSubData
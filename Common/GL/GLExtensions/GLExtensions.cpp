@@ -961,6 +961,9 @@ PFNDOLOBJECTPTRLABELPROC dolObjectPtrLabel;
 PFNDOLPOPDEBUGGROUPPROC dolPopDebugGroup;
 PFNDOLPUSHDEBUGGROUPPROC dolPushDebugGroup;
 
+// KHR_parallel_shader_compile
+PFNDOLMAXSHADERCOMPILERTHREADSPROC dolMaxShaderCompilerThreads;
+
 // ARB_buffer_storage
 PFNDOLBUFFERSTORAGEPROC dolBufferStorage;
 
@@ -976,6 +979,9 @@ PFNDOLGETOCCLUSIONQUERYUIVNVPROC dolGetOcclusionQueryuivNV;
 // ARB_clip_control
 PFNDOLCLIPCONTROLPROC dolClipControl;
 
+// ARB_copy_buffer
+PFNDOLCOPYBUFFERSUBDATAPROC dolCopyBufferSubData;
+
 // ARB_copy_image
 PFNDOLCOPYIMAGESUBDATAPROC dolCopyImageSubData;
 
@@ -2074,6 +2080,11 @@ const GLFunc gl_function_array[] = {
     GLFUNC_REQUIRES(glPushDebugGroup,
                     "GL_KHR_debug !VERSION_GLES_3 !VERSION_GL_4_3 |VERSION_GLES_3_2"),
 
+    // KHR_parallel_shader_compile
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, KHR, "GL_KHR_parallel_shader_compile"),
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, ARB,
+                  "GL_ARB_parallel_shader_compile !GL_KHR_parallel_shader_compile"),
+
     // ARB_buffer_storage
     GLFUNC_REQUIRES(glBufferStorage, "GL_ARB_buffer_storage !VERSION_4_4"),
     GLFUNC_SUFFIX(glNamedBufferStorage, EXT,
@@ -2098,6 +2109,9 @@ const GLFunc gl_function_array[] = {
     // ARB_clip_control
     GLFUNC_REQUIRES(glClipControl, "GL_ARB_clip_control !VERSION_4_5"),
 
+    // ARB_copy_buffer
+    GLFUNC_REQUIRES(glCopyBufferSubData, "GL_ARB_copy_buffer |VERSION_GLES_3"),
+
     // ARB_copy_image
     GLFUNC_REQUIRES(glCopyImageSubData, "GL_ARB_copy_image !VERSION_4_3 |VERSION_GLES_3_2"),
 
@@ -14,6 +14,7 @@
 #include "Common/GL/GLExtensions/ARB_buffer_storage.h"
 #include "Common/GL/GLExtensions/ARB_clip_control.h"
 #include "Common/GL/GLExtensions/ARB_compute_shader.h"
+#include "Common/GL/GLExtensions/ARB_copy_buffer.h"
 #include "Common/GL/GLExtensions/ARB_copy_image.h"
 #include "Common/GL/GLExtensions/ARB_debug_output.h"
 #include "Common/GL/GLExtensions/ARB_draw_elements_base_vertex.h"
@@ -37,6 +38,7 @@
 #include "Common/GL/GLExtensions/EXT_texture_filter_anisotropic.h"
 #include "Common/GL/GLExtensions/HP_occlusion_test.h"
 #include "Common/GL/GLExtensions/KHR_debug.h"
+#include "Common/GL/GLExtensions/KHR_parallel_shader_compile.h"
 #include "Common/GL/GLExtensions/NV_depth_buffer_float.h"
 #include "Common/GL/GLExtensions/NV_occlusion_query_samples.h"
 #include "Common/GL/GLExtensions/NV_primitive_restart.h"
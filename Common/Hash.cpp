@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <xxhash.h>
 #include <zlib.h>
 
 #include "Common/BitUtils.h"
@@ -23,6 +24,7 @@
 namespace Common
 {
 static u64 (*ptrHashFunction)(const u8* src, u32 len, u32 samples) = nullptr;
+static bool s_hash64_xxh64 = false;
 
 // uint32_t
 // WARNING - may read one more byte!
@@ -508,12 +510,21 @@ static u64 GetMurmurHash3(const u8* src, u32 len, u32 samples)
 
 u64 GetHash64(const u8* src, u32 len, u32 samples)
 {
+  if (s_hash64_xxh64 && samples == 0)
+    return XXH64(src, len, 0);
   return ptrHashFunction(src, len, samples);
 }
 
+u64 HashXXH64(const u8* data, size_t length, u64 seed)
+{
+  return XXH64(data, length, seed);
+}
+
 // sets the hash function used for the texture cache
-void SetHash64Function()
+void SetHash64Function(Hash64Function function)
 {
+  s_hash64_xxh64 = function == Hash64Function::XXH64;
+
 #if defined(_M_X86_64) || defined(_M_X86)
   if (cpu_info.bSSE4_2)  // sse crc32 version
   {
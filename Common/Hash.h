@@ -10,11 +10,21 @@
 
 namespace Common
 {
+enum class Hash64Function
+{
+  // CRC32 where the host CPU has an instruction for it, MurmurHash3 otherwise.
+  Default,
+  // XXH64 for hashes of every byte: about twice as fast as MurmurHash3, and a stronger hash than
+  // the CRC32 variant, though slower than it. Sampled hashes keep using the default function.
+  XXH64,
+};
+
 u32 HashFletcher(const u8* data_u8, size_t length);  // FAST. Length & 1 == 0.
 u32 HashAdler32(const u8* data, size_t len);         // Fairly accurate, slightly slower
 u32 HashEctor(const u8* ptr, size_t length);         // JUNK. DO NOT USE FOR NEW THINGS
 u64 GetHash64(const u8* src, u32 len, u32 samples);
-void SetHash64Function();
+void SetHash64Function(Hash64Function function = Hash64Function::Default);
+u64 HashXXH64(const u8* data, size_t length, u64 seed = 0);
 
 u32 ComputeCRC32(std::string_view data);
 u32 ComputeCRC32(const u8* ptr, u32 length);
@@ -3,6 +3,7 @@
 
 #include "Common/HttpRequest.h"
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <mutex>
@@ -15,6 +16,62 @@
 
 namespace Common
 {
+namespace
+{
+// Connections, DNS lookups and TLS sessions are shared by every request, so that talking to a
+// server again doesn't need a new handshake, even from a different HttpRequest
+class CurlShare final
+{
+public:
+  CurlShare() : m_share(curl_share_init())
+  {
+    if (!m_share)
+      return;
+
+    curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, Lock);
+    curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, Unlock);
+    curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+  }
+
+  ~CurlShare()
+  {
+    if (m_share)
+      curl_share_cleanup(m_share);
+  }
+
+  CurlShare(const CurlShare&) = delete;
+  CurlShare& operator=(const CurlShare&) = delete;
+
+  CURLSH* Get() const { return m_share; }
+
+private:
+  static void Lock(CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+  {
+    static_cast<CurlShare*>(userptr)->m_mutexes[data].lock();
+  }
+
+  static void Unlock(CURL*, curl_lock_data data, void* userptr)
+  {
+    static_cast<CurlShare*>(userptr)->m_mutexes[data].unlock();
+  }
+
+  CURLSH* m_share;
+  std::array<std::mutex, CURL_LOCK_DATA_LAST> m_mutexes;
+};
+
+// Constructed when the first request is, so that it outlives every request
+CURLSH* GetCurlShare()
+{
+  static CurlShare s_share;
+  return s_share.Get();
+}
+}  // namespace
+
 class HttpRequest::Impl final
 {
 public:
@@ -107,10 +164,17 @@ HttpRequest::Impl::Impl(std::chrono::milliseconds timeout_ms, ProgressCallback c
 {
   std::call_once(s_curl_was_initialized, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
 
+  CURLSH* const share = GetCurlShare();
+
   m_curl.reset(curl_easy_init());
   if (!m_curl)
     return;
 
+  if (share)
+    curl_easy_setopt(m_curl.get(), CURLOPT_SHARE, share);
+  // Lets requests to the same server go over a single connection where HTTP/2 is available
+  curl_easy_setopt(m_curl.get(), CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+
   curl_easy_setopt(m_curl.get(), CURLOPT_NOPROGRESS, m_callback == nullptr);
 
   if (m_callback)
@@ -3,22 +3,26 @@
 
 #include "Common/IOFile.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstddef>
 #include <cstdio>
 #include <string>
+#include <vector>
 
 #ifdef _WIN32
 #include <io.h>
+#include <windows.h>
 
 #include "Common/CommonFuncs.h"
 #include "Common/StringUtil.h"
 #else
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 
 #ifdef ANDROID
-#include <algorithm>
-
 #include "jni/AndroidCommon/AndroidCommon.h"
 #endif
 
@@ -146,6 +150,21 @@ bool IOFile::Flush()
   return m_good;
 }
 
+bool IOFile::Sync()
+{
+  if (!Flush())
+    return false;
+
+#ifdef _WIN32
+  if (0 != _commit(_fileno(m_file)))
+#else
+  if (0 != fsync(fileno(m_file)))
+#endif
+    m_good = false;
+
+  return m_good;
+}
+
 bool IOFile::Resize(u64 size)
 {
 #ifdef _WIN32
@@ -159,4 +178,111 @@ bool IOFile::Resize(u64 size)
   return m_good;
 }
 
+template <bool write>
+static bool TransferAt(std::FILE* file, u8* data, size_t length, u64 offset)
+{
+#ifdef _WIN32
+  const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+#else
+  const int fd = fileno(file);
+#endif
+  while (length > 0)
+  {
+#ifdef _WIN32
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    const DWORD size = static_cast<DWORD>(std::min<size_t>(length, 1u << 30));
+    DWORD transferred = 0;
+    const BOOL success = write ? WriteFile(handle, data, size, &transferred, &overlapped) :
+                                 ReadFile(handle, data, size, &transferred, &overlapped);
+    if (!success || transferred == 0)
+      return false;
+#else
+    const ssize_t transferred = write ? pwrite(fd, data, length, static_cast<off_t>(offset)) :
+                                        pread(fd, data, length, static_cast<off_t>(offset));
+    if (transferred < 0 && errno == EINTR)
+      continue;
+    if (transferred <= 0)
+      return false;
+#endif
+    data += transferred;
+    length -= transferred;
+    offset += transferred;
+  }
+  return true;
+}
+
+bool IOFile::ReadAt(void* data, size_t length, u64 offset)
+{
+  return IsOpen() && TransferAt<false>(m_file, static_cast<u8*>(data), length, offset);
+}
+
+bool IOFile::WriteAt(const void* data, size_t length, u64 offset)
+{
+  return IsOpen() &&
+         TransferAt<true>(m_file, static_cast<u8*>(const_cast<void*>(data)), length, offset);
+}
+
+bool IOFile::WriteGather(const WriteBuffer* buffers, size_t count)
+{
+  if (!IsOpen())
+  {
+    m_good = false;
+    return m_good;
+  }
+
+#ifdef _WIN32
+  // WriteFileGather() only works with unbuffered, page aligned I/O, which a stdio stream isn't
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!WriteBytes(buffers[i].data, buffers[i].size))
+      return m_good;
+  }
+#else
+  if (!Flush())
+    return m_good;
+
+  std::vector<iovec> iov(count);
+  for (size_t i = 0; i < count; ++i)
+    iov[i] = {const_cast<void*>(buffers[i].data), buffers[i].size};
+
+  const int fd = fileno(m_file);
+  off_t offset = static_cast<off_t>(Tell());
+  size_t first = 0;
+  while (true)
+  {
+    while (first < count && iov[first].iov_len == 0)
+      ++first;
+    if (first == count)
+      break;
+
+    const int batch = static_cast<int>(std::min<size_t>(count - first, IOV_MAX));
+    const ssize_t written = pwritev(fd, &iov[first], batch, offset);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      m_good = false;
+      return m_good;
+    }
+    offset += written;
+
+    // drop everything that made it out, including the written part of a partial buffer
+    size_t remaining = static_cast<size_t>(written);
+    while (remaining > 0 && remaining >= iov[first].iov_len)
+      remaining -= iov[first++].iov_len;
+    if (remaining > 0)
+    {
+      iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + remaining;
+      iov[first].iov_len -= remaining;
+    }
+  }
+
+  Seek(offset, SeekOrigin::Begin);
+#endif
+
+  return m_good;
+}
+
 }  // namespace File
@@ -20,6 +20,12 @@ enum class SeekOrigin
   End,
 };
 
+struct WriteBuffer
+{
+  const void* data;
+  size_t size;
+};
+
 // simple wrapper for cstdlib file functions to
 // hopefully will make error checking easier
 // and make forgetting an fclose() harder
@@ -89,6 +95,17 @@ public:
 
   bool WriteString(std::string_view str) { return WriteBytes(str.data(), str.size()); }
 
+  // Writes all buffers back to back at the current position. Where available this is a single
+  // vectored write instead of one write per buffer.
+  bool WriteGather(const WriteBuffer* buffers, size_t count);
+
+  // Reads or writes length bytes at the given offset, going straight to the file instead of
+  // through the stream. These may be called from several threads at once and don't change
+  // IsGood(), but they also don't see data still buffered in the stream, so Flush() before using
+  // them and Seek() before using the stream again afterwards.
+  bool ReadAt(void* data, size_t length, u64 offset);
+  bool WriteAt(const void* data, size_t length, u64 offset);
+
   bool IsOpen() const { return nullptr != m_file; }
   // m_good is set to false when a read, write or other function fails
   bool IsGood() const { return m_good; }
@@ -101,6 +118,8 @@ public:
   u64 GetSize() const;
   bool Resize(u64 size);
   bool Flush();
+  // Flushes and then waits until the operating system has written the file to disk.
+  bool Sync();
 
   // clear error state
   void ClearError()
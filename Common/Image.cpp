@@ -61,8 +61,9 @@ static void WarningCallback(ErrorHandler* self, const char* msg)
   warnings->emplace_back(msg);
 }
 
-bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u32 width,
-             u32 height, int stride, int level)
+// strip_alpha writes RGBA input as RGB
+static bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format,
+                    bool strip_alpha, u32 width, u32 height, int stride, int level)
 {
   Common::Timer timer;
   timer.Start();
@@ -76,8 +77,8 @@ bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u
     byte_per_pixel = 3;
     break;
   case ImageByteFormat::RGBA:
-    color_type = PNG_COLOR_TYPE_RGBA;
-    byte_per_pixel = 4;
+    color_type = strip_alpha ? PNG_COLOR_TYPE_RGB : PNG_COLOR_TYPE_RGBA;
+    byte_per_pixel = strip_alpha ? 3 : 4;
     break;
   default:
     ASSERT_MSG(FRAMEDUMP, false, "Invalid format {}", static_cast<int>(format));
@@ -111,7 +112,8 @@ bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u
   bool success = false;
   if (png_ptr != nullptr && info_ptr != nullptr)
   {
-    success = SavePNG0(png_ptr, info_ptr, color_type, width, height, level, &buffer, WriteCallback,
+    success = SavePNG0(png_ptr, info_ptr, color_type, width, height, level,
+                       strip_alpha && format == ImageByteFormat::RGBA, &buffer, WriteCallback,
                        const_cast<u8**>(rows.data()));
   }
   png_destroy_write_struct(&png_ptr, &info_ptr);
@@ -148,11 +150,16 @@ bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u
   return success;
 }
 
+bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u32 width,
+             u32 height, int stride, int level)
+{
+  return SavePNG(path, input, format, false, width, height, stride, level);
+}
+
 bool ConvertRGBAToRGBAndSavePNG(const std::string& path, const u8* input, u32 width, u32 height,
                                 int stride, int level)
 {
-  const std::vector<u8> data = RGBAToRGB(input, width, height, stride);
-  return SavePNG(path, data.data(), ImageByteFormat::RGB, width, height, width * 3, level);
+  return SavePNG(path, input, ImageByteFormat::RGBA, true, width, height, stride, level);
 }
 
 std::vector<u8> RGBAToRGB(const u8* input, u32 width, u32 height, int row_stride)
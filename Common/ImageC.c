@@ -9,19 +9,29 @@
 // The main purpose of this function is to allow specifying the compression level, which
 // png_image_write_to_memory does not allow.  row_pointers is not modified by libpng, but also isn't
 // const for some reason.
+//
+// If strip_filler is set, the rows have a fourth byte per pixel after the color, which libpng
+// drops as it writes each row.
 bool SavePNG0(png_structp png_ptr, png_infop info_ptr, int color_type, png_uint_32 width,
-              png_uint_32 height, int level, png_voidp io_ptr, png_rw_ptr write_fn,
-              png_bytepp row_pointers)
+              png_uint_32 height, int level, bool strip_filler, png_voidp io_ptr,
+              png_rw_ptr write_fn, png_bytepp row_pointers)
 {
   if (setjmp(png_jmpbuf(png_ptr)) != 0)
     return false;
 
   png_set_compression_level(png_ptr, level);
+  // At the fastest levels most of the time goes to trying every filter on every row to see which
+  // compresses best, so those just use one that does well on most images
+  if (level == 0)
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+  else if (level == 1)
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
   png_set_IHDR(png_ptr, info_ptr, width, height, 8, color_type, PNG_INTERLACE_NONE,
                PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
   png_set_rows(png_ptr, info_ptr, row_pointers);
   png_set_write_fn(png_ptr, io_ptr, write_fn, NULL);
-  png_write_png(png_ptr, info_ptr, PNG_TRANSFORM_IDENTITY, NULL);
+  png_write_png(png_ptr, info_ptr,
+                strip_filler ? PNG_TRANSFORM_STRIP_FILLER_AFTER : PNG_TRANSFORM_IDENTITY, NULL);
 
   return true;
 }
@@ -18,8 +18,8 @@ struct ErrorHandler
 };
 
 bool SavePNG0(png_structp png_ptr, png_infop info_ptr, int color_type, png_uint_32 width,
-              png_uint_32 height, int level, png_voidp io_ptr, png_rw_ptr write_fn,
-              png_bytepp row_pointers);
+              png_uint_32 height, int level, bool strip_filler, png_voidp io_ptr,
+              png_rw_ptr write_fn, png_bytepp row_pointers);
 
 void PngError(png_structp png_ptr, png_const_charp msg);
 void PngWarning(png_structp png_ptr, png_const_charp msg);
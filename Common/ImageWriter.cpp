@@ -0,0 +1,54 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ImageWriter.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Common
+{
+ImageWriter::ImageWriter(size_t queue_limit)
+    : m_queue_limit(std::max<size_t>(queue_limit, 1)),
+      m_thread([this](Image image) { Write(std::move(image)); })
+{
+}
+
+ImageWriter::~ImageWriter() = default;
+
+void ImageWriter::SavePNG(std::string path, std::vector<u8> pixels, ImageByteFormat format,
+                          u32 width, u32 height, int stride, int level, bool strip_alpha)
+{
+  {
+    std::unique_lock lk(m_mutex);
+    m_written.wait(lk, [this] { return m_queued < m_queue_limit; });
+    ++m_queued;
+  }
+  m_thread.EmplaceItem(Image{std::move(path), std::move(pixels), format, width, height, stride,
+                             level, strip_alpha});
+}
+
+void ImageWriter::WaitForIdle()
+{
+  std::unique_lock lk(m_mutex);
+  m_written.wait(lk, [this] { return m_queued == 0; });
+}
+
+void ImageWriter::Write(Image image)
+{
+  if (image.strip_alpha && image.format == ImageByteFormat::RGBA)
+  {
+    ConvertRGBAToRGBAndSavePNG(image.path, image.pixels.data(), image.width, image.height,
+                               image.stride, image.level);
+  }
+  else
+  {
+    Common::SavePNG(image.path, image.pixels.data(), image.format, image.width, image.height,
+                    image.stride, image.level);
+  }
+
+  std::lock_guard lk(m_mutex);
+  --m_queued;
+  m_written.notify_all();
+}
+}  // namespace Common
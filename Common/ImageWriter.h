@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Image.h"
+#include "Common/WorkQueueThread.h"
+
+namespace Common
+{
+// Encodes and writes PNG images on a thread of its own, so that saving an image doesn't hold up
+// the thread that produced it. At most queue_limit images wait to be written; saving another one
+// blocks until the writer catches up, which bounds the memory a burst of images can hold.
+class ImageWriter
+{
+public:
+  explicit ImageWriter(size_t queue_limit);
+  // Writes every image that is still queued before returning.
+  ~ImageWriter();
+
+  ImageWriter(const ImageWriter&) = delete;
+  ImageWriter& operator=(const ImageWriter&) = delete;
+
+  // Takes the pixels over as they are, rows stride bytes apart. With strip_alpha, RGBA pixels are
+  // written as RGB, dropping the alpha of each row as it's encoded.
+  void SavePNG(std::string path, std::vector<u8> pixels, ImageByteFormat format, u32 width,
+               u32 height, int stride, int level, bool strip_alpha = false);
+
+  // Blocks until every image saved so far has been written.
+  void WaitForIdle();
+
+private:
+  struct Image
+  {
+    std::string path;
+    std::vector<u8> pixels;
+    ImageByteFormat format;
+    u32 width;
+    u32 height;
+    int stride;
+    int level;
+    bool strip_alpha;
+  };
+
+  void Write(Image image);
+
+  const size_t m_queue_limit;
+  std::mutex m_mutex;
+  std::condition_variable m_written;
+  size_t m_queued = 0;
+
+  // Declared last, so that it has written everything before the rest goes away
+  WorkQueueThread<Image> m_thread;
+};
+}  // namespace Common
@@ -16,22 +16,36 @@
 #include "Common/StringUtil.h"
 
 void IniFile::ParseLine(std::string_view line, std::string* keyOut, std::string* valueOut)
+{
+  std::string_view key, value;
+  if (ParseLine(line, &key, valueOut ? &value : nullptr))
+  {
+    *keyOut = key;
+    if (valueOut)
+      *valueOut = value;
+  }
+}
+
+bool IniFile::ParseLine(std::string_view line, std::string_view* key_out,
+                        std::string_view* value_out)
 {
   if (line.empty() || line.front() == '#')
-    return;
+    return false;
 
   size_t firstEquals = line.find('=');
 
   if (firstEquals != std::string::npos)
   {
     // Yes, a valid line!
-    *keyOut = StripSpaces(line.substr(0, firstEquals));
+    *key_out = StripSpaces(line.substr(0, firstEquals));
 
-    if (valueOut)
+    if (value_out)
     {
-      *valueOut = StripQuotes(StripSpaces(line.substr(firstEquals + 1, std::string::npos)));
+      *value_out = StripQuotes(StripSpaces(line.substr(firstEquals + 1, std::string::npos)));
     }
+    return true;
   }
+  return false;
 }
 
 const std::string& IniFile::NULL_STRING = "";
@@ -124,26 +138,43 @@ IniFile::IniFile() = default;
 
 IniFile::~IniFile() = default;
 
-const IniFile::Section* IniFile::GetSection(std::string_view section_name) const
+// The index points into the sections, so a copy needs its own. Moving a list keeps its elements.
+IniFile::IniFile(const IniFile& other) : sections(other.sections)
+{
+  RebuildSectionIndex();
+}
+
+IniFile::IniFile(IniFile&& other) = default;
+
+IniFile& IniFile::operator=(const IniFile& other)
 {
-  for (const Section& sect : sections)
+  if (this != &other)
   {
-    if (CaseInsensitiveStringCompare::IsEqual(sect.name, section_name))
-      return &sect;
+    sections = other.sections;
+    RebuildSectionIndex();
   }
-
-  return nullptr;
+  return *this;
 }
 
-IniFile::Section* IniFile::GetSection(std::string_view section_name)
+IniFile& IniFile::operator=(IniFile&& other) = default;
+
+void IniFile::RebuildSectionIndex()
 {
+  m_section_index.clear();
   for (Section& sect : sections)
-  {
-    if (CaseInsensitiveStringCompare::IsEqual(sect.name, section_name))
-      return &sect;
-  }
+    m_section_index.emplace(sect.name, &sect);
+}
 
-  return nullptr;
+const IniFile::Section* IniFile::GetSection(std::string_view section_name) const
+{
+  const auto it = m_section_index.find(section_name);
+  return it != m_section_index.end() ? it->second : nullptr;
+}
+
+IniFile::Section* IniFile::GetSection(std::string_view section_name)
+{
+  const auto it = m_section_index.find(section_name);
+  return it != m_section_index.end() ? it->second : nullptr;
 }
 
 IniFile::Section* IniFile::GetOrCreateSection(std::string_view section_name)
@@ -153,6 +184,7 @@ IniFile::Section* IniFile::GetOrCreateSection(std::string_view section_name)
   {
     sections.emplace_back(std::string(section_name));
     section = &sections.back();
+    m_section_index.emplace(section->name, section);
   }
   return section;
 }
@@ -163,6 +195,7 @@ bool IniFile::DeleteSection(std::string_view section_name)
   if (!s)
     return false;
 
+  m_section_index.erase(s->name);
   for (auto iter = sections.begin(); iter != sections.end(); ++iter)
   {
     if (&(*iter) == s)
@@ -236,41 +269,33 @@ void IniFile::SortSections()
 bool IniFile::Load(const std::string& filename, bool keep_current_data)
 {
   if (!keep_current_data)
+  {
     sections.clear();
+    m_section_index.clear();
+  }
   // first section consists of the comments before the first real section
 
-  // Open file
-  std::ifstream in;
-  File::OpenFStream(in, filename, std::ios::in);
-
-  if (in.fail())
+  // The whole file is read at once, and lines are only looked at in place
+  std::string contents;
+  if (!File::ReadFileToString(filename, contents))
     return false;
 
-  Section* current_section = nullptr;
-  bool first_line = true;
-  while (!in.eof())
-  {
-    std::string line_str;
-    if (!std::getline(in, line_str))
-    {
-      if (in.eof())
-        return true;
-      else
-        return false;
-    }
+  std::string_view remaining = contents;
 
-    std::string_view line = line_str;
+  // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
+  if (remaining.substr(0, 3) == "\xEF\xBB\xBF")
+    remaining.remove_prefix(3);
 
-    // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
-    if (first_line && line.substr(0, 3) == "\xEF\xBB\xBF")
-      line.remove_prefix(3);
-    first_line = false;
+  Section* current_section = nullptr;
+  while (!remaining.empty())
+  {
+    const size_t line_end = remaining.find('\n');
+    std::string_view line = remaining.substr(0, line_end);
+    remaining.remove_prefix(line_end == std::string_view::npos ? remaining.size() : line_end + 1);
 
-#ifndef _WIN32
     // Check for CRLF eol and convert it to LF
     if (!line.empty() && line.back() == '\r')
       line.remove_suffix(1);
-#endif
 
     if (!line.empty())
     {
@@ -289,7 +314,7 @@ bool IniFile::Load(const std::string& filename, bool keep_current_data)
       {
         if (current_section)
         {
-          std::string key, value;
+          std::string_view key, value;
           ParseLine(line, &key, &value);
 
           // Lines starting with '$', '*' or '+' are kept verbatim.
@@ -302,14 +327,13 @@ bool IniFile::Load(const std::string& filename, bool keep_current_data)
           }
           else
           {
-            current_section->Set(key, value);
+            current_section->Set(std::string(key), std::string(value));
           }
         }
       }
     }
   }
 
-  in.close();
   return true;
 }
 
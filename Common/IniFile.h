@@ -101,6 +101,10 @@ public:
 
   IniFile();
   ~IniFile();
+  IniFile(const IniFile& other);
+  IniFile(IniFile&& other);
+  IniFile& operator=(const IniFile& other);
+  IniFile& operator=(IniFile&& other);
 
   /**
    * Loads sections and keys.
@@ -162,7 +166,14 @@ public:
   const std::list<Section>& GetSections() const { return sections; }
 
 private:
+  // Returns whether the line has a key, without copying it or its value
+  static bool ParseLine(std::string_view line, std::string_view* key_out,
+                        std::string_view* value_out);
+  void RebuildSectionIndex();
+
   std::list<Section> sections;
+  // Looks sections up by name, since games' inis can have hundreds of them
+  std::map<std::string_view, Section*, CaseInsensitiveStringCompare> m_section_index;
 
   static const std::string& NULL_STRING;
 };
@@ -4,21 +4,29 @@
 #include "Common/Logging/LogManager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstddef>
 #include <cstring>
 #include <locale>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <utility>
 
 #include <fmt/format.h>
 
 #include "Common/CommonPaths.h"
 #include "Common/Config/Config.h"
+#include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Common/Timer.h"
 
 namespace Common::Log
@@ -62,6 +70,152 @@ private:
   bool m_enable;
 };
 
+// Hands formatted messages to the listeners on a thread of its own, so that logging costs the
+// caller the formatting and nothing else. Messages go through a bounded ring that any number of
+// threads can add to without taking a lock (Vyukov's bounded queue); when it's full the message
+// is dropped and counted instead of blocking, and the count is reported once there's room.
+// Errors are the exception and wait until they've been written.
+class LogManager::AsyncWriter
+{
+public:
+  explicit AsyncWriter(LogManager* manager) : m_manager(manager)
+  {
+    for (size_t i = 0; i < CAPACITY; ++i)
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    m_thread = std::thread(&AsyncWriter::ThreadFunc, this);
+  }
+
+  // Writes whatever is still queued before returning
+  ~AsyncWriter()
+  {
+    m_exiting.store(true, std::memory_order_release);
+    m_wakeup.Set();
+    m_thread.join();
+  }
+
+  AsyncWriter(const AsyncWriter&) = delete;
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  void Push(LogLevel level, std::string message)
+  {
+    size_t position = m_enqueue_position.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true)
+    {
+      slot = &m_slots[position % CAPACITY];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+      if (difference == 0)
+      {
+        if (m_enqueue_position.compare_exchange_weak(position, position + 1,
+                                                     std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (difference < 0)
+      {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      else
+      {
+        position = m_enqueue_position.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->level = level;
+    slot->message = std::move(message);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    m_wakeup.Set();
+  }
+
+  // Returns once everything pushed so far has been handed to the listeners
+  void Flush()
+  {
+    if (std::this_thread::get_id() == m_thread.get_id())
+      return;
+
+    const size_t target = m_enqueue_position.load(std::memory_order_relaxed);
+    std::unique_lock lk(m_flush_lock);
+    m_flushed.wait(lk, [&] { return m_dispatched_position.load() >= target; });
+  }
+
+private:
+  static constexpr size_t CAPACITY = 4096;
+
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    LogLevel level;
+    std::string message;
+  };
+
+  // Hands over everything that's queued, returns false if nothing was
+  bool Drain()
+  {
+    bool drained_any = false;
+    while (true)
+    {
+      Slot& slot = m_slots[m_dequeue_position % CAPACITY];
+      if (slot.sequence.load(std::memory_order_acquire) != m_dequeue_position + 1)
+        break;
+
+      const LogLevel level = slot.level;
+      const std::string message = std::move(slot.message);
+      slot.sequence.store(m_dequeue_position + CAPACITY, std::memory_order_release);
+      ++m_dequeue_position;
+      m_manager->Dispatch(level, message.c_str());
+      m_dispatched_position.store(m_dequeue_position);
+      drained_any = true;
+    }
+
+    const size_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reported_dropped)
+    {
+      const std::string message = fmt::format(
+          "{} {}[LOG]: {} messages were dropped, the log couldn't keep up\n",
+          Common::Timer::GetTimeFormatted(),
+          LOG_LEVEL_TO_CHAR[static_cast<int>(LogLevel::LWARNING)], dropped - m_reported_dropped);
+      m_manager->Dispatch(LogLevel::LWARNING, message.c_str());
+      m_reported_dropped = dropped;
+    }
+
+    if (drained_any)
+    {
+      std::lock_guard lk(m_flush_lock);
+      m_flushed.notify_all();
+    }
+    return drained_any;
+  }
+
+  void ThreadFunc()
+  {
+    Common::SetCurrentThreadName("Logger");
+
+    while (!m_exiting.load(std::memory_order_acquire))
+    {
+      if (!Drain())
+        m_wakeup.Wait();
+    }
+    Drain();
+  }
+
+  LogManager* m_manager;
+  std::unique_ptr<Slot[]> m_slots = std::make_unique<Slot[]>(CAPACITY);
+  std::atomic<size_t> m_enqueue_position{0};
+  size_t m_dequeue_position = 0;
+  std::atomic<size_t> m_dispatched_position{0};
+  std::atomic<size_t> m_dropped{0};
+  size_t m_reported_dropped = 0;
+
+  Common::Event m_wakeup;
+  std::mutex m_flush_lock;
+  std::condition_variable m_flushed;
+  std::atomic<bool> m_exiting{false};
+  std::thread m_thread;
+};
+
 void GenericLogFmtImpl(LogLevel level, LogType type, const char* file, int line,
                        fmt::string_view format, const fmt::format_args& args)
 {
@@ -169,10 +323,13 @@ LogManager::LogManager()
   }
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+  m_writer = std::make_unique<AsyncWriter>(this);
 }
 
 LogManager::~LogManager()
 {
+  m_writer.reset();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -209,14 +366,24 @@ void LogManager::Log(LogLevel level, LogType type, const char* file, int line, c
 void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                                  const char* message)
 {
-  const std::string msg =
+  std::string msg =
       fmt::format("{} {}:{} {}[{}]: {}\n", Common::Timer::GetTimeFormatted(), file, line,
                   LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), message);
 
+  m_writer->Push(level, std::move(msg));
+
+  // Errors tend to come right before a panic alert or a crash, which would take whatever is still
+  // queued down with them
+  if (level == LogLevel::LERROR)
+    m_writer->Flush();
+}
+
+void LogManager::Dispatch(LogLevel level, const char* message)
+{
   for (const auto listener_id : m_listener_ids)
   {
     if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+      m_listeners[listener_id]->Log(level, message);
   }
 }
 
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstdarg>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "Common/BitSet.h"
@@ -65,6 +66,8 @@ private:
     bool m_enable = false;
   };
 
+  class AsyncWriter;
+
   LogManager();
   ~LogManager();
 
@@ -75,11 +78,14 @@ private:
 
   void LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                        const char* message);
+  // Hands a formatted message to the enabled listeners, on the log thread
+  void Dispatch(LogLevel level, const char* message);
 
   LogLevel m_level;
   EnumMap<LogContainer, LogType::WIIMOTE> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+  std::unique_ptr<AsyncWriter> m_writer;
 };
 }  // namespace Common::Log
@@ -0,0 +1,302 @@
+// Copyright 2021 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace File
+{
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::string& filename, Mode mode)
+{
+  Open(filename, mode);
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+  Swap(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  Swap(other);
+  return *this;
+}
+
+void MappedFile::Swap(MappedFile& other) noexcept
+{
+  std::swap(m_data, other.m_data);
+  std::swap(m_size, other.m_size);
+  std::swap(m_mode, other.m_mode);
+#ifdef _WIN32
+  std::swap(m_mapping_handle, other.m_mapping_handle);
+#endif
+}
+
+bool MappedFile::Open(const std::string& filename, Mode mode)
+{
+  Close();
+  m_mode = mode;
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(UTF8ToWString(filename).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  const DWORD protect = mode == Mode::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY;
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, protect, 0, 0, nullptr);
+  // the mapping keeps the file open on its own
+  CloseHandle(file);
+  if (!mapping)
+    return false;
+
+  const DWORD access = mode == Mode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ;
+  void* data = MapViewOfFile(mapping, access, 0, 0, 0);
+  if (!data)
+  {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  m_mapping_handle = mapping;
+  m_data = static_cast<u8*>(data);
+  m_size = static_cast<u64>(size.QuadPart);
+#else
+  const int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+  return MapFileDescriptor(fd, mode);
+#endif
+
+  return true;
+}
+
+#ifdef _WIN32
+// Shared memory objects only live in the current session, like POSIX ones only live on this host
+static std::wstring GetSharedMemoryName(const std::string& name)
+{
+  return UTF8ToWString("Local\\" + name);
+}
+#elif !defined(ANDROID)
+static std::string GetSharedMemoryName(const std::string& name)
+{
+  return "/" + name;
+}
+#endif
+
+bool MappedFile::OpenSharedMemory(const std::string& name, Mode mode)
+{
+  Close();
+  m_mode = mode;
+
+#ifdef _WIN32
+  const HANDLE mapping = OpenFileMappingW(FILE_MAP_READ | FILE_MAP_COPY, FALSE,
+                                          GetSharedMemoryName(name).c_str());
+  if (!mapping)
+    return false;
+
+  const DWORD access = mode == Mode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ;
+  void* data = MapViewOfFile(mapping, access, 0, 0, 0);
+  MEMORY_BASIC_INFORMATION info;
+  if (!data || VirtualQuery(data, &info, sizeof(info)) == 0)
+  {
+    if (data)
+      UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    return false;
+  }
+
+  // Windows only knows the size in whole pages, which is exact for anything page-sized
+  m_mapping_handle = mapping;
+  m_data = static_cast<u8*>(data);
+  m_size = static_cast<u64>(info.RegionSize);
+  return true;
+#elif defined(ANDROID)
+  return false;
+#else
+  const int fd = shm_open(GetSharedMemoryName(name).c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+  return MapFileDescriptor(fd, mode);
+#endif
+}
+
+#ifndef _WIN32
+bool MappedFile::MapFileDescriptor(int fd, Mode mode)
+{
+  struct stat file_info;
+  if (fstat(fd, &file_info) != 0 || file_info.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  const int protect = mode == Mode::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+  void* data = mmap(nullptr, file_info.st_size, protect, MAP_PRIVATE, fd, 0);
+  // the mapping keeps the file open on its own
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  m_data = static_cast<u8*>(data);
+  m_size = static_cast<u64>(file_info.st_size);
+  return true;
+}
+#endif
+
+void MappedFile::Close()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#else
+  munmap(m_data, m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+void MappedFile::SetAccessPattern(AccessPattern pattern)
+{
+  if (!m_data)
+    return;
+
+#ifndef _WIN32
+  int advice = MADV_NORMAL;
+  if (pattern == AccessPattern::Sequential)
+    advice = MADV_SEQUENTIAL;
+  else if (pattern == AccessPattern::Random)
+    advice = MADV_RANDOM;
+  madvise(m_data, m_size, advice);
+#endif
+}
+
+void MappedFile::Prefetch(u64 offset, u64 size)
+{
+  if (!m_data || offset >= m_size)
+    return;
+  size = std::min(size, m_size - offset);
+
+#ifdef _WIN32
+  WIN32_MEMORY_RANGE_ENTRY range{m_data + offset, static_cast<SIZE_T>(size)};
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  // madvise wants a page-aligned address
+  const u64 page_size = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  const u64 aligned_offset = offset / page_size * page_size;
+  madvise(m_data + aligned_offset, size + (offset - aligned_offset), MADV_WILLNEED);
+#endif
+}
+
+SharedMemory::SharedMemory() = default;
+
+SharedMemory::~SharedMemory()
+{
+  Close();
+}
+
+bool SharedMemory::Create(const std::string& name, const u8* data, u64 size)
+{
+  Close();
+  if (name.empty() || size == 0)
+    return false;
+
+#ifdef _WIN32
+  const HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                            static_cast<DWORD>(size >> 32),
+                                            static_cast<DWORD>(size), GetSharedMemoryName(name).c_str());
+  if (!mapping)
+    return false;
+  if (GetLastError() == ERROR_ALREADY_EXISTS)
+  {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+  if (!view)
+  {
+    CloseHandle(mapping);
+    return false;
+  }
+  std::memcpy(view, data, size);
+  UnmapViewOfFile(view);
+
+  // the object is gone once the last handle to it is closed
+  m_mapping_handle = mapping;
+#elif defined(ANDROID)
+  return false;
+#else
+  const std::string shm_name = GetSharedMemoryName(name);
+  const int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd < 0)
+    return false;
+
+  bool written = ftruncate(fd, static_cast<off_t>(size)) == 0;
+  for (u64 offset = 0; written && offset < size;)
+  {
+    const ssize_t count = pwrite(fd, data + offset, size - offset, static_cast<off_t>(offset));
+    written = count > 0;
+    offset += written ? static_cast<u64>(count) : 0;
+  }
+  close(fd);
+  if (!written)
+  {
+    shm_unlink(shm_name.c_str());
+    return false;
+  }
+#endif
+
+  m_name = name;
+  return true;
+}
+
+void SharedMemory::Close()
+{
+  if (m_name.empty())
+    return;
+
+#ifdef _WIN32
+  CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#elif !defined(ANDROID)
+  shm_unlink(GetSharedMemoryName(m_name).c_str());
+#endif
+
+  m_name.clear();
+}
+
+}  // namespace File
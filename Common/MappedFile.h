@@ -0,0 +1,107 @@
+// Copyright 2021 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+// Maps a whole file into memory. Pages are only read from disk once they're first touched, so
+// opening a large file and looking at a small part of it is cheap.
+//
+// A copy-on-write mapping may be modified freely; modified pages become private to this process
+// and are never written back to the file.
+class MappedFile
+{
+public:
+  enum class Mode
+  {
+    ReadOnly,
+    CopyOnWrite,
+  };
+
+  enum class AccessPattern
+  {
+    Normal,
+    Sequential,
+    Random,
+  };
+
+  MappedFile();
+  MappedFile(const std::string& filename, Mode mode);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  void Swap(MappedFile& other) noexcept;
+
+  bool Open(const std::string& filename, Mode mode);
+  // Maps a shared memory object that a SharedMemory in this or another process published. All
+  // processes that map it share the same physical pages until they write to them.
+  bool OpenSharedMemory(const std::string& name, Mode mode);
+  void Close();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  Mode GetMode() const { return m_mode; }
+  u64 GetSize() const { return m_size; }
+
+  // Writing through this pointer is only allowed for copy-on-write mappings.
+  u8* GetData() { return m_data; }
+  const u8* GetData() const { return m_data; }
+
+  // Hints to the OS how the mapping is going to be accessed, which decides how far it reads
+  // ahead of the touched pages. Does nothing on systems without such hints.
+  void SetAccessPattern(AccessPattern pattern);
+  // Hints to the OS that a range is going to be touched soon, so it can start reading it in.
+  void Prefetch(u64 offset, u64 size);
+
+private:
+#ifndef _WIN32
+  bool MapFileDescriptor(int fd, Mode mode);
+#endif
+
+  u8* m_data = nullptr;
+  u64 m_size = 0;
+  Mode m_mode = Mode::ReadOnly;
+
+#ifdef _WIN32
+  void* m_mapping_handle = nullptr;
+#endif
+};
+
+// A named, read-only shared memory object holding a copy of some data, such as a base card image
+// that many processes want to map with MappedFile::OpenSharedMemory(). It can be mapped by name for
+// as long as this object lives; mappings made before then stay valid after it's gone.
+class SharedMemory
+{
+public:
+  SharedMemory();
+  ~SharedMemory();
+
+  SharedMemory(const SharedMemory&) = delete;
+  SharedMemory& operator=(const SharedMemory&) = delete;
+
+  // Fails if a shared memory object with the same name already exists.
+  bool Create(const std::string& name, const u8* data, u64 size);
+  void Close();
+
+  bool IsOpen() const { return !m_name.empty(); }
+  const std::string& GetName() const { return m_name; }
+
+private:
+  std::string m_name;
+
+#ifdef _WIN32
+  void* m_mapping_handle = nullptr;
+#endif
+};
+
+}  // namespace File
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstddef>
+#include <set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -34,8 +35,11 @@ public:
   /// CreateView() and ReleaseView(). Used to make a mappable region for emulated memory.
   ///
   /// @param size The amount of bytes that should be allocated in this region.
+  /// @param huge_pages Whether to ask for the segment to be backed by huge pages where the host
+  /// supports it. Views still work at page granularity, only the parts of them that cover whole
+  /// aligned huge pages of the segment get them.
   ///
-  void GrabSHMSegment(size_t size);
+  void GrabSHMSegment(size_t size, bool huge_pages);
 
   ///
   /// Release the memory segment previously allocated with GrabSHMSegment().
@@ -62,6 +66,29 @@ public:
   ///
   void ReleaseView(void* view, size_t size);
 
+  ///
+  /// Detach a view created by CreateView() from the memory segment, which keeps what the view
+  /// holds now. Writes through the view then stay with the view, so nothing else may map the same
+  /// part of the segment. Detaching a view again makes the segment keep what it holds at that time.
+  ///
+  /// @param view Pointer returned by CreateView().
+  /// @param offset Offset passed to the corresponding CreateView() call.
+  /// @param size Size passed to the corresponding CreateView() call.
+  ///
+  /// @return Whether the view was detached. Hosts that can't do it leave the view as it was.
+  ///
+  bool DetachView(void* view, s64 offset, size_t size);
+
+  ///
+  /// Throw away what was written through a view since DetachView(), bringing it back to what the
+  /// memory segment holds. This only costs as much as the pages that were written.
+  ///
+  /// @param view Pointer passed to DetachView().
+  /// @param offset Offset passed to DetachView().
+  /// @param size Size passed to DetachView().
+  ///
+  void ResetView(void* view, s64 offset, size_t size);
+
   ///
   /// Reserve the singular 'virtual' memory region handled by this MemArena. This is used to create
   /// our 'fastmem' memory area for the emulated game code to access directly.
@@ -117,6 +144,8 @@ private:
   int fd;
 #else
   int m_shm_fd;
+  bool m_huge_pages = false;
+  std::set<void*> m_detached_views;
   void* m_reserved_region;
   std::size_t m_reserved_region_size;
 #endif
@@ -62,7 +62,7 @@ static int AshmemCreateFileMapping(const char* name, size_t size)
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool huge_pages)
 {
   fd = AshmemCreateFileMapping(("dolphin-emu." + std::to_string(getpid())).c_str(), size);
   if (fd < 0)
@@ -84,6 +84,16 @@ void MemArena::ReleaseView(void* view, size_t size)
   UnmapFromMemoryRegion(view, size);
 }
 
+// Only done for the segments of MemArenaUnix.cpp so far
+bool MemArena::DetachView(void* view, s64 offset, size_t size)
+{
+  return false;
+}
+
+void MemArena::ResetView(void* view, s64 offset, size_t size)
+{
+}
+
 u8* MemArena::ReserveMemoryRegion(size_t memory_size)
 {
   // Android 4.3 changed how mmap works.
@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <set>
 #include <string>
 
@@ -14,6 +15,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/Align.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -22,11 +24,74 @@
 
 namespace Common
 {
+#if defined __linux__ && defined MADV_HUGEPAGE
+#define HAVE_SHMEM_HUGE_PAGES 1
+
+// Transparent huge pages only come in one size for shared memory
+constexpr size_t HUGE_PAGE_SIZE = 0x200000;
+
+static bool AreShmemHugePagesEnabled()
+{
+  // The policy in use is the bracketed one, such as "always within_size [advise] never deny force"
+  std::ifstream file("/sys/kernel/mm/transparent_hugepage/shmem_enabled");
+  std::string policies;
+  if (!std::getline(file, policies))
+    return false;
+  return policies.find("[never]") == std::string::npos &&
+         policies.find("[deny]") == std::string::npos;
+}
+
+// Reserves address space starting on a huge page boundary. Huge pages can only back the parts of
+// a mapping that line up with them both in the address space and in the segment.
+static void* ReserveAlignedRegion(size_t size)
+{
+  const size_t padded_size = size + HUGE_PAGE_SIZE;
+  void* padded = mmap(nullptr, padded_size, PROT_NONE, MAP_ANON | MAP_PRIVATE, -1, 0);
+  if (padded == MAP_FAILED)
+    return MAP_FAILED;
+
+  u8* const start = static_cast<u8*>(padded);
+  u8* const aligned = reinterpret_cast<u8*>(
+      Common::AlignUp(reinterpret_cast<uintptr_t>(start), HUGE_PAGE_SIZE));
+  if (aligned != start)
+    munmap(start, aligned - start);
+  const size_t tail_size = padded_size - size - (aligned - start);
+  if (tail_size != 0)
+    munmap(aligned + size, tail_size);
+  return aligned;
+}
+#endif
+
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool huge_pages)
 {
+  m_huge_pages = false;
+#ifdef HAVE_SHMEM_HUGE_PAGES
+  if (huge_pages)
+  {
+    // A memfd goes by the shmem_enabled policy, while shm_open files go by the mount options of
+    // /dev/shm, which hardly ever allow huge pages
+    m_shm_fd = memfd_create("dolphin-emu", MFD_CLOEXEC);
+    if (m_shm_fd != -1 && ftruncate(m_shm_fd, size) == 0)
+    {
+      m_huge_pages = true;
+      if (!AreShmemHugePagesEnabled())
+      {
+        WARN_LOG_FMT(MEMMAP, "Huge pages for shared memory are disabled on this system, set "
+                             "/sys/kernel/mm/transparent_hugepage/shmem_enabled to advise");
+      }
+      return;
+    }
+
+    WARN_LOG_FMT(MEMMAP, "Falling back to regular pages, memfd_create failed: {}",
+                 LastStrerrorString());
+    if (m_shm_fd != -1)
+      close(m_shm_fd);
+  }
+#endif
+
   const std::string file_name = "/dolphin-emu." + std::to_string(getpid());
   m_shm_fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
   if (m_shm_fd == -1)
@@ -46,14 +111,33 @@ void MemArena::ReleaseSHMSegment()
 
 void* MemArena::CreateView(s64 offset, size_t size)
 {
-  void* retval = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_shm_fd, offset);
+  void* base = nullptr;
+  int flags = MAP_SHARED;
+#ifdef HAVE_SHMEM_HUGE_PAGES
+  if (m_huge_pages)
+  {
+    base = ReserveAlignedRegion(size);
+    if (base != MAP_FAILED)
+      flags |= MAP_FIXED;
+    else
+      base = nullptr;
+  }
+#endif
+
+  void* retval = mmap(base, size, PROT_READ | PROT_WRITE, flags, m_shm_fd, offset);
   if (retval == MAP_FAILED)
   {
     NOTICE_LOG_FMT(MEMMAP, "mmap failed");
+    if (base)
+      munmap(base, size);
     return nullptr;
   }
   else
   {
+#ifdef HAVE_SHMEM_HUGE_PAGES
+    if (m_huge_pages)
+      madvise(retval, size, MADV_HUGEPAGE);
+#endif
     return retval;
   }
 }
@@ -61,12 +145,77 @@ void* MemArena::CreateView(s64 offset, size_t size)
 void MemArena::ReleaseView(void* view, size_t size)
 {
   munmap(view, size);
+  m_detached_views.erase(view);
+}
+
+// A private mapping of the segment reads what the segment holds until a page of it is written,
+// which gives that page a copy of its own. Mapping it over again drops those copies.
+static bool MapPrivately(int fd, void* view, s64 offset, size_t size, bool huge_pages)
+{
+  void* retval = mmap(view, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+                      static_cast<off_t>(offset));
+  if (retval == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(MEMMAP, "Failed to map a view privately: {}", LastStrerrorString());
+    return false;
+  }
+#ifdef HAVE_SHMEM_HUGE_PAGES
+  if (huge_pages)
+    madvise(retval, size, MADV_HUGEPAGE);
+#endif
+  return true;
+}
+
+bool MemArena::DetachView(void* view, s64 offset, size_t size)
+{
+  // The pages written through a detached view only exist in the view
+  if (m_detached_views.count(view) != 0)
+  {
+    const u8* data = static_cast<const u8*>(view);
+    size_t written = 0;
+    while (written < size)
+    {
+      const ssize_t result = pwrite(m_shm_fd, data + written, size - written,
+                                    static_cast<off_t>(offset + written));
+      if (result < 0 && errno == EINTR)
+        continue;
+      if (result <= 0)
+      {
+        ERROR_LOG_FMT(MEMMAP, "Failed to write a view to the memory segment: {}",
+                      LastStrerrorString());
+        return false;
+      }
+      written += static_cast<size_t>(result);
+    }
+  }
+
+  if (!MapPrivately(m_shm_fd, view, offset, size, m_huge_pages))
+  {
+    // A failed MAP_FIXED mapping may have taken the old one with it, but by now the segment holds
+    // everything the view did
+    MapInMemoryRegion(offset, size, view);
+    m_detached_views.erase(view);
+    return false;
+  }
+  m_detached_views.insert(view);
+  return true;
+}
+
+void MemArena::ResetView(void* view, s64 offset, size_t size)
+{
+  if (m_detached_views.count(view) != 0)
+    MapPrivately(m_shm_fd, view, offset, size, m_huge_pages);
 }
 
 u8* MemArena::ReserveMemoryRegion(size_t memory_size)
 {
   const int flags = MAP_ANON | MAP_PRIVATE;
+#ifdef HAVE_SHMEM_HUGE_PAGES
+  void* base = m_huge_pages ? ReserveAlignedRegion(memory_size) :
+                              mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+#else
   void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+#endif
   if (base == MAP_FAILED)
   {
     PanicAlertFmt("Failed to map enough memory space: {}", LastStrerrorString());
@@ -96,6 +245,10 @@ void* MemArena::MapInMemoryRegion(s64 offset, size_t size, void* base)
   }
   else
   {
+#ifdef HAVE_SHMEM_HUGE_PAGES
+    if (m_huge_pages)
+      madvise(retval, size, MADV_HUGEPAGE);
+#endif
     return retval;
   }
 }
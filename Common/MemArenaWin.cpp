@@ -97,8 +97,10 @@ MemArena::~MemArena()
   ReleaseSHMSegment();
 }
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool huge_pages)
 {
+  // Large pages would need every view to be large page aligned, and BAT mappings are finer than
+  // that, so huge_pages isn't supported here
   const std::string name = "dolphin-emu." + std::to_string(GetCurrentProcessId());
   m_memory_handle = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
                                       static_cast<DWORD>(size), UTF8ToTStr(name).c_str());
@@ -123,6 +125,16 @@ void MemArena::ReleaseView(void* view, size_t size)
   UnmapViewOfFile(view);
 }
 
+// A copy-on-write view can't be put in place of a view without the address being free for a while
+bool MemArena::DetachView(void* view, s64 offset, size_t size)
+{
+  return false;
+}
+
+void MemArena::ResetView(void* view, s64 offset, size_t size)
+{
+}
+
 u8* MemArena::ReserveMemoryRegion(size_t memory_size)
 {
   if (m_reserved_region)
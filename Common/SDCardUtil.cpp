@@ -34,16 +34,26 @@
 #include "Common/SDCardUtil.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <limits>
+#include <optional>
+#include <set>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
 
 #ifndef _WIN32
 #include <unistd.h>  // for unlink()
@@ -62,7 +72,6 @@ enum : u32
 
 static u8 s_boot_sector[BYTES_PER_SECTOR];   /* Boot sector */
 static u8 s_fsinfo_sector[BYTES_PER_SECTOR]; /* FS Info sector */
-static u8 s_fat_head[BYTES_PER_SECTOR];      /* First FAT sector */
 
 template <typename T>
 static void WriteData(u8* out, T data)
@@ -165,59 +174,383 @@ static void boot_sector_init(u8* boot, u8* info, u64 disk_size, const char* labe
   WriteData<u32>(info + 508, 0xAA550000);
 }
 
-static void fat_init(u8* fat)
+namespace
+{
+constexpr u32 DIRECTORY_ENTRY_SIZE = 32;
+constexpr u32 LFN_CHARACTERS_PER_ENTRY = 13;
+constexpr u32 END_OF_CHAIN = 0x0fffffff;
+// 1980-01-01, the earliest date that can be stored. A fixed date keeps the images reproducible.
+constexpr u16 FIXED_DATE = (1 << 5) | 1;
+
+enum : u8
 {
-  WriteData<u32>(fat, 0x0ffffff8);      // Reserve cluster 1, media id in low byte
-  WriteData<u32>(fat + 4, 0x0fffffff);  // Reserve cluster 2
-  WriteData<u32>(fat + 8, 0x0fffffff);  // End of cluster chain for root dir
+  ATTRIBUTE_DIRECTORY = 0x10,
+  ATTRIBUTE_ARCHIVE = 0x20,
+  ATTRIBUTE_LFN = 0x0f,
+};
+
+using ShortName = std::array<char, 11>;
+
+// A file or directory that the image is populated with
+struct ImageNode
+{
+  const File::FSTEntry* entry = nullptr;
+  std::u16string long_name;
+  bool needs_long_name = false;
+  u32 first_cluster = 0;
+  u32 cluster_count = 0;
+  std::vector<ImageNode> children;
+};
+
+bool is_short_name_character(char c)
+{
+  return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+         (c != '\0' && std::strchr("!#$%&'()-@^_`{}~", c) != nullptr);
+}
+
+// Returns the 8.3 name for names that are a valid upper case 8.3 name already
+std::optional<ShortName> get_exact_short_name(const std::string& name)
+{
+  const size_t dot = name.find('.');
+  const std::string base = name.substr(0, dot);
+  const std::string ext = dot == std::string::npos ? std::string() : name.substr(dot + 1);
+  if (base.empty() || base.size() > 8 || ext.size() > 3 ||
+      (dot != std::string::npos && ext.empty()) ||
+      !std::all_of(base.begin(), base.end(), is_short_name_character) ||
+      !std::all_of(ext.begin(), ext.end(), is_short_name_character))
+  {
+    return std::nullopt;
+  }
+
+  ShortName short_name;
+  short_name.fill(' ');
+  std::copy(base.begin(), base.end(), short_name.begin());
+  std::copy(ext.begin(), ext.end(), short_name.begin() + 8);
+  return short_name;
 }
 
-static bool write_sector(File::IOFile& file, const u8* sector)
+// Makes up a unique 8.3 name of the BASE~N.EXT form, for names that have a long name entry
+ShortName generate_short_name(const std::string& name, const std::set<ShortName>& used_names)
 {
-  return file.WriteBytes(sector, BYTES_PER_SECTOR);
+  const auto filter = [](std::string_view part, size_t max_length) {
+    std::string result;
+    for (const char c : part)
+    {
+      const char upper = Common::ToUpper(c);
+      if (result.size() < max_length && is_short_name_character(upper))
+        result.push_back(upper);
+    }
+    return result;
+  };
+
+  const size_t dot = name.rfind('.');
+  const bool has_ext = dot != std::string::npos && dot != 0;
+  const std::string base = filter(std::string_view(name).substr(0, has_ext ? dot : name.size()), 8);
+  const std::string ext = has_ext ? filter(std::string_view(name).substr(dot + 1), 3) : "";
+
+  for (u32 n = 1;; ++n)
+  {
+    const std::string tail = fmt::format("~{}", n);
+    const std::string prefix = base.substr(0, 8 - tail.size());
+
+    ShortName short_name;
+    short_name.fill(' ');
+    const std::string full_base = (prefix.empty() ? "_" : prefix) + tail;
+    std::copy(full_base.begin(), full_base.end(), short_name.begin());
+    std::copy(ext.begin(), ext.end(), short_name.begin() + 8);
+    if (used_names.count(short_name) == 0)
+      return short_name;
+  }
 }
 
-static bool write_empty(File::IOFile& file, std::size_t count)
+u8 get_short_name_checksum(const ShortName& short_name)
 {
-  static constexpr u8 empty[64 * 1024] = {};
+  u8 sum = 0;
+  for (const char c : short_name)
+    sum = static_cast<u8>(((sum & 1) << 7) + (sum >> 1) + static_cast<u8>(c));
+  return sum;
+}
 
-  count *= BYTES_PER_SECTOR;
-  while (count > 0)
+u32 get_directory_entry_count(const ImageNode& directory, bool is_root)
+{
+  // . and .. entries
+  u32 count = is_root ? 0 : 2;
+  for (const ImageNode& child : directory.children)
   {
-    const std::size_t len = std::min(sizeof(empty), count);
+    count += 1;
+    if (child.needs_long_name)
+    {
+      count += static_cast<u32>((child.long_name.size() + LFN_CHARACTERS_PER_ENTRY - 1) /
+                                LFN_CHARACTERS_PER_ENTRY);
+    }
+  }
+  return count;
+}
 
-    if (!file.WriteBytes(empty, len))
-      return false;
+void write_short_entry(u8* out, const ShortName& name, u8 attributes, u32 cluster, u32 size)
+{
+  std::memcpy(out, name.data(), name.size());
+  WriteData<u8>(out + 0x0b, attributes);
+  WriteData<u16>(out + 0x10, FIXED_DATE);  // Creation date
+  WriteData<u16>(out + 0x12, FIXED_DATE);  // Last access date
+  WriteData<u16>(out + 0x14, static_cast<u16>(cluster >> 16));
+  WriteData<u16>(out + 0x18, FIXED_DATE);  // Last write date
+  WriteData<u16>(out + 0x1a, static_cast<u16>(cluster));
+  WriteData<u32>(out + 0x1c, size);
+}
 
-    count -= len;
+void write_long_entries(u8* out, const std::u16string& long_name, u8 checksum)
+{
+  const u32 entry_count = static_cast<u32>(
+      (long_name.size() + LFN_CHARACTERS_PER_ENTRY - 1) / LFN_CHARACTERS_PER_ENTRY);
+
+  // The entries come in reverse order, right before the short entry
+  for (u32 i = 0; i < entry_count; ++i)
+  {
+    const u32 sequence = entry_count - i;
+    u8* entry = out + i * DIRECTORY_ENTRY_SIZE;
+    WriteData<u8>(entry, static_cast<u8>(sequence | (i == 0 ? 0x40 : 0)));
+    WriteData<u8>(entry + 0x0b, ATTRIBUTE_LFN);
+    WriteData<u8>(entry + 0x0d, checksum);
+
+    // The name is terminated by a null character if it doesn't fill the last entry, and the rest
+    // is padded with 0xffff
+    static constexpr std::array<u8, LFN_CHARACTERS_PER_ENTRY> offsets{1,  3,  5,  7,  9,  14, 16,
+                                                                     18, 20, 22, 24, 28, 30};
+    for (u32 j = 0; j < LFN_CHARACTERS_PER_ENTRY; ++j)
+    {
+      const size_t index = (sequence - 1) * LFN_CHARACTERS_PER_ENTRY + j;
+      u16 c = 0xffff;
+      if (index < long_name.size())
+        c = long_name[index];
+      else if (index == long_name.size())
+        c = 0;
+      WriteData<u16>(entry + offsets[j], c);
+    }
   }
-  return true;
 }
 
-bool SDCardCreate(u64 disk_size /*in MB*/, const std::string& filename)
+std::optional<ImageNode> make_node(const File::FSTEntry& entry, bool is_root)
 {
-  // Convert MB to bytes
-  disk_size *= 1024 * 1024;
+  ImageNode node;
+  node.entry = &entry;
+  if (!is_root)
+  {
+    node.long_name = UTF8ToUTF16(entry.virtualName);
+    node.needs_long_name = !get_exact_short_name(entry.virtualName);
+  }
+  if ((!is_root && (node.long_name.empty() || node.long_name.size() > 255)) ||
+      (!entry.isDirectory && entry.size > std::numeric_limits<u32>::max()))
+  {
+    ERROR_LOG_FMT(COMMON, "Can't put {} on an SD card image", entry.physicalName);
+    return std::nullopt;
+  }
 
-  if (disk_size < 0x800000 || disk_size > 0x800000000ULL)
+  if (entry.isDirectory)
   {
-    ERROR_LOG_FMT(COMMON, "Trying to create SD Card image of size {}MB is out of range (8MB-32GB)",
-                  disk_size / (1024 * 1024));
-    return false;
+    for (const File::FSTEntry& child : entry.children)
+    {
+      std::optional<ImageNode> child_node = make_node(child, false);
+      if (!child_node)
+        return std::nullopt;
+      node.children.push_back(std::move(*child_node));
+    }
   }
+  return node;
+}
 
-  // Pretty unlikely to overflow.
+// Gives every node a contiguous run of clusters, directories before their contents
+void allocate_clusters(ImageNode& node, bool is_root, u32 cluster_size, u32* next_cluster)
+{
+  if (node.entry->isDirectory)
+  {
+    const u32 size = get_directory_entry_count(node, is_root) * DIRECTORY_ENTRY_SIZE;
+    node.cluster_count = std::max<u32>((size + cluster_size - 1) / cluster_size, 1);
+  }
+  else
+  {
+    node.cluster_count = static_cast<u32>((node.entry->size + cluster_size - 1) / cluster_size);
+  }
+
+  if (node.cluster_count != 0)
+  {
+    node.first_cluster = *next_cluster;
+    *next_cluster += node.cluster_count;
+  }
+
+  for (ImageNode& child : node.children)
+    allocate_clusters(child, false, cluster_size, next_cluster);
+}
+
+class ImageWriter
+{
+public:
+  ImageWriter(File::IOFile& file, u64 data_offset, u32 cluster_size)
+      : m_file(file), m_data_offset(data_offset), m_cluster_size(cluster_size)
+  {
+  }
+
+  bool WriteNode(const ImageNode& node, u32 parent_cluster, bool is_root, std::vector<u32>* fat)
+  {
+    for (u32 i = 0; i < node.cluster_count; ++i)
+    {
+      const u32 cluster = node.first_cluster + i;
+      (*fat)[cluster] = i + 1 == node.cluster_count ? END_OF_CHAIN : cluster + 1;
+    }
+
+    if (!node.entry->isDirectory)
+      return node.cluster_count == 0 || CopyFile(node);
+
+    if (!WriteDirectory(node, parent_cluster, is_root))
+      return false;
+
+    for (const ImageNode& child : node.children)
+    {
+      if (!WriteNode(child, is_root ? 0 : node.first_cluster, false, fat))
+        return false;
+    }
+    return true;
+  }
+
+private:
+  bool SeekToCluster(u32 cluster)
+  {
+    return m_file.Seek(m_data_offset + u64{cluster - 2} * m_cluster_size, File::SeekOrigin::Begin);
+  }
+
+  bool WriteDirectory(const ImageNode& node, u32 parent_cluster, bool is_root)
+  {
+    std::vector<u8> entries(u64{node.cluster_count} * m_cluster_size);
+    u8* out = entries.data();
+
+    if (!is_root)
+    {
+      ShortName dot;
+      dot.fill(' ');
+      dot[0] = '.';
+      write_short_entry(out, dot, ATTRIBUTE_DIRECTORY, node.first_cluster, 0);
+      dot[1] = '.';
+      write_short_entry(out + DIRECTORY_ENTRY_SIZE, dot, ATTRIBUTE_DIRECTORY, parent_cluster, 0);
+      out += 2 * DIRECTORY_ENTRY_SIZE;
+    }
+
+    // Names that are valid 8.3 names already go first, so that the generated ones avoid them
+    std::set<ShortName> used_names;
+    std::vector<ShortName> short_names(node.children.size());
+    for (size_t i = 0; i < node.children.size(); ++i)
+    {
+      if (node.children[i].needs_long_name)
+        continue;
+
+      short_names[i] = *get_exact_short_name(node.children[i].entry->virtualName);
+      if (!used_names.insert(short_names[i]).second)
+        return false;
+    }
+
+    for (size_t i = 0; i < node.children.size(); ++i)
+    {
+      const ImageNode& child = node.children[i];
+      if (child.needs_long_name)
+      {
+        short_names[i] = generate_short_name(child.entry->virtualName, used_names);
+        used_names.insert(short_names[i]);
+
+        write_long_entries(out, child.long_name, get_short_name_checksum(short_names[i]));
+        out += (child.long_name.size() + LFN_CHARACTERS_PER_ENTRY - 1) /
+               LFN_CHARACTERS_PER_ENTRY * DIRECTORY_ENTRY_SIZE;
+      }
+
+      const bool is_directory = child.entry->isDirectory;
+      write_short_entry(out, short_names[i], is_directory ? ATTRIBUTE_DIRECTORY : ATTRIBUTE_ARCHIVE,
+                        child.first_cluster,
+                        is_directory ? 0 : static_cast<u32>(child.entry->size));
+      out += DIRECTORY_ENTRY_SIZE;
+    }
+
+    return SeekToCluster(node.first_cluster) && m_file.WriteBytes(entries.data(), entries.size());
+  }
+
+  bool CopyFile(const ImageNode& node)
+  {
+    File::IOFile source(node.entry->physicalName, "rb");
+    if (!source || !SeekToCluster(node.first_cluster))
+    {
+      ERROR_LOG_FMT(COMMON, "Could not copy {} to the SD card image", node.entry->physicalName);
+      return false;
+    }
+
+    m_buffer.resize(COPY_BUFFER_SIZE);
+    u64 remaining = node.entry->size;
+    while (remaining != 0)
+    {
+      const size_t length = static_cast<size_t>(std::min<u64>(remaining, m_buffer.size()));
+      if (!source.ReadBytes(m_buffer.data(), length) || !m_file.WriteBytes(m_buffer.data(), length))
+      {
+        ERROR_LOG_FMT(COMMON, "Could not copy {} to the SD card image", node.entry->physicalName);
+        return false;
+      }
+      remaining -= length;
+    }
+    return true;
+  }
+
+  static constexpr size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+  File::IOFile& m_file;
+  u64 m_data_offset;
+  u32 m_cluster_size;
+  std::vector<u8> m_buffer;
+};
+}  // namespace
+
+static bool write_sector(File::IOFile& file, u64 sector, const u8* data)
+{
+  return file.Seek(sector * BYTES_PER_SECTOR, File::SeekOrigin::Begin) &&
+         file.WriteBytes(data, BYTES_PER_SECTOR);
+}
+
+static bool write_image(File::IOFile& file, u64 disk_size, const File::FSTEntry* source)
+{
+  const u32 sectors_per_cluster = get_sectors_per_cluster(disk_size);
   const u32 sectors_per_disk = static_cast<u32>(disk_size / BYTES_PER_SECTOR);
-  const u32 sectors_per_fat = get_sectors_per_fat(disk_size, get_sectors_per_cluster(disk_size));
+  const u32 sectors_per_fat = get_sectors_per_fat(disk_size, sectors_per_cluster);
+  const u32 cluster_size = sectors_per_cluster * BYTES_PER_SECTOR;
+  const u64 data_sector = RESERVED_SECTORS + NUM_FATS * u64{sectors_per_fat};
+  const u32 cluster_count =
+      static_cast<u32>((sectors_per_disk - data_sector) / sectors_per_cluster);
 
   boot_sector_init(s_boot_sector, s_fsinfo_sector, disk_size, nullptr);
-  fat_init(s_fat_head);
 
-  File::IOFile file(filename, "wb");
-  if (!file)
-  {
-    ERROR_LOG_FMT(COMMON, "Could not create file '{}', aborting...", filename);
+  // Reserve cluster 0 with the media id in the low byte, reserve cluster 1, and end the cluster
+  // chain of the root directory
+  std::vector<u32> fat{0x0ffffff8, END_OF_CHAIN, END_OF_CHAIN};
+
+  // Everything that isn't written explicitly below is zero, which the host file system can store
+  // sparsely
+  if (!file.Resize(disk_size))
     return false;
+
+  if (source)
+  {
+    std::optional<ImageNode> root = make_node(*source, true);
+    if (!root)
+      return false;
+
+    u32 next_cluster = 2;
+    allocate_clusters(*root, true, cluster_size, &next_cluster);
+    if (next_cluster - 2 > cluster_count)
+    {
+      ERROR_LOG_FMT(COMMON, "{} doesn't fit on the SD card image", source->physicalName);
+      return false;
+    }
+
+    fat.resize(next_cluster);
+    ImageWriter writer(file, data_sector * BYTES_PER_SECTOR, cluster_size);
+    if (!writer.WriteNode(*root, 0, true, &fat))
+      return false;
+
+    WriteData<u32>(s_fsinfo_sector + 488, cluster_count - (next_cluster - 2));
+    WriteData<u32>(s_fsinfo_sector + 492, next_cluster);
   }
 
   /* Here's the layout:
@@ -232,54 +565,73 @@ bool SDCardCreate(u64 disk_size /*in MB*/, const std::string& filename)
    *  second fat
    *  zero sectors
    */
-
-  if (!write_sector(file, s_boot_sector))
-    goto FailWrite;
-
-  if (!write_sector(file, s_fsinfo_sector))
-    goto FailWrite;
+  if (!write_sector(file, 0, s_boot_sector) || !write_sector(file, 1, s_fsinfo_sector))
+    return false;
 
   if constexpr (BACKUP_BOOT_SECTOR > 0)
   {
-    if (!write_empty(file, BACKUP_BOOT_SECTOR - 2))
-      goto FailWrite;
-
-    if (!write_sector(file, s_boot_sector))
-      goto FailWrite;
-
-    if (!write_sector(file, s_fsinfo_sector))
-      goto FailWrite;
-
-    if (!write_empty(file, RESERVED_SECTORS - 2 - BACKUP_BOOT_SECTOR))
-      goto FailWrite;
+    if (!write_sector(file, BACKUP_BOOT_SECTOR, s_boot_sector) ||
+        !write_sector(file, BACKUP_BOOT_SECTOR + 1, s_fsinfo_sector))
+    {
+      return false;
+    }
   }
-  else
+
+  for (u32 i = 0; i < NUM_FATS; ++i)
   {
-    if (!write_empty(file, RESERVED_SECTORS - 2))
-      goto FailWrite;
+    const u64 fat_offset = (RESERVED_SECTORS + u64{i} * sectors_per_fat) * BYTES_PER_SECTOR;
+    if (!file.Seek(fat_offset, File::SeekOrigin::Begin) || !file.WriteArray(fat.data(), fat.size()))
+      return false;
   }
 
-  if (!write_sector(file, s_fat_head))
-    goto FailWrite;
-
-  if (!write_empty(file, sectors_per_fat - 1))
-    goto FailWrite;
+  return file.Flush();
+}
 
-  if (!write_sector(file, s_fat_head))
-    goto FailWrite;
+static bool create_image(u64 disk_size /*in MB*/, const std::string& filename,
+                         const File::FSTEntry* source)
+{
+  // Convert MB to bytes
+  disk_size *= 1024 * 1024;
 
-  if (!write_empty(file, sectors_per_fat - 1))
-    goto FailWrite;
+  if (disk_size < 0x800000 || disk_size > 0x800000000ULL)
+  {
+    ERROR_LOG_FMT(COMMON, "Trying to create SD Card image of size {}MB is out of range (8MB-32GB)",
+                  disk_size / (1024 * 1024));
+    return false;
+  }
 
-  if (!write_empty(file, sectors_per_disk - RESERVED_SECTORS - 2 * sectors_per_fat))
-    goto FailWrite;
+  File::IOFile file(filename, "wb");
+  if (!file)
+  {
+    ERROR_LOG_FMT(COMMON, "Could not create file '{}', aborting...", filename);
+    return false;
+  }
 
-  return true;
+  if (write_image(file, disk_size, source))
+    return true;
 
-FailWrite:
   ERROR_LOG_FMT(COMMON, "Could not write to '{}', aborting...", filename);
+  file.Close();
   if (unlink(filename.c_str()) < 0)
     ERROR_LOG_FMT(COMMON, "unlink({}) failed: {}", filename, LastStrerrorString());
   return false;
 }
+
+bool SDCardCreate(u64 disk_size /*in MB*/, const std::string& filename)
+{
+  return create_image(disk_size, filename, nullptr);
+}
+
+bool SDCardCreateFromDirectory(u64 disk_size /*in MB*/, const std::string& filename,
+                               const std::string& source_path)
+{
+  if (!File::IsDirectory(source_path))
+  {
+    ERROR_LOG_FMT(COMMON, "{} is not a directory", source_path);
+    return false;
+  }
+
+  const File::FSTEntry source = File::ScanDirectoryTree(source_path, true);
+  return create_image(disk_size, filename, &source);
+}
 }  // namespace Common
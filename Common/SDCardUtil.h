@@ -8,5 +8,11 @@
 
 namespace Common
 {
+// Creates an empty FAT32 image. Only the file system structures are written, so the image takes
+// up little space on host file systems that support sparse files.
 bool SDCardCreate(u64 disk_size /*in MB*/, const std::string& filename);
+
+// Creates a FAT32 image that contains a copy of the files and directories in source_path.
+bool SDCardCreateFromDirectory(u64 disk_size /*in MB*/, const std::string& filename,
+                               const std::string& source_path);
 }  // namespace Common
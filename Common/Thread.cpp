@@ -3,6 +3,18 @@
 
 #include "Common/Thread.h"
 
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
 #ifdef _WIN32
 #include <Windows.h>
 #include <processthreadsapi.h>
@@ -10,6 +22,11 @@
 #include <unistd.h>
 #endif
 
+#if defined __linux__ && !defined ANDROID
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined BSD4_4 || defined __FreeBSD__ || defined __OpenBSD__
@@ -27,7 +44,9 @@
 
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Tracing.h"
 
 namespace Common
 {
@@ -113,6 +132,9 @@ void SetCurrentThreadName(const char* name)
 {
   SetCurrentThreadNameViaException(name);
   SetCurrentThreadNameViaApi(name);
+#ifdef ENABLE_TRACING
+  Tracing::SetThreadName(name);
+#endif
 }
 
 #else  // !WIN32, so must be POSIX threads
@@ -183,8 +205,346 @@ void SetCurrentThreadName(const char* name)
   // API.
   __itt_thread_set_name(name);
 #endif
+#ifdef ENABLE_TRACING
+  Tracing::SetThreadName(name);
+#endif
+}
+
+#endif
+
+namespace
+{
+struct PhysicalCore
+{
+  // The logical CPUs of the core, more than one with SMT
+  std::vector<int> cpus;
+  // Cores with the same value share their last-level cache
+  int cache_domain = -1;
+  // Only means something next to the other cores, larger is faster
+  u32 capacity = 0;
+};
+
+constexpr size_t NUM_THREAD_ROLES = static_cast<size_t>(ThreadRole::Worker) + 1;
+using ThreadLayout = std::array<std::vector<int>, NUM_THREAD_ROLES>;
+
+std::mutex s_placement_lock;
+bool s_placement_enabled = false;
+ThreadLayout s_placement;
+}  // namespace
+
+#if defined __linux__ && !defined ANDROID
+
+// sysfs files claim to be a page long whatever they hold, so File::ReadFileToString can't be used
+static std::optional<std::string> ReadSysfsLine(const std::string& path)
+{
+  std::ifstream file(path);
+  std::string line;
+  if (!std::getline(file, line))
+    return std::nullopt;
+  return std::string(StripSpaces(line));
+}
+
+static std::optional<u32> ReadSysfsNumber(const std::string& path)
+{
+  const std::optional<std::string> str = ReadSysfsLine(path);
+  u32 value;
+  if (!str || !TryParse(*str, &value, 10))
+    return std::nullopt;
+  return value;
+}
+
+// Reads a CPU list such as "0-3,8,10-11"
+static std::vector<int> ReadCPUList(const std::string& path)
+{
+  std::vector<int> cpus;
+  const std::optional<std::string> str = ReadSysfsLine(path);
+  if (!str)
+    return cpus;
+
+  for (const std::string& range : SplitString(*str, ','))
+  {
+    const size_t dash = range.find('-');
+    int first;
+    int last;
+    if (!TryParse(range.substr(0, dash), &first, 10))
+      continue;
+    if (dash == std::string::npos)
+      last = first;
+    else if (!TryParse(range.substr(dash + 1), &last, 10))
+      continue;
+
+    for (int cpu = first; cpu <= last; ++cpu)
+      cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+static std::vector<PhysicalCore> ReadCoreTopology()
+{
+  const std::string root = "/sys/devices/system/cpu/";
+  std::map<std::pair<u32, u32>, size_t> core_indices;
+  std::vector<PhysicalCore> cores;
+  for (const int cpu : ReadCPUList(root + "online"))
+  {
+    const std::string dir = fmt::format("{}cpu{}/", root, cpu);
+    const std::optional<u32> package_id = ReadSysfsNumber(dir + "topology/physical_package_id");
+    const std::optional<u32> core_id = ReadSysfsNumber(dir + "topology/core_id");
+    if (!package_id || !core_id)
+      return {};
+
+    const auto [it, inserted] = core_indices.try_emplace({*package_id, *core_id}, cores.size());
+    if (inserted)
+    {
+      PhysicalCore& core = cores.emplace_back();
+
+      // cpu_capacity is only there on big-little systems. Elsewhere hybrid cores still differ in
+      // how fast they can clock.
+      core.capacity = ReadSysfsNumber(dir + "cpu_capacity")
+                          .value_or(ReadSysfsNumber(dir + "cpufreq/cpuinfo_max_freq").value_or(0));
+
+      // The outermost cache names the domain, or the package if the caches aren't listed
+      core.cache_domain = -1 - static_cast<int>(*package_id);
+      u32 outermost_level = 0;
+      for (int index = 0;; ++index)
+      {
+        const std::string cache = fmt::format("{}cache/index{}/", dir, index);
+        const std::optional<u32> level = ReadSysfsNumber(cache + "level");
+        if (!level)
+          break;
+        const std::vector<int> shared_cpus = ReadCPUList(cache + "shared_cpu_list");
+        if (*level > outermost_level && !shared_cpus.empty())
+        {
+          outermost_level = *level;
+          core.cache_domain = shared_cpus.front();
+        }
+      }
+    }
+    cores[it->second].cpus.push_back(cpu);
+  }
+  return cores;
+}
+
+static void MoveCurrentThread(const std::vector<int>& cpus, bool low_priority)
+{
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const int cpu : cpus)
+  {
+    if (cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &cpu_set);
+  }
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+
+  // Linux keeps a nice value for each thread, not just for the whole process
+  if (low_priority)
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+}
+
+#elif defined _WIN32
+
+static std::vector<PhysicalCore> ReadCoreTopology()
+{
+  DWORD length = 0;
+  GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+  std::vector<u8> buffer(length);
+  if (!GetLogicalProcessorInformationEx(
+          RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()),
+          &length))
+  {
+    return {};
+  }
+
+  std::vector<PhysicalCore> cores;
+  std::vector<KAFFINITY> core_masks;
+  std::vector<KAFFINITY> cache_masks;
+  for (DWORD offset = 0; offset < length;)
+  {
+    const auto* info =
+        reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+    offset += info->Size;
+
+    // An affinity mask only reaches the processors of one group
+    if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0)
+    {
+      const KAFFINITY mask = info->Processor.GroupMask[0].Mask;
+      PhysicalCore& core = cores.emplace_back();
+      core.capacity = info->Processor.EfficiencyClass;
+      for (int cpu = 0; cpu < static_cast<int>(sizeof(mask) * 8); ++cpu)
+      {
+        if ((mask >> cpu) & 1)
+          core.cpus.push_back(cpu);
+      }
+      core_masks.push_back(mask);
+    }
+    else if (info->Relationship == RelationCache && info->Cache.Level == 3 &&
+             info->Cache.GroupMask.Group == 0)
+    {
+      cache_masks.push_back(info->Cache.GroupMask.Mask);
+    }
+  }
+
+  for (size_t i = 0; i < cores.size(); ++i)
+  {
+    for (size_t j = 0; j < cache_masks.size(); ++j)
+    {
+      if (core_masks[i] & cache_masks[j])
+        cores[i].cache_domain = static_cast<int>(j);
+    }
+  }
+  return cores;
+}
+
+static void MoveCurrentThread(const std::vector<int>& cpus, bool low_priority)
+{
+  DWORD_PTR mask = 0;
+  for (const int cpu : cpus)
+    mask |= DWORD_PTR(1) << cpu;
+  SetThreadAffinityMask(GetCurrentThread(), mask);
+
+  if (low_priority)
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+}
+
+#else
+
+static std::vector<PhysicalCore> ReadCoreTopology()
+{
+  return {};
+}
+
+static void MoveCurrentThread(const std::vector<int>& cpus, bool low_priority)
+{
 }
 
 #endif
 
+static ThreadLayout ChooseLayout(const std::vector<PhysicalCore>& cores)
+{
+  u32 max_capacity = 0;
+  for (const PhysicalCore& core : cores)
+    max_capacity = std::max(max_capacity, core.capacity);
+
+  // Cores a little slower than the fastest are just not the ones boosting highest
+  const auto is_efficiency_core = [max_capacity](const PhysicalCore& core) {
+    return u64{core.capacity} * 5 < u64{max_capacity} * 4;
+  };
+
+  std::map<int, size_t> domain_sizes;
+  std::vector<const PhysicalCore*> performance_cores;
+  std::vector<int> efficiency_cpus;
+  for (const PhysicalCore& core : cores)
+  {
+    if (is_efficiency_core(core))
+    {
+      efficiency_cpus.insert(efficiency_cpus.end(), core.cpus.begin(), core.cpus.end());
+    }
+    else
+    {
+      ++domain_sizes[core.cache_domain];
+      performance_cores.push_back(&core);
+    }
+  }
+
+  // The domain with the most performance cores goes first, so the CPU, GPU and DSP threads can
+  // share its cache
+  std::stable_sort(performance_cores.begin(), performance_cores.end(),
+                   [&domain_sizes](const PhysicalCore* a, const PhysicalCore* b) {
+                     const size_t a_size = domain_sizes[a->cache_domain];
+                     const size_t b_size = domain_sizes[b->cache_domain];
+                     if (a_size != b_size)
+                       return a_size > b_size;
+                     return a->cache_domain < b->cache_domain;
+                   });
+
+  ThreadLayout layout;
+  const auto role = [&layout](ThreadRole r) -> std::vector<int>& {
+    return layout[static_cast<size_t>(r)];
+  };
+  const size_t last = performance_cores.size() - 1;
+  role(ThreadRole::CPU) = performance_cores[0]->cpus;
+  role(ThreadRole::GPU) = performance_cores[std::min<size_t>(1, last)]->cpus;
+  role(ThreadRole::DSP) = performance_cores[std::min<size_t>(2, last)]->cpus;
+
+  // Audio and workers get whatever the emulation threads left over, I/O prefers the efficiency
+  // cores
+  std::vector<int>& audio = role(ThreadRole::Audio);
+  std::vector<int> all_cpus;
+  for (size_t i = 0; i < performance_cores.size(); ++i)
+  {
+    const std::vector<int>& cpus = performance_cores[i]->cpus;
+    all_cpus.insert(all_cpus.end(), cpus.begin(), cpus.end());
+    if (i > 2)
+      audio.insert(audio.end(), cpus.begin(), cpus.end());
+  }
+  all_cpus.insert(all_cpus.end(), efficiency_cpus.begin(), efficiency_cpus.end());
+  audio.insert(audio.end(), efficiency_cpus.begin(), efficiency_cpus.end());
+  if (audio.empty())
+    audio = all_cpus;
+  role(ThreadRole::IO) = efficiency_cpus.empty() ? audio : efficiency_cpus;
+  role(ThreadRole::Worker) = audio;
+
+  for (std::vector<int>& cpus : layout)
+    std::sort(cpus.begin(), cpus.end());
+  return layout;
+}
+
+// Writes a sorted CPU list the way Linux does, such as "0-3,8"
+static std::string FormatCPUList(const std::vector<int>& cpus)
+{
+  std::string str;
+  for (size_t i = 0; i < cpus.size();)
+  {
+    size_t j = i;
+    while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1)
+      ++j;
+    if (!str.empty())
+      str += ',';
+    str += j == i ? fmt::format("{}", cpus[i]) : fmt::format("{}-{}", cpus[i], cpus[j]);
+    i = j + 1;
+  }
+  return str;
+}
+
+void InitThreadPlacement(bool enabled)
+{
+  const std::vector<PhysicalCore> cores = ReadCoreTopology();
+
+  std::lock_guard lk(s_placement_lock);
+  if (cores.empty())
+  {
+    s_placement_enabled = false;
+    s_placement = {};
+    NOTICE_LOG_FMT(COMMON, "Thread placement: the core topology of this system is unknown");
+    return;
+  }
+
+  s_placement_enabled = enabled;
+  s_placement = ChooseLayout(cores);
+
+  std::map<int, size_t> domains;
+  for (const PhysicalCore& core : cores)
+    ++domains[core.cache_domain];
+  const auto cpus = [](ThreadRole role) {
+    return FormatCPUList(s_placement[static_cast<size_t>(role)]);
+  };
+  NOTICE_LOG_FMT(COMMON,
+                 "Thread placement {}: {} cores in {} cache domains. CPU on {}, GPU on {}, "
+                 "DSP on {}, audio on {}, I/O on {}",
+                 enabled ? "enabled" : "disabled", cores.size(), domains.size(),
+                 cpus(ThreadRole::CPU), cpus(ThreadRole::GPU), cpus(ThreadRole::DSP),
+                 cpus(ThreadRole::Audio), cpus(ThreadRole::IO));
+}
+
+void PlaceCurrentThread(ThreadRole role)
+{
+  std::vector<int> cpus;
+  {
+    std::lock_guard lk(s_placement_lock);
+    if (!s_placement_enabled)
+      return;
+    cpus = s_placement[static_cast<size_t>(role)];
+  }
+  MoveCurrentThread(cpus, role == ThreadRole::IO);
+}
+
 }  // namespace Common
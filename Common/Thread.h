@@ -35,4 +35,27 @@ inline void YieldCPU()
 
 void SetCurrentThreadName(const char* name);
 
+// What a thread is for, which decides the cores it gets placed on
+enum class ThreadRole
+{
+  CPU,
+  GPU,
+  DSP,
+  Audio,
+  IO,
+  // Anything else started while emulating, which would otherwise inherit the placement of the
+  // thread starting it
+  Worker,
+};
+
+// Reads the core topology and picks the cores for each role: the CPU and GPU threads get
+// distinct physical cores sharing a last-level cache, the DSP thread the next such core, I/O
+// threads the efficiency cores if there are any and everything else the cores left over. The
+// layout is logged either way, but threads are only moved when enabled is set.
+void InitThreadPlacement(bool enabled);
+
+// Moves the calling thread onto the cores picked for its role, if placement is enabled. I/O
+// threads also drop below normal priority.
+void PlaceCurrentThread(ThreadRole role);
+
 }  // namespace Common
@@ -0,0 +1,194 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+// Lets Submit and RunPendingTask find the queue of the worker they are running on
+static thread_local const ThreadPool* s_current_pool = nullptr;
+static thread_local size_t s_current_worker = 0;
+
+ThreadPool::ThreadPool(size_t thread_count, std::string name)
+    : m_name(std::move(name)), m_thread_count(std::max<size_t>(thread_count, 1)),
+      m_workers(std::make_unique<Worker[]>(m_thread_count))
+{
+  for (size_t i = 0; i < m_thread_count; ++i)
+    m_workers[i].thread = std::thread(&ThreadPool::WorkerThread, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard lk(m_sleep_mutex);
+    m_exiting = true;
+  }
+  m_wake.notify_all();
+
+  for (size_t i = 0; i < m_thread_count; ++i)
+    m_workers[i].thread.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task, TaskPriority priority)
+{
+  const size_t priority_index = static_cast<size_t>(priority);
+  const size_t worker_index =
+      s_current_pool == this ? s_current_worker : m_next_worker++ % m_thread_count;
+
+  // The count is raised first so that it never drops below the number of queued tasks. A worker
+  // that sees a task counted before it's queued just looks for it again.
+  ++m_queued_tasks[priority_index];
+  {
+    Worker& worker = m_workers[worker_index];
+    std::lock_guard lk(worker.mutex);
+    worker.queues[priority_index].push_back(std::move(task));
+  }
+
+  // Taking the lock ensures that a worker can't miss the notification between checking for
+  // tasks and going to sleep
+  {
+    std::lock_guard lk(m_sleep_mutex);
+  }
+  m_wake.notify_one();
+}
+
+bool ThreadPool::RunPendingTask()
+{
+  std::function<void()> task;
+  if (!TryPopTask(s_current_pool == this ? s_current_worker : 0, &task))
+    return false;
+
+  task();
+  return true;
+}
+
+bool ThreadPool::TryPopTask(size_t home_worker, std::function<void()>* task)
+{
+  for (size_t priority = 0; priority < PRIORITY_COUNT; ++priority)
+  {
+    if (m_queued_tasks[priority].load() == 0)
+      continue;
+
+    // Look in the worker's own queue first, then steal from the others
+    for (size_t i = 0; i < m_thread_count; ++i)
+    {
+      Worker& worker = m_workers[(home_worker + i) % m_thread_count];
+      std::lock_guard lk(worker.mutex);
+
+      std::deque<std::function<void()>>& queue = worker.queues[priority];
+      if (queue.empty())
+        continue;
+
+      *task = std::move(queue.front());
+      queue.pop_front();
+      --m_queued_tasks[priority];
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ThreadPool::WorkerThread(size_t index)
+{
+  s_current_pool = this;
+  s_current_worker = index;
+  Common::SetCurrentThreadName(fmt::format("{} {}", m_name, index).c_str());
+  Common::PlaceCurrentThread(Common::ThreadRole::Worker);
+
+  const auto has_queued_tasks = [this] {
+    return std::any_of(m_queued_tasks.begin(), m_queued_tasks.end(),
+                       [](const std::atomic<size_t>& count) { return count.load() != 0; });
+  };
+
+  std::function<void()> task;
+  while (true)
+  {
+    if (TryPopTask(index, &task))
+    {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock lk(m_sleep_mutex);
+    m_wake.wait(lk, [&] { return m_exiting || has_queued_tasks(); });
+    if (m_exiting && !has_queued_tasks())
+      return;
+  }
+}
+
+ThreadPool& GetGlobalThreadPool()
+{
+  static ThreadPool pool(std::thread::hardware_concurrency(), "Thread pool");
+  return pool;
+}
+
+void TaskGroup::Submit(std::function<void()> task, TaskPriority priority)
+{
+  {
+    std::lock_guard lk(m_mutex);
+    ++m_pending;
+  }
+
+  m_pool.Submit(
+      [this, task = std::move(task)] {
+        task();
+
+        // Notifying with the lock held keeps Wait from returning, and the group from being
+        // destroyed, before this is done with it
+        std::lock_guard lk(m_mutex);
+        if (--m_pending == 0)
+          m_done.notify_all();
+      },
+      priority);
+}
+
+void TaskGroup::Wait()
+{
+  std::unique_lock lk(m_mutex);
+  while (m_pending != 0)
+  {
+    lk.unlock();
+    const bool ran_task = m_pool.RunPendingTask();
+    lk.lock();
+
+    // The remaining tasks are running elsewhere. They may queue more tasks, which this thread
+    // should help with if every worker ends up waiting, so don't sleep for too long.
+    if (!ran_task)
+      m_done.wait_for(lk, std::chrono::milliseconds(1), [this] { return m_pending == 0; });
+  }
+}
+
+void ParallelFor(size_t count, const std::function<void(size_t)>& function, size_t max_threads,
+                 ThreadPool& pool)
+{
+  std::atomic<size_t> next{0};
+  const auto run = [&] {
+    for (size_t i = next++; i < count; i = next++)
+      function(i);
+  };
+
+  if (max_threads == 0)
+    max_threads = pool.GetThreadCount() + 1;
+
+  TaskGroup group(pool);
+  for (size_t i = 1; i < std::min(count, max_threads); ++i)
+    group.Submit(run);
+  run();
+  group.Wait();
+}
+}  // namespace Common
@@ -0,0 +1,105 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Common
+{
+enum class TaskPriority
+{
+  High,
+  Normal,
+  Low,
+};
+
+// A pool of worker threads that run submitted tasks. Every worker has queues of its own, and a
+// worker that runs out of tasks steals from the others, so that the workers don't all contend for
+// a single queue. Tasks are picked in order of priority, and in submission order within a worker.
+class ThreadPool
+{
+public:
+  ThreadPool(size_t thread_count, std::string name);
+  // Runs all tasks that are still queued before returning.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Tasks submitted from one of this pool's workers go to that worker's own queue.
+  void Submit(std::function<void()> task, TaskPriority priority = TaskPriority::Normal);
+
+  // Runs one queued task on the calling thread. Returns false if there was nothing to run.
+  // Threads that wait for tasks can use this to help out instead of blocking.
+  bool RunPendingTask();
+
+  size_t GetThreadCount() const { return m_thread_count; }
+
+private:
+  static constexpr size_t PRIORITY_COUNT = 3;
+
+  struct Worker
+  {
+    std::thread thread;
+    std::mutex mutex;
+    std::array<std::deque<std::function<void()>>, PRIORITY_COUNT> queues;
+  };
+
+  bool TryPopTask(size_t home_worker, std::function<void()>* task);
+  void WorkerThread(size_t index);
+
+  std::string m_name;
+  size_t m_thread_count;
+  std::unique_ptr<Worker[]> m_workers;
+
+  std::atomic<size_t> m_next_worker{0};
+  std::array<std::atomic<size_t>, PRIORITY_COUNT> m_queued_tasks{};
+
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_wake;
+  bool m_exiting = false;
+};
+
+// The pool shared by everything that doesn't need threads of its own, with one thread per core.
+// Sharing it keeps several parallel jobs that run at once from oversubscribing the machine.
+ThreadPool& GetGlobalThreadPool();
+
+// Tasks submitted to a pool through a TaskGroup can be waited for together.
+class TaskGroup
+{
+public:
+  explicit TaskGroup(ThreadPool& pool = GetGlobalThreadPool()) : m_pool(pool) {}
+  ~TaskGroup() { Wait(); }
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void Submit(std::function<void()> task, TaskPriority priority = TaskPriority::Normal);
+
+  // Runs queued tasks of the pool while waiting, so this can be called from a worker thread.
+  void Wait();
+
+private:
+  ThreadPool& m_pool;
+  std::mutex m_mutex;
+  std::condition_variable m_done;
+  size_t m_pending = 0;
+};
+
+// Calls function(i) for every i in [0, count), on the calling thread and workers of the pool, with
+// at most max_threads of them at once, or one more than the pool has threads if max_threads is 0.
+// Indices are handed out one at a time as threads become free, so uneven work still spreads
+// evenly. Like TaskGroup::Wait, this can be called from a worker thread.
+void ParallelFor(size_t count, const std::function<void(size_t)>& function, size_t max_threads = 0,
+                 ThreadPool& pool = GetGlobalThreadPool());
+}  // namespace Common
@@ -0,0 +1,188 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/Tracing.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+
+namespace Common::Tracing
+{
+namespace
+{
+// Single producer ring. The slots are atomics so that a dump can read them while the owning
+// thread keeps writing; a dump throws away any slot that may have been overwritten while copying.
+struct ThreadBuffer
+{
+  u32 id;
+  std::string name;
+  std::array<std::atomic<const char*>, SPANS_PER_THREAD> names{};
+  std::array<std::atomic<u64>, SPANS_PER_THREAD> starts{};
+  // For a counter, the end holds its value
+  std::array<std::atomic<u64>, SPANS_PER_THREAD> ends{};
+  std::array<std::atomic<bool>, SPANS_PER_THREAD> counters{};
+  std::atomic<u64> written{0};
+};
+
+struct Span
+{
+  const char* name;
+  u64 start;
+  u64 end;
+  bool counter;
+};
+
+std::mutex s_buffers_mutex;
+// Buffers stay registered after their thread exits, so its spans still make it into the trace.
+std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+
+ThreadBuffer& GetThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto new_buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard lk(s_buffers_mutex);
+    new_buffer->id = static_cast<u32>(s_buffers.size() + 1);
+    s_buffers.push_back(new_buffer);
+    return new_buffer;
+  }();
+  return *buffer;
+}
+
+std::vector<Span> CopySpans(const ThreadBuffer& buffer)
+{
+  const u64 end = buffer.written.load(std::memory_order_acquire);
+  const u64 begin = end > SPANS_PER_THREAD ? end - SPANS_PER_THREAD : 0;
+  std::vector<Span> spans;
+  spans.reserve(end - begin);
+  for (u64 i = begin; i < end; ++i)
+  {
+    const size_t slot = i % SPANS_PER_THREAD;
+    spans.push_back({buffer.names[slot].load(std::memory_order_relaxed),
+                     buffer.starts[slot].load(std::memory_order_relaxed),
+                     buffer.ends[slot].load(std::memory_order_relaxed),
+                     buffer.counters[slot].load(std::memory_order_relaxed)});
+  }
+
+  // Slots the thread reached again while they were being copied, including the one it may be
+  // writing right now, hold a mix of two spans
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const u64 now_writing = buffer.written.load(std::memory_order_relaxed) + 1;
+  const u64 overwritten = now_writing > SPANS_PER_THREAD ? now_writing - SPANS_PER_THREAD : 0;
+  if (overwritten > begin)
+    spans.erase(spans.begin(), spans.begin() + std::min(overwritten - begin, end - begin));
+  return spans;
+}
+
+void Record(const char* name, u64 start, u64 end, bool counter)
+{
+  ThreadBuffer& buffer = GetThreadBuffer();
+  const u64 index = buffer.written.load(std::memory_order_relaxed);
+  const size_t slot = index % SPANS_PER_THREAD;
+  // Pairs with the fence in CopySpans, so a dump that sees this span's data also sees the count
+  // from before it
+  std::atomic_thread_fence(std::memory_order_release);
+  buffer.names[slot].store(name, std::memory_order_relaxed);
+  buffer.starts[slot].store(start, std::memory_order_relaxed);
+  buffer.ends[slot].store(end, std::memory_order_relaxed);
+  buffer.counters[slot].store(counter, std::memory_order_relaxed);
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+std::string EscapeJSON(std::string_view str)
+{
+  std::string escaped;
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      escaped += c;
+  }
+  return escaped;
+}
+}  // namespace
+
+u64 Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void RecordSpan(const char* name, u64 start, u64 end)
+{
+  Record(name, start, end, false);
+}
+
+void RecordCounter(const char* name, u64 value)
+{
+  Record(name, Now(), value, true);
+}
+
+void SetThreadName(const std::string& name)
+{
+#ifdef ENABLE_TRACING
+  ThreadBuffer& buffer = GetThreadBuffer();
+  std::lock_guard lk(s_buffers_mutex);
+  buffer.name = name;
+#endif
+}
+
+bool WriteChromeTrace(const std::string& path)
+{
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard lk(s_buffers_mutex);
+    buffers = s_buffers;
+  }
+
+  File::IOFile file(path, "wb");
+  if (!file)
+    return false;
+
+  std::string json = "{\"traceEvents\":[\n";
+  bool first = true;
+  const auto append = [&](const std::string& event) {
+    if (!first)
+      json += ",\n";
+    json += event;
+    first = false;
+  };
+  for (const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+  {
+    std::string name;
+    {
+      std::lock_guard lk(s_buffers_mutex);
+      name = buffer->name.empty() ? fmt::format("Thread {}", buffer->id) : buffer->name;
+    }
+    append(fmt::format(
+        R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+        buffer->id, EscapeJSON(name)));
+
+    for (const Span& span : CopySpans(*buffer))
+    {
+      if (span.counter)
+      {
+        append(fmt::format(
+            R"({{"name":"{}","ph":"C","pid":1,"tid":{},"ts":{:.3f},"args":{{"value":{}}}}})",
+            EscapeJSON(span.name), buffer->id, span.start / 1000.0, span.end));
+        continue;
+      }
+      append(fmt::format(R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                         EscapeJSON(span.name), buffer->id, span.start / 1000.0,
+                         (span.end - span.start) / 1000.0));
+    }
+  }
+  json += "\n]}\n";
+
+  return file.WriteString(json);
+}
+}  // namespace Common::Tracing
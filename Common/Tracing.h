@@ -0,0 +1,66 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Scoped spans that record where time goes on each thread, for viewing in chrome://tracing or
+// Perfetto, and counters that record how a value changes over time. Both are only recorded in
+// builds configured with ENABLE_TRACING; otherwise TRACE_SPAN and TRACE_COUNTER compile to nothing.
+//
+// Every thread records into its own ring buffer without locking, and only the most recent spans
+// and counter values of each thread are kept.
+
+namespace Common::Tracing
+{
+// Spans and counter values kept per thread before the oldest ones are overwritten.
+constexpr size_t SPANS_PER_THREAD = 1 << 16;
+
+u64 Now();
+
+// name has to outlive the trace, which string literals do.
+void RecordSpan(const char* name, u64 start, u64 end);
+// Same for name. Every counter gets a track of its own.
+void RecordCounter(const char* name, u64 value);
+
+// Names the calling thread in the trace. Common::SetCurrentThreadName does this as well.
+void SetThreadName(const std::string& name);
+
+// Writes the spans of every thread as Chrome trace event JSON.
+bool WriteChromeTrace(const std::string& path);
+
+class ScopedSpan
+{
+public:
+  explicit ScopedSpan(const char* name) : m_name(name), m_start(Now()) {}
+  ~ScopedSpan() { RecordSpan(m_name, m_start, Now()); }
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+  const char* m_name;
+  u64 m_start;
+};
+}  // namespace Common::Tracing
+
+#define TRACE_SPAN_CONCAT_(a, b) a##b
+#define TRACE_SPAN_CONCAT(a, b) TRACE_SPAN_CONCAT_(a, b)
+
+#ifdef ENABLE_TRACING
+#define TRACE_SPAN(name)                                                                           \
+  Common::Tracing::ScopedSpan TRACE_SPAN_CONCAT(trace_span_, __LINE__)(name)
+#define TRACE_COUNTER(name, value) Common::Tracing::RecordCounter(name, value)
+#else
+#define TRACE_SPAN(name)                                                                           \
+  do                                                                                               \
+  {                                                                                                \
+  } while (0)
+#define TRACE_COUNTER(name, value)                                                                 \
+  do                                                                                               \
+  {                                                                                                \
+  } while (0)
+#endif
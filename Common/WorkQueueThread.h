@@ -74,6 +74,7 @@ private:
   void ThreadLoop()
   {
     Common::SetCurrentThreadName("WorkQueueThread");
+    Common::PlaceCurrentThread(Common::ThreadRole::Worker);
 
     while (true)
     {
@@ -21,7 +21,9 @@
 #include "Core/ActionReplay.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <iterator>
 #include <mutex>
 #include <string>
@@ -81,9 +83,49 @@ enum
   SUB_MASTER_CODE = 0x03,
 };
 
+// An AR code line with its decoding done up front, so that running it doesn't have to go
+// through all the checks the interpreter does
+struct CompiledOp
+{
+  enum class Type : u8
+  {
+    RamWrite8,
+    RamWrite16,
+    RamWrite32,
+    PointerWrite8,
+    PointerWrite16,
+    PointerWrite32,
+    Add8,
+    Add16,
+    Add32,
+    AddFloat,
+    Compare8,
+    Compare16,
+    Compare32,
+    // A Fill & Slide or Memory Copy zero code, which takes the next line as its parameters
+    FillAndSlide,
+    MemoryCopy,
+    Nop,
+    End,
+    // A line that fails when run. The interpreter takes over from it so the error is reported
+    // exactly like before.
+    Interpret,
+  };
+
+  Type type;
+  u8 compare_type = 0;
+  // The GameCube address the line works on
+  u32 address = 0;
+  u32 data = 0;
+  // For conditional codes, the index of the line to continue at if the comparison fails
+  u32 skip_to = 0;
+};
+
 // General lock. Protects codes list and internal log.
 static std::mutex s_lock;
 static std::vector<ARCode> s_active_codes;
+// The compiled lines of each active code, in the same order as s_active_codes
+static std::vector<std::vector<CompiledOp>> s_compiled_codes;
 static std::vector<ARCode> s_synced_codes;
 static std::vector<std::string> s_internal_log;
 static std::atomic<bool> s_use_internal_log{false};
@@ -110,6 +152,16 @@ struct ARAddr
   operator u32() const { return address; }
 };
 
+static std::vector<CompiledOp> CompileCode(const ARCode& arcode);
+
+static void CompileActiveCodes()
+{
+  s_compiled_codes.clear();
+  s_compiled_codes.reserve(s_active_codes.size());
+  for (const ARCode& code : s_active_codes)
+    s_compiled_codes.push_back(CompileCode(code));
+}
+
 // ----------------------
 // AR Remote Functions
 void ApplyCodes(const std::vector<ARCode>& codes)
@@ -123,6 +175,7 @@ void ApplyCodes(const std::vector<ARCode>& codes)
   std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                [](const ARCode& code) { return code.enabled; });
   s_active_codes.shrink_to_fit();
+  CompileActiveCodes();
 }
 
 void SetSyncedCodesAsActive()
@@ -130,6 +183,7 @@ void SetSyncedCodesAsActive()
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
   s_active_codes = s_synced_codes;
+  CompileActiveCodes();
 }
 
 void UpdateSyncedCodes(const std::vector<ARCode>& codes)
@@ -150,6 +204,7 @@ std::vector<ARCode> ApplyAndReturnCodes(const std::vector<ARCode>& codes)
     s_active_codes.clear();
     std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                  [](const ARCode& code) { return code.enabled; });
+    CompileActiveCodes();
   }
   s_active_codes.shrink_to_fit();
 
@@ -165,6 +220,7 @@ void AddCode(ARCode code)
   {
     std::lock_guard guard(s_lock);
     s_disable_logging = false;
+    s_compiled_codes.push_back(CompileCode(code));
     s_active_codes.emplace_back(std::move(code));
   }
 }
@@ -819,7 +875,7 @@ static bool ConditionalCode(const ARAddr& addr, const u32 data, int* const pSkip
 }
 
 // NOTE: Lock needed to give mutual exclusion to s_current_code and LogInfo
-static bool RunCodeLocked(const ARCode& arcode)
+static bool RunCodeLocked(const ARCode& arcode, size_t first_entry = 0)
 {
   // The mechanism is different than what the real AR uses, so there may be compatibility problems.
 
@@ -836,8 +892,9 @@ static bool RunCodeLocked(const ARCode& arcode)
   LogInfo("Code Name: {}", arcode.name);
   LogInfo("Number of codes: {}", arcode.ops.size());
 
-  for (const AREntry& entry : arcode.ops)
+  for (size_t i = first_entry; i < arcode.ops.size(); ++i)
   {
+    const AREntry& entry = arcode.ops[i];
     const ARAddr addr(entry.cmd_addr);
     const u32 data = entry.value;
 
@@ -977,6 +1034,259 @@ static bool RunCodeLocked(const ARCode& arcode)
   return true;
 }
 
+static CompiledOp CompileLine(const ARCode& arcode, size_t index)
+{
+  const AREntry& entry = arcode.ops[index];
+  const ARAddr addr(entry.cmd_addr);
+  const u32 data = entry.value;
+  const u32 line_count = static_cast<u32>(arcode.ops.size());
+
+  CompiledOp op{CompiledOp::Type::Interpret};
+  op.address = addr.GCAddress();
+  op.data = data;
+
+  if (addr >= 0x00002000 && addr < 0x00003000)
+    return op;
+
+  if (0x0 == addr)
+  {
+    switch (data >> 29)
+    {
+    case ZCODE_END:
+      op.type = CompiledOp::Type::End;
+      break;
+
+    case ZCODE_NORM:
+      op.type = CompiledOp::Type::Nop;
+      break;
+
+    case ZCODE_04:
+    {
+      // Leave the checks of the parameter line to the interpreter, as they fail either way
+      if (index + 1 < arcode.ops.size() && 0x3 == ((data >> 25) & 0x03))
+      {
+        if ((arcode.ops[index + 1].value & 0xFF0000) == 0)
+          op.type = CompiledOp::Type::MemoryCopy;
+      }
+      else if (index + 1 < arcode.ops.size())
+      {
+        if (ARAddr(data).size != DATATYPE_32BIT_FLOAT)
+          op.type = CompiledOp::Type::FillAndSlide;
+      }
+      else
+      {
+        // Without a parameter line, there is nothing left to do
+        op.type = CompiledOp::Type::End;
+      }
+      break;
+    }
+    }
+    return op;
+  }
+
+  if (addr.type == 0x00)
+  {
+    static constexpr std::array<CompiledOp::Type, 4> ram_writes{
+        CompiledOp::Type::RamWrite8, CompiledOp::Type::RamWrite16, CompiledOp::Type::RamWrite32,
+        CompiledOp::Type::RamWrite32};
+    static constexpr std::array<CompiledOp::Type, 4> pointer_writes{
+        CompiledOp::Type::PointerWrite8, CompiledOp::Type::PointerWrite16,
+        CompiledOp::Type::PointerWrite32, CompiledOp::Type::PointerWrite32};
+    static constexpr std::array<CompiledOp::Type, 4> adds{
+        CompiledOp::Type::Add8, CompiledOp::Type::Add16, CompiledOp::Type::Add32,
+        CompiledOp::Type::AddFloat};
+
+    switch (addr.subtype)
+    {
+    case SUB_RAM_WRITE:
+      op.type = ram_writes[addr.size];
+      break;
+    case SUB_WRITE_POINTER:
+      op.type = pointer_writes[addr.size];
+      break;
+    case SUB_ADD_CODE:
+      op.type = adds[addr.size];
+      break;
+    }
+    return op;
+  }
+
+  // Conditional codes
+  switch (addr.size)
+  {
+  case DATATYPE_8BIT:
+    op.type = CompiledOp::Type::Compare8;
+    op.data = data & 0xFF;
+    break;
+  case DATATYPE_16BIT:
+    op.type = CompiledOp::Type::Compare16;
+    op.data = data & 0xFFFF;
+    break;
+  default:
+    op.type = CompiledOp::Type::Compare32;
+    break;
+  }
+  op.compare_type = static_cast<u8>(addr.type);
+
+  // Resolve where a failed comparison continues. The skipped lines are counted as lines of the
+  // code, even if they are the parameters of another line.
+  switch (addr.subtype)
+  {
+  case CONDTIONAL_ONE_LINE:
+  case CONDTIONAL_TWO_LINES:
+    op.skip_to = std::min<u32>(static_cast<u32>(index) + 2 + addr.subtype, line_count);
+    break;
+
+  case CONDTIONAL_ALL_LINES_UNTIL:
+  {
+    op.skip_to = line_count;
+    for (size_t i = index + 1; i < arcode.ops.size(); ++i)
+    {
+      if (arcode.ops[i].cmd_addr == 0 && arcode.ops[i].value == 0x40000000)
+      {
+        op.skip_to = static_cast<u32>(i + 1);
+        break;
+      }
+    }
+    break;
+  }
+
+  case CONDTIONAL_ALL_LINES:
+    op.skip_to = line_count;
+    break;
+  }
+
+  return op;
+}
+
+static std::vector<CompiledOp> CompileCode(const ARCode& arcode)
+{
+  // One op per line, so that conditional codes can skip to any of them
+  std::vector<CompiledOp> ops;
+  ops.reserve(arcode.ops.size());
+  for (size_t i = 0; i < arcode.ops.size(); ++i)
+    ops.push_back(CompileLine(arcode, i));
+  return ops;
+}
+
+// Most codes hold values in place, so what they write is usually already there from the frame
+// before and doesn't need writing again.
+template <typename T>
+static void WriteIfChanged(T (*read)(u32), void (*write)(u32, u32), u32 value, u32 address)
+{
+  if (read(address) != static_cast<T>(value))
+    write(value, address);
+}
+
+static bool RunCompiledCodeLocked(const ARCode& arcode, const std::vector<CompiledOp>& ops)
+{
+  s_current_code = &arcode;
+
+  size_t i = 0;
+  while (i < ops.size())
+  {
+    const CompiledOp& op = ops[i];
+    const u32 data = op.data;
+
+    switch (op.type)
+    {
+    case CompiledOp::Type::RamWrite8:
+      for (u32 j = 0; j <= data >> 8; ++j)
+        WriteIfChanged(PowerPC::HostRead_U8, PowerPC::HostWrite_U8, data & 0xFF, op.address + j);
+      break;
+
+    case CompiledOp::Type::RamWrite16:
+      for (u32 j = 0; j <= data >> 16; ++j)
+      {
+        WriteIfChanged(PowerPC::HostRead_U16, PowerPC::HostWrite_U16, data & 0xFFFF,
+                       op.address + j * 2);
+      }
+      break;
+
+    case CompiledOp::Type::RamWrite32:
+      WriteIfChanged(PowerPC::HostRead_U32, PowerPC::HostWrite_U32, data, op.address);
+      break;
+
+    case CompiledOp::Type::PointerWrite8:
+      WriteIfChanged(PowerPC::HostRead_U8, PowerPC::HostWrite_U8, data & 0xFF,
+                     PowerPC::HostRead_U32(op.address) + (data >> 8));
+      break;
+
+    case CompiledOp::Type::PointerWrite16:
+      WriteIfChanged(PowerPC::HostRead_U16, PowerPC::HostWrite_U16, data & 0xFFFF,
+                     PowerPC::HostRead_U32(op.address) + ((data >> 16) << 1));
+      break;
+
+    case CompiledOp::Type::PointerWrite32:
+      WriteIfChanged(PowerPC::HostRead_U32, PowerPC::HostWrite_U32, data,
+                     PowerPC::HostRead_U32(op.address));
+      break;
+
+    case CompiledOp::Type::Add8:
+      PowerPC::HostWrite_U8(PowerPC::HostRead_U8(op.address) + data, op.address);
+      break;
+
+    case CompiledOp::Type::Add16:
+      PowerPC::HostWrite_U16(PowerPC::HostRead_U16(op.address) + data, op.address);
+      break;
+
+    case CompiledOp::Type::Add32:
+      PowerPC::HostWrite_U32(PowerPC::HostRead_U32(op.address) + data, op.address);
+      break;
+
+    case CompiledOp::Type::AddFloat:
+    {
+      const float value = Common::BitCast<float>(PowerPC::HostRead_U32(op.address));
+      PowerPC::HostWrite_U32(Common::BitCast<u32>(value + static_cast<float>(data)), op.address);
+      break;
+    }
+
+    case CompiledOp::Type::Compare8:
+    case CompiledOp::Type::Compare16:
+    case CompiledOp::Type::Compare32:
+    {
+      u32 value;
+      if (op.type == CompiledOp::Type::Compare8)
+        value = PowerPC::HostRead_U8(op.address);
+      else if (op.type == CompiledOp::Type::Compare16)
+        value = PowerPC::HostRead_U16(op.address);
+      else
+        value = PowerPC::HostRead_U32(op.address);
+
+      if (!CompareValues(value, data, op.compare_type))
+      {
+        i = op.skip_to;
+        continue;
+      }
+      break;
+    }
+
+    case CompiledOp::Type::FillAndSlide:
+      ZeroCode_FillAndSlide(data, arcode.ops[i + 1].cmd_addr, arcode.ops[i + 1].value);
+      i += 2;
+      continue;
+
+    case CompiledOp::Type::MemoryCopy:
+      ZeroCode_MemoryCopy(data, arcode.ops[i + 1].cmd_addr, arcode.ops[i + 1].value);
+      i += 2;
+      continue;
+
+    case CompiledOp::Type::Nop:
+      break;
+
+    case CompiledOp::Type::End:
+      return true;
+
+    case CompiledOp::Type::Interpret:
+      return RunCodeLocked(arcode, i);
+    }
+
+    ++i;
+  }
+
+  return true;
+}
+
 void RunAllActive()
 {
   if (!Config::Get(Config::MAIN_ENABLE_CHEATS))
@@ -986,13 +1296,26 @@ void RunAllActive()
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard guard(s_lock);
-  s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [](const ARCode& code) {
-                                        bool success = RunCodeLocked(code);
-                                        LogInfo("\n");
-                                        return !success;
-                                      }),
-                       s_active_codes.end());
+  for (size_t i = 0; i < s_active_codes.size();)
+  {
+    // The first run after the codes changed is logged, which only the interpreter does
+    bool success;
+    if (s_disable_logging)
+      success = RunCompiledCodeLocked(s_active_codes[i], s_compiled_codes[i]);
+    else
+      success = RunCodeLocked(s_active_codes[i]);
+    LogInfo("\n");
+
+    if (success)
+    {
+      ++i;
+    }
+    else
+    {
+      s_active_codes.erase(s_active_codes.begin() + i);
+      s_compiled_codes.erase(s_compiled_codes.begin() + i);
+    }
+  }
   s_disable_logging = true;
 }
 
@@ -3,7 +3,10 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -13,8 +16,11 @@
 #include <vector>
 
 #include "Common/Align.h"
+#include "Common/BitSet.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -100,151 +106,399 @@ std::vector<u8> Cheats::GetValueAsByteVector(const Cheats::SearchValue& value)
 
 namespace
 {
-template <typename T>
-static std::optional<PowerPC::ReadResult<T>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space);
+constexpr u32 PAGE_SIZE = static_cast<u32>(PowerPC::HW_PAGE_SIZE);
+
+// Bytes of a snapshot that one worker compares at a time.
+constexpr u64 SCAN_JOB_SIZE = 256 * 1024;
+
+// Previous results one worker refreshes at a time.
+constexpr size_t REFRESH_JOB_SIZE = 16 * 1024;
+
+// Values that are decoded and compared together. Each pass over a batch is a plain loop the
+// compiler can vectorize.
+constexpr size_t SCAN_BATCH_SIZE = 256;
+
+// A host copy of a stretch of emulated memory, taken on the CPU thread so that the comparisons
+// can run on other threads while emulation continues.
+struct MemorySnapshot
+{
+  u32 m_start = 0;
+  std::vector<u8> m_data;
+  // One entry per page overlapping the snapshot, counted from the page containing m_start.
+  std::vector<u8> m_page_valid;
+  bool m_translated = false;
+
+  bool IsReadable(u64 offset, u64 size) const
+  {
+    const u64 first = (m_start & PowerPC::HW_PAGE_MASK) + offset;
+    const u64 last = first + size - 1;
+    for (u64 page = first / PAGE_SIZE; page <= last / PAGE_SIZE; ++page)
+    {
+      if (!m_page_valid[page])
+        return false;
+    }
+    return true;
+  }
+};
 
-template <>
-std::optional<PowerPC::ReadResult<u8>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+// Copies the given range, translating its address once per page. Bytes of pages that aren't
+// backed by RAM are left zero and marked as not readable.
+MemorySnapshot TakeSnapshot(u32 start, u64 length, PowerPC::RequestedAddressSpace space)
 {
-  return PowerPC::HostTryReadU8(addr, space);
+  MemorySnapshot snapshot;
+  snapshot.m_start = start;
+  snapshot.m_data.resize(length);
+  snapshot.m_page_valid.reserve(((start & PowerPC::HW_PAGE_MASK) + length) / PAGE_SIZE + 1);
+  for (u64 offset = 0; offset < length;)
+  {
+    const u32 address = static_cast<u32>(start + offset);
+    const u64 size = std::min<u64>(length - offset, PAGE_SIZE - (address & PowerPC::HW_PAGE_MASK));
+    const auto page = PowerPC::HostTryGetPagePointer(address, space);
+    if (page)
+    {
+      std::memcpy(snapshot.m_data.data() + offset, page->value, size);
+      snapshot.m_translated = page->translated;
+    }
+    snapshot.m_page_valid.push_back(page.has_value());
+    offset += size;
+  }
+  return snapshot;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u16>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+// Which values of a snapshot a worker handles, by their index in the snapshot's list of candidate
+// addresses.
+struct ScanJob
+{
+  size_t range;
+  size_t begin;
+  size_t end;
+};
+
+template <typename T>
+std::vector<Cheats::SearchResult<T>>
+MergeJobResults(std::vector<std::vector<Cheats::SearchResult<T>>>& job_results)
 {
-  return PowerPC::HostTryReadU16(addr, space);
+  size_t total = 0;
+  for (const auto& results : job_results)
+    total += results.size();
+
+  std::vector<Cheats::SearchResult<T>> results;
+  results.reserve(total);
+  for (const auto& job : job_results)
+    results.insert(results.end(), job.begin(), job.end());
+  return results;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u32>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+template <typename T>
+T ReadValue(const u8* data)
 {
-  return PowerPC::HostTryReadU32(addr, space);
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u64>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+Cheats::SearchResultValueState GetValueState(const MemorySnapshot& snapshot)
 {
-  return PowerPC::HostTryReadU64(addr, space);
+  return snapshot.m_translated ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                 Cheats::SearchResultValueState::ValueFromPhysicalMemory;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s8>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+Cheats::SearchErrorCode CheckCanAccessMemory(PowerPC::RequestedAddressSpace address_space)
 {
-  auto tmp = PowerPC::HostTryReadU8(addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s8>(tmp->translated, Common::BitCast<s8>(tmp->value));
+  const Core::State core_state = Core::GetState();
+  if (core_state != Core::State::Running && core_state != Core::State::Paused)
+    return Cheats::SearchErrorCode::NoEmulationActive;
+
+  if (address_space == PowerPC::RequestedAddressSpace::Virtual && !MSR.DR)
+    return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
+
+  return Cheats::SearchErrorCode::Success;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s16>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+template <typename Function>
+void ForEachSetBit(const std::vector<u64>& bits, size_t first_word, size_t end_word,
+                   const Function& function)
 {
-  auto tmp = PowerPC::HostTryReadU16(addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s16>(tmp->translated, Common::BitCast<s16>(tmp->value));
+  for (size_t i = first_word; i < end_word; ++i)
+  {
+    for (u64 word = bits[i]; word != 0; word &= word - 1)
+      function(i * 64 + Common::LeastSignificantSetBit(word));
+  }
 }
+}  // namespace
 
-template <>
-std::optional<PowerPC::ReadResult<s32>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+// A result set kept as a copy of the searched memory and one bit per candidate address. While most
+// addresses still match, this takes a fraction of the memory of a SearchResult per address.
+struct Cheats::DenseSearchResults
 {
-  auto tmp = PowerPC::HostTryReadU32(addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s32>(tmp->translated, Common::BitCast<s32>(tmp->value));
+  struct Range
+  {
+    MemorySnapshot m_snapshot;
+    // Bit i is set if the value at offset i * m_stride of the snapshot is a result.
+    std::vector<u64> m_bits;
+    // The number of results in the words of m_bits before each word, to find results by index.
+    std::vector<u32> m_rank;
+    size_t m_first_result = 0;
+  };
+
+  std::vector<Range> m_ranges;
+  u32 m_stride = 1;
+  size_t m_result_count = 0;
+  size_t m_valid_count = 0;
+};
+
+namespace
+{
+// Values whose bits are all in one word are always handled by the same worker.
+static_assert(SCAN_JOB_SIZE % (64 * sizeof(u64)) == 0);
+
+size_t GetMemoryUsage(const Cheats::DenseSearchResults& results)
+{
+  size_t usage = 0;
+  for (const Cheats::DenseSearchResults::Range& range : results.m_ranges)
+  {
+    usage += range.m_snapshot.m_data.size() + range.m_snapshot.m_page_valid.size() +
+             range.m_bits.size() * sizeof(u64) + range.m_rank.size() * sizeof(u32);
+  }
+  return usage;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s64>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+// Fills in the counts and lookup tables once the bitmaps of all ranges are final.
+void FinishDenseResults(Cheats::DenseSearchResults* results, u32 data_size)
 {
-  auto tmp = PowerPC::HostTryReadU64(addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s64>(tmp->translated, Common::BitCast<s64>(tmp->value));
+  results->m_result_count = 0;
+  results->m_valid_count = 0;
+  for (Cheats::DenseSearchResults::Range& range : results->m_ranges)
+  {
+    range.m_first_result = results->m_result_count;
+    range.m_rank.resize(range.m_bits.size());
+    u32 count = 0;
+    for (size_t i = 0; i < range.m_bits.size(); ++i)
+    {
+      range.m_rank[i] = count;
+      count += Common::CountSetBits(range.m_bits[i]);
+    }
+    results->m_result_count += count;
+
+    const std::vector<u8>& pages = range.m_snapshot.m_page_valid;
+    if (std::all_of(pages.begin(), pages.end(), [](u8 valid) { return valid != 0; }))
+    {
+      results->m_valid_count += count;
+      continue;
+    }
+    ForEachSetBit(range.m_bits, 0, range.m_bits.size(), [&](size_t i) {
+      if (range.m_snapshot.IsReadable(u64(i) * results->m_stride, data_size))
+        ++results->m_valid_count;
+    });
+  }
 }
 
-template <>
-std::optional<PowerPC::ReadResult<float>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+template <typename T>
+Cheats::SearchResult<T> MakeResult(const MemorySnapshot& snapshot, u64 offset)
 {
-  return PowerPC::HostTryReadF32(addr, space);
+  Cheats::SearchResult<T> r{};
+  r.m_address = static_cast<u32>(snapshot.m_start + offset);
+  if (snapshot.IsReadable(offset, sizeof(T)))
+  {
+    r.m_value = ReadValue<T>(snapshot.m_data.data() + offset);
+    r.m_value_state = GetValueState(snapshot);
+  }
+  else
+  {
+    r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
+  }
+  return r;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<double>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+template <typename T>
+Cheats::SearchResult<T> GetDenseResult(const Cheats::DenseSearchResults& results, size_t index)
 {
-  return PowerPC::HostTryReadF64(addr, space);
+  using Range = Cheats::DenseSearchResults::Range;
+  const auto range =
+      std::prev(std::upper_bound(results.m_ranges.begin(), results.m_ranges.end(), index,
+                                 [](size_t i, const Range& r) { return i < r.m_first_result; }));
+  const u32 rank = static_cast<u32>(index - range->m_first_result);
+  const auto word = std::prev(std::upper_bound(range->m_rank.begin(), range->m_rank.end(), rank));
+  const size_t word_index = word - range->m_rank.begin();
+  u64 bits = range->m_bits[word_index];
+  for (u32 i = *word; i < rank; ++i)
+    bits &= bits - 1;
+
+  const size_t value_index = word_index * 64 + Common::LeastSignificantSetBit(bits);
+  return MakeResult<T>(range->m_snapshot, u64(value_index) * results.m_stride);
 }
-}  // namespace
 
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+std::vector<Cheats::SearchResult<T>> ToSparseResults(const Cheats::DenseSearchResults& results)
 {
-  const u32 data_size = sizeof(T);
-  std::vector<Cheats::SearchResult<T>> results;
-  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
-  Core::RunAsCPUThread([&] {
-    const Core::State core_state = Core::GetState();
-    if (core_state != Core::State::Running && core_state != Core::State::Paused)
+  std::vector<Cheats::SearchResult<T>> sparse;
+  sparse.reserve(results.m_result_count);
+  for (const Cheats::DenseSearchResults::Range& range : results.m_ranges)
+  {
+    ForEachSetBit(range.m_bits, 0, range.m_bits.size(), [&](size_t i) {
+      sparse.push_back(MakeResult<T>(range.m_snapshot, u64(i) * results.m_stride));
+    });
+  }
+  return sparse;
+}
+
+// Compares the values with the given indices in a snapshot, the value at index i being at offset
+// i * stride, and sets the bits of the ones that match. The values are decoded one batch at a time
+// and then compared in a second pass, so that with an inlinable validator both passes vectorize.
+template <typename T, typename Validator>
+void ScanSnapshot(Cheats::DenseSearchResults::Range* range, size_t begin, size_t end, u32 stride,
+                  const Validator& validator)
+{
+  const MemorySnapshot& snapshot = range->m_snapshot;
+  u64* bits = range->m_bits.data();
+  std::array<T, SCAN_BATCH_SIZE> values;
+  std::array<u8, SCAN_BATCH_SIZE> matches;
+  for (size_t batch = begin; batch < end; batch += SCAN_BATCH_SIZE)
+  {
+    const size_t count = std::min(SCAN_BATCH_SIZE, end - batch);
+    const u64 batch_offset = u64(batch) * stride;
+    const u8* data = snapshot.m_data.data() + batch_offset;
+    for (size_t i = 0; i < count; ++i)
+      values[i] = ReadValue<T>(data + i * stride);
+    for (size_t i = 0; i < count; ++i)
+      matches[i] = validator(values[i]);
+
+    if (snapshot.IsReadable(batch_offset, (count - 1) * stride + sizeof(T)))
     {
-      error_code = Cheats::SearchErrorCode::NoEmulationActive;
-      return;
+      for (size_t i = 0; i < count; ++i)
+        bits[(batch + i) / 64] |= u64(matches[i]) << ((batch + i) % 64);
+      continue;
     }
 
-    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !MSR.DR)
+    for (size_t i = 0; i < count; ++i)
     {
-      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
-      return;
+      if (matches[i] && snapshot.IsReadable(batch_offset + i * stride, sizeof(T)))
+        bits[(batch + i) / 64] |= u64(1) << ((batch + i) % 64);
     }
+  }
+}
+
+template <typename T, typename Validator>
+Common::Result<Cheats::SearchErrorCode, Cheats::DenseSearchResults>
+NewSearchImpl(const std::vector<Cheats::MemoryRange>& memory_ranges,
+              PowerPC::RequestedAddressSpace address_space, bool aligned,
+              const Validator& validator)
+{
+  const u32 data_size = sizeof(T);
+  Cheats::DenseSearchResults results;
+  results.m_stride = aligned ? data_size : 1;
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
+  Core::RunAsCPUThread([&] {
+    error_code = CheckCanAccessMemory(address_space);
+    if (error_code != Cheats::SearchErrorCode::Success)
+      return;
 
     for (const Cheats::MemoryRange& range : memory_ranges)
     {
       if (range.m_length < data_size)
         continue;
 
-      const u32 increment_per_loop = aligned ? data_size : 1;
       const u32 start_address = aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
       const u64 aligned_length = range.m_length - (start_address - range.m_start);
 
       if (aligned_length < data_size)
         continue;
 
-      const u64 length = aligned_length - (data_size - 1);
-      for (u64 i = 0; i < length; i += increment_per_loop)
+      results.m_ranges.emplace_back().m_snapshot =
+          TakeSnapshot(start_address, aligned_length, address_space);
+    }
+  });
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
+
+  std::vector<ScanJob> jobs;
+  const size_t values_per_job = SCAN_JOB_SIZE / results.m_stride;
+  for (size_t i = 0; i < results.m_ranges.size(); ++i)
+  {
+    Cheats::DenseSearchResults::Range& range = results.m_ranges[i];
+    const u64 length = range.m_snapshot.m_data.size() - (data_size - 1);
+    const size_t value_count = (length + results.m_stride - 1) / results.m_stride;
+    range.m_bits.resize((value_count + 63) / 64);
+    for (size_t begin = 0; begin < value_count; begin += values_per_job)
+      jobs.push_back({i, begin, std::min(begin + values_per_job, value_count)});
+  }
+
+  Common::ParallelFor(jobs.size(), [&](size_t i) {
+    ScanSnapshot<T>(&results.m_ranges[jobs[i].range], jobs[i].begin, jobs[i].end,
+                    results.m_stride, validator);
+  });
+  FinishDenseResults(&results, data_size);
+  return results;
+}
+
+// Refreshes a dense result set against a new copy of the same memory. Like NextSearch, results
+// that were or have become inaccessible are kept.
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, Cheats::DenseSearchResults>
+NextSearchDense(const Cheats::DenseSearchResults& previous,
+                PowerPC::RequestedAddressSpace address_space,
+                const std::function<bool(const T& new_value, const T& old_value)>& validator)
+{
+  Cheats::DenseSearchResults results;
+  results.m_stride = previous.m_stride;
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
+  Core::RunAsCPUThread([&] {
+    error_code = CheckCanAccessMemory(address_space);
+    if (error_code != Cheats::SearchErrorCode::Success)
+      return;
+
+    for (const Cheats::DenseSearchResults::Range& previous_range : previous.m_ranges)
+    {
+      const MemorySnapshot& snapshot = previous_range.m_snapshot;
+      Cheats::DenseSearchResults::Range& range = results.m_ranges.emplace_back();
+      range.m_snapshot = TakeSnapshot(snapshot.m_start, snapshot.m_data.size(), address_space);
+      range.m_bits.resize(previous_range.m_bits.size());
+    }
+  });
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
+
+  std::vector<ScanJob> jobs;
+  const size_t words_per_job = SCAN_JOB_SIZE / results.m_stride / 64;
+  for (size_t i = 0; i < results.m_ranges.size(); ++i)
+  {
+    const size_t word_count = results.m_ranges[i].m_bits.size();
+    for (size_t begin = 0; begin < word_count; begin += words_per_job)
+      jobs.push_back({i, begin, std::min(begin + words_per_job, word_count)});
+  }
+
+  Common::ParallelFor(jobs.size(), [&](size_t job_index) {
+    const ScanJob& job = jobs[job_index];
+    const Cheats::DenseSearchResults::Range& previous_range = previous.m_ranges[job.range];
+    Cheats::DenseSearchResults::Range& range = results.m_ranges[job.range];
+    const MemorySnapshot& old_snapshot = previous_range.m_snapshot;
+    const MemorySnapshot& new_snapshot = range.m_snapshot;
+    ForEachSetBit(previous_range.m_bits, job.begin, job.end, [&](size_t i) {
+      const u64 offset = u64(i) * results.m_stride;
+      if (!new_snapshot.IsReadable(offset, sizeof(T)) ||
+          !old_snapshot.IsReadable(offset, sizeof(T)) ||
+          validator(ReadValue<T>(new_snapshot.m_data.data() + offset),
+                    ReadValue<T>(old_snapshot.m_data.data() + offset)))
       {
-        const u32 addr = start_address + i;
-        const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
-        if (!current_value)
-          continue;
-
-        if (validator(current_value->value))
-        {
-          auto& r = results.emplace_back();
-          r.m_value = current_value->value;
-          r.m_value_state = current_value->translated ?
-                                Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                                Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-          r.m_address = addr;
-        }
+        range.m_bits[i / 64] |= u64(1) << (i % 64);
       }
-    }
+    });
   });
-  if (error_code == Cheats::SearchErrorCode::Success)
-    return results;
-  return error_code;
+  FinishDenseResults(&results, sizeof(T));
+  return results;
+}
+}  // namespace
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Cheats::NewSearch(const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const T& value)>& validator)
+{
+  const auto results = NewSearchImpl<T>(memory_ranges, address_space, aligned, validator);
+  if (!results.Succeeded())
+    return results.Error();
+  return ToSparseResults<T>(*results);
 }
 
 template <typename T>
@@ -253,27 +507,60 @@ Cheats::NextSearch(const std::vector<Cheats::SearchResult<T>>& previous_results,
                    PowerPC::RequestedAddressSpace address_space,
                    const std::function<bool(const T& new_value, const T& old_value)>& validator)
 {
-  std::vector<Cheats::SearchResult<T>> results;
+  // Neighbouring results share a snapshot, as long as the memory between them is small enough
+  // that copying it is cheaper than translating another address.
+  struct Span
+  {
+    u64 start;
+    u64 end;
+    size_t first_result;
+  };
+  std::vector<Span> spans;
+  for (size_t i = 0; i < previous_results.size(); ++i)
+  {
+    const u64 address = previous_results[i].m_address;
+    if (!spans.empty() && address >= spans.back().start && address <= spans.back().end + PAGE_SIZE)
+      spans.back().end = std::max(spans.back().end, address + sizeof(T));
+    else
+      spans.push_back({address, address + sizeof(T), i});
+  }
+
+  std::vector<MemorySnapshot> snapshots;
   Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
   Core::RunAsCPUThread([&] {
-    const Core::State core_state = Core::GetState();
-    if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    {
-      error_code = Cheats::SearchErrorCode::NoEmulationActive;
+    error_code = CheckCanAccessMemory(address_space);
+    if (error_code != Cheats::SearchErrorCode::Success)
       return;
-    }
 
-    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !MSR.DR)
+    snapshots.reserve(spans.size());
+    for (const Span& span : spans)
     {
-      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
-      return;
+      snapshots.push_back(
+          TakeSnapshot(static_cast<u32>(span.start), span.end - span.start, address_space));
     }
+  });
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
 
-    for (const auto& previous_result : previous_results)
+  std::vector<ScanJob> jobs;
+  for (size_t i = 0; i < spans.size(); ++i)
+  {
+    const size_t end = i + 1 < spans.size() ? spans[i + 1].first_result : previous_results.size();
+    for (size_t begin = spans[i].first_result; begin < end; begin += REFRESH_JOB_SIZE)
+      jobs.push_back({i, begin, std::min(begin + REFRESH_JOB_SIZE, end)});
+  }
+
+  std::vector<std::vector<Cheats::SearchResult<T>>> job_results(jobs.size());
+  Common::ParallelFor(jobs.size(), [&](size_t job_index) {
+    const ScanJob& job = jobs[job_index];
+    const MemorySnapshot& snapshot = snapshots[job.range];
+    auto& results = job_results[job_index];
+    for (size_t i = job.begin; i < job.end; ++i)
     {
+      const auto& previous_result = previous_results[i];
       const u32 addr = previous_result.m_address;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
-      if (!current_value)
+      const u64 offset = addr - snapshot.m_start;
+      if (!snapshot.IsReadable(offset, sizeof(T)))
       {
         auto& r = results.emplace_back();
         r.m_address = addr;
@@ -283,21 +570,17 @@ Cheats::NextSearch(const std::vector<Cheats::SearchResult<T>>& previous_results,
 
       // if the previous state was invalid we always update the value to avoid getting stuck in an
       // invalid state
-      if (!previous_result.IsValueValid() ||
-          validator(current_value->value, previous_result.m_value))
+      const T current_value = ReadValue<T>(snapshot.m_data.data() + offset);
+      if (!previous_result.IsValueValid() || validator(current_value, previous_result.m_value))
       {
         auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+        r.m_value = current_value;
+        r.m_value_state = GetValueState(snapshot);
         r.m_address = addr;
       }
     }
   });
-  if (error_code == Cheats::SearchErrorCode::Success)
-    return results;
-  return error_code;
+  return MergeJobResults(job_results);
 }
 
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
@@ -373,6 +656,7 @@ void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
   m_search_results.clear();
+  m_dense_results.reset();
 }
 
 template <typename T>
@@ -423,11 +707,59 @@ MakeCompareFunctionForLastValue(Cheats::CompareType op)
   }
 }
 
+// Calls the given function with the comparison as a function object rather than a
+// std::function, so that a new search over all of memory can inline it into its scan loop.
+template <typename T, typename Function>
+static auto WithCompareFunction(Cheats::CompareType op, const Function& function)
+{
+  switch (op)
+  {
+  case Cheats::CompareType::Equal:
+    return function(std::equal_to<T>());
+  case Cheats::CompareType::NotEqual:
+    return function(std::not_equal_to<T>());
+  case Cheats::CompareType::Less:
+    return function(std::less<T>());
+  case Cheats::CompareType::LessOrEqual:
+    return function(std::less_equal<T>());
+  case Cheats::CompareType::Greater:
+    return function(std::greater<T>());
+  case Cheats::CompareType::GreaterOrEqual:
+    return function(std::greater_equal<T>());
+  default:
+    assert(0);
+    return function(std::equal_to<T>());
+  }
+}
+
 template <typename T>
 Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch()
 {
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
-      Cheats::SearchErrorCode::InvalidParameters;
+  const auto new_search = [&](const auto& validator) {
+    auto results = NewSearchImpl<T>(m_memory_ranges, m_address_space, m_aligned, validator);
+    if (!results.Succeeded())
+      return results.Error();
+    SetDenseResults(std::move(*results));
+    return Cheats::SearchErrorCode::Success;
+  };
+  const auto next_search = [&](const std::function<bool(const T&, const T&)>& validator) {
+    if (m_dense_results)
+    {
+      auto results = NextSearchDense<T>(*m_dense_results, m_address_space, validator);
+      if (!results.Succeeded())
+        return results.Error();
+      SetDenseResults(std::move(*results));
+      return Cheats::SearchErrorCode::Success;
+    }
+
+    auto results = Cheats::NextSearch<T>(m_search_results, m_address_space, validator);
+    if (!results.Succeeded())
+      return results.Error();
+    m_search_results = std::move(*results);
+    return Cheats::SearchErrorCode::Success;
+  };
+
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::InvalidParameters;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
     if (!m_value)
@@ -436,13 +768,15 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch()
     auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
     if (m_first_search_done)
     {
-      result = Cheats::NextSearch<T>(
-          m_search_results, m_address_space,
+      error_code = next_search(
           [&func](const T& new_value, const T& old_value) { return func(new_value); });
     }
     else
     {
-      result = Cheats::NewSearch<T>(m_memory_ranges, m_address_space, m_aligned, func);
+      error_code = WithCompareFunction<T>(m_compare_type, [&](const auto& compare) {
+        const T& value = *m_value;
+        return new_search([&](const T& new_value) { return compare(new_value, value); });
+      });
     }
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
@@ -450,31 +784,44 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch()
     if (!m_first_search_done)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    result = Cheats::NextSearch<T>(m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
+    error_code = next_search(MakeCompareFunctionForLastValue<T>(m_compare_type));
   }
   else if (m_filter_type == FilterType::DoNotFilter)
   {
     if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
-    }
+      error_code = next_search([](const T& v1, const T& v2) { return true; });
     else
-    {
-      result = Cheats::NewSearch<T>(m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
-    }
+      error_code = new_search([](const T& v) { return true; });
   }
 
-  if (result.Succeeded())
-  {
-    m_search_results = std::move(*result);
+  if (error_code == Cheats::SearchErrorCode::Success)
     m_first_search_done = true;
-    return Cheats::SearchErrorCode::Success;
+  return error_code;
+}
+
+template <typename T>
+void Cheats::CheatSearchSession<T>::SetDenseResults(DenseSearchResults&& results)
+{
+  // Once few enough addresses are left, listing them takes less memory than the bitmaps do, and
+  // refreshing them no longer needs a copy of all of the searched memory.
+  if (results.m_result_count * sizeof(SearchResult<T>) > GetMemoryUsage(results))
+  {
+    m_dense_results = std::make_shared<const DenseSearchResults>(std::move(results));
+    m_search_results.clear();
+  }
+  else
+  {
+    m_search_results = ToSparseResults<T>(results);
+    m_dense_results.reset();
   }
+}
 
-  return result.Error();
+template <typename T>
+Cheats::SearchResult<T> Cheats::CheatSearchSession<T>::GetResult(size_t index) const
+{
+  if (m_dense_results)
+    return GetDenseResult<T>(*m_dense_results, index);
+  return m_search_results[index];
 }
 
 template <typename T>
@@ -522,12 +869,17 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
+  if (m_dense_results)
+    return m_dense_results->m_result_count;
   return m_search_results.size();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
+  if (m_dense_results)
+    return m_dense_results->m_valid_count;
+
   const auto& results = m_search_results;
   size_t count = 0;
   for (const auto& r : results)
@@ -541,45 +893,46 @@ size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
-  return m_search_results[index].m_address;
+  return GetResult(index).m_address;
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
-  return m_search_results[index].m_value;
+  return GetResult(index).m_value;
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{GetResultValue(index)};
 }
 
 template <typename T>
 std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index, bool hex) const
 {
-  if (GetResultValueState(index) == Cheats::SearchResultValueState::AddressNotAccessible)
+  const SearchResult<T> result = GetResult(index);
+  if (result.m_value_state == Cheats::SearchResultValueState::AddressNotAccessible)
     return "(inaccessible)";
 
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
-      return fmt::format("0x{0:08x}", Common::BitCast<u32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", Common::BitCast<u32>(result.m_value));
     else if constexpr (std::is_same_v<T, double>)
-      return fmt::format("0x{0:016x}", Common::BitCast<u64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", Common::BitCast<u64>(result.m_value));
     else
-      return fmt::format("0x{0:0{1}x}", m_search_results[index].m_value, sizeof(T) * 2);
+      return fmt::format("0x{0:0{1}x}", result.m_value, sizeof(T) * 2);
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", result.m_value);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
-  return m_search_results[index].m_value_state;
+  return GetResult(index).m_value_state;
 }
 
 template <typename T>
@@ -598,11 +951,10 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const std::vector<size_t>& result_indices) const
 {
-  const auto& results = m_search_results;
   std::vector<SearchResult<T>> partial_results;
   partial_results.reserve(result_indices.size());
   for (size_t idx : result_indices)
-    partial_results.push_back(results[idx]);
+    partial_results.push_back(GetResult(idx));
 
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
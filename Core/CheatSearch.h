@@ -105,7 +105,8 @@ DataType GetDataType(const SearchValue& value);
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
 // Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
+// for which the given validator returns true. The memory is copied on the CPU thread and then
+// searched on worker threads, so the validator may be called from several threads at once.
 template <typename T>
 Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
 NewSearch(const std::vector<MemoryRange>& memory_ranges,
@@ -113,13 +114,17 @@ NewSearch(const std::vector<MemoryRange>& memory_ranges,
           const std::function<bool(const T& value)>& validator);
 
 // Refresh the values for the given results in the given address space, only keeping values for
-// which the given validator returns true.
+// which the given validator returns true. Like NewSearch, this may call the validator from several
+// threads at once.
 template <typename T>
 Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
 NextSearch(const std::vector<SearchResult<T>>& previous_results,
            PowerPC::RequestedAddressSpace address_space,
            const std::function<bool(const T& new_value, const T& old_value)>& validator);
 
+// Results of a search over most of memory, stored as a copy of the memory and a bitmap.
+struct DenseSearchResults;
+
 class CheatSearchSessionBase
 {
 public:
@@ -209,7 +214,13 @@ public:
   ClonePartial(const std::vector<size_t>& result_indices) const override;
 
 private:
+  void SetDenseResults(DenseSearchResults&& results);
+  SearchResult<T> GetResult(size_t index) const;
+
+  // Results are kept in m_dense_results while they cover enough of memory that a bitmap is smaller
+  // than listing them, and in m_search_results after that.
   std::vector<SearchResult<T>> m_search_results;
+  std::shared_ptr<const DenseSearchResults> m_dense_results;
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
@@ -36,10 +36,15 @@ const Info<bool> MAIN_SKIP_IPL{{System::Main, "Core", "SkipIPL"}, true};
 const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
+const Info<bool> MAIN_JIT_HOT_BLOCK_RECOMPILE{{System::Main, "Core", "JITHotBlockRecompile"},
+                                              false};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
+const Info<bool> MAIN_HUGE_PAGES{{System::Main, "Core", "HugePages"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_TIMING_VARIANCE{{System::Main, "Core", "TimingVariance"}, 40};
+const Info<int> MAIN_THROTTLE_SPIN_BUDGET{{System::Main, "Core", "ThrottleSpinBudget"}, 0};
 const Info<bool> MAIN_CPU_THREAD{{System::Main, "Core", "CPUThread"}, true};
+const Info<bool> MAIN_PIN_THREADS{{System::Main, "Core", "PinThreads"}, false};
 const Info<bool> MAIN_SYNC_ON_SKIP_IDLE{{System::Main, "Core", "SyncOnSkipIdle"}, true};
 const Info<std::string> MAIN_DEFAULT_ISO{{System::Main, "Core", "DefaultISO"}, ""};
 const Info<bool> MAIN_ENABLE_CHEATS{{System::Main, "Core", "EnableCheats"}, false};
@@ -52,6 +57,8 @@ const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY{{System::Main, "Core", "D
 const Info<int> MAIN_AUDIO_LATENCY{{System::Main, "Core", "AudioLatency"}, 20};
 const Info<bool> MAIN_AUDIO_STRETCH{{System::Main, "Core", "AudioStretch"}, false};
 const Info<int> MAIN_AUDIO_STRETCH_LATENCY{{System::Main, "Core", "AudioStretchMaxLatency"}, 80};
+const Info<bool> MAIN_AUDIO_STRETCH_LOW_LATENCY{{System::Main, "Core", "AudioStretchLowLatency"},
+                                                false};
 const Info<std::string> MAIN_MEMCARD_A_PATH{{System::Main, "Core", "MemcardAPath"}, ""};
 const Info<std::string> MAIN_MEMCARD_B_PATH{{System::Main, "Core", "MemcardBPath"}, ""};
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot)
@@ -92,6 +99,26 @@ const Info<std::string>& GetInfoForGCIPathOverride(ExpansionInterface::Slot slot
 }
 
 const Info<int> MAIN_MEMORY_CARD_SIZE{{System::Main, "Core", "MemoryCardSize"}, -1};
+const Info<int> MAIN_MEMCARD_FLUSH_COALESCE_MS{
+    {System::Main, "Core", "MemcardFlushCoalesceMs"}, 1000};
+const Info<int> MAIN_MEMCARD_FLUSH_MAX_LATENCY_MS{
+    {System::Main, "Core", "MemcardFlushMaxLatencyMs"}, 15000};
+const Info<bool> MAIN_MEMCARD_FLUSH_ON_SAVE_COMPLETE{
+    {System::Main, "Core", "MemcardFlushOnSaveComplete"}, true};
+const Info<bool> MAIN_MEMCARD_FLUSH_FSYNC{{System::Main, "Core", "MemcardFlushFsync"}, false};
+const Info<bool> MAIN_MEMCARD_A_INSTANT_TRANSFER{{System::Main, "Core", "MemcardAInstantTransfer"},
+                                                 false};
+const Info<bool> MAIN_MEMCARD_B_INSTANT_TRANSFER{{System::Main, "Core", "MemcardBInstantTransfer"},
+                                                 false};
+const Info<bool>& GetInfoForMemcardInstantTransfer(ExpansionInterface::Slot slot)
+{
+  ASSERT(ExpansionInterface::IsMemcardSlot(slot));
+  static constexpr Common::EnumMap<const Info<bool>*, ExpansionInterface::MAX_MEMCARD_SLOT> infos{
+      &MAIN_MEMCARD_A_INSTANT_TRANSFER,
+      &MAIN_MEMCARD_B_INSTANT_TRANSFER,
+  };
+  return *infos[slot];
+}
 
 const Info<ExpansionInterface::EXIDeviceType> MAIN_SLOT_A{
     {System::Main, "Core", "SlotA"}, ExpansionInterface::EXIDeviceType::MemoryCardFolder};
@@ -142,6 +169,8 @@ const Info<bool>& GetInfoForAdapterRumble(int channel)
   return infos[channel];
 }
 
+const Info<bool> MAIN_ADAPTER_ALIGN_POLLS{{System::Main, "Core", "AdapterAlignPolls"}, false};
+
 const Info<bool>& GetInfoForSimulateKonga(int channel)
 {
   static const std::array<const Info<bool>, 4> infos{
@@ -161,12 +190,14 @@ const Info<bool> MAIN_WIIMOTE_ENABLE_SPEAKER{{System::Main, "Core", "WiimoteEnab
 const Info<bool> MAIN_CONNECT_WIIMOTES_FOR_CONTROLLER_INTERFACE{
     {System::Main, "Core", "WiimoteControllerInterface"}, false};
 const Info<bool> MAIN_MMU{{System::Main, "Core", "MMU"}, false};
+const Info<bool> MAIN_HLE_MEMORY_FUNCTIONS{{System::Main, "Core", "HLEMemoryFunctions"}, false};
 const Info<int> MAIN_BB_DUMP_PORT{{System::Main, "Core", "BBDumpPort"}, -1};
 const Info<bool> MAIN_SYNC_GPU{{System::Main, "Core", "SyncGPU"}, false};
 const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE{{System::Main, "Core", "SyncGpuMaxDistance"}, 200000};
 const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE{{System::Main, "Core", "SyncGpuMinDistance"}, -200000};
 const Info<float> MAIN_SYNC_GPU_OVERCLOCK{{System::Main, "Core", "SyncGpuOverclock"}, 1.0f};
 const Info<bool> MAIN_FAST_DISC_SPEED{{System::Main, "Core", "FastDiscSpeed"}, false};
+const Info<bool> MAIN_INSTANT_DISC{{System::Main, "Core", "InstantDisc"}, false};
 const Info<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"}, false};
 const Info<bool> MAIN_FLOAT_EXCEPTIONS{{System::Main, "Core", "FloatExceptions"}, false};
 const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS{{System::Main, "Core", "DivByZeroExceptions"},
@@ -270,6 +301,8 @@ const Info<bool> MAIN_SHOW_FRAME_COUNT{{System::Main, "General", "ShowFrameCount
 const Info<std::string> MAIN_WIRELESS_MAC{{System::Main, "General", "WirelessMac"}, ""};
 const Info<std::string> MAIN_GDB_SOCKET{{System::Main, "General", "GDBSocket"}, ""};
 const Info<int> MAIN_GDB_PORT{{System::Main, "General", "GDBPort"}, -1};
+const Info<bool> MAIN_MEMORY_WATCHER_BINARY{{System::Main, "General", "MemoryWatcherBinary"},
+                                            false};
 const Info<int> MAIN_ISO_PATH_COUNT{{System::Main, "General", "ISOPaths"}, 0};
 
 static Info<std::string> MakeISOPathConfigInfo(size_t idx)
@@ -331,6 +364,7 @@ const std::array<Info<std::string>, 4> MAIN_GBA_ROM_PATHS{
 const Info<std::string> MAIN_GBA_SAVES_PATH{{System::Main, "GBA", "SavesPath"}, ""};
 const Info<bool> MAIN_GBA_SAVES_IN_ROM_PATH{{System::Main, "GBA", "SavesInRomPath"}, false};
 const Info<bool> MAIN_GBA_THREADS{{System::Main, "GBA", "Threads"}, true};
+const Info<int> MAIN_GBA_SYNC_WINDOW{{System::Main, "GBA", "SyncWindow"}, 1000};
 #endif
 
 // Main.Network
@@ -449,6 +483,7 @@ const Info<bool> MAIN_MOVIE_SHOW_RERECORD{{System::Main, "Movie", "ShowRerecord"
 // Main.Input
 
 const Info<bool> MAIN_INPUT_BACKGROUND_INPUT{{System::Main, "Input", "BackgroundInput"}, false};
+const Info<u32> MAIN_INPUT_POLLING_RATE{{System::Main, "Input", "PollingRate"}, 0};
 
 // Main.Debug
 
@@ -473,6 +508,12 @@ const Info<bool> MAIN_DEBUG_JIT_SYSTEM_REGISTERS_OFF{
 const Info<bool> MAIN_DEBUG_JIT_BRANCH_OFF{{System::Main, "Debug", "JitBranchOff"}, false};
 const Info<bool> MAIN_DEBUG_JIT_REGISTER_CACHE_OFF{{System::Main, "Debug", "JitRegisterCacheOff"},
                                                    false};
+const Info<bool> MAIN_JIT_COVERAGE{{System::Main, "Debug", "JitCoverage"}, false};
+const Info<bool> MAIN_JIT_KEEP_BLOCKS_ON_STATE_LOAD{
+    {System::Main, "Debug", "JitKeepBlocksOnStateLoad"}, false};
+const Info<bool> MAIN_KEEP_BOOT_STATE{{System::Main, "Debug", "KeepBootState"}, false};
+const Info<bool> MAIN_BOOT_STATE_RAM_SNAPSHOT{{System::Main, "Debug", "BootStateRAMSnapshot"},
+                                              false};
 
 // Main.BluetoothPassthrough
 
@@ -54,11 +54,21 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+// Counts how often each block runs, and compiles the ones that run often again with more
+// branches followed into them.
+extern const Info<bool> MAIN_JIT_HOT_BLOCK_RECOMPILE;
 extern const Info<bool> MAIN_FASTMEM;
+// Backs guest memory with huge pages where the host allows it
+extern const Info<bool> MAIN_HUGE_PAGES;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
 extern const Info<int> MAIN_TIMING_VARIANCE;
+// Microseconds at the end of each throttle wait that are spent spinning instead of sleeping, which
+// makes the waits end on time at the cost of keeping the CPU thread busy. 0 only sleeps.
+extern const Info<int> MAIN_THROTTLE_SPIN_BUDGET;
 extern const Info<bool> MAIN_CPU_THREAD;
+// Pins the emulation threads to cores picked from the topology, see Common::PlaceCurrentThread
+extern const Info<bool> MAIN_PIN_THREADS;
 extern const Info<bool> MAIN_SYNC_ON_SKIP_IDLE;
 extern const Info<std::string> MAIN_DEFAULT_ISO;
 extern const Info<bool> MAIN_ENABLE_CHEATS;
@@ -69,6 +79,7 @@ extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const Info<bool> MAIN_AUDIO_STRETCH_LOW_LATENCY;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot);
@@ -79,6 +90,13 @@ extern const Info<std::string> MAIN_GCI_FOLDER_A_PATH_OVERRIDE;
 extern const Info<std::string> MAIN_GCI_FOLDER_B_PATH_OVERRIDE;
 const Info<std::string>& GetInfoForGCIPathOverride(ExpansionInterface::Slot slot);
 extern const Info<int> MAIN_MEMORY_CARD_SIZE;
+extern const Info<int> MAIN_MEMCARD_FLUSH_COALESCE_MS;
+extern const Info<int> MAIN_MEMCARD_FLUSH_MAX_LATENCY_MS;
+extern const Info<bool> MAIN_MEMCARD_FLUSH_ON_SAVE_COMPLETE;
+extern const Info<bool> MAIN_MEMCARD_FLUSH_FSYNC;
+extern const Info<bool> MAIN_MEMCARD_A_INSTANT_TRANSFER;
+extern const Info<bool> MAIN_MEMCARD_B_INSTANT_TRANSFER;
+const Info<bool>& GetInfoForMemcardInstantTransfer(ExpansionInterface::Slot slot);
 extern const Info<ExpansionInterface::EXIDeviceType> MAIN_SLOT_A;
 extern const Info<ExpansionInterface::EXIDeviceType> MAIN_SLOT_B;
 extern const Info<ExpansionInterface::EXIDeviceType> MAIN_SERIAL_PORT_1;
@@ -88,6 +106,7 @@ extern const Info<std::string> MAIN_BBA_XLINK_IP;
 extern const Info<bool> MAIN_BBA_XLINK_CHAT_OSD;
 const Info<SerialInterface::SIDevices>& GetInfoForSIDevice(int channel);
 const Info<bool>& GetInfoForAdapterRumble(int channel);
+extern const Info<bool> MAIN_ADAPTER_ALIGN_POLLS;
 const Info<bool>& GetInfoForSimulateKonga(int channel);
 extern const Info<bool> MAIN_WII_SD_CARD;
 extern const Info<bool> MAIN_WII_KEYBOARD;
@@ -95,12 +114,18 @@ extern const Info<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING;
 extern const Info<bool> MAIN_WIIMOTE_ENABLE_SPEAKER;
 extern const Info<bool> MAIN_CONNECT_WIIMOTES_FOR_CONTROLLER_INTERFACE;
 extern const Info<bool> MAIN_MMU;
+// Runs the guest's memcpy, memset and data cache range functions on the host when their symbols
+// are known. Not done with MMU or memory checks, whose accesses have to go one by one.
+extern const Info<bool> MAIN_HLE_MEMORY_FUNCTIONS;
 extern const Info<int> MAIN_BB_DUMP_PORT;
 extern const Info<bool> MAIN_SYNC_GPU;
 extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+// Finishes every disc read at the next scheduler slice, reading the disc on the CPU thread,
+// instead of emulating how long the drive takes. Not even close to accurate, for automation.
+extern const Info<bool> MAIN_INSTANT_DISC;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
@@ -183,6 +208,7 @@ extern const Info<bool> MAIN_SHOW_FRAME_COUNT;
 extern const Info<std::string> MAIN_WIRELESS_MAC;
 extern const Info<std::string> MAIN_GDB_SOCKET;
 extern const Info<int> MAIN_GDB_PORT;
+extern const Info<bool> MAIN_MEMORY_WATCHER_BINARY;
 extern const Info<int> MAIN_ISO_PATH_COUNT;
 std::vector<std::string> GetIsoPaths();
 void SetIsoPaths(const std::vector<std::string>& paths);
@@ -195,6 +221,10 @@ extern const std::array<Info<std::string>, 4> MAIN_GBA_ROM_PATHS;
 extern const Info<std::string> MAIN_GBA_SAVES_PATH;
 extern const Info<bool> MAIN_GBA_SAVES_IN_ROM_PATH;
 extern const Info<bool> MAIN_GBA_THREADS;
+// How often, in microseconds, the GBA cores are brought up to the emulated time while the games
+// aren't talking to them. Longer windows wake the GBA threads less often. NetPlay and movies
+// always use the default.
+extern const Info<int> MAIN_GBA_SYNC_WINDOW;
 #endif
 
 // Main.Network
@@ -301,6 +331,9 @@ extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
 // Main.Input
 
 extern const Info<bool> MAIN_INPUT_BACKGROUND_INPUT;
+// Polls the controllers on a thread of their own at this many times per second, 0 to poll them
+// whenever the game does.
+extern const Info<u32> MAIN_INPUT_POLLING_RATE;
 
 // Main.Debug
 
@@ -317,6 +350,14 @@ extern const Info<bool> MAIN_DEBUG_JIT_PAIRED_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_SYSTEM_REGISTERS_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_BRANCH_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_REGISTER_CACHE_OFF;
+extern const Info<bool> MAIN_JIT_COVERAGE;
+extern const Info<bool> MAIN_JIT_KEEP_BLOCKS_ON_STATE_LOAD;
+// Keeps the machine as it was when the title just booted reached its entry point, for
+// Core::WarmReboot().
+extern const Info<bool> MAIN_KEEP_BOOT_STATE;
+// Keeps RAM in the boot state as a copy-on-write snapshot, so going back to it only costs as much
+// as the pages written since. Needs MAIN_FASTMEM off.
+extern const Info<bool> MAIN_BOOT_STATE_RAM_SNAPSHOT;
 
 // Main.BluetoothPassthrough
 
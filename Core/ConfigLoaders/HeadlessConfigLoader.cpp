@@ -0,0 +1,59 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/ConfigLoaders/HeadlessConfigLoader.h"
+
+#include <memory>
+
+#include "Common/Config/Config.h"
+
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+
+namespace ConfigLoaders
+{
+class HeadlessThroughputConfigLayerLoader final : public Config::ConfigLayerLoader
+{
+public:
+  explicit HeadlessThroughputConfigLayerLoader(bool dual_core)
+      : ConfigLayerLoader(Config::LayerType::CommandLine), m_dual_core(dual_core)
+  {
+  }
+
+  void Load(Config::Layer* layer) override
+  {
+    layer->Set(Config::MAIN_EMULATION_SPEED, 0.0f);
+    layer->Set(Config::MAIN_CPU_THREAD, m_dual_core);
+    layer->Set(Config::MAIN_SYNC_GPU, false);
+    // Nothing waiting on the emulated drive makes for loading screens that are over in a blink
+    layer->Set(Config::MAIN_INSTANT_DISC, true);
+
+    // The null sound stream never pulls from the mixer, so once its FIFOs fill every push of
+    // samples returns straight away without copying anything.
+    layer->Set(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+    layer->Set(Config::MAIN_AUDIO_STRETCH, false);
+    layer->Set(Config::MAIN_DUMP_AUDIO, false);
+    layer->Set(Config::MAIN_DSP_HLE, true);
+
+    layer->Set(Config::MAIN_GFX_BACKEND, "Null");
+    layer->Set(Config::MAIN_OSD_MESSAGES, false);
+    layer->Set(Config::GFX_VSYNC, false);
+    layer->Set(Config::GFX_SHOW_FPS, false);
+    // Nothing is ever looked at, so only what the game waits on is taken from the FIFO
+    layer->Set(Config::GFX_HACK_SKIP_GPU, true);
+  }
+
+  void Save(Config::Layer* layer) override
+  {
+    // Do Nothing
+  }
+
+private:
+  const bool m_dual_core;
+};
+
+std::unique_ptr<Config::ConfigLayerLoader> GenerateHeadlessThroughputConfigLoader(bool dual_core)
+{
+  return std::make_unique<HeadlessThroughputConfigLayerLoader>(dual_core);
+}
+}  // namespace ConfigLoaders
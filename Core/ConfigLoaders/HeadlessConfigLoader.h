@@ -0,0 +1,20 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+
+namespace Config
+{
+class ConfigLayerLoader;
+}
+
+namespace ConfigLoaders
+{
+// A command line layer for automated runs that emulate as fast as the host allows: no throttling,
+// no audio output, no video output and no on-screen messages. Game INIs still take precedence,
+// so per-game compatibility settings such as SyncGPU keep applying. With dual_core unset the CPU
+// and GPU run on the same thread.
+std::unique_ptr<Config::ConfigLayerLoader> GenerateHeadlessThroughputConfigLoader(bool dual_core);
+}  // namespace ConfigLoaders
@@ -64,6 +64,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_AUDIO_LATENCY.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH_LATENCY.GetLocation(),
+      &Config::MAIN_AUDIO_STRETCH_LOW_LATENCY.GetLocation(),
       &Config::MAIN_OVERCLOCK.GetLocation(),
       &Config::MAIN_OVERCLOCK_ENABLE.GetLocation(),
       &Config::MAIN_RAM_OVERRIDE_ENABLE.GetLocation(),
@@ -86,6 +87,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_CUSTOM_RTC_ENABLE.GetLocation(),
       &Config::MAIN_CUSTOM_RTC_VALUE.GetLocation(),
       &Config::MAIN_JIT_FOLLOW_BRANCH.GetLocation(),
+      &Config::MAIN_JIT_HOT_BLOCK_RECOMPILE.GetLocation(),
       &Config::MAIN_FLOAT_EXCEPTIONS.GetLocation(),
       &Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS.GetLocation(),
       &Config::MAIN_LOW_DCBZ_HACK.GetLocation(),
@@ -95,6 +97,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::GetInfoForAdapterRumble(1).GetLocation(),
       &Config::GetInfoForAdapterRumble(2).GetLocation(),
       &Config::GetInfoForAdapterRumble(3).GetLocation(),
+      &Config::MAIN_ADAPTER_ALIGN_POLLS.GetLocation(),
       &Config::GetInfoForSimulateKonga(0).GetLocation(),
       &Config::GetInfoForSimulateKonga(1).GetLocation(),
       &Config::GetInfoForSimulateKonga(2).GetLocation(),
@@ -104,9 +107,13 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_GPU_DETERMINISM_MODE.GetLocation(),
       &Config::MAIN_DISABLE_ICACHE.GetLocation(),
       &Config::MAIN_FAST_DISC_SPEED.GetLocation(),
+      &Config::MAIN_INSTANT_DISC.GetLocation(),
       &Config::MAIN_SYNC_ON_SKIP_IDLE.GetLocation(),
       &Config::MAIN_FASTMEM.GetLocation(),
+      &Config::MAIN_HUGE_PAGES.GetLocation(),
       &Config::MAIN_TIMING_VARIANCE.GetLocation(),
+      &Config::MAIN_HLE_MEMORY_FUNCTIONS.GetLocation(),
+      &Config::MAIN_THROTTLE_SPIN_BUDGET.GetLocation(),
       &Config::MAIN_WII_SD_CARD.GetLocation(),
       &Config::MAIN_WII_KEYBOARD.GetLocation(),
       &Config::MAIN_WIIMOTE_CONTINUOUS_SCANNING.GetLocation(),
@@ -120,6 +127,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::GetInfoForSIDevice(2).GetLocation(),
       &Config::GetInfoForSIDevice(3).GetLocation(),
       &Config::MAIN_CPU_THREAD.GetLocation(),
+      &Config::MAIN_PIN_THREADS.GetLocation(),
       &Config::MAIN_MMU.GetLocation(),
       &Config::MAIN_BB_DUMP_PORT.GetLocation(),
       &Config::MAIN_SYNC_GPU.GetLocation(),
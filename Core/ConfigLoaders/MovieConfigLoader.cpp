@@ -30,6 +30,7 @@ static void LoadFromDTM(Config::Layer* config_layer, Movie::DTMHeader* dtm)
   config_layer->Set(Config::MAIN_CPU_THREAD, dtm->bDualCore);
   config_layer->Set(Config::MAIN_DSP_HLE, dtm->bDSPHLE);
   config_layer->Set(Config::MAIN_FAST_DISC_SPEED, dtm->bFastDiscSpeed);
+  config_layer->Set(Config::MAIN_INSTANT_DISC, dtm->bInstantDisc);
   config_layer->Set(Config::MAIN_CPU_CORE, static_cast<PowerPC::CPUCore>(dtm->CPUCore));
   config_layer->Set(Config::MAIN_SYNC_GPU, dtm->bSyncGPU);
   config_layer->Set(Config::MAIN_GFX_BACKEND, dtm->videoBackend.data());
@@ -50,6 +51,13 @@ static void LoadFromDTM(Config::Layer* config_layer, Movie::DTMHeader* dtm)
   config_layer->Set(Config::SESSION_USE_FMA, dtm->bUseFMA);
 
   config_layer->Set(Config::MAIN_JIT_FOLLOW_BRANCH, dtm->bFollowBranch);
+  // When blocks get recompiled depends on the JIT cache, not on the movie
+  config_layer->Set(Config::MAIN_JIT_HOT_BLOCK_RECOMPILE, false);
+  // Movies don't record it, and it changes how many cycles the game's memory functions take
+  config_layer->Set(Config::MAIN_HLE_MEMORY_FUNCTIONS, false);
+
+  config_layer->Set(Config::MAIN_MEMCARD_A_INSTANT_TRANSFER, (dtm->instantMemcards & 1) != 0);
+  config_layer->Set(Config::MAIN_MEMCARD_B_INSTANT_TRANSFER, (dtm->instantMemcards & 2) != 0);
 }
 
 void SaveToDTM(Movie::DTMHeader* dtm)
@@ -57,6 +65,7 @@ void SaveToDTM(Movie::DTMHeader* dtm)
   dtm->bDualCore = Config::Get(Config::MAIN_CPU_THREAD);
   dtm->bDSPHLE = Config::Get(Config::MAIN_DSP_HLE);
   dtm->bFastDiscSpeed = Config::Get(Config::MAIN_FAST_DISC_SPEED);
+  dtm->bInstantDisc = Config::Get(Config::MAIN_INSTANT_DISC);
   dtm->CPUCore = static_cast<u8>(Config::Get(Config::MAIN_CPU_CORE));
   dtm->bSyncGPU = Config::Get(Config::MAIN_SYNC_GPU);
   const std::string video_backend = Config::Get(Config::MAIN_GFX_BACKEND);
@@ -78,6 +87,12 @@ void SaveToDTM(Movie::DTMHeader* dtm)
 
   dtm->bFollowBranch = Config::Get(Config::MAIN_JIT_FOLLOW_BRANCH);
 
+  dtm->instantMemcards = 0;
+  if (Config::Get(Config::MAIN_MEMCARD_A_INSTANT_TRANSFER))
+    dtm->instantMemcards |= 1;
+  if (Config::Get(Config::MAIN_MEMCARD_B_INSTANT_TRANSFER))
+    dtm->instantMemcards |= 2;
+
   // Settings which only existed in old Dolphin versions
   dtm->bSkipIdle = true;
   dtm->bEFBCopyEnable = true;
@@ -70,6 +70,8 @@ public:
     layer->Set(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES,
                m_settings.m_SafeTextureCacheColorSamples);
     layer->Set(Config::GFX_PERF_QUERIES_ENABLE, m_settings.m_PerfQueriesEnable);
+    // Stale readbacks depend on how far behind the host GPU is, which differs between players
+    layer->Set(Config::GFX_READBACK_LATENCY, 0);
     layer->Set(Config::MAIN_FLOAT_EXCEPTIONS, m_settings.m_FloatExceptions);
     layer->Set(Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS, m_settings.m_DivideByZeroExceptions);
     layer->Set(Config::MAIN_FPRF, m_settings.m_FPRF);
@@ -82,7 +84,16 @@ public:
     layer->Set(Config::MAIN_SYNC_GPU_OVERCLOCK, m_settings.m_SyncGpuOverclock);
 
     layer->Set(Config::MAIN_JIT_FOLLOW_BRANCH, m_settings.m_JITFollowBranch);
+    // Recompiling moves block boundaries, and with them exception timing, at a point that depends
+    // on each player's JIT cache
+    layer->Set(Config::MAIN_JIT_HOT_BLOCK_RECOMPILE, false);
+    // HLE memory functions take fewer cycles than the game's own, so players would drift apart
+    // unless all of them had it set the same way
+    layer->Set(Config::MAIN_HLE_MEMORY_FUNCTIONS, false);
     layer->Set(Config::MAIN_FAST_DISC_SPEED, m_settings.m_FastDiscSpeed);
+    layer->Set(Config::MAIN_INSTANT_DISC, m_settings.m_InstantDisc);
+    layer->Set(Config::MAIN_MEMCARD_A_INSTANT_TRANSFER, m_settings.m_MemcardInstantTransfer[0]);
+    layer->Set(Config::MAIN_MEMCARD_B_INSTANT_TRANSFER, m_settings.m_MemcardInstantTransfer[1]);
     layer->Set(Config::MAIN_MMU, m_settings.m_MMU);
     layer->Set(Config::MAIN_FASTMEM, m_settings.m_Fastmem);
     layer->Set(Config::MAIN_SKIP_IPL, m_settings.m_SkipIPL);
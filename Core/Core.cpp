@@ -10,6 +10,7 @@
 #include <queue>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -53,6 +54,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -106,12 +108,16 @@ static bool s_is_started = false;
 static Common::Flag s_is_booting;
 static std::thread s_emu_thread;
 static std::vector<StateChangedCallbackFunc> s_on_state_changed_callbacks;
+static std::vector<FrameCallbackFunc> s_on_frame_callbacks;
 
 static std::thread s_cpu_thread;
 static bool s_is_throttler_temp_disabled = false;
 static std::atomic<double> s_last_actual_emulation_speed{1.0};
 static bool s_frame_step = false;
 static std::atomic<bool> s_stop_frame_step;
+// The machine at the entry point of the running title, for WarmReboot
+static std::vector<u8> s_boot_state;
+static bool s_boot_state_uses_ram_snapshot = false;
 
 #ifdef USE_MEMORYWATCHER
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
@@ -150,6 +156,12 @@ void FrameUpdateOnCPUThread()
 {
   if (NetPlay::IsNetPlayRunning())
     NetPlay::NetPlayClient::SendTimeBase();
+
+  for (const FrameCallbackFunc& callback : s_on_frame_callbacks)
+  {
+    if (callback)
+      callback();
+  }
 }
 
 void OnFrameEnd()
@@ -323,6 +335,17 @@ static void CPUSetInitialExecutionState(bool force_paused = false)
   // The CPU starts in stepping state, and will wait until a new state is set before executing.
   // SetState must be called on the host thread, so we defer it for later.
   QueueHostJob([force_paused]() {
+    // The CPU hasn't executed anything yet, so this is the machine just as the boot left it
+    if (Config::Get(Config::MAIN_KEEP_BOOT_STATE) && IsRunningAndStarted())
+    {
+      // With a snapshot of RAM to go back to, the boot state only has to hold everything else
+      s_boot_state_uses_ram_snapshot =
+          Config::Get(Config::MAIN_BOOT_STATE_RAM_SNAPSHOT) && Memory::TakeRAMSnapshot();
+      Memory::SetStatesUseRAMSnapshot(s_boot_state_uses_ram_snapshot);
+      ::State::SaveToBuffer(s_boot_state);
+      Memory::SetStatesUseRAMSnapshot(false);
+    }
+
     bool paused = SConfig::GetInstance().bBootToPause || force_paused;
     SetState(paused ? State::Paused : State::Running);
     Host_UpdateDisasmDialog();
@@ -340,6 +363,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
     Common::SetCurrentThreadName("CPU thread");
   else
     Common::SetCurrentThreadName("CPU-GPU thread");
+  Common::PlaceCurrentThread(Common::ThreadRole::CPU);
 
   // This needs to be delayed until after the video backend is ready.
   DolphinAnalytics::Instance().ReportGameStart();
@@ -419,6 +443,7 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
     Common::SetCurrentThreadName("FIFO player thread");
   else
     Common::SetCurrentThreadName("FIFO-GPU thread");
+  Common::PlaceCurrentThread(Common::ThreadRole::CPU);
 
   // Enter CPU run loop. When we leave it - we are done.
   if (auto cpu_core = FifoPlayer::GetInstance().GetCPUCore())
@@ -455,6 +480,8 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     s_is_started = false;
     s_is_stopping = false;
     s_wants_determinism = false;
+    s_boot_state = {};
+    s_boot_state_uses_ram_snapshot = false;
 
     CallOnStateChangedCallbacks(State::Uninitialized);
 
@@ -463,6 +490,9 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
 
   Common::SetCurrentThreadName("Emuthread - Starting");
 
+  // Before anything that starts a thread of its own
+  Common::InitThreadPlacement(Config::Get(Config::MAIN_PIN_THREADS));
+
   DeclareAsGPUThread();
 
   // For a time this acts as the CPU thread...
@@ -656,6 +686,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     // This thread, after creating the EmuWindow, spawns a CPU
     // thread, and then takes over and becomes the video thread
     Common::SetCurrentThreadName("Video thread");
+    Common::PlaceCurrentThread(Common::ThreadRole::GPU);
     UndeclareAsCPUThread();
     FPURoundMode::LoadDefaultSIMDState();
 
@@ -1006,6 +1037,17 @@ void UpdateTitle(u32 ElapseTime)
   Host_UpdateTitle(message);
 }
 
+bool WarmReboot()
+{
+  if (!IsRunningAndStarted() || s_boot_state.empty())
+    return false;
+
+  Memory::SetStatesUseRAMSnapshot(s_boot_state_uses_ram_snapshot);
+  ::State::LoadFromBuffer(s_boot_state);
+  Memory::SetStatesUseRAMSnapshot(false);
+  return true;
+}
+
 void Shutdown()
 {
   // During shutdown DXGI expects us to handle some messages on the UI thread.
@@ -1046,6 +1088,31 @@ bool RemoveOnStateChangedCallback(int* handle)
   return false;
 }
 
+int AddOnFrameCallback(FrameCallbackFunc callback)
+{
+  for (size_t i = 0; i < s_on_frame_callbacks.size(); ++i)
+  {
+    if (!s_on_frame_callbacks[i])
+    {
+      s_on_frame_callbacks[i] = std::move(callback);
+      return int(i);
+    }
+  }
+  s_on_frame_callbacks.emplace_back(std::move(callback));
+  return int(s_on_frame_callbacks.size()) - 1;
+}
+
+bool RemoveOnFrameCallback(int* handle)
+{
+  if (handle && *handle >= 0 && s_on_frame_callbacks.size() > static_cast<size_t>(*handle))
+  {
+    s_on_frame_callbacks[*handle] = FrameCallbackFunc();
+    *handle = -1;
+    return true;
+  }
+  return false;
+}
+
 void CallOnStateChangedCallbacks(Core::State state)
 {
   for (const StateChangedCallbackFunc& on_state_changed_callback : s_on_state_changed_callbacks)
@@ -96,6 +96,13 @@ bool Init(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi);
 void Stop();
 void Shutdown();
 
+// Starts the running title over from its entry point without booting it again. Only the CPU,
+// hardware and RAM are reset, to how they were when the title was booted with
+// Config::MAIN_KEEP_BOOT_STATE set; the disc, the memory mappings, the video backend and every
+// thread carry on. Returns false if there is no boot state to go back to. [NOT THREADSAFE] For
+// use by Host only
+bool WarmReboot();
+
 void DeclareAsCPUThread();
 void UndeclareAsCPUThread();
 void DeclareAsGPUThread();
@@ -149,6 +156,13 @@ int AddOnStateChangedCallback(StateChangedCallbackFunc callback);
 bool RemoveOnStateChangedCallback(int* handle);
 void CallOnStateChangedCallbacks(Core::State state);
 
+// Called on the CPU thread every time the game finishes drawing a frame.
+using FrameCallbackFunc = std::function<void()>;
+// Returns a handle
+int AddOnFrameCallback(FrameCallbackFunc callback);
+// Also invalidates the handle
+bool RemoveOnFrameCallback(int* handle);
+
 // Run on the Host thread when the factors change. [NOT THREADSAFE]
 void UpdateWantDeterminism(bool initial = false);
 
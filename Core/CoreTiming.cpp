@@ -4,6 +4,7 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
+#include <array>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -15,6 +16,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/SPSCQueue.h"
+#include "Common/Tracing.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
@@ -29,6 +31,11 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+
+  // Instrumentation, only touched on the CPU thread.
+  u64 schedule_count = 0;
+  u64 fire_count = 0;
+  s64 total_lead_cycles = 0;
 };
 
 struct Event
@@ -53,12 +60,159 @@ static bool operator<(const Event& left, const Event& right)
 // remain stable regardless of rehashes/resizing.
 static std::unordered_map<std::string, EventType> s_event_types;
 
+// A calendar queue. Events due within the next BUCKET_COUNT buckets of BUCKET_CYCLES each go into
+// the bucket of their time, which makes scheduling them O(1). Only events further out than that
+// go through a min-heap, and they move into the buckets once the wheel comes close enough.
+// Events come out in (time, fifo_order) order, exactly like they would from a single heap.
+class EventQueue
+{
+public:
+  bool Empty() const { return m_size == 0; }
+
+  void Push(Event event)
+  {
+    ++m_size;
+    // An empty wheel moves back to an event due before it, rather than crowding everything before
+    // its base into the current bucket
+    if (m_near_size == 0 && event.time < m_base)
+      m_base = (event.time >> BUCKET_SHIFT) << BUCKET_SHIFT;
+
+    if (event.time >= m_base + SPAN_CYCLES)
+    {
+      m_far.push_back(std::move(event));
+      std::push_heap(m_far.begin(), m_far.end(), std::greater<Event>());
+      return;
+    }
+
+    // Events already due share the current bucket
+    const s64 offset = std::max<s64>(event.time - m_base, 0) >> BUCKET_SHIFT;
+    std::vector<Event>& bucket = m_buckets[(m_cursor + offset) % BUCKET_COUNT];
+    bucket.push_back(std::move(event));
+    ++m_near_size;
+    m_top = nullptr;
+  }
+
+  // The earliest event. The queue must not be empty.
+  const Event& Top()
+  {
+    if (!m_top)
+      FindTop();
+    return *m_top;
+  }
+
+  void Pop()
+  {
+    Top();
+    std::vector<Event>& bucket = m_buckets[m_cursor];
+    *m_top = std::move(bucket.back());
+    bucket.pop_back();
+    --m_near_size;
+    --m_size;
+    m_top = nullptr;
+  }
+
+  template <typename Predicate>
+  void RemoveIf(Predicate predicate)
+  {
+    for (std::vector<Event>& bucket : m_buckets)
+    {
+      const auto end = std::remove_if(bucket.begin(), bucket.end(), predicate);
+      m_near_size -= bucket.end() - end;
+      m_size -= bucket.end() - end;
+      bucket.erase(end, bucket.end());
+    }
+
+    const auto end = std::remove_if(m_far.begin(), m_far.end(), predicate);
+    if (end != m_far.end())
+    {
+      m_size -= m_far.end() - end;
+      m_far.erase(end, m_far.end());
+      std::make_heap(m_far.begin(), m_far.end(), std::greater<Event>());
+    }
+    m_top = nullptr;
+  }
+
+  // Every pending event, in no particular order.
+  std::vector<Event> GetAll() const
+  {
+    std::vector<Event> events(m_far);
+    for (const std::vector<Event>& bucket : m_buckets)
+      events.insert(events.end(), bucket.begin(), bucket.end());
+    return events;
+  }
+
+  void Assign(std::vector<Event> events)
+  {
+    Clear();
+    // Start the wheel at the earliest event, so the rest land in its buckets instead of the heap
+    const auto earliest = std::min_element(events.begin(), events.end());
+    if (earliest != events.end())
+      m_base = (earliest->time >> BUCKET_SHIFT) << BUCKET_SHIFT;
+    for (Event& event : events)
+      Push(std::move(event));
+  }
+
+  // The wheel keeps its base, which is still close to the current time, so the events scheduled
+  // next go into its buckets instead of the heap.
+  void Clear()
+  {
+    for (std::vector<Event>& bucket : m_buckets)
+      bucket.clear();
+    m_far.clear();
+    m_size = 0;
+    m_near_size = 0;
+    m_top = nullptr;
+  }
+
+private:
+  static constexpr int BUCKET_SHIFT = 10;
+  static constexpr size_t BUCKET_COUNT = 512;
+  static constexpr s64 SPAN_CYCLES = s64{BUCKET_COUNT} << BUCKET_SHIFT;
+
+  void FindTop()
+  {
+    // With nothing close by, jump the wheel straight to the earliest far event
+    if (m_near_size == 0)
+    {
+      m_base = (m_far.front().time >> BUCKET_SHIFT) << BUCKET_SHIFT;
+      PullFarEvents();
+    }
+
+    while (m_buckets[m_cursor].empty())
+    {
+      m_cursor = (m_cursor + 1) % BUCKET_COUNT;
+      m_base += s64{1} << BUCKET_SHIFT;
+      PullFarEvents();
+    }
+
+    std::vector<Event>& bucket = m_buckets[m_cursor];
+    m_top = &*std::min_element(bucket.begin(), bucket.end());
+  }
+
+  void PullFarEvents()
+  {
+    while (!m_far.empty() && m_far.front().time < m_base + SPAN_CYCLES)
+    {
+      std::pop_heap(m_far.begin(), m_far.end(), std::greater<Event>());
+      Event event = std::move(m_far.back());
+      m_far.pop_back();
+      --m_size;
+      Push(std::move(event));
+    }
+  }
+
+  std::array<std::vector<Event>, BUCKET_COUNT> m_buckets;
+  std::vector<Event> m_far;
+  // First cycle of the bucket at m_cursor.
+  s64 m_base = 0;
+  size_t m_cursor = 0;
+  size_t m_size = 0;
+  size_t m_near_size = 0;
+  Event* m_top = nullptr;
+};
+
 // STATE_TO_SAVE
-// The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-// We don't use std::priority_queue because we need to be able to serialize, unserialize and
-// erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-// by the standard adaptor class.
-static std::vector<Event> s_event_queue;
+static EventQueue s_event_queue;
 static u64 s_event_fifo_id;
 static std::mutex s_ts_write_lock;
 static Common::SPSCQueue<Event, false> s_ts_queue;
@@ -120,7 +274,7 @@ EventType* RegisterEvent(const std::string& name, TimedCallback callback)
 
 void UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, s_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, s_event_queue.Empty(), "Cannot unregister events with events pending");
   s_event_types.clear();
 }
 
@@ -181,7 +335,8 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(s_event_queue, [](PointerWrap& pw, Event& ev) {
+  std::vector<Event> events = s_event_queue.GetAll();
+  p.DoEachElement(events, [](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -215,10 +370,8 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingEvents");
 
   // When loading from a save state, we must assume the Event order is random and meaningless.
-  // The exact layout of the heap in memory is implementation defined, therefore it is platform
-  // and library version specific.
   if (p.IsReadMode())
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    s_event_queue.Assign(std::move(events));
 }
 
 // This should only be called from the CPU thread. If you are calling
@@ -241,7 +394,7 @@ u64 GetIdleTicks()
 
 void ClearPendingEvents()
 {
-  s_event_queue.clear();
+  s_event_queue.Clear();
 }
 
 void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata, FromThread from)
@@ -269,8 +422,9 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     if (!s_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    s_event_queue.emplace_back(Event{timeout, s_event_fifo_id++, userdata, event_type});
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    ++event_type->schedule_count;
+    event_type->total_lead_cycles += cycles_into_future;
+    s_event_queue.Push(Event{timeout, s_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -289,15 +443,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
 
 void RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(s_event_queue.begin(), s_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != s_event_queue.end())
-  {
-    s_event_queue.erase(itr, s_event_queue.end());
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-  }
+  s_event_queue.RemoveIf([&](const Event& e) { return e.type == event_type; });
 }
 
 void RemoveAllEvents(EventType* event_type)
@@ -323,13 +469,16 @@ void MoveEvents()
   for (Event ev; s_ts_queue.Pop(ev);)
   {
     ev.fifo_order = s_event_fifo_id++;
-    s_event_queue.emplace_back(std::move(ev));
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    ++ev.type->schedule_count;
+    ev.type->total_lead_cycles += ev.time - g.global_timer;
+    s_event_queue.Push(std::move(ev));
   }
 }
 
 void Advance()
 {
+  TRACE_SPAN("CoreTiming::Advance");
+
   MoveEvents();
 
   int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
@@ -340,21 +489,21 @@ void Advance()
 
   s_is_global_timer_sane = true;
 
-  while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer)
+  while (!s_event_queue.Empty() && s_event_queue.Top().time <= g.global_timer)
   {
-    Event evt = std::move(s_event_queue.front());
-    std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-    s_event_queue.pop_back();
+    Event evt = s_event_queue.Top();
+    s_event_queue.Pop();
+    ++evt.type->fire_count;
     evt.type->callback(evt.userdata, g.global_timer - evt.time);
   }
 
   s_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!s_event_queue.empty())
+  if (!s_event_queue.Empty())
   {
     g.slice_length = static_cast<int>(
-        std::min<s64>(s_event_queue.front().time - g.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(s_event_queue.Top().time - g.global_timer, MAX_SLICE_LENGTH));
   }
 
   PowerPC::ppcState.downcount = CyclesToDowncount(g.slice_length);
@@ -368,7 +517,7 @@ void Advance()
 
 void LogPendingEvents()
 {
-  auto clone = s_event_queue;
+  auto clone = s_event_queue.GetAll();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -380,11 +529,13 @@ void LogPendingEvents()
 // Should only be called from the CPU thread after the PPC clock has changed
 void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock)
 {
-  for (Event& ev : s_event_queue)
+  std::vector<Event> events = s_event_queue.GetAll();
+  for (Event& ev : events)
   {
     const s64 ticks = (ev.time - g.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = g.global_timer + ticks;
   }
+  s_event_queue.Assign(std::move(events));
 }
 
 void Idle()
@@ -407,7 +558,7 @@ std::string GetScheduledEventsSummary()
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = s_event_queue;
+  auto clone = s_event_queue.GetAll();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -416,6 +567,29 @@ std::string GetScheduledEventsSummary()
   return text;
 }
 
+std::vector<EventStats> GetEventStats()
+{
+  std::vector<EventStats> stats;
+  stats.reserve(s_event_types.size());
+  for (const auto& [name, type] : s_event_types)
+  {
+    const double average_lead =
+        type.schedule_count ? static_cast<double>(type.total_lead_cycles) / type.schedule_count : 0;
+    stats.push_back({name, type.schedule_count, type.fire_count, average_lead});
+  }
+  return stats;
+}
+
+void ResetEventStats()
+{
+  for (auto& entry : s_event_types)
+  {
+    entry.second.schedule_count = 0;
+    entry.second.fire_count = 0;
+    entry.second.total_lead_cycles = 0;
+  }
+}
+
 u32 GetFakeDecStartValue()
 {
   return s_fake_dec_start_value;
@@ -17,6 +17,7 @@
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
 #include <string>
+#include <vector>
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -96,6 +97,18 @@ void LogPendingEvents();
 
 std::string GetScheduledEventsSummary();
 
+// Counters of every event type since it was registered or the stats were last reset. Only call
+// these from the CPU thread.
+struct EventStats
+{
+  std::string name;
+  u64 scheduled;
+  u64 fired;
+  double average_lead_cycles;
+};
+std::vector<EventStats> GetEventStats();
+void ResetEventStats();
+
 void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock);
 
 u32 GetFakeDecStartValue();
@@ -160,6 +160,63 @@ u16 Accelerator::Read(const s16* coefs)
   return val;
 }
 
+void Accelerator::ReadSamples(const s16* coefs, s16* samples, u32 count)
+{
+  u32 i = 0;
+  while (i < count)
+  {
+    if (m_sample_format == 0x00 && !m_reads_stopped)
+      i += DecodeADPCMRun(coefs, samples + i, count - i);
+
+    if (i < count)
+      samples[i++] = static_cast<s16>(Read(coefs));
+  }
+}
+
+u32 Accelerator::DecodeADPCMRun(const s16* coefs, s16* samples, u32 count)
+{
+  // The frame header only changes where a frame ends, so it holds for the whole run
+  const s32 scale = 1 << (m_pred_scale & 0xF);
+  const int coef_idx = (m_pred_scale >> 4) & 0x7;
+  const s32 coef1 = coefs[coef_idx * 2 + 0];
+  const s32 coef2 = coefs[coef_idx * 2 + 1];
+
+  s32 yn1 = m_yn1;
+  s32 yn2 = m_yn2;
+  u32 address = m_current_address;
+  u8 byte = 0;
+  u32 i = 0;
+  for (; i < count; ++i)
+  {
+    // Leave frame ends, looping and the end address to Read(), erring on the side of stopping
+    const u32 next_address = address + 1;
+    if ((next_address & 15) == 0 || next_address == m_end_address ||
+        next_address == m_end_address - 1 || next_address == m_end_address + 1)
+    {
+      break;
+    }
+
+    if (i == 0 || (address & 1) == 0)
+      byte = ReadMemory(address >> 1);
+    int temp = (address & 1) ? (byte & 0xF) : (byte >> 4);
+    if (temp >= 8)
+      temp -= 16;
+
+    const s32 val32 = (scale * temp) + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+    const s16 val = static_cast<s16>(std::clamp<s32>(val32, -0x7FFF, 0x7FFF));
+    samples[i] = val;
+
+    yn2 = yn1;
+    yn1 = val;
+    address = next_address;
+  }
+
+  m_yn1 = static_cast<s16>(yn1);
+  m_yn2 = static_cast<s16>(yn2);
+  m_current_address = address;
+  return i;
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
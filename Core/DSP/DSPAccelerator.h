@@ -15,6 +15,8 @@ public:
   virtual ~Accelerator() = default;
 
   u16 Read(const s16* coefs);
+  // Same as count calls to Read(), but ADPCM samples are decoded a frame at a time.
+  void ReadSamples(const s16* coefs, s16* samples, u32 count);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
@@ -37,6 +39,10 @@ public:
   void DoState(PointerWrap& p);
 
 protected:
+  // Decodes ADPCM samples up to the first one that needs more than a decode, like one that ends a
+  // frame or reaches the end address, and returns how many it decoded.
+  u32 DecodeADPCMRun(const s16* coefs, s16* samples, u32 count);
+
   virtual void OnEndException() = 0;
   virtual u8 ReadMemory(u32 address) = 0;
   virtual void WriteMemory(u32 address, u8 value) = 0;
@@ -60,6 +60,63 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0, 0},
 };
 
+// Besides the known signatures, any loop that only loads a mailbox register, tests it and
+// branches back is a mail wait loop, e.g.
+//   LRS   $AC0.M, @CMBH
+//   ANDCF $AC0.M, #0x8000
+//   JLNZ  <start of the loop>
+// Nothing but the CPU can end such a loop, as running it again has no other effect.
+static bool IsMailboxPollingLoop(const SDSP& dsp, u16 addr)
+{
+  const auto is_mailbox = [](u16 address) { return address >= (0xff00 | DSP_DMBH); };
+
+  u16 pc = addr;
+  const UDSPInstruction load = dsp.ReadIMEM(pc);
+  int loaded_reg;
+  if ((load & 0xf800) == 0x2000 && is_mailbox(static_cast<u16>(static_cast<s8>(load & 0xff))))
+  {
+    // LRS $(0x18+D), @M
+    loaded_reg = DSP_REG_AXL0 + ((load >> 8) & 0x7);
+    pc += 1;
+  }
+  else if ((load & 0xffe0) == 0x00c0 && is_mailbox(dsp.ReadIMEM(static_cast<u16>(pc + 1))))
+  {
+    // LR $D, @M
+    loaded_reg = load & 0x1f;
+    pc += 2;
+  }
+  else
+  {
+    return false;
+  }
+
+  // The flags have to come from the loaded value. TSTAXH must not have an extended opcode.
+  const UDSPInstruction test = dsp.ReadIMEM(pc);
+  if ((test & 0xfeff) == 0x02a0 || (test & 0xfeff) == 0x02c0)
+  {
+    // ANDF/ANDCF $acD.m, #I
+    if (loaded_reg != DSP_REG_ACM0 + ((test >> 8) & 0x1))
+      return false;
+    pc += 2;
+  }
+  else if ((test & 0xfeff) == 0x8600)
+  {
+    // TSTAXH $axR.h
+    if (loaded_reg != DSP_REG_AXH0 + ((test >> 8) & 0x1))
+      return false;
+    pc += 1;
+  }
+  else
+  {
+    return false;
+  }
+
+  // Jcc back to the load
+  const UDSPInstruction branch = dsp.ReadIMEM(pc);
+  return (branch & 0xfff0) == 0x0290 && branch != 0x029f &&
+         dsp.ReadIMEM(static_cast<u16>(pc + 1)) == addr;
+}
+
 Analyzer::Analyzer() = default;
 Analyzer::~Analyzer() = default;
 
@@ -169,5 +226,17 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
       }
     }
   }
+
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if ((m_code_flags[addr] & (CODE_START_OF_INST | CODE_IDLE_SKIP)) != CODE_START_OF_INST)
+      continue;
+
+    if (IsMailboxPollingLoop(dsp, addr))
+    {
+      INFO_LOG_FMT(DSPLLE, "Idle skip location found at {:02x} (mail wait loop)", addr);
+      m_code_flags[addr] |= CODE_IDLE_SKIP;
+    }
+  }
 }
 }  // namespace DSP
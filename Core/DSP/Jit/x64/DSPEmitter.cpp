@@ -497,6 +497,13 @@ Gen::OpArg DSPEmitter::M_SDSP_external_interrupt_waiting()
   return MDisp(R15, static_cast<int>(offsetof(SDSP, external_interrupt_waiting)));
 }
 
+Gen::OpArg DSPEmitter::M_SDSP_reset_dspjit_codespace()
+{
+  static_assert(sizeof(SDSP::reset_dspjit_codespace) == sizeof(u8));
+
+  return MDisp(R15, static_cast<int>(offsetof(SDSP, reset_dspjit_codespace)));
+}
+
 Gen::OpArg DSPEmitter::M_SDSP_r_st(size_t index)
 {
   return MDisp(R15, static_cast<int>(offsetof(SDSP, r.st) + sizeof(SDSP::r.st[0]) * index));
@@ -212,7 +212,7 @@ private:
   void FallBackToInterpreter(UDSPInstruction inst);
 
   void WriteBranchExit();
-  void WriteBlockLink(u16 dest);
+  void WriteBlockLink(u16 dest, bool conditional);
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
@@ -294,6 +294,7 @@ private:
   Gen::OpArg M_SDSP_exceptions();
   Gen::OpArg M_SDSP_control_reg();
   Gen::OpArg M_SDSP_external_interrupt_waiting();
+  Gen::OpArg M_SDSP_reset_dspjit_codespace();
   Gen::OpArg M_SDSP_r_st(size_t index);
   Gen::OpArg M_SDSP_reg_stack_ptrs(size_t index);
 
@@ -7,6 +7,7 @@
 
 #include "Core/DSP/DSPAnalyzer.h"
 #include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPHost.h"
 #include "Core/DSP/DSPTables.h"
 
 using namespace Gen;
@@ -114,32 +115,69 @@ void DSPEmitter::WriteBranchExit()
   m_gpr.FlushRegs(c, false);
 }
 
-void DSPEmitter::WriteBlockLink(u16 dest)
+void DSPEmitter::WriteBlockLink(u16 dest, bool conditional)
 {
-  // Jump directly to the called block if it has already been compiled.
-  if (!(dest >= m_start_address && dest <= m_compile_pc))
+  // Idle skip blocks have to go back to the dispatcher to give up their cycles
+  if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
+    return;
+
+  // Jump directly to the called block if it has already been compiled. A branch back to the
+  // start of the block that is being compiled loops without going through the dispatcher.
+  Block link;
+  u16 dest_size;
+  if (dest == m_start_address)
+  {
+    link = m_block_link_entry;
+    dest_size = m_block_size[m_start_address];
+  }
+  else if (!(dest >= m_start_address && dest <= m_compile_pc))
   {
-    if (m_block_links[dest] != nullptr)
-    {
-      m_gpr.FlushRegs();
-      // Check if we have enough cycles to execute the next block
-      MOV(64, R(RAX), ImmPtr(&m_cycles_left));
-      MOV(16, R(ECX), MatR(RAX));
-      CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + m_block_size[dest]));
-      FixupBranch notEnoughCycles = J_CC(CC_BE);
-
-      SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
-      MOV(16, MatR(RAX), R(ECX));
-      JMP(m_block_links[dest], true);
-      SetJumpTarget(notEnoughCycles);
-    }
-    else
-    {
-      // The destination has not been compiled yet.  Add it to the list
-      // of blocks that this block is waiting on.
+    link = m_block_links[dest];
+    dest_size = m_block_size[dest];
+
+    // The destination has not been compiled yet.  Add it to the list
+    // of blocks that this block is waiting on. Conditional branches don't wait, as the blocks
+    // they lead to often branch back, and waiting on each other would keep them from compiling.
+    if (link == nullptr && !conditional)
       m_unresolved_jumps[m_start_address].push_back(dest);
-    }
   }
+  else
+  {
+    return;
+  }
+
+  if (link == nullptr)
+    return;
+
+  m_gpr.FlushRegs();
+
+  // Linked blocks skip the checks of the dispatcher, so leave through it if a DMA to IRAM has
+  // made the linked code stale, or the DSP has been halted or interrupted
+  CMP(8, M_SDSP_reset_dspjit_codespace(), Imm8(0));
+  FixupBranch code_reset = J_CC(CC_NE);
+  TEST(8, M_SDSP_control_reg(), Imm8(CR_HALT));
+  FixupBranch halted = J_CC(CC_NE);
+  FixupBranch interrupted;
+  if (Host::OnThread())
+  {
+    CMP(8, M_SDSP_external_interrupt_waiting(), Imm8(0));
+    interrupted = J_CC(CC_NE);
+  }
+
+  // Check if we have enough cycles to execute the next block
+  MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+  MOV(16, R(ECX), MatR(RAX));
+  CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + dest_size));
+  FixupBranch notEnoughCycles = J_CC(CC_BE);
+
+  SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
+  MOV(16, MatR(RAX), R(ECX));
+  JMP(link, true);
+  SetJumpTarget(notEnoughCycles);
+  SetJumpTarget(code_reset);
+  SetJumpTarget(halted);
+  if (Host::OnThread())
+    SetJumpTarget(interrupted);
 }
 
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
@@ -147,9 +185,7 @@ void DSPEmitter::r_jcc(const UDSPInstruction opc)
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
   const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  WriteBlockLink(dest, !opcode->uncond_branch);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -194,9 +230,7 @@ void DSPEmitter::r_call(const UDSPInstruction opc)
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
   const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  WriteBlockLink(dest, !opcode->uncond_branch);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
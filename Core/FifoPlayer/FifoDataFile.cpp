@@ -9,6 +9,9 @@
 #include <string>
 #include <vector>
 
+#include <xxhash.h>
+
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
@@ -106,6 +109,20 @@ void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
   m_Frames.push_back(frameInfo);
 }
 
+FifoBytes FifoDataFile::AddMemoryUpdateData(const u8* data, size_t size)
+{
+  const u64 hash = XXH64(data, size, 0);
+  const auto [begin, end] = m_memory_update_pool.equal_range(hash);
+  for (auto it = begin; it != end; ++it)
+  {
+    const FifoBytes& pooled = it->second;
+    if (pooled.size() == size && std::memcmp(pooled.data(), data, size) == 0)
+      return pooled;
+  }
+
+  return m_memory_update_pool.emplace(hash, std::vector<u8>(data, data + size))->second;
+}
+
 bool FifoDataFile::Save(const std::string& filename)
 {
   File::IOFile file;
@@ -171,6 +188,7 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteBytes(&header, sizeof(FileHeader));
 
   // Write frames list
+  WrittenDataMap writtenData;
   for (unsigned int i = 0; i < m_Frames.size(); ++i)
   {
     const FifoFrameInfo& srcFrame = m_Frames[i];
@@ -180,7 +198,7 @@ bool FifoDataFile::Save(const std::string& filename)
     u64 dataOffset = file.Tell();
     file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file, writtenData);
 
     FileFrameInfo dstFrame;
     dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
@@ -204,24 +222,22 @@ bool FifoDataFile::Save(const std::string& filename)
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
 {
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file)
+  auto dataFile = std::make_unique<FifoDataFile>();
+  if (!dataFile->m_mapping.Open(filename, File::MappedFile::Mode::ReadOnly))
+  {
+    // Empty files can't be mapped
+    if (File::Exists(filename) && File::GetSize(filename) == 0)
+      CriticalAlertFmtT("DFF file size is 0; corrupt/incomplete file?");
     return nullptr;
+  }
 
   auto panic_failed_to_read = []() {
     CriticalAlertFmtT("Failed to read DFF file.");
     return nullptr;
   };
 
-  if (file.GetSize() == 0)
-  {
-    CriticalAlertFmtT("DFF file size is 0; corrupt/incomplete file?");
-    return nullptr;
-  }
-
   FileHeader header;
-  if (!file.ReadBytes(&header, sizeof(header)))
+  if (!dataFile->ReadMapped(0, &header))
     return panic_failed_to_read();
 
   if (header.fileId != FILE_ID)
@@ -248,8 +264,6 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     header.mem2_size = Memory::MEM2_SIZE_RETAIL;
   }
 
-  auto dataFile = std::make_unique<FifoDataFile>();
-
   dataFile->m_Flags = header.flags;
   dataFile->m_Version = header.file_version;
 
@@ -284,61 +298,58 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   }
 
   u32 size = std::min<u32>(BP_MEM_SIZE, header.bpMemSize);
-  file.Seek(header.bpMemOffset, File::SeekOrigin::Begin);
-  file.ReadArray(dataFile->m_BPMem.data(), size);
+  bool good = dataFile->ReadMapped(header.bpMemOffset, dataFile->m_BPMem.data(), size);
 
   size = std::min<u32>(CP_MEM_SIZE, header.cpMemSize);
-  file.Seek(header.cpMemOffset, File::SeekOrigin::Begin);
-  file.ReadArray(dataFile->m_CPMem.data(), size);
+  good &= dataFile->ReadMapped(header.cpMemOffset, dataFile->m_CPMem.data(), size);
 
   size = std::min<u32>(XF_MEM_SIZE, header.xfMemSize);
-  file.Seek(header.xfMemOffset, File::SeekOrigin::Begin);
-  file.ReadArray(dataFile->m_XFMem.data(), size);
+  good &= dataFile->ReadMapped(header.xfMemOffset, dataFile->m_XFMem.data(), size);
 
   size = std::min<u32>(XF_REGS_SIZE, header.xfRegsSize);
-  file.Seek(header.xfRegsOffset, File::SeekOrigin::Begin);
-  file.ReadArray(dataFile->m_XFRegs.data(), size);
+  good &= dataFile->ReadMapped(header.xfRegsOffset, dataFile->m_XFRegs.data(), size);
 
   // Texture memory saving was added in version 4.
   dataFile->m_TexMem.fill(0);
   if (dataFile->m_Version >= 4)
   {
     size = std::min<u32>(TEX_MEM_SIZE, header.texMemSize);
-    file.Seek(header.texMemOffset, File::SeekOrigin::Begin);
-    file.ReadArray(&dataFile->m_TexMem);
+    good &= dataFile->ReadMapped(header.texMemOffset, dataFile->m_TexMem.data(), size);
   }
 
-  if (!file.IsGood())
+  if (!good)
     return panic_failed_to_read();
 
   // idk what else these could be used for, but it'd be a shame to not make them available.
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
+  // The frame list and the memory update lists are offset tables into the rest of the file, so
+  // the frames' data is used straight from the mapping instead of being copied
+  dataFile->m_mapping.SetAccessPattern(File::MappedFile::AccessPattern::Sequential);
+  dataFile->m_Frames.resize(header.frameCount);
   for (u32 i = 0; i < header.frameCount; ++i)
   {
     u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
     FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
+    if (!dataFile->ReadMapped(frameOffset, &srcFrame))
       return panic_failed_to_read();
 
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
+    FifoFrameInfo& dstFrame = dataFile->m_Frames[i];
     dstFrame.fifoStart = srcFrame.fifoStart;
     dstFrame.fifoEnd = srcFrame.fifoEnd;
 
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
-
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
-
-    if (!file.IsGood())
+    const u8* fifoData =
+        dataFile->GetMappedRange(srcFrame.fifoDataOffset, srcFrame.fifoDataSize);
+    if (!fifoData)
       return panic_failed_to_read();
+    dstFrame.fifoData = FifoBytes::View(fifoData, srcFrame.fifoDataSize);
 
-    dataFile->AddFrame(dstFrame);
+    if (!dataFile->ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
+                                     dstFrame.memoryUpdates))
+    {
+      return panic_failed_to_read();
+    }
   }
 
   return dataFile;
@@ -364,7 +375,7 @@ bool FifoDataFile::GetFlag(u32 flag) const
 }
 
 u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
+                                     File::IOFile& file, WrittenDataMap& writtenData)
 {
   // Add space for memory update list
   u64 updateListOffset = file.Tell();
@@ -374,10 +385,17 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
   {
     const MemoryUpdate& srcUpdate = memUpdates[i];
 
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+    // Write memory, unless an earlier update with the same payload already did. Loading maps
+    // updates that point to the same data to the same bytes again.
+    const auto [written, isNew] =
+        writtenData.try_emplace({srcUpdate.data.data(), srcUpdate.data.size()}, 0);
+    if (isNew)
+    {
+      file.Seek(0, File::SeekOrigin::End);
+      written->second = file.Tell();
+      file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+    }
+    const u64 dataOffset = written->second;
 
     FileMemoryUpdate dstUpdate;
     dstUpdate.address = srcUpdate.address;
@@ -394,25 +412,48 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
   return updateListOffset;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+bool FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+                                     std::vector<MemoryUpdate>& memUpdates)
 {
   memUpdates.resize(numUpdates);
 
   for (u32 i = 0; i < numUpdates; ++i)
   {
     u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
     FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
+    if (!ReadMapped(updateOffset, &srcUpdate))
+      return false;
+
+    const u8* data = GetMappedRange(srcUpdate.dataOffset, srcUpdate.dataSize);
+    if (!data)
+      return false;
 
     MemoryUpdate& dstUpdate = memUpdates[i];
     dstUpdate.address = srcUpdate.address;
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
+    dstUpdate.data = FifoBytes::View(data, srcUpdate.dataSize);
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
-
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
   }
+
+  return true;
+}
+
+const u8* FifoDataFile::GetMappedRange(u64 offset, u64 size) const
+{
+  const u64 mappingSize = m_mapping.GetSize();
+  if (offset > mappingSize || size > mappingSize - offset)
+    return nullptr;
+
+  return m_mapping.GetData() + offset;
+}
+
+template <typename T>
+bool FifoDataFile::ReadMapped(u64 offset, T* out, size_t count) const
+{
+  const u8* data = GetMappedRange(offset, u64{sizeof(T)} * count);
+  if (!data)
+    return false;
+
+  std::memcpy(out, data, sizeof(T) * count);
+  return true;
 }
@@ -4,11 +4,16 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace File
@@ -16,6 +21,41 @@ namespace File
 class IOFile;
 }
 
+// Bytes that are either owned, for recordings, or a view into the mapping of the file they were
+// loaded from. Views stay valid for as long as that FifoDataFile exists. Copies of owned bytes
+// share their storage.
+class FifoBytes
+{
+public:
+  FifoBytes() = default;
+  FifoBytes(std::vector<u8> owned)
+      : m_owned(std::make_shared<const std::vector<u8>>(std::move(owned))),
+        m_data(m_owned->data()), m_size(m_owned->size())
+  {
+  }
+
+  static FifoBytes View(const u8* data, size_t size)
+  {
+    FifoBytes bytes;
+    bytes.m_data = data;
+    bytes.m_size = size;
+    return bytes;
+  }
+
+  const u8* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  const u8* begin() const { return m_data; }
+  const u8* end() const { return m_data + m_size; }
+  const u8& operator[](size_t index) const { return m_data[index]; }
+
+private:
+  std::shared_ptr<const std::vector<u8>> m_owned;
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+};
+
 struct MemoryUpdate
 {
   enum Type
@@ -28,13 +68,13 @@ struct MemoryUpdate
 
   u32 fifoPosition = 0;
   u32 address = 0;
-  std::vector<u8> data;
+  FifoBytes data;
   Type type{};
 };
 
 struct FifoFrameInfo
 {
-  std::vector<u8> fifoData;
+  FifoBytes fifoData;
 
   u32 fifoStart = 0;
   u32 fifoEnd = 0;
@@ -73,10 +113,17 @@ public:
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
   void AddFrame(const FifoFrameInfo& frameInfo);
+
+  // Returns a copy of the given memory update payload. Payloads that were added before are
+  // looked up by their hash and shared rather than copied again, and are only saved once, with
+  // every memory update that uses them pointing at the same data in the file.
+  FifoBytes AddMemoryUpdateData(const u8* data, size_t size);
   const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
   u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Must not be used to overwrite the file this was loaded from, as the frames point into it.
   bool Save(const std::string& filename);
 
+  // Maps the file rather than reading it in, so the frames' data is only paged in once played.
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
@@ -90,9 +137,16 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  // Where the data that memory updates point to was saved, keyed by its address and size in memory
+  using WrittenDataMap = std::map<std::pair<const u8*, size_t>, u64>;
+  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file,
+                         WrittenDataMap& writtenData);
+  bool ReadMemoryUpdates(u64 fileOffset, u32 numUpdates, std::vector<MemoryUpdate>& memUpdates);
+
+  // Points to size bytes at offset in the mapping, or returns nullptr if they're past its end
+  const u8* GetMappedRange(u64 offset, u64 size) const;
+  template <typename T>
+  bool ReadMapped(u64 offset, T* out, size_t count = 1) const;
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -106,4 +160,9 @@ private:
   u32 m_Version = 0;
 
   std::vector<FifoFrameInfo> m_Frames;
+
+  // Memory update payloads by their hash
+  std::unordered_multimap<u64, FifoBytes> m_memory_update_pool;
+
+  File::MappedFile m_mapping;
 };
@@ -294,8 +294,12 @@ void FifoRecorder::UseMemory(u32 address, u32 size, MemoryUpdate::Type type, boo
     memUpdate.address = address;
     memUpdate.fifoPosition = (u32)(m_FifoData.size());
     memUpdate.type = type;
-    memUpdate.data.resize(size);
-    std::copy(newData, newData + size, memUpdate.data.begin());
+    {
+      std::lock_guard lk(m_mutex);
+      if (!m_File)
+        return;
+      memUpdate.data = m_File->AddMemoryUpdateData(newData, size);
+    }
 
     m_CurrentFrame.memoryUpdates.push_back(std::move(memUpdate));
   }
@@ -13,6 +13,7 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/GeckoCode.h"
+#include "Core/HLE/HLE_Memory.h"
 #include "Core/HLE/HLE_Misc.h"
 #include "Core/HLE/HLE_OS.h"
 #include "Core/HW/Memmap.h"
@@ -26,7 +27,7 @@ namespace HLE
 static std::map<u32, u32> s_hooked_addresses;
 
 // clang-format off
-constexpr std::array<Hook, 23> os_patches{{
+constexpr std::array<Hook, 31> os_patches{{
     // Placeholder, os_patches[0] is the "non-existent function" index
     {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace, HookFlag::Generic},
 
@@ -56,6 +57,16 @@ constexpr std::array<Hook, 23> os_patches{{
     {"___blank",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug}, // used for early init things (normally)
     {"__write_console",              HLE_OS::HLE_write_console,             HookType::Start,   HookFlag::Debug}, // used by sysmenu (+more?)
 
+    // Memory routines, run on the host
+    {"memcpy",                       HLE_Memory::HLE_memcpy,                HookType::Replace, HookFlag::Memory},
+    {"memmove",                      HLE_Memory::HLE_memcpy,                HookType::Replace, HookFlag::Memory},
+    {"memset",                       HLE_Memory::HLE_memset,                HookType::Replace, HookFlag::Memory},
+    {"DCFlushRange",                 HLE_Memory::HLE_DCRangeOperation,      HookType::Replace, HookFlag::Memory},
+    {"DCFlushRangeNoSync",           HLE_Memory::HLE_DCRangeOperation,      HookType::Replace, HookFlag::Memory},
+    {"DCStoreRange",                 HLE_Memory::HLE_DCRangeOperation,      HookType::Replace, HookFlag::Memory},
+    {"DCStoreRangeNoSync",           HLE_Memory::HLE_DCRangeOperation,      HookType::Replace, HookFlag::Memory},
+    {"DCInvalidateRange",            HLE_Memory::HLE_DCRangeOperation,      HookType::Replace, HookFlag::Memory},
+
     {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,   HookFlag::Fixed},
     {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace, HookFlag::Fixed},
     {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Replace, HookFlag::Fixed} // apploader needs OSReport-like function
@@ -189,6 +200,13 @@ HookFlag GetHookFlagsByIndex(u32 index)
 
 bool IsEnabled(HookFlag flag)
 {
+  // The host copies don't go through the page table, and memory checks have to see every access
+  if (flag == HookFlag::Memory)
+  {
+    return Config::Get(Config::MAIN_HLE_MEMORY_FUNCTIONS) && !Config::Get(Config::MAIN_MMU) &&
+           !PowerPC::memchecks.HasAny();
+  }
+
   return flag != HLE::HookFlag::Debug || Config::Get(Config::MAIN_ENABLE_DEBUGGING) ||
          PowerPC::GetMode() == PowerPC::CoreMode::Interpreter;
 }
@@ -23,6 +23,7 @@ enum class HookFlag
   Generic,  // Miscellaneous function
   Debug,    // Debug output function
   Fixed,    // An arbitrary hook mapped to a fixed address instead of a symbol
+  Memory,   // Standard memory routine, only replaced with Config::MAIN_HLE_MEMORY_FUNCTIONS
 };
 
 struct Hook
@@ -0,0 +1,116 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HLE/HLE_Memory.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace HLE_Memory
+{
+namespace
+{
+// Runs fn(address, host_pointer, size) on each piece of [address, address + size) that doesn't
+// cross a page, with a null host_pointer for the pieces that aren't RAM
+template <typename Function>
+void ForEachPage(u32 address, u32 size, Function fn)
+{
+  while (size != 0)
+  {
+    const u32 chunk =
+        std::min<u32>(size, PowerPC::HW_PAGE_SIZE - (address & PowerPC::HW_PAGE_MASK));
+    const auto page = PowerPC::HostTryGetPagePointer(address);
+    // The pointer is only const because it's meant for reading, the RAM behind it is ours
+    fn(address, page ? const_cast<u8*>(page->value) : nullptr, chunk);
+    address += chunk;
+    size -= chunk;
+  }
+}
+
+// Whatever isn't RAM, such as the gather pipe, gets the same byte accesses a guest loop would do
+void ReadGuest(u32 address, u8* data, u32 size)
+{
+  ForEachPage(address, size, [&data](u32 guest_address, const u8* pointer, u32 chunk) {
+    if (pointer)
+      std::memcpy(data, pointer, chunk);
+    else
+      for (u32 i = 0; i < chunk; ++i)
+        data[i] = PowerPC::Read_U8(guest_address + i);
+    data += chunk;
+  });
+}
+
+void WriteGuest(u32 address, const u8* data, u32 size)
+{
+  ForEachPage(address, size, [&data](u32 guest_address, u8* pointer, u32 chunk) {
+    if (pointer)
+      std::memcpy(pointer, data, chunk);
+    else
+      for (u32 i = 0; i < chunk; ++i)
+        PowerPC::Write_U8(data[i], guest_address + i);
+    data += chunk;
+  });
+}
+}  // namespace
+
+// Also used for memmove. The copy goes through a buffer a block at a time, in the direction that
+// never writes over source bytes before they're read, so overlapping ranges work like memmove.
+void HLE_memcpy()
+{
+  constexpr u32 BLOCK_SIZE = 0x10000;
+  static std::array<u8, BLOCK_SIZE> s_buffer;
+
+  const u32 dest = GPR(3);
+  const u32 src = GPR(4);
+  const u32 size = GPR(5);
+  const bool backwards = dest > src;
+  for (u32 done = 0; done < size;)
+  {
+    const u32 block_size = std::min(size - done, BLOCK_SIZE);
+    const u32 offset = backwards ? size - done - block_size : done;
+    ReadGuest(src + offset, s_buffer.data(), block_size);
+    WriteGuest(dest + offset, s_buffer.data(), block_size);
+    done += block_size;
+  }
+
+  // dest stays in r3 as the return value
+  NPC = LR;
+}
+
+void HLE_memset()
+{
+  const u32 dest = GPR(3);
+  const u8 value = static_cast<u8>(GPR(4));
+  const u32 size = GPR(5);
+  ForEachPage(dest, size, [value](u32 guest_address, u8* pointer, u32 chunk) {
+    if (pointer)
+      std::memset(pointer, value, chunk);
+    else
+      for (u32 i = 0; i < chunk; ++i)
+        PowerPC::Write_U8(value, guest_address + i);
+  });
+
+  NPC = LR;
+}
+
+// DCFlushRange, DCStoreRange and DCInvalidateRange, which come down to the same thing without data
+// cache emulation: the dcbf/dcbst/dcbi loop only invalidates the JIT blocks on the touched lines
+void HLE_DCRangeOperation()
+{
+  const u32 address = GPR(3);
+  const u32 size = GPR(4);
+  if (size != 0)
+  {
+    const u32 start = address & ~31U;
+    JitInterface::InvalidateICache(start, ((address + size + 31) & ~31U) - start, false);
+  }
+
+  NPC = LR;
+}
+}  // namespace HLE_Memory
@@ -0,0 +1,11 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+namespace HLE_Memory
+{
+void HLE_memcpy();
+void HLE_memset();
+void HLE_DCRangeOperation();
+}  // namespace HLE_Memory
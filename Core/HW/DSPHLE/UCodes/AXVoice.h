@@ -12,10 +12,12 @@
 #endif
 
 #include <algorithm>
-#include <functional>
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -199,16 +201,18 @@ void AcceleratorSetup(PB_TYPE* pb)
   s_accelerator->SetPredScale(pb->adpcm.pred_scale);
 }
 
-// Reads a sample from the accelerator. Also handles looping and
+// Reads samples from the accelerator. Also handles looping and
 // disabling streams that reached the end (this is done by an exception raised
 // by the accelerator on real hardware).
-u16 AcceleratorGetSample()
+void AcceleratorGetSamples(s16* samples, u32 count)
 {
-  return s_accelerator->Read(acc_pb->adpcm.coefs);
+  s_accelerator->ReadSamples(acc_pb->adpcm.coefs, samples, count);
 }
 
 // Reads samples from the input callback, resamples them to <count> samples at
-// the wanted sample rate (computed from the ratio, see below).
+// the wanted sample rate (computed from the ratio, see below). The callback is
+// called as input_callback(s16* samples, u32 n) and has to fill in the next n
+// input samples.
 //
 // If srctype is SRCTYPE_POLYPHASE, coefficients need to be provided as well
 // (or the srctype will automatically be changed to LINEAR).
@@ -227,111 +231,77 @@ u16 AcceleratorGetSample()
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+template <typename InputCallback>
+u32 ResampleAudio(InputCallback input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
-  int read_samples_count = 0;
-
-  // If DSP DROM coefficients are available, support polyphase resampling.
-  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+  if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
   {
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
+    // Work out where each output sample is first, so that all the input samples of the frame can
+    // be read in one go. <window[i]> is the index in <input> of the oldest of the four samples
+    // used to interpolate output sample i.
+    std::array<u32, MAX_SAMPLES_PER_FRAME> window;
+    std::array<u16, MAX_SAMPLES_PER_FRAME> frac;
+    u32 read_samples_count = 0;
     for (u32 i = 0; i < count; ++i)
     {
       curr_pos += ratio;
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
-      const s16* c = &coeffs[curr_pos_frac];
-
-      s64 t0 = temp[idx++ & 3];
-      s64 t1 = temp[idx++ & 3];
-      s64 t2 = temp[idx++ & 3];
-      s64 t3 = temp[idx++ & 3];
-
-      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
-
-      output[i] = MathUtil::SaturatingCast<s16>(samp);
+      read_samples_count += curr_pos >> 16;
+      curr_pos &= 0xFFFF;
+      window[i] = read_samples_count;
+      frac[i] = static_cast<u16>(curr_pos);
     }
 
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
-  }
-  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
-  {
-    // This is the circular buffer containing samples to use for the
-    // interpolation. It is initialized with the values from the PB, and it
-    // will be stored back to the PB at the end.
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
+    // The input starts with the four last samples of the previous frame, which are stored back
+    // to the PB at the end.
+    std::array<s16, 4 + MAX_SAMPLES_PER_FRAME * 4> input_buffer;
+    std::vector<s16> large_input_buffer;
+    s16* input = input_buffer.data();
+    if (read_samples_count > input_buffer.size() - 4)
     {
-      curr_pos += ratio;
+      large_input_buffer.resize(4 + read_samples_count);
+      input = large_input_buffer.data();
+    }
+    std::copy_n(last_samples, 4, input);
+    input_callback(input + 4, read_samples_count);
 
-      // While our current position is >= 1.0, push new samples to the
-      // circular buffer.
-      while (curr_pos >= 0x10000)
+    // If DSP DROM coefficients are available, support polyphase resampling.
+    if (coeffs && srctype == SRCTYPE_POLYPHASE)
+    {
+      for (u32 i = 0; i < count; ++i)
       {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
+        const s16* t = &input[window[i]];
+        const s16* c = &coeffs[(frac[i] >> 9) << 2];
 
-      // Get our current fractional position, used to know how much of
-      // curr0 and how much of curr1 the output sample should be.
-      u16 curr_frac = curr_pos & 0xFFFF;
-      u16 inv_curr_frac = -curr_frac;
+        const s64 samp =
+            (s64(t[0]) * c[0] + s64(t[1]) * c[1] + s64(t[2]) * c[2] + s64(t[3]) * c[3]) >> 15;
 
-      // Interpolate! If curr_frac is 0, we can simply take the last
-      // sample without any multiplying.
-      s16 sample;
-      if (curr_frac)
-      {
-        s32 s0 = temp[idx++ & 3];
-        s32 s1 = temp[idx++ & 3];
-
-        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
-        idx += 2;
+        output[i] = MathUtil::SaturatingCast<s16>(samp);
       }
-      else
+    }
+    else
+    {
+      for (u32 i = 0; i < count; ++i)
       {
-        sample = temp[idx++ & 3];
-        idx += 3;
+        // Interpolate between the two oldest samples. If frac is 0, we can simply take the
+        // oldest sample without any multiplying.
+        const s16* t = &input[window[i]];
+        const u16 curr_frac = frac[i];
+        const u16 inv_curr_frac = -curr_frac;
+        if (curr_frac)
+          output[i] = ((s32(t[0]) * inv_curr_frac) + (s32(t[1]) * curr_frac)) >> 16;
+        else
+          output[i] = t[0];
       }
-
-      output[i] = sample;
     }
 
-    // Update the four last_samples values.
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
+    std::copy_n(&input[read_samples_count], 4, last_samples);
   }
   else  // SRCTYPE_NEAREST
   {
     // No sample rate conversion here: simply read samples from the
     // accelerator to the output buffer.
-    for (u32 i = 0; i < count; ++i)
-      output[i] = input_callback(i);
+    input_callback(output, count);
 
     memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
   }
@@ -347,9 +317,8 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+  u32 curr_pos = ResampleAudio(AcceleratorGetSamples, samples, count, pb.src.last_samples,
+                               pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -360,30 +329,72 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.adpcm.pred_scale = s_accelerator->GetPredScale();
 }
 
+// Scales samples by a volume that changes by <volume_delta> after each sample, like the DSP does,
+// and returns the volume after the last sample.
+u16 ApplyVolumeRamp(const s16* input, s16* output, u32 count, u16 volume, u16 volume_delta)
+{
+  u32 i = 0;
+#ifdef _M_X86
+  const __m128i volume_steps =
+      _mm_mullo_epi16(_mm_set1_epi16(volume_delta), _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7));
+  const __m128i volume_step8 = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  __m128i volumes = _mm_add_epi16(_mm_set1_epi16(volume), volume_steps);
+  for (; i + 8 <= count; i += 8)
+  {
+    // The volume is unsigned, so the signed high half of the product is short by the sample
+    // wherever the top bit of the volume is set.
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const __m128i lo = _mm_mullo_epi16(samples, volumes);
+    const __m128i hi = _mm_add_epi16(_mm_mulhi_epi16(samples, volumes),
+                                     _mm_and_si128(samples, _mm_srai_epi16(volumes, 15)));
+    const __m128i products_lo = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+    const __m128i products_hi = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                     _mm_max_epi16(_mm_packs_epi32(products_lo, products_hi), min_sample));
+    volumes = _mm_add_epi16(volumes, volume_step8);
+  }
+  volume += volume_delta * i;
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s32 sample = (s32(input[i]) * volume) >> 15;
+    output[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
+    volume += volume_delta;
+  }
+
+  return volume;
+}
+
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
+  if (count == 0)
+    return;
 
   // If volume ramping is disabled, set volume_delta to 0. That way, the
   // mixing loop can avoid testing if volume ramping is enabled at each step,
   // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
+  s16 samples[MAX_SAMPLES_PER_FRAME];
+  vd->volume = ApplyVolumeRamp(input, samples, count, vd->volume, ramp ? vd->volume_delta : 0);
 
-  for (u32 i = 0; i < count; ++i)
+  u32 i = 0;
+#ifdef _M_X86
+  for (; i + 8 <= count; i += 8)
   {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
+    const __m128i scaled = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+    const __m128i scaled_lo = _mm_srai_epi32(_mm_unpacklo_epi16(scaled, scaled), 16);
+    const __m128i scaled_hi = _mm_srai_epi32(_mm_unpackhi_epi16(scaled, scaled), 16);
+    __m128i* const dest = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(dest, _mm_add_epi32(_mm_loadu_si128(dest), scaled_lo));
+    _mm_storeu_si128(dest + 1, _mm_add_epi32(_mm_loadu_si128(dest + 1), scaled_hi));
   }
+#endif
+  for (; i < count; ++i)
+    out[i] += samples[i];
+
+  *dpop = samples[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -409,12 +420,8 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    const s32 sample = ((s32)samples[i] * pb.vol_env.cur_volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = ApplyVolumeRamp(samples, samples, count, pb.vol_env.cur_volume,
+                                          static_cast<u16>(pb.vol_env.cur_volume_delta));
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -516,9 +523,9 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 
     // We use ratio 0x55555 == (5 * 65536 + 21845) / 65536 == 5.3333 which
     // is the nearest we can get to 96/18
-    u32 curr_pos = ResampleAudio([&samples](u32 i) { return samples[i]; }, wm_samples, wm_count,
-                                 pb.remote_src.last_samples, pb.remote_src.cur_addr_frac, 0x55555,
-                                 SRCTYPE_POLYPHASE, coeffs);
+    u32 curr_pos = ResampleAudio([&samples](s16* out, u32 n) { std::copy_n(samples, n, out); },
+                                 wm_samples, wm_count, pb.remote_src.last_samples,
+                                 pb.remote_src.cur_addr_frac, 0x55555, SRCTYPE_POLYPHASE, coeffs);
     pb.remote_src.cur_addr_frac = curr_pos & 0xFFFF;
 
 // Mix to main[0-3] and aux[0-3]
@@ -57,6 +57,7 @@ void DSPLLE::DoState(PointerWrap& p)
 void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 {
   Common::SetCurrentThreadName("DSP thread");
+  Common::PlaceCurrentThread(Common::ThreadRole::DSP);
 
   while (dsp_lle->m_is_running.IsSet())
   {
@@ -1383,6 +1383,13 @@ static void ScheduleReads(u64 offset, u32 length, const DiscIO::Partition& parti
   // faster than on real hardware, and if there's too much latency in the wrong
   // places, the video before the save-file select screen lags.
 
+  if (Config::Get(Config::MAIN_INSTANT_DISC))
+  {
+    // The whole read is done in one go, and the drive buffer is left as it is
+    DVDThread::StartReadToEmulatedRAM(output_address, offset, length, partition, reply_type, 0);
+    return;
+  }
+
   const u64 current_time = CoreTiming::GetTicks();
   const u32 ticks_per_second = SystemTimers::GetTicksPerSecond();
   const bool wii_disc = DVDThread::GetDiscType() == DiscIO::Platform::WiiDisc;
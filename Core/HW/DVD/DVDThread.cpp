@@ -21,6 +21,7 @@
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -74,7 +75,11 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
 static void FinishRead(u64 id, s64 cycles_late);
 static CoreTiming::EventType* s_finish_read;
 
+static std::vector<u8> ReadDisc(const ReadRequest& request);
+
 static u64 s_next_id = 0;
+// Requests handed to the DVD thread since it was last known to be idle. Only used by the CPU thread
+static u32 s_requests_since_idle = 0;
 
 static std::thread s_dvd_thread;
 static Common::Event s_request_queue_expanded;    // Is set by CPU thread
@@ -251,6 +256,7 @@ void WaitUntilIdle()
 
   StopDVDThread();
   StartDVDThread();
+  s_requests_since_idle = 0;
 }
 
 void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
@@ -288,8 +294,22 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   request.time_started_ticks = CoreTiming::GetTicks();
   request.realtime_started_us = Common::Timer::GetTimeUs();
 
-  s_request_queue.Push(std::move(request));
-  s_request_queue_expanded.Set();
+  if (Config::Get(Config::MAIN_INSTANT_DISC))
+  {
+    // The disc is read right here, which races with the DVD thread if it's still reading it.
+    // FinishRead looks in s_result_map first, so the result is picked up from there.
+    if (s_requests_since_idle != 0)
+      WaitUntilIdle();
+    std::vector<u8> buffer = ReadDisc(request);
+    request.realtime_done_us = Common::Timer::GetTimeUs();
+    s_result_map.emplace(id, ReadResult(std::move(request), std::move(buffer)));
+  }
+  else
+  {
+    s_request_queue.Push(std::move(request));
+    s_request_queue_expanded.Set();
+    ++s_requests_since_idle;
+  }
 
   CoreTiming::ScheduleEvent(ticks_until_completion, s_finish_read, id);
 }
@@ -361,9 +381,32 @@ static void FinishRead(u64 id, s64 cycles_late)
   DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
 }
 
+static std::vector<u8> ReadDisc(const ReadRequest& request)
+{
+  FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
+
+  // The data still has to be copied into a buffer, since results are savestated and only get
+  // copied to emulated memory once the emulated read finishes. But a disc image that's mapped
+  // into memory can be copied from directly, without zero-filling the buffer first.
+  std::vector<u8> buffer;
+  if (const u8* data =
+          s_disc->GetDataPointer(request.dvd_offset, request.length, request.partition))
+  {
+    buffer.assign(data, data + request.length);
+  }
+  else
+  {
+    buffer.resize(request.length);
+    if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+      buffer.resize(0);
+  }
+  return buffer;
+}
+
 static void DVDThread()
 {
   Common::SetCurrentThreadName("DVD thread");
+  Common::PlaceCurrentThread(Common::ThreadRole::IO);
 
   while (true)
   {
@@ -375,11 +418,7 @@ static void DVDThread()
     ReadRequest request;
     while (s_request_queue.Pop(request))
     {
-      FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
-
-      std::vector<u8> buffer(request.length);
-      if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      std::vector<u8> buffer = ReadDisc(request);
 
       request.realtime_done_us = Common::Timer::GetTimeUs();
 
@@ -3,8 +3,13 @@
 
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
+#include <array>
+#include <cstring>
+#include <vector>
+
 #include <fcntl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
@@ -22,6 +27,9 @@ namespace ExpansionInterface
 
 constexpr char socket_path[] = "/tmp/dolphin-tap";
 
+// Enough for a burst of frames, and for the largest frame the size field can describe
+constexpr size_t READ_BUFFER_SIZE = 0x20000;
+
 bool CEXIETHERNET::TAPServerNetworkInterface::Activate()
 {
   if (IsActivated())
@@ -57,21 +65,15 @@ bool CEXIETHERNET::TAPServerNetworkInterface::Activate()
 
 bool CEXIETHERNET::TAPServerNetworkInterface::SendFrame(const u8* frame, u32 size)
 {
-  {
-    const std::string s = ArrayToString(frame, size, 0x10);
-    INFO_LOG_FMT(SP1, "SendFrame {}\n{}", size, s);
-  }
+  DEBUG_LOG_FMT(SP1, "SendFrame {}\n{}", size, ArrayToString(frame, size, 0x10));
 
+  // The size field and the frame go out in a single call
   auto size16 = u16(size);
-  if (write(fd, &size16, 2) != 2)
+  std::array<iovec, 2> iov{{{&size16, 2}, {const_cast<u8*>(frame), size}}};
+  const ssize_t written_bytes = writev(fd, iov.data(), static_cast<int>(iov.size()));
+  if (written_bytes != ssize_t(size + 2))
   {
-    ERROR_LOG_FMT(SP1, "SendFrame(): could not write size field");
-    return false;
-  }
-  int written_bytes = write(fd, frame, size);
-  if (u32(written_bytes) != size)
-  {
-    ERROR_LOG_FMT(SP1, "SendFrame(): expected to write {} bytes, instead wrote {}", size,
+    ERROR_LOG_FMT(SP1, "SendFrame(): expected to write {} bytes, instead wrote {}", size + 2,
                   written_bytes);
     return false;
   }
@@ -84,6 +86,11 @@ bool CEXIETHERNET::TAPServerNetworkInterface::SendFrame(const u8* frame, u32 siz
 
 void CEXIETHERNET::TAPServerNetworkInterface::ReadThreadHandler()
 {
+  // As much as is available is read at once, and every complete frame in it is handled before
+  // reading again. Only the start of a frame that hasn't fully arrived is kept for the next read.
+  std::vector<u8> buffer(READ_BUFFER_SIZE);
+  size_t buffered = 0;
+
   while (!readThreadShutdown.IsSet())
   {
     fd_set rfds;
@@ -96,26 +103,39 @@ void CEXIETHERNET::TAPServerNetworkInterface::ReadThreadHandler()
     if (select(fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
       continue;
 
-    u16 size;
-    if (read(fd, &size, 2) != 2)
+    const ssize_t read_bytes = read(fd, buffer.data() + buffered, buffer.size() - buffered);
+    if (read_bytes <= 0)
     {
-      ERROR_LOG_FMT(SP1, "Failed to read size field from BBA: {}", LastStrerrorString());
+      ERROR_LOG_FMT(SP1, "Failed to read packet data from BBA: {}", LastStrerrorString());
+      continue;
     }
-    else
+    buffered += read_bytes;
+
+    size_t offset = 0;
+    while (buffered - offset >= 2)
     {
-      int read_bytes = read(fd, m_eth_ref->mRecvBuffer.get(), size);
-      if (read_bytes < 0)
+      u16 size;
+      std::memcpy(&size, &buffer[offset], 2);
+      if (buffered - offset - 2 < size)
+        break;
+
+      const u8* frame = &buffer[offset + 2];
+      offset += 2 + size;
+      if (size > BBA_RECV_SIZE)
       {
-        ERROR_LOG_FMT(SP1, "Failed to read packet data from BBA: {}", LastStrerrorString());
+        ERROR_LOG_FMT(SP1, "Dropping a {} byte frame that doesn't fit the BBA", size);
       }
       else if (readEnabled.IsSet())
       {
-        std::string data_string = ArrayToString(m_eth_ref->mRecvBuffer.get(), read_bytes, 0x10);
-        INFO_LOG_FMT(SP1, "Read data: {}", data_string);
-        m_eth_ref->mRecvBufferLength = read_bytes;
+        DEBUG_LOG_FMT(SP1, "Read data: {}", ArrayToString(frame, size, 0x10));
+        std::memcpy(m_eth_ref->mRecvBuffer.get(), frame, size);
+        m_eth_ref->mRecvBufferLength = size;
         m_eth_ref->RecvHandlePacket();
       }
     }
+
+    std::memmove(buffer.data(), buffer.data() + offset, buffered - offset);
+    buffered -= offset;
   }
 }
 
@@ -3,6 +3,7 @@
 
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
+#include <cerrno>
 #include <cstring>
 
 #ifndef _WIN32
@@ -70,6 +71,9 @@ bool CEXIETHERNET::TAPNetworkInterface::Activate()
   }
   ioctl(fd, TUNSETNOCSUM, 1);
 
+  // The read thread drains every queued frame once select() wakes it up
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
   INFO_LOG_FMT(SP1, "BBA initialized with associated tap {}", ifr.ifr_name);
   return RecvInit();
 #else
@@ -140,17 +144,24 @@ void CEXIETHERNET::TAPNetworkInterface::ReadThreadHandler(TAPNetworkInterface* s
     if (select(self->fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
       continue;
 
-    int readBytes = read(self->fd, self->m_eth_ref->mRecvBuffer.get(), BBA_RECV_SIZE);
-    if (readBytes < 0)
-    {
-      ERROR_LOG_FMT(SP1, "Failed to read from BBA, err={}", readBytes);
-    }
-    else if (self->readEnabled.IsSet())
+    // Each read gives one frame, so bursts are handled without going back to select() in between
+    while (!self->readThreadShutdown.IsSet())
     {
-      DEBUG_LOG_FMT(SP1, "Read data: {}",
-                    ArrayToString(self->m_eth_ref->mRecvBuffer.get(), readBytes, 0x10));
-      self->m_eth_ref->mRecvBufferLength = readBytes;
-      self->m_eth_ref->RecvHandlePacket();
+      int readBytes = read(self->fd, self->m_eth_ref->mRecvBuffer.get(), BBA_RECV_SIZE);
+      if (readBytes < 0)
+      {
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+          ERROR_LOG_FMT(SP1, "Failed to read from BBA, err={}", readBytes);
+        break;
+      }
+
+      if (self->readEnabled.IsSet())
+      {
+        DEBUG_LOG_FMT(SP1, "Read data: {}",
+                      ArrayToString(self->m_eth_ref->mRecvBuffer.get(), readBytes, 0x10));
+        self->m_eth_ref->mRecvBufferLength = readBytes;
+        self->m_eth_ref->RecvHandlePacket();
+      }
     }
   }
 }
@@ -4,6 +4,7 @@
 #include "Core/HW/EXI/EXI_DeviceMemoryCard.h"
 
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <functional>
 #include <memory>
@@ -20,6 +21,8 @@
 #include "Common/FileUtil.h"
 #include "Common/IniFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
+#include "Common/Tracing.h"
 #include "Core/CommonTitles.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -29,7 +32,9 @@
 #include "Core/HW/EXI/EXI_Device.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
 #include "Core/HW/GCMemcard/GCMemcardDirectory.h"
+#include "Core/HW/GCMemcard/GCMemcardMemory.h"
 #include "Core/HW/GCMemcard/GCMemcardRaw.h"
+#include "Core/HW/GCMemcard/GCMemcardReadWatch.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/Sram.h"
 #include "Core/HW/SystemTimers.h"
@@ -103,7 +108,8 @@ void CEXIMemoryCard::Shutdown()
 
 CEXIMemoryCard::CEXIMemoryCard(const Slot slot, bool gci_folder,
                                const Memcard::HeaderData& header_data)
-    : m_card_slot(slot)
+    : m_card_slot(slot),
+      m_instant_transfer(Config::Get(Config::GetInfoForMemcardInstantTransfer(slot)))
 {
   ASSERT_MSG(EXPANSIONINTERFACE, IsMemcardSlot(slot), "Trying to create invalid memory card in {}.",
              slot);
@@ -129,7 +135,31 @@ CEXIMemoryCard::CEXIMemoryCard(const Slot slot, bool gci_folder,
   // card_id = 0xc243;
   m_card_id = 0xc221;  // It's a Nintendo brand memcard
 
-  if (gci_folder)
+  File::MappedFile shared_image;
+  if (const std::string shared_name = Memcard::GetInjectedSharedCardImage(slot);
+      !shared_name.empty() &&
+      !shared_image.OpenSharedMemory(shared_name, File::MappedFile::Mode::CopyOnWrite))
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE,
+                  "Could not map the shared card image {} injected into slot {}", shared_name,
+                  slot);
+  }
+
+  auto injected_image = Memcard::GetInjectedCardImage(slot);
+  if (shared_image.IsOpen())
+  {
+    INFO_LOG_FMT(EXPANSIONINTERFACE, "Using the shared card image injected into slot {}", slot);
+    auto memory_card = std::make_unique<MemoryCardMemory>(std::move(shared_image), m_card_slot);
+    if (injected_image)
+      memory_card->CopyImage(*injected_image);
+    m_memory_card = std::move(memory_card);
+  }
+  else if (injected_image)
+  {
+    INFO_LOG_FMT(EXPANSIONINTERFACE, "Using the card image injected into slot {}", slot);
+    m_memory_card = std::make_unique<MemoryCardMemory>(*injected_image, m_card_slot);
+  }
+  else if (gci_folder)
   {
     SetupGciFolder(header_data);
   }
@@ -237,6 +267,9 @@ CEXIMemoryCard::~CEXIMemoryCard()
 {
   CoreTiming::RemoveEvent(s_et_cmd_done[m_card_slot]);
   CoreTiming::RemoveEvent(s_et_transfer_complete[m_card_slot]);
+
+  INFO_LOG_FMT(EXPANSIONINTERFACE, "Memory card in slot {}: {}", s_card_short_names[m_card_slot],
+               m_access_counters.Summarize());
 }
 
 bool CEXIMemoryCard::UseDelayedTransferCompletion() const
@@ -268,7 +301,25 @@ void CEXIMemoryCard::TransferComplete()
 void CEXIMemoryCard::CmdDoneLater(u64 cycles)
 {
   CoreTiming::RemoveEvent(s_et_cmd_done[m_card_slot]);
-  CoreTiming::ScheduleEvent(cycles, s_et_cmd_done[m_card_slot], static_cast<u64>(m_card_slot));
+  CoreTiming::ScheduleEvent(m_instant_transfer ? 0 : cycles, s_et_cmd_done[m_card_slot],
+                            static_cast<u64>(m_card_slot));
+}
+
+u64 CEXIMemoryCard::GetTransferCycles(u32 size, u32 rate) const
+{
+  if (m_instant_transfer)
+    return 0;
+  return size * (SystemTimers::GetTicksPerSecond() / rate);
+}
+
+void CEXIMemoryCard::RecordTransfer(Memcard::AccessKind kind, u32 address, u32 size,
+                                    u64 emulated_cycles,
+                                    std::chrono::steady_clock::time_point host_start)
+{
+  m_access_counters.RecordTransfer(kind, address & (m_memory_card_size - 1), size,
+                                   m_instant_transfer ? 0 : emulated_cycles,
+                                   std::chrono::steady_clock::now() - host_start,
+                                   CoreTiming::GetTicks());
 }
 
 void CEXIMemoryCard::SetCS(int cs)
@@ -284,7 +335,11 @@ void CEXIMemoryCard::SetCS(int cs)
     case Command::SectorErase:
       if (m_position > 2)
       {
+        TRACE_SPAN("Memcard sector erase");
+        const auto host_start = std::chrono::steady_clock::now();
         m_memory_card->ClearBlock(m_address & (m_memory_card_size - 1));
+        RecordTransfer(Memcard::AccessKind::SectorErase, m_address, Memcard::BLOCK_SIZE, 5000,
+                       host_start);
         m_status |= MC_STATUS_BUSY;
         m_status &= ~MC_STATUS_READY;
 
@@ -299,7 +354,9 @@ void CEXIMemoryCard::SetCS(int cs)
       {
         // TODO: Investigate on HW, I (LPFaint99) believe that this only
         // erases the system area (Blocks 0-4)
+        const auto host_start = std::chrono::steady_clock::now();
         m_memory_card->ClearAll();
+        RecordTransfer(Memcard::AccessKind::ChipErase, 0, m_memory_card_size, 0, host_start);
         m_status &= ~MC_STATUS_BUSY;
       }
       break;
@@ -311,6 +368,22 @@ void CEXIMemoryCard::SetCS(int cs)
         int i = 0;
         m_status &= ~MC_STATUS_BUSY;
 
+        // Pages sent with DMA were already counted as they were written, and only the wait for
+        // the programming to finish is left
+        const auto host_start = std::chrono::steady_clock::now();
+        const u32 address = m_address;
+        const u32 size = static_cast<u32>(count);
+
+        // A page that neither wraps the programming buffer nor the sector offset is a single span.
+        // An empty page writes nothing, as the byte loop would.
+        if (count > 0 && count <= static_cast<int>(m_programming_buffer.size()) &&
+            (m_address & 0x1FF) + count <= 0x200)
+        {
+          m_memory_card->Write(m_address, count, m_programming_buffer.data());
+          m_address = (m_address & ~0x1FF) | ((m_address + count) & 0x1FF);
+          count = 0;
+        }
+
         while (count--)
         {
           m_memory_card->Write(m_address, 1, &(m_programming_buffer[i++]));
@@ -318,6 +391,7 @@ void CEXIMemoryCard::SetCS(int cs)
           m_address = (m_address & ~0x1FF) | ((m_address + 1) & 0x1FF);
         }
 
+        RecordTransfer(Memcard::AccessKind::Write, address, size, 5000, host_start);
         CmdDoneLater(5000);
       }
       break;
@@ -380,6 +454,28 @@ void CEXIMemoryCard::TransferByte(u8& byte)
       byte = 0xFF;
       m_position = 0;
     }
+
+    switch (m_command)
+    {
+    case Command::ReadArray:
+      m_access_counters.RecordCommand(Memcard::AccessKind::Read);
+      break;
+    case Command::PageProgram:
+      m_access_counters.RecordCommand(Memcard::AccessKind::Write);
+      break;
+    case Command::SectorErase:
+      m_access_counters.RecordCommand(Memcard::AccessKind::SectorErase);
+      break;
+    case Command::ChipErase:
+      m_access_counters.RecordCommand(Memcard::AccessKind::ChipErase);
+      break;
+    case Command::ReadStatus:
+      m_access_counters.RecordCommand(Memcard::AccessKind::Status);
+      break;
+    default:
+      m_access_counters.RecordCommand(Memcard::AccessKind::Other);
+      break;
+    }
   }
   else
   {
@@ -521,7 +617,12 @@ void CEXIMemoryCard::DoState(PointerWrap& p)
 // read all at once instead of single byte at a time as done by IEXIDevice::DMARead
 void CEXIMemoryCard::DMARead(u32 addr, u32 size)
 {
+  TRACE_SPAN("Memcard DMA read");
+  const auto host_start = std::chrono::steady_clock::now();
   m_memory_card->Read(m_address, size, Memory::GetPointer(addr));
+  Memcard::NotifyDMARead(m_card_slot, m_address, addr, size);
+  RecordTransfer(Memcard::AccessKind::Read, m_address, size,
+                 GetTransferCycles(size, MC_TRANSFER_RATE_READ), host_start);
 
   if ((m_address + size) % Memcard::BLOCK_SIZE == 0)
   {
@@ -529,7 +630,7 @@ void CEXIMemoryCard::DMARead(u32 addr, u32 size)
   }
 
   // Schedule transfer complete later based on read speed
-  CoreTiming::ScheduleEvent(size * (SystemTimers::GetTicksPerSecond() / MC_TRANSFER_RATE_READ),
+  CoreTiming::ScheduleEvent(GetTransferCycles(size, MC_TRANSFER_RATE_READ),
                             s_et_transfer_complete[m_card_slot], static_cast<u64>(m_card_slot));
 }
 
@@ -537,7 +638,11 @@ void CEXIMemoryCard::DMARead(u32 addr, u32 size)
 // write all at once instead of single byte at a time as done by IEXIDevice::DMAWrite
 void CEXIMemoryCard::DMAWrite(u32 addr, u32 size)
 {
+  TRACE_SPAN("Memcard DMA write");
+  const auto host_start = std::chrono::steady_clock::now();
   m_memory_card->Write(m_address, size, Memory::GetPointer(addr));
+  RecordTransfer(Memcard::AccessKind::Write, m_address, size,
+                 GetTransferCycles(size, MC_TRANSFER_RATE_WRITE), host_start);
 
   if (((m_address + size) % Memcard::BLOCK_SIZE) == 0)
   {
@@ -545,7 +650,7 @@ void CEXIMemoryCard::DMAWrite(u32 addr, u32 size)
   }
 
   // Schedule transfer complete later based on write speed
-  CoreTiming::ScheduleEvent(size * (SystemTimers::GetTicksPerSecond() / MC_TRANSFER_RATE_WRITE),
+  CoreTiming::ScheduleEvent(GetTransferCycles(size, MC_TRANSFER_RATE_WRITE),
                             s_et_transfer_complete[m_card_slot], static_cast<u64>(m_card_slot));
 }
 }  // namespace ExpansionInterface
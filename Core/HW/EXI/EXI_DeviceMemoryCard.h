@@ -4,12 +4,14 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "Core/HW/EXI/EXI_Device.h"
+#include "Core/HW/GCMemcard/GCMemcardAccessStats.h"
 
 class MemoryCardBase;
 class PointerWrap;
@@ -42,6 +44,13 @@ public:
   void DMARead(u32 addr, u32 size) override;
   void DMAWrite(u32 addr, u32 size) override;
 
+  // The backend holding the card contents. Only touch it from the CPU thread or while the CPU is
+  // paused.
+  MemoryCardBase* GetMemoryCard() const { return m_memory_card.get(); }
+
+  // What the game has done with the card since it was inserted. Readable from any thread.
+  const Memcard::AccessCounters& GetAccessCounters() const { return m_access_counters; }
+
   // CoreTiming events need to be registered during boot since CoreTiming is DoState()-ed
   // before ExpansionInterface so we'll lose the save stated events if the callbacks are
   // not already registered first.
@@ -72,6 +81,12 @@ private:
   // Variant of CmdDone which schedules an event later in the future to complete the command.
   void CmdDoneLater(u64 cycles);
 
+  // How long the card takes to move size bytes at the given rate, or 0 for instant transfers.
+  u64 GetTransferCycles(u32 size, u32 rate) const;
+
+  void RecordTransfer(Memcard::AccessKind kind, u32 address, u32 size, u64 emulated_cycles,
+                      std::chrono::steady_clock::time_point host_start);
+
   enum class Command
   {
     NintendoID = 0x00,
@@ -92,6 +107,8 @@ private:
   };
 
   Slot m_card_slot;
+  // Complete commands and transfers at the next event boundary instead of at card speed.
+  bool m_instant_transfer;
   //! memory card state
 
   // STATE_TO_SAVE
@@ -107,6 +124,8 @@ private:
   u32 m_memory_card_size;
   std::unique_ptr<MemoryCardBase> m_memory_card;
 
+  Memcard::AccessCounters m_access_counters;
+
 protected:
   void TransferByte(u8& byte) override;
 };
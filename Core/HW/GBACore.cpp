@@ -30,6 +30,7 @@
 #include "Core/Core.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
 #include "Core/NetPlayProto.h"
 
 namespace HW::GBA
@@ -244,6 +245,8 @@ bool Core::Start(u64 gc_ticks)
 
   if (Config::Get(Config::MAIN_GBA_THREADS))
   {
+    // Which syncs get merged depends on how fast the threads are, and that isn't deterministic
+    m_merge_syncs = !NetPlay::IsNetPlayRunning() && !Movie::IsMovieActive();
     m_idle = true;
     m_exit_loop = false;
     m_thread = std::make_unique<std::thread>([this] { ThreadLoop(); });
@@ -473,6 +476,16 @@ void Core::SendJoybusCommand(u64 gc_ticks, int transfer_time, u8* buffer, u16 ke
   if (m_thread)
   {
     std::lock_guard<std::mutex> lock(m_queue_mutex);
+    // A GBA thread that hasn't even started on the last sync can run to this one instead, so
+    // several GBAs that fall behind don't pile up wake-ups
+    if (m_merge_syncs && command.sync_only && !m_command_queue.empty() &&
+        m_command_queue.back().sync_only && m_command_queue.back().transfer_time == 0)
+    {
+      Command& last = m_command_queue.back();
+      last.ticks = std::max(last.ticks, command.ticks);
+      last.keys = command.keys;
+      return;
+    }
     m_command_queue.push(command);
     m_idle = false;
     m_command_cv.notify_one();
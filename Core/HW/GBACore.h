@@ -127,6 +127,7 @@ private:
   std::unique_ptr<std::thread> m_thread;
   bool m_exit_loop = false;
   bool m_idle = false;
+  bool m_merge_syncs = false;
   std::mutex m_queue_mutex;
   std::condition_variable m_command_cv;
   std::queue<Command> m_command_queue;
@@ -3,13 +3,53 @@
 
 #include "Core/HW/GCMemcard/GCIFile.h"
 
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <xxhash.h>
+
+#include <fmt/format.h>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 
 namespace Memcard
 {
+namespace
+{
+struct GCIHeaderKey
+{
+  u64 path_hash;
+  u64 file_size;
+  s64 modification_time;
+};
+
+class GCIHeaderIndexReader final : public LinearDiskCacheReader<GCIHeaderKey, DEntry>
+{
+public:
+  void Read(const GCIHeaderKey& key, const DEntry* value, u32 value_size) override
+  {
+    // Later entries for a path supersede earlier ones
+    if (value_size == 1)
+      m_entries[key.path_hash] = {key, *value};
+  }
+
+  std::unordered_map<u64, std::pair<GCIHeaderKey, DEntry>> m_entries;
+};
+
+u64 HashPath(const std::string& path)
+{
+  return XXH64(path.data(), path.size(), 0);
+}
+}  // namespace
+
 bool GCIFile::LoadHeader()
 {
   if (m_filename.empty())
@@ -62,6 +102,7 @@ bool GCIFile::LoadSaveBlocks()
       m_save_data.clear();
       return false;
     }
+    m_dirty_blocks.assign(num_blocks, false);
   }
   return true;
 }
@@ -98,5 +139,80 @@ void GCIFile::DoState(PointerWrap& p)
     p.DoPOD<GCMBlock>(*itr);
   }
   p.Do(m_used_blocks);
+
+  // Whatever was loaded may differ from the file anywhere
+  if (p.IsReadMode())
+    m_dirty_blocks.clear();
+}
+std::vector<GCIHeaderEntry> ReadGCIHeaders(const std::string& directory)
+{
+  const std::string index_path = File::GetUserPath(D_CACHE_IDX) +
+                                 fmt::format("GCIHeaders-{:016x}.cache", HashPath(directory));
+  GCIHeaderIndexReader reader;
+  LinearDiskCache<GCIHeaderKey, DEntry> index;
+  const u32 indexed_count = index.OpenAndRead(index_path, reader);
+
+  // A file changed within the same second as its header was read can't be told apart from an
+  // unchanged one, so recently modified files are left out of the index until they've settled.
+  const s64 settled_before = static_cast<s64>(std::time(nullptr)) - 1;
+
+  std::vector<GCIHeaderEntry> headers;
+  std::vector<GCIHeaderKey> keys;
+  std::vector<std::pair<GCIHeaderKey, DEntry>> new_entries;
+  size_t reused_count = 0;
+  for (const std::string& filename : Common::DoFileSearch({directory}, {".gci"}))
+  {
+    const File::FileInfo info(filename);
+    if (!info.IsFile())
+      continue;
+
+    const GCIHeaderKey key{HashPath(filename), info.GetSize(), info.GetModificationTime()};
+    const auto cached = reader.m_entries.find(key.path_hash);
+    if (cached != reader.m_entries.end() && cached->second.first.file_size == key.file_size &&
+        cached->second.first.modification_time == key.modification_time)
+    {
+      headers.push_back({filename, key.file_size, cached->second.second});
+      keys.push_back(key);
+      ++reused_count;
+      continue;
+    }
+
+    File::IOFile file(filename, "rb");
+    DEntry header;
+    if (!file || !file.ReadBytes(&header, DENTRY_SIZE))
+    {
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to load header of {}", filename);
+      continue;
+    }
+
+    INFO_LOG_FMT(EXPANSIONINTERFACE, "Read header from disk for {}", filename);
+    headers.push_back({filename, key.file_size, header});
+    keys.push_back(key);
+    if (key.modification_time != 0 && key.modification_time < settled_before)
+      new_entries.emplace_back(key, header);
+  }
+
+  // Start the index over once it holds more outdated entries than current ones
+  if (indexed_count > 2 * headers.size())
+  {
+    index.Close();
+    File::Delete(index_path);
+    index.OpenAndRead(index_path, reader);
+    for (size_t i = 0; i < headers.size(); ++i)
+    {
+      if (keys[i].modification_time != 0 && keys[i].modification_time < settled_before)
+        index.Append(keys[i], &headers[i].header, 1);
+    }
+  }
+  else
+  {
+    for (const auto& [key, header] : new_entries)
+      index.Append(key, &header, 1);
+  }
+  index.Close();
+
+  INFO_LOG_FMT(EXPANSIONINTERFACE, "Found {} GCI headers in {}, {} from the index", headers.size(),
+               directory, reused_count);
+  return headers;
 }
 }  // namespace Memcard
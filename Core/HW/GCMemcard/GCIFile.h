@@ -24,8 +24,23 @@ public:
 
   DEntry m_gci_header;
   std::vector<GCMBlock> m_save_data;
+  // Which blocks of m_save_data changed since they were last written to m_filename. Doesn't match
+  // m_save_data in size when that's unknown, in which case the whole file has to be rewritten.
+  std::vector<bool> m_dirty_blocks;
   std::vector<u16> m_used_blocks;
   bool m_dirty = false;
   std::string m_filename;
 };
+
+struct GCIHeaderEntry
+{
+  std::string filename;
+  u64 file_size;
+  DEntry header;
+};
+
+// The header of every .gci file in a directory. Headers are remembered in an index in the user's
+// cache folder, keyed by path, size and modification time, so as long as a file hasn't changed it
+// only has to be stat'ed instead of opened.
+std::vector<GCIHeaderEntry> ReadGCIHeaders(const std::string& directory);
 }  // namespace Memcard
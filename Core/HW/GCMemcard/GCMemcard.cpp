@@ -5,22 +5,40 @@
 
 #include <algorithm>
 #include <cstring>
+#include <new>
 #include <utility>
 #include <vector>
 
 #include "Common/Assert.h"
+#include "Common/BitSet.h"
 #include "Common/BitUtils.h"
 #include "Common/ColorUtil.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/Intrinsics.h"
+#include "Common/MappedFile.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Tracing.h"
 
+#include "Core/HW/GCMemcard/GCMemcardFixups.h"
+#include "Core/HW/GCMemcard/GCMemcardGeometry.h"
 #include "Core/HW/GCMemcard/GCMemcardUtils.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 static constexpr std::optional<u64> BytesToMegabits(u64 bytes)
 {
   const u64 factor = ((1024 * 1024) / 8);
@@ -59,8 +77,116 @@ GCMemcardErrorCode& GCMemcardErrorCode::operator|=(const GCMemcardErrorCode& oth
   return *this;
 }
 
+GCMemcardBlockPool::GCMemcardBlockPool(bool use_huge_pages) : m_use_huge_pages(use_huge_pages)
+{
+}
+
+GCMemcardBlockPool::~GCMemcardBlockPool()
+{
+  for (const Slab& slab : m_free_slabs)
+    FreeSlab(slab);
+}
+
+GCMBlock* GCMemcardBlockPool::Allocate(size_t block_count)
+{
+  {
+    std::lock_guard lk(m_mutex);
+    const auto it = std::find_if(m_free_slabs.begin(), m_free_slabs.end(),
+                                 [&](const Slab& slab) { return slab.block_count == block_count; });
+    if (it != m_free_slabs.end())
+    {
+      GCMBlock* blocks = it->blocks;
+      m_idle_bytes -= block_count * sizeof(GCMBlock);
+      m_free_slabs.erase(it);
+      return blocks;
+    }
+  }
+
+  GCMBlock* blocks = AllocateSlab(block_count);
+  if (!blocks)
+  {
+    // idle storage of other sizes may be what's in the way
+    Trim();
+    blocks = AllocateSlab(block_count);
+    if (!blocks)
+      throw std::bad_alloc();
+  }
+  return blocks;
+}
+
+void GCMemcardBlockPool::Free(GCMBlock* blocks, size_t block_count)
+{
+  std::vector<Slab> released;
+  {
+    std::lock_guard lk(m_mutex);
+    m_free_slabs.push_back({blocks, block_count});
+    m_idle_bytes += block_count * sizeof(GCMBlock);
+    while (m_idle_bytes > MAX_IDLE_BYTES)
+    {
+      released.push_back(m_free_slabs.front());
+      m_idle_bytes -= m_free_slabs.front().block_count * sizeof(GCMBlock);
+      m_free_slabs.pop_front();
+    }
+  }
+
+  for (const Slab& slab : released)
+    FreeSlab(slab);
+}
+
+void GCMemcardBlockPool::Trim()
+{
+  std::deque<Slab> released;
+  {
+    std::lock_guard lk(m_mutex);
+    released.swap(m_free_slabs);
+    m_idle_bytes = 0;
+  }
+
+  for (const Slab& slab : released)
+    FreeSlab(slab);
+}
+
+GCMBlock* GCMemcardBlockPool::AllocateSlab(size_t block_count) const
+{
+  const size_t size = block_count * sizeof(GCMBlock);
+  if (!m_use_huge_pages)
+    return static_cast<GCMBlock*>(Common::AllocateMemoryPages(size));
+
+  constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+  void* blocks = Common::AllocateAlignedMemory(size, HUGE_PAGE_SIZE);
+#ifdef __linux__
+  if (blocks)
+    madvise(blocks, size, MADV_HUGEPAGE);
+#endif
+  return static_cast<GCMBlock*>(blocks);
+}
+
+void GCMemcardBlockPool::FreeSlab(const Slab& slab) const
+{
+  if (m_use_huge_pages)
+    Common::FreeAlignedMemory(slab.blocks);
+  else
+    Common::FreeMemoryPages(slab.blocks, slab.block_count * sizeof(GCMBlock));
+}
+
+GCMBlock* GCMemcardBlockAllocator::allocate(size_t count)
+{
+  if (m_pool)
+    return m_pool->Allocate(count);
+  return std::allocator<GCMBlock>().allocate(count);
+}
+
+void GCMemcardBlockAllocator::deallocate(GCMBlock* blocks, size_t count)
+{
+  if (m_pool)
+    m_pool->Free(blocks, count);
+  else
+    std::allocator<GCMBlock>().deallocate(blocks, count);
+}
+
 GCMemcard::GCMemcard()
-    : m_valid(false), m_size_blocks(0), m_size_mb(0), m_active_directory(0), m_active_bat(0)
+    : m_valid(false), m_size_blocks(0), m_size_mb(0), m_source_file_tracked(false),
+      m_active_directory(0), m_active_bat(0)
 {
 }
 
@@ -68,29 +194,26 @@ std::optional<GCMemcard> GCMemcard::Create(std::string filename, const CardFlash
                                            u16 size_mbits, bool shift_jis, u32 rtc_bias,
                                            u32 sram_language, u64 format_time)
 {
-  GCMemcard card;
+  GCMemcard card =
+      CreateInMemory(flash_id, size_mbits, shift_jis, rtc_bias, sram_language, format_time);
   card.m_filename = std::move(filename);
-
-  // TODO: Format() not only formats the card but also writes it to disk at m_filename.
-  // Those tasks should probably be separated.
-  if (!card.Format(flash_id, size_mbits, shift_jis, rtc_bias, sram_language, format_time))
+  if (!card.Save())
     return std::nullopt;
 
   return std::move(card);
 }
 
-std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> GCMemcard::Open(std::string filename)
+GCMemcard GCMemcard::CreateInMemory(const CardFlashId& flash_id, u16 size_mbits, bool shift_jis,
+                                    u32 rtc_bias, u32 sram_language, u64 format_time)
 {
-  GCMemcardErrorCode error_code;
-  File::IOFile file(filename, "rb");
-  if (!file.IsOpen())
-  {
-    error_code.Set(GCMemcardValidityIssues::FAILED_TO_OPEN);
-    return std::make_pair(error_code, std::nullopt);
-  }
+  GCMemcard card;
+  card.FormatInMemory(flash_id, size_mbits, shift_jis, rtc_bias, sram_language, format_time);
+  return card;
+}
 
-  // check if the filesize is a valid memory card size
-  const u64 filesize = file.GetSize();
+// returns the card size in megabits if the given file size is a valid memory card size
+static std::optional<u16> CardSizeMbitsFromFileSize(u64 filesize)
+{
   const u64 filesize_megabits = BytesToMegabits(filesize).value_or(0);
   const std::array<u16, 6> valid_megabits = {{
       MBIT_SIZE_MEMORY_CARD_59,
@@ -103,12 +226,34 @@ std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> GCMemcard::Open(std::str
 
   if (!std::any_of(valid_megabits.begin(), valid_megabits.end(),
                    [filesize_megabits](u64 mbits) { return mbits == filesize_megabits; }))
+  {
+    return std::nullopt;
+  }
+
+  return static_cast<u16>(filesize_megabits);
+}
+
+std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+GCMemcard::Open(std::string filename, const GCMemcardOpenOptions& options)
+{
+  TRACE_SPAN("GCMemcard::Open");
+  GCMemcardErrorCode error_code;
+  File::IOFile file(filename, "rb");
+  if (!file.IsOpen())
+  {
+    error_code.Set(GCMemcardValidityIssues::FAILED_TO_OPEN);
+    return std::make_pair(error_code, std::nullopt);
+  }
+
+  // check if the filesize is a valid memory card size
+  const std::optional<u16> card_size_mbits_opt = CardSizeMbitsFromFileSize(file.GetSize());
+  if (!card_size_mbits_opt)
   {
     error_code.Set(GCMemcardValidityIssues::INVALID_CARD_SIZE);
     return std::make_pair(error_code, std::nullopt);
   }
 
-  const u16 card_size_mbits = static_cast<u16>(filesize_megabits);
+  const u16 card_size_mbits = *card_size_mbits_opt;
 
   // read the entire card into memory
   GCMemcard card;
@@ -125,15 +270,12 @@ std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> GCMemcard::Open(std::str
 
   const u16 card_size_blocks = card_size_mbits * MBIT_TO_BLOCKS;
   const u16 user_data_blocks = card_size_blocks - MC_FST_BLOCKS;
-  card.m_data_blocks.reserve(user_data_blocks);
-  for (u16 i = 0; i < user_data_blocks; ++i)
+  card.m_data_blocks = GCMemcardBlockVector(GCMemcardBlockAllocator(options.block_pool));
+  card.m_data_blocks.resize(user_data_blocks);
+  if (!file.ReadArray(card.m_data_blocks.data(), user_data_blocks))
   {
-    GCMBlock& block = card.m_data_blocks.emplace_back();
-    if (!file.ReadArray(block.m_block.data(), BLOCK_SIZE))
-    {
-      error_code.Set(GCMemcardValidityIssues::IO_ERROR);
-      return std::make_pair(error_code, std::nullopt);
-    }
+    error_code.Set(GCMemcardValidityIssues::IO_ERROR);
+    return std::make_pair(error_code, std::nullopt);
   }
 
   file.Close();
@@ -141,13 +283,160 @@ std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> GCMemcard::Open(std::str
   card.m_filename = std::move(filename);
   card.m_size_blocks = card_size_blocks;
   card.m_size_mb = card_size_mbits;
+  card.m_changed_data_blocks.assign(card.m_size_blocks - MC_FST_BLOCKS, false);
+  card.m_source_file_tracked = true;
+
+  if (options.skip_validation)
+  {
+    card.SelectActiveBlocks();
+    card.m_valid = true;
+    return std::make_pair(error_code, std::move(card));
+  }
+
+  error_code |= card.Validate();
+  if (!card.m_valid)
+    return std::make_pair(error_code, std::nullopt);
+
+  return std::make_pair(error_code, std::move(card));
+}
+
+std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+GCMemcard::OpenImage(const u8* image, size_t size, const GCMemcardOpenOptions& options)
+{
+  GCMemcardErrorCode error_code;
+  const std::optional<u16> card_size_mbits_opt = CardSizeMbitsFromFileSize(size);
+  if (!card_size_mbits_opt)
+  {
+    error_code.Set(GCMemcardValidityIssues::INVALID_CARD_SIZE);
+    return std::make_pair(error_code, std::nullopt);
+  }
+
+  const u16 card_size_mbits = *card_size_mbits_opt;
+  const u16 card_size_blocks = card_size_mbits * MBIT_TO_BLOCKS;
+  const u16 user_data_blocks = card_size_blocks - MC_FST_BLOCKS;
+
+  GCMemcard card;
+  std::memcpy(&card.m_header_block, &image[BLOCK_SIZE * 0], BLOCK_SIZE);
+  std::memcpy(&card.m_directory_blocks[0], &image[BLOCK_SIZE * 1], BLOCK_SIZE);
+  std::memcpy(&card.m_directory_blocks[1], &image[BLOCK_SIZE * 2], BLOCK_SIZE);
+  std::memcpy(&card.m_bat_blocks[0], &image[BLOCK_SIZE * 3], BLOCK_SIZE);
+  std::memcpy(&card.m_bat_blocks[1], &image[BLOCK_SIZE * 4], BLOCK_SIZE);
+  card.m_data_blocks = GCMemcardBlockVector(GCMemcardBlockAllocator(options.block_pool));
+  card.m_data_blocks.resize(user_data_blocks);
+  std::memcpy(card.m_data_blocks.data(), &image[BLOCK_SIZE * MC_FST_BLOCKS],
+              size_t(user_data_blocks) * BLOCK_SIZE);
+
+  card.m_size_blocks = card_size_blocks;
+  card.m_size_mb = card_size_mbits;
+  card.m_changed_data_blocks.assign(card.m_size_blocks - MC_FST_BLOCKS, false);
+  card.m_source_file_tracked = false;
+
+  if (options.skip_validation)
+  {
+    card.SelectActiveBlocks();
+    card.m_valid = true;
+    return std::make_pair(error_code, std::move(card));
+  }
+
+  error_code |= card.Validate();
+  if (!card.m_valid)
+    return std::make_pair(error_code, std::nullopt);
+
+  return std::make_pair(error_code, std::move(card));
+}
+
+std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+GCMemcard::OpenMapped(std::string filename, const GCMemcardOpenOptions& options)
+{
+  TRACE_SPAN("GCMemcard::OpenMapped");
+  GCMemcardErrorCode error_code;
+  File::MappedFile mapping(filename, File::MappedFile::Mode::CopyOnWrite);
+  if (!mapping.IsOpen())
+  {
+    error_code.Set(GCMemcardValidityIssues::FAILED_TO_OPEN);
+    return std::make_pair(error_code, std::nullopt);
+  }
+
+  return OpenFromMapping(std::move(mapping), std::move(filename), options);
+}
+
+std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+GCMemcard::OpenSharedMemory(const std::string& name, const GCMemcardOpenOptions& options)
+{
+  TRACE_SPAN("GCMemcard::OpenSharedMemory");
+  File::MappedFile mapping;
+  if (!mapping.OpenSharedMemory(name, File::MappedFile::Mode::CopyOnWrite))
+  {
+    GCMemcardErrorCode error_code;
+    error_code.Set(GCMemcardValidityIssues::FAILED_TO_OPEN);
+    return std::make_pair(error_code, std::nullopt);
+  }
+
+  return OpenFromMapping(std::move(mapping), {}, options);
+}
+
+std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+GCMemcard::OpenFromMapping(File::MappedFile mapping, std::string filename,
+                           const GCMemcardOpenOptions& options)
+{
+  GCMemcardErrorCode error_code;
+  const std::optional<u16> card_size_mbits_opt = CardSizeMbitsFromFileSize(mapping.GetSize());
+  if (!card_size_mbits_opt)
+  {
+    error_code.Set(GCMemcardValidityIssues::INVALID_CARD_SIZE);
+    return std::make_pair(error_code, std::nullopt);
+  }
+
+  const u16 card_size_mbits = *card_size_mbits_opt;
+
+  // only the filesystem blocks are copied out, the data blocks stay in the mapping and are paged in
+  // on first access
+  GCMemcard card;
+  const u8* data = mapping.GetData();
+  std::memcpy(&card.m_header_block, &data[BLOCK_SIZE * 0], BLOCK_SIZE);
+  std::memcpy(&card.m_directory_blocks[0], &data[BLOCK_SIZE * 1], BLOCK_SIZE);
+  std::memcpy(&card.m_directory_blocks[1], &data[BLOCK_SIZE * 2], BLOCK_SIZE);
+  std::memcpy(&card.m_bat_blocks[0], &data[BLOCK_SIZE * 3], BLOCK_SIZE);
+  std::memcpy(&card.m_bat_blocks[1], &data[BLOCK_SIZE * 4], BLOCK_SIZE);
+  card.m_mapping = std::move(mapping);
+  // still used by clones of this card
+  card.m_data_blocks = GCMemcardBlockVector(GCMemcardBlockAllocator(options.block_pool));
+
+  // a card from shared memory has no file that could be tracked
+  card.m_source_file_tracked = !filename.empty();
+  card.m_filename = std::move(filename);
+  card.m_size_blocks = card_size_mbits * MBIT_TO_BLOCKS;
+  card.m_size_mb = card_size_mbits;
+  card.m_changed_data_blocks.assign(card.m_size_blocks - MC_FST_BLOCKS, false);
+
+  if (options.skip_validation)
+  {
+    card.SelectActiveBlocks();
+    card.m_valid = true;
+    return std::make_pair(error_code, std::move(card));
+  }
+
+  error_code |= card.Validate();
+  if (!card.m_valid)
+    return std::make_pair(error_code, std::nullopt);
+
+  return std::make_pair(error_code, std::move(card));
+}
+
+GCMemcardErrorCode GCMemcard::Validate()
+{
+  m_valid = false;
+  // the repair below may rewrite a Dir or BAT block
+  InvalidateFileSystemBlockHashes();
+  const u16 card_size_mbits = m_size_mb;
 
   // can return invalid card size, invalid checksum, data in unused area
   // data in unused area is okay, otherwise fail
-  const GCMemcardErrorCode header_error_code = card.m_header_block.CheckForErrors(card_size_mbits);
+  GCMemcardErrorCode error_code;
+  const GCMemcardErrorCode header_error_code = m_header_block.CheckForErrors(card_size_mbits);
   error_code |= header_error_code;
   if (header_error_code.HasCriticalErrors())
-    return std::make_pair(error_code, std::nullopt);
+    return error_code;
 
   // The GC BIOS counts any card as corrupted as long as at least any two of [dir0, dir1, bat0,
   // bat1] are corrupted. Yes, even if we have one valid dir and one valid bat, and even if those
@@ -171,12 +460,12 @@ std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> GCMemcard::Open(std::str
   // memory card.
 
   // can return invalid checksum, data in unused area
-  GCMemcardErrorCode dir_block_0_error_code = card.m_directory_blocks[0].CheckForErrors();
-  GCMemcardErrorCode dir_block_1_error_code = card.m_directory_blocks[1].CheckForErrors();
+  GCMemcardErrorCode dir_block_0_error_code = m_directory_blocks[0].CheckForErrors();
+  GCMemcardErrorCode dir_block_1_error_code = m_directory_blocks[1].CheckForErrors();
 
   // can return invalid card size, invalid checksum, data in unused area, free block mismatch
-  GCMemcardErrorCode bat_block_0_error_code = card.m_bat_blocks[0].CheckForErrors(card_size_mbits);
-  GCMemcardErrorCode bat_block_1_error_code = card.m_bat_blocks[1].CheckForErrors(card_size_mbits);
+  GCMemcardErrorCode bat_block_0_error_code = m_bat_blocks[0].CheckForErrors(card_size_mbits);
+  GCMemcardErrorCode bat_block_1_error_code = m_bat_blocks[1].CheckForErrors(card_size_mbits);
 
   const bool dir_block_0_valid = !dir_block_0_error_code.HasCriticalErrors();
   const bool dir_block_1_valid = !dir_block_1_error_code.HasCriticalErrors();
@@ -201,7 +490,7 @@ std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> GCMemcard::Open(std::str
     error_code |= dir_block_1_error_code;
     error_code |= bat_block_0_error_code;
     error_code |= bat_block_1_error_code;
-    return std::make_pair(error_code, std::nullopt);
+    return error_code;
   }
 
   // if exactly one block is corrupted copy and update it over the non-corrupted block
@@ -209,31 +498,31 @@ std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> GCMemcard::Open(std::str
   {
     if (!dir_block_0_valid)
     {
-      card.m_directory_blocks[0] = card.m_directory_blocks[1];
-      card.m_directory_blocks[0].m_update_counter = card.m_directory_blocks[0].m_update_counter + 1;
-      card.m_directory_blocks[0].FixChecksums();
-      dir_block_0_error_code = card.m_directory_blocks[0].CheckForErrors();
+      m_directory_blocks[0] = m_directory_blocks[1];
+      m_directory_blocks[0].m_update_counter = m_directory_blocks[0].m_update_counter + 1;
+      m_directory_blocks[0].FixChecksums();
+      dir_block_0_error_code = m_directory_blocks[0].CheckForErrors();
     }
     else if (!dir_block_1_valid)
     {
-      card.m_directory_blocks[1] = card.m_directory_blocks[0];
-      card.m_directory_blocks[1].m_update_counter = card.m_directory_blocks[1].m_update_counter + 1;
-      card.m_directory_blocks[1].FixChecksums();
-      dir_block_1_error_code = card.m_directory_blocks[1].CheckForErrors();
+      m_directory_blocks[1] = m_directory_blocks[0];
+      m_directory_blocks[1].m_update_counter = m_directory_blocks[1].m_update_counter + 1;
+      m_directory_blocks[1].FixChecksums();
+      dir_block_1_error_code = m_directory_blocks[1].CheckForErrors();
     }
     else if (!bat_block_0_valid)
     {
-      card.m_bat_blocks[0] = card.m_bat_blocks[1];
-      card.m_bat_blocks[0].m_update_counter = card.m_bat_blocks[0].m_update_counter + 1;
-      card.m_bat_blocks[0].FixChecksums();
-      bat_block_0_error_code = card.m_bat_blocks[0].CheckForErrors(card_size_mbits);
+      m_bat_blocks[0] = m_bat_blocks[1];
+      m_bat_blocks[0].m_update_counter = m_bat_blocks[0].m_update_counter + 1;
+      m_bat_blocks[0].FixChecksums();
+      bat_block_0_error_code = m_bat_blocks[0].CheckForErrors(card_size_mbits);
     }
     else if (!bat_block_1_valid)
     {
-      card.m_bat_blocks[1] = card.m_bat_blocks[0];
-      card.m_bat_blocks[1].m_update_counter = card.m_bat_blocks[1].m_update_counter + 1;
-      card.m_bat_blocks[1].FixChecksums();
-      bat_block_1_error_code = card.m_bat_blocks[1].CheckForErrors(card_size_mbits);
+      m_bat_blocks[1] = m_bat_blocks[0];
+      m_bat_blocks[1].m_update_counter = m_bat_blocks[1].m_update_counter + 1;
+      m_bat_blocks[1].FixChecksums();
+      bat_block_1_error_code = m_bat_blocks[1].CheckForErrors(card_size_mbits);
     }
     else
     {
@@ -247,33 +536,116 @@ std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> GCMemcard::Open(std::str
   error_code |= bat_block_0_error_code;
   error_code |= bat_block_1_error_code;
 
-  // select the in-use Dir and BAT blocks based on update counter
+  SelectActiveBlocks();
+
+  // check for consistency between the active Dir and BAT
+  const GCMemcardErrorCode dir_bat_consistency_error_code =
+      GetActiveDirectory().CheckForErrorsWithBat(GetActiveBat(), card_size_mbits);
+  error_code |= dir_bat_consistency_error_code;
+  if (error_code.HasCriticalErrors())
+    return error_code;
+
+  m_valid = true;
 
+  return error_code;
+}
+
+void GCMemcard::SelectActiveBlocks()
+{
   // These are compared as signed values by the GC BIOS. There is no protection against overflow, so
   // if one block is MAX_VAL and the other is MIN_VAL it still picks the MAX_VAL one as the active
   // one, even if that results in a corrupted memory card.
   // TODO: We could try to be smarter about this to rescue seemingly-corrupted cards.
 
-  if (card.m_directory_blocks[0].m_update_counter >= card.m_directory_blocks[1].m_update_counter)
-    card.m_active_directory = 0;
+  if (m_directory_blocks[0].m_update_counter >= m_directory_blocks[1].m_update_counter)
+    m_active_directory = 0;
   else
-    card.m_active_directory = 1;
+    m_active_directory = 1;
 
-  if (card.m_bat_blocks[0].m_update_counter >= card.m_bat_blocks[1].m_update_counter)
-    card.m_active_bat = 0;
+  if (m_bat_blocks[0].m_update_counter >= m_bat_blocks[1].m_update_counter)
+    m_active_bat = 0;
   else
-    card.m_active_bat = 1;
+    m_active_bat = 1;
 
-  // check for consistency between the active Dir and BAT
-  const GCMemcardErrorCode dir_bat_consistency_error_code =
-      card.GetActiveDirectory().CheckForErrorsWithBat(card.GetActiveBat());
-  error_code |= dir_bat_consistency_error_code;
-  if (error_code.HasCriticalErrors())
-    return std::make_pair(error_code, std::nullopt);
+  RebuildBlockChains();
+  m_free_block_bitmap = FreeBlockBitmap(GetActiveBat(), m_size_blocks);
+}
 
-  card.m_valid = true;
+GCMBlock& GCMemcard::DataBlock(u32 index)
+{
+  if (!m_fork_blocks.empty())
+  {
+    if (!m_fork_block_owned[index])
+    {
+      m_fork_blocks[index] = &m_forked_blocks.emplace_back(*m_fork_blocks[index]);
+      m_fork_block_owned[index] = true;
+    }
+    // the block is in m_forked_blocks now, which this card owns
+    return const_cast<GCMBlock&>(*m_fork_blocks[index]);
+  }
+  if (m_mapping.IsOpen())
+    return reinterpret_cast<GCMBlock*>(m_mapping.GetData())[MC_FST_BLOCKS + index];
+  return m_data_blocks[index];
+}
 
-  return std::make_pair(error_code, std::move(card));
+const GCMBlock& GCMemcard::DataBlock(u32 index) const
+{
+  if (!m_fork_blocks.empty())
+    return *m_fork_blocks[index];
+  if (m_mapping.IsOpen())
+    return reinterpret_cast<const GCMBlock*>(m_mapping.GetData())[MC_FST_BLOCKS + index];
+  return m_data_blocks[index];
+}
+
+GCMemcard GCMemcard::CopyWithoutDataBlocks() const
+{
+  GCMemcard card;
+  card.m_valid = m_valid;
+  card.m_filename = m_filename;
+  card.m_size_blocks = m_size_blocks;
+  card.m_size_mb = m_size_mb;
+  card.m_header_block = m_header_block;
+  card.m_directory_blocks = m_directory_blocks;
+  card.m_bat_blocks = m_bat_blocks;
+  card.m_data_blocks = GCMemcardBlockVector(m_data_blocks.get_allocator());
+  card.m_changed_data_blocks = m_changed_data_blocks;
+  card.m_source_file_tracked = m_source_file_tracked;
+  card.m_active_directory = m_active_directory;
+  card.m_active_bat = m_active_bat;
+  card.m_block_chains = m_block_chains;
+  card.m_free_block_bitmap = m_free_block_bitmap;
+  card.m_block_hashes = m_block_hashes;
+  card.m_block_hash_valid = m_block_hash_valid;
+  return card;
+}
+
+GCMemcard GCMemcard::Clone() const
+{
+  GCMemcard card = CopyWithoutDataBlocks();
+  if (m_mapping.IsOpen() || !m_fork_blocks.empty())
+  {
+    card.m_data_blocks.reserve(m_size_blocks - MC_FST_BLOCKS);
+    for (u32 i = 0; i < m_size_blocks - MC_FST_BLOCKS; ++i)
+      card.m_data_blocks.push_back(DataBlock(i));
+  }
+  else
+  {
+    card.m_data_blocks = m_data_blocks;
+  }
+  return card;
+}
+
+GCMemcard GCMemcard::Fork() const
+{
+  GCMemcard card = CopyWithoutDataBlocks();
+  card.m_fork_blocks.resize(m_size_blocks - MC_FST_BLOCKS);
+  for (u32 i = 0; i < m_size_blocks - MC_FST_BLOCKS; ++i)
+    card.m_fork_blocks[i] = &DataBlock(i);
+  card.m_fork_block_owned.assign(m_size_blocks - MC_FST_BLOCKS, false);
+
+  // writing the changed blocks into the file under this card's mapping would change its data
+  card.m_source_file_tracked = false;
+  return card;
 }
 
 const Directory& GCMemcard::GetActiveDirectory() const
@@ -292,6 +664,8 @@ void GCMemcard::UpdateDirectory(const Directory& directory)
   int new_directory_index = m_active_directory == 0 ? 1 : 0;
   m_directory_blocks[new_directory_index] = directory;
   m_active_directory = new_directory_index;
+  InvalidateBlockHash(1 + new_directory_index);
+  RebuildBlockChains();
 }
 
 void GCMemcard::UpdateBat(const BlockAlloc& bat)
@@ -300,6 +674,51 @@ void GCMemcard::UpdateBat(const BlockAlloc& bat)
   int new_bat_index = m_active_bat == 0 ? 1 : 0;
   m_bat_blocks[new_bat_index] = bat;
   m_active_bat = new_bat_index;
+  InvalidateBlockHash(3 + new_bat_index);
+  RebuildBlockChains();
+}
+
+void GCMemcard::RebuildBlockChains()
+{
+  VisitCardGeometry(m_size_mb, [this](auto geometry) {
+    const Directory& directory = GetActiveDirectory();
+    const BatView bat(GetActiveBat(), geometry);
+    for (size_t i = 0; i < DIRLEN; ++i)
+    {
+      std::vector<u16>& chain = m_block_chains[i];
+      chain.clear();
+
+      const DEntry& entry = directory.m_dir_entries[i];
+      const u16 block_count = entry.m_block_count;
+      if (entry.m_gamecode == DEntry::UNINITIALIZED_GAMECODE || block_count > geometry.SizeBlocks())
+        continue;
+
+      chain.reserve(block_count);
+      u16 current_block = entry.m_first_block;
+      for (u16 j = 0; j < block_count; ++j)
+      {
+        if (current_block < MC_FST_BLOCKS || current_block >= geometry.SizeBlocks())
+        {
+          // only complete chains are kept
+          chain.clear();
+          break;
+        }
+        chain.push_back(current_block);
+        current_block = bat.GetNextBlock(current_block);
+      }
+    }
+  });
+}
+
+const std::vector<u16>* GCMemcard::GetBlockChain(u8 index) const
+{
+  if (!m_valid || index >= DIRLEN)
+    return nullptr;
+
+  const std::vector<u16>& chain = m_block_chains[index];
+  if (chain.size() != GetActiveDirectory().m_dir_entries[index].m_block_count)
+    return nullptr;
+  return &chain;
 }
 
 bool GCMemcard::IsShiftJIS() const
@@ -312,36 +731,210 @@ bool GCMemcard::Save()
   return Save(m_filename);
 }
 
-bool GCMemcard::Save(std::string const& filename)
+bool GCMemcard::Save(std::string const& filename, const GCMemcardSaveOptions& options)
+{
+  TRACE_SPAN("GCMemcard::Save");
+  const bool is_source_file = m_source_file_tracked && filename == m_filename;
+  if (is_source_file && options.only_changed_blocks && !options.atomic &&
+      File::GetSize(filename) == static_cast<u64>(m_size_blocks) * BLOCK_SIZE)
+  {
+    if (!WriteChangedBlocks(filename))
+      return false;
+  }
+  // Truncating the file backing our mapping, or the one of the card we were forked from, would
+  // pull the pages out from under us, so saving over that file writes next to it and then moves
+  // the new file over it. Other targets, such as a fork's own output, are written directly.
+  else if (options.atomic ||
+           ((m_mapping.IsOpen() || !m_fork_blocks.empty()) && !m_filename.empty() &&
+            filename == m_filename))
+  {
+    const std::string temp_filename = File::GetTempFilenameForAtomicWrite(filename);
+    if (!WriteCard(temp_filename) || !File::RenameSync(temp_filename, filename))
+    {
+      File::Delete(temp_filename);
+      return false;
+    }
+  }
+  else if (!WriteCard(filename))
+  {
+    return false;
+  }
+
+  if (filename == m_filename)
+  {
+    m_source_file_tracked = true;
+    std::fill(m_changed_data_blocks.begin(), m_changed_data_blocks.end(), false);
+  }
+
+  return true;
+}
+
+std::array<File::WriteBuffer, MC_FST_BLOCKS> GCMemcard::GetFileSystemBuffers() const
+{
+  return {{
+      {&m_header_block, BLOCK_SIZE},
+      {&m_directory_blocks[0], BLOCK_SIZE},
+      {&m_directory_blocks[1], BLOCK_SIZE},
+      {&m_bat_blocks[0], BLOCK_SIZE},
+      {&m_bat_blocks[1], BLOCK_SIZE},
+  }};
+}
+
+bool GCMemcard::WriteCard(const std::string& filename) const
 {
   File::IOFile mcdFile(filename, "wb");
   mcdFile.Seek(0, File::SeekOrigin::Begin);
 
-  mcdFile.WriteBytes(&m_header_block, BLOCK_SIZE);
-  mcdFile.WriteBytes(&m_directory_blocks[0], BLOCK_SIZE);
-  mcdFile.WriteBytes(&m_directory_blocks[1], BLOCK_SIZE);
-  mcdFile.WriteBytes(&m_bat_blocks[0], BLOCK_SIZE);
-  mcdFile.WriteBytes(&m_bat_blocks[1], BLOCK_SIZE);
-  for (unsigned int i = 0; i < m_size_blocks - MC_FST_BLOCKS; ++i)
+  // the data blocks are contiguous in both the mapping and m_data_blocks, so unless the card is a
+  // fork the whole card goes out in a single buffer
+  const auto fst_buffers = GetFileSystemBuffers();
+  std::vector<File::WriteBuffer> buffers(fst_buffers.begin(), fst_buffers.end());
+  AppendDataBlockBuffers(0, m_size_blocks - MC_FST_BLOCKS, &buffers);
+  mcdFile.WriteGather(buffers.data(), buffers.size());
+
+  return mcdFile.Close();
+}
+
+void GCMemcard::AppendDataBlockBuffers(u32 first, u32 count,
+                                       std::vector<File::WriteBuffer>* buffers) const
+{
+  const u8* run_start = nullptr;
+  size_t run_size = 0;
+  for (u32 i = first; i < first + count; ++i)
+  {
+    const u8* block = DataBlock(i).m_block.data();
+    if (run_start && block == run_start + run_size)
+    {
+      run_size += BLOCK_SIZE;
+      continue;
+    }
+    if (run_start)
+      buffers->push_back({run_start, run_size});
+    run_start = block;
+    run_size = BLOCK_SIZE;
+  }
+  if (run_start)
+    buffers->push_back({run_start, run_size});
+}
+
+bool GCMemcard::WriteChangedBlocks(const std::string& filename) const
+{
+  File::IOFile mcdFile(filename, "r+b");
+  mcdFile.Seek(0, File::SeekOrigin::Begin);
+
+  // the filesystem blocks are small enough that tracking changes to them isn't worth it
+  const auto fst_buffers = GetFileSystemBuffers();
+  mcdFile.WriteGather(fst_buffers.data(), fst_buffers.size());
+
+  const u32 data_block_count = m_size_blocks - MC_FST_BLOCKS;
+  u32 i = 0;
+  while (i < data_block_count)
   {
-    mcdFile.WriteBytes(m_data_blocks[i].m_block.data(), m_data_blocks[i].m_block.size());
+    if (!m_changed_data_blocks[i])
+    {
+      ++i;
+      continue;
+    }
+
+    const u32 run_start = i;
+    while (i < data_block_count && m_changed_data_blocks[i])
+      ++i;
+
+    std::vector<File::WriteBuffer> buffers;
+    AppendDataBlockBuffers(run_start, i - run_start, &buffers);
+    mcdFile.Seek(static_cast<s64>(MC_FST_BLOCKS + run_start) * BLOCK_SIZE,
+                 File::SeekOrigin::Begin);
+    mcdFile.WriteGather(buffers.data(), buffers.size());
   }
 
   return mcdFile.Close();
 }
 
+void GCMemcard::SetDataBlock(u32 index, const GCMBlock& block)
+{
+  DataBlock(index) = block;
+  m_changed_data_blocks[index] = true;
+  InvalidateBlockHash(MC_FST_BLOCKS + index);
+}
+
+void GCMemcard::InvalidateBlockHash(u32 block_index)
+{
+  if (block_index < m_block_hash_valid.size())
+    m_block_hash_valid[block_index] = false;
+}
+
+void GCMemcard::InvalidateFileSystemBlockHashes()
+{
+  for (u32 i = 0; i < MC_FST_BLOCKS; ++i)
+    InvalidateBlockHash(i);
+}
+
+const std::vector<u64>& GCMemcard::GetBlockHashes() const
+{
+  if (m_block_hashes.size() != m_size_blocks)
+  {
+    m_block_hashes.assign(m_size_blocks, 0);
+    m_block_hash_valid.assign(m_size_blocks, false);
+  }
+
+  for (u32 i = 0; i < m_size_blocks; ++i)
+  {
+    if (m_block_hash_valid[i])
+      continue;
+    m_block_hashes[i] = Common::HashXXH64(GetRawBlock(i), BLOCK_SIZE);
+    m_block_hash_valid[i] = true;
+  }
+
+  return m_block_hashes;
+}
+
 static std::pair<u16, u16> CalculateMemcardChecksums(const u8* data, size_t size)
 {
   ASSERT(size % 2 == 0);
-  u16 csum = 0;
-  u16 inv_csum = 0;
 
-  for (size_t i = 0; i < size; i += 2)
+  // The checksum is the sum of all big-endian u16 words, which is the same as 256 times the sum of
+  // the high bytes plus the sum of the low bytes. That lets us sum bytes in wide lanes and never
+  // swap anything. The inverse checksum sums 0xffff - word, which is -(word count + checksum).
+  u64 high_sum = 0;
+  u64 low_sum = 0;
+  size_t i = 0;
+
+#if defined(_M_X86_64)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i low_byte_mask = _mm_set1_epi16(0x00ff);
+  __m128i high_acc = zero;
+  __m128i low_acc = zero;
+  for (; i + 16 <= size; i += 16)
+  {
+    const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[i]));
+    // in memory order the high byte of each big-endian word comes first
+    high_acc = _mm_add_epi64(high_acc, _mm_sad_epu8(_mm_and_si128(words, low_byte_mask), zero));
+    low_acc = _mm_add_epi64(low_acc, _mm_sad_epu8(_mm_srli_epi16(words, 8), zero));
+  }
+  high_sum =
+      _mm_cvtsi128_si64(high_acc) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(high_acc, high_acc));
+  low_sum = _mm_cvtsi128_si64(low_acc) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(low_acc, low_acc));
+#elif defined(_M_ARM_64)
+  uint32x4_t high_acc = vdupq_n_u32(0);
+  uint32x4_t low_acc = vdupq_n_u32(0);
+  for (; i + 32 <= size; i += 32)
   {
-    u16 d = Common::swap16(&data[i]);
-    csum += d;
-    inv_csum += static_cast<u16>(d ^ 0xffff);
+    const uint8x16x2_t bytes = vld2q_u8(&data[i]);
+    high_acc = vpadalq_u16(high_acc, vpaddlq_u8(bytes.val[0]));
+    low_acc = vpadalq_u16(low_acc, vpaddlq_u8(bytes.val[1]));
   }
+  high_sum = vaddvq_u32(high_acc);
+  low_sum = vaddvq_u32(low_acc);
+#endif
+
+  for (; i < size; i += 2)
+  {
+    high_sum += data[i];
+    low_sum += data[i + 1];
+  }
+
+  u16 csum = static_cast<u16>((high_sum << 8) + low_sum);
+  u16 inv_csum = static_cast<u16>(0 - size / 2 - csum);
 
   csum = Common::swap16(csum);
   inv_csum = Common::swap16(inv_csum);
@@ -351,7 +944,124 @@ static std::pair<u16, u16> CalculateMemcardChecksums(const u8* data, size_t size
   if (inv_csum == 0xffff)
     inv_csum = 0;
 
-  return std::make_pair(csum, inv_csum);
+  return std::make_pair(csum, inv_csum);
+}
+
+u16 CountNonzeroBatEntries(const BlockAlloc& bat, u16 begin, u16 end)
+{
+  // the byte order doesn't matter for telling zero from nonzero, so the words are never swapped
+  const u16* map = reinterpret_cast<const u16*>(bat.m_map.data());
+  u32 zero_count = 0;
+  u16 i = begin;
+
+#if defined(_M_X86_64)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 8 <= end; i += 8)
+  {
+    const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&map[i]));
+    // two mask bits per zero word
+    zero_count += Common::CountSetBits(static_cast<u32>(
+                      _mm_movemask_epi8(_mm_cmpeq_epi16(words, zero)))) /
+                  2;
+  }
+#elif defined(_M_ARM_64)
+  uint16x8_t nonzero_acc = vdupq_n_u16(0);
+  for (; i + 8 <= end; i += 8)
+  {
+    const uint16x8_t words = vld1q_u16(&map[i]);
+    // the test yields all ones, which is -1, for each nonzero word
+    nonzero_acc = vsubq_u16(nonzero_acc, vtstq_u16(words, words));
+  }
+  zero_count = (i - begin) - vaddvq_u16(nonzero_acc);
+#endif
+
+  for (; i < end; ++i)
+    zero_count += map[i] == 0;
+
+  return static_cast<u16>((end - begin) - zero_count);
+}
+
+bool AreBatLinksInRange(const BlockAlloc& bat, u16 begin, u16 end, u32 size_blocks)
+{
+  const u16* map = reinterpret_cast<const u16*>(bat.m_map.data());
+  u16 i = begin;
+
+#if defined(_M_X86_64)
+  // SSE2 only compares signed words, and flipping the sign bit turns that into an unsigned compare
+  const __m128i sign = _mm_set1_epi16(static_cast<s16>(0x8000));
+  const __m128i first_block = _mm_set1_epi16(MC_FST_BLOCKS);
+  const __m128i block_range = _mm_xor_si128(_mm_set1_epi16(size_blocks - MC_FST_BLOCKS), sign);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i last = _mm_set1_epi16(-1);
+  for (; i + 8 <= end; i += 8)
+  {
+    __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&map[i]));
+    words = _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+    const __m128i in_range = _mm_cmplt_epi16(
+        _mm_xor_si128(_mm_sub_epi16(words, first_block), sign), block_range);
+    const __m128i valid = _mm_or_si128(
+        in_range, _mm_or_si128(_mm_cmpeq_epi16(words, zero), _mm_cmpeq_epi16(words, last)));
+    if (_mm_movemask_epi8(valid) != 0xFFFF)
+      return false;
+  }
+#elif defined(_M_ARM_64)
+  const uint16x8_t first_block = vdupq_n_u16(MC_FST_BLOCKS);
+  const uint16x8_t block_range = vdupq_n_u16(size_blocks - MC_FST_BLOCKS);
+  const uint16x8_t last = vdupq_n_u16(0xFFFF);
+  for (; i + 8 <= end; i += 8)
+  {
+    const uint16x8_t words = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(
+        reinterpret_cast<const u8*>(&map[i]))));
+    const uint16x8_t valid =
+        vorrq_u16(vcltq_u16(vsubq_u16(words, first_block), block_range),
+                  vorrq_u16(vceqzq_u16(words), vceqq_u16(words, last)));
+    if (vminvq_u16(valid) == 0)
+      return false;
+  }
+#endif
+
+  for (; i < end; ++i)
+  {
+    const u16 link = bat.m_map[i];
+    if (link != 0 && link != 0xFFFF && (link < MC_FST_BLOCKS || link >= size_blocks))
+      return false;
+  }
+  return true;
+}
+
+// The checksum is a plain sum of words, so overwriting some of them only moves it by the difference
+// between the old and the new words. Returns false if the stored checksums don't pin down the
+// current sum, in which case the caller has to recalculate them from scratch.
+static bool ReplaceMemcardChecksummedData(u8* field, const u8* data, size_t size,
+                                          size_t checksum_area_size, u16& checksum,
+                                          u16& checksum_inv)
+{
+  ASSERT(size % 2 == 0);
+  const u16 word_count = static_cast<u16>(checksum_area_size / 2);
+
+  // a sum of 0xffff is stored as 0, so a stored 0 could mean either
+  u16 csum = Common::swap16(checksum);
+  const u16 expected_inv_csum = static_cast<u16>(0 - word_count - csum);
+  const bool checksums_known =
+      csum != 0 &&
+      Common::swap16(checksum_inv) == (expected_inv_csum == 0xffff ? 0 : expected_inv_csum);
+
+  for (size_t i = 0; i < size; i += 2)
+    csum += Common::swap16(&data[i]) - Common::swap16(&field[i]);
+  std::memcpy(field, data, size);
+
+  if (!checksums_known)
+    return false;
+
+  u16 inv_csum = static_cast<u16>(0 - word_count - csum);
+  if (csum == 0xffff)
+    csum = 0;
+  if (inv_csum == 0xffff)
+    inv_csum = 0;
+
+  checksum = Common::swap16(csum);
+  checksum_inv = Common::swap16(inv_csum);
+  return true;
 }
 
 bool GCMemcard::FixChecksums()
@@ -360,6 +1070,7 @@ bool GCMemcard::FixChecksums()
     return false;
 
   m_header_block.FixChecksums();
+  InvalidateFileSystemBlockHashes();
   m_directory_blocks[0].FixChecksums();
   m_directory_blocks[1].FixChecksums();
   m_bat_blocks[0].FixChecksums();
@@ -368,6 +1079,34 @@ bool GCMemcard::FixChecksums()
   return true;
 }
 
+bool GCMemcard::ChecksumsAreCurrent() const
+{
+  const auto matches = [](const auto& block) {
+    return block.CalculateChecksums() == std::make_pair(block.m_checksum, block.m_checksum_inv);
+  };
+  return matches(m_header_block) && matches(m_directory_blocks[0]) &&
+         matches(m_directory_blocks[1]) && matches(m_bat_blocks[0]) && matches(m_bat_blocks[1]);
+}
+
+const u8* GCMemcard::GetRawBlock(u32 block_index) const
+{
+  switch (block_index)
+  {
+  case 0:
+    return reinterpret_cast<const u8*>(&m_header_block);
+  case 1:
+  case 2:
+    return reinterpret_cast<const u8*>(&m_directory_blocks[block_index - 1]);
+  case 3:
+  case 4:
+    return reinterpret_cast<const u8*>(&m_bat_blocks[block_index - 3]);
+  default:
+    if (block_index >= m_size_blocks)
+      return nullptr;
+    return DataBlock(block_index - MC_FST_BLOCKS).m_block.data();
+  }
+}
+
 u8 GCMemcard::GetNumFiles() const
 {
   if (!m_valid)
@@ -576,63 +1315,84 @@ u16 GCMemcard::DEntry_BlockCount(u8 index) const
   return blocks;
 }
 
-std::optional<std::vector<u8>> GCMemcard::GetSaveDataBytes(u8 save_index, size_t offset,
-                                                           size_t length) const
+size_t GCMemcardSaveView::GetSegmentCount() const
 {
-  if (!m_valid || save_index >= DIRLEN)
-    return std::nullopt;
+  if (m_size == 0)
+    return 0;
+  return (m_offset + m_size - 1) / BLOCK_SIZE - m_offset / BLOCK_SIZE + 1;
+}
 
-  const DEntry& entry = GetActiveDirectory().m_dir_entries[save_index];
-  const BlockAlloc& bat = GetActiveBat();
-  const u16 block_count = entry.m_block_count;
-  const u16 first_block = entry.m_first_block;
-  const size_t block_max = MC_FST_BLOCKS + m_data_blocks.size();
-  if (block_count == 0xFFFF || first_block < MC_FST_BLOCKS || first_block >= block_max)
-    return std::nullopt;
+GCMemcardSaveView::Segment GCMemcardSaveView::GetSegment(size_t index) const
+{
+  // only the first segment can start in the middle of a block, only the last one can end early
+  const size_t first_block = m_offset / BLOCK_SIZE;
+  const size_t segment_start = index == 0 ? m_offset : (first_block + index) * BLOCK_SIZE;
+  const size_t segment_end =
+      std::min((segment_start / BLOCK_SIZE + 1) * BLOCK_SIZE, m_offset + m_size);
+  const GCMBlock& block = Block(segment_start / BLOCK_SIZE);
+  return {block.m_block.data() + segment_start % BLOCK_SIZE, segment_end - segment_start};
+}
 
-  const u32 file_size = block_count * BLOCK_SIZE;
-  if (offset >= file_size)
-    return std::nullopt;
+const u8* GCMemcardSaveView::GetContiguous(size_t position, size_t count) const
+{
+  if (position > m_size || count > m_size - position)
+    return nullptr;
 
-  const size_t bytes_to_copy = std::min(length, file_size - offset);
-  std::vector<u8> result;
-  result.reserve(bytes_to_copy);
+  const size_t save_offset = m_offset + position;
+  if (count > 0 && save_offset / BLOCK_SIZE != (save_offset + count - 1) / BLOCK_SIZE)
+    return nullptr;
+  return &(*this)[position];
+}
 
-  u16 current_block = first_block;
-  size_t offset_in_current_block = offset;
-  size_t bytes_remaining = bytes_to_copy;
+bool GCMemcardSaveView::CopyTo(size_t position, size_t count, u8* destination) const
+{
+  if (position > m_size || count > m_size - position)
+    return false;
 
-  // skip unnecessary blocks at start
-  while (offset_in_current_block >= BLOCK_SIZE)
+  size_t save_offset = m_offset + position;
+  while (count > 0)
   {
-    offset_in_current_block -= BLOCK_SIZE;
-    current_block = bat.GetNextBlock(current_block);
-    if (current_block < MC_FST_BLOCKS || current_block >= block_max)
-      return std::nullopt;
+    const size_t offset_in_block = save_offset % BLOCK_SIZE;
+    const size_t bytes_to_copy = std::min(count, BLOCK_SIZE - offset_in_block);
+    const GCMBlock& block = Block(save_offset / BLOCK_SIZE);
+    std::memcpy(destination, block.m_block.data() + offset_in_block, bytes_to_copy);
+
+    destination += bytes_to_copy;
+    save_offset += bytes_to_copy;
+    count -= bytes_to_copy;
   }
+  return true;
+}
 
-  // then copy one block at a time into the result vector
-  while (true)
-  {
-    const GCMBlock& block = m_data_blocks[current_block - MC_FST_BLOCKS];
-    const size_t bytes_in_current_block_left = BLOCK_SIZE - offset_in_current_block;
-    const size_t bytes_in_current_block_left_to_copy =
-        std::min(bytes_remaining, bytes_in_current_block_left);
+std::optional<GCMemcardSaveView> GCMemcard::GetSaveDataView(u8 save_index, size_t offset,
+                                                            size_t length) const
+{
+  if (!m_valid || save_index >= DIRLEN)
+    return std::nullopt;
 
-    const auto data_to_copy_begin = block.m_block.begin() + offset_in_current_block;
-    const auto data_to_copy_end = data_to_copy_begin + bytes_in_current_block_left_to_copy;
-    result.insert(result.end(), data_to_copy_begin, data_to_copy_end);
+  const std::vector<u16>* chain = GetBlockChain(save_index);
+  if (!chain || chain->empty())
+    return std::nullopt;
 
-    bytes_remaining -= bytes_in_current_block_left_to_copy;
-    if (bytes_remaining == 0)
-      break;
+  const size_t file_size = chain->size() * BLOCK_SIZE;
+  if (offset >= file_size)
+    return std::nullopt;
 
-    offset_in_current_block = 0;
-    current_block = bat.GetNextBlock(current_block);
-    if (current_block < MC_FST_BLOCKS || current_block >= block_max)
-      return std::nullopt;
-  }
+  const bool forked = !m_fork_blocks.empty();
+  return GCMemcardSaveView(forked ? nullptr : &DataBlock(0),
+                           forked ? m_fork_blocks.data() : nullptr, chain->data(), offset,
+                           std::min(length, file_size - offset));
+}
+
+std::optional<std::vector<u8>> GCMemcard::GetSaveDataBytes(u8 save_index, size_t offset,
+                                                           size_t length) const
+{
+  const std::optional<GCMemcardSaveView> view = GetSaveDataView(save_index, offset, length);
+  if (!view)
+    return std::nullopt;
 
+  std::vector<u8> result(view->size());
+  view->CopyTo(0, view->size(), result.data());
   return std::make_optional(std::move(result));
 }
 
@@ -645,8 +1405,9 @@ std::optional<std::pair<std::string, std::string>> GCMemcard::GetSaveComments(u8
   if (address == 0xFFFFFFFF)
     return std::nullopt;
 
-  const auto data = GetSaveDataBytes(index, address, DENTRY_STRLEN * 2);
-  if (!data || data->size() != DENTRY_STRLEN * 2)
+  const auto view = GetSaveDataView(index, address, DENTRY_STRLEN * 2);
+  std::array<u8, DENTRY_STRLEN * 2> data;
+  if (!view || !view->CopyTo(0, data.size(), data.data()))
     return std::nullopt;
 
   const auto string_decoder = IsShiftJIS() ? SHIFTJISToUTF8 : CP1252ToUTF8;
@@ -657,7 +1418,7 @@ std::optional<std::pair<std::string, std::string>> GCMemcard::GetSaveComments(u8
     return s.substr(0, offset);
   };
 
-  const u8* address_1 = data->data();
+  const u8* address_1 = data.data();
   const u8* address_2 = address_1 + DENTRY_STRLEN;
   const std::string encoded_1(reinterpret_cast<const char*>(address_1), DENTRY_STRLEN);
   const std::string encoded_2(reinterpret_cast<const char*>(address_2), DENTRY_STRLEN);
@@ -725,14 +1486,95 @@ bool BlockAlloc::ClearBlocks(u16 starting_block, u16 block_count)
       return false;
     }
     for (unsigned int i = 0; i < length; ++i)
-      m_map[blocks.at(i) - MC_FST_BLOCKS] = 0;
-    m_free_blocks = m_free_blocks + block_count;
+      SetNextBlock(blocks.at(i), 0);
+    SetFreeBlocks(m_free_blocks + block_count);
 
     return true;
   }
   return false;
 }
 
+FreeBlockBitmap::FreeBlockBitmap()
+{
+  m_free.fill(0);
+}
+
+FreeBlockBitmap::FreeBlockBitmap(const BlockAlloc& bat, u16 size_blocks) : FreeBlockBitmap()
+{
+  const u16 max_block = std::min<u16>(size_blocks, MC_FST_BLOCKS + BAT_SIZE);
+  for (u16 block = MC_FST_BLOCKS; block < max_block; ++block)
+  {
+    if (bat.m_map[block - MC_FST_BLOCKS] == 0)
+      MarkFree(block);
+  }
+}
+
+void FreeBlockBitmap::MarkUsed(u16 block)
+{
+  m_free[block / 64] &= ~(u64(1) << (block % 64));
+}
+
+void FreeBlockBitmap::MarkFree(u16 block)
+{
+  m_free[block / 64] |= u64(1) << (block % 64);
+}
+
+u16 FreeBlockBitmap::FindBlock(bool free, u16 begin, u16 end) const
+{
+  for (u16 word_index = begin / 64; word_index * 64 < end; ++word_index)
+  {
+    u64 word = free ? m_free[word_index] : ~m_free[word_index];
+    // ignore the bits before begin in the first word
+    if (word_index == begin / 64)
+      word &= ~u64(0) << (begin % 64);
+    if (word != 0)
+      return std::min<u16>(word_index * 64 + Common::LeastSignificantSetBit(word), end);
+  }
+  return end;
+}
+
+u16 FreeBlockBitmap::NextFreeBlock(u16 max_block, u16 starting_block) const
+{
+  starting_block = std::clamp<u16>(starting_block, MC_FST_BLOCKS, BAT_SIZE + MC_FST_BLOCKS);
+  max_block = std::clamp<u16>(max_block, MC_FST_BLOCKS, BAT_SIZE + MC_FST_BLOCKS);
+
+  u16 block = FindBlock(true, starting_block, max_block);
+  if (block < max_block)
+    return block;
+
+  const u16 wrap_end = std::min(starting_block, max_block);
+  block = FindBlock(true, MC_FST_BLOCKS, wrap_end);
+  if (block < wrap_end)
+    return block;
+
+  return 0xFFFF;
+}
+
+u16 FreeBlockBitmap::NextFreeRun(u16 length, u16 max_block, u16 starting_block) const
+{
+  starting_block = std::clamp<u16>(starting_block, MC_FST_BLOCKS, BAT_SIZE + MC_FST_BLOCKS);
+  max_block = std::clamp<u16>(max_block, MC_FST_BLOCKS, BAT_SIZE + MC_FST_BLOCKS);
+
+  const auto find_run = [this, length](u16 begin, u16 end) -> u16 {
+    while (begin < end)
+    {
+      const u16 run_start = FindBlock(true, begin, end);
+      if (run_start == end)
+        break;
+      const u16 run_end = FindBlock(false, run_start, end);
+      if (run_end - run_start >= length)
+        return run_start;
+      begin = run_end;
+    }
+    return 0xFFFF;
+  };
+
+  const u16 block = find_run(starting_block, max_block);
+  if (block != 0xFFFF)
+    return block;
+  return find_run(MC_FST_BLOCKS, std::min(starting_block, max_block));
+}
+
 void BlockAlloc::FixChecksums()
 {
   std::tie(m_checksum, m_checksum_inv) = CalculateChecksums();
@@ -746,22 +1588,54 @@ u16 BlockAlloc::AssignBlocksContiguous(u16 length)
   u16 current = starting;
   while ((current - starting + 1) < length)
   {
-    m_map[current - 5] = current + 1;
+    SetNextBlock(current, current + 1);
     current++;
   }
-  m_map[current - 5] = 0xFFFF;
-  m_last_allocated_block = current;
-  m_free_blocks = m_free_blocks - length;
-  FixChecksums();
+  SetNextBlock(current, 0xFFFF);
+  SetLastAllocatedBlock(current);
+  SetFreeBlocks(m_free_blocks - length);
   return starting;
 }
 
+void BlockAlloc::SetNextBlock(u16 block, u16 next_block)
+{
+  const Common::BigEndianValue<u16> value(next_block);
+  ReplaceChecksummedData(&m_map[block - MC_FST_BLOCKS], &value, sizeof(value));
+}
+
+void BlockAlloc::SetFreeBlocks(u16 free_blocks)
+{
+  const Common::BigEndianValue<u16> value(free_blocks);
+  ReplaceChecksummedData(&m_free_blocks, &value, sizeof(value));
+}
+
+void BlockAlloc::SetLastAllocatedBlock(u16 block)
+{
+  const Common::BigEndianValue<u16> value(block);
+  ReplaceChecksummedData(&m_last_allocated_block, &value, sizeof(value));
+}
+
+void BlockAlloc::IncrementUpdateCounter()
+{
+  const Common::BigEndianValue<s16> value(static_cast<s16>(m_update_counter + 1));
+  ReplaceChecksummedData(&m_update_counter, &value, sizeof(value));
+}
+
+void BlockAlloc::ReplaceChecksummedData(void* field, const void* data, size_t size)
+{
+  constexpr size_t checksum_area_size = sizeof(BlockAlloc) - offsetof(BlockAlloc, m_update_counter);
+  if (!ReplaceMemcardChecksummedData(static_cast<u8*>(field), static_cast<const u8*>(data), size,
+                                     checksum_area_size, m_checksum, m_checksum_inv))
+  {
+    FixChecksums();
+  }
+}
+
 std::pair<u16, u16> BlockAlloc::CalculateChecksums() const
 {
   static_assert(std::is_trivially_copyable<BlockAlloc>());
 
-  std::array<u8, sizeof(BlockAlloc)> raw;
-  memcpy(raw.data(), this, raw.size());
+  const u8* raw = reinterpret_cast<const u8*>(this);
 
   constexpr size_t checksum_area_start = offsetof(BlockAlloc, m_update_counter);
   constexpr size_t checksum_area_end = sizeof(BlockAlloc);
@@ -780,29 +1654,18 @@ GCMemcardErrorCode BlockAlloc::CheckForErrors(u16 size_mbits) const
 
   if (size_mbits > 0 && size_mbits <= 256)
   {
-    // check if free block count matches the actual amount of free blocks in m_map
-    const u16 total_available_blocks = (size_mbits * MBIT_TO_BLOCKS) - MC_FST_BLOCKS;
-    ASSERT(total_available_blocks <= m_map.size());
-    u16 blocks_in_use = 0;
-    for (size_t i = 0; i < total_available_blocks; ++i)
-    {
-      if (m_map[i] != 0)
-        ++blocks_in_use;
-    }
-    const u16 free_blocks = total_available_blocks - blocks_in_use;
+    VisitCardGeometry(size_mbits, [&](auto geometry) {
+      const BatView bat(*this, geometry);
 
-    if (free_blocks != m_free_blocks)
-      error_code.Set(GCMemcardValidityIssues::FREE_BLOCK_MISMATCH);
+      // check if free block count matches the actual amount of free blocks in m_map
+      const u16 free_blocks = geometry.DataBlocks() - bat.CountBlocksInUse();
+      if (free_blocks != m_free_blocks)
+        error_code.Set(GCMemcardValidityIssues::FREE_BLOCK_MISMATCH);
 
-    // remaining blocks map to nothing on hardware and must be empty
-    for (size_t i = total_available_blocks; i < m_map.size(); ++i)
-    {
-      if (m_map[i] != 0)
-      {
+      // remaining blocks map to nothing on hardware and must be empty
+      if (bat.HasDataInUnusedArea())
         error_code.Set(GCMemcardValidityIssues::DATA_IN_UNUSED_AREA);
-        break;
-      }
-    }
+    });
   }
   else
   {
@@ -826,24 +1689,64 @@ GCMemcardGetSaveDataRetVal GCMemcard::GetSaveData(u8 index, std::vector<GCMBlock
     return GCMemcardGetSaveDataRetVal::FAIL;
   }
 
-  u16 nextBlock = block;
-  for (int i = 0; i < BlockCount; ++i)
+  const std::vector<u16>* chain = GetBlockChain(index);
+  if (!chain)
+    return GCMemcardGetSaveDataRetVal::FAIL;
+
+  Blocks.reserve(Blocks.size() + BlockCount);
+  for (const u16 chain_block : *chain)
+    Blocks.push_back(DataBlock(chain_block - MC_FST_BLOCKS));
+  return GCMemcardGetSaveDataRetVal::SUCCESS;
+}
+
+GCMemcardGetSaveDataRetVal GCMemcard::GetSaveData(u8 index, GCMBlock* save_blocks,
+                                                  size_t block_count) const
+{
+  if (!m_valid)
+    return GCMemcardGetSaveDataRetVal::NOMEMCARD;
+
+  const u16 block = DEntry_FirstBlock(index);
+  const u16 BlockCount = DEntry_BlockCount(index);
+
+  if ((block == 0xFFFF) || (BlockCount == 0xFFFF) || BlockCount != block_count)
   {
-    if ((!nextBlock) || (nextBlock == 0xFFFF))
-      return GCMemcardGetSaveDataRetVal::FAIL;
-    Blocks.push_back(m_data_blocks[nextBlock - MC_FST_BLOCKS]);
-    nextBlock = GetActiveBat().GetNextBlock(nextBlock);
+    return GCMemcardGetSaveDataRetVal::FAIL;
   }
+
+  const std::vector<u16>* chain = GetBlockChain(index);
+  if (!chain)
+    return GCMemcardGetSaveDataRetVal::FAIL;
+
+  for (size_t i = 0; i < chain->size(); ++i)
+    save_blocks[i] = DataBlock((*chain)[i] - MC_FST_BLOCKS);
   return GCMemcardGetSaveDataRetVal::SUCCESS;
 }
 
 GCMemcardImportFileRetVal GCMemcard::ImportFile(const Savefile& savefile)
+{
+  const GCMemcardImportFileRetVal result = CanImportFile(savefile.dir_entry);
+  if (result != GCMemcardImportFileRetVal::SUCCESS)
+    return result;
+
+  // the per-game fixups modify the blocks, so work on a copy
+  std::vector<GCMBlock> blocks = savefile.blocks;
+  return ImportFileBlocks(savefile.dir_entry, blocks);
+}
+
+GCMemcardImportFileRetVal GCMemcard::ImportFile(Savefile&& savefile)
+{
+  const GCMemcardImportFileRetVal result = CanImportFile(savefile.dir_entry);
+  if (result != GCMemcardImportFileRetVal::SUCCESS)
+    return result;
+
+  return ImportFileBlocks(savefile.dir_entry, savefile.blocks);
+}
+
+GCMemcardImportFileRetVal GCMemcard::CanImportFile(const DEntry& direntry) const
 {
   if (!m_valid)
     return GCMemcardImportFileRetVal::NOMEMCARD;
 
-  const DEntry& direntry = savefile.dir_entry;
-
   if (GetNumFiles() >= DIRLEN)
   {
     return GCMemcardImportFileRetVal::OUTOFDIRENTRIES;
@@ -857,9 +1760,19 @@ GCMemcardImportFileRetVal GCMemcard::ImportFile(const Savefile& savefile)
     return GCMemcardImportFileRetVal::TITLEPRESENT;
   }
 
-  // find first free data block
+  return GCMemcardImportFileRetVal::SUCCESS;
+}
+
+GCMemcardImportFileRetVal GCMemcard::ImportFileBlocks(const DEntry& direntry,
+                                                      std::vector<GCMBlock>& blocks)
+{
+  // Files are read back front to back, so keep them in one piece if there's room anywhere.
+  // Otherwise start at the first free data block.
+  const u16 search_start = GetActiveBat().m_last_allocated_block;
   u16 firstBlock =
-      GetActiveBat().NextFreeBlock(m_size_blocks, GetActiveBat().m_last_allocated_block);
+      m_free_block_bitmap.NextFreeRun(direntry.m_block_count, m_size_blocks, search_start);
+  if (firstBlock == 0xFFFF)
+    firstBlock = m_free_block_bitmap.NextFreeBlock(m_size_blocks, search_start);
   if (firstBlock == 0xFFFF)
     return GCMemcardImportFileRetVal::OUTOFBLOCKS;
   Directory UpdatedDir = GetActiveDirectory();
@@ -869,20 +1782,19 @@ GCMemcardImportFileRetVal GCMemcard::ImportFile(const Savefile& savefile)
   {
     if (UpdatedDir.m_dir_entries[i].m_gamecode == DEntry::UNINITIALIZED_GAMECODE)
     {
-      UpdatedDir.m_dir_entries[i] = direntry;
-      UpdatedDir.m_dir_entries[i].m_first_block = firstBlock;
-      UpdatedDir.m_dir_entries[i].m_copy_counter = UpdatedDir.m_dir_entries[i].m_copy_counter + 1;
+      DEntry entry = direntry;
+      entry.m_first_block = firstBlock;
+      entry.m_copy_counter = entry.m_copy_counter + 1;
+      UpdatedDir.Replace(entry, i);
       break;
     }
   }
-  UpdatedDir.m_update_counter = UpdatedDir.m_update_counter + 1;
+  UpdatedDir.IncrementUpdateCounter();
   UpdateDirectory(UpdatedDir);
 
   int fileBlocks = direntry.m_block_count;
 
-  std::vector<GCMBlock> blocks = savefile.blocks;
-  FZEROGX_MakeSaveGameValid(m_header_block, direntry, blocks);
-  PSO_MakeSaveGameValid(m_header_block, direntry, blocks);
+  ApplySaveFixups(m_header_block, direntry, blocks);
 
   BlockAlloc UpdatedBat = GetActiveBat();
   u16 nextBlock;
@@ -891,21 +1803,25 @@ GCMemcardImportFileRetVal GCMemcard::ImportFile(const Savefile& savefile)
   {
     if (firstBlock == 0xFFFF)
       PanicAlertFmt("Fatal Error");
-    m_data_blocks[firstBlock - MC_FST_BLOCKS] = blocks[i];
+    SetDataBlock(firstBlock - MC_FST_BLOCKS, blocks[i]);
+    m_free_block_bitmap.MarkUsed(firstBlock);
     if (i == fileBlocks - 1)
       nextBlock = 0xFFFF;
     else
-      nextBlock = UpdatedBat.NextFreeBlock(m_size_blocks, firstBlock + 1);
-    UpdatedBat.m_map[firstBlock - MC_FST_BLOCKS] = nextBlock;
-    UpdatedBat.m_last_allocated_block = firstBlock;
+      nextBlock = m_free_block_bitmap.NextFreeBlock(m_size_blocks, firstBlock + 1);
+    UpdatedBat.SetNextBlock(firstBlock, nextBlock);
+    UpdatedBat.SetLastAllocatedBlock(firstBlock);
     firstBlock = nextBlock;
   }
 
-  UpdatedBat.m_free_blocks = UpdatedBat.m_free_blocks - fileBlocks;
-  UpdatedBat.m_update_counter = UpdatedBat.m_update_counter + 1;
+  UpdatedBat.SetFreeBlocks(UpdatedBat.m_free_blocks - fileBlocks);
+  UpdatedBat.IncrementUpdateCounter();
   UpdateBat(UpdatedBat);
 
-  FixChecksums();
+  // the edits above keep the checksums up to date, unless they were stale to begin with, which
+  // cards opened without validation can be
+  if (!ChecksumsAreCurrent())
+    FixChecksums();
 
   return GCMemcardImportFileRetVal::SUCCESS;
 }
@@ -926,6 +1842,33 @@ std::optional<Savefile> GCMemcard::ExportFile(u8 index) const
   return savefile;
 }
 
+GCMemcardOverwriteFileRetVal GCMemcard::OverwriteFileData(u8 index,
+                                                          const std::vector<GCMBlock>& blocks)
+{
+  if (!m_valid)
+    return GCMemcardOverwriteFileRetVal::NOMEMCARD;
+  if (index >= DIRLEN ||
+      GetActiveDirectory().m_dir_entries[index].m_gamecode == DEntry::UNINITIALIZED_GAMECODE)
+    return GCMemcardOverwriteFileRetVal::NOFILE;
+
+  const u16 first_block = DEntry_FirstBlock(index);
+  const u16 block_count = DEntry_BlockCount(index);
+  if (first_block == 0xFFFF || block_count == 0xFFFF)
+    return GCMemcardOverwriteFileRetVal::NOFILE;
+  if (blocks.size() != block_count)
+    return GCMemcardOverwriteFileRetVal::SIZEMISMATCH;
+
+  // the chain is only cached if it's intact, so a broken BAT leaves the card untouched
+  const std::vector<u16>* chain = GetBlockChain(index);
+  if (!chain)
+    return GCMemcardOverwriteFileRetVal::CHAINBROKEN;
+
+  for (size_t i = 0; i < blocks.size(); ++i)
+    SetDataBlock((*chain)[i] - MC_FST_BLOCKS, blocks[i]);
+
+  return GCMemcardOverwriteFileRetVal::SUCCESS;
+}
+
 GCMemcardRemoveFileRetVal GCMemcard::RemoveFile(u8 index)  // index in the directory array
 {
   if (!m_valid)
@@ -936,78 +1879,181 @@ GCMemcardRemoveFileRetVal GCMemcard::RemoveFile(u8 index)  // index in the direc
   u16 startingblock = GetActiveDirectory().m_dir_entries[index].m_first_block;
   u16 numberofblocks = GetActiveDirectory().m_dir_entries[index].m_block_count;
 
+  // the cached chain is gone once the BAT changes
+  const std::vector<u16> freed_blocks = m_block_chains[index];
+
   BlockAlloc UpdatedBat = GetActiveBat();
   if (!UpdatedBat.ClearBlocks(startingblock, numberofblocks))
     return GCMemcardRemoveFileRetVal::DELETE_FAIL;
-  UpdatedBat.m_update_counter = UpdatedBat.m_update_counter + 1;
+  UpdatedBat.IncrementUpdateCounter();
   UpdateBat(UpdatedBat);
 
+  if (freed_blocks.size() == numberofblocks)
+  {
+    for (const u16 block : freed_blocks)
+      m_free_block_bitmap.MarkFree(block);
+  }
+  else
+  {
+    m_free_block_bitmap = FreeBlockBitmap(GetActiveBat(), m_size_blocks);
+  }
+
   Directory UpdatedDir = GetActiveDirectory();
 
   // TODO: Deleting a file via the GC BIOS sometimes leaves behind an extra updated directory block
   // here that has an empty file with the filename "Broken File000" where the actual deleted file
   // was. Determine when exactly this happens and if this is neccessary for anything.
 
-  memset(reinterpret_cast<u8*>(&UpdatedDir.m_dir_entries[index]), 0xFF, DENTRY_SIZE);
-  UpdatedDir.m_update_counter = UpdatedDir.m_update_counter + 1;
+  UpdatedDir.Replace(DEntry(), index);
+  UpdatedDir.IncrementUpdateCounter();
   UpdateDirectory(UpdatedDir);
 
-  FixChecksums();
+  // the edits above keep the checksums up to date, unless they were stale to begin with, which
+  // cards opened without validation can be
+  if (!ChecksumsAreCurrent())
+    FixChecksums();
 
   return GCMemcardRemoveFileRetVal::SUCCESS;
 }
 
-std::optional<std::vector<u32>> GCMemcard::ReadBannerRGBA8(u8 index) const
+GCMemcardDefragmentRetVal GCMemcard::Defragment()
+{
+  if (!m_valid)
+    return GCMemcardDefragmentRetVal::NOMEMCARD;
+
+  Directory updated_dir = GetActiveDirectory();
+  BlockAlloc updated_bat = GetActiveBat();
+  for (auto& next_block : updated_bat.m_map)
+    next_block = 0;
+
+  // Everything that moves is copied out first, since the new spot of one file may still hold
+  // another file's data
+  std::vector<GCMBlock> moved_blocks;
+  std::vector<u16> moved_targets;
+  std::vector<bool> visited(m_size_blocks, false);
+  u16 next_free = MC_FST_BLOCKS;
+  for (u8 i = 0; i < DIRLEN; ++i)
+  {
+    DEntry& entry = updated_dir.m_dir_entries[i];
+    if (entry.m_gamecode == DEntry::UNINITIALIZED_GAMECODE || entry.m_block_count == 0)
+      continue;
+
+    // chains that share blocks can't both be moved
+    const std::vector<u16>* chain = GetBlockChain(i);
+    if (!chain || next_free + chain->size() > m_size_blocks)
+      return GCMemcardDefragmentRetVal::CHAINBROKEN;
+    for (const u16 block : *chain)
+    {
+      if (visited[block])
+        return GCMemcardDefragmentRetVal::CHAINBROKEN;
+      visited[block] = true;
+    }
+
+    entry.m_first_block = next_free;
+    for (size_t j = 0; j < chain->size(); ++j)
+    {
+      const u16 block = (*chain)[j];
+      if (block != next_free)
+      {
+        moved_blocks.push_back(std::as_const(*this).DataBlock(block - MC_FST_BLOCKS));
+        moved_targets.push_back(next_free);
+      }
+      const u16 next_block = j + 1 == chain->size() ? 0xFFFF : next_free + 1;
+      updated_bat.m_map[next_free - MC_FST_BLOCKS] = next_block;
+      ++next_free;
+    }
+  }
+
+  // Every chain already runs in place, so the Dir comes out the same. The BAT can still differ
+  // when it has blocks in use that no file owns.
+  if (moved_blocks.empty() && updated_bat.m_map == GetActiveBat().m_map)
+    return GCMemcardDefragmentRetVal::UNCHANGED;
+
+  if (!moved_blocks.empty())
+  {
+    for (size_t i = 0; i < moved_blocks.size(); ++i)
+      SetDataBlock(moved_targets[i] - MC_FST_BLOCKS, moved_blocks[i]);
+
+    updated_dir.m_update_counter = updated_dir.m_update_counter + 1;
+    updated_dir.FixChecksums();
+    UpdateDirectory(updated_dir);
+  }
+
+  updated_bat.m_last_allocated_block = next_free - 1;
+  updated_bat.m_update_counter = updated_bat.m_update_counter + 1;
+  updated_bat.FixChecksums();
+  UpdateBat(updated_bat);
+
+  m_free_block_bitmap = FreeBlockBitmap(GetActiveBat(), m_size_blocks);
+  return GCMemcardDefragmentRetVal::SUCCESS;
+}
+
+bool GCMemcard::ReadBannerRGBA8(u8 index, u32* rgba) const
 {
   if (!m_valid || index >= DIRLEN)
-    return std::nullopt;
+    return false;
 
   const u32 offset = GetActiveDirectory().m_dir_entries[index].m_image_offset;
   if (offset == 0xFFFFFFFF)
-    return std::nullopt;
+    return false;
 
   // See comment on m_banner_and_icon_flags for an explanation of these.
   const u8 flags = GetActiveDirectory().m_dir_entries[index].m_banner_and_icon_flags;
   const u8 format = (flags & 0b0000'0011);
   if (format != MEMORY_CARD_BANNER_FORMAT_CI8 && format != MEMORY_CARD_BANNER_FORMAT_RGB5A3)
-    return std::nullopt;
+    return false;
 
   constexpr u32 pixel_count = MEMORY_CARD_BANNER_WIDTH * MEMORY_CARD_BANNER_HEIGHT;
   const size_t total_bytes = format == MEMORY_CARD_BANNER_FORMAT_CI8 ?
                                  (pixel_count + MEMORY_CARD_CI8_PALETTE_ENTRIES * 2) :
                                  (pixel_count * 2);
-  const auto data = GetSaveDataBytes(index, offset, total_bytes);
+  const auto data = GetSaveDataView(index, offset, total_bytes);
   if (!data || data->size() != total_bytes)
-    return std::nullopt;
+    return false;
 
-  std::vector<u32> rgba(pixel_count);
   if (format == MEMORY_CARD_BANNER_FORMAT_CI8)
   {
-    const u8* pxdata = data->data();
+    // the pixels can be decoded in place unless they straddle two blocks
+    std::array<u8, pixel_count> pxbuffer;
+    const u8* pxdata = data->GetContiguous(0, pixel_count);
+    if (!pxdata)
+    {
+      data->CopyTo(0, pixel_count, pxbuffer.data());
+      pxdata = pxbuffer.data();
+    }
     std::array<u16, MEMORY_CARD_CI8_PALETTE_ENTRIES> paldata;
-    std::memcpy(paldata.data(), data->data() + pixel_count, MEMORY_CARD_CI8_PALETTE_ENTRIES * 2);
-    Common::DecodeCI8Image(rgba.data(), pxdata, paldata.data(), MEMORY_CARD_BANNER_WIDTH,
+    data->CopyTo(pixel_count, MEMORY_CARD_CI8_PALETTE_ENTRIES * 2,
+                 reinterpret_cast<u8*>(paldata.data()));
+    Common::DecodeCI8Image(rgba, pxdata, paldata.data(), MEMORY_CARD_BANNER_WIDTH,
                            MEMORY_CARD_BANNER_HEIGHT);
   }
   else
   {
     std::array<u16, pixel_count> pxdata;
-    std::memcpy(pxdata.data(), data->data(), pixel_count * 2);
-    Common::Decode5A3Image(rgba.data(), pxdata.data(), MEMORY_CARD_BANNER_WIDTH,
+    data->CopyTo(0, pixel_count * 2, reinterpret_cast<u8*>(pxdata.data()));
+    Common::Decode5A3Image(rgba, pxdata.data(), MEMORY_CARD_BANNER_WIDTH,
                            MEMORY_CARD_BANNER_HEIGHT);
   }
 
+  return true;
+}
+
+std::optional<std::vector<u32>> GCMemcard::ReadBannerRGBA8(u8 index) const
+{
+  std::vector<u32> rgba(MEMORY_CARD_BANNER_WIDTH * MEMORY_CARD_BANNER_HEIGHT);
+  if (!ReadBannerRGBA8(index, rgba.data()))
+    return std::nullopt;
   return rgba;
 }
 
-std::optional<std::vector<GCMemcardAnimationFrameRGBA8>> GCMemcard::ReadAnimRGBA8(u8 index) const
+bool GCMemcard::ReadAnimRGBA8(u8 index, std::vector<GCMemcardAnimationFrameRGBA8>& output) const
 {
   if (!m_valid || index >= DIRLEN)
-    return std::nullopt;
+    return false;
 
   u32 image_offset = GetActiveDirectory().m_dir_entries[index].m_image_offset;
   if (image_offset == 0xFFFFFFFF)
-    return std::nullopt;
+    return false;
 
   // Data at m_image_offset stores first the banner, if any, and then the icon data.
   // Skip over the banner if there is one.
@@ -1033,7 +2079,7 @@ std::optional<std::vector<GCMemcardAnimationFrameRGBA8>> GCMemcard::ReadAnimRGBA
 
   // if first frame format is 0, the entire icon is skipped
   if (frame_formats[0] == 0)
-    return std::nullopt;
+    return false;
 
   // calculate byte length of each individual icon frame and full icon data
   constexpr u32 pixels_per_frame = MEMORY_CARD_ICON_WIDTH * MEMORY_CARD_ICON_HEIGHT;
@@ -1070,7 +2116,7 @@ std::optional<std::vector<GCMemcardAnimationFrameRGBA8>> GCMemcard::ReadAnimRGBA
   }
 
   if (frame_count == 0)
-    return std::nullopt;
+    return false;
 
   const u32 shared_palette_offset = data_length;
   if (has_shared_palette)
@@ -1078,23 +2124,34 @@ std::optional<std::vector<GCMemcardAnimationFrameRGBA8>> GCMemcard::ReadAnimRGBA
 
   // now that we have determined the data length, fetch the actual data from the save file
   // if anything is sketchy, bail so we don't access out of bounds
-  auto save_data_bytes = GetSaveDataBytes(index, image_offset, data_length);
-  if (!save_data_bytes || save_data_bytes->size() != data_length)
-    return std::nullopt;
+  const auto save_data = GetSaveDataView(index, image_offset, data_length);
+  if (!save_data || save_data->size() != data_length)
+    return false;
+
+  // CI8 pixels can be decoded in place unless they straddle two blocks
+  std::array<u8, pixels_per_frame> ci8_buffer;
+  const auto get_ci8_pixels = [&](u32 offset) {
+    const u8* pixels = save_data->GetContiguous(offset, pixels_per_frame);
+    if (pixels)
+      return pixels;
+    save_data->CopyTo(offset, pixels_per_frame, ci8_buffer.data());
+    return static_cast<const u8*>(ci8_buffer.data());
+  };
 
   // and finally, decode icons into RGBA8
   std::array<u16, MEMORY_CARD_CI8_PALETTE_ENTRIES> shared_palette;
   if (has_shared_palette)
   {
-    std::memcpy(shared_palette.data(), save_data_bytes->data() + shared_palette_offset,
-                2 * MEMORY_CARD_CI8_PALETTE_ENTRIES);
+    save_data->CopyTo(shared_palette_offset, 2 * MEMORY_CARD_CI8_PALETTE_ENTRIES,
+                      reinterpret_cast<u8*>(shared_palette.data()));
   }
 
-  std::vector<GCMemcardAnimationFrameRGBA8> output;
+  // reuse whatever frames the caller passed in, clearing them to transparent
+  output.resize(frame_count);
   for (u32 i = 0; i < frame_count; ++i)
   {
-    GCMemcardAnimationFrameRGBA8& output_frame = output.emplace_back();
-    output_frame.image_data.resize(pixels_per_frame);
+    GCMemcardAnimationFrameRGBA8& output_frame = output[i];
+    output_frame.image_data.assign(pixels_per_frame, 0);
     output_frame.delay = frame_delays[i];
 
     // Note on how to interpret this inner loop here: In the general case this just degenerates into
@@ -1104,22 +2161,22 @@ std::optional<std::vector<GCMemcardAnimationFrameRGBA8>> GCMemcard::ReadAnimRGBA
     // that this may end up decoding the same frame multiple times.
     // If this happens but no next valid frame exists, we instead return a fully transparent frame,
     // again visually matching the GC BIOS. There is no extra code necessary for this as the
-    // resize() of the vector already initializes it to a fully transparent frame.
+    // assign() above already initializes it to a fully transparent frame.
     for (u32 j = i; j < frame_count; ++j)
     {
       if (frame_formats[j] == MEMORY_CARD_ICON_FORMAT_CI8_SHARED_PALETTE)
       {
-        Common::DecodeCI8Image(output_frame.image_data.data(),
-                               save_data_bytes->data() + frame_offsets[j], shared_palette.data(),
-                               MEMORY_CARD_ICON_WIDTH, MEMORY_CARD_ICON_HEIGHT);
+        Common::DecodeCI8Image(output_frame.image_data.data(), get_ci8_pixels(frame_offsets[j]),
+                               shared_palette.data(), MEMORY_CARD_ICON_WIDTH,
+                               MEMORY_CARD_ICON_HEIGHT);
         break;
       }
 
       if (frame_formats[j] == MEMORY_CARD_ICON_FORMAT_RGB5A3)
       {
         std::array<u16, pixels_per_frame> pxdata;
-        std::memcpy(pxdata.data(), save_data_bytes->data() + frame_offsets[j],
-                    pixels_per_frame * 2);
+        save_data->CopyTo(frame_offsets[j], pixels_per_frame * 2,
+                          reinterpret_cast<u8*>(pxdata.data()));
         Common::Decode5A3Image(output_frame.image_data.data(), pxdata.data(),
                                MEMORY_CARD_ICON_WIDTH, MEMORY_CARD_ICON_HEIGHT);
         break;
@@ -1128,16 +2185,23 @@ std::optional<std::vector<GCMemcardAnimationFrameRGBA8>> GCMemcard::ReadAnimRGBA
       if (frame_formats[j] == MEMORY_CARD_ICON_FORMAT_CI8_UNIQUE_PALETTE)
       {
         std::array<u16, MEMORY_CARD_CI8_PALETTE_ENTRIES> paldata;
-        std::memcpy(paldata.data(), save_data_bytes->data() + frame_offsets[j] + pixels_per_frame,
-                    MEMORY_CARD_CI8_PALETTE_ENTRIES * 2);
-        Common::DecodeCI8Image(output_frame.image_data.data(),
-                               save_data_bytes->data() + frame_offsets[j], paldata.data(),
-                               MEMORY_CARD_ICON_WIDTH, MEMORY_CARD_ICON_HEIGHT);
+        save_data->CopyTo(frame_offsets[j] + pixels_per_frame, MEMORY_CARD_CI8_PALETTE_ENTRIES * 2,
+                          reinterpret_cast<u8*>(paldata.data()));
+        Common::DecodeCI8Image(output_frame.image_data.data(), get_ci8_pixels(frame_offsets[j]),
+                               paldata.data(), MEMORY_CARD_ICON_WIDTH, MEMORY_CARD_ICON_HEIGHT);
         break;
       }
     }
   }
 
+  return true;
+}
+
+std::optional<std::vector<GCMemcardAnimationFrameRGBA8>> GCMemcard::ReadAnimRGBA8(u8 index) const
+{
+  std::vector<GCMemcardAnimationFrameRGBA8> output;
+  if (!ReadAnimRGBA8(index, output))
+    return std::nullopt;
   return output;
 }
 
@@ -1162,6 +2226,13 @@ bool GCMemcard::Format(u8* card_data, const CardFlashId& flash_id, u16 size_mbit
 
 bool GCMemcard::Format(const CardFlashId& flash_id, u16 size_mbits, bool shift_jis, u32 rtc_bias,
                        u32 sram_language, u64 format_time)
+{
+  FormatInMemory(flash_id, size_mbits, shift_jis, rtc_bias, sram_language, format_time);
+  return Save();
+}
+
+void GCMemcard::FormatInMemory(const CardFlashId& flash_id, u16 size_mbits, bool shift_jis,
+                               u32 rtc_bias, u32 sram_language, u64 format_time)
 {
   m_header_block = Header(flash_id, size_mbits, shift_jis, rtc_bias, sram_language, format_time);
   m_directory_blocks[0] = m_directory_blocks[1] = Directory();
@@ -1169,14 +2240,22 @@ bool GCMemcard::Format(const CardFlashId& flash_id, u16 size_mbits, bool shift_j
 
   m_size_mb = size_mbits;
   m_size_blocks = (u32)m_size_mb * MBIT_TO_BLOCKS;
+  m_mapping.Close();
+  m_fork_blocks.clear();
+  m_fork_block_owned.clear();
+  m_forked_blocks.clear();
   m_data_blocks.clear();
   m_data_blocks.resize(m_size_blocks - MC_FST_BLOCKS);
+  m_changed_data_blocks.assign(m_size_blocks - MC_FST_BLOCKS, false);
+  m_source_file_tracked = false;
+  m_block_hashes.clear();
+  m_block_hash_valid.clear();
 
   m_active_directory = 0;
   m_active_bat = 0;
   m_valid = true;
-
-  return Save();
+  RebuildBlockChains();
+  m_free_block_bitmap = FreeBlockBitmap(GetActiveBat(), m_size_blocks);
 }
 
 /*************************************************************/
@@ -1417,8 +2496,7 @@ std::pair<u16, u16> Header::CalculateChecksums() const
 {
   static_assert(std::is_trivially_copyable<Header>());
 
-  std::array<u8, sizeof(Header)> raw;
-  memcpy(raw.data(), this, raw.size());
+  const u8* raw = reinterpret_cast<const u8*>(this);
 
   constexpr size_t checksum_area_start = offsetof(Header, m_data);
   constexpr size_t checksum_area_end = offsetof(Header, m_checksum);
@@ -1462,11 +2540,26 @@ bool Directory::Replace(const DEntry& entry, size_t index)
   if (index >= m_dir_entries.size())
     return false;
 
-  m_dir_entries[index] = entry;
-  FixChecksums();
+  ReplaceChecksummedData(&m_dir_entries[index], &entry, sizeof(entry));
   return true;
 }
 
+void Directory::IncrementUpdateCounter()
+{
+  const Common::BigEndianValue<s16> value(static_cast<s16>(m_update_counter + 1));
+  ReplaceChecksummedData(&m_update_counter, &value, sizeof(value));
+}
+
+void Directory::ReplaceChecksummedData(void* field, const void* data, size_t size)
+{
+  constexpr size_t checksum_area_size = offsetof(Directory, m_checksum);
+  if (!ReplaceMemcardChecksummedData(static_cast<u8*>(field), static_cast<const u8*>(data), size,
+                                     checksum_area_size, m_checksum, m_checksum_inv))
+  {
+    FixChecksums();
+  }
+}
+
 void Directory::FixChecksums()
 {
   std::tie(m_checksum, m_checksum_inv) = CalculateChecksums();
@@ -1476,8 +2569,7 @@ std::pair<u16, u16> Directory::CalculateChecksums() const
 {
   static_assert(std::is_trivially_copyable<Directory>());
 
-  std::array<u8, sizeof(Directory)> raw;
-  memcpy(raw.data(), this, raw.size());
+  const u8* raw = reinterpret_cast<const u8*>(this);
 
   constexpr size_t checksum_area_start = offsetof(Directory, m_dir_entries);
   constexpr size_t checksum_area_end = offsetof(Directory, m_checksum);
@@ -1501,57 +2593,67 @@ GCMemcardErrorCode Directory::CheckForErrors() const
   return error_code;
 }
 
-GCMemcardErrorCode Directory::CheckForErrorsWithBat(const BlockAlloc& bat) const
+GCMemcardErrorCode Directory::CheckForErrorsWithBat(const BlockAlloc& bat, u16 size_mbits) const
 {
   GCMemcardErrorCode error_code;
-
-  for (u8 i = 0; i < DIRLEN; ++i)
+  if (size_mbits == 0 || size_mbits > 256)
   {
-    const DEntry& entry = m_dir_entries[i];
-    if (entry.m_gamecode == DEntry::UNINITIALIZED_GAMECODE)
-      continue;
+    error_code.Set(GCMemcardValidityIssues::DIR_BAT_INCONSISTENT);
+    return error_code;
+  }
+
+  const bool consistent = VisitCardGeometry(size_mbits, [&](auto geometry) {
+    const BatView bat_view(bat, geometry);
+    // if no link leaves the card, only the first block of each chain needs a bounds check
+    const bool links_in_range = bat_view.AreLinksInRange();
 
-    // check if we end up with the same number of blocks when traversing through the BAT using the
-    // given first block
-    const u16 dir_number_of_blocks = entry.m_block_count;
-    const u16 dir_first_block = entry.m_first_block;
-    bool bat_block_count_matches = false;
+    // Walk all files through one bitmap of the blocks seen so far. A file has to end with the
+    // last-block BAT indicator after exactly as many blocks as the directory says, and a block
+    // that was already seen means the chain loops or runs into another file.
+    std::bitset<MC_FST_BLOCKS + BAT_SIZE> visited;
+    for (const DEntry& entry : m_dir_entries)
     {
-      u16 remaining_blocks = dir_number_of_blocks;
-      u16 current_block = dir_first_block;
-      while (true)
+      if (entry.m_gamecode == DEntry::UNINITIALIZED_GAMECODE)
+        continue;
+
+      const u16 block_count = entry.m_block_count;
+      u16 current_block = entry.m_first_block;
+      if (block_count == 0 || block_count > geometry.DataBlocks() ||
+          current_block < MC_FST_BLOCKS || current_block >= geometry.SizeBlocks())
       {
-        if (remaining_blocks == 0)
-        {
-          // we should be at the last block but haven't seen the last-block BAT indicator yet, file
-          // is larger according to BAT, so we're inconsistent
-          break;
-        }
-        --remaining_blocks;
-        const u16 next_block = bat.GetNextBlock(current_block);
-        if (next_block == 0)
-        {
-          // current block is out-of-range or next block is unallocated, this is definitely wrong
-          break;
-        }
+        return false;
+      }
+
+      for (u16 j = 1;; ++j)
+      {
+        if (visited[current_block])
+          return false;
+        visited[current_block] = true;
+
+        const u16 next_block = links_in_range ?
+                                   static_cast<u16>(bat.m_map[current_block - MC_FST_BLOCKS]) :
+                                   bat_view.GetNextBlock(current_block);
         if (next_block == 0xFFFF)
         {
-          // we're at the final block according to the BAT
-          // if there are zero remaining blocks according to the directory we're consistent,
-          // otherwise the file is smaller according to the BAT and we're inconsistent
-          bat_block_count_matches = remaining_blocks == 0;
+          // the file is smaller according to the BAT if there are blocks left in the directory
+          if (j != block_count)
+            return false;
           break;
         }
+        // a next block that is unallocated or out of range is definitely wrong, and one past the
+        // directory's count means the file is larger according to the BAT
+        if (next_block == 0 || j == block_count)
+          return false;
+        if (!links_in_range && (next_block < MC_FST_BLOCKS || next_block >= geometry.SizeBlocks()))
+          return false;
         current_block = next_block;
       }
     }
+    return true;
+  });
 
-    if (!bat_block_count_matches)
-    {
-      error_code.Set(GCMemcardValidityIssues::DIR_BAT_INCONSISTENT);
-      break;
-    }
-  }
+  if (!consistent)
+    error_code.Set(GCMemcardValidityIssues::DIR_BAT_INCONSISTENT);
 
   // TODO: We could also check if every allocated BAT block is actually reachable with the files.
 
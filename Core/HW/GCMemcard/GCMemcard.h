@@ -6,11 +6,19 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <cstddef>
+#include <deque>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/NandPaths.h"
 #include "Common/Swap.h"
 #include "Common/Timer.h"
@@ -54,6 +62,23 @@ enum class GCMemcardRemoveFileRetVal
   DELETE_FAIL,
 };
 
+enum class GCMemcardDefragmentRetVal
+{
+  SUCCESS,
+  UNCHANGED,
+  NOMEMCARD,
+  CHAINBROKEN,
+};
+
+enum class GCMemcardOverwriteFileRetVal
+{
+  SUCCESS,
+  NOMEMCARD,
+  NOFILE,
+  SIZEMISMATCH,
+  CHAINBROKEN,
+};
+
 enum class GCMemcardValidityIssues
 {
   FAILED_TO_OPEN,
@@ -339,12 +364,18 @@ struct Directory
   // with the given DEntry data.
   bool Replace(const DEntry& entry, size_t index);
 
+  void IncrementUpdateCounter();
+
+  // Overwrites a field inside the checksummed area and adjusts the checksums for just the changed
+  // words, instead of recalculating them over the whole block.
+  void ReplaceChecksummedData(void* field, const void* data, size_t size);
+
   void FixChecksums();
   std::pair<u16, u16> CalculateChecksums() const;
 
   GCMemcardErrorCode CheckForErrors() const;
 
-  GCMemcardErrorCode CheckForErrorsWithBat(const BlockAlloc& bat) const;
+  GCMemcardErrorCode CheckForErrorsWithBat(const BlockAlloc& bat, u16 size_mbits) const;
 };
 static_assert(sizeof(Directory) == BLOCK_SIZE);
 static_assert(std::is_trivially_copyable_v<Directory>);
@@ -376,6 +407,16 @@ struct BlockAlloc
   bool ClearBlocks(u16 starting_block, u16 block_count);
   u16 AssignBlocksContiguous(u16 length);
 
+  // These keep the checksums up to date, see ReplaceChecksummedData().
+  void SetNextBlock(u16 block, u16 next_block);
+  void SetFreeBlocks(u16 free_blocks);
+  void SetLastAllocatedBlock(u16 block);
+  void IncrementUpdateCounter();
+
+  // Overwrites a field inside the checksummed area and adjusts the checksums for just the changed
+  // words, instead of recalculating them over the whole block.
+  void ReplaceChecksummedData(void* field, const void* data, size_t size);
+
   void FixChecksums();
   std::pair<u16, u16> CalculateChecksums() const;
 
@@ -383,6 +424,32 @@ struct BlockAlloc
 };
 static_assert(sizeof(BlockAlloc) == BLOCK_SIZE);
 static_assert(std::is_trivially_copyable_v<BlockAlloc>);
+
+// One bit per card block, set while the block is free. Kept next to a BAT so allocation can find
+// free blocks a word at a time instead of scanning the BAT map entry by entry.
+class FreeBlockBitmap
+{
+public:
+  FreeBlockBitmap();
+  FreeBlockBitmap(const BlockAlloc& bat, u16 size_blocks);
+
+  void MarkUsed(u16 block);
+  void MarkFree(u16 block);
+
+  // Same search order as BlockAlloc::NextFreeBlock(): [starting_block, max_block), then from the
+  // first data block up to starting_block. Returns 0xFFFF if no block is free.
+  u16 NextFreeBlock(u16 max_block, u16 starting_block) const;
+
+  // Start of the first run of at least length free blocks, searched in the same order as
+  // NextFreeBlock(). Returns 0xFFFF if there is no such run.
+  u16 NextFreeRun(u16 length, u16 max_block, u16 starting_block) const;
+
+private:
+  // first block in [begin, end) whose free bit equals free, or end
+  u16 FindBlock(bool free, u16 begin, u16 end) const;
+
+  std::array<u64, (MC_FST_BLOCKS + BAT_SIZE + 63) / 64> m_free;
+};
 #pragma pack(pop)
 
 struct Savefile
@@ -391,6 +458,196 @@ struct Savefile
   std::vector<GCMBlock> blocks;
 };
 
+// Keeps the data block storage of destroyed cards around, so that cards opened or cloned later
+// can reuse it instead of allocating and faulting in up to 16 MiB of fresh memory every time.
+// Storage is only reused for cards of the same size, and at most MAX_IDLE_BYTES of it is kept
+// around, the oldest idle storage being released first. Thread safe.
+class GCMemcardBlockPool
+{
+public:
+  static constexpr size_t MAX_IDLE_BYTES = 256 * 1024 * 1024;
+
+  // Huge pages are only a hint to the OS, and only used where it supports them.
+  explicit GCMemcardBlockPool(bool use_huge_pages = false);
+  ~GCMemcardBlockPool();
+
+  GCMemcardBlockPool(const GCMemcardBlockPool&) = delete;
+  GCMemcardBlockPool& operator=(const GCMemcardBlockPool&) = delete;
+
+  // Throws std::bad_alloc if there is neither idle storage of this size nor memory for more.
+  GCMBlock* Allocate(size_t block_count);
+  void Free(GCMBlock* blocks, size_t block_count);
+  // Releases all idle storage back to the OS.
+  void Trim();
+
+private:
+  struct Slab
+  {
+    GCMBlock* blocks;
+    size_t block_count;
+  };
+
+  GCMBlock* AllocateSlab(size_t block_count) const;
+  void FreeSlab(const Slab& slab) const;
+
+  bool m_use_huge_pages;
+  std::mutex m_mutex;
+  // Oldest first
+  std::deque<Slab> m_free_slabs;
+  size_t m_idle_bytes = 0;
+};
+
+// Allocates from a GCMemcardBlockPool if it has one, and from the heap otherwise.
+class GCMemcardBlockAllocator
+{
+public:
+  using value_type = GCMBlock;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  template <typename T>
+  struct rebind
+  {
+    static_assert(std::is_same_v<T, GCMBlock>);
+    using other = GCMemcardBlockAllocator;
+  };
+
+  GCMemcardBlockAllocator() = default;
+  explicit GCMemcardBlockAllocator(std::shared_ptr<GCMemcardBlockPool> pool)
+      : m_pool(std::move(pool))
+  {
+  }
+
+  GCMBlock* allocate(size_t count);
+  void deallocate(GCMBlock* blocks, size_t count);
+
+  bool operator==(const GCMemcardBlockAllocator& other) const { return m_pool == other.m_pool; }
+  bool operator!=(const GCMemcardBlockAllocator& other) const { return m_pool != other.m_pool; }
+
+private:
+  std::shared_ptr<GCMemcardBlockPool> m_pool;
+};
+
+using GCMemcardBlockVector = std::vector<GCMBlock, GCMemcardBlockAllocator>;
+
+struct GCMemcardOpenOptions
+{
+  // Trust the card and skip all consistency checks on open. The active Dir and BAT are still
+  // picked by update counter. GCMemcard::Validate() can be called later to run the checks anyway.
+  bool skip_validation = false;
+
+  // Where the card's data blocks, and those of its clones, are allocated from. Worth sharing
+  // between all cards of a bulk workload.
+  std::shared_ptr<GCMemcardBlockPool> block_pool;
+};
+
+// Non-owning view of a range of a save's bytes, directly on top of the card's data blocks. The
+// bytes form one segment per block they touch. Only valid until the card it came from is modified.
+class GCMemcardSaveView
+{
+public:
+  struct Segment
+  {
+    const u8* data;
+    size_t size;
+  };
+
+  class Iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = u8;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const u8*;
+    using reference = const u8&;
+
+    Iterator(const GCMemcardSaveView* view, size_t position) : m_view(view), m_position(position)
+    {
+    }
+
+    reference operator*() const { return (*m_view)[m_position]; }
+    Iterator& operator++()
+    {
+      ++m_position;
+      return *this;
+    }
+    Iterator operator++(int)
+    {
+      Iterator old = *this;
+      ++m_position;
+      return old;
+    }
+    bool operator==(const Iterator& other) const { return m_position == other.m_position; }
+    bool operator!=(const Iterator& other) const { return m_position != other.m_position; }
+
+    // byte offset into the view
+    size_t Position() const { return m_position; }
+
+  private:
+    const GCMemcardSaveView* m_view;
+    size_t m_position;
+  };
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  const u8& operator[](size_t position) const
+  {
+    const size_t save_offset = m_offset + position;
+    return Block(save_offset / BLOCK_SIZE).m_block[save_offset % BLOCK_SIZE];
+  }
+
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const { return Iterator(this, m_size); }
+
+  size_t GetSegmentCount() const;
+  Segment GetSegment(size_t index) const;
+
+  // Pointer to count bytes starting at position if they all lie in the same block, else nullptr.
+  const u8* GetContiguous(size_t position, size_t count) const;
+
+  // Copies count bytes starting at position. Returns false if that runs past the end of the view.
+  bool CopyTo(size_t position, size_t count, u8* destination) const;
+
+private:
+  friend class GCMemcard;
+
+  GCMemcardSaveView(const GCMBlock* blocks, const GCMBlock* const* block_pointers,
+                    const u16* chain, size_t offset, size_t size)
+      : m_blocks(blocks), m_block_pointers(block_pointers), m_chain(chain), m_offset(offset),
+        m_size(size)
+  {
+  }
+
+  // block of the card holding the given block of the save
+  const GCMBlock& Block(size_t save_block) const
+  {
+    const size_t index = m_chain[save_block] - MC_FST_BLOCKS;
+    return m_block_pointers ? *m_block_pointers[index] : m_blocks[index];
+  }
+
+  // data blocks of the card, indexed by card block number minus MC_FST_BLOCKS, either in one piece
+  // or, for forked cards, one by one
+  const GCMBlock* m_blocks;
+  const GCMBlock* const* m_block_pointers;
+  // card block numbers of the save, in order
+  const u16* m_chain;
+  // offset of the view into the save
+  size_t m_offset;
+  size_t m_size;
+};
+
+struct GCMemcardSaveOptions
+{
+  // Write the card to a temporary file and move it over the target once complete, so a crash never
+  // leaves a torn card behind.
+  bool atomic = false;
+
+  // When saving over the file the card was opened from, only rewrite the filesystem blocks and the
+  // data blocks that changed since it was opened or last saved.
+  bool only_changed_blocks = true;
+};
+
 class GCMemcard
 {
 private:
@@ -403,35 +660,137 @@ private:
   Header m_header_block;
   std::array<Directory, 2> m_directory_blocks;
   std::array<BlockAlloc, 2> m_bat_blocks;
-  std::vector<GCMBlock> m_data_blocks;
+  GCMemcardBlockVector m_data_blocks;
+
+  // Set for cards opened with OpenMapped(). The data blocks then live in this copy-on-write mapping
+  // instead of m_data_blocks.
+  File::MappedFile m_mapping;
+
+  // Set for cards made with Fork(): where each data block lives, which is the base card until the
+  // block is first written and then m_forked_blocks, which doesn't move its blocks around.
+  std::vector<const GCMBlock*> m_fork_blocks;
+  std::vector<bool> m_fork_block_owned;
+  std::deque<GCMBlock> m_forked_blocks;
+
+  // Data blocks modified since the card was read from or last saved to m_filename. Only meaningful
+  // while m_source_file_tracked is set, that is while the file is known to hold the rest.
+  std::vector<bool> m_changed_data_blocks;
+  bool m_source_file_tracked;
 
   int m_active_directory;
   int m_active_bat;
 
+  // Data block indices of every file, in order, as given by the active Dir and BAT. Rebuilt
+  // whenever either changes. Left empty for unused entries and for files whose chain is broken.
+  std::array<std::vector<u16>, DIRLEN> m_block_chains;
+
+  // free blocks of the active BAT
+  FreeBlockBitmap m_free_block_bitmap;
+
+  // see GetBlockHashes(), indexed like GetRawBlock()
+  mutable std::vector<u64> m_block_hashes;
+  mutable std::vector<bool> m_block_hash_valid;
+
   GCMemcard();
 
+  // The non-const version gives forked cards their own copy of the block first.
+  GCMBlock& DataBlock(u32 index);
+  const GCMBlock& DataBlock(u32 index) const;
+
+  // Everything but the data blocks, shared by Clone() and Fork()
+  GCMemcard CopyWithoutDataBlocks() const;
+
+  // The rest of OpenMapped() and OpenSharedMemory() once the card is mapped
+  static std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+  OpenFromMapping(File::MappedFile mapping, std::string filename,
+                  const GCMemcardOpenOptions& options);
+
+  // Buffers covering count data blocks starting at first. Blocks that are next to one another in
+  // memory share one buffer.
+  void AppendDataBlockBuffers(u32 first, u32 count, std::vector<File::WriteBuffer>* buffers) const;
+
+  // select the in-use Dir and BAT blocks based on update counter
+  void SelectActiveBlocks();
+
+  void SetDataBlock(u32 index, const GCMBlock& block);
+
+  void InvalidateBlockHash(u32 block_index);
+  void InvalidateFileSystemBlockHashes();
+
+  std::array<File::WriteBuffer, MC_FST_BLOCKS> GetFileSystemBuffers() const;
+  bool WriteCard(const std::string& filename) const;
+  bool WriteChangedBlocks(const std::string& filename) const;
+
   const Directory& GetActiveDirectory() const;
   const BlockAlloc& GetActiveBat() const;
 
   void UpdateDirectory(const Directory& directory);
   void UpdateBat(const BlockAlloc& bat);
 
+  void RebuildBlockChains();
+
+  // true if the stored checksums of every filesystem block match a full recalculation
+  bool ChecksumsAreCurrent() const;
+
+  // Format() without writing the result to m_filename.
+  void FormatInMemory(const CardFlashId& flash_id, u16 size_mbits, bool shift_jis, u32 rtc_bias,
+                      u32 sram_language, u64 format_time);
+
+  GCMemcardImportFileRetVal CanImportFile(const DEntry& direntry) const;
+  GCMemcardImportFileRetVal ImportFileBlocks(const DEntry& direntry, std::vector<GCMBlock>& blocks);
+
 public:
   static std::optional<GCMemcard> Create(std::string filename, const CardFlashId& flash_id,
                                          u16 size_mbits, bool shift_jis, u32 rtc_bias,
                                          u32 sram_language, u64 format_time);
 
-  static std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> Open(std::string filename);
+  // Same as Create(), but the card only exists in memory until it's explicitly saved with
+  // Save(filename). It has no filename of its own, so Save() without one fails.
+  static GCMemcard CreateInMemory(const CardFlashId& flash_id, u16 size_mbits, bool shift_jis,
+                                  u32 rtc_bias, u32 sram_language, u64 format_time);
+
+  static std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+  Open(std::string filename, const GCMemcardOpenOptions& options = {});
+
+  // Same as Open(), but maps the file into memory instead of reading it. Data blocks are only paged
+  // in once a save touches them, and modifications stay private until the card is saved.
+  static std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+  OpenMapped(std::string filename, const GCMemcardOpenOptions& options = {});
+
+  // Same as OpenMapped(), but maps a base card image some process published with
+  // File::SharedMemory, so that every process opening it shares one copy of the unmodified blocks.
+  // The card has no filename, so it's only written out by Save(filename).
+  static std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+  OpenSharedMemory(const std::string& name, const GCMemcardOpenOptions& options = {});
+
+  // Same as Open(), but from a card image in memory, such as one GetCardImage() returned. The card
+  // has no filename, so it's only written out by Save(filename).
+  static std::pair<GCMemcardErrorCode, std::optional<GCMemcard>>
+  OpenImage(const u8* image, size_t size, const GCMemcardOpenOptions& options = {});
 
   GCMemcard(const GCMemcard&) = delete;
   GCMemcard& operator=(const GCMemcard&) = delete;
   GCMemcard(GCMemcard&&) = default;
   GCMemcard& operator=(GCMemcard&&) = default;
 
+  // Explicit deep copy of the whole card, including every data block.
+  GCMemcard Clone() const;
+
+  // Copy of the card that shares the data blocks of this one until they are written, so that it
+  // only costs memory for the blocks it changes. This card has to outlive the fork and must not be
+  // modified while the fork exists. Saving a fork over the file this card maps always writes a
+  // new file, so that the mapping keeps its data.
+  GCMemcard Fork() const;
+
   bool IsValid() const { return m_valid; }
+
+  // Runs the checks Open() does on the filesystem blocks, including the repair of a single
+  // corrupted Dir or BAT copy. On a card opened with skip_validation this gives the same result a
+  // validating Open() would have. Clears the valid flag if the card turns out to be unusable.
+  GCMemcardErrorCode Validate();
   bool IsShiftJIS() const;
   bool Save();
-  bool Save(std::string const& filename);
+  bool Save(std::string const& filename, const GCMemcardSaveOptions& options = {});
   bool Format(const CardFlashId& flash_id, u16 size_mbits, bool shift_jis, u32 rtc_bias,
               u32 sram_language, u64 format_time);
   static bool Format(u8* card_data, const CardFlashId& flash_id, u16 size_mbits, bool shift_jis,
@@ -443,6 +802,26 @@ public:
 
   bool FixChecksums();
 
+  const Header& GetHeader() const { return m_header_block; }
+
+  // get number of blocks in the card image, including the filesystem blocks
+  u32 GetSizeBlocks() const { return m_size_blocks; }
+
+  // Returns the raw contents of a block of the card image, exactly as Save() writes it, or
+  // nullptr if the index is out of range. Block 0 is the header, 1-2 the directories, 3-4 the
+  // BATs, and everything from MC_FST_BLOCKS on is user data.
+  const u8* GetRawBlock(u32 block_index) const;
+
+  // XXH64 of every block of the card image, indexed like GetRawBlock(). Hashes are computed on
+  // first use and kept until their block is written again, so comparing two cards cloned from one
+  // another only has to hash the blocks that changed. Updating the cache isn't thread safe, call
+  // this once before sharing a card between threads.
+  const std::vector<u64>& GetBlockHashes() const;
+
+  // The card blocks holding the file at the given directory index, in order. nullptr unless the
+  // file's chain is intact and as long as its directory entry claims.
+  const std::vector<u16>* GetBlockChain(u8 index) const;
+
   // get number of file entries in the directory
   u8 GetNumFiles() const;
   u8 GetFileIndex(u8 fileNumber) const;
@@ -476,6 +855,11 @@ public:
   GetSaveDataBytes(u8 save_index, size_t offset = 0,
                    size_t length = std::numeric_limits<size_t>::max()) const;
 
+  // Same range as GetSaveDataBytes(), but viewed in place instead of copied out.
+  std::optional<GCMemcardSaveView>
+  GetSaveDataView(u8 save_index, size_t offset = 0,
+                  size_t length = std::numeric_limits<size_t>::max()) const;
+
   // Returns, if available, the two strings shown on the save file in the GC BIOS, in UTF8.
   // The first is the big line on top, usually the game title, and the second is the smaller line
   // next to the block size, often a progress indicator or subtitle.
@@ -486,19 +870,45 @@ public:
 
   GCMemcardGetSaveDataRetVal GetSaveData(u8 index, std::vector<GCMBlock>& saveBlocks) const;
 
+  // Copies the blocks of the given file into a caller-provided buffer, which must hold exactly
+  // DEntry_BlockCount(index) blocks.
+  GCMemcardGetSaveDataRetVal GetSaveData(u8 index, GCMBlock* save_blocks,
+                                         size_t block_count) const;
+
   // Adds the given savefile to the memory card, if possible.
   GCMemcardImportFileRetVal ImportFile(const Savefile& savefile);
 
+  // Same as above, but consumes the savefile instead of copying its blocks.
+  GCMemcardImportFileRetVal ImportFile(Savefile&& savefile);
+
   // Fetches the savefile at the given directory index, if any.
   std::optional<Savefile> ExportFile(u8 index) const;
 
+  // Replaces the contents of the file at the given directory index in place, following its
+  // existing BAT chain. The directory entry, the BAT and all checksums stay untouched, so the new
+  // data must span exactly the file's current block count. Unlike ImportFile this does not apply
+  // any per-game fixups, since the data never leaves the card it belongs to.
+  GCMemcardOverwriteFileRetVal OverwriteFileData(u8 index, const std::vector<GCMBlock>& blocks);
+
   // delete a file from the directory
   GCMemcardRemoveFileRetVal RemoveFile(u8 index);
 
+  // Moves every file into one contiguous run of blocks, in directory order, starting at the first
+  // data block, which leaves all free space in one piece at the end. The Dir and BAT are each
+  // rewritten once, and only the data blocks that actually move are written. A card that is
+  // already laid out like that is left untouched and UNCHANGED returned, so there is nothing to
+  // save. Fails without modifying the card if any file's chain is broken or shares blocks with
+  // another file's.
+  GCMemcardDefragmentRetVal Defragment();
+
   // reads the banner image
   std::optional<std::vector<u32>> ReadBannerRGBA8(u8 index) const;
+  // same, into a caller provided buffer of MEMORY_CARD_BANNER_WIDTH * MEMORY_CARD_BANNER_HEIGHT
+  bool ReadBannerRGBA8(u8 index, u32* rgba) const;
 
   // reads the animation frames
   std::optional<std::vector<GCMemcardAnimationFrameRGBA8>> ReadAnimRGBA8(u8 index) const;
+  // same, reusing the frames and their storage from a previous call
+  bool ReadAnimRGBA8(u8 index, std::vector<GCMemcardAnimationFrameRGBA8>& frames) const;
 };
 }  // namespace Memcard
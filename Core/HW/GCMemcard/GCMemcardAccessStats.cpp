@@ -0,0 +1,125 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/GCMemcard/GCMemcardAccessStats.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Tracing.h"
+
+#include "Core/HW/GCMemcard/GCMemcard.h"
+
+namespace Memcard
+{
+// How many of the blocks the game read first a summary lists
+constexpr size_t SUMMARY_FIRST_READS = 16;
+
+// The trace counters of the bytes of each kind, which have to be string literals
+constexpr std::array<const char*, static_cast<size_t>(AccessKind::Count)> BYTES_COUNTER_NAMES{
+    "memcard read bytes",       "memcard write bytes",  "memcard sector erase bytes",
+    "memcard chip erase bytes", "memcard status bytes", "memcard other bytes"};
+
+void AccessCounters::RecordCommand(AccessKind kind)
+{
+  m_command_count[static_cast<size_t>(kind)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AccessCounters::RecordTransfer(AccessKind kind, u32 address, u32 size, u64 emulated_cycles,
+                                    std::chrono::nanoseconds host_time, u64 ticks)
+{
+  const size_t index = static_cast<size_t>(kind);
+  [[maybe_unused]] const u64 bytes =
+      m_bytes[index].fetch_add(size, std::memory_order_relaxed) + size;
+  TRACE_COUNTER(BYTES_COUNTER_NAMES[index], bytes);
+  m_emulated_cycles[index].fetch_add(emulated_cycles, std::memory_order_relaxed);
+  m_host_time_ns[index].fetch_add(host_time.count(), std::memory_order_relaxed);
+
+  const u16 block = static_cast<u16>(address / BLOCK_SIZE);
+  std::lock_guard lk(m_block_accesses_mutex);
+  if (!m_block_accesses.empty() && m_block_accesses.back().block == block &&
+      m_block_accesses.back().kind == kind)
+  {
+    return;
+  }
+  TRACE_COUNTER("memcard block", block);
+  if (m_block_accesses.size() < MAX_BLOCK_ACCESSES)
+    m_block_accesses.push_back({block, kind, ticks});
+}
+
+AccessStats AccessCounters::Get() const
+{
+  AccessStats stats;
+  for (size_t i = 0; i < KIND_COUNT; ++i)
+  {
+    stats.command_count[i] = m_command_count[i].load(std::memory_order_relaxed);
+    stats.bytes[i] = m_bytes[i].load(std::memory_order_relaxed);
+    stats.emulated_cycles[i] = m_emulated_cycles[i].load(std::memory_order_relaxed);
+    stats.host_time_us[i] = m_host_time_ns[i].load(std::memory_order_relaxed) / 1000;
+  }
+  return stats;
+}
+
+std::vector<BlockAccess> AccessCounters::GetBlockAccesses() const
+{
+  std::lock_guard lk(m_block_accesses_mutex);
+  return m_block_accesses;
+}
+
+std::string AccessCounters::Summarize() const
+{
+  const AccessStats stats = Get();
+  std::string summary;
+  for (size_t i = 0; i < KIND_COUNT; ++i)
+  {
+    if (stats.command_count[i] == 0 && stats.bytes[i] == 0)
+      continue;
+    summary += fmt::format("{}: {} commands, {} bytes, {} cycles, {} us; ",
+                           GetAccessKindName(static_cast<AccessKind>(i)), stats.command_count[i],
+                           stats.bytes[i], stats.emulated_cycles[i], stats.host_time_us[i]);
+  }
+
+  std::vector<u16> first_reads;
+  {
+    std::lock_guard lk(m_block_accesses_mutex);
+    for (const BlockAccess& access : m_block_accesses)
+    {
+      if (first_reads.size() == SUMMARY_FIRST_READS)
+        break;
+      if (access.kind == AccessKind::Read &&
+          std::find(first_reads.begin(), first_reads.end(), access.block) == first_reads.end())
+      {
+        first_reads.push_back(access.block);
+      }
+    }
+  }
+  summary += fmt::format("first blocks read: {:#x}", fmt::join(first_reads, " "));
+  return summary;
+}
+
+const char* GetAccessKindName(AccessKind kind)
+{
+  switch (kind)
+  {
+  case AccessKind::Read:
+    return "read";
+  case AccessKind::Write:
+    return "write";
+  case AccessKind::SectorErase:
+    return "sector erase";
+  case AccessKind::ChipErase:
+    return "chip erase";
+  case AccessKind::Status:
+    return "status";
+  default:
+    return "other";
+  }
+}
+}  // namespace Memcard
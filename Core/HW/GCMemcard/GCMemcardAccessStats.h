@@ -0,0 +1,79 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Memcard
+{
+// What the commands a game sends to a memory card do, as far as the counters are concerned.
+enum class AccessKind
+{
+  Read,
+  Write,
+  SectorErase,
+  ChipErase,
+  Status,
+  Other,
+  Count,
+};
+
+// Totals over the lifetime of a memory card device. Emulated time is how long the card keeps the
+// game waiting, and host time is how long the backend took.
+struct AccessStats
+{
+  std::array<u64, static_cast<size_t>(AccessKind::Count)> command_count{};
+  std::array<u64, static_cast<size_t>(AccessKind::Count)> bytes{};
+  std::array<u64, static_cast<size_t>(AccessKind::Count)> emulated_cycles{};
+  std::array<u64, static_cast<size_t>(AccessKind::Count)> host_time_us{};
+};
+
+struct BlockAccess
+{
+  u16 block;
+  AccessKind kind;
+  // CoreTiming ticks of the first transfer
+  u64 ticks;
+};
+
+// Recorded by the CPU thread and readable from any other.
+class AccessCounters
+{
+public:
+  // Accesses that continue the previous one in the same block and the same way are one entry
+  static constexpr size_t MAX_BLOCK_ACCESSES = 0x4000;
+
+  void RecordCommand(AccessKind kind);
+  void RecordTransfer(AccessKind kind, u32 address, u32 size, u64 emulated_cycles,
+                      std::chrono::nanoseconds host_time, u64 ticks);
+
+  AccessStats Get() const;
+  // The blocks in the order they were accessed, up to MAX_BLOCK_ACCESSES.
+  std::vector<BlockAccess> GetBlockAccesses() const;
+
+  // A summary for the log, with the first blocks that were read.
+  std::string Summarize() const;
+
+private:
+  static constexpr size_t KIND_COUNT = static_cast<size_t>(AccessKind::Count);
+
+  std::array<std::atomic<u64>, KIND_COUNT> m_command_count{};
+  std::array<std::atomic<u64>, KIND_COUNT> m_bytes{};
+  std::array<std::atomic<u64>, KIND_COUNT> m_emulated_cycles{};
+  std::array<std::atomic<u64>, KIND_COUNT> m_host_time_ns{};
+
+  mutable std::mutex m_block_accesses_mutex;
+  std::vector<BlockAccess> m_block_accesses;
+};
+
+const char* GetAccessKindName(AccessKind kind);
+}  // namespace Memcard
@@ -0,0 +1,346 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/GCMemcard/GCMemcardArchive.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
+
+#include "Core/HW/GCMemcard/GCMemcardMemory.h"
+
+namespace Memcard
+{
+namespace
+{
+struct ArchiveHeader
+{
+  u32 magic;
+  u32 version;
+  u32 base_size;
+  u32 compressed_base_size;
+};
+
+struct ArchiveEntryHeader
+{
+  u16 name_length;
+  u32 size;
+  u32 compressed_size;
+};
+
+constexpr size_t ARCHIVE_HEADER_SIZE = 16;
+constexpr size_t ARCHIVE_ENTRY_HEADER_SIZE = 10;
+
+// The headers are read and written a field at a time, so they're little-endian and unpadded
+// whatever the host
+template <typename T>
+void PutLE(u8*& out, T value)
+{
+  for (size_t i = 0; i < sizeof(T); ++i)
+    *out++ = static_cast<u8>(value >> (i * 8));
+}
+
+template <typename T>
+T GetLE(const u8*& in)
+{
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); ++i)
+    value |= static_cast<T>(static_cast<T>(*in++) << (i * 8));
+  return value;
+}
+
+std::array<u8, ARCHIVE_HEADER_SIZE> EncodeHeader(const ArchiveHeader& header)
+{
+  std::array<u8, ARCHIVE_HEADER_SIZE> bytes;
+  u8* out = bytes.data();
+  PutLE(out, header.magic);
+  PutLE(out, header.version);
+  PutLE(out, header.base_size);
+  PutLE(out, header.compressed_base_size);
+  return bytes;
+}
+
+ArchiveHeader DecodeHeader(const std::array<u8, ARCHIVE_HEADER_SIZE>& bytes)
+{
+  const u8* in = bytes.data();
+  ArchiveHeader header;
+  header.magic = GetLE<u32>(in);
+  header.version = GetLE<u32>(in);
+  header.base_size = GetLE<u32>(in);
+  header.compressed_base_size = GetLE<u32>(in);
+  return header;
+}
+
+std::array<u8, ARCHIVE_ENTRY_HEADER_SIZE> EncodeEntryHeader(const ArchiveEntryHeader& header)
+{
+  std::array<u8, ARCHIVE_ENTRY_HEADER_SIZE> bytes;
+  u8* out = bytes.data();
+  PutLE(out, header.name_length);
+  PutLE(out, header.size);
+  PutLE(out, header.compressed_size);
+  return bytes;
+}
+
+ArchiveEntryHeader DecodeEntryHeader(const std::array<u8, ARCHIVE_ENTRY_HEADER_SIZE>& bytes)
+{
+  const u8* in = bytes.data();
+  ArchiveEntryHeader header;
+  header.name_length = GetLE<u16>(in);
+  header.size = GetLE<u32>(in);
+  header.compressed_size = GetLE<u32>(in);
+  return header;
+}
+
+// Whether a card image of size bytes could have been compressed down to compressed_size, which
+// rules out sizes that would only make a corrupted archive allocate huge buffers
+bool IsValidImageSize(u32 size, u32 compressed_size)
+{
+  return IsValidCardImageSize(size) && compressed_size <= ZSTD_compressBound(size);
+}
+
+// Decompresses a frame that must hold exactly size bytes
+std::optional<std::vector<u8>> Decompress(const std::vector<u8>& frame, u32 size,
+                                          const ZSTD_DDict* ddict)
+{
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+  if (!dctx)
+    return std::nullopt;
+
+  std::vector<u8> image(size);
+  const size_t result =
+      ddict ? ZSTD_decompress_usingDDict(dctx.get(), image.data(), image.size(), frame.data(),
+                                         frame.size(), ddict) :
+              ZSTD_decompressDCtx(dctx.get(), image.data(), image.size(), frame.data(),
+                                  frame.size());
+  if (ZSTD_isError(result) || result != size)
+    return std::nullopt;
+  return image;
+}
+}  // namespace
+
+GCMemcardArchive::GCMemcardArchive(File::IOFile file, std::vector<u8> base_image, int level)
+    : m_file(std::move(file)), m_base_image(std::move(base_image))
+{
+  // Matches have to reach back across the whole base card from anywhere in the card being
+  // compressed, and the default tables are far too small to remember every position of a base
+  // card, so save data that doesn't compress on its own would find nothing to match
+  const int size_log = IntLog2(std::max<u64>(m_base_image.size(), 1));
+  m_cctx = ZSTD_createCCtx();
+  if (m_cctx &&
+      (ZSTD_isError(ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, level)) ||
+       ZSTD_isError(ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_windowLog, size_log + 1)) ||
+       ZSTD_isError(ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_hashLog, size_log)) ||
+       ZSTD_isError(ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_checksumFlag, 1)) ||
+       ZSTD_isError(ZSTD_CCtx_loadDictionary(m_cctx, m_base_image.data(), m_base_image.size()))))
+  {
+    ZSTD_freeCCtx(m_cctx);
+    m_cctx = nullptr;
+  }
+  m_ddict = ZSTD_createDDict(m_base_image.data(), m_base_image.size());
+}
+
+GCMemcardArchive::~GCMemcardArchive()
+{
+  ZSTD_freeCCtx(m_cctx);
+  ZSTD_freeDDict(m_ddict);
+}
+
+std::unique_ptr<GCMemcardArchive> GCMemcardArchive::Create(const std::string& path,
+                                                           const std::vector<u8>& base_image,
+                                                           int level)
+{
+  if (!IsValidCardImageSize(base_image.size()))
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "The base card of archive {} has an invalid size", path);
+    return nullptr;
+  }
+
+  std::vector<u8> frame(ZSTD_compressBound(base_image.size()));
+  const size_t compressed_size =
+      ZSTD_compress(frame.data(), frame.size(), base_image.data(), base_image.size(), level);
+  if (ZSTD_isError(compressed_size))
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to compress the base card of archive {}: {}", path,
+                  ZSTD_getErrorName(compressed_size));
+    return nullptr;
+  }
+
+  File::IOFile file(path, "w+b");
+  const auto header =
+      EncodeHeader({ARCHIVE_MAGIC, ARCHIVE_VERSION, static_cast<u32>(base_image.size()),
+                    static_cast<u32>(compressed_size)});
+  if (!file || !file.WriteBytes(header.data(), header.size()) ||
+      !file.WriteBytes(frame.data(), compressed_size))
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to write archive {}", path);
+    return nullptr;
+  }
+
+  std::unique_ptr<GCMemcardArchive> archive(
+      new GCMemcardArchive(std::move(file), base_image, level));
+  archive->m_end = ARCHIVE_HEADER_SIZE + compressed_size;
+  if (!archive->IsReady())
+    return nullptr;
+  return archive;
+}
+
+std::unique_ptr<GCMemcardArchive> GCMemcardArchive::Open(const std::string& path, int level)
+{
+  File::IOFile file(path, "r+b");
+  std::array<u8, ARCHIVE_HEADER_SIZE> header_bytes;
+  if (!file || !file.ReadBytes(header_bytes.data(), header_bytes.size()))
+    return nullptr;
+  const ArchiveHeader header = DecodeHeader(header_bytes);
+  if (header.magic != ARCHIVE_MAGIC || header.version != ARCHIVE_VERSION)
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "{} is not a memory card archive this version can read",
+                  path);
+    return nullptr;
+  }
+  if (!IsValidImageSize(header.base_size, header.compressed_base_size) ||
+      header.compressed_base_size > file.GetSize() - ARCHIVE_HEADER_SIZE)
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "The base card of archive {} is corrupted", path);
+    return nullptr;
+  }
+
+  std::vector<u8> frame(header.compressed_base_size);
+  if (!file.ReadBytes(frame.data(), frame.size()))
+    return nullptr;
+  std::optional<std::vector<u8>> base_image = Decompress(frame, header.base_size, nullptr);
+  if (!base_image)
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "The base card of archive {} is corrupted", path);
+    return nullptr;
+  }
+
+  std::unique_ptr<GCMemcardArchive> archive(
+      new GCMemcardArchive(std::move(file), std::move(*base_image), level));
+  archive->m_end = ARCHIVE_HEADER_SIZE + frame.size();
+  if (!archive->IsReady() || !archive->ReadEntries())
+    return nullptr;
+  return archive;
+}
+
+bool GCMemcardArchive::IsArchive(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  std::array<u8, sizeof(u32)> magic;
+  const u8* in = magic.data();
+  return file && file.ReadBytes(magic.data(), magic.size()) && GetLE<u32>(in) == ARCHIVE_MAGIC;
+}
+
+bool GCMemcardArchive::ReadEntries()
+{
+  const u64 file_size = m_file.GetSize();
+  while (m_end + ARCHIVE_ENTRY_HEADER_SIZE <= file_size)
+  {
+    std::array<u8, ARCHIVE_ENTRY_HEADER_SIZE> header_bytes;
+    if (!m_file.Seek(m_end, File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(header_bytes.data(), header_bytes.size()))
+    {
+      return false;
+    }
+
+    const ArchiveEntryHeader header = DecodeEntryHeader(header_bytes);
+    const u64 data_offset = m_end + ARCHIVE_ENTRY_HEADER_SIZE + header.name_length;
+    if (data_offset + header.compressed_size > file_size)
+      break;
+    if (!IsValidImageSize(header.size, header.compressed_size))
+    {
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Entry {} of a card archive is corrupted",
+                    m_entries.size());
+      return false;
+    }
+
+    std::string name(header.name_length, '\0');
+    if (!m_file.ReadBytes(name.data(), name.size()))
+      return false;
+    m_index[name] = m_entries.size();
+    m_entries.push_back({std::move(name), data_offset, header.size, header.compressed_size});
+    m_end = data_offset + header.compressed_size;
+  }
+
+  if (m_end != file_size)
+  {
+    WARN_LOG_FMT(EXPANSIONINTERFACE, "Dropping the incomplete last entry of a card archive");
+  }
+  return true;
+}
+
+std::optional<size_t> GCMemcardArchive::FindEntry(std::string_view name) const
+{
+  const auto it = m_index.find(std::string(name));
+  if (it == m_index.end())
+    return std::nullopt;
+  return it->second;
+}
+
+std::optional<std::vector<u8>> GCMemcardArchive::ReadImage(size_t index) const
+{
+  const Entry& entry = m_entries[index];
+  std::vector<u8> frame(entry.compressed_size);
+  {
+    std::lock_guard lk(m_file_lock);
+    if (!m_file.Seek(entry.offset, File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(frame.data(), frame.size()))
+    {
+      return std::nullopt;
+    }
+  }
+  return Decompress(frame, entry.size, m_ddict);
+}
+
+bool GCMemcardArchive::Append(std::string name, const u8* image, size_t size)
+{
+  if (name.size() > UINT16_MAX || !IsValidCardImageSize(size))
+    return false;
+
+  std::vector<u8> frame(ZSTD_compressBound(size));
+  const size_t compressed_size = ZSTD_compress2(m_cctx, frame.data(), frame.size(), image, size);
+  if (ZSTD_isError(compressed_size))
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to compress card {}: {}", name,
+                  ZSTD_getErrorName(compressed_size));
+    return false;
+  }
+
+  const auto header = EncodeEntryHeader(
+      {static_cast<u16>(name.size()), static_cast<u32>(size), static_cast<u32>(compressed_size)});
+  std::lock_guard lk(m_file_lock);
+  if (!m_file.Seek(m_end, File::SeekOrigin::Begin) ||
+      !m_file.WriteBytes(header.data(), header.size()) ||
+      !m_file.WriteBytes(name.data(), name.size()) ||
+      !m_file.WriteBytes(frame.data(), compressed_size))
+  {
+    return false;
+  }
+
+  // Whatever was left of an entry cut short goes now that it's been written over
+  const u64 data_offset = m_end + ARCHIVE_ENTRY_HEADER_SIZE + name.size();
+  m_end = data_offset + compressed_size;
+  if (m_file.GetSize() > m_end && !m_file.Resize(m_end))
+    return false;
+  if (!m_file.Flush())
+    return false;
+
+  m_index[name] = m_entries.size();
+  m_entries.push_back({std::move(name), data_offset, static_cast<u32>(size),
+                       static_cast<u32>(compressed_size)});
+  return true;
+}
+}  // namespace Memcard
@@ -0,0 +1,98 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DDict_s;
+
+// An append-only archive of memory card images, such as a fuzzing corpus or a batch of mutants.
+// Cards derived from the same base card are nearly identical, so every entry is compressed with
+// the base card image as its zstd dictionary, which leaves little more than their differences.
+//
+// The file is little-endian:
+//   header:  u32 magic | u32 version | u32 base size | u32 compressed base size
+//            then the base card image as a zstd frame of its own
+//   entries: u16 name length | u32 size | u32 compressed size | name | zstd frame
+// There is no separate index: opening an archive walks the entry headers, and a trailing entry
+// that was cut short is dropped and overwritten by the next append.
+
+namespace Memcard
+{
+constexpr u32 ARCHIVE_MAGIC = 0x414D4347;  // "GCMA"
+constexpr u32 ARCHIVE_VERSION = 1;
+constexpr int ARCHIVE_DEFAULT_LEVEL = 3;
+
+class GCMemcardArchive
+{
+public:
+  struct Entry
+  {
+    std::string name;
+    u64 offset;
+    u32 size;
+    u32 compressed_size;
+  };
+
+  // Creates an archive at path, replacing anything there, with base_image as its dictionary.
+  // base_image has to be the size of a card.
+  static std::unique_ptr<GCMemcardArchive> Create(const std::string& path,
+                                                  const std::vector<u8>& base_image,
+                                                  int level = ARCHIVE_DEFAULT_LEVEL);
+  static std::unique_ptr<GCMemcardArchive> Open(const std::string& path,
+                                                int level = ARCHIVE_DEFAULT_LEVEL);
+
+  // true if the file starts like an archive
+  static bool IsArchive(const std::string& path);
+
+  ~GCMemcardArchive();
+  GCMemcardArchive(const GCMemcardArchive&) = delete;
+  GCMemcardArchive& operator=(const GCMemcardArchive&) = delete;
+
+  const std::vector<u8>& GetBaseImage() const { return m_base_image; }
+
+  // In the order they were appended. Entries may share a name, the last one wins in FindEntry().
+  const std::vector<Entry>& GetEntries() const { return m_entries; }
+  std::optional<size_t> FindEntry(std::string_view name) const;
+
+  // Reads and decompresses one entry. Safe to call from several threads at once.
+  std::optional<std::vector<u8>> ReadImage(size_t index) const;
+
+  // Compresses the image and writes it at the end of the archive. Fails for an image that isn't
+  // the size of a card. Must not race with anything else using the archive.
+  bool Append(std::string name, const u8* image, size_t size);
+  bool Append(std::string name, const std::vector<u8>& image)
+  {
+    return Append(std::move(name), image.data(), image.size());
+  }
+
+private:
+  GCMemcardArchive(File::IOFile file, std::vector<u8> base_image, int level);
+  bool IsReady() const { return m_cctx && m_ddict; }
+
+  bool ReadEntries();
+
+  mutable std::mutex m_file_lock;
+  mutable File::IOFile m_file;
+  std::vector<u8> m_base_image;
+  std::vector<Entry> m_entries;
+  // The last entry of each name
+  std::unordered_map<std::string, size_t> m_index;
+  u64 m_end = 0;
+
+  // Holds onto the digested base card between appends
+  ZSTD_CCtx_s* m_cctx = nullptr;
+  ZSTD_DDict_s* m_ddict = nullptr;
+};
+}  // namespace Memcard
@@ -6,6 +6,7 @@
 #include "Common/CommonTypes.h"
 
 #include "Core/HW/GCMemcard/GCMemcard.h"
+#include "Core/HW/GCMemcard/GCMemcardFlush.h"
 
 class PointerWrap;
 
@@ -24,8 +25,10 @@ public:
   virtual void ClearAll() = 0;
   virtual void DoState(PointerWrap& p) = 0;
   u32 GetCardId() const { return m_nintendo_card_id; }
+  Memcard::FlushStats GetFlushStats() const { return m_flush_counters.Get(); }
 
 protected:
   ExpansionInterface::Slot m_card_slot;
   u16 m_nintendo_card_id;
+  Memcard::FlushCounters m_flush_counters;
 };
@@ -4,11 +4,14 @@
 #include "Core/HW/GCMemcard/GCMemcardDirectory.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -18,13 +21,13 @@
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
-#include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "Common/Timer.h"
 
 #include "Core/Config/MainSettings.h"
@@ -33,12 +36,55 @@
 #include "Core/Core.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
+#include "Core/HW/GCMemcard/GCMemcardFixups.h"
 #include "Core/HW/GCMemcard/GCMemcardUtils.h"
 #include "Core/HW/Sram.h"
 #include "Core/NetPlayProto.h"
 
 static const char* MC_HDR = "MC_SYSTEM_AREA";
 
+namespace
+{
+// One save's share of a flush, copied out of m_saves so it can be written without the lock.
+struct GCIWriteJob
+{
+  std::string filename;
+  Memcard::DEntry header;
+  // Every block when rewriting the file, otherwise only the changed ones, by index in the save.
+  std::vector<std::pair<u16, Memcard::GCMBlock>> blocks;
+  bool rewrite = false;
+};
+
+bool WriteGCI(const GCIWriteJob& job, bool fsync)
+{
+  File::IOFile gci(job.filename, job.rewrite ? "wb" : "r+b");
+  if (gci)
+  {
+    gci.WriteBytes(&job.header, Memcard::DENTRY_SIZE);
+    u32 next_index = 0;
+    for (const auto& [index, block] : job.blocks)
+    {
+      if (index != next_index)
+        gci.Seek(Memcard::DENTRY_SIZE + u64{index} * Memcard::BLOCK_SIZE, File::SeekOrigin::Begin);
+      gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
+      next_index = index + 1;
+    }
+    if (fsync)
+      gci.Sync();
+  }
+
+  if (!gci.IsOpen() || !gci.IsGood())
+  {
+    Core::DisplayMessage(fmt::format("Failed to write save contents to {}", job.filename), 4000);
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", job.filename);
+    return false;
+  }
+
+  Core::DisplayMessage(fmt::format("Wrote save contents to {}", job.filename), 4000);
+  return true;
+}
+}  // namespace
+
 bool GCMemcardDirectory::LoadGCI(Memcard::GCIFile gci)
 {
   // check if any already loaded file has the same internal name as the new file
@@ -85,11 +131,7 @@ bool GCMemcardDirectory::LoadGCI(Memcard::GCIFile gci)
   }
   gci.m_gci_header.m_first_block = first_block;
 
-  if (gci.HasCopyProtection())
-  {
-    Memcard::GCMemcard::PSO_MakeSaveGameValid(m_hdr, gci.m_gci_header, gci.m_save_data);
-    Memcard::GCMemcard::FZEROGX_MakeSaveGameValid(m_hdr, gci.m_gci_header, gci.m_save_data);
-  }
+  Memcard::ApplySaveFixups(m_hdr, gci.m_gci_header, gci.m_save_data);
 
   // actually load save file into memory card
   int idx = (int)m_saves.size();
@@ -111,17 +153,12 @@ std::vector<std::string> GCMemcardDirectory::GetFileNamesForGameID(const std::st
     game_code = Common::swap32(reinterpret_cast<const u8*>(game_id.c_str()));
 
   std::vector<std::string> loaded_saves;
-  for (const std::string& file_name : Common::DoFileSearch({directory}, {".gci"}))
+  for (const Memcard::GCIHeaderEntry& entry : Memcard::ReadGCIHeaders(directory))
   {
-    File::IOFile gci_file(file_name, "rb");
-    if (!gci_file)
-      continue;
-
     Memcard::GCIFile gci;
-    gci.m_filename = file_name;
+    gci.m_filename = entry.filename;
     gci.m_dirty = false;
-    if (!gci_file.ReadBytes(&gci.m_gci_header, Memcard::DENTRY_SIZE))
-      continue;
+    gci.m_gci_header = entry.header;
 
     const std::string gci_filename = gci.m_gci_header.GCI_FileName();
     if (std::find(loaded_saves.begin(), loaded_saves.end(), gci_filename) != loaded_saves.end())
@@ -134,8 +171,7 @@ std::vector<std::string> GCMemcardDirectory::GetFileNamesForGameID(const std::st
       continue;
 
     const u32 size = num_blocks * Memcard::BLOCK_SIZE;
-    const u64 file_size = gci_file.GetSize();
-    if (file_size != size + Memcard::DENTRY_SIZE)
+    if (entry.file_size != size + Memcard::DENTRY_SIZE)
       continue;
 
     // There's technically other available block checks to prevent overfilling the virtual memory
@@ -145,7 +181,7 @@ std::vector<std::string> GCMemcardDirectory::GetFileNamesForGameID(const std::st
     if (game_code == Common::swap32(gci.m_gci_header.m_gamecode.data()))
     {
       loaded_saves.push_back(gci_filename);
-      filenames.push_back(file_name);
+      filenames.push_back(entry.filename);
     }
   }
 
@@ -156,7 +192,7 @@ GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, ExpansionIn
                                        const Memcard::HeaderData& header_data, u32 game_id)
     : MemoryCardBase(slot, header_data.m_size_mb), m_game_id(game_id), m_last_block(-1),
       m_hdr(header_data), m_bat1(header_data.m_size_mb), m_saves(0), m_save_directory(directory),
-      m_exiting(false)
+      m_flush_scheduler(Memcard::FlushPolicy::FromConfig())
 {
   // Use existing header data if available
   {
@@ -164,22 +200,17 @@ GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, ExpansionIn
   }
 
   const bool current_game_only = Config::Get(Config::SESSION_GCI_FOLDER_CURRENT_GAME_ONLY);
-  std::vector<std::string> filenames = Common::DoFileSearch({m_save_directory}, {".gci"});
 
   // split up into files for current games we should definitely load,
   // and files for other games that we don't care too much about
   std::vector<Memcard::GCIFile> gci_current_game;
   std::vector<Memcard::GCIFile> gci_other_games;
-  for (const std::string& filename : filenames)
+  for (const Memcard::GCIHeaderEntry& entry : Memcard::ReadGCIHeaders(m_save_directory))
   {
     Memcard::GCIFile gci;
-    gci.m_filename = filename;
+    gci.m_filename = entry.filename;
     gci.m_dirty = false;
-    if (!gci.LoadHeader())
-    {
-      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to load header of {}", filename);
-      continue;
-    }
+    gci.m_gci_header = entry.header;
 
     if (m_game_id == Common::swap32(gci.m_gci_header.m_gamecode.data()))
       gci_current_game.emplace_back(std::move(gci));
@@ -231,6 +262,56 @@ GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, ExpansionIn
   m_bat2 = m_bat1;
 
   m_flush_thread = std::thread(&GCMemcardDirectory::FlushThread, this);
+
+  // The running game is going to want its own saves first
+  m_prefetch_thread.Reset([this](u16 save_index) { PrefetchSave(save_index); });
+  QueuePrefetch(true);
+}
+
+void GCMemcardDirectory::QueuePrefetch(bool current_game_only)
+{
+  std::unique_lock l(m_write_mutex);
+  for (u16 i = 0; i < m_saves.size(); ++i)
+  {
+    const Memcard::GCIFile& save = m_saves[i];
+    if (save.m_gci_header.m_gamecode == Memcard::DEntry::UNINITIALIZED_GAMECODE ||
+        save.m_filename.empty() || !save.m_save_data.empty())
+    {
+      continue;
+    }
+    if (current_game_only && Common::swap32(save.m_gci_header.m_gamecode.data()) != m_game_id)
+      continue;
+
+    m_prefetch_thread.EmplaceItem(i);
+  }
+}
+
+void GCMemcardDirectory::PrefetchSave(u16 save_index)
+{
+  Memcard::GCIFile gci;
+  {
+    std::unique_lock l(m_write_mutex);
+    if (save_index >= m_saves.size() || !m_saves[save_index].m_save_data.empty())
+      return;
+    gci.m_gci_header = m_saves[save_index].m_gci_header;
+    gci.m_filename = m_saves[save_index].m_filename;
+  }
+
+  // The disk read happens without the lock, so the CPU thread can keep going meanwhile
+  if (!gci.LoadSaveBlocks())
+    return;
+
+  // Only keep the blocks if the save is still the one we read and nobody loaded it first
+  std::unique_lock l(m_write_mutex);
+  if (save_index >= m_saves.size())
+    return;
+  Memcard::GCIFile& save = m_saves[save_index];
+  if (save.m_save_data.empty() && save.m_filename == gci.m_filename &&
+      memcmp(&save.m_gci_header, &gci.m_gci_header, Memcard::DENTRY_SIZE) == 0)
+  {
+    save.m_save_data = std::move(gci.m_save_data);
+    save.m_dirty_blocks = std::move(gci.m_dirty_blocks);
+  }
 }
 
 void GCMemcardDirectory::FlushThread()
@@ -241,30 +322,17 @@ void GCMemcardDirectory::FlushThread()
   }
 
   Common::SetCurrentThreadName(fmt::format("Memcard {} flushing thread", m_card_slot).c_str());
+  Common::PlaceCurrentThread(Common::ThreadRole::IO);
 
-  constexpr std::chrono::seconds flush_interval{1};
-  while (true)
-  {
-    // no-op until signalled
-    m_flush_trigger.Wait();
-
-    if (m_exiting.TestAndClear())
-      return;
-    // no-op as long as signalled within flush_interval
-    while (m_flush_trigger.WaitFor(flush_interval))
-    {
-      if (m_exiting.TestAndClear())
-        return;
-    }
-
+  // The destructor does the final flush once we're exiting
+  while (m_flush_scheduler.WaitForFlush())
     FlushToFile();
-  }
 }
 
 GCMemcardDirectory::~GCMemcardDirectory()
 {
-  m_exiting.Set();
-  m_flush_trigger.Set();
+  m_prefetch_thread.Cancel();
+  m_flush_scheduler.RequestExit();
   m_flush_thread.join();
 
   FlushToFile();
@@ -286,6 +354,8 @@ s32 GCMemcardDirectory::Read(u32 src_address, s32 length, u8* dest_address)
                      "Memcard directory Read Logic Error");
   }
 
+  // the prefetch and flush threads may be filling in save data or dropping the cached block
+  std::unique_lock l(m_write_mutex);
   if (m_last_block != block)
   {
     switch (block)
@@ -322,6 +392,12 @@ s32 GCMemcardDirectory::Read(u32 src_address, s32 length, u8* dest_address)
   }
 
   memcpy(dest_address, m_last_block_address + offset, length);
+  l.unlock();
+
+  // Reading the directory is the first step to opening a file, so start paging saves in
+  if ((block == 1 || block == 2) && offset == 0)
+    QueuePrefetch(false);
+
   if (extra)
     extra = Read(src_address + length, extra, dest_address + length);
   return length + extra;
@@ -391,7 +467,11 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
   if (extra)
     extra = Write(dest_address + length, extra, src_address + length);
   if (offset + length == Memcard::BLOCK_SIZE)
-    m_flush_trigger.Set();
+  {
+    m_flush_scheduler.NotifyWrite();
+    if (Memcard::IsSaveCommitBlock(block))
+      m_flush_scheduler.NotifySaveComplete();
+  }
   return length + extra;
 }
 
@@ -405,6 +485,7 @@ void GCMemcardDirectory::ClearBlock(u32 address)
 
   const u32 block = address / Memcard::BLOCK_SIZE;
   INFO_LOG_FMT(EXPANSIONINTERFACE, "Clearing block {}", block);
+  std::unique_lock l(m_write_mutex);
   switch (block)
   {
   case 0:
@@ -481,11 +562,13 @@ inline void GCMemcardDirectory::SyncSaves()
           INFO_LOG_FMT(EXPANSIONINTERFACE, "Save moved from {:#x} to {:#x}", old_start, new_start);
           m_saves[i].m_used_blocks.clear();
           m_saves[i].m_save_data.clear();
+          m_saves[i].m_dirty_blocks.clear();
         }
         if (m_saves[i].m_used_blocks.empty())
         {
           SetUsedBlocks(i);
         }
+        m_block_owners_dirty = true;
       }
     }
     else if ((i < m_saves.size()) && (*(u32*)&(m_saves[i].m_gci_header) != 0xFFFFFFFF))
@@ -494,47 +577,68 @@ inline void GCMemcardDirectory::SyncSaves()
                    Common::swap32(m_saves[i].m_gci_header.m_gamecode.data()));
       m_saves[i].m_gci_header.m_gamecode = Memcard::DEntry::UNINITIALIZED_GAMECODE;
       m_saves[i].m_save_data.clear();
+      m_saves[i].m_dirty_blocks.clear();
       m_saves[i].m_used_blocks.clear();
       m_saves[i].m_dirty = true;
+      m_block_owners_dirty = true;
     }
   }
 }
 inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
 {
-  for (u16 i = 0; i < m_saves.size(); ++i)
+  if (m_block_owners_dirty)
+    RebuildBlockOwners();
+
+  if (block >= m_block_owners.size() || m_block_owners[block].save == BlockOwner::NO_SAVE)
+    return -1;
+
+  const BlockOwner& owner = m_block_owners[block];
+  Memcard::GCIFile& save = m_saves[owner.save];
+  if (!save.LoadSaveBlocks())
   {
-    if (m_saves[i].m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
+    int num_blocks = save.m_gci_header.m_block_count;
+    while (num_blocks)
     {
-      if (m_saves[i].m_used_blocks.empty())
-      {
-        SetUsedBlocks(i);
-      }
+      save.m_save_data.emplace_back();
+      num_blocks--;
+    }
+  }
 
-      int idx = m_saves[i].UsesBlock(block);
-      if (idx != -1)
-      {
-        if (!m_saves[i].LoadSaveBlocks())
-        {
-          int num_blocks = m_saves[i].m_gci_header.m_block_count;
-          while (num_blocks)
-          {
-            m_saves[i].m_save_data.emplace_back();
-            num_blocks--;
-          }
-        }
+  if (writing)
+  {
+    save.m_dirty = true;
+    if (save.m_dirty_blocks.size() == save.m_save_data.size())
+      save.m_dirty_blocks[owner.index] = true;
+  }
 
-        if (writing)
-        {
-          m_saves[i].m_dirty = true;
-        }
+  m_last_block = block;
+  m_last_block_address = save.m_save_data[owner.index].m_block.data();
+  return m_last_block;
+}
 
-        m_last_block = block;
-        m_last_block_address = m_saves[i].m_save_data[idx].m_block.data();
-        return m_last_block;
+void GCMemcardDirectory::RebuildBlockOwners()
+{
+  m_block_owners.fill({});
+  for (u16 i = 0; i < m_saves.size(); ++i)
+  {
+    if (m_saves[i].m_gci_header.m_gamecode == Memcard::DEntry::UNINITIALIZED_GAMECODE)
+      continue;
+
+    if (m_saves[i].m_used_blocks.empty())
+      SetUsedBlocks(i);
+
+    // If saves overlap, the first one claiming a block keeps it
+    const std::vector<u16>& used_blocks = m_saves[i].m_used_blocks;
+    for (u16 j = 0; j < used_blocks.size(); ++j)
+    {
+      if (used_blocks[j] < m_block_owners.size() &&
+          m_block_owners[used_blocks[j]].save == BlockOwner::NO_SAVE)
+      {
+        m_block_owners[used_blocks[j]] = {i, j};
       }
     }
   }
-  return -1;
+  m_block_owners_dirty = false;
 }
 
 s32 GCMemcardDirectory::DirectoryWrite(u32 dest_address, u32 length, const u8* src_address)
@@ -566,6 +670,7 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
   else
     current_bat = &m_bat1;
 
+  m_block_owners_dirty = true;
   u16 block = m_saves[save_index].m_gci_header.m_first_block;
   while (block != 0xFFFF)
   {
@@ -594,11 +699,14 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
 
 void GCMemcardDirectory::FlushToFile()
 {
+  const auto flush_start = std::chrono::steady_clock::now();
   std::unique_lock l(m_write_mutex);
-  int errors = 0;
-  Memcard::DEntry invalid;
+  const auto lock_wait_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - flush_start);
+  std::vector<GCIWriteJob> jobs;
   for (Memcard::GCIFile& save : m_saves)
   {
+    bool queued_write = false;
     if (save.m_dirty)
     {
       if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
@@ -631,25 +739,24 @@ void GCMemcardDirectory::FlushToFile()
           }
           save.m_filename = default_save_name;
         }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          for (const Memcard::GCMBlock& block : save.m_save_data)
-            gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
 
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage(fmt::format("Wrote save contents to {}", save.m_filename), 4000);
-          }
-          else
-          {
-            ++errors;
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 4000);
-            ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
-          }
+        // Snapshot what changed, the files themselves are written once the lock is dropped.
+        // Unless every block is accounted for and the file on disk matches the save's size,
+        // the whole file is rewritten.
+        GCIWriteJob& job = jobs.emplace_back();
+        job.filename = save.m_filename;
+        job.header = save.m_gci_header;
+        const u64 file_size =
+            Memcard::DENTRY_SIZE + u64{save.m_save_data.size()} * Memcard::BLOCK_SIZE;
+        job.rewrite = save.m_dirty_blocks.size() != save.m_save_data.size() ||
+                      File::GetSize(save.m_filename) != file_size;
+        for (u16 i = 0; i < save.m_save_data.size(); ++i)
+        {
+          if (job.rewrite || save.m_dirty_blocks[i])
+            job.blocks.emplace_back(i, save.m_save_data[i]);
         }
+        save.m_dirty_blocks.assign(save.m_save_data.size(), false);
+        queued_write = true;
       }
       else if (save.m_filename.length() != 0)
       {
@@ -661,7 +768,9 @@ void GCMemcardDirectory::FlushToFile()
         File::Rename(old_name, deleted_name);
         save.m_filename.clear();
         save.m_save_data.clear();
+        save.m_dirty_blocks.clear();
         save.m_used_blocks.clear();
+        m_block_owners_dirty = true;
       }
     }
 
@@ -670,13 +779,60 @@ void GCMemcardDirectory::FlushToFile()
     // simultaneously
     // this ensures that the save data for all of the current games gci files are stored in the
     // savestate
+    // saves that are being written stay loaded until the next flush, in case the write fails
     const u32 gamecode = Common::swap32(save.m_gci_header.m_gamecode.data());
-    if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty())
+    if (!queued_write && gamecode != m_game_id && gamecode != 0xFFFFFFFF &&
+        !save.m_save_data.empty())
     {
       INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
       save.m_save_data.clear();
+      save.m_dirty_blocks.clear();
     }
   }
+
+  // Writes only mark their block dirty when they go through SaveAreaRW(), which the cached block
+  // skips. Dropping the cache makes the next write to it mark it again now that the marks are
+  // cleared, and keeps it from pointing into save data that was just unloaded.
+  m_last_block = -1;
+  m_last_block_address = nullptr;
+  l.unlock();
+
+  // Every job is a different file, so they're written side by side
+  const bool fsync = m_flush_scheduler.GetPolicy().fsync;
+  std::atomic<u64> bytes_flushed{0};
+  std::vector<u8> written(jobs.size(), false);
+  Common::ParallelFor(jobs.size(), [&](size_t i) {
+    written[i] = WriteGCI(jobs[i], fsync);
+    if (written[i])
+      bytes_flushed += Memcard::DENTRY_SIZE + jobs[i].blocks.size() * Memcard::BLOCK_SIZE;
+  });
+
+  // The dirty marks of failed writes were already cleared, so have the next flush rewrite the
+  // whole file instead
+  if (std::find(written.begin(), written.end(), false) != written.end())
+  {
+    l.lock();
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+      if (written[i])
+        continue;
+      const auto it = std::find_if(m_saves.begin(), m_saves.end(), [&](const auto& save) {
+        return save.m_filename == jobs[i].filename;
+      });
+      if (it != m_saves.end() && !it->m_save_data.empty())
+      {
+        it->m_dirty = true;
+        it->m_dirty_blocks.clear();
+      }
+    }
+    l.unlock();
+  }
+
+  const auto flush_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - flush_start);
+  m_flush_counters.Record(bytes_flushed, flush_time, lock_wait_time);
+  INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushed {} bytes of GCI folder {} in {} us",
+               bytes_flushed.load(), m_save_directory, flush_time.count());
 #if _WRITE_MC_HEADER
   u8 mc[BLOCK_SIZE * MC_FST_BLOCKS];
   Read(0, BLOCK_SIZE * MC_FST_BLOCKS, mc);
@@ -703,6 +859,7 @@ void GCMemcardDirectory::DoState(PointerWrap& p)
   {
     save.DoState(p);
   }
+  m_block_owners_dirty = true;
 }
 
 void MigrateFromMemcardFile(const std::string& directory_name, ExpansionInterface::Slot card_slot,
@@ -3,15 +3,17 @@
 
 #pragma once
 
+#include <array>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
 
-#include "Common/Event.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/HW/GCMemcard/GCIFile.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
 #include "Core/HW/GCMemcard/GCMemcardBase.h"
+#include "Core/HW/GCMemcard/GCMemcardFlush.h"
 #include "DiscIO/Enums.h"
 
 // Uncomment this to write the system data of the memorycard from directory to disc
@@ -48,6 +50,17 @@ private:
   s32 DirectoryWrite(u32 dest_address, u32 length, const u8* src_address);
   inline void SyncSaves();
   bool SetUsedBlocks(int save_index);
+  void RebuildBlockOwners();
+  void QueuePrefetch(bool current_game_only);
+  void PrefetchSave(u16 save_index);
+
+  // The save a card block belongs to, and the block's index within that save.
+  struct BlockOwner
+  {
+    static constexpr u16 NO_SAVE = 0xFFFF;
+    u16 save = NO_SAVE;
+    u16 index = 0;
+  };
 
   u32 m_game_id;
   s32 m_last_block;
@@ -59,10 +72,14 @@ private:
   Memcard::BlockAlloc m_bat1;
   Memcard::BlockAlloc m_bat2;
   std::vector<Memcard::GCIFile> m_saves;
+  // Indexed by card block, rebuilt from m_saves on the next access whenever it's marked dirty.
+  std::array<BlockOwner, Memcard::MC_FST_BLOCKS + Memcard::BAT_SIZE> m_block_owners;
+  bool m_block_owners_dirty = true;
 
   std::string m_save_directory;
-  Common::Event m_flush_trigger;
   std::mutex m_write_mutex;
-  Common::Flag m_exiting;
+  Memcard::FlushScheduler m_flush_scheduler;
   std::thread m_flush_thread;
+  // Loads save blocks from disk ahead of the game's first access to them.
+  Common::WorkQueueThread<u16> m_prefetch_thread;
 };
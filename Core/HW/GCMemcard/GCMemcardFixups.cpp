@@ -0,0 +1,96 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/GCMemcard/GCMemcardFixups.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+
+namespace Memcard
+{
+namespace
+{
+struct FixupEntry
+{
+  std::array<u8, 3> title;
+  std::array<u8, 2> makercode;
+  SaveFixup fixup;
+};
+
+template <size_t N>
+std::array<u8, N> ToCode(std::string_view code)
+{
+  ASSERT(code.size() == N);
+  std::array<u8, N> result{};
+  std::copy_n(code.begin(), std::min(code.size(), N), result.begin());
+  return result;
+}
+
+FixupEntry MakeEntry(std::string_view title, std::string_view makercode, SaveFixup fixup)
+{
+  return {ToCode<3>(title), ToCode<2>(makercode), std::move(fixup)};
+}
+
+bool FZeroGXFixup(const Header& card_header, const DEntry& direntry, std::vector<GCMBlock>& blocks)
+{
+  return GCMemcard::FZEROGX_MakeSaveGameValid(card_header, direntry, blocks) != 0;
+}
+
+bool PSOFixup(const Header& card_header, const DEntry& direntry, std::vector<GCMBlock>& blocks)
+{
+  return GCMemcard::PSO_MakeSaveGameValid(card_header, direntry, blocks) != 0;
+}
+
+struct FixupRegistry
+{
+  FixupRegistry()
+  {
+    entries.push_back(MakeEntry("GFZ", "8P", FZeroGXFixup));
+    entries.push_back(MakeEntry("GPO", "8P", PSOFixup));
+    entries.push_back(MakeEntry("GPS", "8P", PSOFixup));
+  }
+
+  std::mutex mutex;
+  std::vector<FixupEntry> entries;
+};
+
+FixupRegistry& GetRegistry()
+{
+  static FixupRegistry registry;
+  return registry;
+}
+}  // namespace
+
+void RegisterSaveFixup(std::string_view title, std::string_view makercode, SaveFixup fixup)
+{
+  auto& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  registry.entries.push_back(MakeEntry(title, makercode, std::move(fixup)));
+}
+
+int ApplySaveFixups(const Header& card_header, const DEntry& direntry,
+                    std::vector<GCMBlock>& blocks)
+{
+  auto& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  int applied = 0;
+  for (const FixupEntry& entry : registry.entries)
+  {
+    if (!std::equal(entry.title.begin(), entry.title.end(), direntry.m_gamecode.begin()) ||
+        entry.makercode != direntry.m_makercode)
+    {
+      continue;
+    }
+    if (entry.fixup(card_header, direntry, blocks))
+      ++applied;
+  }
+  return applied;
+}
+}  // namespace Memcard
@@ -0,0 +1,29 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include "Core/HW/GCMemcard/GCMemcard.h"
+
+namespace Memcard
+{
+// Rewrites the title specific integrity fields of a save, such as checksums or serial numbers
+// bound to the card it's on, so the game accepts it on the card with the given header. Returns
+// whether the save was changed.
+using SaveFixup =
+    std::function<bool(const Header& card_header, const DEntry& direntry, std::vector<GCMBlock>&)>;
+
+// Registers a fixup for every save of a title, matched on the first three characters of the
+// gamecode and on the makercode, so one registration covers all regions of a game. The built-in
+// fixups for F-Zero GX and Phantasy Star Online are always registered.
+void RegisterSaveFixup(std::string_view title, std::string_view makercode, SaveFixup fixup);
+
+// Runs every fixup registered for the save's title, in the order they were registered. Returns
+// how many of them changed the save.
+int ApplySaveFixups(const Header& card_header, const DEntry& direntry,
+                    std::vector<GCMBlock>& blocks);
+}  // namespace Memcard
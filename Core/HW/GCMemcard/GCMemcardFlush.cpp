@@ -0,0 +1,116 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/GCMemcard/GCMemcardFlush.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+
+#include "Core/Config/MainSettings.h"
+
+namespace Memcard
+{
+FlushPolicy FlushPolicy::FromConfig()
+{
+  FlushPolicy policy;
+  policy.coalesce_window =
+      std::chrono::milliseconds(std::max(Config::Get(Config::MAIN_MEMCARD_FLUSH_COALESCE_MS), 0));
+  policy.max_latency = std::chrono::milliseconds(
+      std::max(Config::Get(Config::MAIN_MEMCARD_FLUSH_MAX_LATENCY_MS), 0));
+  policy.flush_on_save_complete = Config::Get(Config::MAIN_MEMCARD_FLUSH_ON_SAVE_COMPLETE);
+  policy.fsync = Config::Get(Config::MAIN_MEMCARD_FLUSH_FSYNC);
+  return policy;
+}
+
+void FlushCounters::Record(u64 bytes, std::chrono::microseconds flush_time,
+                           std::chrono::microseconds lock_wait_time)
+{
+  m_flush_count.fetch_add(1, std::memory_order_relaxed);
+  m_bytes_flushed.fetch_add(bytes, std::memory_order_relaxed);
+  m_flush_time_us.fetch_add(flush_time.count(), std::memory_order_relaxed);
+  m_lock_wait_time_us.fetch_add(lock_wait_time.count(), std::memory_order_relaxed);
+}
+
+FlushStats FlushCounters::Get() const
+{
+  FlushStats stats;
+  stats.flush_count = m_flush_count.load(std::memory_order_relaxed);
+  stats.bytes_flushed = m_bytes_flushed.load(std::memory_order_relaxed);
+  stats.flush_time_us = m_flush_time_us.load(std::memory_order_relaxed);
+  stats.lock_wait_time_us = m_lock_wait_time_us.load(std::memory_order_relaxed);
+  return stats;
+}
+
+s64 FlushScheduler::Now()
+{
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+void FlushScheduler::NotifyWrite()
+{
+  const s64 now = Now();
+  m_last_write.store(now, std::memory_order_relaxed);
+
+  // Only the first write after a flush has to wake the flush thread up
+  if (!m_dirty.exchange(true, std::memory_order_acq_rel))
+  {
+    m_first_write.store(now, std::memory_order_relaxed);
+    m_trigger.Set();
+  }
+}
+
+void FlushScheduler::NotifySaveComplete()
+{
+  if (!m_policy.flush_on_save_complete)
+    return;
+
+  m_save_complete.Set();
+  m_trigger.Set();
+}
+
+void FlushScheduler::RequestExit()
+{
+  m_exiting.Set();
+  m_trigger.Set();
+}
+
+bool FlushScheduler::WaitForFlush()
+{
+  using Duration = std::chrono::steady_clock::duration;
+  const s64 coalesce_window =
+      std::chrono::duration_cast<Duration>(m_policy.coalesce_window).count();
+  const s64 max_latency = std::chrono::duration_cast<Duration>(m_policy.max_latency).count();
+
+  while (true)
+  {
+    if (m_exiting.IsSet())
+      return false;
+
+    if (!m_dirty.load(std::memory_order_acquire))
+    {
+      m_trigger.Wait();
+      continue;
+    }
+
+    if (m_save_complete.TestAndClear())
+      break;
+
+    // Flush once the game has gone quiet, or a write has waited as long as it may
+    const s64 deadline =
+        std::min(m_last_write.load(std::memory_order_relaxed) + coalesce_window,
+                 m_first_write.load(std::memory_order_relaxed) + max_latency);
+    const s64 now = Now();
+    if (now >= deadline)
+      break;
+
+    m_trigger.WaitFor(Duration(deadline - now));
+  }
+
+  // Writes from here on land after the flush's snapshot starts and begin a new window
+  m_dirty.store(false, std::memory_order_release);
+  return true;
+}
+}  // namespace Memcard
@@ -0,0 +1,91 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+
+#include "Core/HW/GCMemcard/GCMemcard.h"
+
+namespace Memcard
+{
+// When the memory card backends write their contents back to disk.
+struct FlushPolicy
+{
+  // How long the card has to go without writes before a flush.
+  std::chrono::milliseconds coalesce_window{1000};
+  // The longest a write waits to be flushed, even while the game keeps writing.
+  std::chrono::milliseconds max_latency{15000};
+  // Flush as soon as the game commits a save, instead of waiting out the coalescing window.
+  bool flush_on_save_complete = true;
+  // fsync flushed files, so a finished flush survives a crash of the host.
+  bool fsync = false;
+
+  static FlushPolicy FromConfig();
+};
+
+// Totals over the lifetime of a backend.
+struct FlushStats
+{
+  u64 flush_count = 0;
+  u64 bytes_flushed = 0;
+  u64 flush_time_us = 0;
+  u64 lock_wait_time_us = 0;
+};
+
+class FlushCounters
+{
+public:
+  void Record(u64 bytes, std::chrono::microseconds flush_time,
+              std::chrono::microseconds lock_wait_time);
+  FlushStats Get() const;
+
+private:
+  std::atomic<u64> m_flush_count{0};
+  std::atomic<u64> m_bytes_flushed{0};
+  std::atomic<u64> m_flush_time_us{0};
+  std::atomic<u64> m_lock_wait_time_us{0};
+};
+
+// Decides when a flush thread should write, from the writes the CPU thread reports to it.
+// Reporting a write never blocks on the flush thread.
+class FlushScheduler
+{
+public:
+  explicit FlushScheduler(const FlushPolicy& policy) : m_policy(policy) {}
+
+  void NotifyWrite();
+  void NotifySaveComplete();
+  void RequestExit();
+
+  // Blocks until a flush is due. Returns false once an exit was requested, after which the caller
+  // does its final flush and stops.
+  bool WaitForFlush();
+
+  const FlushPolicy& GetPolicy() const { return m_policy; }
+
+private:
+  static s64 Now();
+
+  FlushPolicy m_policy;
+  Common::Event m_trigger;
+  Common::Flag m_save_complete;
+  Common::Flag m_exiting;
+  std::atomic<bool> m_dirty{false};
+  // steady_clock ticks of the first write since the last flush, and of the latest one.
+  std::atomic<s64> m_first_write{0};
+  std::atomic<s64> m_last_write{0};
+};
+
+// Games commit a save by rewriting the directory and block allocation table, so a write that
+// finishes one of those blocks marks the end of a save.
+constexpr bool IsSaveCommitBlock(u32 block)
+{
+  return block >= 1 && block < MC_FST_BLOCKS;
+}
+}  // namespace Memcard
@@ -0,0 +1,99 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/GCMemcard/GCMemcard.h"
+
+namespace Memcard
+{
+// Kernels over the raw big-endian BAT map entries [begin, end).
+u16 CountNonzeroBatEntries(const BlockAlloc& bat, u16 begin, u16 end);
+// Whether every entry is 0 (free), 0xFFFF (last block of a file) or a block in
+// [MC_FST_BLOCKS, size_blocks).
+bool AreBatLinksInRange(const BlockAlloc& bat, u16 begin, u16 end, u32 size_blocks);
+
+// The size of a card that is one of the MBIT_SIZE_MEMORY_CARD_* sizes. Everything derived from it
+// is a constant, so loops bounded by it have a fixed trip count.
+template <u16 SizeMbits>
+struct FixedCardGeometry
+{
+  static_assert(SizeMbits > 0 && SizeMbits * MBIT_TO_BLOCKS <= MC_FST_BLOCKS + BAT_SIZE);
+
+  static constexpr u16 SizeMb() { return SizeMbits; }
+  static constexpr u32 SizeBlocks() { return SizeMbits * MBIT_TO_BLOCKS; }
+  static constexpr u16 DataBlocks() { return SizeMbits * MBIT_TO_BLOCKS - MC_FST_BLOCKS; }
+};
+
+// Any other size, for cards that were made with odd sizes. size_mbits has to be in (0, 256].
+struct RuntimeCardGeometry
+{
+  u16 size_mbits;
+
+  u16 SizeMb() const { return size_mbits; }
+  u32 SizeBlocks() const { return size_mbits * MBIT_TO_BLOCKS; }
+  u16 DataBlocks() const { return size_mbits * MBIT_TO_BLOCKS - MC_FST_BLOCKS; }
+};
+
+// Calls f with the geometry of a card of size_mbits, a FixedCardGeometry for the standard sizes and
+// a RuntimeCardGeometry otherwise. Branch on the size once and do the block math inside f.
+template <typename F>
+decltype(auto) VisitCardGeometry(u16 size_mbits, F&& f)
+{
+  switch (size_mbits)
+  {
+  case MBIT_SIZE_MEMORY_CARD_59:
+    return std::forward<F>(f)(FixedCardGeometry<MBIT_SIZE_MEMORY_CARD_59>{});
+  case MBIT_SIZE_MEMORY_CARD_123:
+    return std::forward<F>(f)(FixedCardGeometry<MBIT_SIZE_MEMORY_CARD_123>{});
+  case MBIT_SIZE_MEMORY_CARD_251:
+    return std::forward<F>(f)(FixedCardGeometry<MBIT_SIZE_MEMORY_CARD_251>{});
+  case MBIT_SIZE_MEMORY_CARD_507:
+    return std::forward<F>(f)(FixedCardGeometry<MBIT_SIZE_MEMORY_CARD_507>{});
+  case MBIT_SIZE_MEMORY_CARD_1019:
+    return std::forward<F>(f)(FixedCardGeometry<MBIT_SIZE_MEMORY_CARD_1019>{});
+  case MBIT_SIZE_MEMORY_CARD_2043:
+    return std::forward<F>(f)(FixedCardGeometry<MBIT_SIZE_MEMORY_CARD_2043>{});
+  default:
+    return std::forward<F>(f)(RuntimeCardGeometry{size_mbits});
+  }
+}
+
+// A BAT as seen on a card of the given geometry.
+template <typename Geometry>
+class BatView
+{
+public:
+  BatView(const BlockAlloc& bat, Geometry geometry) : m_bat(bat), m_geometry(geometry) {}
+
+  // Like BlockAlloc::GetNextBlock(), but only blocks that exist on this card have a next block.
+  u16 GetNextBlock(u16 block) const
+  {
+    if (block < MC_FST_BLOCKS || block >= m_geometry.SizeBlocks())
+      return 0;
+    return m_bat.m_map[block - MC_FST_BLOCKS];
+  }
+
+  u16 CountBlocksInUse() const { return CountNonzeroBatEntries(m_bat, 0, m_geometry.DataBlocks()); }
+
+  // Whether any of the entries past the end of the card, which map to nothing, are set.
+  bool HasDataInUnusedArea() const
+  {
+    return CountNonzeroBatEntries(m_bat, m_geometry.DataBlocks(), BAT_SIZE) != 0;
+  }
+
+  // Whether every block of the card links to nothing, to the end of a file or to another block of
+  // the card, in which case chains only have to be bounds-checked at their first block.
+  bool AreLinksInRange() const
+  {
+    return AreBatLinksInRange(m_bat, 0, m_geometry.DataBlocks(), m_geometry.SizeBlocks());
+  }
+
+private:
+  const BlockAlloc& m_bat;
+  Geometry m_geometry;
+};
+}  // namespace Memcard
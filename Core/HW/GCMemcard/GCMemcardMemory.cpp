@@ -0,0 +1,239 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/GCMemcard/GCMemcardMemory.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/Assert.h"
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/EnumMap.h"
+#include "Common/MappedFile.h"
+#include "Common/MsgHandler.h"
+
+#include "Core/HW/EXI/EXI.h"
+
+MemoryCardMemory::MemoryCardMemory(std::vector<u8> image, ExpansionInterface::Slot card_slot)
+    : MemoryCardBase(card_slot, static_cast<int>(image.size() / Memcard::BLOCK_SIZE /
+                                                 Memcard::MBIT_TO_BLOCKS)),
+      m_image(std::move(image)), m_data(m_image.data()), m_size(m_image.size())
+{
+  ASSERT(Memcard::IsValidCardImageSize(m_size));
+}
+
+MemoryCardMemory::MemoryCardMemory(File::MappedFile image, ExpansionInterface::Slot card_slot)
+    : MemoryCardBase(card_slot, static_cast<int>(image.GetSize() / Memcard::BLOCK_SIZE /
+                                                 Memcard::MBIT_TO_BLOCKS)),
+      m_mapped_image(std::move(image)), m_data(m_mapped_image.GetData()),
+      m_size(m_mapped_image.GetSize())
+{
+  ASSERT(m_mapped_image.GetMode() == File::MappedFile::Mode::CopyOnWrite);
+  ASSERT(Memcard::IsValidCardImageSize(m_size));
+}
+
+s32 MemoryCardMemory::Read(u32 src_address, s32 length, u8* dest_address)
+{
+  if (!IsAddressInBounds(src_address, length))
+  {
+    PanicAlertFmtT("MemoryCard: Read called with invalid source address ({0:#x})", src_address);
+    return -1;
+  }
+
+  memcpy(dest_address, &m_data[src_address], length);
+  return length;
+}
+
+s32 MemoryCardMemory::Write(u32 dest_address, s32 length, const u8* src_address)
+{
+  if (!IsAddressInBounds(dest_address, length))
+  {
+    PanicAlertFmtT("MemoryCard: Write called with invalid destination address ({0:#x})",
+                   dest_address);
+    return -1;
+  }
+
+  memcpy(&m_data[dest_address], src_address, length);
+  return length;
+}
+
+void MemoryCardMemory::ClearBlock(u32 address)
+{
+  if (address & (Memcard::BLOCK_SIZE - 1) || !IsAddressInBounds(address, Memcard::BLOCK_SIZE))
+  {
+    PanicAlertFmtT("MemoryCard: ClearBlock called on invalid address ({0:#x})", address);
+    return;
+  }
+
+  memset(&m_data[address], 0xFF, Memcard::BLOCK_SIZE);
+}
+
+void MemoryCardMemory::ClearAll()
+{
+  std::fill(m_data, m_data + m_size, 0xFF);
+}
+
+void MemoryCardMemory::DoState(PointerWrap& p)
+{
+  p.Do(m_card_slot);
+  u32 size = static_cast<u32>(m_size);
+  p.Do(size);
+  if (size != m_size)
+  {
+    // A state from a card of another size can't be loaded into this one.
+    p.SetMeasureMode();
+    return;
+  }
+
+  if (p.IsReadMode() && m_mapped_image.IsOpen())
+  {
+    // block by block, so that loading a state doesn't unshare the blocks it leaves alone
+    std::array<u8, Memcard::BLOCK_SIZE> block;
+    for (u32 address = 0; address < size; address += Memcard::BLOCK_SIZE)
+    {
+      p.DoArray(block.data(), Memcard::BLOCK_SIZE);
+      if (!p.IsReadMode())
+        return;
+      if (memcmp(&m_data[address], block.data(), Memcard::BLOCK_SIZE) != 0)
+        memcpy(&m_data[address], block.data(), Memcard::BLOCK_SIZE);
+    }
+    return;
+  }
+  p.DoArray(m_data, size);
+}
+
+bool MemoryCardMemory::SwapImage(std::vector<u8> image)
+{
+  if (image.size() != m_size)
+    return false;
+
+  if (m_mapped_image.IsOpen())
+  {
+    CopyChangedBlocks(image.data());
+    return true;
+  }
+
+  m_image = std::move(image);
+  m_data = m_image.data();
+  return true;
+}
+
+bool MemoryCardMemory::CopyImage(const std::vector<u8>& image)
+{
+  if (image.size() != m_size)
+    return false;
+
+  if (m_mapped_image.IsOpen())
+    CopyChangedBlocks(image.data());
+  else
+    m_image = image;
+  return true;
+}
+
+const std::vector<u8>& MemoryCardMemory::GetImage() const
+{
+  ASSERT(!m_mapped_image.IsOpen());
+  return m_image;
+}
+
+void MemoryCardMemory::CopyChangedBlocks(const u8* image)
+{
+  // writing an unchanged block would still give this process a private copy of its pages
+  for (size_t address = 0; address < m_size; address += Memcard::BLOCK_SIZE)
+  {
+    if (memcmp(&m_data[address], &image[address], Memcard::BLOCK_SIZE) != 0)
+      memcpy(&m_data[address], &image[address], Memcard::BLOCK_SIZE);
+  }
+}
+
+namespace Memcard
+{
+static std::mutex s_injected_images_mutex;
+static Common::EnumMap<std::shared_ptr<const std::vector<u8>>, ExpansionInterface::MAX_MEMCARD_SLOT>
+    s_injected_images;
+static Common::EnumMap<std::string, ExpansionInterface::MAX_MEMCARD_SLOT> s_injected_shared_images;
+
+std::vector<u8> GetCardImage(const GCMemcard& card)
+{
+  std::vector<u8> image(size_t(card.GetSizeBlocks()) * BLOCK_SIZE);
+  for (u32 i = 0; i < card.GetSizeBlocks(); ++i)
+    memcpy(&image[size_t(i) * BLOCK_SIZE], card.GetRawBlock(i), BLOCK_SIZE);
+  return image;
+}
+
+bool IsValidCardImageSize(size_t size)
+{
+  constexpr size_t mbit_size = MBIT_TO_BLOCKS * BLOCK_SIZE;
+  for (u16 size_mbits = MBIT_SIZE_MEMORY_CARD_59; size_mbits <= MBIT_SIZE_MEMORY_CARD_2043;
+       size_mbits *= 2)
+  {
+    if (size == size_mbits * mbit_size)
+      return true;
+  }
+  return false;
+}
+
+bool InjectCardImage(ExpansionInterface::Slot slot, std::vector<u8> image)
+{
+  ASSERT(ExpansionInterface::IsMemcardSlot(slot));
+  if (!IsValidCardImageSize(image.size()))
+    return false;
+
+  auto shared_image = std::make_shared<const std::vector<u8>>(std::move(image));
+  std::lock_guard lk(s_injected_images_mutex);
+  s_injected_images[slot] = std::move(shared_image);
+  s_injected_shared_images[slot].clear();
+  return true;
+}
+
+bool InjectSharedCardImage(ExpansionInterface::Slot slot, const std::string& name,
+                           std::vector<u8> image)
+{
+  ASSERT(ExpansionInterface::IsMemcardSlot(slot));
+  // only checks that the image is there and fits a slot, each device maps it for itself
+  File::MappedFile shared_image;
+  if (!shared_image.OpenSharedMemory(name, File::MappedFile::Mode::ReadOnly) ||
+      !IsValidCardImageSize(shared_image.GetSize()) ||
+      (!image.empty() && image.size() != shared_image.GetSize()))
+  {
+    return false;
+  }
+
+  std::shared_ptr<const std::vector<u8>> starting_image;
+  if (!image.empty())
+    starting_image = std::make_shared<const std::vector<u8>>(std::move(image));
+  std::lock_guard lk(s_injected_images_mutex);
+  s_injected_images[slot] = std::move(starting_image);
+  s_injected_shared_images[slot] = name;
+  return true;
+}
+
+void ClearInjectedCardImage(ExpansionInterface::Slot slot)
+{
+  ASSERT(ExpansionInterface::IsMemcardSlot(slot));
+  std::lock_guard lk(s_injected_images_mutex);
+  s_injected_images[slot].reset();
+  s_injected_shared_images[slot].clear();
+}
+
+std::shared_ptr<const std::vector<u8>> GetInjectedCardImage(ExpansionInterface::Slot slot)
+{
+  ASSERT(ExpansionInterface::IsMemcardSlot(slot));
+  std::lock_guard lk(s_injected_images_mutex);
+  return s_injected_images[slot];
+}
+
+std::string GetInjectedSharedCardImage(ExpansionInterface::Slot slot)
+{
+  ASSERT(ExpansionInterface::IsMemcardSlot(slot));
+  std::lock_guard lk(s_injected_images_mutex);
+  return s_injected_shared_images[slot];
+}
+}  // namespace Memcard
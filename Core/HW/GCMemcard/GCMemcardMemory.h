@@ -0,0 +1,91 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+
+#include "Core/HW/GCMemcard/GCMemcard.h"
+#include "Core/HW/GCMemcard/GCMemcardBase.h"
+
+class PointerWrap;
+
+// A memory card that only lives in memory. It never touches the filesystem and never flushes, so
+// whatever the game writes is gone once the card is destroyed unless it's read back with
+// GetImage() or GetData().
+class MemoryCardMemory : public MemoryCardBase
+{
+public:
+  MemoryCardMemory(std::vector<u8> image, ExpansionInterface::Slot card_slot);
+  // Runs from a copy-on-write mapping of a shared base image, such as one
+  // MappedFile::OpenSharedMemory() mapped, so only the pages the game writes cost this process
+  // memory.
+  MemoryCardMemory(File::MappedFile image, ExpansionInterface::Slot card_slot);
+
+  s32 Read(u32 src_address, s32 length, u8* dest_address) override;
+  s32 Write(u32 dest_address, s32 length, const u8* src_address) override;
+  void ClearBlock(u32 address) override;
+  void ClearAll() override;
+  void DoState(PointerWrap& p) override;
+
+  // Replaces the contents of the card with another image of the same size. Returns false and
+  // leaves the card alone if the sizes differ. A card running from a shared image keeps running
+  // from it and only takes the blocks that differ, so the rest of its pages stay shared.
+  bool SwapImage(std::vector<u8> image);
+  // Same as SwapImage(), but copies the image.
+  bool CopyImage(const std::vector<u8>& image);
+
+  // The contents of a card that doesn't run from a shared image. GetData() and GetSize() cover
+  // every card.
+  const std::vector<u8>& GetImage() const;
+  const u8* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+
+private:
+  bool IsAddressInBounds(u32 address, s32 length) const
+  {
+    return length >= 0 && address <= m_size && m_size - address >= u32(length);
+  }
+
+  // Copies the blocks of image that differ from the card, which has to be the same size.
+  void CopyChangedBlocks(const u8* image);
+
+  // The card lives in one of these, and m_data points at whichever it is
+  std::vector<u8> m_image;
+  File::MappedFile m_mapped_image;
+
+  u8* m_data;
+  size_t m_size;
+};
+
+namespace Memcard
+{
+// The raw image of a card, exactly as GCMemcard::Save() would write it.
+std::vector<u8> GetCardImage(const GCMemcard& card);
+
+// true if the image has the size of a card a memory card slot can hold
+bool IsValidCardImageSize(size_t size);
+
+// Hands a card image to the memory card in the given slot, which then runs from a
+// MemoryCardMemory instead of its file or GCI folder. This takes effect whenever the slot's device
+// is next created, so a new image can be injected between runs without touching the disk.
+bool InjectCardImage(ExpansionInterface::Slot slot, std::vector<u8> image);
+// Same as InjectCardImage(), but with an image published with File::SharedMemory under the given
+// name. Every process that injects it shares one copy of the blocks the game doesn't write. If
+// image isn't empty, the card starts out as image instead, which has to be the size of the shared
+// one, and only the blocks where the two differ aren't shared.
+bool InjectSharedCardImage(ExpansionInterface::Slot slot, const std::string& name,
+                           std::vector<u8> image = {});
+void ClearInjectedCardImage(ExpansionInterface::Slot slot);
+
+// The image injected into the slot, or nullptr if the slot uses its regular backend. With a shared
+// image injected too, this is what the card starts out as on top of it.
+std::shared_ptr<const std::vector<u8>> GetInjectedCardImage(ExpansionInterface::Slot slot);
+// The name of the shared image injected into the slot, or an empty string if there is none.
+std::string GetInjectedSharedCardImage(ExpansionInterface::Slot slot);
+}  // namespace Memcard
@@ -3,15 +3,20 @@
 
 #include "Core/HW/GCMemcard/GCMemcardRaw.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstring>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
+#include <xxhash.h>
 
 #include <fmt/format.h>
 
+#include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
@@ -30,13 +35,15 @@
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
 #include "Core/HW/Sram.h"
+#include "Core/State.h"
 
 #define SIZE_TO_Mb (1024 * 8 * 16)
 #define MC_HDR_SIZE 0xA000
 
 MemoryCard::MemoryCard(const std::string& filename, ExpansionInterface::Slot card_slot,
                        u16 size_mbits)
-    : MemoryCardBase(card_slot, size_mbits), m_filename(filename)
+    : MemoryCardBase(card_slot, size_mbits), m_filename(filename),
+      m_flush_scheduler(Memcard::FlushPolicy::FromConfig())
 {
   File::IOFile file(m_filename, "rb");
   if (file)
@@ -77,6 +84,13 @@ MemoryCard::MemoryCard(const std::string& filename, ExpansionInterface::Slot car
   // Class members (including inherited ones) have now been initialized, so
   // it's safe to startup the flush thread (which reads them).
   m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
+  m_block_count = (m_memory_card_size + Memcard::BLOCK_SIZE - 1) / Memcard::BLOCK_SIZE;
+  m_dirty_blocks = std::make_unique<std::atomic<u64>[]>((m_block_count + 63) / 64);
+  m_block_sequence = std::make_unique<std::atomic<u32>[]>(m_block_count);
+  m_base_data = std::make_unique<u8[]>(m_memory_card_size);
+  memcpy(&m_base_data[0], &m_memcard_data[0], m_memory_card_size);
+  m_base_hash = XXH64(&m_base_data[0], m_memory_card_size, 0);
+  m_modified_blocks.assign(m_block_count, false);
   m_flush_thread = std::thread(&MemoryCard::FlushThread, this);
 }
 
@@ -84,7 +98,7 @@ MemoryCard::~MemoryCard()
 {
   if (m_flush_thread.joinable())
   {
-    m_flush_trigger.Set();
+    m_flush_scheduler.RequestExit();
 
     m_flush_thread.join();
   }
@@ -98,26 +112,18 @@ void MemoryCard::FlushThread()
   }
 
   Common::SetCurrentThreadName(fmt::format("Memcard {} flushing thread", m_card_slot).c_str());
-
-  const auto flush_interval = std::chrono::seconds(15);
+  Common::PlaceCurrentThread(Common::ThreadRole::IO);
 
   while (true)
   {
-    // If triggered, we're exiting.
-    // If timed out, check if we need to flush.
-    bool do_exit = m_flush_trigger.WaitFor(flush_interval);
-    if (!do_exit)
-    {
-      bool is_dirty = m_dirty.TestAndClear();
-      if (!is_dirty)
-      {
-        continue;
-      }
-    }
+    // Once we're exiting, whatever is still dirty gets one last flush.
+    const bool do_exit = !m_flush_scheduler.WaitForFlush();
+    const auto flush_start = std::chrono::steady_clock::now();
 
     // Opening the file is purposefully done each iteration to ensure the
     // file doesn't disappear out from under us after the first check.
     File::IOFile file(m_filename, "r+b");
+    bool created = false;
 
     if (!file)
     {
@@ -128,6 +134,7 @@ void MemoryCard::FlushThread()
         File::CreateFullPath(dir);
       }
       file.Open(m_filename, "wb");
+      created = true;
     }
 
     // Note - file may have changed above, after ctor
@@ -145,11 +152,52 @@ void MemoryCard::FlushThread()
       return;
     }
 
+    // Only the blocks changed since the last flush are copied out and written back, unless the
+    // file doesn't hold the whole card yet. Each word of the dirty set is swapped for an empty
+    // one, so a write landing after that just marks its block again for the next flush.
+    const bool write_all = created || file.GetSize() != m_memory_card_size;
+    std::vector<std::pair<u32, u32>> runs;
+    for (u32 word = 0; word < (m_block_count + 63) / 64; ++word)
     {
-      std::unique_lock l(m_flush_mutex);
-      memcpy(&m_flush_buffer[0], &m_memcard_data[0], m_memory_card_size);
+      u64 bits = m_dirty_blocks[word].exchange(0, std::memory_order_acquire);
+      if (write_all)
+        bits = ~u64{0};
+
+      for (; bits != 0; bits &= bits - 1)
+      {
+        const u32 block = word * 64 + Common::LeastSignificantSetBit(bits);
+        if (block >= m_block_count)
+          break;
+
+        // A block written to during the copy was marked dirty again by that write, so it's
+        // simply left for the next flush.
+        if (!CopyBlockForFlush(block))
+          continue;
+
+        const u32 offset = block * Memcard::BLOCK_SIZE;
+        const u32 size = std::min(offset + Memcard::BLOCK_SIZE, m_memory_card_size) - offset;
+        if (!runs.empty() && runs.back().first + runs.back().second == offset)
+          runs.back().second += size;
+        else
+          runs.emplace_back(offset, size);
+      }
     }
-    file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
+    u64 bytes_flushed = 0;
+    for (const auto& [offset, size] : runs)
+    {
+      file.Seek(offset, File::SeekOrigin::Begin);
+      file.WriteBytes(&m_flush_buffer[offset], size);
+      bytes_flushed += size;
+    }
+    if (m_flush_scheduler.GetPolicy().fsync && !runs.empty())
+      file.Sync();
+
+    // Nothing is locked on this side, so there's never any lock wait to report
+    const auto flush_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - flush_start);
+    m_flush_counters.Record(bytes_flushed, flush_time, std::chrono::microseconds(0));
+    INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushed {} bytes of memory card {} in {} us", bytes_flushed,
+                 m_filename, flush_time.count());
 
     if (do_exit)
       return;
@@ -163,7 +211,7 @@ void MemoryCard::FlushThread()
 
 void MemoryCard::MakeDirty()
 {
-  m_dirty.Set();
+  m_flush_scheduler.NotifyWrite();
 }
 
 s32 MemoryCard::Read(u32 src_address, s32 length, u8* dest_address)
@@ -187,11 +235,17 @@ s32 MemoryCard::Write(u32 dest_address, s32 length, const u8* src_address)
     return -1;
   }
 
+  BeginBlockWrite(dest_address, length);
+  memcpy(&m_memcard_data[dest_address], src_address, length);
+  EndBlockWrite(dest_address, length);
+  MakeDirty();
+
+  const u32 end_address = dest_address + length;
+  if (end_address % Memcard::BLOCK_SIZE == 0 &&
+      Memcard::IsSaveCommitBlock(end_address / Memcard::BLOCK_SIZE - 1))
   {
-    std::unique_lock l(m_flush_mutex);
-    memcpy(&m_memcard_data[dest_address], src_address, length);
+    m_flush_scheduler.NotifySaveComplete();
   }
-  MakeDirty();
   return length;
 }
 
@@ -204,24 +258,156 @@ void MemoryCard::ClearBlock(u32 address)
   }
   else
   {
-    std::unique_lock l(m_flush_mutex);
+    BeginBlockWrite(address, Memcard::BLOCK_SIZE);
     memset(&m_memcard_data[address], 0xFF, Memcard::BLOCK_SIZE);
+    EndBlockWrite(address, Memcard::BLOCK_SIZE);
   }
   MakeDirty();
 }
 
 void MemoryCard::ClearAll()
 {
+  BeginBlockWrite(0, m_memory_card_size);
+  memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+  EndBlockWrite(0, m_memory_card_size);
+  MakeDirty();
+}
+
+std::pair<u32, u32> MemoryCard::GetBlockRange(u32 address, u32 length) const
+{
+  if (length == 0)
+    return {0, 0};
+
+  const u32 first = address / Memcard::BLOCK_SIZE;
+  const u32 last = (address + length - 1) / Memcard::BLOCK_SIZE;
+  return {first, std::min(last + 1, m_block_count)};
+}
+
+// The sequence numbers work like a seqlock: odd while a write is in progress, so the flush thread
+// can detect a torn copy and retry, without the CPU thread ever waiting on it.
+void MemoryCard::BeginBlockWrite(u32 address, u32 length)
+{
+  const auto [first, last] = GetBlockRange(address, length);
+  for (u32 block = first; block < last; ++block)
   {
-    std::unique_lock l(m_flush_mutex);
-    memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+    auto& sequence = m_block_sequence[block];
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+void MemoryCard::EndBlockWrite(u32 address, u32 length)
+{
+  const auto [first, last] = GetBlockRange(address, length);
+  for (u32 block = first; block < last; ++block)
+  {
+    auto& sequence = m_block_sequence[block];
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    m_dirty_blocks[block / 64].fetch_or(u64{1} << (block % 64), std::memory_order_release);
+    m_modified_blocks[block] = true;
   }
-  MakeDirty();
+}
+
+bool MemoryCard::CopyBlockForFlush(u32 block)
+{
+  const u32 offset = block * Memcard::BLOCK_SIZE;
+  const u32 size = std::min(offset + Memcard::BLOCK_SIZE, m_memory_card_size) - offset;
+  for (int attempt = 0; attempt < 4; ++attempt)
+  {
+    const u32 sequence = m_block_sequence[block].load(std::memory_order_acquire);
+    if ((sequence & 1) == 0)
+    {
+      memcpy(&m_flush_buffer[offset], &m_memcard_data[offset], size);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (m_block_sequence[block].load(std::memory_order_relaxed) == sequence)
+        return true;
+    }
+    std::this_thread::yield();
+  }
+  return false;
 }
 
 void MemoryCard::DoState(PointerWrap& p)
 {
   p.Do(m_card_slot);
-  p.Do(m_memory_card_size);
-  p.DoArray(&m_memcard_data[0], m_memory_card_size);
+
+  const auto do_block = [&](u32 block) {
+    const u32 offset = block * Memcard::BLOCK_SIZE;
+    p.DoArray(&m_memcard_data[offset], std::min(Memcard::BLOCK_SIZE, m_memory_card_size - offset));
+  };
+
+  u32 memory_card_size = m_memory_card_size;
+  u64 base_hash = m_base_hash;
+  // States in files can be loaded after the card has moved on, so they carry their own base image.
+  // States in buffers are only loaded in this session, while the base is still in memory.
+  bool has_base_image = !p.IsReadMode() && !State::IsSavingToBuffer();
+  std::vector<u32> blocks;
+  if (!p.IsReadMode())
+  {
+    for (u32 block = 0; block < m_block_count; ++block)
+    {
+      if (m_modified_blocks[block])
+        blocks.push_back(block);
+    }
+  }
+  p.Do(memory_card_size);
+  p.Do(base_hash);
+  p.Do(has_base_image);
+  if (memory_card_size != m_memory_card_size)
+  {
+    PanicAlertFmtT("The memory card in this savestate no longer matches memory card {0}.",
+                   m_filename);
+    p.SetMeasureMode();
+    return;
+  }
+
+  std::unique_ptr<u8[]> base_image;
+  if (has_base_image)
+  {
+    if (p.IsReadMode())
+      base_image = std::make_unique<u8[]>(m_memory_card_size);
+    p.DoArray(p.IsReadMode() ? &base_image[0] : &m_base_data[0], m_memory_card_size);
+  }
+  p.Do(blocks);
+
+  if (!p.IsReadMode())
+  {
+    for (u32 block : blocks)
+      do_block(block);
+    return;
+  }
+
+  if (base_image)
+  {
+    m_base_data = std::move(base_image);
+    m_base_hash = base_hash;
+  }
+  else if (base_hash != m_base_hash)
+  {
+    PanicAlertFmtT("The memory card in this savestate no longer matches memory card {0}.",
+                   m_filename);
+    p.SetMeasureMode();
+    return;
+  }
+
+  // A loaded state can differ from the file anywhere, so the next flush writes the whole card.
+  BeginBlockWrite(0, m_memory_card_size);
+  memcpy(&m_memcard_data[0], &m_base_data[0], m_memory_card_size);
+  for (u32 block : blocks)
+  {
+    if (block >= m_block_count)
+    {
+      p.SetMeasureMode();
+      break;
+    }
+    do_block(block);
+  }
+  EndBlockWrite(0, m_memory_card_size);
+
+  m_modified_blocks.assign(m_block_count, false);
+  for (u32 block : blocks)
+  {
+    if (block < m_block_count)
+      m_modified_blocks[block] = true;
+  }
 }
@@ -3,14 +3,18 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <thread>
-#include "Common/Event.h"
-#include "Common/Flag.h"
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
 #include "Core/HW/GCMemcard/GCMemcard.h"
 #include "Core/HW/GCMemcard/GCMemcardBase.h"
+#include "Core/HW/GCMemcard/GCMemcardFlush.h"
 
 class PointerWrap;
 
@@ -32,12 +36,31 @@ public:
 private:
   bool IsAddressInBounds(u32 address) const { return address <= (m_memory_card_size - 1); }
 
+  // The half-open range of blocks overlapping [address, address + length).
+  std::pair<u32, u32> GetBlockRange(u32 address, u32 length) const;
+
+  // Bracket every change to m_memcard_data, so the flush thread can tell whether a block it copied
+  // was written to meanwhile. Only the CPU thread changes the card, and it never has to wait.
+  void BeginBlockWrite(u32 address, u32 length);
+  void EndBlockWrite(u32 address, u32 length);
+
+  // Copies a block into m_flush_buffer, failing if the CPU thread wrote to it during the copy.
+  bool CopyBlockForFlush(u32 block);
+
   std::string m_filename;
   std::unique_ptr<u8[]> m_memcard_data;
   std::unique_ptr<u8[]> m_flush_buffer;
   std::thread m_flush_thread;
-  std::mutex m_flush_mutex;
-  Common::Event m_flush_trigger;
-  Common::Flag m_dirty;
+  // One bit per block, set when the block changed since it was last copied out for flushing.
+  std::unique_ptr<std::atomic<u64>[]> m_dirty_blocks;
+  // Per block, odd while the CPU thread is writing to it and bumped again once it's done.
+  std::unique_ptr<std::atomic<u32>[]> m_block_sequence;
+  u32 m_block_count;
+  // The card as loaded, and which blocks have been written to since. Savestates store the blocks
+  // modified since along with the hash of the base, and states saved to files the base itself.
+  std::unique_ptr<u8[]> m_base_data;
+  u64 m_base_hash;
+  std::vector<bool> m_modified_blocks;
+  Memcard::FlushScheduler m_flush_scheduler;
   u32 m_memory_card_size;
 };
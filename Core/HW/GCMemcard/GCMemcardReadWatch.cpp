@@ -0,0 +1,165 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/GCMemcard/GCMemcardReadWatch.h"
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+#include "Core/HW/EXI/EXI.h"
+#include "Core/PowerPC/BreakPoints.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace Memcard
+{
+namespace
+{
+// Keeps a memcheck around for the whole watch, so the JIT stays in watchpoint-compatible mode
+// while buffers come and go. Nothing the game uses lives on its page.
+constexpr u32 PLACEHOLDER_ADDRESS = 0xFFFFFFFF;
+
+struct WatchedBuffer
+{
+  // Effective address of the buffer's memcheck.
+  u32 start;
+  // Where on the card the buffer's current contents came from.
+  u32 card_address;
+};
+
+struct ReadWatch
+{
+  bool active = false;
+  ExpansionInterface::Slot slot{};
+  std::vector<bool> card_bytes;
+  std::vector<WatchedBuffer> buffers;
+};
+
+std::mutex s_mutex;
+ReadWatch s_watch;
+// Lets DMAs skip the lock while nothing is watched.
+std::atomic<bool> s_active{false};
+
+TMemCheck* FindCheck(const WatchedBuffer& buffer)
+{
+  TMemCheck* check = PowerPC::memchecks.GetMemCheck(buffer.start);
+  if (!check || !check->record_reads || check->start_address != buffer.start)
+    return nullptr;
+  return check;
+}
+
+// Moves what was read from the buffer over to the card bytes it holds.
+void Fold(const WatchedBuffer& buffer, const TMemCheck& check)
+{
+  for (size_t i = 0; i < check.read_bytes.size(); ++i)
+  {
+    const size_t card_offset = buffer.card_address + i;
+    if (check.read_bytes[i] && card_offset < s_watch.card_bytes.size())
+      s_watch.card_bytes[card_offset] = true;
+  }
+}
+}  // namespace
+
+void StartReadWatch(ExpansionInterface::Slot slot, u32 card_size)
+{
+  std::lock_guard lock(s_mutex);
+  s_watch.active = true;
+  s_watch.slot = slot;
+  s_watch.card_bytes.assign(card_size, false);
+  s_watch.buffers.clear();
+  s_active = true;
+
+  TMemCheck placeholder;
+  placeholder.start_address = PLACEHOLDER_ADDRESS;
+  placeholder.end_address = PLACEHOLDER_ADDRESS;
+  placeholder.is_enabled = false;
+  PowerPC::memchecks.Add(placeholder);
+}
+
+std::vector<bool> StopReadWatch()
+{
+  std::lock_guard lock(s_mutex);
+  for (const WatchedBuffer& buffer : s_watch.buffers)
+  {
+    if (const TMemCheck* check = FindCheck(buffer))
+    {
+      Fold(buffer, *check);
+      PowerPC::memchecks.Remove(buffer.start);
+    }
+  }
+  PowerPC::memchecks.Remove(PLACEHOLDER_ADDRESS);
+  s_watch.buffers.clear();
+  s_watch.active = false;
+  s_active = false;
+  return std::move(s_watch.card_bytes);
+}
+
+bool IsReadWatchActive()
+{
+  return s_active;
+}
+
+void NotifyDMARead(ExpansionInterface::Slot slot, u32 card_address, u32 ram_address, u32 size)
+{
+  if (!s_active)
+    return;
+
+  std::lock_guard lock(s_mutex);
+  if (!s_watch.active || slot != s_watch.slot || size == 0)
+    return;
+
+  // Games read DMA buffers through the cached mirror of RAM
+  const u32 start = 0x80000000 | ram_address;
+  const u32 end = start + size - 1;
+
+  // Games tend to reuse one buffer for every read, so what was read from a buffer is credited to
+  // the card bytes it held before it's overwritten
+  bool reused = false;
+  for (auto it = s_watch.buffers.begin(); it != s_watch.buffers.end();)
+  {
+    TMemCheck* check = FindCheck(*it);
+    if (!check || check->end_address < start || check->start_address > end)
+    {
+      ++it;
+      continue;
+    }
+
+    Fold(*it, *check);
+    if (it->start == start)
+    {
+      check->end_address = end;
+      check->is_ranged = start != end;
+      check->read_bytes.assign(size, false);
+      it->card_address = card_address;
+      reused = true;
+      ++it;
+    }
+    else
+    {
+      // The placeholder keeps this from clearing the JIT cache mid-block
+      PowerPC::memchecks.Remove(it->start);
+      it = s_watch.buffers.erase(it);
+    }
+  }
+
+  if (reused)
+  {
+    // The range may have changed, and with it the pages that have to stay out of fastmem
+    PowerPC::DBATUpdated();
+    return;
+  }
+
+  TMemCheck check;
+  check.start_address = start;
+  check.end_address = end;
+  check.is_ranged = start != end;
+  check.record_reads = true;
+  check.read_bytes.assign(size, false);
+  PowerPC::memchecks.Add(check);
+  s_watch.buffers.push_back({start, card_address});
+}
+}  // namespace Memcard
@@ -0,0 +1,33 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace ExpansionInterface
+{
+enum class Slot : int;
+}
+
+namespace Memcard
+{
+// Records which bytes of the card in a slot the game reads back out of RAM after DMAing them
+// there. Every DMA buffer gets a read recording memcheck; pages with a memcheck drop out of
+// fastmem, so only accesses to the buffers themselves take the slow path.
+//
+// Call StartReadWatch before booting, so the JIT compiles watchpoint-compatible code from the
+// start instead of having to flush while a DMA is in progress.
+void StartReadWatch(ExpansionInterface::Slot slot, u32 card_size);
+
+// Removes the memchecks and returns one entry per card byte, set for the ones the game read.
+// Call this with the core stopped or paused.
+std::vector<bool> StopReadWatch();
+
+bool IsReadWatchActive();
+
+// Called by the memory card device for every DMA read from the card into RAM.
+void NotifyDMARead(ExpansionInterface::Slot slot, u32 card_address, u32 ram_address, u32 size);
+}  // namespace Memcard
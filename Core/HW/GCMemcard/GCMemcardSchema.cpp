@@ -0,0 +1,247 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/GCMemcard/GCMemcardSchema.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+
+namespace Memcard
+{
+namespace
+{
+// The fields GCMemcard::FZEROGX_MakeSaveGameValid rewrites in f_zero.dat
+constexpr std::array F_ZERO_GX_FIELDS{
+    // 2 bytes at 0x0000: inverted CRC-16 of the rest of the first four blocks
+    SaveField{"checksum", 0x0000, 2},
+    // 2 bytes at 0x2060: low half of the first card serial
+    SaveField{"serial1_low", 0x2060, 2},
+    // 2 bytes at 0x2066: high half of the first card serial
+    SaveField{"serial1_high", 0x2066, 2},
+    // 2 bytes at 0x2200: low half of the second card serial
+    SaveField{"serial2_low", 0x2200, 2},
+    // 2 bytes at 0x7580: high half of the second card serial
+    SaveField{"serial2_high", 0x7580, 2},
+};
+
+// The fields GCMemcard::PSO_MakeSaveGameValid rewrites in the PSO_SYSTEM and PSO3_SYSTEM files
+constexpr std::array PSO_SYSTEM_FIELDS{
+    // 4 bytes at 0x2048: inverted CRC-32 of 0x204c to 0x2164, or to 0x2174 for PSO3
+    SaveField{"checksum", 0x2048, 4},
+    // 4 bytes at 0x2158: first card serial
+    SaveField{"serial1", 0x2158, 4},
+    // 4 bytes at 0x215c: second card serial
+    SaveField{"serial2", 0x215C, 4},
+};
+
+struct SchemaEntry
+{
+  std::array<u8, 3> title;
+  std::array<u8, 2> makercode;
+  std::string filename;
+  const SaveField* fields;
+  size_t count;
+};
+
+template <size_t N>
+std::array<u8, N> ToCode(std::string_view code)
+{
+  ASSERT(code.size() == N);
+  std::array<u8, N> result{};
+  std::copy_n(code.begin(), std::min(code.size(), N), result.begin());
+  return result;
+}
+
+SchemaEntry MakeEntry(std::string_view title, std::string_view makercode,
+                      std::string_view filename, const SaveField* fields, size_t count)
+{
+  return {ToCode<3>(title), ToCode<2>(makercode), std::string(filename), fields, count};
+}
+
+struct SchemaRegistry
+{
+  SchemaRegistry()
+  {
+    entries.push_back(MakeEntry("GFZ", "8P", "f_zero.dat", F_ZERO_GX_FIELDS.data(),
+                                F_ZERO_GX_FIELDS.size()));
+    for (std::string_view title : {"GPO", "GPS"})
+    {
+      for (std::string_view filename : {"PSO_SYSTEM", "PSO3_SYSTEM"})
+      {
+        entries.push_back(MakeEntry(title, "8P", filename, PSO_SYSTEM_FIELDS.data(),
+                                    PSO_SYSTEM_FIELDS.size()));
+      }
+    }
+  }
+
+  std::mutex mutex;
+  std::vector<SchemaEntry> entries;
+};
+
+SchemaRegistry& GetRegistry()
+{
+  static SchemaRegistry registry;
+  return registry;
+}
+
+bool Matches(const SchemaEntry& entry, const DEntry& direntry)
+{
+  if (!std::equal(entry.title.begin(), entry.title.end(), direntry.m_gamecode.begin()) ||
+      entry.makercode != direntry.m_makercode)
+  {
+    return false;
+  }
+  if (entry.filename.empty())
+    return true;
+
+  const char* filename = reinterpret_cast<const char*>(direntry.m_filename.data());
+  return std::string_view(filename, strnlen(filename, DENTRY_STRLEN)) == entry.filename;
+}
+
+// The byte length of the icon frames and palettes, see GCMemcard::ReadAnimRGBA8()
+u32 IconDataLength(const DEntry& direntry)
+{
+  const u16 icon_format = direntry.m_icon_format;
+  const u16 animation_speed = direntry.m_animation_speed;
+  if ((icon_format & 0b11) == 0)
+    return 0;
+
+  constexpr u32 pixels_per_frame = MEMORY_CARD_ICON_WIDTH * MEMORY_CARD_ICON_HEIGHT;
+  u32 length = 0;
+  bool has_shared_palette = false;
+  for (u32 i = 0; i < MEMORY_CARD_ICON_ANIMATION_MAX_FRAMES; ++i)
+  {
+    if (((animation_speed >> (2 * i)) & 0b11) == 0)
+      break;
+
+    const u8 format = (icon_format >> (2 * i)) & 0b11;
+    if (format == MEMORY_CARD_ICON_FORMAT_CI8_SHARED_PALETTE)
+    {
+      length += pixels_per_frame;
+      has_shared_palette = true;
+    }
+    else if (format == MEMORY_CARD_ICON_FORMAT_RGB5A3)
+    {
+      length += pixels_per_frame * 2;
+    }
+    else if (format == MEMORY_CARD_ICON_FORMAT_CI8_UNIQUE_PALETTE)
+    {
+      length += pixels_per_frame + 2 * MEMORY_CARD_CI8_PALETTE_ENTRIES;
+    }
+  }
+
+  if (has_shared_palette)
+    length += 2 * MEMORY_CARD_CI8_PALETTE_ENTRIES;
+  return length;
+}
+}  // namespace
+
+void RegisterSaveSchema(std::string_view title, std::string_view makercode,
+                        std::string_view filename, const SaveField* fields, size_t count)
+{
+  auto& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  registry.entries.push_back(MakeEntry(title, makercode, filename, fields, count));
+}
+
+SaveFieldMap::SaveFieldMap(const DEntry& direntry)
+{
+  const u32 block_count = direntry.m_block_count;
+  const u32 save_size = block_count * BLOCK_SIZE;
+  const auto add_field = [&](const SaveField& field) {
+    if (field.size != 0 && field.offset < save_size && field.size <= save_size - field.offset)
+      AddField(field);
+  };
+
+  {
+    auto& registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    for (const SchemaEntry& entry : registry.entries)
+    {
+      if (!Matches(entry, direntry))
+        continue;
+      for (size_t i = 0; i < entry.count; ++i)
+        add_field(entry.fields[i]);
+    }
+  }
+
+  // See the comment on m_banner_and_icon_flags for the banner formats
+  const u32 image_offset = direntry.m_image_offset;
+  if (image_offset != 0xFFFFFFFF)
+  {
+    constexpr u32 banner_pixels = MEMORY_CARD_BANNER_WIDTH * MEMORY_CARD_BANNER_HEIGHT;
+    const u8 banner_format = direntry.m_banner_and_icon_flags & 0b0000'0011;
+    u32 banner_size = 0;
+    if (banner_format == MEMORY_CARD_BANNER_FORMAT_CI8)
+      banner_size = banner_pixels + MEMORY_CARD_CI8_PALETTE_ENTRIES * 2;
+    else if (banner_format == MEMORY_CARD_BANNER_FORMAT_RGB5A3)
+      banner_size = banner_pixels * 2;
+
+    add_field({"banner", image_offset, banner_size});
+    add_field({"icons", image_offset + banner_size, IconDataLength(direntry)});
+  }
+
+  const u32 comments_address = direntry.m_comments_address;
+  if (comments_address != 0xFFFFFFFF)
+    add_field({"comments", comments_address, DENTRY_STRLEN * 2});
+
+  // Fields were kept sorted as they were added
+  m_first_field_of_block.resize(block_count);
+  u32 first = 0;
+  for (u32 block = 0; block < block_count; ++block)
+  {
+    while (first < m_fields.size() && m_fields[first].End() <= block * BLOCK_SIZE)
+      ++first;
+    m_first_field_of_block[block] = first;
+  }
+}
+
+void SaveFieldMap::AddField(const SaveField& field)
+{
+  const auto next = std::upper_bound(
+      m_fields.begin(), m_fields.end(), field.offset,
+      [](u32 offset, const SaveField& other) { return offset < other.offset; });
+  if (next != m_fields.end() && next->offset < field.End())
+    return;
+  if (next != m_fields.begin() && std::prev(next)->End() > field.offset)
+    return;
+
+  m_fields.insert(next, field);
+}
+
+size_t SaveFieldMap::FirstFieldEndingAfter(u32 offset) const
+{
+  const u32 block = offset / BLOCK_SIZE;
+  if (block >= m_first_field_of_block.size())
+    return m_fields.size();
+
+  size_t i = m_first_field_of_block[block];
+  while (i < m_fields.size() && m_fields[i].End() <= offset)
+    ++i;
+  return i;
+}
+
+const SaveField* SaveFieldMap::FindField(u32 offset) const
+{
+  const size_t i = FirstFieldEndingAfter(offset);
+  if (i == m_fields.size() || m_fields[i].offset > offset)
+    return nullptr;
+  return &m_fields[i];
+}
+
+const SaveField* SaveFieldMap::FindField(std::string_view name) const
+{
+  const auto it = std::find_if(m_fields.begin(), m_fields.end(),
+                               [name](const SaveField& field) { return field.name == name; });
+  return it != m_fields.end() ? &*it : nullptr;
+}
+}  // namespace Memcard
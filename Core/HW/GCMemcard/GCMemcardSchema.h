@@ -0,0 +1,90 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/GCMemcard/GCMemcard.h"
+
+namespace Memcard
+{
+// A named run of bytes in a save, at an offset from the start of its first block.
+struct SaveField
+{
+  std::string_view name;
+  u32 offset;
+  u32 size;
+
+  constexpr u32 End() const { return offset + size; }
+};
+
+// Registers the field layout of the saves of a title, matched on the first three characters of
+// the gamecode and on the makercode like the fixups are, and on the filename unless it's empty.
+// The fields must outlive every lookup, which a constexpr table does. The layouts of the integrity
+// fields of F-Zero GX and Phantasy Star Online are always registered.
+void RegisterSaveSchema(std::string_view title, std::string_view makercode,
+                        std::string_view filename, const SaveField* fields, size_t count);
+
+template <size_t N>
+void RegisterSaveSchema(std::string_view title, std::string_view makercode,
+                        std::string_view filename, const std::array<SaveField, N>& fields)
+{
+  RegisterSaveSchema(title, makercode, filename, fields.data(), N);
+}
+
+// The fields of one save: its banner, icons and comments as its directory entry describes them,
+// plus those of every schema registered for it. Registered fields win over the ones from the
+// directory entry, and a field that overlaps one already in the map is left out, so every byte
+// belongs to at most one field.
+class SaveFieldMap
+{
+public:
+  explicit SaveFieldMap(const DEntry& direntry);
+
+  // Sorted by offset.
+  const std::vector<SaveField>& GetFields() const { return m_fields; }
+  bool IsEmpty() const { return m_fields.empty(); }
+
+  const SaveField* FindField(u32 offset) const;
+  const SaveField* FindField(std::string_view name) const;
+
+  // Splits [start, end) at every field boundary and calls func(piece_start, piece_end, field) for
+  // every piece, in order, with the field it lies in or nullptr.
+  template <typename Func>
+  void ForEachPiece(u32 start, u32 end, Func&& func) const
+  {
+    size_t i = FirstFieldEndingAfter(start);
+    while (start < end)
+    {
+      if (i < m_fields.size() && m_fields[i].offset <= start)
+      {
+        const u32 piece_end = std::min(end, m_fields[i].End());
+        func(start, piece_end, &m_fields[i]);
+        start = piece_end;
+        ++i;
+      }
+      else
+      {
+        const u32 piece_end = i < m_fields.size() ? std::min(end, m_fields[i].offset) : end;
+        func(start, piece_end, static_cast<const SaveField*>(nullptr));
+        start = piece_end;
+      }
+    }
+  }
+
+private:
+  void AddField(const SaveField& field);
+  size_t FirstFieldEndingAfter(u32 offset) const;
+
+  std::vector<SaveField> m_fields;
+  // Index of the first field that ends after the start of each block, so looking up an offset
+  // only has to step over the fields of its own block
+  std::vector<u32> m_first_field_of_block;
+};
+}  // namespace Memcard
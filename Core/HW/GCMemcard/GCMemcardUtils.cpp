@@ -3,14 +3,25 @@
 
 #include "Core/HW/GCMemcard/GCMemcardUtils.h"
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/NandPaths.h"
+#include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "Core/HW/GCMemcard/GCMemcard.h"
 
@@ -359,4 +370,168 @@ size_t GetBlockCount(const std::vector<Savefile>& savefiles)
     block_count += savefile.blocks.size();
   return block_count;
 }
+
+static std::string GetStem(const std::string& path)
+{
+  std::string stem;
+  SplitPath(path, nullptr, &stem, nullptr);
+  return stem;
+}
+
+// The stem of every path, with " (2)", " (3)" and so on appended to stems an earlier path already
+// has, so that outputs named after them don't overwrite each other. Stems that only differ in
+// case count as the same, for case-insensitive filesystems.
+static std::vector<std::string> GetUniqueStems(const std::vector<std::string>& paths)
+{
+  std::vector<std::string> stems;
+  stems.reserve(paths.size());
+  std::unordered_set<std::string> taken;
+  for (const std::string& path : paths)
+  {
+    const std::string stem = GetStem(path);
+    std::string unique = stem;
+    for (int n = 2;; ++n)
+    {
+      std::string key = unique;
+      Common::ToLower(&key);
+      if (taken.insert(std::move(key)).second)
+        break;
+      unique = fmt::format("{} ({})", stem, n);
+    }
+    stems.push_back(std::move(unique));
+  }
+  return stems;
+}
+
+static std::string WithTrailingSlash(std::string path)
+{
+  if (!path.empty() && path.back() != '/')
+    path += '/';
+  return path;
+}
+
+// Runs process(i, results) for every input on the global thread pool, with no more than
+// max_in_flight inputs being worked on or waiting for a worker at once, and returns the results
+// of all inputs in order
+template <typename Process>
+static std::vector<BatchSavefileResult> RunBatch(size_t input_count,
+                                                 const BatchSavefileOptions& options,
+                                                 Process process)
+{
+  std::vector<std::vector<BatchSavefileResult>> results(input_count);
+  const size_t max_in_flight = std::max<size_t>(options.max_in_flight, 1);
+
+  std::mutex mutex;
+  std::condition_variable slot_freed;
+  size_t in_flight = 0;
+
+  {
+    Common::TaskGroup group;
+    for (size_t i = 0; i < input_count; ++i)
+    {
+      {
+        std::unique_lock lk(mutex);
+        slot_freed.wait(lk, [&] { return in_flight < max_in_flight; });
+        ++in_flight;
+      }
+
+      group.Submit([&, i] {
+        process(i, &results[i]);
+
+        std::lock_guard lk(mutex);
+        if (options.on_result)
+        {
+          for (const BatchSavefileResult& result : results[i])
+            options.on_result(result);
+        }
+        --in_flight;
+        slot_freed.notify_one();
+      });
+    }
+    group.Wait();
+  }
+
+  std::vector<BatchSavefileResult> flattened;
+  for (std::vector<BatchSavefileResult>& input_results : results)
+    std::move(input_results.begin(), input_results.end(), std::back_inserter(flattened));
+  return flattened;
+}
+
+std::vector<BatchSavefileResult> ConvertSavefiles(const std::vector<std::string>& inputs,
+                                                  const std::string& output_directory,
+                                                  const BatchSavefileOptions& options)
+{
+  const std::string directory = WithTrailingSlash(output_directory);
+  const std::vector<std::string> stems = GetUniqueStems(inputs);
+  File::CreateFullPath(directory);
+
+  return RunBatch(
+      inputs.size(), options, [&](size_t i, std::vector<BatchSavefileResult>* results) {
+        BatchSavefileResult& result = results->emplace_back();
+        result.input = inputs[i];
+
+        auto savefile = ReadSavefile(inputs[i]);
+        if (const auto* error = std::get_if<ReadSavefileErrorCode>(&savefile))
+        {
+          switch (*error)
+          {
+          case ReadSavefileErrorCode::OpenFileFail:
+            result.error = BatchSavefileErrorCode::OpenFileFail;
+            break;
+          case ReadSavefileErrorCode::IOError:
+            result.error = BatchSavefileErrorCode::IOError;
+            break;
+          case ReadSavefileErrorCode::DataCorrupted:
+            result.error = BatchSavefileErrorCode::DataCorrupted;
+            break;
+          }
+          return;
+        }
+
+        result.output = directory + stems[i] + GetDefaultExtension(options.format);
+        if (!WriteSavefile(result.output, std::get<Savefile>(savefile), options.format))
+          result.error = BatchSavefileErrorCode::WriteFail;
+      });
+}
+
+std::vector<BatchSavefileResult> ExportSavefiles(const std::vector<std::string>& cards,
+                                                 const std::string& output_directory,
+                                                 const BatchSavefileOptions& options)
+{
+  const std::string directory = WithTrailingSlash(output_directory);
+  const std::vector<std::string> stems = GetUniqueStems(cards);
+
+  return RunBatch(
+      cards.size(), options, [&](size_t i, std::vector<BatchSavefileResult>* results) {
+        // Only the blocks of the saves get read, one save at a time
+        auto [error, card] = GCMemcard::OpenMapped(cards[i]);
+        if (!card)
+        {
+          results->push_back({cards[i], {}, BatchSavefileErrorCode::OpenCardFail});
+          return;
+        }
+
+        const std::string card_directory = directory + stems[i] + '/';
+        File::CreateFullPath(card_directory);
+
+        for (u8 file_number = 0; file_number < card->GetNumFiles(); ++file_number)
+        {
+          BatchSavefileResult& result = results->emplace_back();
+          result.input = cards[i];
+
+          const std::optional<Savefile> savefile =
+              card->ExportFile(card->GetFileIndex(file_number));
+          if (!savefile)
+          {
+            result.error = BatchSavefileErrorCode::DataCorrupted;
+            continue;
+          }
+
+          result.output = card_directory + GenerateFilename(savefile->dir_entry) +
+                          GetDefaultExtension(options.format);
+          if (!WriteSavefile(result.output, *savefile, options.format))
+            result.error = BatchSavefileErrorCode::WriteFail;
+        }
+      });
+}
 }  // namespace Memcard
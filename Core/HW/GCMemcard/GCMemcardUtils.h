@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "Core/HW/GCMemcard/GCMemcard.h"
 
@@ -47,4 +50,48 @@ std::vector<Savefile> GetSavefiles(const GCMemcard& card, const std::vector<u8>&
 
 // Gets the total amount of blocks the given saves use.
 size_t GetBlockCount(const std::vector<Savefile>& savefiles);
+
+enum class BatchSavefileErrorCode
+{
+  Success,
+  OpenFileFail,
+  IOError,
+  DataCorrupted,
+  OpenCardFail,
+  WriteFail,
+};
+
+struct BatchSavefileResult
+{
+  // The savefile or card that was read
+  std::string input;
+  // The savefile that was written, if it got that far
+  std::string output;
+  BatchSavefileErrorCode error = BatchSavefileErrorCode::Success;
+};
+
+struct BatchSavefileOptions
+{
+  SavefileFormat format = SavefileFormat::GCI;
+  // Inputs that are read but whose output isn't written yet, which bounds the memory in use
+  size_t max_in_flight = 64;
+  // Called with every result as soon as it's known, from whichever thread produced it. Calls
+  // don't overlap.
+  std::function<void(const BatchSavefileResult&)> on_result;
+};
+
+// Converts savefiles to another format on the global thread pool. Every savefile is written to
+// output_directory under its own name, with the extension of the format. Inputs sharing a name
+// get " (2)", " (3)" and so on appended, in the order of the inputs. A file that fails doesn't
+// stop the others. Returns one result per input, in the order of the inputs.
+std::vector<BatchSavefileResult> ConvertSavefiles(const std::vector<std::string>& inputs,
+                                                  const std::string& output_directory,
+                                                  const BatchSavefileOptions& options);
+
+// Exports every save on each of the cards on the global thread pool, into a directory per card
+// named after the card, made unique the same way. Returns one result per save, grouped by card
+// in the order of the cards, and a single result for cards that couldn't be opened.
+std::vector<BatchSavefileResult> ExportSavefiles(const std::vector<std::string>& cards,
+                                                 const std::string& output_directory,
+                                                 const BatchSavefileOptions& options);
 }  // namespace Memcard
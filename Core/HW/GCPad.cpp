@@ -3,9 +3,16 @@
 
 #include "Core/HW/GCPad.h"
 
-#include <cstring>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
+#include "Common/BitUtils.h"
 #include "Common/Common.h"
+#include "Common/Flag.h"
+#include "Common/Thread.h"
 #include "Core/HW/GCPadEmu.h"
 #include "InputCommon/ControllerEmu/ControlGroup/ControlGroup.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
@@ -20,8 +27,86 @@ InputConfig* GetConfig()
   return &s_config;
 }
 
+namespace
+{
+using PadStatusArray = std::array<GCPadStatus, 4>;
+constexpr size_t SNAPSHOT_WORDS = sizeof(PadStatusArray) / sizeof(u64);
+static_assert(sizeof(PadStatusArray) % sizeof(u64) == 0);
+
+std::thread s_polling_thread;
+Common::Flag s_polling_thread_running;
+
+// The latest states from the polling thread behind a seqlock, so that reading them never blocks.
+// The sequence is odd while the polling thread writes.
+std::atomic<u32> s_snapshot_sequence{0};
+std::array<std::atomic<u64>, SNAPSHOT_WORDS> s_snapshot{};
+
+void PublishSnapshot(const PadStatusArray& pads)
+{
+  const auto words = Common::BitCast<std::array<u64, SNAPSHOT_WORDS>>(pads);
+
+  const u32 sequence = s_snapshot_sequence.load(std::memory_order_relaxed);
+  s_snapshot_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < SNAPSHOT_WORDS; ++i)
+    s_snapshot[i].store(words[i], std::memory_order_relaxed);
+  s_snapshot_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+GCPadStatus ReadSnapshot(int pad_num)
+{
+  std::array<u64, SNAPSHOT_WORDS> words;
+  while (true)
+  {
+    const u32 sequence = s_snapshot_sequence.load(std::memory_order_acquire);
+    for (size_t i = 0; i < SNAPSHOT_WORDS; ++i)
+      words[i] = s_snapshot[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if ((sequence & 1) == 0 && s_snapshot_sequence.load(std::memory_order_relaxed) == sequence)
+      break;
+
+    // The polling thread only writes for a moment, once per period
+    Common::YieldCPU();
+  }
+
+  return Common::BitCast<PadStatusArray>(words)[pad_num];
+}
+
+GCPadStatus PollStatus(int pad_num)
+{
+  return static_cast<GCPad*>(s_config.GetController(pad_num))->GetInput();
+}
+
+void PollingThread(u32 rate)
+{
+  Common::SetCurrentThreadName("Input polling thread");
+
+  // The states are what the game would otherwise have polled itself
+  ControllerInterface::SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
+
+  const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / rate));
+  auto next_poll = std::chrono::steady_clock::now();
+  while (s_polling_thread_running.IsSet())
+  {
+    g_controller_interface.UpdateInput();
+
+    PadStatusArray pads;
+    for (int i = 0; i < static_cast<int>(pads.size()); ++i)
+      pads[i] = PollStatus(i);
+    PublishSnapshot(pads);
+
+    // Don't try to catch up on polls that were missed
+    next_poll = std::max(next_poll + period, std::chrono::steady_clock::now());
+    std::this_thread::sleep_until(next_poll);
+  }
+}
+}  // namespace
+
 void Shutdown()
 {
+  StopPollingThread();
   s_config.UnregisterHotplugCallback();
 
   s_config.ClearControllers();
@@ -53,7 +138,10 @@ bool IsInitialized()
 
 GCPadStatus GetStatus(int pad_num)
 {
-  return static_cast<GCPad*>(s_config.GetController(pad_num))->GetInput();
+  if (s_polling_thread_running.IsSet())
+    return ReadSnapshot(pad_num);
+
+  return PollStatus(pad_num);
 }
 
 ControllerEmu::ControlGroup* GetGroup(int pad_num, PadGroup group)
@@ -75,4 +163,32 @@ bool GetMicButton(const int pad_num)
 {
   return static_cast<GCPad*>(s_config.GetController(pad_num))->GetMicButton();
 }
+
+void StartPollingThread(u32 rate)
+{
+  if (rate == 0 || s_polling_thread_running.IsSet())
+    return;
+
+  // Readers never see an empty snapshot
+  PadStatusArray pads;
+  for (int i = 0; i < static_cast<int>(pads.size()); ++i)
+    pads[i] = PollStatus(i);
+  PublishSnapshot(pads);
+
+  s_polling_thread_running.Set();
+  s_polling_thread = std::thread(PollingThread, rate);
+}
+
+void StopPollingThread()
+{
+  if (!s_polling_thread_running.TestAndClear())
+    return;
+
+  s_polling_thread.join();
+}
+
+bool IsPollingThreadRunning()
+{
+  return s_polling_thread_running.IsSet();
+}
 }  // namespace Pad
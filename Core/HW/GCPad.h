@@ -24,10 +24,17 @@ bool IsInitialized();
 
 InputConfig* GetConfig();
 
+// Returns the state from the polling thread while it runs.
 GCPadStatus GetStatus(int pad_num);
 ControllerEmu::ControlGroup* GetGroup(int pad_num, PadGroup group);
 void Rumble(int pad_num, ControlState strength);
 void ResetRumble(int pad_num);
 
 bool GetMicButton(int pad_num);
+
+// Polls the controllers rate times per second on a thread of its own, so that slow input backends
+// don't hold up the CPU thread. Does nothing if rate is 0.
+void StartPollingThread(u32 rate);
+void StopPollingThread();
+bool IsPollingThreadRunning();
 }  // namespace Pad
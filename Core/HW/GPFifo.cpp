@@ -3,6 +3,7 @@
 
 #include "Core/HW/GPFifo.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 
@@ -140,6 +141,23 @@ void Write64(const u64 value)
   CheckGatherPipe();
 }
 
+void WriteBurst(const u8* data, size_t size)
+{
+  while (size != 0)
+  {
+    // Bursting leaves less than GATHER_PIPE_SIZE bytes behind, so the rest of the extra space is
+    // free for the next chunk
+    if (GetGatherPipeCount() >= GATHER_PIPE_SIZE)
+      UpdateGatherPipe();
+    const size_t chunk_size = std::min<size_t>(size, GATHER_PIPE_EXTRA_SIZE - GATHER_PIPE_SIZE);
+    std::memcpy(PowerPC::ppcState.gather_pipe_ptr, data, chunk_size);
+    PowerPC::ppcState.gather_pipe_ptr += chunk_size;
+    data += chunk_size;
+    size -= chunk_size;
+  }
+  CheckGatherPipe();
+}
+
 void FastWrite8(const u8 value)
 {
   *PowerPC::ppcState.gather_pipe_ptr = value;
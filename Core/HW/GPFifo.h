@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -30,6 +32,10 @@ void Write16(u16 value);
 void Write32(u32 value);
 void Write64(u64 value);
 
+// Appends bytes that are already in guest order, such as a whole cache line, and checks the pipe
+// once at the end rather than after every word
+void WriteBurst(const u8* data, size_t size);
+
 // These expect pre-byteswapped values
 // Also there's an upper limit of about 512 per batch
 // Most likely these should be inlined into JIT instead
@@ -14,6 +14,7 @@
 #include <memory>
 #include <tuple>
 
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -48,9 +49,15 @@ namespace Memory
 u8* physical_base = nullptr;
 u8* logical_base = nullptr;
 static bool is_fastmem_arena_initialized = false;
+// Views of guest RAM that no longer see the segment the fastmem arena maps
+static bool s_ram_views_detached = false;
+static bool s_ram_snapshot_taken = false;
+static bool s_states_use_ram_snapshot = false;
 
 // The MemArena class
 static Common::MemArena g_arena;
+
+static constexpr size_t HUGE_PAGE_ALIGNMENT = 0x200000;
 // ==============
 
 // STATE_TO_SAVE
@@ -274,11 +281,14 @@ void Init()
     if (!fake_vmem && (region.flags & PhysicalMemoryRegion::FAKE_VMEM))
       continue;
 
+    // Starting every region on a huge page boundary lets huge pages back it from its start, and
+    // the gaps are never touched so they don't take any memory
+    mem_size = Common::AlignUp(mem_size, HUGE_PAGE_ALIGNMENT);
     region.shm_position = mem_size;
     region.active = true;
     mem_size += region.size;
   }
-  g_arena.GrabSHMSegment(mem_size);
+  g_arena.GrabSHMSegment(mem_size, Config::Get(Config::MAIN_HUGE_PAGES));
 
   // Create an anonymous view of the physical memory
   for (const PhysicalMemoryRegion& region : s_physical_regions)
@@ -312,6 +322,12 @@ bool InitFastmemArena()
 #else
   const size_t memory_size = 0x400000000;
 #endif
+  if (s_ram_views_detached)
+  {
+    WARN_LOG_FMT(MEMMAP, "Not using the fastmem arena, guest RAM has been snapshotted");
+    return false;
+  }
+
   physical_base = g_arena.ReserveMemoryRegion(memory_size);
 
   if (!physical_base)
@@ -432,6 +448,20 @@ void DoState(PointerWrap& p)
     return;
   }
 
+  if (s_states_use_ram_snapshot)
+  {
+    if (p.IsReadMode())
+    {
+      for (const PhysicalMemoryRegion& region : s_physical_regions)
+      {
+        if (region.active)
+          g_arena.ResetView(*region.out_pointer, region.shm_position, region.size);
+      }
+    }
+    p.DoMarker("Memory RAM snapshot");
+    return;
+  }
+
   p.DoArray(m_pRAM, current_ram_size);
   p.DoArray(m_pL1Cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
@@ -443,6 +473,37 @@ void DoState(PointerWrap& p)
   p.DoMarker("Memory EXRAM");
 }
 
+bool TakeRAMSnapshot()
+{
+  s_ram_snapshot_taken = false;
+  if (is_fastmem_arena_initialized)
+  {
+    WARN_LOG_FMT(MEMMAP, "Can't snapshot guest RAM while the fastmem arena is in use");
+    return false;
+  }
+
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (!region.active)
+      continue;
+
+    // Even if this fails, regions detached before this one have to stay out of the fastmem arena
+    const bool detached =
+        g_arena.DetachView(*region.out_pointer, region.shm_position, region.size);
+    s_ram_views_detached |= detached;
+    if (!detached)
+      return false;
+  }
+
+  s_ram_snapshot_taken = true;
+  return true;
+}
+
+void SetStatesUseRAMSnapshot(bool enabled)
+{
+  s_states_use_ram_snapshot = enabled && s_ram_snapshot_taken;
+}
+
 void Shutdown()
 {
   ShutdownFastmemArena();
@@ -457,6 +518,9 @@ void Shutdown()
     *region.out_pointer = nullptr;
   }
   g_arena.ReleaseSHMSegment();
+  s_ram_views_detached = false;
+  s_ram_snapshot_taken = false;
+  s_states_use_ram_snapshot = false;
   mmio_mapping.reset();
   INFO_LOG_FMT(MEMMAP, "Memory system shut down.");
 }
@@ -66,6 +66,14 @@ bool InitFastmemArena();
 void ShutdownFastmemArena();
 void DoState(PointerWrap& p);
 
+// Keeps what guest RAM holds now, so that loading a state while SetStatesUseRAMSnapshot() is
+// enabled brings it back at a cost that only depends on how much RAM was written in between.
+// The fastmem arena maps the same memory as the snapshot's views, so this fails once it's in use
+// and the fastmem arena can't be set up afterwards.
+bool TakeRAMSnapshot();
+// While enabled, states leave guest RAM out, and loading one brings RAM back to the snapshot.
+void SetStatesUseRAMSnapshot(bool enabled);
+
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
 void Clear();
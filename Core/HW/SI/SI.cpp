@@ -19,6 +19,7 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
+#include "Core/HW/GCPad.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI_DeviceGBA.h"
@@ -395,6 +396,8 @@ void Init()
 {
   RegisterEvents();
 
+  Pad::StartPollingThread(Config::Get(Config::MAIN_INPUT_POLLING_RATE));
+
   for (int i = 0; i < MAX_SI_CHANNELS; i++)
   {
     s_channel[i].out.hex = 0;
@@ -447,6 +450,7 @@ void Init()
 
 void Shutdown()
 {
+  Pad::StopPollingThread();
   for (int i = 0; i < MAX_SI_CHANNELS; i++)
     RemoveDevice(i);
   GBAConnectionWaiter_Shutdown();
@@ -677,8 +681,10 @@ void UpdateDevices()
 
   // Update inputs at the rate of SI
   // Typically 120hz but is variable
+  // The polling thread does this at its own rate, if it runs
   g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
-  g_controller_interface.UpdateInput();
+  if (!Pad::IsPollingThreadRunning())
+    g_controller_interface.UpdateInput();
 
   // Update channels and set the status bit if there's new data
   s_status_reg.RDST0 =
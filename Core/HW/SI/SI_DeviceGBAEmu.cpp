@@ -3,12 +3,14 @@
 
 #include "Core/HW/SI/SI_DeviceGBAEmu.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/GBACore.h"
@@ -17,23 +19,37 @@
 #include "Core/HW/SI/SI_DeviceGCController.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
 #include "Core/NetPlayProto.h"
 
 namespace SerialInterface
 {
+constexpr int DEFAULT_SYNC_WINDOW_US = 1000;
+constexpr int MIN_SYNC_WINDOW_US = 100;
+constexpr int MAX_SYNC_WINDOW_US = 20000;
+
+// The GBA cores are only brought up to the emulated time this often between transfers, since
+// they catch up on their own when a transfer arrives. Where they stop in between still changes
+// their timing slightly, so NetPlay and movies always stop them at the same points.
 static s64 GetSyncInterval()
 {
-  return SystemTimers::GetTicksPerSecond() / 1000;
+  int window_us = DEFAULT_SYNC_WINDOW_US;
+  if (!NetPlay::IsNetPlayRunning() && !Movie::IsMovieActive())
+  {
+    window_us = std::clamp(Config::Get(Config::MAIN_GBA_SYNC_WINDOW), MIN_SYNC_WINDOW_US,
+                           MAX_SYNC_WINDOW_US);
+  }
+  return SystemTimers::GetTicksPerSecond() * window_us / 1000000;
 }
 
 CSIDevice_GBAEmu::CSIDevice_GBAEmu(SIDevices device, int device_number)
-    : ISIDevice(device, device_number)
+    : ISIDevice(device, device_number), m_sync_interval(GetSyncInterval())
 {
   m_core = std::make_shared<HW::GBA::Core>(m_device_number);
   m_core->Start(CoreTiming::GetTicks());
   m_gbahost = Host_CreateGBAHost(m_core);
   m_core->SetHost(m_gbahost);
-  ScheduleEvent(m_device_number, GetSyncInterval());
+  ScheduleEvent(m_device_number, m_sync_interval);
 }
 
 CSIDevice_GBAEmu::~CSIDevice_GBAEmu()
@@ -59,7 +75,7 @@ int CSIDevice_GBAEmu::RunBuffer(u8* buffer, int request_length)
     m_core->SendJoybusCommand(m_timestamp_sent, TransferInterval(), buffer, m_keys);
 
     RemoveEvent(m_device_number);
-    ScheduleEvent(m_device_number, TransferInterval() + GetSyncInterval());
+    ScheduleEvent(m_device_number, TransferInterval() + m_sync_interval);
     for (int i = 0; i < MAX_SI_CHANNELS; ++i)
     {
       if (i == m_device_number || SerialInterface::GetDeviceType(i) != GetDeviceType())
@@ -163,6 +179,6 @@ void CSIDevice_GBAEmu::DoState(PointerWrap& p)
 void CSIDevice_GBAEmu::OnEvent(u64 userdata, s64 cycles_late)
 {
   m_core->SendJoybusCommand(CoreTiming::GetTicks() + userdata, 0, nullptr, m_keys);
-  ScheduleEvent(m_device_number, userdata + GetSyncInterval());
+  ScheduleEvent(m_device_number, userdata + m_sync_interval);
 }
 }  // namespace SerialInterface
@@ -42,6 +42,7 @@ private:
   EBufferCommands m_last_cmd{};
   u64 m_timestamp_sent = 0;
   u16 m_keys = 0;
+  const s64 m_sync_interval;
 
   std::shared_ptr<HW::GBA::Core> m_core;
   std::shared_ptr<GBAHostInterface> m_gbahost;
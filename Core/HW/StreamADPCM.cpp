@@ -6,41 +6,40 @@
 #include "Core/HW/StreamADPCM.h"
 
 #include <algorithm>
+#include <array>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 
 namespace StreamADPCM
 {
-static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+// Decodes one channel of a block. Its header byte picks the filter and the shift for all of the
+// block's samples, which sit in the low or the high nibbles of the data bytes.
+static void DecodeChannel(s16* pcm, const u8* data, u32 nibble_shift, u8 header, s32& hist1,
+                          s32& hist2)
 {
-  s32 hist = 0;
-  switch (q >> 4)
-  {
-  case 0:
-    hist = 0;
-    break;
-  case 1:
-    hist = (hist1 * 0x3c);
-    break;
-  case 2:
-    hist = (hist1 * 0x73) - (hist2 * 0x34);
-    break;
-  case 3:
-    hist = (hist1 * 0x62) - (hist2 * 0x37);
-    break;
-  }
-  hist = std::clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
+  // Filters past the fourth don't predict anything
+  static constexpr std::array<std::array<s32, 2>, 16> filters = {
+      {{0, 0}, {0x3c, 0}, {0x73, -0x34}, {0x62, -0x37}}};
+  const s32 coef1 = filters[header >> 4][0];
+  const s32 coef2 = filters[header >> 4][1];
+  const u32 shift = header & 0xf;
 
-  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
-
-  hist2 = hist1;
-  hist1 = cur;
+  s32 h1 = hist1;
+  s32 h2 = hist2;
+  for (u32 i = 0; i < SAMPLES_PER_BLOCK; i++)
+  {
+    const s32 bits = (data[i] >> nibble_shift) & 0xf;
+    const s32 hist = std::clamp((h1 * coef1 + h2 * coef2 + 0x20) >> 6, -0x200000, 0x1fffff);
+    const s32 cur = (((s16)(bits << 12) >> shift) << 6) + hist;
 
-  cur >>= 6;
-  cur = std::clamp(cur, -0x8000, 0x7fff);
+    h2 = h1;
+    h1 = cur;
 
-  return (s16)cur;
+    pcm[i * 2] = (s16)std::clamp(cur >> 6, -0x8000, 0x7fff);
+  }
+  hist1 = h1;
+  hist2 = h2;
 }
 
 void ADPCMDecoder::ResetFilter()
@@ -61,12 +60,8 @@ void ADPCMDecoder::DoState(PointerWrap& p)
 
 void ADPCMDecoder::DecodeBlock(s16* pcm, const u8* adpcm)
 {
-  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
-  {
-    pcm[i * 2] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf, adpcm[0],
-                                 m_histl1, m_histl2);
-    pcm[i * 2 + 1] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4, adpcm[1],
-                                     m_histr1, m_histr2);
-  }
+  const u8* data = adpcm + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK);
+  DecodeChannel(pcm, data, 0, adpcm[0], m_histl1, m_histl2);
+  DecodeChannel(pcm + 1, data, 4, adpcm[1], m_histr1, m_histr2);
 }
 }  // namespace StreamADPCM
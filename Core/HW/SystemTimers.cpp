@@ -44,9 +44,13 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 
 #include "Core/HW/SystemTimers.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cfloat>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <thread>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -65,6 +69,7 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameRecords.h"
 
 namespace SystemTimers
 {
@@ -98,6 +103,14 @@ std::mutex s_emu_to_real_time_mutex;
 // at initialization (or ever), since only the "derivative" of that value really matters.
 u64 s_time_spent_sleeping;
 
+// Read every emulated millisecond
+Config::CachedInfo<float> s_emulation_speed{Config::MAIN_EMULATION_SPEED};
+Config::CachedInfo<int> s_timing_variance{Config::MAIN_TIMING_VARIANCE};
+Config::CachedInfo<int> s_throttle_spin_budget{Config::MAIN_THROTTLE_SPIN_BUDGET};
+
+// Written by the CPU thread, read by the renderer for the statistics
+std::array<std::atomic<u64>, PACING_ERROR_LIMITS_US.size() + 1> s_pacing_errors;
+
 // DSP/CPU timeslicing.
 void DSPCallback(u64 userdata, s64 cyclesLate)
 {
@@ -165,6 +178,29 @@ void PatchEngineCallback(u64 userdata, s64 cycles_late)
   CoreTiming::ScheduleEvent(next_schedule, et_PatchEngine, cycles_pruned);
 }
 
+// Sleeps overshoot by up to a millisecond or so depending on the host, so with a spin budget the
+// sleep ends that much early and the rest is spent spinning on the clock
+void WaitUntil(u64 deadline, u64 now, u64 spin_budget)
+{
+  if (spin_budget == 0)
+  {
+    Common::SleepCurrentThread(static_cast<int>((deadline - now) / 1000));
+    return;
+  }
+
+  if (deadline > now + spin_budget)
+    std::this_thread::sleep_for(std::chrono::microseconds(deadline - now - spin_budget));
+  while (Common::Timer::GetTimeUs() < deadline)
+    Common::YieldCPU();
+}
+
+void RecordPacingError(u64 error)
+{
+  const auto it = std::lower_bound(PACING_ERROR_LIMITS_US.begin(), PACING_ERROR_LIMITS_US.end(),
+                                   std::min<u64>(error, UINT32_MAX));
+  s_pacing_errors[it - PACING_ERROR_LIMITS_US.begin()].fetch_add(1, std::memory_order_relaxed);
+}
+
 void ThrottleCallback(u64 last_time, s64 cyclesLate)
 {
   // Allow the GPU thread to sleep. Setting this flag here limits the wakeups to 1 kHz.
@@ -173,8 +209,9 @@ void ThrottleCallback(u64 last_time, s64 cyclesLate)
   u64 time = Common::Timer::GetTimeUs();
 
   s64 diff = last_time - time;
-  const float emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
+  const float emulation_speed = s_emulation_speed.Get();
   bool frame_limiter = emulation_speed > 0.0f && !Core::GetIsThrottlerTempDisabled();
+  const u64 spin_budget = static_cast<u64>(std::max(s_throttle_spin_budget.Get(), 0));
   u32 next_event = GetTicksPerSecond() / 1000;
 
   {
@@ -188,17 +225,20 @@ void ThrottleCallback(u64 last_time, s64 cyclesLate)
   {
     if (emulation_speed != 1.0f)
       next_event = u32(next_event * emulation_speed);
-    const s64 max_fallback = Config::Get(Config::MAIN_TIMING_VARIANCE) * 1000;
+    const s64 max_fallback = s_timing_variance.Get() * 1000;
     if (std::abs(diff) > max_fallback)
     {
       DEBUG_LOG_FMT(COMMON, "system too {}, {} ms skipped", diff < 0 ? "slow" : "fast",
                     std::abs(diff) - max_fallback);
       last_time = time - max_fallback;
     }
-    else if (diff > 1000)
+    else if (diff > 1000 || (spin_budget != 0 && diff > 0))
     {
-      Common::SleepCurrentThread(diff / 1000);
-      s_time_spent_sleeping += Common::Timer::GetTimeUs() - time;
+      FrameRecords::ScopedCPUWait wait;
+      WaitUntil(last_time, time, spin_budget);
+      const u64 woke_up = Common::Timer::GetTimeUs();
+      RecordPacingError(woke_up > last_time ? woke_up - last_time : last_time - woke_up);
+      s_time_spent_sleeping += woke_up - time;
     }
   }
   CoreTiming::ScheduleEvent(next_event - cyclesLate, et_Throttle, last_time + 1000);
@@ -247,6 +287,14 @@ s64 GetLocalTimeRTCOffset()
   return s_localtime_rtc_offset;
 }
 
+PacingErrorHistogram GetPacingErrorHistogram()
+{
+  PacingErrorHistogram histogram;
+  for (size_t i = 0; i < histogram.size(); ++i)
+    histogram[i] = s_pacing_errors[i].load(std::memory_order_relaxed);
+  return histogram;
+}
+
 double GetEstimatedEmulationPerformance()
 {
   u64 ts_now, ts_before;  // In microseconds
@@ -301,6 +349,8 @@ void Init()
   }
 
   Common::Timer::IncreaseResolution();
+  for (std::atomic<u64>& count : s_pacing_errors)
+    count.store(0, std::memory_order_relaxed);
   // store and convert localtime at boot to timebase ticks
   if (Config::Get(Config::MAIN_CUSTOM_RTC_ENABLE))
   {
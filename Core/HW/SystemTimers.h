@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 
 namespace SystemTimers
@@ -70,6 +72,12 @@ s64 GetLocalTimeRTCOffset();
 // - 2.0: the emulator is running at 200% speed (or 100% speed but sleeping half of the time).
 double GetEstimatedEmulationPerformance();
 
+// How far off the throttle woke up from the times it waited for. Each bucket counts the wakeups
+// that were off by at most its limit, and the last one counts the rest.
+constexpr std::array<u32, 6> PACING_ERROR_LIMITS_US{50, 100, 250, 500, 1000, 2000};
+using PacingErrorHistogram = std::array<u64, PACING_ERROR_LIMITS_US.size() + 1>;
+PacingErrorHistogram GetPacingErrorHistogram();
+
 }  // namespace SystemTimers
 
 inline namespace SystemTimersLiterals
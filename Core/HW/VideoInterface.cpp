@@ -64,6 +64,11 @@ static double s_target_refresh_rate = 0;
 static u32 s_target_refresh_rate_numerator = 0;
 static u32 s_target_refresh_rate_denominator = 1;
 
+// Read on every field and SI poll
+static Config::CachedInfo<bool> s_early_xfb_output{Config::GFX_HACK_EARLY_XFB_OUTPUT};
+static Config::CachedInfo<bool> s_background_input{Config::MAIN_INPUT_BACKGROUND_INPUT};
+static Config::CachedInfo<bool> s_lock_cursor{Config::MAIN_LOCK_CURSOR};
+
 static constexpr std::array<u32, 2> s_clock_freqs{{
     27000000,
     54000000,
@@ -823,7 +828,7 @@ static void BeginField(FieldType field, u64 ticks)
 {
   // Outputting the frame at the beginning of scanout reduces latency. This assumes the game isn't
   // going to change the VI registers while a frame is scanning out.
-  if (Config::Get(Config::GFX_HACK_EARLY_XFB_OUTPUT))
+  if (s_early_xfb_output.Get())
     OutputField(field, ticks);
 }
 
@@ -833,7 +838,7 @@ static void EndField(FieldType field, u64 ticks)
   // until the end so the last register values are used. This still isn't accurate, but it does
   // produce more acceptable results in some problematic cases.
   // Currently, this is only known to be necessary to eliminate flickering in WWE Crush Hour.
-  if (!Config::Get(Config::GFX_HACK_EARLY_XFB_OUTPUT))
+  if (!s_early_xfb_output.Get())
     OutputField(field, ticks);
 
   Core::VideoThrottle();
@@ -881,8 +886,7 @@ void Update(u64 ticks)
 
   if (s_half_line_of_next_si_poll == s_half_line_count)
   {
-    Core::UpdateInputGate(!Config::Get(Config::MAIN_INPUT_BACKGROUND_INPUT),
-                          Config::Get(Config::MAIN_LOCK_CURSOR));
+    Core::UpdateInputGate(!s_background_input.Get(), s_lock_cursor.Get());
     SerialInterface::UpdateDevices();
     s_half_line_of_next_si_poll += 2 * SerialInterface::GetPollXLines();
   }
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <mbedtls/md5.h>
@@ -32,6 +33,7 @@
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 #include "Core/CommonTitles.h"
 #include "Core/HW/WiiSaveStructs.h"
 #include "Core/IOS/ES/ES.h"
@@ -386,9 +388,16 @@ public:
 
   bool WriteFiles(const std::vector<SaveFile>& files) override
   {
-    if (!m_file.Seek(sizeof(Header) + sizeof(BkHeader), File::SeekOrigin::Begin))
+    // The signature covers the bk header and the files. They are hashed as they are written, so
+    // that they don't need to be read back afterwards.
+    const std::optional<BkHeader> bk_header = ReadBkHeader();
+    if (!bk_header || !m_file.Seek(sizeof(Header) + sizeof(BkHeader), File::SeekOrigin::Begin))
       return false;
 
+    DataHasher hasher(bk_header->size_of_files + sizeof(BkHeader));
+    hasher.Update(&*bk_header, sizeof(BkHeader));
+
+    std::vector<u8> encrypted_chunk;
     for (const SaveFile& save_file : files)
     {
       FileHDR file_hdr{};
@@ -411,19 +420,29 @@ public:
 
       if (!m_file.WriteArray(&file_hdr, 1))
         return false;
+      hasher.Update(&file_hdr, sizeof(file_hdr));
 
       if (data)
       {
-        std::vector<u8> file_data_enc(Common::AlignUp(data->size(), BLOCK_SZ));
-        std::copy(data->cbegin(), data->cend(), file_data_enc.begin());
-        m_iosc.Encrypt(IOS::HLE::IOSC::HANDLE_SD_KEY, file_hdr.iv.data(), file_data_enc.data(),
-                       file_data_enc.size(), file_data_enc.data(), IOS::PID_ES);
-        if (!m_file.WriteBytes(file_data_enc.data(), file_data_enc.size()))
-          return false;
+        // The file header must be written with the initial IV, which Encrypt updates
+        std::array<u8, 0x10> iv = file_hdr.iv;
+        const size_t encrypted_size = Common::AlignUp(data->size(), BLOCK_SZ);
+        for (size_t offset = 0; offset < encrypted_size; offset += ENCRYPTION_CHUNK_SIZE)
+        {
+          const size_t chunk_size = std::min(ENCRYPTION_CHUNK_SIZE, encrypted_size - offset);
+          const size_t data_size = std::min(chunk_size, data->size() - offset);
+          encrypted_chunk.assign(data->begin() + offset, data->begin() + offset + data_size);
+          encrypted_chunk.resize(chunk_size);
+          m_iosc.Encrypt(IOS::HLE::IOSC::HANDLE_SD_KEY, iv.data(), encrypted_chunk.data(),
+                         chunk_size, encrypted_chunk.data(), IOS::PID_ES);
+          if (!m_file.WriteBytes(encrypted_chunk.data(), chunk_size))
+            return false;
+          hasher.Update(encrypted_chunk.data(), chunk_size);
+        }
       }
     }
 
-    if (!WriteSignatures())
+    if (!WriteSignatures(hasher))
     {
       ERROR_LOG_FMT(CORE, "WiiSave::WriteFiles: Failed to write signatures");
       return false;
@@ -432,28 +451,56 @@ public:
   }
 
 private:
-  bool WriteSignatures()
+  static constexpr size_t ENCRYPTION_CHUNK_SIZE = 0x10000;
+
+  // Hashes the first size bytes that are written after the header
+  class DataHasher
   {
-    const std::optional<BkHeader> bk_header = ReadBkHeader();
-    if (!bk_header)
-      return false;
+  public:
+    explicit DataHasher(u64 size) : m_remaining(size)
+    {
+      mbedtls_sha1_init(&m_context);
+      mbedtls_sha1_starts_ret(&m_context);
+    }
+    ~DataHasher() { mbedtls_sha1_free(&m_context); }
+
+    DataHasher(const DataHasher&) = delete;
+    DataHasher& operator=(const DataHasher&) = delete;
 
-    // Read data to sign.
-    std::array<u8, 20> data_sha1;
+    void Update(const void* data, u64 size)
     {
-      const u32 data_size = bk_header->size_of_files + sizeof(BkHeader);
-      auto data = std::make_unique<u8[]>(data_size);
-      m_file.Seek(sizeof(Header), File::SeekOrigin::Begin);
-      if (!m_file.ReadBytes(data.get(), data_size))
-        return false;
-      mbedtls_sha1_ret(data.get(), data_size, data_sha1.data());
+      const u64 length = std::min(size, m_remaining);
+      mbedtls_sha1_update_ret(&m_context, static_cast<const u8*>(data), length);
+      m_remaining -= length;
+    }
+
+    // Fails if less than size bytes were written
+    std::optional<std::array<u8, 20>> Finish()
+    {
+      if (m_remaining != 0)
+        return std::nullopt;
+
+      std::array<u8, 20> sha1;
+      mbedtls_sha1_finish_ret(&m_context, sha1.data());
+      return sha1;
     }
 
+  private:
+    mbedtls_sha1_context m_context;
+    u64 m_remaining;
+  };
+
+  bool WriteSignatures(DataHasher& hasher)
+  {
+    const std::optional<std::array<u8, 20>> data_sha1 = hasher.Finish();
+    if (!data_sha1)
+      return false;
+
     // Sign the data.
     IOS::CertECC ap_cert;
     Common::ec::Signature ap_sig;
     m_iosc.Sign(ap_sig.data(), reinterpret_cast<u8*>(&ap_cert), Titles::SYSTEM_MENU,
-                data_sha1.data(), static_cast<u32>(data_sha1.size()));
+                data_sha1->data(), static_cast<u32>(data_sha1->size()));
 
     // Write signatures.
     if (!m_file.Seek(0, File::SeekOrigin::End))
@@ -559,30 +606,40 @@ CopyResult Import(const std::string& data_bin_path, std::function<bool()> can_ov
   return Copy(data_bin.get(), nand.get());
 }
 
-static CopyResult Export(u64 tid, std::string_view export_path, IOS::HLE::Kernel* ios)
+static CopyResult Export(u64 tid, std::string_view export_path, FS::FileSystem* fs,
+                         IOS::HLE::IOSC* iosc)
 {
   const std::string path = fmt::format("{}/private/wii/title/{}{}{}{}/data.bin", export_path,
                                        static_cast<char>(tid >> 24), static_cast<char>(tid >> 16),
                                        static_cast<char>(tid >> 8), static_cast<char>(tid));
-  return Copy(MakeNandStorage(ios->GetFS().get(), tid).get(),
-              MakeDataBinStorage(&ios->GetIOSC(), path, "w+b").get());
+  return Copy(MakeNandStorage(fs, tid).get(), MakeDataBinStorage(iosc, path, "w+b").get());
 }
 
 CopyResult Export(u64 tid, std::string_view export_path)
 {
   IOS::HLE::Kernel ios;
-  return Export(tid, export_path, &ios);
+  return Export(tid, export_path, ios.GetFS().get(), &ios.GetIOSC());
 }
 
 size_t ExportAll(std::string_view export_path)
 {
   IOS::HLE::Kernel ios;
-  size_t exported_save_count = 0;
+  std::atomic<size_t> exported_save_count{0};
+
+  // The saves are exported on the thread pool. The file system isn't thread-safe, so each export
+  // gets its own, which is fine since they only read from the NAND. IOSC can be shared, since
+  // encrypting and signing don't change it.
+  Common::TaskGroup task_group;
   for (const u64 title : ios.GetES()->GetInstalledTitles())
   {
-    if (Export(title, export_path, &ios) == CopyResult::Success)
-      ++exported_save_count;
+    task_group.Submit([title, export_path, &ios, &exported_save_count] {
+      const std::unique_ptr<FS::FileSystem> fs = FS::MakeFileSystem();
+      if (Export(title, export_path, fs.get(), &ios.GetIOSC()) == CopyResult::Success)
+        ++exported_save_count;
+    });
   }
+  task_group.Wait();
+
   return exported_save_count;
 }
 }  // namespace WiiSave
@@ -23,6 +23,8 @@
 
 namespace IOS::HLE::FS
 {
+constexpr size_t MAX_CACHED_HOST_PATHS = 4096;
+
 HostFileSystem::HostFilename HostFileSystem::BuildFilename(const std::string& wii_path) const
 {
   for (const auto& redirect : m_nand_redirects)
@@ -43,6 +45,23 @@ HostFileSystem::HostFilename HostFileSystem::BuildFilename(const std::string& wi
   return HostFilename{m_root_path, false};
 }
 
+HostFileSystem::HostPathInfo HostFileSystem::GetHostPathInfo(const std::string& wii_path)
+{
+  const auto it = m_host_path_cache.find(wii_path);
+  if (it != m_host_path_cache.end())
+    return it->second;
+
+  // Games can look for lots of files that don't exist, so don't let this grow without bounds
+  if (m_host_path_cache.size() >= MAX_CACHED_HOST_PATHS)
+    m_host_path_cache.clear();
+
+  HostFilename filename = BuildFilename(wii_path);
+  const File::FileInfo host_file_info{filename.host_path};
+  const HostPathInfo info{std::move(filename), host_file_info.Exists(), host_file_info.IsFile()};
+  m_host_path_cache.emplace(wii_path, info);
+  return info;
+}
+
 // Get total filesize of contents of a directory (recursive)
 // Only used for ES_GetUsage atm, could be useful elsewhere?
 static u64 ComputeTotalFileSize(const File::FSTEntry& parent_entry)
@@ -124,7 +143,10 @@ HostFileSystem::HostFileSystem(const std::string& root_path,
   LoadFst();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  FlushFst();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
@@ -205,6 +227,20 @@ void HostFileSystem::SaveFst()
     PanicAlertFmt("IOS_FS: Failed to rename temporary FST file");
 }
 
+void HostFileSystem::MarkFstDirty()
+{
+  m_fst_dirty = true;
+}
+
+void HostFileSystem::FlushFst()
+{
+  if (!m_fst_dirty)
+    return;
+
+  m_fst_dirty = false;
+  SaveFst();
+}
+
 HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string& path)
 {
   if (path == "/")
@@ -213,11 +249,12 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
   if (!IsValidNonRootPath(path))
     return nullptr;
 
-  auto host_file = BuildFilename(path);
-  const File::FileInfo host_file_info{host_file.host_path};
-  if (!host_file_info.Exists())
+  const HostPathInfo host_file_info = GetHostPathInfo(path);
+  if (!host_file_info.exists)
     return nullptr;
 
+  const HostFilename& host_file = host_file_info.filename;
+
   FstEntry* entry = host_file.is_redirect ? &m_redirect_fst : &m_root_entry;
   std::string complete_path = "";
   for (const std::string& component : SplitString(std::string(path.substr(1)), '/'))
@@ -242,7 +279,7 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
     }
   }
 
-  entry->data.is_file = host_file_info.IsFile();
+  entry->data.is_file = host_file_info.is_file;
   if (entry->data.is_file && !entry->children.empty())
   {
     WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", path);
@@ -254,9 +291,13 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
 
 void HostFileSystem::DoState(PointerWrap& p)
 {
+  FlushFst();
+
   // Temporarily close the file, to prevent any issues with the savestating of /tmp
   for (Handle& handle : m_handles)
     handle.host_file.reset();
+  m_recent_files.clear();
+  m_host_path_cache.clear();
 
   // handle /tmp
   std::string Path = BuildFilename("/tmp").host_path;
@@ -365,12 +406,15 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (m_root_path.empty())
     return ResultCode::AccessDenied;
   const std::string root = BuildFilename("/").host_path;
+  // Reset and close all handles.
+  m_handles = {};
+  m_recent_files.clear();
+  m_host_path_cache.clear();
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
+  m_fst_dirty = false;
   SaveFst();
-  // Reset and close all handles.
-  m_handles = {};
   return ResultCode::Success;
 }
 
@@ -397,6 +441,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
     return ResultCode::AlreadyExists;
 
   const bool ok = is_file ? File::CreateEmptyFile(host_path) : File::CreateDir(host_path);
+  m_host_path_cache.clear();
   if (!ok)
   {
     ERROR_LOG_FMT(IOS_FS, "Failed to create file or directory: {}", host_path);
@@ -411,7 +456,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.uid = uid;
   child->data.gid = gid;
   child->data.attribute = attr;
-  SaveFst();
+  MarkFstDirty();
   return ResultCode::Success;
 }
 
@@ -459,6 +504,8 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (!File::Exists(host_path))
     return ResultCode::NotFound;
 
+  CloseRecentFiles(host_path);
+  m_host_path_cache.clear();
   if (File::IsFile(host_path) && !IsFileOpened(path))
     File::Delete(host_path);
   else if (File::IsDirectory(host_path) && !IsDirectoryInUse(path))
@@ -470,7 +517,7 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
                                GetNamePredicate(split_path.file_name));
   if (it != parent->children.end())
     parent->children.erase(it);
-  SaveFst();
+  MarkFstDirty();
 
   return ResultCode::Success;
 }
@@ -514,6 +561,10 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   const std::string& host_old_path = host_old_info.host_path;
   const std::string& host_new_path = host_new_info.host_path;
 
+  CloseRecentFiles(host_old_path);
+  CloseRecentFiles(host_new_path);
+  m_host_path_cache.clear();
+
   // If there is already something of the same type at the new path, delete it.
   if (File::Exists(host_new_path))
   {
@@ -566,7 +617,7 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
     old_parent->children.erase(it);
   }
 
-  SaveFst();
+  MarkFstDirty();
 
   return ResultCode::Success;
 }
@@ -655,7 +706,7 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string
     return ResultCode::NotFound;
 
   Metadata metadata = entry->data;
-  metadata.size = File::GetSize(BuildFilename(path).host_path);
+  metadata.size = GetHostFileSize(BuildFilename(path).host_path);
   return metadata;
 }
 
@@ -674,7 +725,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   if (caller_uid != 0 && uid != entry->data.uid)
     return ResultCode::AccessDenied;
 
-  const bool is_empty = File::GetSize(BuildFilename(path).host_path) == 0;
+  const bool is_empty = GetHostFileSize(BuildFilename(path).host_path) == 0;
   if (entry->data.uid != uid && entry->data.is_file && !is_empty)
     return ResultCode::FileNotEmpty;
 
@@ -682,7 +733,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   entry->data.uid = uid;
   entry->data.attribute = attr;
   entry->data.modes = modes;
-  SaveFst();
+  MarkFstDirty();
 
   return ResultCode::Success;
 }
@@ -730,6 +781,9 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
 
 void HostFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
 {
+  // The redirected files are copied back around this, by code that goes to the host directly
+  FlushFst();
   m_nand_redirects = std::move(nand_redirects);
+  m_host_path_cache.clear();
 }
 }  // namespace IOS::HLE::FS
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -73,12 +74,30 @@ private:
     std::vector<FstEntry> children;
   };
 
+  /// A host file, shared by all handles that have it open.
+  struct HostFile
+  {
+    /// Seeks the stream to offset, unless the previous access in the same direction ended there.
+    /// Seeking flushes the stream's buffer, which would otherwise collect runs of small reads and
+    /// writes into large ones.
+    void SeekForAccess(u64 offset, bool write);
+
+    std::string host_path;
+    File::IOFile file;
+    /// All writes go through this class, so the size never needs to be asked from the host.
+    u64 size = 0;
+    /// Where the stream is. Only valid if position_known is set.
+    u64 position = 0;
+    bool position_known = false;
+    bool last_access_was_write = false;
+  };
+
   struct Handle
   {
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
-    std::shared_ptr<File::IOFile> host_file;
+    std::shared_ptr<HostFile> host_file;
     u32 file_offset = 0;
   };
   Handle* AssignFreeHandle();
@@ -91,7 +110,21 @@ private:
     bool is_redirect;
   };
   HostFilename BuildFilename(const std::string& wii_path) const;
-  std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<HostFile> OpenHostFile(const std::string& host_path);
+  /// Closes the recently used files whose host paths start with host_path, so that they can be
+  /// deleted or renamed.
+  void CloseRecentFiles(const std::string& host_path);
+  u64 GetHostFileSize(const std::string& host_path) const;
+
+  struct HostPathInfo
+  {
+    HostFilename filename;
+    bool exists;
+    bool is_file;
+  };
+  /// Looks up a host path without asking the host again, as long as nothing was created, deleted
+  /// or renamed since the last time.
+  HostPathInfo GetHostPathInfo(const std::string& wii_path);
 
   ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
                                    FileAttribute attribute, Modes modes, bool is_file);
@@ -102,6 +135,10 @@ private:
   void ResetFst();
   void LoadFst();
   void SaveFst();
+  /// Metadata changes are written back when a file is closed rather than right away, since games
+  /// tend to make several of them in a row when they create their files.
+  void MarkFstDirty();
+  void FlushFst();
   /// Get the FST entry for a file (or directory).
   /// Automatically creates fallback entries for parents if they do not exist.
   /// Returns nullptr if the path is invalid or the file does not exist.
@@ -117,8 +154,13 @@ private:
   /// filesystem root manually.
   FstEntry m_root_entry{};
   std::string m_root_path;
-  std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
+  bool m_fst_dirty = false;
+  std::map<std::string, std::weak_ptr<HostFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
+  /// Files that were closed recently, most recent first. These stay open on the host, as games
+  /// tend to open the same few files over and over again.
+  std::vector<std::shared_ptr<HostFile>> m_recent_files;
+  std::unordered_map<std::string, HostPathInfo> m_host_path_cache;
 
   FstEntry m_redirect_fst{};
   std::vector<NandRedirect> m_nand_redirects;
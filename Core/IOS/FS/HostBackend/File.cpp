@@ -4,17 +4,33 @@
 #include "Core/IOS/FS/HostBackend/FS.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <memory>
 
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
 
 namespace IOS::HLE::FS
 {
+constexpr size_t HOST_FILE_BUFFER_SIZE = 0x10000;
+constexpr size_t RECENT_FILE_COUNT = 8;
+
+void HostFileSystem::HostFile::SeekForAccess(u64 offset, bool write)
+{
+  // Switching between reading and writing needs a seek in any case
+  if (position_known && position == offset && last_access_was_write == write)
+    return;
+
+  position_known = file.Seek(offset, File::SeekOrigin::Begin);
+  position = offset;
+  last_access_was_write = write;
+}
+
 // This isn't theadsafe, but it's only called from the CPU thread.
-std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
+std::shared_ptr<HostFileSystem::HostFile> HostFileSystem::OpenHostFile(const std::string& host_path)
 {
   // On the wii, all file operations are strongly ordered.
   // If a game opens the same file twice (or 8 times, looking at you PokePark Wii)
@@ -59,35 +75,60 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
     }
   }
 
+  // Must be done before anything else is done with the stream
+  std::setvbuf(file.GetHandle(), nullptr, _IOFBF, HOST_FILE_BUFFER_SIZE);
+
   // This code will be called when all references to the shared pointer below have been removed.
-  auto deleter = [this, host_path](File::IOFile* ptr) {
+  auto deleter = [this, host_path](HostFile* ptr) {
     delete ptr;                     // IOFile's deconstructor closes the file.
     m_open_files.erase(host_path);  // erase the weak pointer from the list of open files.
   };
 
   // Use the custom deleter from above.
-  std::shared_ptr<File::IOFile> file_ptr(new File::IOFile(std::move(file)), deleter);
+  std::shared_ptr<HostFile> file_ptr(new HostFile{host_path, std::move(file)}, deleter);
+  file_ptr->size = file_ptr->file.GetSize();
 
   // Store a weak pointer to our newly opened file in the cache.
-  m_open_files[host_path] = std::weak_ptr<File::IOFile>(file_ptr);
+  m_open_files[host_path] = std::weak_ptr<HostFile>(file_ptr);
 
   return file_ptr;
 }
 
+void HostFileSystem::CloseRecentFiles(const std::string& host_path)
+{
+  m_recent_files.erase(std::remove_if(m_recent_files.begin(), m_recent_files.end(),
+                                      [&host_path](const std::shared_ptr<HostFile>& file) {
+                                        return StringBeginsWith(file->host_path, host_path);
+                                      }),
+                       m_recent_files.end());
+}
+
+u64 HostFileSystem::GetHostFileSize(const std::string& host_path) const
+{
+  const auto it = m_open_files.find(host_path);
+  if (it != m_open_files.end())
+  {
+    if (const std::shared_ptr<HostFile> file = it->second.lock())
+      return file->size;
+  }
+
+  return File::GetSize(host_path);
+}
+
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
 {
   Handle* handle = AssignFreeHandle();
   if (!handle)
     return ResultCode::NoFreeHandle;
 
-  const std::string host_path = BuildFilename(path).host_path;
-  if (!File::IsFile(host_path))
+  const HostPathInfo info = GetHostPathInfo(path);
+  if (!info.is_file)
   {
     *handle = Handle{};
     return ResultCode::NotFound;
   }
 
-  handle->host_file = OpenHostFile(host_path);
+  handle->host_file = OpenHostFile(info.filename.host_path);
   if (!handle->host_file)
   {
     *handle = Handle{};
@@ -106,32 +147,51 @@ ResultCode HostFileSystem::Close(Fd fd)
   if (!handle)
     return ResultCode::Invalid;
 
-  // Let go of our pointer to the file, it will automatically close if we are the last handle
-  // accessing it.
+  // Other code may read the file from the host once the game is done with it
+  std::shared_ptr<HostFile> host_file = std::move(handle->host_file);
+  if (host_file)
+    host_file->file.Flush();
+
+  // Let go of our pointer to the file, it will close once it drops out of the recent files if we
+  // are the last handle accessing it.
   *handle = Handle{};
+  if (host_file)
+  {
+    CloseRecentFiles(host_file->host_path);
+    m_recent_files.insert(m_recent_files.begin(), std::move(host_file));
+    if (m_recent_files.size() > RECENT_FILE_COUNT)
+      m_recent_files.pop_back();
+  }
+
+  FlushFst();
   return ResultCode::Success;
 }
 
 Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Read)) == 0)
     return ResultCode::AccessDenied;
 
-  const u32 file_size = static_cast<u32>(handle->host_file->GetSize());
+  HostFile& host_file = *handle->host_file;
+  const u32 file_size = static_cast<u32>(host_file.size);
   // IOS has this check in the read request handler.
   if (count + handle->file_offset > file_size)
     count = file_size - handle->file_offset;
 
   // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
+  host_file.SeekForAccess(handle->file_offset, false);
+  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, host_file.file.GetHandle()));
+  host_file.position += actually_read;
 
-  if (actually_read != count && ferror(handle->host_file->GetHandle()))
+  if (actually_read != count && ferror(host_file.file.GetHandle()))
+  {
+    host_file.position_known = false;
     return ResultCode::AccessDenied;
+  }
 
   // IOS returns the number of bytes read and adds that value to the seek position,
   // instead of adding the *requested* read length.
@@ -142,17 +202,23 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  if (!handle->host_file->WriteBytes(ptr, count))
+  // File might be opened twice, need to seek before we write
+  HostFile& host_file = *handle->host_file;
+  host_file.SeekForAccess(handle->file_offset, true);
+  if (!host_file.file.WriteBytes(ptr, count))
+  {
+    host_file.position_known = false;
     return ResultCode::AccessDenied;
+  }
 
+  host_file.position += count;
+  host_file.size = std::max(host_file.size, host_file.position);
   handle->file_offset += count;
   return count;
 }
@@ -160,7 +226,7 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   u32 new_position = 0;
@@ -173,14 +239,14 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
     new_position = handle->file_offset + offset;
     break;
   case SeekMode::End:
-    new_position = handle->host_file->GetSize() + offset;
+    new_position = handle->host_file->size + offset;
     break;
   default:
     return ResultCode::Invalid;
   }
 
   // This differs from POSIX behaviour which allows seeking past the end of the file.
-  if (handle->host_file->GetSize() < new_position)
+  if (handle->host_file->size < new_position)
     return ResultCode::Invalid;
 
   handle->file_offset = new_position;
@@ -190,11 +256,11 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 Result<FileStatus> HostFileSystem::GetFileStatus(Fd fd)
 {
   const Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   FileStatus status;
-  status.size = handle->host_file->GetSize();
+  status.size = handle->host_file->size;
   status.offset = handle->file_offset;
   return status;
 }
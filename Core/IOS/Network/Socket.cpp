@@ -213,6 +213,7 @@ s32 WiiSocket::CloseFd()
   s32 ReturnValue = 0;
   if (fd >= 0)
   {
+    WiiSockMan::GetInstance().socket_poller.Remove(fd);
     s32 ret = closesocket(fd);
     ReturnValue = WiiSockMan::GetNetErrorCode(ret, "CloseFd", false);
   }
@@ -221,6 +222,8 @@ s32 WiiSocket::CloseFd()
     ReturnValue = WiiSockMan::GetNetErrorCode(EITHER(WSAENOTSOCK, EBADF), "CloseFd", false);
   }
   fd = -1;
+  wants_read = false;
+  wants_write = false;
 
   for (auto it = pending_sockops.begin(); it != pending_sockops.end();)
   {
@@ -261,6 +264,7 @@ s32 WiiSocket::FCntl(u32 cmd, u32 arg)
 
 void WiiSocket::Update(bool read, bool write, bool except)
 {
+  has_new_sockops = false;
   auto it = pending_sockops.begin();
   while (it != pending_sockops.end())
   {
@@ -717,6 +721,39 @@ void WiiSocket::Update(bool read, bool write, bool except)
   }
 }
 
+bool WiiSocket::NeedsRetry() const
+{
+  if (has_new_sockops)
+    return true;
+
+  // SSL contexts can have data buffered that the socket doesn't know about, and blocking
+  // connects time out, so only plain reads and writes wait for the socket to be ready.
+  return std::any_of(pending_sockops.begin(), pending_sockops.end(), [](const sockop& op) {
+    return op.is_ssl || op.is_aborted ||
+           (op.net_type != IOCTL_SO_ACCEPT && op.net_type != IOCTLV_SO_RECVFROM &&
+            op.net_type != IOCTLV_SO_SENDTO);
+  });
+}
+
+void WiiSocket::UpdatePollInterest(SocketPoller& poller)
+{
+  bool read = false;
+  bool write = false;
+  for (const sockop& op : pending_sockops)
+  {
+    if (op.is_ssl)
+      continue;
+    read |= op.net_type == IOCTL_SO_ACCEPT || op.net_type == IOCTLV_SO_RECVFROM;
+    write |= op.net_type == IOCTLV_SO_SENDTO;
+  }
+
+  if (read == wants_read && write == wants_write)
+    return;
+  poller.SetInterest(fd, wii_fd, read, write);
+  wants_read = read;
+  wants_write = write;
+}
+
 void WiiSocket::UpdateConnectingState(s32 connect_rv)
 {
   if (connect_rv == -SO_EAGAIN || connect_rv == -SO_EALREADY || connect_rv == -SO_EINPROGRESS)
@@ -843,6 +880,7 @@ void WiiSocket::DoSock(Request request, NET_IOCTL type)
   sockop so = {request, false};
   so.net_type = type;
   pending_sockops.push_back(so);
+  has_new_sockops = true;
 }
 
 void WiiSocket::DoSock(Request request, SSL_IOCTL type)
@@ -850,6 +888,7 @@ void WiiSocket::DoSock(Request request, SSL_IOCTL type)
   sockop so = {request, true};
   so.ssl_type = type;
   pending_sockops.push_back(so);
+  has_new_sockops = true;
 }
 
 s32 WiiSockMan::AddSocket(s32 fd, bool is_rw)
@@ -879,6 +918,7 @@ s32 WiiSockMan::AddSocket(s32 fd, bool is_rw)
     WiiSocket& sock = WiiSockets[wii_fd];
     sock.SetFd(fd);
     sock.SetWiiFd(wii_fd);
+    socket_poller.Add(fd, wii_fd);
     PowerPC::debug_interface.NetworkLogger()->OnNewSocket(fd);
 
 #ifdef __APPLE__
@@ -939,9 +979,12 @@ s32 WiiSockMan::GetHostSocket(s32 wii_fd) const
 s32 WiiSockMan::ShutdownSocket(s32 wii_fd, u32 how)
 {
   auto socket_entry = WiiSockets.find(wii_fd);
-  if (socket_entry != WiiSockets.end())
-    return socket_entry->second.Shutdown(how);
-  return -SO_EBADF;
+  if (socket_entry == WiiSockets.end())
+    return -SO_EBADF;
+
+  // Aborted operations are replied to by the next update
+  sockets_to_retry.set(wii_fd);
+  return socket_entry->second.Shutdown(how);
 }
 
 s32 WiiSockMan::DeleteSocket(s32 wii_fd)
@@ -958,51 +1001,51 @@ s32 WiiSockMan::DeleteSocket(s32 wii_fd)
 
 void WiiSockMan::Update()
 {
-  s32 nfds = 0;
-  fd_set read_fds, write_fds, except_fds;
-  struct timeval t = {0, 0};
-  FD_ZERO(&read_fds);
-  FD_ZERO(&write_fds);
-  FD_ZERO(&except_fds);
-
-  auto socket_iter = WiiSockets.begin();
-  auto end_socks = WiiSockets.end();
-
-  while (socket_iter != end_socks)
+  // Sockets only need an update when they have something pending, so instead of checking all of
+  // them, the poller tells which ones are ready for what they are waiting on.
+  std::bitset<WII_SOCKET_FD_MAX> read_ready, write_ready, except_ready;
+  std::bitset<WII_SOCKET_FD_MAX> to_update = sockets_to_retry;
+  if (socket_poller.Poll(ready_sockets))
   {
-    const WiiSocket& sock = socket_iter->second;
-    if (sock.IsValid())
+    for (const SocketPoller::Event& event : ready_sockets)
     {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
-      ++socket_iter;
-    }
-    else
-    {
-      // Good time to clean up invalid sockets.
-      socket_iter = WiiSockets.erase(socket_iter);
+      if (event.id < 0 || event.id >= WII_SOCKET_FD_MAX)
+        continue;
+      to_update.set(event.id);
+      read_ready[event.id] = event.read;
+      write_ready[event.id] = event.write;
+      except_ready[event.id] = event.except;
     }
   }
-
-  const s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
-
-  if (ret >= 0)
+  else
   {
-    for (auto& pair : WiiSockets)
-    {
-      WiiSocket& sock = pair.second;
-      sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
-                  FD_ISSET(sock.fd, &except_fds) != 0);
-    }
+    to_update.set();
   }
-  else
+  sockets_to_retry.reset();
+
+  for (s32 wii_fd = 0; wii_fd < WII_SOCKET_FD_MAX; ++wii_fd)
   {
-    for (auto& elem : WiiSockets)
+    if (!to_update[wii_fd])
+      continue;
+
+    const auto socket_entry = WiiSockets.find(wii_fd);
+    if (socket_entry == WiiSockets.end())
+      continue;
+
+    WiiSocket& sock = socket_entry->second;
+    if (!sock.IsValid())
     {
-      elem.second.Update(false, false, false);
+      // Good time to clean up invalid sockets.
+      WiiSockets.erase(socket_entry);
+      continue;
     }
+    if (sock.pending_sockops.empty())
+      continue;
+
+    sock.Update(read_ready[wii_fd], write_ready[wii_fd], except_ready[wii_fd]);
+    if (sock.NeedsRetry())
+      sockets_to_retry.set(wii_fd);
+    sock.UpdatePollInterest(socket_poller);
   }
   UpdatePollCommands();
 }
@@ -42,6 +42,7 @@ typedef struct pollfd pollfd_t;
 #endif
 
 #include <algorithm>
+#include <bitset>
 #include <chrono>
 #include <cstdio>
 #include <list>
@@ -57,6 +58,7 @@ typedef struct pollfd pollfd_t;
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/Network/IP/Top.h"
 #include "Core/IOS/Network/SSL.h"
+#include "Core/IOS/Network/SocketPoller.h"
 
 namespace IOS::HLE
 {
@@ -220,6 +222,11 @@ private:
   void DoSock(Request request, NET_IOCTL type);
   void DoSock(Request request, SSL_IOCTL type);
   void Update(bool read, bool write, bool except);
+  // Whether a pending operation has to be retried even though the socket isn't ready, like one
+  // that's about to run for the first time or that can time out.
+  bool NeedsRetry() const;
+  // Registers what the pending operations are waiting on with the socket poller.
+  void UpdatePollInterest(SocketPoller& poller);
   void UpdateConnectingState(s32 connect_rv);
   ConnectingState GetConnectingState() const;
   bool IsValid() const { return fd >= 0; }
@@ -230,6 +237,9 @@ private:
   bool nonBlock = false;
   ConnectingState connecting_state = ConnectingState::None;
   std::list<sockop> pending_sockops;
+  bool has_new_sockops = false;
+  bool wants_read = false;
+  bool wants_write = false;
 
   std::optional<Timeout> timeout;
 };
@@ -276,7 +286,11 @@ public:
   s32 DeleteSocket(s32 wii_fd);
   s32 GetLastNetError() const { return errno_last; }
   void SetLastNetError(s32 error) { errno_last = error; }
-  void Clean() { WiiSockets.clear(); }
+  void Clean()
+  {
+    WiiSockets.clear();
+    sockets_to_retry.reset();
+  }
   template <typename T>
   void DoSock(s32 sock, const Request& request, T type)
   {
@@ -290,12 +304,15 @@ public:
     else
     {
       socket_entry->second.DoSock(request, type);
+      sockets_to_retry.set(sock);
     }
   }
 
   void UpdateWantDeterminism(bool want);
 
 private:
+  friend class WiiSocket;
+
   WiiSockMan() = default;
   WiiSockMan(const WiiSockMan&) = delete;
   WiiSockMan& operator=(const WiiSockMan&) = delete;
@@ -304,6 +321,11 @@ private:
 
   void UpdatePollCommands();
 
+  // Declared before the sockets, which unregister themselves when they are closed
+  SocketPoller socket_poller;
+  std::vector<SocketPoller::Event> ready_sockets;
+  // Sockets that get updated whether they are ready or not
+  std::bitset<WII_SOCKET_FD_MAX> sockets_to_retry;
   std::unordered_map<s32, WiiSocket> WiiSockets;
   s32 errno_last = 0;
   std::vector<PollCommand> pending_polls;
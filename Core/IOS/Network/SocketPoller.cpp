@@ -0,0 +1,215 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/IOS/Network/SocketPoller.h"
+
+#include <algorithm>
+#include <array>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif !defined(SOCKET_POLLER_USE_POLL)
+#include <sys/event.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+
+namespace IOS::HLE
+{
+// Enough for a read and a write event from every socket the Wii can have open
+constexpr size_t MAX_EVENTS = 64;
+
+#if defined(__linux__)
+SocketPoller::SocketPoller() : m_fd(epoll_create1(EPOLL_CLOEXEC))
+{
+  if (m_fd < 0)
+    ERROR_LOG_FMT(IOS_NET, "epoll_create1 failed: {}", LastStrerrorString());
+}
+
+SocketPoller::~SocketPoller()
+{
+  if (m_fd >= 0)
+    close(m_fd);
+}
+
+void SocketPoller::Add(s32 fd, s32 id)
+{
+  epoll_event event{};
+  event.data.u32 = static_cast<u32>(id);
+  if (m_fd >= 0 && epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+    ERROR_LOG_FMT(IOS_NET, "Failed to add socket {} to epoll: {}", fd, LastStrerrorString());
+}
+
+void SocketPoller::SetInterest(s32 fd, s32 id, bool read, bool write)
+{
+  epoll_event event{};
+  event.events = (read ? static_cast<u32>(EPOLLIN | EPOLLPRI) : u32{0}) |
+                 (write ? static_cast<u32>(EPOLLOUT) : u32{0});
+  event.data.u32 = static_cast<u32>(id);
+  if (m_fd >= 0 && epoll_ctl(m_fd, EPOLL_CTL_MOD, fd, &event) < 0)
+    ERROR_LOG_FMT(IOS_NET, "Failed to update socket {} in epoll: {}", fd, LastStrerrorString());
+}
+
+void SocketPoller::Remove(s32 fd)
+{
+  if (m_fd >= 0)
+    epoll_ctl(m_fd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+bool SocketPoller::Poll(std::vector<Event>& events)
+{
+  events.clear();
+  if (m_fd < 0)
+    return false;
+
+  std::array<epoll_event, MAX_EVENTS> native_events;
+  const int count = epoll_wait(m_fd, native_events.data(), MAX_EVENTS, 0);
+  if (count < 0)
+    return false;
+
+  for (int i = 0; i < count; ++i)
+  {
+    const u32 flags = native_events[i].events;
+    events.push_back({static_cast<s32>(native_events[i].data.u32),
+                      (flags & (EPOLLIN | EPOLLHUP)) != 0, (flags & (EPOLLOUT | EPOLLHUP)) != 0,
+                      (flags & (EPOLLPRI | EPOLLERR)) != 0});
+  }
+  return true;
+}
+#elif !defined(SOCKET_POLLER_USE_POLL)
+SocketPoller::SocketPoller() : m_fd(kqueue())
+{
+  if (m_fd < 0)
+    ERROR_LOG_FMT(IOS_NET, "kqueue failed: {}", LastStrerrorString());
+}
+
+SocketPoller::~SocketPoller()
+{
+  if (m_fd >= 0)
+    close(m_fd);
+}
+
+// Sockets have a read and a write filter each, which are switched on and off with the interest
+void SocketPoller::Add(s32 fd, s32 id)
+{
+  SetInterest(fd, id, false, false);
+}
+
+void SocketPoller::SetInterest(s32 fd, s32 id, bool read, bool write)
+{
+  if (m_fd < 0)
+    return;
+
+  std::array<struct kevent, 2> changes;
+  EV_SET(&changes[0], fd, EVFILT_READ, EV_ADD | (read ? EV_ENABLE : EV_DISABLE), 0, 0,
+         reinterpret_cast<void*>(static_cast<intptr_t>(id)));
+  EV_SET(&changes[1], fd, EVFILT_WRITE, EV_ADD | (write ? EV_ENABLE : EV_DISABLE), 0, 0,
+         reinterpret_cast<void*>(static_cast<intptr_t>(id)));
+  if (kevent(m_fd, changes.data(), static_cast<int>(changes.size()), nullptr, 0, nullptr) < 0)
+    ERROR_LOG_FMT(IOS_NET, "Failed to update socket {} in kqueue: {}", fd, LastStrerrorString());
+}
+
+void SocketPoller::Remove(s32 fd)
+{
+  if (m_fd < 0)
+    return;
+
+  // Each filter is removed on its own so that one that's missing doesn't keep the other
+  for (const auto filter : {EVFILT_READ, EVFILT_WRITE})
+  {
+    struct kevent change;
+    EV_SET(&change, fd, filter, EV_DELETE, 0, 0, nullptr);
+    kevent(m_fd, &change, 1, nullptr, 0, nullptr);
+  }
+}
+
+bool SocketPoller::Poll(std::vector<Event>& events)
+{
+  events.clear();
+  if (m_fd < 0)
+    return false;
+
+  std::array<struct kevent, MAX_EVENTS> native_events;
+  const timespec timeout{0, 0};
+  const int count =
+      kevent(m_fd, nullptr, 0, native_events.data(), static_cast<int>(MAX_EVENTS), &timeout);
+  if (count < 0)
+    return false;
+
+  for (int i = 0; i < count; ++i)
+  {
+    const struct kevent& event = native_events[i];
+    const bool except = (event.flags & (EV_EOF | EV_ERROR)) != 0;
+    events.push_back({static_cast<s32>(reinterpret_cast<intptr_t>(event.udata)),
+                      event.filter == EVFILT_READ, event.filter == EVFILT_WRITE, except});
+  }
+  return true;
+}
+#else
+SocketPoller::SocketPoller() = default;
+SocketPoller::~SocketPoller() = default;
+
+void SocketPoller::Add(s32 fd, s32 id)
+{
+  m_fds.push_back({});
+  m_fds.back().fd = fd;
+  m_ids.push_back(id);
+}
+
+void SocketPoller::SetInterest(s32 fd, s32 id, bool read, bool write)
+{
+  const auto it = std::find_if(m_fds.begin(), m_fds.end(), [fd](const auto& pfd) {
+    return static_cast<s32>(pfd.fd) == fd;
+  });
+  if (it == m_fds.end())
+    return;
+
+  it->events = (read ? POLLIN : 0) | (write ? POLLOUT : 0);
+  m_ids[it - m_fds.begin()] = id;
+}
+
+void SocketPoller::Remove(s32 fd)
+{
+  const auto it = std::find_if(m_fds.begin(), m_fds.end(), [fd](const auto& pfd) {
+    return static_cast<s32>(pfd.fd) == fd;
+  });
+  if (it == m_fds.end())
+    return;
+
+  m_ids.erase(m_ids.begin() + (it - m_fds.begin()));
+  m_fds.erase(it);
+}
+
+bool SocketPoller::Poll(std::vector<Event>& events)
+{
+  events.clear();
+  // WSAPoll fails without any socket
+  if (m_fds.empty())
+    return true;
+
+#ifdef _WIN32
+  const int count = WSAPoll(m_fds.data(), static_cast<ULONG>(m_fds.size()), 0);
+#else
+  const int count = poll(m_fds.data(), m_fds.size(), 0);
+#endif
+  if (count < 0)
+    return false;
+
+  for (size_t i = 0; i < m_fds.size() && events.size() < static_cast<size_t>(count); ++i)
+  {
+    const int flags = m_fds[i].revents;
+    if (flags == 0)
+      continue;
+    events.push_back({m_ids[i], (flags & (POLLIN | POLLHUP)) != 0,
+                      (flags & (POLLOUT | POLLHUP)) != 0, (flags & (POLLPRI | POLLERR)) != 0});
+  }
+  return true;
+}
+#endif
+}  // namespace IOS::HLE
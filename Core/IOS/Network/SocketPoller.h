@@ -0,0 +1,64 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#if !defined(__linux__) && !defined(__APPLE__) && !defined(__FreeBSD__) && !defined(__NetBSD__) && \
+    !defined(__OpenBSD__)
+#define SOCKET_POLLER_USE_POLL
+#ifdef _WIN32
+#include <WinSock2.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+#include "Common/CommonTypes.h"
+
+namespace IOS::HLE
+{
+// Tells which host sockets are ready. Sockets stay registered between polls, along with whether
+// they are waited on for reading or writing, so that a poll only costs as much as the sockets
+// that are ready with epoll and kqueue. Other platforms keep a list of sockets for poll().
+class SocketPoller
+{
+public:
+  struct Event
+  {
+    // What the socket was registered with
+    s32 id;
+    bool read;
+    bool write;
+    bool except;
+  };
+
+  SocketPoller();
+  ~SocketPoller();
+  SocketPoller(const SocketPoller&) = delete;
+  SocketPoller& operator=(const SocketPoller&) = delete;
+
+  // Sockets start out waited on for nothing, but errors and hang-ups are reported regardless.
+  void Add(s32 fd, s32 id);
+  void SetInterest(s32 fd, s32 id, bool read, bool write);
+  // Has to happen before the socket is closed.
+  void Remove(s32 fd);
+
+  // Fills events with the sockets that are ready, without blocking. Returns false if polling
+  // failed, in which case any socket may be ready.
+  bool Poll(std::vector<Event>& events);
+
+private:
+#ifdef SOCKET_POLLER_USE_POLL
+#ifdef _WIN32
+  std::vector<WSAPOLLFD> m_fds;
+#else
+  std::vector<pollfd> m_fds;
+#endif
+  std::vector<s32> m_ids;
+#else
+  int m_fd = -1;
+#endif
+};
+}  // namespace IOS::HLE
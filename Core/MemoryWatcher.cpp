@@ -10,12 +10,14 @@
 #include <unistd.h>
 
 #include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
 
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
+  m_binary = Config::Get(Config::MAIN_MEMORY_WATCHER_BINARY);
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
   if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
@@ -56,6 +58,9 @@ void MemoryWatcher::ParseLine(const std::string& line)
   u32 offset;
   while (offsets >> offset)
     m_addresses[line].push_back(offset);
+
+  if (m_binary)
+    m_binary_watches.push_back({m_addresses[line]});
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -101,11 +106,69 @@ std::string MemoryWatcher::ComposeMessages()
   return message_stream.str();
 }
 
+u32 MemoryWatcher::ReadWatch(BinaryWatch& watch)
+{
+  if (watch.offsets.empty())
+    return 0;
+  if (watch.offsets.size() == 1)
+    return PowerPC::HostRead_U32(watch.offsets[0]);
+
+  const u32 base = PowerPC::HostRead_U32(watch.offsets[0]);
+  if (watch.resolved && base == watch.base)
+    return PowerPC::HostRead_U32(watch.address);
+
+  // Walk the chain the same way ChasePointer does, remembering the final address if every
+  // pointer along the way led into RAM.
+  watch.resolved = false;
+  u32 value = base;
+  for (size_t i = 1; i < watch.offsets.size(); ++i)
+  {
+    if (!PowerPC::HostIsRAMAddress(value))
+      return value;
+    const u32 address = value + watch.offsets[i];
+    value = PowerPC::HostRead_U32(address);
+    if (i + 1 == watch.offsets.size())
+    {
+      watch.base = base;
+      watch.address = address;
+      watch.resolved = true;
+    }
+  }
+  return value;
+}
+
+void MemoryWatcher::ComposeBinaryMessage()
+{
+  m_binary_message.clear();
+  for (size_t i = 0; i < m_binary_watches.size(); ++i)
+  {
+    BinaryWatch& watch = m_binary_watches[i];
+    const u32 new_value = ReadWatch(watch);
+    if (new_value != watch.value)
+    {
+      watch.value = new_value;
+      m_binary_message.push_back(static_cast<u32>(i));
+      m_binary_message.push_back(new_value);
+    }
+  }
+}
+
 void MemoryWatcher::Step()
 {
   if (!m_running)
     return;
 
+  if (m_binary)
+  {
+    ComposeBinaryMessage();
+    if (!m_binary_message.empty())
+    {
+      sendto(m_fd, m_binary_message.data(), m_binary_message.size() * sizeof(u32), 0,
+             reinterpret_cast<sockaddr*>(&m_addr), sizeof(m_addr));
+    }
+    return;
+  }
+
   std::string message = ComposeMessages();
   sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
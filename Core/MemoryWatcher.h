@@ -19,6 +19,11 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// With MemoryWatcherBinary set, every frame that changed anything instead sends
+// a single datagram of (u32 line, u32 value) pairs in host byte order, where line
+// is the zero-based line of the address in the input file. In this mode a pointer
+// chain is only walked again once the value at its first address changes.
 class MemoryWatcher final
 {
 public:
@@ -27,6 +32,16 @@ public:
   void Step();
 
 private:
+  struct BinaryWatch
+  {
+    std::vector<u32> offsets;
+    u32 value = 0;
+    // The value at the first address when the chain was last walked, and where it led.
+    u32 base = 0;
+    u32 address = 0;
+    bool resolved = false;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
 
@@ -34,6 +49,13 @@ private:
   u32 ChasePointer(const std::string& line);
   std::string ComposeMessages();
 
+  static u32 ReadWatch(BinaryWatch& watch);
+  void ComposeBinaryMessage();
+
+  bool m_binary = false;
+  std::vector<BinaryWatch> m_binary_watches;
+  std::vector<u32> m_binary_message;
+
   bool m_running = false;
 
   int m_fd;
@@ -27,6 +27,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
@@ -95,7 +96,93 @@ static std::array<ControllerType, 4> s_controllers{};
 static std::array<bool, 4> s_wiimotes{};
 static ControllerState s_padState;
 static DTMHeader tmpHeader;
-static std::vector<u8> s_temp_input;
+
+// The input stream of the movie. Playback maps the movie file rather than reading all of it in,
+// and recording writes into space reserved in large chunks. The stream only becomes a copy of its
+// own once something writes to it.
+class MovieInput
+{
+public:
+  bool Map(const std::string& movie_path)
+  {
+    Clear();
+    if (!m_file.Open(movie_path, File::MappedFile::Mode::ReadOnly))
+      return false;
+    if (m_file.GetSize() < sizeof(DTMHeader))
+    {
+      m_file.Close();
+      return false;
+    }
+    m_mapped_path = movie_path;
+    m_data = m_file.GetData() + sizeof(DTMHeader);
+    m_size = static_cast<size_t>(m_file.GetSize() - sizeof(DTMHeader));
+    return true;
+  }
+
+  void Clear()
+  {
+    m_file.Close();
+    m_owned.clear();
+    m_data = nullptr;
+    m_size = 0;
+  }
+
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+  const u8* data() const { return m_data; }
+  const u8& operator[](size_t index) const { return m_data[index]; }
+
+  // Copies the stream out of the movie file before that file gets overwritten.
+  void DetachFrom(const std::string& path)
+  {
+    if (m_file.IsOpen() && path == m_mapped_path)
+      Detach();
+  }
+
+  // Returns where to write size bytes at offset, keeping whatever comes after them.
+  u8* Overwrite(size_t offset, size_t size)
+  {
+    if (m_file.IsOpen())
+      Detach();
+
+    const size_t end = offset + size;
+    if (end > m_owned.size())
+    {
+      const size_t chunks = (end + CHUNK_SIZE - 1) / CHUNK_SIZE;
+      m_owned.resize(std::max(m_owned.size() * 2, chunks * CHUNK_SIZE));
+    }
+    m_data = m_owned.data();
+    m_size = std::max(m_size, end);
+    return &m_owned[offset];
+  }
+
+  // Cuts the stream off at offset and returns where to write size bytes there.
+  u8* Write(size_t offset, size_t size)
+  {
+    u8* destination = Overwrite(offset, size);
+    m_size = offset + size;
+    return destination;
+  }
+
+private:
+  static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+  void Detach()
+  {
+    m_owned.assign(m_data, m_data + m_size);
+    m_file.Close();
+    m_data = m_owned.data();
+  }
+
+  File::MappedFile m_file;
+  std::string m_mapped_path;
+  // Sized to the reserved space, of which the first m_size bytes are in use.
+  std::vector<u8> m_owned;
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+static MovieInput s_temp_input;
 static u64 s_currentByte = 0;
 static u64 s_currentFrame = 0, s_totalFrames = 0;  // VI
 static u64 s_currentLagCount = 0;
@@ -596,7 +683,7 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
 
     s_playMode = PlayMode::Recording;
     s_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
-    s_temp_input.clear();
+    s_temp_input.Clear();
 
     s_currentByte = 0;
 
@@ -877,8 +964,8 @@ void RecordInput(const GCPadStatus* PadStatus, int controllerID)
 
   CheckPadStatus(PadStatus, controllerID);
 
-  s_temp_input.resize(s_currentByte + sizeof(ControllerState));
-  memcpy(&s_temp_input[s_currentByte], &s_padState, sizeof(ControllerState));
+  memcpy(s_temp_input.Write(s_currentByte, sizeof(ControllerState)), &s_padState,
+         sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
 }
 
@@ -898,10 +985,10 @@ void RecordWiimote(int wiimote, const u8* data, u8 size)
     return;
 
   InputUpdate();
-  s_temp_input.resize(s_currentByte + size + 1);
-  s_temp_input[s_currentByte++] = size;
-  memcpy(&s_temp_input[s_currentByte], data, size);
-  s_currentByte += size;
+  u8* destination = s_temp_input.Write(s_currentByte, size + 1);
+  destination[0] = size;
+  memcpy(destination + 1, data, size);
+  s_currentByte += size + 1;
 }
 
 // NOTE: EmuThread / Host Thread
@@ -975,8 +1062,11 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
 
   Core::UpdateWantDeterminism();
 
-  s_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(s_temp_input.data(), s_temp_input.size());
+  if (!s_temp_input.Map(movie_path))
+  {
+    const size_t size = static_cast<size_t>(recording_file.GetSize() - sizeof(DTMHeader));
+    recording_file.ReadBytes(s_temp_input.Write(0, size), size);
+  }
   s_currentByte = 0;
   recording_file.Close();
 
@@ -1067,8 +1157,8 @@ void LoadInput(const std::string& movie_path)
     s_totalInputCount = tmpHeader.inputCount;
     s_totalTickCount = s_tickCountAtLastInput = tmpHeader.tickCount;
 
-    s_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(s_temp_input.data(), s_temp_input.size());
+    const size_t size = static_cast<size_t>(totalSavedBytes);
+    t_record.ReadBytes(s_temp_input.Write(0, size), size);
   }
   else if (s_currentByte > 0)
   {
@@ -1090,7 +1180,7 @@ void LoadInput(const std::string& movie_path)
       std::vector<u8> movInput(s_currentByte);
       t_record.ReadArray(movInput.data(), movInput.size());
 
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.begin());
+      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.data());
 
       if (result.first != movInput.end())
       {
@@ -1109,7 +1199,8 @@ void LoadInput(const std::string& movie_path)
                          "read-only mode off. Otherwise you'll probably get a desync.",
                          byte_offset, byte_offset);
 
-          std::copy(movInput.begin(), movInput.end(), s_temp_input.begin());
+          std::copy(movInput.begin(), movInput.end(),
+                    s_temp_input.Overwrite(0, movInput.size()));
         }
         else
         {
@@ -1362,6 +1453,7 @@ void EndPlayInput(bool cont)
 // NOTE: Save State + Host Thread
 void SaveRecording(const std::string& filename)
 {
+  s_temp_input.DetachFrom(filename);
   File::IOFile save_record(filename, "wb");
   // Create the real header now and write it
   DTMHeader header;
@@ -1577,6 +1669,6 @@ static void GetMD5()
 void Shutdown()
 {
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
-  s_temp_input.clear();
+  s_temp_input.Clear();
 }
 }  // namespace Movie
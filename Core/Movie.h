@@ -124,7 +124,9 @@ struct DTMHeader
   bool bFollowBranch;
   bool bUseFMA;
   u8 GBAControllers;                // GBA Controllers plugged in (the bits are ports 1-4)
-  std::array<u8, 7> reserved;       // Padding for any new config options
+  u8 instantMemcards;               // Instant transfer memcards (the bits are slots A and B)
+  bool bInstantDisc;
+  std::array<u8, 5> reserved;       // Padding for any new config options
   std::array<char, 40> discChange;  // Name of iso file to switch to, for two disc games.
   std::array<u8, 20> revision;      // Git hash
   u32 DSPiromHash;
@@ -23,6 +23,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/ENetUtil.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
@@ -648,20 +649,14 @@ void NetPlayClient::OnGBAConfig(sf::Packet& packet)
 
 void NetPlayClient::OnPadData(sf::Packet& packet)
 {
+  PadStatusDelta delta;
   while (!packet.endOfPacket())
   {
     PadIndex map;
-    packet >> map;
-
     GCPadStatus pad;
-    packet >> pad.button;
-    if (!m_gba_config.at(map).enabled)
-    {
-      packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
-          pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-    }
+    if (!delta.Read(packet, &map, &pad))
+      break;
 
-    // Trusting server for good map value (>=0 && <4)
     // add to pad buffer
     m_pad_buffer.at(map).Push(pad);
     m_gc_pad_event.Set();
@@ -670,20 +665,14 @@ void NetPlayClient::OnPadData(sf::Packet& packet)
 
 void NetPlayClient::OnPadHostData(sf::Packet& packet)
 {
+  PadStatusDelta delta;
   while (!packet.endOfPacket())
   {
     PadIndex map;
-    packet >> map;
-
     GCPadStatus pad;
-    packet >> pad.button;
-    if (!m_gba_config.at(map).enabled)
-    {
-      packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
-          pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-    }
+    if (!delta.Read(packet, &map, &pad))
+      break;
 
-    // Trusting server for good map value (>=0 && <4)
     // write to last status
     m_last_pad_status[map] = pad;
 
@@ -697,20 +686,26 @@ void NetPlayClient::OnPadHostData(sf::Packet& packet)
 
 void NetPlayClient::OnWiimoteData(sf::Packet& packet)
 {
-  PadIndex map;
-  WiimoteInput nw;
-  u8 size;
+  while (!packet.endOfPacket())
+  {
+    PadIndex map;
+    WiimoteInput nw;
+    u8 size;
 
-  packet >> map >> nw.report_id >> size;
+    packet >> map >> nw.report_id >> size;
 
-  nw.data.resize(size);
-  for (auto& byte : nw.data)
-    packet >> byte;
+    nw.data.resize(size);
+    for (auto& byte : nw.data)
+      packet >> byte;
 
-  // Trusting server for good map value (>=0 && <4)
-  // add to Wiimote buffer
-  m_wiimote_buffer.at(map).Push(nw);
-  m_wii_pad_event.Set();
+    if (!packet)
+      break;
+
+    // Trusting server for good map value (>=0 && <4)
+    // add to Wiimote buffer
+    m_wiimote_buffer.at(map).Push(nw);
+    m_wii_pad_event.Set();
+  }
 }
 
 void NetPlayClient::OnPadBuffer(sf::Packet& packet)
@@ -854,6 +849,9 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.m_SyncGpuOverclock;
     packet >> m_net_settings.m_JITFollowBranch;
     packet >> m_net_settings.m_FastDiscSpeed;
+    packet >> m_net_settings.m_InstantDisc;
+    for (bool& instant_transfer : m_net_settings.m_MemcardInstantTransfer)
+      packet >> instant_transfer;
     packet >> m_net_settings.m_MMU;
     packet >> m_net_settings.m_Fastmem;
     packet >> m_net_settings.m_SkipIPL;
@@ -990,6 +988,14 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
     OnSyncSaveDataRaw(packet);
     break;
 
+  case SyncSaveDataID::RawDataHashRequest:
+    OnSyncSaveDataRawHashRequest(packet);
+    break;
+
+  case SyncSaveDataID::RawDataDelta:
+    OnSyncSaveDataRawDelta(packet);
+    break;
+
   case SyncSaveDataID::GCIData:
     OnSyncSaveDataGCI(packet);
     break;
@@ -1019,6 +1025,37 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
     m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
 }
 
+static std::optional<std::string> GetNetPlayMemcardPath(bool is_slot_a, const std::string& region,
+                                                        int size_override)
+{
+  // This check is mainly intended to filter out characters which have special meanings in paths
+  if (region != JAP_DIR && region != USA_DIR && region != EUR_DIR)
+    return std::nullopt;
+
+  std::string size_suffix;
+  if (size_override >= 0 && size_override <= 4)
+  {
+    size_suffix = fmt::format(
+        ".{}", Memcard::MbitToFreeBlocks(Memcard::MBIT_SIZE_MEMORY_CARD_59 << size_override));
+  }
+
+  return File::GetUserPath(D_GCUSER_IDX) + GC_MEMCARD_NETPLAY + (is_slot_a ? "A." : "B.") +
+         region + size_suffix + ".raw";
+}
+
+static std::optional<std::vector<u8>> ReadNetPlayMemcard(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  if (!file)
+    return std::nullopt;
+
+  std::vector<u8> data(file.GetSize());
+  if (!file.ReadBytes(data.data(), data.size()))
+    return std::nullopt;
+
+  return data;
+}
+
 void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
 {
   bool is_slot_a;
@@ -1026,22 +1063,15 @@ void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
   int size_override;
   packet >> is_slot_a >> region >> size_override;
 
-  // This check is mainly intended to filter out characters which have special meanings in paths
-  if (region != JAP_DIR && region != USA_DIR && region != EUR_DIR)
+  const std::optional<std::string> memcard_path =
+      GetNetPlayMemcardPath(is_slot_a, region, size_override);
+  if (!memcard_path)
   {
     SyncSaveDataResponse(false);
     return;
   }
 
-  std::string size_suffix;
-  if (size_override >= 0 && size_override <= 4)
-  {
-    size_suffix = fmt::format(
-        ".{}", Memcard::MbitToFreeBlocks(Memcard::MBIT_SIZE_MEMORY_CARD_59 << size_override));
-  }
-
-  const std::string path = File::GetUserPath(D_GCUSER_IDX) + GC_MEMCARD_NETPLAY +
-                           (is_slot_a ? "A." : "B.") + region + size_suffix + ".raw";
+  const std::string& path = *memcard_path;
   if (File::Exists(path) && !File::Delete(path))
   {
     PanicAlertFmtT("Failed to delete NetPlay memory card. Verify your write permissions.");
@@ -1053,6 +1083,104 @@ void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
   SyncSaveDataResponse(success);
 }
 
+void NetPlayClient::OnSyncSaveDataRawHashRequest(sf::Packet& packet)
+{
+  bool is_slot_a;
+  std::string region;
+  int size_override;
+  packet >> is_slot_a >> region >> size_override;
+
+  const std::optional<std::string> path = GetNetPlayMemcardPath(is_slot_a, region, size_override);
+  if (!path)
+  {
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  // The card from the last session is usually close to the host's, so the host only needs to send
+  // the blocks that differ. Without a card, no hashes are sent and the host sends all of it.
+  std::vector<u64> hashes;
+  if (const std::optional<std::vector<u8>> data = ReadNetPlayMemcard(*path))
+    hashes = HashMemcardBlocks(*data);
+  if (hashes.size() > MAX_MEMCARD_BLOCK_COUNT)
+    hashes.clear();
+
+  sf::Packet response_packet;
+  response_packet << MessageID::SyncSaveData;
+  response_packet << SyncSaveDataID::RawDataHashes;
+  response_packet << is_slot_a << static_cast<u32>(hashes.size());
+  for (const u64 hash : hashes)
+    response_packet << sf::Uint64{hash};
+
+  Send(response_packet);
+}
+
+void NetPlayClient::OnSyncSaveDataRawDelta(sf::Packet& packet)
+{
+  bool is_slot_a;
+  std::string region;
+  int size_override;
+  packet >> is_slot_a >> region >> size_override;
+
+  const u64 size = Common::PacketReadU64(packet);
+  u32 block_count;
+  packet >> block_count;
+  if (!packet || size > u64{MAX_MEMCARD_BLOCK_COUNT} * Memcard::BLOCK_SIZE ||
+      block_count > MAX_MEMCARD_BLOCK_COUNT)
+  {
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  std::vector<u32> block_indices(block_count);
+  for (u32& index : block_indices)
+    packet >> index;
+
+  const std::optional<std::string> path = GetNetPlayMemcardPath(is_slot_a, region, size_override);
+  const std::optional<std::vector<u8>> blocks = ZstdDecompressPacketIntoBuffer(packet);
+  if (!path || !blocks)
+  {
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  // The host only sends a delta if this client reported having a card
+  std::optional<std::vector<u8>> data = ReadNetPlayMemcard(*path);
+  if (!data)
+  {
+    SyncSaveDataResponse(false);
+    return;
+  }
+  data->resize(size);
+
+  size_t offset = 0;
+  for (const u32 index : block_indices)
+  {
+    const u64 block_offset = u64{index} * Memcard::BLOCK_SIZE;
+    if (block_offset >= size)
+    {
+      SyncSaveDataResponse(false);
+      return;
+    }
+
+    const size_t length =
+        static_cast<size_t>(std::min<u64>(Memcard::BLOCK_SIZE, size - block_offset));
+    if (blocks->size() - offset < length)
+    {
+      SyncSaveDataResponse(false);
+      return;
+    }
+
+    std::copy_n(blocks->begin() + offset, length, data->begin() + block_offset);
+    offset += length;
+  }
+
+  File::IOFile file(*path, "wb");
+  const bool success =
+      offset == blocks->size() && file && file.WriteBytes(data->data(), data->size());
+  SyncSaveDataResponse(success);
+}
+
 void NetPlayClient::OnSyncSaveDataGCI(sf::Packet& packet)
 {
   bool is_slot_a;
@@ -1616,27 +1744,19 @@ void NetPlayClient::SendChatMessage(const std::string& msg)
 
 // called from ---CPU--- thread
 void NetPlayClient::AddPadStateToPacket(const int in_game_pad, const GCPadStatus& pad,
-                                        sf::Packet& packet)
+                                        sf::Packet& packet, PadStatusDelta& delta)
 {
-  packet << static_cast<PadIndex>(in_game_pad);
-  packet << pad.button;
-  if (!m_gba_config[in_game_pad].enabled)
-  {
-    packet << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-           << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
-  }
+  delta.Write(packet, static_cast<PadIndex>(in_game_pad), pad, m_gba_config[in_game_pad].enabled);
 }
 
 // called from ---CPU--- thread
-void NetPlayClient::SendWiimoteState(const int in_game_pad, const WiimoteInput& nw)
+void NetPlayClient::AddWiimoteStateToPacket(const int in_game_pad, const WiimoteInput& nw,
+                                            sf::Packet& packet)
 {
-  sf::Packet packet;
-  packet << MessageID::WiimoteData;
   packet << static_cast<PadIndex>(in_game_pad);
   packet << static_cast<u8>(nw.report_id);
   packet << static_cast<u8>(nw.data.size());
   packet.append(nw.data.data(), nw.data.size());
-  SendAsync(std::move(packet));
 }
 
 // called from ---GUI--- thread
@@ -1956,11 +2076,12 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     sf::Packet packet;
     packet << MessageID::PadData;
 
+    PadStatusDelta delta;
     bool send_packet = false;
     const int num_local_pads = NumLocalPads();
     for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
     {
-      send_packet = PollLocalPad(local_pad, packet) || send_packet;
+      send_packet = PollLocalPad(local_pad, packet, delta) || send_packet;
     }
 
     if (send_packet)
@@ -1977,7 +2098,8 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     {
       sf::Packet packet;
       packet << MessageID::PadData;
-      if (PollLocalPad(local_pad, packet))
+      PadStatusDelta delta;
+      if (PollLocalPad(local_pad, packet, delta))
         SendAsync(std::move(packet));
     }
 
@@ -2057,14 +2179,23 @@ bool NetPlayClient::WiimoteUpdate(int _number, u8* data, const std::size_t size,
     {
       nw.data.assign(data, data + size);
 
+      // All states that are added to fill up the buffer go in one packet
+      sf::Packet packet;
+      packet << MessageID::WiimoteData;
+      bool send_packet = false;
+
       // TODO: add a seperate setting for wiimote buffer?
       while (m_wiimote_buffer[_number].Size() <= m_target_buffer_size * 200 / 120)
       {
         // add to buffer
         m_wiimote_buffer[_number].Push(nw);
 
-        SendWiimoteState(_number, nw);
+        AddWiimoteStateToPacket(_number, nw, packet);
+        send_packet = true;
       }
+
+      if (send_packet)
+        SendAsync(std::move(packet));
     }
 
   }  // unlock players
@@ -2120,7 +2251,7 @@ bool NetPlayClient::WiimoteUpdate(int _number, u8* data, const std::size_t size,
   return true;
 }
 
-bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
+bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet, PadStatusDelta& delta)
 {
   const int ingame_pad = LocalPadToInGamePad(local_pad);
   bool data_added = false;
@@ -2145,7 +2276,7 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
     if (m_local_player->pid != m_current_golfer)
     {
       // add to packet
-      AddPadStateToPacket(ingame_pad, pad_status, packet);
+      AddPadStateToPacket(ingame_pad, pad_status, packet, delta);
       data_added = true;
     }
     else
@@ -2165,7 +2296,7 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
       m_pad_buffer[ingame_pad].Push(pad_status);
 
       // add to packet
-      AddPadStateToPacket(ingame_pad, pad_status, packet);
+      AddPadStateToPacket(ingame_pad, pad_status, packet, delta);
       data_added = true;
     }
   }
@@ -2192,6 +2323,7 @@ void NetPlayClient::SendPadHostPoll(const PadIndex pad_num)
 
   sf::Packet packet;
   packet << MessageID::PadHostData;
+  PadStatusDelta delta;
 
   if (pad_num < 0)
   {
@@ -2216,7 +2348,7 @@ void NetPlayClient::SendPadHostPoll(const PadIndex pad_num)
 
       const GCPadStatus& pad_status = m_last_pad_status[i];
       m_pad_buffer[i].Push(pad_status);
-      AddPadStateToPacket(static_cast<int>(i), pad_status, packet);
+      AddPadStateToPacket(static_cast<int>(i), pad_status, packet, delta);
     }
   }
   else if (m_pad_map[pad_num] != 0)
@@ -2233,7 +2365,7 @@ void NetPlayClient::SendPadHostPoll(const PadIndex pad_num)
     {
       const GCPadStatus& pad_status = m_last_pad_status[pad_num];
       m_pad_buffer[pad_num].Push(pad_status);
-      AddPadStateToPacket(pad_num, pad_status, packet);
+      AddPadStateToPacket(pad_num, pad_status, packet, delta);
     }
   }
 
@@ -19,6 +19,7 @@
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayCommon.h"
 #include "Core/NetPlayProto.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
@@ -238,12 +239,13 @@ private:
   void SyncSaveDataResponse(bool success);
   void SyncCodeResponse(bool success);
 
-  bool PollLocalPad(int local_pad, sf::Packet& packet);
+  bool PollLocalPad(int local_pad, sf::Packet& packet, PadStatusDelta& delta);
   void SendPadHostPoll(PadIndex pad_num);
 
   void UpdateDevices();
-  void AddPadStateToPacket(int in_game_pad, const GCPadStatus& np, sf::Packet& packet);
-  void SendWiimoteState(int in_game_pad, const WiimoteInput& nw);
+  void AddPadStateToPacket(int in_game_pad, const GCPadStatus& np, sf::Packet& packet,
+                           PadStatusDelta& delta);
+  void AddWiimoteStateToPacket(int in_game_pad, const WiimoteInput& nw, sf::Packet& packet);
   void Send(const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
   void Disconnect();
   bool Connect();
@@ -282,6 +284,8 @@ private:
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
   void OnSyncSaveDataRaw(sf::Packet& packet);
+  void OnSyncSaveDataRawHashRequest(sf::Packet& packet);
+  void OnSyncSaveDataRawDelta(sf::Packet& packet);
   void OnSyncSaveDataGCI(sf::Packet& packet);
   void OnSyncSaveDataWii(sf::Packet& packet);
   void OnSyncSaveDataGBA(sf::Packet& packet);
@@ -7,8 +7,10 @@
 
 #include <fmt/format.h>
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/SFMLHelper.h"
@@ -297,4 +299,162 @@ std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
 
   return out_buffer;
 }
+
+bool ZstdCompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet)
+{
+  const sf::Uint64 size = in_buffer.size();
+  packet << size;
+
+  if (size == 0)
+    return true;
+
+  std::vector<u8> out_buffer(ZSTD_compressBound(in_buffer.size()));
+  const size_t out_size = ZSTD_compress(out_buffer.data(), out_buffer.size(), in_buffer.data(),
+                                        in_buffer.size(), ZSTD_CLEVEL_DEFAULT);
+  if (ZSTD_isError(out_size))
+  {
+    PanicAlertFmtT("Internal zstd Error - compression failed");
+    return false;
+  }
+
+  packet << static_cast<u32>(out_size);
+  packet.append(out_buffer.data(), out_size);
+  return true;
+}
+
+std::optional<std::vector<u8>> ZstdDecompressPacketIntoBuffer(sf::Packet& packet)
+{
+  const u64 size = Common::PacketReadU64(packet);
+
+  std::vector<u8> out_buffer(size);
+
+  if (size == 0)
+    return out_buffer;
+
+  u32 in_size = 0;
+  packet >> in_size;
+
+  std::vector<u8> in_buffer(in_size);
+  for (u8& byte : in_buffer)
+    packet >> byte;
+
+  if (!packet)
+    return {};
+
+  const size_t result =
+      ZSTD_decompress(out_buffer.data(), out_buffer.size(), in_buffer.data(), in_buffer.size());
+  if (ZSTD_isError(result) || result != size)
+  {
+    PanicAlertFmtT("Internal zstd Error - decompression failed");
+    return {};
+  }
+
+  return out_buffer;
+}
+
+enum PadStatusField : u8
+{
+  PAD_FIELD_BUTTON = 1 << 0,
+  PAD_FIELD_ANALOG = 1 << 1,
+  PAD_FIELD_STICK = 1 << 2,
+  PAD_FIELD_SUBSTICK = 1 << 3,
+  PAD_FIELD_TRIGGERS = 1 << 4,
+  PAD_FIELD_CONNECTED = 1 << 5,
+};
+
+void PadStatusDelta::Write(sf::Packet& packet, PadIndex map, const GCPadStatus& pad,
+                           bool buttons_only)
+{
+  GCPadStatus& previous = m_previous.at(map);
+
+  u8 fields = 0;
+  if (pad.button != previous.button)
+    fields |= PAD_FIELD_BUTTON;
+  if (!buttons_only)
+  {
+    if (pad.analogA != previous.analogA || pad.analogB != previous.analogB)
+      fields |= PAD_FIELD_ANALOG;
+    if (pad.stickX != previous.stickX || pad.stickY != previous.stickY)
+      fields |= PAD_FIELD_STICK;
+    if (pad.substickX != previous.substickX || pad.substickY != previous.substickY)
+      fields |= PAD_FIELD_SUBSTICK;
+    if (pad.triggerLeft != previous.triggerLeft || pad.triggerRight != previous.triggerRight)
+      fields |= PAD_FIELD_TRIGGERS;
+    if (pad.isConnected != previous.isConnected)
+      fields |= PAD_FIELD_CONNECTED;
+  }
+
+  packet << map << fields;
+  if (fields & PAD_FIELD_BUTTON)
+  {
+    packet << pad.button;
+    previous.button = pad.button;
+  }
+  if (fields & PAD_FIELD_ANALOG)
+  {
+    packet << pad.analogA << pad.analogB;
+    previous.analogA = pad.analogA;
+    previous.analogB = pad.analogB;
+  }
+  if (fields & PAD_FIELD_STICK)
+  {
+    packet << pad.stickX << pad.stickY;
+    previous.stickX = pad.stickX;
+    previous.stickY = pad.stickY;
+  }
+  if (fields & PAD_FIELD_SUBSTICK)
+  {
+    packet << pad.substickX << pad.substickY;
+    previous.substickX = pad.substickX;
+    previous.substickY = pad.substickY;
+  }
+  if (fields & PAD_FIELD_TRIGGERS)
+  {
+    packet << pad.triggerLeft << pad.triggerRight;
+    previous.triggerLeft = pad.triggerLeft;
+    previous.triggerRight = pad.triggerRight;
+  }
+  if (fields & PAD_FIELD_CONNECTED)
+  {
+    packet << pad.isConnected;
+    previous.isConnected = pad.isConnected;
+  }
+}
+
+bool PadStatusDelta::Read(sf::Packet& packet, PadIndex* map, GCPadStatus* pad)
+{
+  u8 fields = 0;
+  packet >> *map >> fields;
+  if (!packet || *map < 0 || static_cast<size_t>(*map) >= m_previous.size())
+    return false;
+
+  GCPadStatus& previous = m_previous[*map];
+  if (fields & PAD_FIELD_BUTTON)
+    packet >> previous.button;
+  if (fields & PAD_FIELD_ANALOG)
+    packet >> previous.analogA >> previous.analogB;
+  if (fields & PAD_FIELD_STICK)
+    packet >> previous.stickX >> previous.stickY;
+  if (fields & PAD_FIELD_SUBSTICK)
+    packet >> previous.substickX >> previous.substickY;
+  if (fields & PAD_FIELD_TRIGGERS)
+    packet >> previous.triggerLeft >> previous.triggerRight;
+  if (fields & PAD_FIELD_CONNECTED)
+    packet >> previous.isConnected;
+
+  *pad = previous;
+  return static_cast<bool>(packet);
+}
+
+std::vector<u64> HashMemcardBlocks(const std::vector<u8>& data)
+{
+  std::vector<u64> hashes;
+  hashes.reserve((data.size() + Memcard::BLOCK_SIZE - 1) / Memcard::BLOCK_SIZE);
+  for (size_t offset = 0; offset < data.size(); offset += Memcard::BLOCK_SIZE)
+  {
+    const size_t length = std::min<size_t>(Memcard::BLOCK_SIZE, data.size() - offset);
+    hashes.push_back(Common::HashXXH64(data.data() + offset, length));
+  }
+  return hashes;
+}
 }  // namespace NetPlay
@@ -11,15 +11,46 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/HW/GCMemcard/GCMemcard.h"
+#include "Core/NetPlayProto.h"
+#include "InputCommon/GCPadStatus.h"
 
 namespace NetPlay
 {
 constexpr u32 PEER_TIMEOUT = 30000;
 
+// The number of blocks of the largest raw memory card
+constexpr u32 MAX_MEMCARD_BLOCK_COUNT =
+    Memcard::MBIT_SIZE_MEMORY_CARD_2043 * Memcard::MBIT_TO_BLOCKS;
+
 bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet);
 bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet);
 bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet);
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
 bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
+
+// Used for the memory card deltas, which only contain the blocks that differ between the copies
+// of the server and a client. Unlike the functions above, the data is compressed in one piece.
+bool ZstdCompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet);
+std::optional<std::vector<u8>> ZstdDecompressPacketIntoBuffer(sf::Packet& packet);
+
+// Returns the hash of every Memcard::BLOCK_SIZE bytes of a raw memory card. The last hash covers
+// whatever is left if the size isn't a multiple of the block size.
+std::vector<u64> HashMemcardBlocks(const std::vector<u8>& data);
+
+// Pad states are sent as the fields that differ from the previous state of the same pad in the
+// packet, starting from a default GCPadStatus. Filling up the pad buffer adds the same state
+// several times in a row, which then only takes two bytes each. A packet must be read with the
+// same sequence of calls it was written with, using one PadStatusDelta per packet.
+class PadStatusDelta
+{
+public:
+  void Write(sf::Packet& packet, PadIndex map, const GCPadStatus& pad, bool buttons_only);
+  // Returns false if the packet is malformed.
+  bool Read(sf::Packet& packet, PadIndex* map, GCPadStatus* pad);
+
+private:
+  std::array<GCPadStatus, 4> m_previous{};
+};
 }  // namespace NetPlay
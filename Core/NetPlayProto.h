@@ -73,6 +73,8 @@ struct NetSettings
   float m_SyncGpuOverclock = 0;
   bool m_JITFollowBranch = false;
   bool m_FastDiscSpeed = false;
+  bool m_InstantDisc = false;
+  std::array<bool, 2> m_MemcardInstantTransfer{};
   bool m_MMU = false;
   bool m_Fastmem = false;
   bool m_SkipIPL = false;
@@ -203,7 +205,10 @@ enum class SyncSaveDataID : u8
   RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  GBAData = 6,
+  RawDataHashRequest = 7,
+  RawDataHashes = 8,
+  RawDataDelta = 9,
 };
 
 enum class SyncCodeID : u8
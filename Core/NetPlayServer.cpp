@@ -7,6 +7,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -22,6 +23,7 @@
 #include "Common/ENetUtil.h"
 #include "Common/FileUtil.h"
 #include "Common/HttpRequest.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/SFMLHelper.h"
@@ -268,14 +270,19 @@ void NetPlayServer::ThreadFunc()
       {
         std::lock_guard lkp(m_crit.players);
         auto& e = m_async_queue.Front();
-        if (e.target_mode == TargetMode::Only)
+        if (!e.packet)
+        {
+          ERROR_LOG_FMT(NETPLAY, "Failed to allocate a packet");
+        }
+        else if (e.target_mode == TargetMode::Only)
         {
-          if (m_players.find(e.target_pid) != m_players.end())
-            Send(m_players.at(e.target_pid).socket, e.packet, e.channel_id);
+          const auto it = m_players.find(e.target_pid);
+          if (it != m_players.end())
+            enet_peer_send(it->second.socket, e.channel_id, e.packet.get());
         }
         else
         {
-          SendToClients(e.packet, e.target_pid, e.channel_id);
+          SendToClients(e.packet.get(), e.target_pid, e.channel_id);
         }
       }
       m_async_queue.Pop();
@@ -690,22 +697,28 @@ void NetPlayServer::SetHostInputAuthority(const bool enable)
     AdjustPadBufferSize(m_target_buffer_size);
 }
 
+// The packet gets copied into an ENet packet right away, which then goes to every target as is
 void NetPlayServer::SendAsync(sf::Packet&& packet, const PlayerId pid, const u8 channel_id)
 {
-  {
-    std::lock_guard lkq(m_crit.async_queue_write);
-    m_async_queue.Push(AsyncQueueEntry{std::move(packet), pid, TargetMode::Only, channel_id});
-  }
-  ENetUtil::WakeupThread(m_server);
+  QueueAsync(
+      ENetUtil::CreatePacket(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE),
+      pid, TargetMode::Only, channel_id);
 }
 
 void NetPlayServer::SendAsyncToClients(sf::Packet&& packet, const PlayerId skip_pid,
                                        const u8 channel_id)
+{
+  QueueAsync(
+      ENetUtil::CreatePacket(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE),
+      skip_pid, TargetMode::AllExcept, channel_id);
+}
+
+void NetPlayServer::QueueAsync(ENetUtil::PacketPtr packet, const PlayerId pid,
+                               const TargetMode target_mode, const u8 channel_id)
 {
   {
     std::lock_guard lkq(m_crit.async_queue_write);
-    m_async_queue.Push(
-        AsyncQueueEntry{std::move(packet), skip_pid, TargetMode::AllExcept, channel_id});
+    m_async_queue.Push(AsyncQueueEntry{std::move(packet), pid, target_mode, channel_id});
   }
   ENetUtil::WakeupThread(m_server);
 }
@@ -791,10 +804,14 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     sf::Packet spac;
     spac << (m_host_input_authority ? MessageID::PadHostData : MessageID::PadData);
 
+    PadStatusDelta in_delta;
+    PadStatusDelta out_delta;
     while (!packet.endOfPacket())
     {
       PadIndex map;
-      packet >> map;
+      GCPadStatus pad;
+      if (!in_delta.Read(packet, &map, &pad))
+        return 1;
 
       // If the data is not from the correct player,
       // then disconnect them.
@@ -803,17 +820,7 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         return 1;
       }
 
-      GCPadStatus pad;
-      packet >> pad.button;
-      spac << map << pad.button;
-      if (!m_gba_config.at(map).enabled)
-      {
-        packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
-            pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-
-        spac << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-             << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
-      }
+      out_delta.Write(spac, map, pad, m_gba_config.at(map).enabled);
     }
 
     if (m_host_input_authority)
@@ -838,22 +845,16 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     sf::Packet spac;
     spac << MessageID::PadData;
 
+    PadStatusDelta in_delta;
+    PadStatusDelta out_delta;
     while (!packet.endOfPacket())
     {
       PadIndex map;
-      packet >> map;
-
       GCPadStatus pad;
-      packet >> pad.button;
-      spac << map << pad.button;
-      if (!m_gba_config.at(map).enabled)
-      {
-        packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
-            pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+      if (!in_delta.Read(packet, &map, &pad))
+        return 1;
 
-        spac << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-             << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
-      }
+      out_delta.Write(spac, map, pad, m_gba_config.at(map).enabled);
     }
 
     SendToClients(spac, player.pid);
@@ -866,28 +867,34 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (player.current_game != m_current_game)
       break;
 
-    PadIndex map;
-    u8 size;
-    packet >> map >> size;
-    std::vector<u8> data(size);
-    for (u8& byte : data)
-      packet >> byte;
+    sf::Packet spac;
+    spac << MessageID::WiimoteData;
 
-    // If the data is not from the correct player,
-    // then disconnect them.
-    if (m_wiimote_map.at(map) != player.pid)
+    while (!packet.endOfPacket())
     {
-      return 1;
+      PadIndex map;
+      u8 report_id;
+      u8 size;
+      packet >> map >> report_id >> size;
+      std::vector<u8> data(size);
+      for (u8& byte : data)
+        packet >> byte;
+
+      if (!packet)
+        return 1;
+
+      // If the data is not from the correct player,
+      // then disconnect them.
+      if (m_wiimote_map.at(map) != player.pid)
+      {
+        return 1;
+      }
+
+      spac << map << report_id << size;
+      spac.append(data.data(), data.size());
     }
 
     // relay to clients
-    sf::Packet spac;
-    spac << MessageID::WiimoteData;
-    spac << map;
-    spac << size;
-    for (const u8& byte : data)
-      spac << byte;
-
     SendToClients(spac, player.pid);
   }
   break;
@@ -1125,6 +1132,10 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         if (m_save_data_synced_players >= m_players.size() - 1)
         {
           m_dialog->AppendChat(Common::GetStringT("All players' saves synchronized."));
+          {
+            std::lock_guard lkg(m_crit.game);
+            m_raw_memcard_syncs = {};
+          }
 
           // Saves are synced, check if codes are as well and attempt to start the game
           m_saves_synced = true;
@@ -1134,6 +1145,9 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     break;
 
+    case SyncSaveDataID::RawDataHashes:
+      return OnSyncSaveDataRawHashes(packet, player);
+
     case SyncSaveDataID::Failure:
     {
       m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
@@ -1359,6 +1373,9 @@ bool NetPlayServer::SetupNetSettings()
   settings.m_SyncGpuOverclock = Config::Get(Config::MAIN_SYNC_GPU_OVERCLOCK);
   settings.m_JITFollowBranch = Config::Get(Config::MAIN_JIT_FOLLOW_BRANCH);
   settings.m_FastDiscSpeed = Config::Get(Config::MAIN_FAST_DISC_SPEED);
+  settings.m_InstantDisc = Config::Get(Config::MAIN_INSTANT_DISC);
+  settings.m_MemcardInstantTransfer = {Config::Get(Config::MAIN_MEMCARD_A_INSTANT_TRANSFER),
+                                       Config::Get(Config::MAIN_MEMCARD_B_INSTANT_TRANSFER)};
   settings.m_MMU = Config::Get(Config::MAIN_MMU);
   settings.m_Fastmem = Config::Get(Config::MAIN_FASTMEM);
   settings.m_SkipIPL = Config::Get(Config::MAIN_SKIP_IPL) || !DoAllPlayersHaveIPLDump();
@@ -1539,6 +1556,9 @@ bool NetPlayServer::StartGame()
   spac << m_settings.m_SyncGpuOverclock;
   spac << m_settings.m_JITFollowBranch;
   spac << m_settings.m_FastDiscSpeed;
+  spac << m_settings.m_InstantDisc;
+  for (bool instant_transfer : m_settings.m_MemcardInstantTransfer)
+    spac << instant_transfer;
   spac << m_settings.m_MMU;
   spac << m_settings.m_Fastmem;
   spac << m_settings.m_SkipIPL;
@@ -1599,6 +1619,70 @@ void NetPlayServer::AbortGameStart()
   }
 }
 
+// called from ---NETPLAY--- thread
+unsigned int NetPlayServer::OnSyncSaveDataRawHashes(sf::Packet& packet, const Client& player)
+{
+  bool is_slot_a;
+  u32 block_count;
+  packet >> is_slot_a >> block_count;
+  if (!packet || block_count > MAX_MEMCARD_BLOCK_COUNT)
+    return 1;
+
+  std::vector<u64> client_hashes(block_count);
+  for (u64& hash : client_hashes)
+    hash = Common::PacketReadU64(packet);
+
+  std::lock_guard lkg(m_crit.game);
+  const std::optional<RawMemcardSync>& card = m_raw_memcard_syncs[is_slot_a ? 0 : 1];
+  // The game start may have been aborted in the meantime
+  if (!m_start_pending || !card)
+    return 0;
+
+  sf::Packet pac;
+  pac << MessageID::SyncSaveData;
+
+  if (client_hashes.empty())
+  {
+    // The client has no card of its own, so send all of it
+    pac << SyncSaveDataID::RawData;
+    pac << is_slot_a << card->region << card->size_override;
+    if (!CompressBufferIntoPacket(card->data, pac))
+      return 0;
+  }
+  else
+  {
+    std::vector<u32> block_indices;
+    std::vector<u8> blocks;
+    for (u32 i = 0; i < card->block_hashes.size(); ++i)
+    {
+      if (i < client_hashes.size() && client_hashes[i] == card->block_hashes[i])
+        continue;
+
+      const size_t offset = size_t{i} * Memcard::BLOCK_SIZE;
+      const size_t length = std::min<size_t>(Memcard::BLOCK_SIZE, card->data.size() - offset);
+      block_indices.push_back(i);
+      blocks.insert(blocks.end(), card->data.begin() + offset,
+                    card->data.begin() + offset + length);
+    }
+
+    pac << SyncSaveDataID::RawDataDelta;
+    pac << is_slot_a << card->region << card->size_override;
+    pac << static_cast<sf::Uint64>(card->data.size());
+    pac << static_cast<u32>(block_indices.size());
+    for (const u32 index : block_indices)
+      pac << index;
+    if (!ZstdCompressBufferIntoPacket(blocks, pac))
+      return 0;
+
+    INFO_LOG_FMT(NETPLAY, "Sending {} of {} memory card blocks to player {}",
+                 block_indices.size(), card->block_hashes.size(), player.pid);
+  }
+
+  SendChunked(std::move(pac), player.pid,
+              fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+  return 0;
+}
+
 // called from ---GUI--- thread
 bool NetPlayServer::SyncSaveData()
 {
@@ -1606,6 +1690,10 @@ bool NetPlayServer::SyncSaveData()
   m_saves_synced = false;
 
   m_save_data_synced_players = 0;
+  {
+    std::lock_guard lkg(m_crit.game);
+    m_raw_memcard_syncs = {};
+  }
 
   u8 save_count = 0;
 
@@ -1681,24 +1769,42 @@ bool NetPlayServer::SyncSaveData()
               Memcard::MBIT_SIZE_MEMORY_CARD_2043;
       const std::string path = Config::GetMemcardPath(slot, game_region, card_size_mbits);
 
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::RawData;
-      pac << is_slot_a << region << size_override;
-
       if (File::Exists(path))
       {
-        if (!CompressFileIntoPacket(path, pac))
+        RawMemcardSync card{region, size_override};
+        File::IOFile file(path, "rb");
+        card.data.resize(file.GetSize());
+        if (!file.ReadBytes(card.data.data(), card.data.size()))
           return false;
+        card.block_hashes = HashMemcardBlocks(card.data);
+
+        {
+          std::lock_guard lkg(m_crit.game);
+          m_raw_memcard_syncs[is_slot_a ? 0 : 1] = std::move(card);
+        }
+
+        // Each client replies with the hashes of the card it has from earlier sessions, which
+        // OnSyncSaveDataRawHashes answers with the blocks that differ
+        sf::Packet pac;
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::RawDataHashRequest;
+        pac << is_slot_a << region << size_override;
+
+        SendAsyncToClients(std::move(pac), 1, CHUNKED_DATA_CHANNEL);
       }
       else
       {
+        sf::Packet pac;
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::RawData;
+        pac << is_slot_a << region << size_override;
+
         // No file, so we'll say the size is 0
         pac << sf::Uint64{0};
-      }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+        SendChunkedToClients(std::move(pac), 1,
+                             fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      }
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
@@ -2045,12 +2151,31 @@ u64 NetPlayServer::GetInitialNetPlayRTC() const
 // called from multiple threads
 void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_pid,
                                   const u8 channel_id)
+{
+  ENetUtil::PacketPtr epac =
+      ENetUtil::CreatePacket(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE);
+
+  // A packet the peers hold on to may only be released by the thread servicing them, so other
+  // threads hand it over like SendAsyncToClients does
+  if (std::this_thread::get_id() != m_thread.get_id())
+  {
+    QueueAsync(std::move(epac), skip_pid, TargetMode::AllExcept, channel_id);
+    return;
+  }
+
+  if (epac)
+    SendToClients(epac.get(), skip_pid, channel_id);
+}
+
+// Every client gets the same packet, ENet keeps it around until all of them are done with it
+void NetPlayServer::SendToClients(ENetPacket* packet, const PlayerId skip_pid,
+                                  const u8 channel_id)
 {
   for (auto& p : m_players)
   {
     if (p.second.pid && p.second.pid != skip_pid)
     {
-      Send(p.second.socket, packet, channel_id);
+      enet_peer_send(p.second.socket, channel_id, packet);
     }
   }
 }
@@ -2233,11 +2358,19 @@ void NetPlayServer::ChunkedDataThreadFunc()
 
         auto start = std::chrono::steady_clock::now();
 
-        sf::Packet pac;
-        pac << MessageID::ChunkedDataPayload;
-        pac << id;
+        // The payload goes straight from the data into the ENet packet behind the header
+        sf::Packet header;
+        header << MessageID::ChunkedDataPayload;
+        header << id;
         size_t len = std::min(CHUNKED_DATA_UNIT_SIZE, e.packet.getDataSize() - index);
-        pac.append(static_cast<const u8*>(e.packet.getData()) + index, len);
+        ENetUtil::PacketPtr pac = ENetUtil::CreatePacket(nullptr, header.getDataSize() + len,
+                                                         ENET_PACKET_FLAG_RELIABLE);
+        if (pac)
+        {
+          std::memcpy(pac->data, header.getData(), header.getDataSize());
+          std::memcpy(pac->data + header.getDataSize(),
+                      static_cast<const u8*>(e.packet.getData()) + index, len);
+        }
 
         ChunkedDataSend(std::move(pac), e.target_pid, e.target_mode);
         index += CHUNKED_DATA_UNIT_SIZE;
@@ -2282,6 +2415,12 @@ void NetPlayServer::ChunkedDataSend(sf::Packet&& packet, const PlayerId pid,
   }
 }
 
+void NetPlayServer::ChunkedDataSend(ENetUtil::PacketPtr packet, const PlayerId pid,
+                                    const TargetMode target_mode)
+{
+  QueueAsync(std::move(packet), pid, target_mode, CHUNKED_DATA_CHANNEL);
+}
+
 void NetPlayServer::ChunkedDataAbort()
 {
   m_abort_chunked_data = true;
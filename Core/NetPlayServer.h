@@ -5,16 +5,20 @@
 
 #include <SFML/Network/Packet.hpp>
 
+#include <array>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <sstream>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include "Common/ENetUtil.h"
 #include "Common/Event.h"
 #include "Common/QoSSession.h"
 #include "Common/SPSCQueue.h"
@@ -105,7 +109,7 @@ private:
 
   struct AsyncQueueEntry
   {
-    sf::Packet packet;
+    ENetUtil::PacketPtr packet;
     PlayerId target_pid{};
     TargetMode target_mode{};
     u8 channel_id = 0;
@@ -119,15 +123,28 @@ private:
     std::string title;
   };
 
+  // A raw memory card that is waiting for the clients to report the blocks they already have
+  struct RawMemcardSync
+  {
+    std::string region;
+    int size_override = -1;
+    std::vector<u8> data;
+    std::vector<u64> block_hashes;
+  };
+
   bool SetupNetSettings();
   bool SyncSaveData();
+  unsigned int OnSyncSaveDataRawHashes(sf::Packet& packet, const Client& player);
   bool SyncCodes();
   void CheckSyncAndStartGame();
 
   u64 GetInitialNetPlayRTC() const;
 
+  void QueueAsync(ENetUtil::PacketPtr packet, PlayerId pid, TargetMode target_mode,
+                  u8 channel_id);
   void SendToClients(const sf::Packet& packet, PlayerId skip_pid = 0,
                      u8 channel_id = DEFAULT_CHANNEL);
+  void SendToClients(ENetPacket* packet, PlayerId skip_pid, u8 channel_id);
   void Send(ENetPeer* socket, const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
   ConnectionError OnConnect(ENetPeer* socket, sf::Packet& rpac);
   unsigned int OnDisconnect(const Client& player);
@@ -142,6 +159,7 @@ private:
   std::vector<std::pair<std::string, std::string>> GetInterfaceListInternal() const;
   void ChunkedDataThreadFunc();
   void ChunkedDataSend(sf::Packet&& packet, PlayerId pid, const TargetMode target_mode);
+  void ChunkedDataSend(ENetUtil::PacketPtr packet, PlayerId pid, const TargetMode target_mode);
   void ChunkedDataAbort();
 
   void SetupIndex();
@@ -160,6 +178,8 @@ private:
   GBAConfigArray m_gba_config;
   PadMappingArray m_wiimote_map;
   unsigned int m_save_data_synced_players = 0;
+  // Indexed by slot, A first. Guarded by m_crit.game.
+  std::array<std::optional<RawMemcardSync>, 2> m_raw_memcard_syncs;
   unsigned int m_codes_synced_players = 0;
   bool m_saves_synced = true;
   bool m_codes_synced = true;
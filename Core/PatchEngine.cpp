@@ -27,6 +27,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/GeckoCode.h"
 #include "Core/GeckoCodeConfig.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -223,6 +224,23 @@ void LoadPatches()
   LoadSpeedhacks("Speedhacks", merged);
 }
 
+// Frame patches are applied every frame, but what they write is almost always still in place from
+// the frame before. Reading memory back tells that better than remembering what was written, as the
+// game may write over a patch at any time. Only a patch that changes memory is written, and the
+// instruction cache and any JIT blocks are invalidated for it in case the patch is code.
+template <typename T>
+static void ApplyPatchEntry(const PatchEntry& entry, T (*read)(u32), void (*write)(u32, u32))
+{
+  const T current = read(entry.address);
+  if (entry.conditional && current != static_cast<T>(entry.comparand))
+    return;
+  if (current == static_cast<T>(entry.value))
+    return;
+
+  write(static_cast<T>(entry.value), entry.address);
+  JitInterface::InvalidateICache(entry.address, sizeof(T), false);
+}
+
 static void ApplyPatches(const std::vector<Patch>& patches)
 {
   for (const Patch& patch : patches)
@@ -231,22 +249,16 @@ static void ApplyPatches(const std::vector<Patch>& patches)
     {
       for (const PatchEntry& entry : patch.entries)
       {
-        u32 addr = entry.address;
-        u32 value = entry.value;
-        u32 comparand = entry.comparand;
         switch (entry.type)
         {
         case PatchType::Patch8Bit:
-          if (!entry.conditional || PowerPC::HostRead_U8(addr) == static_cast<u8>(comparand))
-            PowerPC::HostWrite_U8(static_cast<u8>(value), addr);
+          ApplyPatchEntry<u8>(entry, PowerPC::HostRead_U8, PowerPC::HostWrite_U8);
           break;
         case PatchType::Patch16Bit:
-          if (!entry.conditional || PowerPC::HostRead_U16(addr) == static_cast<u16>(comparand))
-            PowerPC::HostWrite_U16(static_cast<u16>(value), addr);
+          ApplyPatchEntry<u16>(entry, PowerPC::HostRead_U16, PowerPC::HostWrite_U16);
           break;
         case PatchType::Patch32Bit:
-          if (!entry.conditional || PowerPC::HostRead_U32(addr) == comparand)
-            PowerPC::HostWrite_U32(value, addr);
+          ApplyPatchEntry<u32>(entry, PowerPC::HostRead_U32, PowerPC::HostWrite_U32);
           break;
         default:
           // unknown patchtype
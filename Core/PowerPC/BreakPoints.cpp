@@ -16,8 +16,43 @@
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
 
+bool PageBitmap::TestRange(u32 start_address, u32 end_address) const
+{
+  if (m_bits.empty())
+    return false;
+
+  // A range that wraps around checks up to the end of the address space
+  if (end_address < start_address)
+    end_address = 0xFFFFFFFF;
+
+  for (u32 page = start_address >> PAGE_SHIFT; page <= end_address >> PAGE_SHIFT; ++page)
+  {
+    if (((m_bits[page / 64] >> (page % 64)) & 1) != 0)
+      return true;
+  }
+  return false;
+}
+
+void PageBitmap::MarkRange(u32 start_address, u32 end_address)
+{
+  if (m_bits.empty())
+    m_bits.resize((u64{1} << (32 - PAGE_SHIFT)) / 64);
+
+  for (u32 page = start_address >> PAGE_SHIFT; page <= end_address >> PAGE_SHIFT; ++page)
+    m_bits[page / 64] |= u64{1} << (page % 64);
+}
+
+void PageBitmap::Clear()
+{
+  m_bits.clear();
+  m_bits.shrink_to_fit();
+}
+
 bool BreakPoints::IsAddressBreakPoint(u32 address) const
 {
+  if (!m_pages.Test(address))
+    return false;
+
   return std::any_of(m_breakpoints.begin(), m_breakpoints.end(),
                      [address](const auto& bp) { return bp.address == address; });
 }
@@ -92,6 +127,7 @@ void BreakPoints::Add(const TBreakPoint& bp)
     return;
 
   m_breakpoints.push_back(bp);
+  m_pages.MarkRange(bp.address, bp.address);
 
   JitInterface::InvalidateICache(bp.address, 4, true);
 }
@@ -115,6 +151,7 @@ void BreakPoints::Add(u32 address, bool temp, bool break_on_hit, bool log_on_hit
   bp.address = address;
 
   m_breakpoints.push_back(bp);
+  m_pages.MarkRange(address, address);
 
   JitInterface::InvalidateICache(address, 4, true);
 }
@@ -140,6 +177,7 @@ void BreakPoints::Remove(u32 address)
     return;
 
   m_breakpoints.erase(iter);
+  UpdatePageBitmap();
   JitInterface::InvalidateICache(address, 4, true);
 }
 
@@ -151,6 +189,7 @@ void BreakPoints::Clear()
   }
 
   m_breakpoints.clear();
+  m_pages.Clear();
 }
 
 void BreakPoints::ClearAllTemporary()
@@ -168,6 +207,14 @@ void BreakPoints::ClearAllTemporary()
       ++bp;
     }
   }
+  UpdatePageBitmap();
+}
+
+void BreakPoints::UpdatePageBitmap()
+{
+  m_pages.Clear();
+  for (const TBreakPoint& bp : m_breakpoints)
+    m_pages.MarkRange(bp.address, bp.address);
 }
 
 MemChecks::TMemChecksStr MemChecks::GetStrings() const
@@ -214,13 +261,12 @@ void MemChecks::Add(const TMemCheck& memory_check)
   if (GetMemCheck(memory_check.start_address) != nullptr)
     return;
 
-  bool had_any = HasAny();
   Core::RunAsCPUThread([&] {
     m_mem_checks.push_back(memory_check);
-    // If this is the first one, clear the JIT cache so it can switch to
-    // watchpoint-compatible code.
-    if (!had_any)
-      JitInterface::ClearCache();
+    m_pages.MarkRange(memory_check.start_address, memory_check.end_address);
+    // Clear the JIT cache so it can switch to watchpoint-compatible code. The JIT only leaves
+    // out the checks for accesses to pages without memchecks, so this is needed for every one.
+    JitInterface::ClearCache();
     PowerPC::DBATUpdated();
   });
 }
@@ -248,8 +294,8 @@ void MemChecks::Remove(u32 address)
 
   Core::RunAsCPUThread([&] {
     m_mem_checks.erase(iter);
-    if (!HasAny())
-      JitInterface::ClearCache();
+    UpdatePageBitmap();
+    JitInterface::ClearCache();
     PowerPC::DBATUpdated();
   });
 }
@@ -258,13 +304,25 @@ void MemChecks::Clear()
 {
   Core::RunAsCPUThread([&] {
     m_mem_checks.clear();
+    m_pages.Clear();
     JitInterface::ClearCache();
     PowerPC::DBATUpdated();
   });
 }
 
+void MemChecks::UpdatePageBitmap()
+{
+  m_pages.Clear();
+  for (const TMemCheck& mc : m_mem_checks)
+    m_pages.MarkRange(mc.start_address, mc.end_address);
+}
+
 TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
 {
+  // Accesses are at most a few bytes, so this only looks at one or two pages
+  if (!m_pages.TestRange(address, static_cast<u32>(address + size - 1)))
+    return nullptr;
+
   const auto iter =
       std::find_if(m_mem_checks.begin(), m_mem_checks.end(), [address, size](const auto& mc) {
         return mc.end_address >= address && address + size - 1 >= mc.start_address;
@@ -282,6 +340,10 @@ bool MemChecks::OverlapsMemcheck(u32 address, u32 length) const
   if (!HasAny())
     return false;
 
+  // The bitmap has the exact answer for blocks made up of whole pages
+  if (length >= PageBitmap::PAGE_SIZE)
+    return m_pages.TestRange(address & ~(length - 1), address | (length - 1));
+
   const u32 page_end_suffix = length - 1;
   const u32 page_end_address = address | page_end_suffix;
 
@@ -299,6 +361,18 @@ bool TMemCheck::Action(Common::DebugInterface* debug_interface, u64 value, u32 a
   if (!is_enabled)
     return false;
 
+  if (record_reads)
+  {
+    if (!write)
+    {
+      const u32 first = std::max(addr, start_address);
+      const u32 last = std::min<u32>(addr + static_cast<u32>(size) - 1, end_address);
+      for (u32 i = first; i <= last; ++i)
+        read_bytes[i - start_address] = true;
+    }
+    return false;
+  }
+
   if ((write && is_break_on_write) || (!write && is_break_on_read))
   {
     if (log_on_hit)
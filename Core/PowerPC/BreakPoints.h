@@ -39,11 +39,43 @@ struct TMemCheck
 
   u32 num_hits = 0;
 
+  // Instead of logging or breaking, mark every byte of the range a read touches in read_bytes,
+  // which then holds one entry per byte of the range.
+  bool record_reads = false;
+  std::vector<bool> read_bytes;
+
   // returns whether to break
   bool Action(Common::DebugInterface* debug_interface, u64 value, u32 addr, bool write, size_t size,
               u32 pc);
 };
 
+// One bit per page of the 32-bit address space, telling whether anything is set on that page.
+// The bitmap is only allocated once a page gets marked, so that the common case of nothing being
+// on a page is a single bit test without costing any memory when nothing is set at all.
+class PageBitmap
+{
+public:
+  static constexpr u32 PAGE_SHIFT = 12;
+  static constexpr u32 PAGE_SIZE = 1 << PAGE_SHIFT;
+
+  bool Test(u32 address) const
+  {
+    if (m_bits.empty())
+      return false;
+    const u32 page = address >> PAGE_SHIFT;
+    return ((m_bits[page / 64] >> (page % 64)) & 1) != 0;
+  }
+  // Whether any page in [start_address, end_address] is marked
+  bool TestRange(u32 start_address, u32 end_address) const;
+
+  // Marks the pages in [start_address, end_address]
+  void MarkRange(u32 start_address, u32 end_address);
+  void Clear();
+
+private:
+  std::vector<u64> m_bits;
+};
+
 // Code breakpoints.
 class BreakPoints
 {
@@ -76,7 +108,10 @@ public:
   void ClearAllTemporary();
 
 private:
+  void UpdatePageBitmap();
+
   TBreakPoints m_breakpoints;
+  PageBitmap m_pages;
 };
 
 // Memory breakpoints
@@ -97,11 +132,20 @@ public:
   // memory breakpoint
   TMemCheck* GetMemCheck(u32 address, size_t size = 1);
   bool OverlapsMemcheck(u32 address, u32 length) const;
+  // Whether [address, address + length) shares a page with any memcheck. Cheaper than
+  // OverlapsMemcheck, but only accurate to the page.
+  bool IsPageWatched(u32 address, u32 length = 1) const
+  {
+    return m_pages.TestRange(address, address + (length - 1));
+  }
   void Remove(u32 address);
 
   void Clear();
   bool HasAny() const { return !m_mem_checks.empty(); }
 
 private:
+  void UpdatePageBitmap();
+
   TMemChecks m_mem_checks;
+  PageBitmap m_pages;
 };
@@ -3,6 +3,8 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -10,14 +12,18 @@
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
+using FusedInstruction = void (*)(UGeckoInstruction, UGeckoInstruction);
+
 struct CachedInterpreter::Instruction
 {
   using CommonCallback = void (*)(UGeckoInstruction);
   using ConditionalCallback = bool (*)(u32);
+  using FusedCallback = FusedInstruction;
 
   Instruction() {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
@@ -30,17 +36,32 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  // The second instruction goes into the entry that follows this one
+  Instruction(const FusedCallback c, UGeckoInstruction i)
+      : fused_callback(c), data(i.hex), type(Type::Fused)
+  {
+  }
+
+  Instruction(JitBlock::ProfileData* const p, u32 downcount)
+      : profile_data(p), data(downcount), type(Type::Profile)
+  {
+  }
+
   enum class Type
   {
     Abort,
     Common,
     Conditional,
+    Fused,
+    Profile,
   };
 
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const FusedCallback fused_callback;
+    JitBlock::ProfileData* const profile_data;
   };
 
   u32 data = 0;
@@ -99,6 +120,16 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::Fused:
+      code->fused_callback(UGeckoInstruction(code->data), UGeckoInstruction(code[1].data));
+      ++code;
+      break;
+
+    case Instruction::Type::Profile:
+      ++code->profile_data->runCount;
+      code->profile_data->downcountCounter += code->data;
+      break;
+
     default:
       ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}",
                     static_cast<int>(code->type));
@@ -212,6 +243,64 @@ static bool CheckIdle(u32 idle_pc)
   return false;
 }
 
+// Pairs of instructions that often follow each other run from a single entry, which saves a
+// dispatch and lets the compiler inline both of them.
+template <Interpreter::Instruction First, Interpreter::Instruction Second>
+static void FusedPair(UGeckoInstruction first, UGeckoInstruction second)
+{
+  First(first);
+  Second(second);
+}
+
+namespace
+{
+struct FusionRule
+{
+  Interpreter::Instruction first;
+  Interpreter::Instruction second;
+  FusedInstruction fused;
+};
+
+template <Interpreter::Instruction First, Interpreter::Instruction Second>
+constexpr FusionRule Fuse()
+{
+  return {First, Second, FusedPair<First, Second>};
+}
+}  // namespace
+
+static constexpr std::array s_fusion_rules{
+    Fuse<Interpreter::lwz, Interpreter::addi>(),
+    Fuse<Interpreter::lwz, Interpreter::cmpi>(),
+    Fuse<Interpreter::lwz, Interpreter::cmpli>(),
+    Fuse<Interpreter::cmp, Interpreter::bcx>(),
+    Fuse<Interpreter::cmpi, Interpreter::bcx>(),
+    Fuse<Interpreter::cmpl, Interpreter::bcx>(),
+    Fuse<Interpreter::cmpli, Interpreter::bcx>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_add>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_sub>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_mul>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_madd>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_muls0>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_muls1>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_madds0>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_madds1>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_merge00>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_merge01>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_merge10>(),
+    Fuse<Interpreter::psq_l, Interpreter::ps_merge11>(),
+};
+
+static FusedInstruction GetFusedInstruction(Interpreter::Instruction first,
+                                            Interpreter::Instruction second)
+{
+  for (const FusionRule& rule : s_fusion_rules)
+  {
+    if (rule.first == first && rule.second == second)
+      return rule.fused;
+  }
+  return nullptr;
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
@@ -227,6 +316,17 @@ bool CachedInterpreter::HandleFunctionHooking(u32 address)
   });
 }
 
+void CachedInterpreter::EmitEndBlock()
+{
+  m_code.emplace_back(EndBlock, js.downcountAmount);
+
+  // Most blocks don't have both kinds of instructions, so skip the updates that would add zero
+  if (js.numLoadStoreInst != 0)
+    m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
+  if (js.numFloatingPointInst != 0)
+    m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -258,6 +358,16 @@ void CachedInterpreter::Jit(u32 address)
 
   b->checkedEntry = GetCodePtr();
   b->normalEntry = GetCodePtr();
+  const size_t block_begin = m_code.size();
+
+  if (jo.profile_blocks)
+  {
+    // The whole block is counted, even if it's left early
+    u32 block_downcount = 0;
+    for (u32 i = 0; i < code_block.m_num_instructions; i++)
+      block_downcount += m_code_buffer[i].opinfo->numCycles;
+    m_code.emplace_back(&b->profile_data, block_downcount);
+  }
 
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
@@ -281,20 +391,43 @@ void CachedInterpreter::Jit(u32 address)
       const bool memcheck = (op.opinfo->flags & FL_LOADSTORE) && jo.memcheck;
       const bool check_program_exception = !endblock && ShouldHandleFPExceptionForInstruction(&op);
       const bool idle_loop = op.branchIsIdleLoop;
+      const bool write_pc =
+          breakpoint || check_fpu || endblock || memcheck || check_program_exception;
+      const Interpreter::Instruction interpreter_op = PPCTables::GetInterpreterOp(op.inst);
+
+      // Only fuse with the previous instruction if nothing has to run between the two. The PC
+      // written for a branch isn't used by the instruction before it, so it can be written first.
+      FusedInstruction fused = nullptr;
+      if (!breakpoint && !check_fpu && (endblock || !write_pc) && m_code.size() > block_begin &&
+          m_code.back().type == Instruction::Type::Common)
+      {
+        fused = GetFusedInstruction(m_code.back().common_callback, interpreter_op);
+      }
 
-      if (breakpoint || check_fpu || endblock || memcheck || check_program_exception)
-        m_code.emplace_back(WritePC, op.address);
+      if (fused)
+      {
+        const UGeckoInstruction previous_inst(m_code.back().data);
+        m_code.pop_back();
+        if (write_pc)
+          m_code.emplace_back(WritePC, op.address);
+        m_code.emplace_back(fused, previous_inst);
+      }
+      else
+      {
+        if (write_pc)
+          m_code.emplace_back(WritePC, op.address);
 
-      if (breakpoint)
-        m_code.emplace_back(CheckBreakpoint, js.downcountAmount);
+        if (breakpoint)
+          m_code.emplace_back(CheckBreakpoint, js.downcountAmount);
 
-      if (check_fpu)
-      {
-        m_code.emplace_back(CheckFPU, js.downcountAmount);
-        js.firstFPInstructionFound = true;
+        if (check_fpu)
+        {
+          m_code.emplace_back(CheckFPU, js.downcountAmount);
+          js.firstFPInstructionFound = true;
+        }
       }
 
-      m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+      m_code.emplace_back(interpreter_op, op.inst);
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (check_program_exception)
@@ -303,25 +436,21 @@ void CachedInterpreter::Jit(u32 address)
         m_code.emplace_back(CheckIdle, js.blockStart);
       if (endblock)
       {
-        m_code.emplace_back(EndBlock, js.downcountAmount);
-        m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-        m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+        EmitEndBlock();
       }
     }
   }
   if (code_block.m_broken)
   {
     m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-    m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+    EmitEndBlock();
   }
   m_code.emplace_back();
 
   b->codeSize = (u32)(GetCodePtr() - b->checkedEntry);
   b->originalSize = code_block.m_num_instructions;
 
-  m_block_cache.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+  m_block_cache.FinalizeBlock(*b, jo.enableBlocklink, code_block, m_code_buffer);
 }
 
 void CachedInterpreter::ClearCache()
@@ -40,6 +40,9 @@ std::array<Interpreter::Instruction, 1024> Interpreter::m_op_table31;
 std::array<Interpreter::Instruction, 32> Interpreter::m_op_table59;
 std::array<Interpreter::Instruction, 1024> Interpreter::m_op_table63;
 
+std::array<Interpreter::DecodedLine, Interpreter::DECODED_LINE_COUNT>
+    Interpreter::m_decoded_lines;
+
 namespace
 {
 // Determines whether or not the given instruction is one where its execution
@@ -61,12 +64,13 @@ bool IsPairedSingleInstruction(UGeckoInstruction inst)
 // Paired single instructions are illegal to execute if HID2.PSE is not set.
 // It's also illegal to execute psq_l, psq_lu, psq_st, and psq_stu if HID2.PSE is enabled,
 // but HID2.LSQE is not set.
-bool IsInvalidPairedSingleExecution(UGeckoInstruction inst)
+bool IsInvalidPairedSingleExecution(bool is_paired_single,
+                                    bool is_paired_single_quantized_non_indexed)
 {
-  if (!HID2.PSE && IsPairedSingleInstruction(inst))
+  if (!HID2.PSE && is_paired_single)
     return true;
 
-  return HID2.PSE && !HID2.LSQE && IsPairedSingleQuantizedNonIndexedInstruction(inst);
+  return HID2.PSE && !HID2.LSQE && is_paired_single_quantized_non_indexed;
 }
 
 void UpdatePC()
@@ -100,6 +104,7 @@ void Interpreter::RunTable63(UGeckoInstruction inst)
 void Interpreter::Init()
 {
   InitializeInstructionTables();
+  ClearDecodedLines();
   m_end_block = false;
 }
 
@@ -140,6 +145,61 @@ bool Interpreter::HandleFunctionHooking(u32 address)
   });
 }
 
+void Interpreter::ClearDecodedLines()
+{
+  for (DecodedLine& line : m_decoded_lines)
+  {
+    // Line addresses are 32-byte aligned, so this never matches
+    line.address = UINT32_MAX;
+  }
+}
+
+const Interpreter::DecodedInstruction& Interpreter::Decode(u32 address, UGeckoInstruction inst)
+{
+  DecodedLine& line = m_decoded_lines[(address >> 5) % DECODED_LINE_COUNT];
+  if (line.address != (address & ~0x1fU))
+  {
+    line.address = address & ~0x1fU;
+    for (DecodedInstruction& decoded : line.instructions)
+      decoded.handler = nullptr;
+  }
+
+  DecodedInstruction& decoded = line.instructions[(address >> 2) & 7];
+  if (decoded.handler != nullptr && decoded.inst.hex == inst.hex)
+    return decoded;
+
+  decoded.inst = inst;
+  switch (inst.OPCD)
+  {
+  case 4:
+    decoded.handler = m_op_table4[inst.SUBOP10];
+    break;
+  case 19:
+    decoded.handler = m_op_table19[inst.SUBOP10];
+    break;
+  case 31:
+    decoded.handler = m_op_table31[inst.SUBOP10];
+    break;
+  case 59:
+    decoded.handler = m_op_table59[inst.SUBOP5];
+    break;
+  case 63:
+    decoded.handler = m_op_table63[inst.SUBOP10];
+    break;
+  default:
+    decoded.handler = m_op_table[inst.OPCD];
+    break;
+  }
+
+  const bool known = decoded.handler != unknown_instruction;
+  decoded.opinfo = known ? PPCTables::GetOpInfo(inst) : nullptr;
+  decoded.uses_fpu = known && PPCTables::UsesFPU(inst);
+  decoded.is_paired_single = IsPairedSingleInstruction(inst);
+  decoded.is_paired_single_quantized_non_indexed =
+      IsPairedSingleQuantizedNonIndexedInstruction(inst);
+  return decoded;
+}
+
 int Interpreter::SingleStepInner()
 {
   if (HandleFunctionHooking(PC))
@@ -162,16 +222,21 @@ int Interpreter::SingleStepInner()
     Trace(m_prev_inst);
   }
 
+  const GekkoOPInfo* opinfo = nullptr;
   if (m_prev_inst.hex != 0)
   {
-    if (IsInvalidPairedSingleExecution(m_prev_inst))
+    const DecodedInstruction& decoded = Decode(PC, m_prev_inst);
+    opinfo = decoded.opinfo;
+
+    if (IsInvalidPairedSingleExecution(decoded.is_paired_single,
+                                       decoded.is_paired_single_quantized_non_indexed))
     {
       GenerateProgramException(ProgramExceptionCause::IllegalInstruction);
       CheckExceptions();
     }
     else if (MSR.FP)
     {
-      m_op_table[m_prev_inst.OPCD](m_prev_inst);
+      decoded.handler(m_prev_inst);
       if ((PowerPC::ppcState.Exceptions & EXCEPTION_DSI) != 0)
       {
         CheckExceptions();
@@ -180,14 +245,14 @@ int Interpreter::SingleStepInner()
     else
     {
       // check if we have to generate a FPU unavailable exception or a program exception.
-      if (PPCTables::UsesFPU(m_prev_inst))
+      if (decoded.uses_fpu)
       {
         PowerPC::ppcState.Exceptions |= EXCEPTION_FPU_UNAVAILABLE;
         CheckExceptions();
       }
       else
       {
-        m_op_table[m_prev_inst.OPCD](m_prev_inst);
+        decoded.handler(m_prev_inst);
         if ((PowerPC::ppcState.Exceptions & EXCEPTION_DSI) != 0)
         {
           CheckExceptions();
@@ -203,7 +268,8 @@ int Interpreter::SingleStepInner()
 
   UpdatePC();
 
-  const GekkoOPInfo* opinfo = PPCTables::GetOpInfo(m_prev_inst);
+  if (opinfo == nullptr)
+    opinfo = PPCTables::GetOpInfo(m_prev_inst);
   PowerPC::UpdatePerformanceMonitor(opinfo->numCycles, (opinfo->flags & FL_LOADSTORE) != 0,
                                     (opinfo->flags & FL_USE_FPU) != 0);
   return opinfo->numCycles;
@@ -345,7 +411,7 @@ void Interpreter::unknown_instruction(UGeckoInstruction inst)
 
 void Interpreter::ClearCache()
 {
-  // Do nothing.
+  ClearDecodedLines();
 }
 
 void Interpreter::CheckExceptions()
@@ -9,6 +9,8 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/Gekko.h"
 
+struct GekkoOPInfo;
+
 class Interpreter : public CPUCoreBase
 {
 public:
@@ -281,6 +283,32 @@ public:
   static u32 Helper_Carry(u32 value1, u32 value2);
 
 private:
+  // What the interpreter needs to know about an instruction before and after running it, cached
+  // per 32-byte line of guest code so that repeated execution skips decoding. The instruction
+  // is still fetched every time, through the emulated instruction cache, and a cached entry is
+  // only used while it matches what was fetched.
+  struct DecodedInstruction
+  {
+    UGeckoInstruction inst;
+    Instruction handler;
+    // nullptr for unknown instructions, which are only looked up after they ran
+    const GekkoOPInfo* opinfo;
+    bool uses_fpu;
+    bool is_paired_single;
+    bool is_paired_single_quantized_non_indexed;
+  };
+
+  struct DecodedLine
+  {
+    u32 address;
+    std::array<DecodedInstruction, 8> instructions;
+  };
+
+  static constexpr u32 DECODED_LINE_COUNT = 2048;
+
+  static const DecodedInstruction& Decode(u32 address, UGeckoInstruction inst);
+  static void ClearDecodedLines();
+
   void CheckExceptions();
 
   static void InitializeInstructionTables();
@@ -298,4 +326,5 @@ private:
   UGeckoInstruction m_prev_inst{};
 
   static bool m_end_block;
+  static std::array<DecodedLine, DECODED_LINE_COUNT> m_decoded_lines;
 };
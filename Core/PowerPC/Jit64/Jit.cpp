@@ -39,6 +39,7 @@
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
 #include "Core/PowerPC/Jit64Common/TrampolineCache.h"
+#include "Core/PowerPC/JitCommon/JitCoverage.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
@@ -154,6 +155,11 @@ enum
   GUARD_OFFSET = STACK_SIZE - SAFE_STACK_SIZE - GUARD_SIZE,
 };
 
+// With Config::MAIN_JIT_HOT_BLOCK_RECOMPILE, how often a block runs before it is compiled again,
+// and how many unconditional branches it then follows.
+constexpr u32 HOT_BLOCK_THRESHOLD = 10000;
+constexpr u32 HOT_BLOCK_BRANCH_FOLLOWING_THRESHOLD = 8;
+
 Jit64::Jit64() : QuantizedMemoryRoutines(*this)
 {
 }
@@ -820,6 +826,12 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     }
   }
 
+  // Hot blocks can afford to follow more branches, as they are only compiled again once they have
+  // proven to run often.
+  analyzer.SetBranchFollowingThreshold(
+      IsHotBlock(em_address) ? HOT_BLOCK_BRANCH_FOLLOWING_THRESHOLD :
+                               PPCAnalyst::PPCAnalyzer::BRANCH_FOLLOWING_THRESHOLD);
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
@@ -860,7 +872,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       b->far_begin = far_start;
       b->far_end = far_end;
 
-      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block, m_code_buffer);
       return;
     }
   }
@@ -938,6 +950,32 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+  if (m_enable_coverage)
+  {
+    MOV(64, R(RSCRATCH), ImmPtr(JitCoverage::GetMapEntry(js.blockStart)));
+    MOV(8, MatR(RSCRATCH), Imm8(1));
+  }
+  if (m_enable_hot_block_recompile && !m_enable_debugging && !jo.profile_blocks &&
+      !IsHotBlock(js.blockStart))
+  {
+    // Once the block has run often enough, have it compiled again as a hot block. The new block
+    // replaces this one, and the blocks linked to this one, through the block cache.
+    b->runs_until_hot = HOT_BLOCK_THRESHOLD;
+
+    SwitchToFarCode();
+    const u8* target = GetCodePtr();
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+
+    MOV(64, R(RSCRATCH), ImmPtr(&b->runs_until_hot));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    J_CC(CC_Z, target);
+  }
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -1023,10 +1061,21 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     {
       js.fifoBytesSinceCheck = 0;
       js.mustCheckFifo = false;
+
+      // The pipe usually still has room, so only a full one leaves for the far code
+      MOV(64, R(RSCRATCH), PPCSTATE(gather_pipe_ptr));
+      SUB(64, R(RSCRATCH), PPCSTATE(gather_pipe_base_ptr));
+      CMP(64, R(RSCRATCH), Imm32(GPFifo::GATHER_PIPE_SIZE));
+      FixupBranch burst = J_CC(CC_GE, true);
+      SwitchToFarCode();
+      SetJumpTarget(burst);
       BitSet32 registersInUse = CallerSavedRegistersInUse();
       ABI_PushRegistersAndAdjustStack(registersInUse, 0);
-      ABI_CallFunction(GPFifo::FastCheckGatherPipe);
+      ABI_CallFunction(GPFifo::UpdateGatherPipe);
       ABI_PopRegistersAndAdjustStack(registersInUse, 0);
+      FixupBranch burst_done = J(true);
+      SwitchToNearCode();
+      SetJumpTarget(burst_done);
       gatherPipeIntCheck = true;
     }
 
@@ -1243,6 +1292,12 @@ BitSet32 Jit64::CallerSavedRegistersInUse() const
   return in_use & ABI_ALL_CALLER_SAVED;
 }
 
+bool Jit64::IsHotBlock(u32 em_address) const
+{
+  return m_enable_hot_block_recompile &&
+         js.hotBlockAddresses.find(em_address) != js.hotBlockAddresses.end();
+}
+
 void Jit64::EnableBlockLink()
 {
   jo.enableBlocklink = true;
@@ -53,6 +53,8 @@ public:
 
   void EnableOptimization();
   void EnableBlockLink();
+  // Whether the block at the address was found to run often enough to be compiled again
+  bool IsHotBlock(u32 em_address) const;
 
   // Jit!
 
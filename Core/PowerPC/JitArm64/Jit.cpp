@@ -22,6 +22,7 @@
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/JitArm64/JitArm64_RegCache.h"
+#include "Core/PowerPC/JitCommon/JitCoverage.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/Profiler.h"
 
@@ -59,6 +60,8 @@ void JitArm64::Init()
   gpr.Init(this);
   fpr.Init(this);
   blocks.Init();
+  m_fastmem_faults.clear();
+  m_fastmem_stats = {};
 
   code_block.m_stats = &js.st;
   code_block.m_gpa = &js.gpa;
@@ -128,6 +131,11 @@ bool JitArm64::HandleStackFault()
 
 void JitArm64::ClearCache()
 {
+  DEBUG_LOG_FMT(DYNA_REC,
+                "Fastmem: {} accesses emitted as fastmem, {} as slowmem, {} faults at {} guest PCs",
+                m_fastmem_stats.fastmem_sites, m_fastmem_stats.slowmem_sites,
+                m_fastmem_stats.faults, m_fastmem_faults.size());
+
   m_fault_to_handler.clear();
 
   blocks.Clear();
@@ -700,7 +708,7 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       b->far_begin = far_start;
       b->far_end = far_end;
 
-      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block, m_code_buffer);
       return;
     }
   }
@@ -779,6 +787,12 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     // get start tic
     BeginTimeProfile(b);
   }
+  if (m_enable_coverage)
+  {
+    MOVP2R(ARM64Reg::X0, JitCoverage::GetMapEntry(js.blockStart));
+    MOVI2R(ARM64Reg::W1, 1);
+    STRB(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+  }
 
   if (code_block.m_gqr_used.Count() == 1 &&
       js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
@@ -846,12 +860,27 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
       BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
       regs_in_use[DecodeReg(ARM64Reg::W30)] = 0;
 
+      // The pipe usually still has room, so only a full one leaves for the far code
+      const ARM64Reg WA = gpr.GetReg();
+      const ARM64Reg XA = EncodeRegTo64(WA);
+      LDP(IndexType::Signed, XA, ARM64Reg::X30, PPC_REG, PPCSTATE_OFF(gather_pipe_ptr));
+      SUB(XA, XA, ARM64Reg::X30);
+      CMP(XA, GPFifo::GATHER_PIPE_SIZE);
+      gpr.Unlock(WA);
+      FixupBranch has_room = B(CC_LT);
+      FixupBranch burst = B();
+      SwitchToFarCode();
+      SetJumpTarget(burst);
       ABI_PushRegisters(regs_in_use);
       m_float_emit.ABI_PushRegisters(fprs_in_use, ARM64Reg::X30);
-      MOVP2R(ARM64Reg::X8, &GPFifo::FastCheckGatherPipe);
+      MOVP2R(ARM64Reg::X8, &GPFifo::UpdateGatherPipe);
       BLR(ARM64Reg::X8);
       m_float_emit.ABI_PopRegisters(fprs_in_use, ARM64Reg::X30);
       ABI_PopRegisters(regs_in_use);
+      FixupBranch burst_done = B();
+      SwitchToNearCode();
+      SetJumpTarget(has_room);
+      SetJumpTarget(burst_done);
 
       // Inline exception check
       LDR(IndexType::Unsigned, ARM64Reg::W30, PPC_REG, PPCSTATE_OFF(Exceptions));
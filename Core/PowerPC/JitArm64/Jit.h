@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <map>
 #include <tuple>
+#include <unordered_map>
 
 #include <rangeset/rangesizeset.h>
 
@@ -35,6 +36,19 @@ public:
   bool HandleStackFault() override;
   bool HandleFastmemFault(uintptr_t access_address, SContext* ctx);
 
+  struct FastmemStats
+  {
+    // Accesses emitted with a fastmem path, and those emitted as slowmem because they faulted
+    // before
+    u64 fastmem_sites = 0;
+    u64 slowmem_sites = 0;
+    u64 faults = 0;
+  };
+
+  const FastmemStats& GetFastmemStats() const { return m_fastmem_stats; }
+  // <Guest PC, number of times a fastmem access emitted for it faulted>
+  const std::unordered_map<u32, u32>& GetFastmemFaultCounts() const { return m_fastmem_faults; }
+
   void ClearCache() override;
 
   CommonAsmRoutinesBase* GetAsmRoutines() override { return this; }
@@ -110,9 +124,7 @@ public:
   void mcrf(UGeckoInstruction inst);
   void mcrxr(UGeckoInstruction inst);
   void mfsr(UGeckoInstruction inst);
-  void mtsr(UGeckoInstruction inst);
   void mfsrin(UGeckoInstruction inst);
-  void mtsrin(UGeckoInstruction inst);
   void twx(UGeckoInstruction inst);
   void mfspr(UGeckoInstruction inst);
   void mftb(UGeckoInstruction inst);
@@ -185,6 +197,7 @@ protected:
   {
     const u8* fastmem_code;
     const u8* slowmem_code;
+    u32 guest_pc;
   };
 
   void CompileInstruction(PPCAnalyst::CodeOp& op);
@@ -315,6 +328,10 @@ protected:
 
   // <Fastmem fault location, slowmem handler location>
   std::map<const u8*, FastmemArea> m_fault_to_handler;
+  // Kept when the cache is cleared, so that accesses which fault keep getting emitted as slowmem
+  // instead of being backpatched again every time their block is recompiled
+  std::unordered_map<u32, u32> m_fastmem_faults;
+  FastmemStats m_fastmem_stats;
   Arm64GPRCache gpr;
   Arm64FPRCache fpr;
 
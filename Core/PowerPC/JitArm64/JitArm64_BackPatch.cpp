@@ -60,6 +60,20 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
 {
   const u32 access_size = BackPatchInfo::GetFlagSize(flags);
 
+  if (fastmem && do_farcode && !emitting_routine)
+  {
+    if (m_fastmem_faults.count(js.compilerPC) != 0)
+    {
+      fastmem = false;
+      do_farcode = false;
+      m_fastmem_stats.slowmem_sites++;
+    }
+    else
+    {
+      m_fastmem_stats.fastmem_sites++;
+    }
+  }
+
   bool in_far_code = false;
   const u8* fastmem_start = GetCodePtr();
   std::optional<FixupBranch> slowmem_fixup;
@@ -136,6 +150,7 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
         FastmemArea* fastmem_area = &m_fault_to_handler[fastmem_end];
         fastmem_area->fastmem_code = fastmem_start;
         fastmem_area->slowmem_code = GetCodePtr();
+        fastmem_area->guest_pc = js.compilerPC;
       }
     }
 
@@ -310,6 +325,8 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
   while (emitter.GetCodePtr() < fastmem_area_end)
     emitter.NOP();
 
+  m_fastmem_faults[slow_handler_iter->second.guest_pc]++;
+  m_fastmem_stats.faults++;
   m_fault_to_handler.erase(slow_handler_iter);
 
   emitter.FlushIcache();
@@ -50,6 +50,8 @@ void JitBase::RefreshConfig()
   bJITBranchOff = Config::Get(Config::MAIN_DEBUG_JIT_BRANCH_OFF);
   bJITRegisterCacheOff = Config::Get(Config::MAIN_DEBUG_JIT_REGISTER_CACHE_OFF);
   m_enable_debugging = Config::Get(Config::MAIN_ENABLE_DEBUGGING);
+  m_enable_coverage = Config::Get(Config::MAIN_JIT_COVERAGE);
+  m_enable_hot_block_recompile = Config::Get(Config::MAIN_JIT_HOT_BLOCK_RECOMPILE);
   m_enable_float_exceptions = Config::Get(Config::MAIN_FLOAT_EXCEPTIONS);
   m_enable_div_by_zero_exceptions = Config::Get(Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS);
   m_low_dcbz_hack = Config::Get(Config::MAIN_LOW_DCBZ_HACK);
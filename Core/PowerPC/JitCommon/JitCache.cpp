@@ -41,6 +41,7 @@ JitBaseBlockCache::~JitBaseBlockCache() = default;
 void JitBaseBlockCache::Init()
 {
   JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR));
+  m_record_instructions = Config::Get(Config::MAIN_JIT_KEEP_BLOCKS_ON_STATE_LOAD);
 
   Clear();
 }
@@ -59,6 +60,7 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
@@ -102,16 +104,25 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 }
 
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
-                                      const std::set<u32>& physical_addresses)
+                                      const PPCAnalyst::CodeBlock& code_block,
+                                      const PPCAnalyst::CodeBuffer& code_buffer)
 {
   size_t index = FastLookupIndexForAddress(block.effectiveAddress);
   fast_block_map[index] = &block;
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  block.physical_addresses = code_block.m_physical_addresses;
+
+  if (m_record_instructions)
+  {
+    block.instructions.clear();
+    block.instructions.reserve(code_block.m_num_instructions);
+    for (u32 i = 0; i < code_block.m_num_instructions; ++i)
+      block.instructions.emplace_back(code_buffer[i].address, code_buffer[i].inst.hex);
+  }
 
   u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  for (u32 addr : physical_addresses)
+  for (u32 addr : block.physical_addresses)
   {
     valid_block.Set(addr / 32);
     block_range_map[addr & range_mask].insert(&block);
@@ -178,6 +189,74 @@ const u8* JitBaseBlockCache::Dispatch()
   return block->normalEntry;
 }
 
+void JitBaseBlockCache::RevalidateBlocks()
+{
+  // Linked exits would jump straight into blocks that haven't been checked yet
+  for (auto& e : block_map)
+  {
+    JitBlock& block = e.second;
+    for (auto& link : block.linkData)
+    {
+      if (link.linkStatus)
+      {
+        WriteLinkBlock(link, nullptr);
+        link.linkStatus = false;
+      }
+    }
+    block.needs_revalidation = true;
+  }
+
+  // Make the dispatcher go through MoveBlockIntoFastCache for every block
+  fast_block_map.fill(nullptr);
+}
+
+bool JitBaseBlockCache::RevalidateBlock(JitBlock& block)
+{
+  // The instructions are read the same way the analyzer reads them when compiling, so the block
+  // is kept exactly when compiling it again would give the same block
+  std::set<u32> physical_addresses;
+  for (const auto& [address, hex] : block.instructions)
+  {
+    const auto result = PowerPC::TryReadInstruction(address);
+    if (!result.valid || result.hex != hex)
+      return false;
+    physical_addresses.insert(result.physical_address);
+  }
+
+  if (physical_addresses != block.physical_addresses)
+    return false;
+
+  block.needs_revalidation = false;
+  LinkBlock(block);
+  return true;
+}
+
+void JitBaseBlockCache::EraseBlock(JitBlock& block)
+{
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  for (u32 addr : block.physical_addresses)
+  {
+    const auto it = block_range_map.find(addr & range_mask);
+    if (it == block_range_map.end())
+      continue;
+
+    it->second.erase(&block);
+    if (it->second.empty())
+      block_range_map.erase(it);
+  }
+
+  DestroyBlock(block);
+  auto block_map_iter = block_map.equal_range(block.physicalAddress);
+  for (; block_map_iter.first != block_map_iter.second; ++block_map_iter.first)
+  {
+    if (&block_map_iter.first->second == &block)
+    {
+      block_map.erase(block_map_iter.first);
+      break;
+    }
+  }
+}
+
 void JitBaseBlockCache::InvalidateICacheLine(u32 address)
 {
   const u32 cache_line_address = address & ~0x1f;
@@ -255,6 +334,7 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
       {
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
+        m_jit.js.hotBlockAddresses.erase(i);
       }
     }
   }
@@ -331,7 +411,7 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
     if (!e.linkStatus)
     {
       JitBlock* destinationBlock = GetBlockFromStartAddress(e.exitAddress, block.msrBits);
-      if (destinationBlock)
+      if (destinationBlock && !destinationBlock->needs_revalidation)
       {
         WriteLinkBlock(e, destinationBlock);
         e.linkStatus = true;
@@ -411,6 +491,12 @@ JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, u32 msr)
   if (!block)
     return nullptr;
 
+  if (block->needs_revalidation && !RevalidateBlock(*block))
+  {
+    EraseBlock(*block);
+    return nullptr;
+  }
+
   // Drop old fast block map entry
   if (fast_block_map[block->fast_block_map_index] == block)
     fast_block_map[block->fast_block_map_index] = nullptr;
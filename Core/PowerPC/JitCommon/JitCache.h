@@ -13,9 +13,11 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/PowerPC/PPCAnalyst.h"
 
 class JitBase;
 
@@ -81,6 +83,18 @@ struct JitBlock : public JitBlockData
   // This set stores all physical addresses of all occupied instructions.
   std::set<u32> physical_addresses;
 
+  // The effective addresses and values of the instructions the block was compiled from, kept so
+  // that the block can be checked against memory after a state is loaded. Only recorded with
+  // Config::MAIN_JIT_KEEP_BLOCKS_ON_STATE_LOAD.
+  std::vector<std::pair<u32, u32>> instructions;
+
+  // Set for blocks that must be checked against memory before they run again.
+  bool needs_revalidation = false;
+
+  // Counted down each time the block runs, if it was compiled to count its runs. Reaching zero
+  // gets the block compiled again as a hot block.
+  u32 runs_until_hot = 0;
+
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
   {
@@ -147,7 +161,20 @@ public:
   void RunOnBlocks(std::function<void(const JitBlock&)> f);
 
   JitBlock* AllocateBlock(u32 em_address);
-  void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
+  void FinalizeBlock(JitBlock& block, bool block_link, const PPCAnalyst::CodeBlock& code_block,
+                     const PPCAnalyst::CodeBuffer& code_buffer);
+
+  // Whether the blocks record the instructions they were compiled from, which RevalidateBlocks
+  // needs.
+  bool CanRevalidateBlocks() const { return m_record_instructions; }
+
+  // Keeps the compiled blocks, but unlinks them and has Dispatch check each one against the
+  // instructions in memory before running it again. Blocks that no longer match are destroyed
+  // and compiled again. This is used instead of clearing the cache when a state is loaded, so
+  // that loading a state over and over doesn't compile the same code every time.
+  void RevalidateBlocks();
+
+  size_t GetBlockCount() const { return block_map.size(); }
 
   // Look for the block in the slow but accurate way.
   // This function shall be used if FastLookupIndexForAddress() failed.
@@ -180,6 +207,9 @@ private:
   void UnlinkBlock(const JitBlock& block);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
 
+  bool RevalidateBlock(JitBlock& block);
+  void EraseBlock(JitBlock& block);
+
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
   // Fast but risky block lookup based on fast_block_map.
@@ -206,4 +236,6 @@ private:
   // This array is indexed with the masked PC and likely holds the correct block id.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
   std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map{};  // start_addr & mask -> number
+
+  bool m_record_instructions = false;
 };
@@ -0,0 +1,34 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitCoverage.h"
+
+#include <algorithm>
+#include <array>
+
+#include "Common/CommonTypes.h"
+
+namespace JitCoverage
+{
+alignas(64) static std::array<u8, MAP_SIZE> s_map{};
+
+u8* GetMapEntry(u32 address)
+{
+  return &s_map[GetMapIndex(address)];
+}
+
+const u8* GetMap()
+{
+  return s_map.data();
+}
+
+void Reset()
+{
+  s_map.fill(0);
+}
+
+u32 CountHits()
+{
+  return static_cast<u32>(MAP_SIZE - std::count(s_map.begin(), s_map.end(), u8(0)));
+}
+}  // namespace JitCoverage
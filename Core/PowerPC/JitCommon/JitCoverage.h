@@ -0,0 +1,31 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Which guest blocks ran since the last reset, for tools that steer their inputs towards new code.
+// With Config::MAIN_JIT_COVERAGE set, every block the JITs compile stores to the entry of the map
+// its start address hashes to each time it's entered. That's a single byte store per block, so
+// collecting coverage barely costs anything.
+namespace JitCoverage
+{
+constexpr u32 MAP_SIZE = 1 << 16;
+
+// Instructions are word aligned, and the upper bits are folded in so that code in different
+// megabytes of RAM doesn't always collide.
+constexpr u32 GetMapIndex(u32 address)
+{
+  return ((address >> 2) ^ (address >> 18)) & (MAP_SIZE - 1);
+}
+
+// The entry compiled code stores to when entering the block starting at address.
+u8* GetMapEntry(u32 address);
+
+const u8* GetMap();
+void Reset();
+
+// The number of map entries set since the last reset.
+u32 CountHits();
+}  // namespace JitCoverage
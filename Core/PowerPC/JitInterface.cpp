@@ -47,7 +47,13 @@ void SetJit(JitBase* jit)
 }
 void DoState(PointerWrap& p)
 {
-  if (g_jit && p.IsReadMode())
+  if (!g_jit || !p.IsReadMode())
+    return;
+
+  JitBaseBlockCache* block_cache = g_jit->GetBlockCache();
+  if (block_cache->CanRevalidateBlocks())
+    block_cache->RevalidateBlocks();
+  else
     g_jit->ClearCache();
 }
 CPUCoreBase* InitJitCore(PowerPC::CPUCore core)
@@ -91,6 +97,14 @@ void SetProfilingState(ProfilingState state)
   g_jit->jo.profile_blocks = state == ProfilingState::Enabled;
 }
 
+size_t GetBlockCount()
+{
+  if (!g_jit)
+    return 0;
+
+  return g_jit->GetBlockCache()->GetBlockCount();
+}
+
 void WriteProfileResults(const std::string& filename)
 {
   Profiler::ProfileStats prof_stats;
@@ -263,6 +277,9 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBlock:
+    exception_addresses = &g_jit->js.hotBlockAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
@@ -277,7 +294,7 @@ void CompileExceptionCheck(ExceptionType type)
     exception_addresses->insert(PC);
 
     // Invalidate the JIT block so that it gets recompiled with the external exception check
-    // included.
+    // included, or as a hot block.
     g_jit->GetBlockCache()->InvalidateICache(PC, 4, true);
   }
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 #include "Common/CommonTypes.h"
@@ -28,7 +29,8 @@ enum class ExceptionType
 {
   FIFOWrite,
   PairedQuantize,
-  SpeculativeConstants
+  SpeculativeConstants,
+  HotBlock
 };
 
 void DoState(PointerWrap& p);
@@ -44,6 +46,7 @@ enum class ProfilingState
 };
 
 void SetProfilingState(ProfilingState state);
+size_t GetBlockCount();
 void WriteProfileResults(const std::string& filename);
 void GetProfileResults(Profiler::ProfileStats* prof_stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/MMU.h"
 
+#include <array>
 #include <cstddef>
 #include <cstring>
 #include <string>
@@ -168,6 +169,39 @@ static void EFB_Write(u32 data, u32 addr)
 BatTable ibat_table;
 BatTable dbat_table;
 
+// A direct-mapped cache of page address translations in front of the emulated TLB. It's much
+// larger than the TLB, so games with a large working set don't keep searching the page table.
+// Entries are only added for pages whose referenced bit is set (and the changed bit, for writes),
+// so skipping the page table doesn't skip any update of it either. Host accesses don't use the
+// cache, which keeps them free of side effects so that they can be made from other threads while
+// the CPU is paused.
+constexpr u32 TRANSLATION_CACHE_SIZE = 4096;
+constexpr u32 TRANSLATION_WRITABLE_BIT = 0x1;
+constexpr u32 TRANSLATION_WI_BIT = 0x2;
+
+struct TranslationCacheEntry
+{
+  // The generation in the upper half and the effective page number in the lower half. Bumping
+  // the generation invalidates all entries at once.
+  u64 key = 0;
+  // Physical page address, and the flags above in the low bits
+  u32 physical = 0;
+};
+
+static std::array<std::array<TranslationCacheEntry, TRANSLATION_CACHE_SIZE>, NUM_TLBS>
+    s_translation_cache;
+static u32 s_translation_cache_generation = 1;
+static TranslationStats s_translation_stats;
+
+static void InvalidateTranslationCache()
+{
+  if (++s_translation_cache_generation == 0)
+  {
+    s_translation_cache = {};
+    s_translation_cache_generation = 1;
+  }
+}
+
 static void GenerateDSIException(u32 effective_address, bool write);
 
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
@@ -858,9 +892,42 @@ std::optional<ReadResult<std::string>> HostTryReadString(u32 address, size_t siz
   return ReadResult<std::string>(c->translated, std::move(s));
 }
 
+std::optional<ReadResult<const u8*>> HostTryGetPagePointer(u32 address,
+                                                           RequestedAddressSpace space)
+{
+  if (!HostIsRAMAddress(address, space))
+    return std::nullopt;
+
+  const bool translate = space == RequestedAddressSpace::Virtual ||
+                         (space == RequestedAddressSpace::Effective && MSR.DR);
+  if (translate)
+  {
+    const auto translated_address = TranslateAddress<XCheckTLBFlag::NoException>(address);
+    if (!translated_address.Success())
+      return std::nullopt;
+    address = translated_address.address;
+  }
+
+  // Every backing region is a whole number of pages, so the rest of the page is contiguous.
+  const u8* pointer = nullptr;
+  if (Memory::m_pL1Cache && (address >> 28) == 0xE)
+    pointer = &Memory::m_pL1Cache[address & 0x0FFFFFFF];
+  else if (Memory::m_pRAM && (address & 0xF8000000) == 0x00000000)
+    pointer = &Memory::m_pRAM[address & Memory::GetRamMask()];
+  else if (Memory::m_pEXRAM && (address >> 28) == 0x1)
+    pointer = &Memory::m_pEXRAM[address & 0x0FFFFFFF];
+  else if (Memory::m_pFakeVMEM && (address & 0xFE000000) == 0x7E000000)
+    pointer = &Memory::m_pFakeVMEM[address & Memory::GetFakeVMemMask()];
+  else
+    return std::nullopt;
+
+  return ReadResult<const u8*>(translate, pointer);
+}
+
 bool IsOptimizableRAMAddress(const u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
+  // Only accesses to pages that have memchecks need to take the checked path
+  if (PowerPC::memchecks.IsPageWatched(address, 32))
     return false;
 
   if (!MSR.DR)
@@ -1041,6 +1108,14 @@ void ClearCacheLine(u32 address)
     address = translated_address.address;
   }
 
+  // A line cleared into the gather pipe goes in as a single burst
+  if ((address & 0xFFFFF000) == 0x0C008000)
+  {
+    static constexpr std::array<u8, 32> zero_line{};
+    GPFifo::WriteBurst(zero_line.data(), zero_line.size());
+    return;
+  }
+
   // TODO: This isn't precisely correct for non-RAM regions, but the difference
   // is unlikely to matter.
   for (u32 i = 0; i < 32; i += 4)
@@ -1049,7 +1124,7 @@ void ClearCacheLine(u32 address)
 
 u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (PowerPC::memchecks.IsPageWatched(address, access_size >> 3))
     return 0;
 
   if (!MSR.DR)
@@ -1072,7 +1147,7 @@ u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 
 bool IsOptimizableGatherPipeWrite(u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (PowerPC::memchecks.IsPageWatched(address, 32))
     return false;
 
   if (!MSR.DR)
@@ -1167,6 +1242,8 @@ static void GenerateISIException(u32 effective_address)
 
 void SDRUpdated()
 {
+  InvalidateTranslationCache();
+
   const auto sdr = UReg_SDR1{ppcState.spr[SPR_SDR]};
   const u32 htabmask = sdr.htabmask;
 
@@ -1267,6 +1344,28 @@ void InvalidateTLBEntry(u32 address)
 
   ppcState.tlb[0][entry_index].Invalidate();
   ppcState.tlb[1][entry_index].Invalidate();
+
+  // tlbie invalidates the whole congruence class, so drop every page that maps to the same set
+  for (auto& cache : s_translation_cache)
+  {
+    for (u32 i = entry_index; i < TRANSLATION_CACHE_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+      cache[i].key = 0;
+  }
+}
+
+void SRUpdated()
+{
+  InvalidateTranslationCache();
+}
+
+TranslationStats GetTranslationStats()
+{
+  return s_translation_stats;
+}
+
+void ResetTranslationStats()
+{
+  s_translation_stats = {};
 }
 
 union EffectiveAddress
@@ -1286,6 +1385,33 @@ union EffectiveAddress
 static TranslateAddressResult TranslatePageAddress(const EffectiveAddress address,
                                                    const XCheckTLBFlag flag, bool* wi)
 {
+  const bool use_cache = !IsNoExceptionFlag(flag);
+  const u32 page = address.Hex >> HW_PAGE_INDEX_SHIFT;
+  const u64 key = (u64{s_translation_cache_generation} << 32) | page;
+  TranslationCacheEntry& cache_entry =
+      s_translation_cache[IsOpcodeFlag(flag)][page % TRANSLATION_CACHE_SIZE];
+  if (use_cache)
+  {
+    if (cache_entry.key == key &&
+        (flag != XCheckTLBFlag::Write || (cache_entry.physical & TRANSLATION_WRITABLE_BIT) != 0))
+    {
+      ++s_translation_stats.cache_hits;
+      *wi = (cache_entry.physical & TRANSLATION_WI_BIT) != 0;
+      return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
+                                    (cache_entry.physical & ~u32(HW_PAGE_MASK)) | address.offset};
+    }
+    ++s_translation_stats.cache_misses;
+  }
+
+  const auto add_to_cache = [&](u32 translated, bool writable) {
+    if (!use_cache)
+      return;
+    cache_entry.key = key;
+    cache_entry.physical = (translated & ~u32(HW_PAGE_MASK)) |
+                           (writable ? TRANSLATION_WRITABLE_BIT : 0) |
+                           (*wi ? TRANSLATION_WI_BIT : 0);
+  };
+
   // TLB cache
   // This catches 99%+ of lookups in practice, so the actual page table entry code below doesn't
   // benefit much from optimization.
@@ -1293,9 +1419,14 @@ static TranslateAddressResult TranslatePageAddress(const EffectiveAddress addres
   const TLBLookupResult res = LookupTLBPageAddress(flag, address.Hex, &translated_address, wi);
   if (res == TLBLookupResult::Found)
   {
+    // Entries only get into the TLB once the referenced bit was set, and a write only finds one
+    // whose changed bit is set
+    add_to_cache(translated_address, flag == XCheckTLBFlag::Write);
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                   translated_address};
   }
+  if (use_cache)
+    ++s_translation_stats.page_walks;
 
   const auto sr = UReg_SR{ppcState.sr[address.SR]};
 
@@ -1372,6 +1503,9 @@ static TranslateAddressResult TranslatePageAddress(const EffectiveAddress addres
 
         *wi = (pte2.WIMG & 0b1100) != 0;
 
+        if (pte2.R != 0)
+          add_to_cache(pte2.RPN << 12, pte2.C != 0);
+
         return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                       (pte2.RPN << 12) | offset};
       }
@@ -1491,6 +1625,7 @@ static void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
 
 void DBATUpdated()
 {
+  InvalidateTranslationCache();
   dbat_table = {};
   UpdateBATs(dbat_table, SPR_DBAT0U);
   bool extended_bats = SConfig::GetInstance().bWii && HID4.SBE;
@@ -1513,6 +1648,7 @@ void DBATUpdated()
 
 void IBATUpdated()
 {
+  InvalidateTranslationCache();
   ibat_table = {};
   UpdateBATs(ibat_table, SPR_IBAT0U);
   bool extended_bats = SConfig::GetInstance().bWii && HID4.SBE;
@@ -74,6 +74,12 @@ std::optional<ReadResult<std::string>>
 HostTryReadString(u32 address, size_t size = 0,
                   RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+// Translates the given address once and returns a pointer to the RAM backing it, which stays valid
+// up to the end of the address's page. This lets host code copy memory in bulk instead of paying
+// for a translation per value. The bytes are in the guest's big endian byte order.
+std::optional<ReadResult<const u8*>>
+HostTryGetPagePointer(u32 address, RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
 // Writes a value to emulated memory using the currently active MMU settings.
 // If the write fails (eg. address does not correspond to a mapped address in the current address
 // space), a PanicAlert will be shown to the user.
@@ -171,6 +177,21 @@ void SDRUpdated();
 void InvalidateTLBEntry(u32 address);
 void DBATUpdated();
 void IBATUpdated();
+// Must be called when a segment register is written.
+void SRUpdated();
+
+// Counters of page address translations made by the emulated CPU since boot or since the stats
+// were last reset. Only call these from the CPU thread.
+struct TranslationStats
+{
+  // Lookups answered by the translation cache in front of the TLB
+  u64 cache_hits;
+  u64 cache_misses;
+  // Lookups that missed the TLB as well, and had to search the page table
+  u64 page_walks;
+};
+TranslationStats GetTranslationStats();
+void ResetTranslationStats();
 
 // Result changes based on the BAT registers and MSR.DR.  Returns whether
 // it's safe to optimize a read or write to this address to an unguarded
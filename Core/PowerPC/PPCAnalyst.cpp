@@ -15,6 +15,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -38,9 +39,6 @@
 
 namespace PPCAnalyst
 {
-// 0 does not perform block merging
-constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
-
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
@@ -104,9 +102,11 @@ bool AnalyzeFunction(u32 startAddr, Common::Symbol& func, u32 max_size)
         func.flags |= Common::FFLAG_STRAIGHT;
       return true;
     }
-    const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(addr);
-    const UGeckoInstruction instr = read_result.hex;
-    if (read_result.valid && PPCTables::IsValidInstruction(instr))
+    // This doesn't go through the instruction cache, so that functions can be analyzed on several
+    // threads at once
+    const auto read_result = PowerPC::HostTryReadInstruction(addr);
+    const UGeckoInstruction instr = read_result ? read_result->value : 0;
+    if (read_result && PPCTables::IsValidInstruction(instr))
     {
       // BLR or RFI
       // 4e800021 is blrl, not the end of a function
@@ -256,36 +256,56 @@ bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
 // called by another function. Therefore, let's scan the
 // entire space for bl operations and find what functions
 // get called.
-static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, Common::SymbolDB* func_db)
+static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db)
 {
-  for (u32 addr = startAddr; addr < endAddr; addr += 4)
-  {
-    const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(addr);
-    const UGeckoInstruction instr = read_result.hex;
+  // The range is split into chunks that are scanned in parallel
+  constexpr u32 CHUNK_SIZE = 0x40000;
 
-    if (read_result.valid && PPCTables::IsValidInstruction(instr))
+  std::vector<std::vector<u32>> chunk_targets((u64{endAddr - startAddr} + CHUNK_SIZE - 1) /
+                                              CHUNK_SIZE);
+  {
+    Common::TaskGroup task_group;
+    for (size_t i = 0; i < chunk_targets.size(); ++i)
     {
-      switch (instr.OPCD)
-      {
-      case 18:  // branch instruction
-      {
-        if (instr.LK)  // bl
+      const u32 chunk_start = startAddr + static_cast<u32>(i) * CHUNK_SIZE;
+      const u32 chunk_end = chunk_start + std::min(CHUNK_SIZE, endAddr - chunk_start);
+      task_group.Submit([chunk_start, chunk_end, targets = &chunk_targets[i]] {
+        for (u32 addr = chunk_start; addr < chunk_end; addr += 4)
         {
-          u32 target = SignExt26(instr.LI << 2);
-          if (!instr.AA)
-            target += addr;
-          if (PowerPC::HostIsRAMAddress(target))
+          const auto read_result = PowerPC::HostTryReadInstruction(addr);
+          const UGeckoInstruction instr = read_result ? read_result->value : 0;
+
+          if (read_result && PPCTables::IsValidInstruction(instr))
           {
-            func_db->AddFunction(target);
+            switch (instr.OPCD)
+            {
+            case 18:  // branch instruction
+            {
+              if (instr.LK)  // bl
+              {
+                u32 target = SignExt26(instr.LI << 2);
+                if (!instr.AA)
+                  target += addr;
+                if (PowerPC::HostIsRAMAddress(target))
+                {
+                  targets->push_back(target);
+                }
+              }
+            }
+            break;
+            default:
+              break;
+            }
           }
         }
-      }
-      break;
-      default:
-        break;
-      }
+      });
     }
   }
+
+  std::vector<u32> targets;
+  for (const std::vector<u32>& chunk : chunk_targets)
+    targets.insert(targets.end(), chunk.begin(), chunk.end());
+  func_db->AddFunctions(std::move(targets));
 }
 
 static void FindFunctionsFromHandlers(PPCSymbolDB* func_db)
@@ -792,7 +812,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
 
     bool conditional_continue = false;
 
-    // TODO: Find the optimal value for BRANCH_FOLLOWING_THRESHOLD.
+    // TODO: Find the optimal value for the branch following threshold.
     //       If it is small, the performance will be down.
     //       If it is big, the size of generated code will be big and
     //       cache clearning will happen many times.
@@ -823,7 +843,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       {
         code[i].branchTo = code[caller].address + 4;
         if ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION) &&
-            numFollows < BRANCH_FOLLOWING_THRESHOLD)
+            numFollows < m_branch_following_threshold)
         {
           // bclrx with unconditional branch = return
           // Follow it if we can propagate the LR value of the last CALL instruction.
@@ -883,7 +903,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
-    if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (follow && numFollows < m_branch_following_threshold)
     {
       // Follow the unconditional branch.
       numFollows++;
@@ -211,12 +211,16 @@ public:
     OPTION_CROR_MERGE = (1 << 6),
   };
 
+  // How many unconditional branches a block follows by default. 0 does not perform block merging.
+  static constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+
   // Option setting/getting
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
   void SetDebuggingEnabled(bool enabled) { m_is_debugging_enabled = enabled; }
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
+  void SetBranchFollowingThreshold(u32 threshold) { m_branch_following_threshold = threshold; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
@@ -242,6 +246,7 @@ private:
 
   bool m_is_debugging_enabled = false;
   bool m_enable_branch_following = false;
+  u32 m_branch_following_threshold = BRANCH_FOLLOWING_THRESHOLD;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
 };
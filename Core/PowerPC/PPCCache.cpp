@@ -95,6 +95,7 @@ InstructionCache::~InstructionCache()
 
 void InstructionCache::Reset()
 {
+  m_last_line = NO_LAST_LINE;
   valid.fill(0);
   plru.fill(0);
   lookup_table.fill(0xFF);
@@ -134,6 +135,7 @@ void InstructionCache::Invalidate(u32 addr)
     }
   }
   valid[set] = 0;
+  m_last_line = NO_LAST_LINE;
   JitInterface::InvalidateICacheLine(addr);
 }
 
@@ -141,6 +143,13 @@ u32 InstructionCache::ReadInstruction(u32 addr)
 {
   if (!HID0.ICE || m_disable_icache)  // instruction cache is disabled
     return Memory::Read_U32(addr);
+
+  // Most fetches land on the same line as the one before. The line is still in the cache, as only
+  // a fetch from another line or an invalidation can evict it, and touching its way again would
+  // leave the PLRU bits as they are.
+  if ((addr >> 5) == m_last_line)
+    return Common::swap32(m_last_line_data[(addr >> 2) & 7]);
+
   u32 set = (addr >> 5) & 0x7f;
   u32 tag = addr >> 12;
 
@@ -190,6 +199,10 @@ u32 InstructionCache::ReadInstruction(u32 addr)
   }
   // update plru
   plru[set] = (plru[set] & ~s_plru_mask[t]) | s_plru_value[t];
+  m_last_line = addr >> 5;
+  m_last_line_data = data[set][t].data();
+
+  // Stale lines are only looked for when a fetch moves onto them
   const u32 res = Common::swap32(data[set][t][(addr >> 2) & 7]);
   const u32 inmem = Memory::Read_U32(addr);
   if (res != inmem)
@@ -211,6 +224,7 @@ void InstructionCache::DoState(PointerWrap& p)
   p.DoArray(lookup_table);
   p.DoArray(lookup_table_ex);
   p.DoArray(lookup_table_vmem);
+  m_last_line = NO_LAST_LINE;
 }
 
 void InstructionCache::RefreshConfig()
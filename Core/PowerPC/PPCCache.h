@@ -34,6 +34,11 @@ struct InstructionCache
   bool m_disable_icache = false;
   std::optional<size_t> m_config_callback_id = std::nullopt;
 
+  // The line the last fetch hit, as addr >> 5, and where its words are held
+  static constexpr u32 NO_LAST_LINE = 0xFFFFFFFF;
+  u32 m_last_line = NO_LAST_LINE;
+  const u32* m_last_line_data = nullptr;
+
   InstructionCache() = default;
   ~InstructionCache();
   u32 ReadInstruction(u32 addr);
@@ -18,6 +18,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -49,6 +50,41 @@ Common::Symbol* PPCSymbolDB::AddFunction(u32 start_addr)
   return ptr;
 }
 
+void PPCSymbolDB::AddFunctions(std::vector<u32> start_addrs)
+{
+  std::sort(start_addrs.begin(), start_addrs.end());
+  start_addrs.erase(std::unique(start_addrs.begin(), start_addrs.end()), start_addrs.end());
+  start_addrs.erase(std::remove_if(start_addrs.begin(), start_addrs.end(),
+                                   [this](u32 addr) { return m_functions.count(addr) != 0; }),
+                    start_addrs.end());
+
+  // Analysis only reads memory, so the functions can be analyzed independently of each other
+  constexpr size_t FUNCTIONS_PER_TASK = 256;
+  std::vector<Common::Symbol> symbols(start_addrs.size());
+  std::vector<u8> analyzed(start_addrs.size());
+  {
+    Common::TaskGroup task_group;
+    for (size_t begin = 0; begin < start_addrs.size(); begin += FUNCTIONS_PER_TASK)
+    {
+      const size_t end = std::min(begin + FUNCTIONS_PER_TASK, start_addrs.size());
+      task_group.Submit([&, begin, end] {
+        for (size_t i = begin; i < end; ++i)
+          analyzed[i] = PPCAnalyst::AnalyzeFunction(start_addrs[i], symbols[i]);
+      });
+    }
+  }
+
+  for (size_t i = 0; i < start_addrs.size(); ++i)
+  {
+    if (!analyzed[i])
+      continue;
+
+    Common::Symbol* ptr = &(m_functions[start_addrs[i]] = std::move(symbols[i]));
+    ptr->type = Common::Symbol::Type::Function;
+    m_checksum_to_function[ptr->hash].insert(ptr);
+  }
+}
+
 void PPCSymbolDB::AddKnownSymbol(u32 startAddr, u32 size, const std::string& name,
                                  Common::Symbol::Type type)
 {
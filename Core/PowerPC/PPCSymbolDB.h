@@ -20,6 +20,8 @@ public:
   ~PPCSymbolDB() override;
 
   Common::Symbol* AddFunction(u32 start_addr) override;
+  // Adds the functions that aren't in the list yet, analyzing them in parallel.
+  void AddFunctions(std::vector<u32> start_addrs);
   void AddKnownSymbol(u32 startAddr, u32 size, const std::string& name,
                       Common::Symbol::Type type = Common::Symbol::Type::Function);
 
@@ -48,6 +48,8 @@ PPCDebugInterface debug_interface;
 
 static CoreTiming::EventType* s_invalidate_cache_thread_safe;
 
+static FatalExceptionCallback s_fatal_exception_callback = nullptr;
+
 double PairedSingle::PS0AsDouble() const
 {
   return Common::BitCast<double>(ps0);
@@ -97,6 +99,15 @@ std::ostream& operator<<(std::ostream& os, CPUCore core)
   return os;
 }
 
+// Whether two sets of SPRs map the same BATs, including the extended ones of the Wii.
+static bool AreBATsEqual(const u32* lhs, const u32* rhs)
+{
+  constexpr u32 BAT_SPR_COUNT = 16;  // IBAT0U to DBAT3L, and IBAT4U to DBAT7L
+  return std::equal(lhs + SPR_IBAT0U, lhs + SPR_IBAT0U + BAT_SPR_COUNT, rhs + SPR_IBAT0U) &&
+         std::equal(lhs + SPR_IBAT4U, lhs + SPR_IBAT4U + BAT_SPR_COUNT, rhs + SPR_IBAT4U) &&
+         lhs[SPR_HID4] == rhs[SPR_HID4];
+}
+
 void DoState(PointerWrap& p)
 {
   // some of this code has been disabled, because
@@ -122,6 +133,9 @@ void DoState(PointerWrap& p)
   p.Do(ppcState.xer_stringctrl);
   p.DoArray(ppcState.ps);
   p.DoArray(ppcState.sr);
+  std::vector<u32> old_spr;
+  if (p.IsReadMode())
+    old_spr.assign(std::begin(ppcState.spr), std::end(ppcState.spr));
   p.DoArray(ppcState.spr);
   p.DoArray(ppcState.tlb);
   p.Do(ppcState.pagetable_base);
@@ -135,8 +149,18 @@ void DoState(PointerWrap& p)
   if (p.IsReadMode())
   {
     RoundingModeUpdated();
-    IBATUpdated();
-    DBATUpdated();
+    // Updating the BATs clears the JIT's blocks, which JitInterface::DoState may want to keep.
+    // Loading a state of the same game usually leaves them as they were, and then the BAT tables
+    // are still right, and only the translations of the segments that were loaded go stale.
+    if (AreBATsEqual(old_spr.data(), ppcState.spr))
+    {
+      SRUpdated();
+    }
+    else
+    {
+      IBATUpdated();
+      DBATUpdated();
+    }
   }
 
   // SystemTimers::DecrementerSet();
@@ -446,6 +470,17 @@ void UpdatePerformanceMonitor(u32 cycles, u32 num_load_stores, u32 num_fp_inst)
     PowerPC::ppcState.Exceptions |= EXCEPTION_PERFORMANCE_MONITOR;
 }
 
+void SetFatalExceptionCallback(FatalExceptionCallback callback)
+{
+  s_fatal_exception_callback = callback;
+}
+
+static void NotifyFatalException(u32 vector)
+{
+  if (s_fatal_exception_callback)
+    s_fatal_exception_callback(vector, SRR0);
+}
+
 void CheckExceptions()
 {
   u32 exceptions = ppcState.Exceptions;
@@ -482,6 +517,7 @@ void CheckExceptions()
 
     DEBUG_LOG_FMT(POWERPC, "EXCEPTION_ISI");
     ppcState.Exceptions &= ~EXCEPTION_ISI;
+    NotifyFatalException(0x00000400);
   }
   else if (exceptions & EXCEPTION_PROGRAM)
   {
@@ -494,6 +530,7 @@ void CheckExceptions()
 
     DEBUG_LOG_FMT(POWERPC, "EXCEPTION_PROGRAM");
     ppcState.Exceptions &= ~EXCEPTION_PROGRAM;
+    NotifyFatalException(0x00000700);
   }
   else if (exceptions & EXCEPTION_SYSCALL)
   {
@@ -533,6 +570,7 @@ void CheckExceptions()
 
     DEBUG_LOG_FMT(POWERPC, "EXCEPTION_DSI");
     ppcState.Exceptions &= ~EXCEPTION_DSI;
+    NotifyFatalException(0x00000300);
   }
   else if (exceptions & EXCEPTION_ALIGNMENT)
   {
@@ -546,6 +584,7 @@ void CheckExceptions()
 
     DEBUG_LOG_FMT(POWERPC, "EXCEPTION_ALIGNMENT");
     ppcState.Exceptions &= ~EXCEPTION_ALIGNMENT;
+    NotifyFatalException(0x00000600);
   }
 
   // EXTERNAL INTERRUPT
@@ -635,6 +674,7 @@ void PowerPCState::SetSR(u32 index, u32 value)
 {
   DEBUG_LOG_FMT(POWERPC, "{:08x}: MMU: Segment register {} set to {:08x}", pc, index, value);
   sr[index] = value;
+  SRUpdated();
 }
 
 // FPSCR update functions
@@ -226,6 +226,12 @@ void CheckExternalExceptions();
 void CheckBreakPoints();
 void RunLoop();
 
+// Called on the CPU thread with the vector and SRR0 of every ISI, DSI, program or alignment
+// exception CheckExceptions() delivers. Games don't take these in normal operation, so tools can
+// use this to tell that a game crashed. Pass nullptr to remove the callback.
+using FatalExceptionCallback = void (*)(u32 vector, u32 srr0);
+void SetFatalExceptionCallback(FatalExceptionCallback callback);
+
 u64 ReadFullTimeBaseValue();
 void WriteFullTimeBaseValue(u64 value);
 
@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
@@ -10,10 +11,12 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -101,12 +104,18 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
+u64 GetIndexKey(u32 size, u32 first_instruction)
+{
+  return (u64{size} << 32) | first_instruction;
+}
+
 bool Compare(u32 address, u32 size, const MEGASignature& sig)
 {
   if (size != sig.code.size() * sizeof(u32))
     return false;
 
-  for (size_t i = 0; i < sig.code.size(); ++i)
+  // The first instruction was already matched through the index
+  for (size_t i = 1; i < sig.code.size(); ++i)
   {
     if (sig.code[i] != 0 &&
         PowerPC::HostRead_U32(static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
@@ -122,6 +131,7 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -140,6 +150,9 @@ bool MEGASignatureDB::Load(const std::string& file_path)
 
     if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
     {
+      const u32 size = static_cast<u32>(sig.code.size() * sizeof(u32));
+      const u32 first_instruction = sig.code.empty() ? 0 : sig.code[0];
+      m_index[GetIndexKey(size, first_instruction)].push_back(m_signatures.size());
       m_signatures.push_back(std::move(sig));
     }
     else
@@ -156,20 +169,68 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
   return false;
 }
 
+// Returns the first signature in the file that matches the function
+const MEGASignature* MEGASignatureDB::FindSignature(u32 address, u32 size) const
+{
+  if (size % sizeof(u32) != 0)
+    return nullptr;
+
+  const auto find_first_match = [&](u64 key, size_t end) -> size_t {
+    const auto it = m_index.find(key);
+    if (it == m_index.end())
+      return end;
+    for (const size_t i : it->second)
+    {
+      if (i >= end)
+        break;
+      if (Compare(address, size, m_signatures[i]))
+        return i;
+    }
+    return end;
+  };
+
+  u32 first_instruction = 0;
+  if (size != 0)
+  {
+    const auto read_result = PowerPC::HostTryReadU32(address);
+    if (!read_result)
+      return nullptr;
+    first_instruction = read_result->value;
+  }
+
+  size_t match = find_first_match(GetIndexKey(size, first_instruction), m_signatures.size());
+  if (first_instruction != 0)
+    match = find_first_match(GetIndexKey(size, 0), match);
+
+  return match != m_signatures.size() ? &m_signatures[match] : nullptr;
+}
+
 void MEGASignatureDB::Apply(PPCSymbolDB* symbol_db) const
 {
+  std::vector<Common::Symbol*> symbols;
   for (auto& it : symbol_db->AccessSymbols())
+    symbols.push_back(&it.second);
+
+  // Matching only reads memory, so the symbols are split among the threads of the pool
+  constexpr size_t SYMBOLS_PER_TASK = 256;
   {
-    auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    Common::TaskGroup task_group;
+    for (size_t begin = 0; begin < symbols.size(); begin += SYMBOLS_PER_TASK)
     {
-      if (Compare(symbol.address, symbol.size, sig))
-      {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
-                     symbol.size);
-        break;
-      }
+      const size_t end = std::min(begin + SYMBOLS_PER_TASK, symbols.size());
+      task_group.Submit([this, &symbols, begin, end] {
+        for (size_t i = begin; i < end; ++i)
+        {
+          Common::Symbol& symbol = *symbols[i];
+          const MEGASignature* sig = FindSignature(symbol.address, symbol.size);
+          if (!sig)
+            continue;
+
+          symbol.name = sig->name;
+          INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig->name, symbol.address,
+                       symbol.size);
+        }
+      });
     }
   }
   symbol_db->Index();
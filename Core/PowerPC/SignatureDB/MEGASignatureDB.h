@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -52,5 +53,10 @@ public:
   bool Add(u32 startAddr, u32 size, const std::string& name) override;
 
 private:
+  const MEGASignature* FindSignature(u32 address, u32 size) const;
+
   std::vector<MEGASignature> m_signatures;
+  // Indices into m_signatures by code size and first instruction, in file order. Signatures that
+  // start with a wildcard are indexed with a first instruction of 0.
+  std::unordered_map<u64, std::vector<size_t>> m_index;
 };
@@ -3,16 +3,21 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
 #include <lzo/lzo1x.h>
 #include <map>
 #include <mutex>
+#include <numeric>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
+#include <zstd.h>
 
 #include <fmt/format.h>
 
+#include "Common/AsyncIOQueue.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
@@ -22,6 +27,7 @@
 #include "Common/ScopeGuard.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Tracing.h"
 #include "Common/Version.h"
 
 #include "Core/ConfigManager.h"
@@ -36,6 +42,8 @@
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
 
+#include "DiscIO/MultithreadedCompressor.h"
+
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -54,10 +62,8 @@ static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
 static unsigned char __LZO_MMODEL out[OUT_LEN];
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
-
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+// States favour speed over size, as they did with LZO.
+static const int ZSTD_STATE_LEVEL = 1;
 
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
@@ -74,7 +80,7 @@ static std::recursive_mutex g_save_thread_mutex;
 static std::thread g_save_thread;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 143;  // Last changed in PR 10784
+constexpr u32 STATE_VERSION = 145;  // Last changed for self-contained memory card states
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -101,6 +107,13 @@ enum
 
 static bool s_use_compression = true;
 
+// Size of the last state serialized, and how much more room the next one starts out with.
+static std::atomic<size_t> s_state_size_hint = 0;
+static constexpr size_t STATE_SIZE_SLACK = 1024 * 1024;
+
+// Only touched on the CPU thread, which every state is serialized on.
+static bool s_saving_to_buffer = false;
+
 void EnableCompression(bool compression)
 {
   s_use_compression = compression;
@@ -232,24 +245,39 @@ void LoadFromBuffer(std::vector<u8>& buffer)
       true);
 }
 
+// Serializes the state into buffer in a single pass. The buffer starts out as large as the last
+// state plus some slack, since states barely change in size from one save to the next. Returns
+// false if the save was aborted.
+static bool SerializeState(std::vector<u8>& buffer)
+{
+  buffer.resize(s_state_size_hint.load() + STATE_SIZE_SLACK);
+  u8* ptr = nullptr;
+  PointerWrap p(&ptr, buffer);
+  DoState(p);
+  if (!p.IsWriteMode())
+    return false;
+
+  buffer.resize(ptr - buffer.data());
+  s_state_size_hint.store(buffer.size());
+  return true;
+}
+
 void SaveToBuffer(std::vector<u8>& buffer)
 {
   Core::RunOnCPUThread(
       [&] {
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-
-        DoState(p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
-
-        ptr = buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(p);
+        s_saving_to_buffer = true;
+        SerializeState(buffer);
+        s_saving_to_buffer = false;
       },
       true);
 }
 
+bool IsSavingToBuffer()
+{
+  return s_saving_to_buffer;
+}
+
 // return state number not in map
 static int GetEmptySlot(std::map<double, int> m)
 {
@@ -297,6 +325,164 @@ static std::map<double, int> GetSavedStates()
   return m;
 }
 
+static u32 GetChunkCount(size_t size)
+{
+  return static_cast<u32>((size + STATE_CHUNK_SIZE - 1) / STATE_CHUNK_SIZE);
+}
+
+// Every compression thread keeps its own context.
+struct ZstdCompressState
+{
+  ~ZstdCompressState() { ZSTD_freeCCtx(ctx); }
+  ZSTD_CCtx* ctx = nullptr;
+};
+
+struct ZstdDecompressState
+{
+  ~ZstdDecompressState() { ZSTD_freeDCtx(ctx); }
+  ZSTD_DCtx* ctx = nullptr;
+};
+
+struct CompressedChunk
+{
+  u32 index = 0;
+  std::vector<u8> data;
+};
+
+// Writes the chunk index followed by the chunks, which are compressed in parallel. The index is
+// filled in once the last chunk has been written.
+static bool WriteZstdChunks(File::IOFile& f, const u8* data, size_t size)
+{
+  const u32 chunk_count = GetChunkCount(size);
+  std::vector<u32> chunk_sizes(chunk_count);
+  const u64 index_position = f.Tell();
+  if (!f.WriteArray(chunk_sizes.data(), chunk_count))
+    return false;
+
+  using Compressor = DiscIO::MultithreadedCompressor<ZstdCompressState, u32, CompressedChunk>;
+  Compressor compressor(
+      [](ZstdCompressState* state) {
+        state->ctx = ZSTD_createCCtx();
+        return state->ctx ? DiscIO::ConversionResultCode::Success :
+                            DiscIO::ConversionResultCode::InternalError;
+      },
+      [&](ZstdCompressState* state, u32 index) -> DiscIO::ConversionResult<CompressedChunk> {
+        const size_t offset = size_t{index} * STATE_CHUNK_SIZE;
+        const size_t length = std::min<size_t>(STATE_CHUNK_SIZE, size - offset);
+        CompressedChunk chunk{index, std::vector<u8>(ZSTD_compressBound(length))};
+        const size_t result = ZSTD_compressCCtx(state->ctx, chunk.data.data(), chunk.data.size(),
+                                                data + offset, length, ZSTD_STATE_LEVEL);
+        if (ZSTD_isError(result))
+          return DiscIO::ConversionResultCode::InternalError;
+        chunk.data.resize(result);
+        return chunk;
+      },
+      [&](CompressedChunk chunk) {
+        chunk_sizes[chunk.index] = static_cast<u32>(chunk.data.size());
+        return f.WriteBytes(chunk.data.data(), chunk.data.size()) ?
+                   DiscIO::ConversionResultCode::Success :
+                   DiscIO::ConversionResultCode::WriteFailed;
+      });
+
+  for (u32 i = 0;
+       i < chunk_count && compressor.GetStatus() == DiscIO::ConversionResultCode::Success; ++i)
+  {
+    compressor.CompressAndWrite(i);
+  }
+  compressor.Shutdown();
+  if (compressor.GetStatus() != DiscIO::ConversionResultCode::Success)
+    return false;
+
+  const u64 end_position = f.Tell();
+  return f.Seek(index_position, File::SeekOrigin::Begin) &&
+         f.WriteArray(chunk_sizes.data(), chunk_count) &&
+         f.Seek(end_position, File::SeekOrigin::Begin);
+}
+
+// Reads the chunk index and the chunks, decompressing the chunks in parallel into buffer as they
+// arrive. buffer is sized to the uncompressed state once the index has been checked against the
+// file, so a corrupted header can't make us allocate more than the file could hold.
+static bool ReadZstdChunks(File::IOFile& f, u32 size, u32 chunk_count, std::vector<u8>& buffer)
+{
+  if (chunk_count != GetChunkCount(size))
+    return false;
+
+  const u64 position = f.Tell();
+  const u64 file_size = f.GetSize();
+  if (position > file_size || (file_size - position) / sizeof(u32) < chunk_count)
+    return false;
+  const u64 data_size = file_size - position - u64{chunk_count} * sizeof(u32);
+
+  std::vector<u32> chunk_sizes(chunk_count);
+  if (!f.ReadArray(chunk_sizes.data(), chunk_count))
+    return false;
+  const size_t max_chunk_size = ZSTD_compressBound(STATE_CHUNK_SIZE);
+  if (std::any_of(chunk_sizes.begin(), chunk_sizes.end(),
+                  [&](u32 chunk_size) { return chunk_size == 0 || chunk_size > max_chunk_size; }))
+  {
+    return false;
+  }
+  std::vector<u64> chunk_offsets(chunk_count);
+  std::exclusive_scan(chunk_sizes.begin(), chunk_sizes.end(), chunk_offsets.begin(), u64{0});
+  const u64 compressed_size = chunk_count ? chunk_offsets.back() + chunk_sizes.back() : 0;
+  if (compressed_size > data_size)
+    return false;
+  std::vector<u8> compressed(compressed_size);
+  buffer.resize(size);
+  const u64 data_position = f.Tell();
+
+  // Chunks decompress straight into their place in the buffer, so there is nothing to output.
+  using Decompressor = DiscIO::MultithreadedCompressor<ZstdDecompressState, u32, u32>;
+  Decompressor decompressor(
+      [](ZstdDecompressState* state) {
+        state->ctx = ZSTD_createDCtx();
+        return state->ctx ? DiscIO::ConversionResultCode::Success :
+                            DiscIO::ConversionResultCode::InternalError;
+      },
+      [&](ZstdDecompressState* state, u32 index) -> DiscIO::ConversionResult<u32> {
+        const size_t offset = size_t{index} * STATE_CHUNK_SIZE;
+        const size_t length = std::min<size_t>(STATE_CHUNK_SIZE, buffer.size() - offset);
+        const u8* chunk = compressed.data() + chunk_offsets[index];
+        const unsigned long long content_size =
+            ZSTD_getFrameContentSize(chunk, chunk_sizes[index]);
+        if (content_size == ZSTD_CONTENTSIZE_ERROR ||
+            (content_size != ZSTD_CONTENTSIZE_UNKNOWN && content_size != length))
+        {
+          return DiscIO::ConversionResultCode::ReadFailed;
+        }
+        const size_t result = ZSTD_decompressDCtx(state->ctx, buffer.data() + offset, length,
+                                                  chunk, chunk_sizes[index]);
+        if (result != length)
+          return DiscIO::ConversionResultCode::ReadFailed;
+        return index;
+      },
+      [](u32) { return DiscIO::ConversionResultCode::Success; });
+
+  // A single I/O worker completes the reads in order and hands each chunk to the decompressor, so
+  // decompressing overlaps with reading the rest of the file.
+  bool read_success;
+  {
+    File::AsyncIOQueue io;
+    std::vector<File::AsyncIOQueue::Request> requests(chunk_count);
+    for (u32 i = 0; i < chunk_count; ++i)
+    {
+      requests[i] = {&f, data_position + chunk_offsets[i], compressed.data() + chunk_offsets[i],
+                     chunk_sizes[i], false, [&decompressor, i](bool success) {
+                       if (success &&
+                           decompressor.GetStatus() == DiscIO::ConversionResultCode::Success)
+                       {
+                         decompressor.CompressAndWrite(i);
+                       }
+                     }};
+    }
+    io.Submit(std::move(requests));
+    read_success = io.Wait();
+  }
+  decompressor.Shutdown();
+  return read_success && f.Seek(data_position + compressed_size, File::SeekOrigin::Begin) &&
+         decompressor.GetStatus() == DiscIO::ConversionResultCode::Success;
+}
+
 struct CompressAndDumpState_args
 {
   std::vector<u8>* buffer_vector = nullptr;
@@ -307,6 +493,7 @@ struct CompressAndDumpState_args
 
 static void CompressAndDumpState(CompressAndDumpState_args save_args)
 {
+  TRACE_SPAN("State::CompressAndDumpState");
   std::lock_guard lk(*save_args.buffer_mutex);
 
   // ScopeGuard is used here to ensure that g_compressAndDumpStateSyncEvent.Set()
@@ -328,6 +515,7 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   // For easy debugging
   Common::SetCurrentThreadName("SaveState thread");
+  Common::PlaceCurrentThread(Common::ThreadRole::Worker);
 
   // Moving to last overwritten save-state
   if (File::Exists(filename))
@@ -359,38 +547,18 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.gameID, std::size(header.gameID));
   header.size = s_use_compression ? (u32)buffer_size : 0;
+  header.compression = StateCompression::ZstdChunks;
+  header.chunk_count = s_use_compression ? GetChunkCount(buffer_size) : 0;
   header.time = Common::Timer::GetDoubleTime();
 
   f.WriteArray(&header, 1);
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
+    if (!WriteZstdChunks(f, buffer_data, buffer_size))
     {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
+      Core::DisplayMessage("Could not save state", 2000);
+      return;
     }
   }
   else  // uncompressed
@@ -410,21 +578,10 @@ void SaveAs(const std::string& filename, bool wait)
 
   Core::RunOnCPUThread(
       [&] {
-        // Measure the size of the buffer.
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-        DoState(p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-        // Then actually do the write.
         bool is_write_mode;
         {
           std::lock_guard lk(g_cs_current_buffer);
-          g_current_buffer.resize(buffer_size);
-          ptr = g_current_buffer.data();
-          PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-          DoState(p);
-          is_write_mode = p.IsWriteMode();
+          is_write_mode = SerializeState(g_current_buffer);
         }
 
         if (is_write_mode)
@@ -485,6 +642,34 @@ u64 GetUnixTimeOfSlot(int slot)
          (Common::Timer::DOUBLE_TIME_OFFSET * MS_PER_SEC);
 }
 
+// Reads the LZO blocks states were compressed into before chunked zstd.
+static bool ReadLZOBlocks(File::IOFile& f, std::vector<u8>& buffer)
+{
+  lzo_uint i = 0;
+  while (true)
+  {
+    lzo_uint32 cur_len = 0;  // number of bytes to read
+    lzo_uint new_len = 0;    // number of bytes to write
+
+    if (!f.ReadArray(&cur_len, 1))
+      break;
+
+    f.ReadBytes(out, cur_len);
+    const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
+    if (res != LZO_E_OK)
+    {
+      // This doesn't seem to happen anymore.
+      PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
+                     "Try loading the state again",
+                     res, i, new_len);
+      return false;
+    }
+
+    i += new_len;
+  }
+  return true;
+}
+
 static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
 {
   Flush();
@@ -511,29 +696,24 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
   {
     Core::DisplayMessage("Decompressing State...", 500);
 
-    buffer.resize(header.size);
-
-    lzo_uint i = 0;
-    while (true)
+    if (header.compression == StateCompression::ZstdChunks)
     {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
-
-      if (!f.ReadArray(&cur_len, 1))
-        break;
-
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
+      if (!ReadZstdChunks(f, header.size, header.chunk_count, buffer))
       {
-        // This doesn't seem to happen anymore.
-        PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
-                       "Try loading the state again",
-                       res, i, new_len);
+        PanicAlertFmtT("Failed to decompress state, the file may be corrupted");
         return;
       }
-
-      i += new_len;
+    }
+    else if (header.compression == StateCompression::LZO)
+    {
+      buffer.resize(header.size);
+      if (!ReadLZOBlocks(f, buffer))
+        return;
+    }
+    else
+    {
+      Core::DisplayMessage("State uses an unknown compression format", 2000);
+      return;
     }
   }
   else  // uncompressed
@@ -17,12 +17,24 @@ namespace State
 // number of states
 static const u32 NUM_STATES = 10;
 
+enum class StateCompression : u16
+{
+  // Consecutive LZO blocks, each preceded by its compressed size.
+  LZO = 0,
+  // Independently compressed zstd chunks of STATE_CHUNK_SIZE bytes, preceded by the compressed
+  // size of every chunk.
+  ZstdChunks = 1,
+};
+
+constexpr u32 STATE_CHUNK_SIZE = 1024 * 1024;
+
 struct StateHeader
 {
   char gameID[6];
-  u16 reserved1;
+  StateCompression compression;
+  // Size of the uncompressed state, or 0 if the state isn't compressed.
   u32 size;
-  u32 reserved2;
+  u32 chunk_count;
   double time;
 };
 constexpr size_t STATE_HEADER_SIZE = sizeof(StateHeader);
@@ -58,6 +70,9 @@ void LoadAs(const std::string& filename);
 
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
+// Whether the state being saved goes to a buffer, which is only ever loaded back in this session,
+// rather than to a file, which may be loaded after a restart. Only meaningful during a save.
+bool IsSavingToBuffer();
 
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
@@ -0,0 +1,194 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateRewind.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/Assert.h"
+
+#include "Core/State.h"
+
+namespace State
+{
+// A delta is a sequence of records, each an offset, a length and that many bytes to XOR into
+// the previous snapshot. Differences closer together than this many bytes share a record.
+static constexpr size_t MAX_RUN_GAP = 8;
+static constexpr size_t RECORD_HEADER_SIZE = sizeof(u32) + sizeof(u16);
+
+RewindBuffer::RewindBuffer(size_t memory_budget, u32 keyframe_interval)
+    : m_memory_budget(memory_budget), m_keyframe_interval(std::max<u32>(keyframe_interval, 1))
+{
+}
+
+std::vector<u8> RewindBuffer::EncodeDelta(const std::vector<u8>& from, const std::vector<u8>& to)
+{
+  ASSERT(from.size() == to.size());
+
+  std::vector<u8> delta;
+  for (size_t page = 0; page < to.size(); page += PAGE_SIZE)
+  {
+    const size_t page_end = std::min(page + PAGE_SIZE, to.size());
+    if (std::memcmp(&from[page], &to[page], page_end - page) == 0)
+      continue;
+
+    size_t i = page;
+    while (i < page_end)
+    {
+      while (i < page_end && from[i] == to[i])
+        ++i;
+      if (i == page_end)
+        break;
+
+      const size_t start = i;
+      size_t last_difference = i;
+      while (i < page_end && i - last_difference <= MAX_RUN_GAP)
+      {
+        if (from[i] != to[i])
+          last_difference = i;
+        ++i;
+      }
+      const size_t end = last_difference + 1;
+
+      const u32 offset = static_cast<u32>(start);
+      const u16 length = static_cast<u16>(end - start);
+      const size_t record = delta.size();
+      delta.resize(record + RECORD_HEADER_SIZE + length);
+      std::memcpy(&delta[record], &offset, sizeof(offset));
+      std::memcpy(&delta[record + sizeof(offset)], &length, sizeof(length));
+      for (size_t j = 0; j < length; ++j)
+        delta[record + RECORD_HEADER_SIZE + j] = from[start + j] ^ to[start + j];
+
+      i = end;
+    }
+  }
+  return delta;
+}
+
+void RewindBuffer::ApplyDelta(const std::vector<u8>& delta, std::vector<u8>& state)
+{
+  size_t position = 0;
+  while (position < delta.size())
+  {
+    u32 offset;
+    u16 length;
+    std::memcpy(&offset, &delta[position], sizeof(offset));
+    std::memcpy(&length, &delta[position + sizeof(offset)], sizeof(length));
+    position += RECORD_HEADER_SIZE;
+
+    for (size_t i = 0; i < length; ++i)
+      state[offset + i] ^= delta[position + i];
+    position += length;
+  }
+}
+
+void RewindBuffer::Push(const std::vector<u8>& state)
+{
+  // Deltas need the snapshots on both sides to be the same size
+  const bool keyframe = m_entries.empty() || m_force_keyframe ||
+                        m_since_keyframe + 1 >= m_keyframe_interval ||
+                        state.size() != m_newest.size();
+  if (keyframe)
+  {
+    m_entries.push_back({true, state});
+    m_since_keyframe = 0;
+    m_force_keyframe = false;
+  }
+  else
+  {
+    m_entries.push_back({false, EncodeDelta(m_newest, state)});
+    ++m_since_keyframe;
+  }
+
+  m_memory_usage += m_entries.back().data.size() + state.size() - m_newest.size();
+  m_newest = state;
+  Trim();
+}
+
+void RewindBuffer::Trim()
+{
+  while (m_memory_usage > m_memory_budget)
+  {
+    // The oldest deltas can only go together with the keyframe they build on
+    const auto next_keyframe = std::find_if(m_entries.begin() + 1, m_entries.end(),
+                                            [](const Entry& entry) { return entry.keyframe; });
+    if (next_keyframe == m_entries.end())
+    {
+      // Start a new keyframe early, so this one can be dropped once it exists
+      m_force_keyframe = true;
+      return;
+    }
+
+    for (auto it = m_entries.begin(); it != next_keyframe; ++it)
+      m_memory_usage -= it->data.size();
+    m_entries.erase(m_entries.begin(), next_keyframe);
+  }
+}
+
+bool RewindBuffer::Restore(size_t index, std::vector<u8>& state) const
+{
+  if (index >= m_entries.size())
+    return false;
+  if (index == m_entries.size() - 1)
+  {
+    state = m_newest;
+    return true;
+  }
+
+  size_t keyframe = index;
+  while (!m_entries[keyframe].keyframe)
+    --keyframe;
+
+  state = m_entries[keyframe].data;
+  for (size_t i = keyframe + 1; i <= index; ++i)
+    ApplyDelta(m_entries[i].data, state);
+  return true;
+}
+
+void RewindBuffer::Truncate(size_t index)
+{
+  if (index + 1 >= m_entries.size())
+    return;
+
+  std::vector<u8> state;
+  Restore(index, state);
+  m_memory_usage += state.size() - m_newest.size();
+  m_newest = std::move(state);
+
+  for (size_t i = index + 1; i < m_entries.size(); ++i)
+    m_memory_usage -= m_entries[i].data.size();
+  m_entries.erase(m_entries.begin() + index + 1, m_entries.end());
+
+  m_since_keyframe = 0;
+  for (size_t i = index; !m_entries[i].keyframe; --i)
+    ++m_since_keyframe;
+}
+
+void RewindBuffer::Clear()
+{
+  m_entries.clear();
+  m_newest.clear();
+  m_since_keyframe = 0;
+  m_force_keyframe = false;
+  m_memory_usage = 0;
+}
+
+void RewindBuffer::Capture()
+{
+  std::vector<u8> state;
+  SaveToBuffer(state);
+  Push(state);
+}
+
+bool RewindBuffer::Rewind(size_t index)
+{
+  std::vector<u8> state;
+  if (!Restore(index, state))
+    return false;
+
+  LoadFromBuffer(state);
+  Truncate(index);
+  return true;
+}
+}  // namespace State
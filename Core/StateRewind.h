@@ -0,0 +1,61 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+// A ring of in-memory savestates for rewinding. Every keyframe_interval-th snapshot is kept in
+// full, the ones in between as XOR run-length deltas of their changed 4 KiB pages against the
+// snapshot before them. Once the ring outgrows its memory budget, the oldest keyframe and its
+// deltas are dropped together.
+class RewindBuffer
+{
+public:
+  static constexpr size_t PAGE_SIZE = 0x1000;
+
+  explicit RewindBuffer(size_t memory_budget, u32 keyframe_interval = 60);
+
+  // Adds a snapshot as the newest entry.
+  void Push(const std::vector<u8>& state);
+  // Rebuilds the snapshot at index, 0 being the oldest one held. Returns false if there is none.
+  bool Restore(size_t index, std::vector<u8>& state) const;
+  // Drops every entry newer than index, so the ring continues from that snapshot.
+  void Truncate(size_t index);
+  void Clear();
+
+  size_t GetCount() const { return m_entries.size(); }
+  size_t GetMemoryUsage() const { return m_memory_usage; }
+
+  // Saves the running game into the ring, and loads a snapshot from it back into the game.
+  void Capture();
+  bool Rewind(size_t index);
+
+private:
+  struct Entry
+  {
+    bool keyframe;
+    std::vector<u8> data;
+  };
+
+  static std::vector<u8> EncodeDelta(const std::vector<u8>& from, const std::vector<u8>& to);
+  static void ApplyDelta(const std::vector<u8>& delta, std::vector<u8>& state);
+
+  void Trim();
+
+  size_t m_memory_budget;
+  u32 m_keyframe_interval;
+  std::deque<Entry> m_entries;
+  // The newest snapshot in full, which the next delta is taken against.
+  std::vector<u8> m_newest;
+  u32 m_since_keyframe = 0;
+  bool m_force_keyframe = false;
+  size_t m_memory_usage = 0;
+};
+}  // namespace State
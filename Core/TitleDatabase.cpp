@@ -3,9 +3,11 @@
 
 #include "Core/TitleDatabase.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <fstream>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -51,13 +53,79 @@ static Map LoadMap(const std::string& file_path)
   return map;
 }
 
+static std::string_view GetView(const std::string& contents, u32 offset, u32 length)
+{
+  return std::string_view(contents).substr(offset, length);
+}
+
 void TitleDatabase::AddLazyMap(DiscIO::Language language, const std::string& language_code)
 {
-  m_title_maps[language] = [language_code]() -> Map {
-    return LoadMap(File::GetSysDirectory() + "wiitdb-" + language_code + ".txt");
+  m_title_maps[language] = [language_code]() -> TitleIndex {
+    TitleIndex index;
+    if (!File::ReadFileToString(File::GetSysDirectory() + "wiitdb-" + language_code + ".txt",
+                                index.contents))
+    {
+      return index;
+    }
+
+    const std::string_view contents = index.contents;
+    size_t line_start = 0;
+    while (line_start < contents.size())
+    {
+      const size_t line_end = std::min(contents.find('\n', line_start), contents.size());
+      const std::string_view line = contents.substr(line_start, line_end - line_start);
+
+      const size_t equals_index = line.find('=');
+      if (equals_index != std::string::npos)
+      {
+        const std::string_view game_id = StripSpaces(line.substr(0, equals_index));
+        const std::string_view name = StripSpaces(line.substr(equals_index + 1));
+        if (game_id.length() >= 4)
+        {
+          index.entries.push_back({static_cast<u32>(game_id.data() - contents.data()),
+                                   static_cast<u32>(game_id.size()),
+                                   static_cast<u32>(name.data() - contents.data()),
+                                   static_cast<u32>(name.size())});
+        }
+      }
+      line_start = line_end + 1;
+    }
+
+    // Stable, so that the first of several entries for an ID is the one found, as with a map
+    std::stable_sort(index.entries.begin(), index.entries.end(),
+                     [&contents = index.contents](const auto& a, const auto& b) {
+                       return GetView(contents, a.id_offset, a.id_length) <
+                              GetView(contents, b.id_offset, b.id_length);
+                     });
+    return index;
   };
 }
 
+const std::string* TitleDatabase::FindBuiltInName(const std::string& gametdb_id,
+                                                  DiscIO::Language language) const
+{
+  TitleIndex& index = *m_title_maps.at(language);
+
+  const auto cached = index.names.find(gametdb_id);
+  if (cached != index.names.end())
+    return &cached->second;
+
+  const auto it =
+      std::lower_bound(index.entries.begin(), index.entries.end(), gametdb_id,
+                       [&index](const TitleIndex::Entry& entry, const std::string& id) {
+                         return GetView(index.contents, entry.id_offset, entry.id_length) < id;
+                       });
+  if (it == index.entries.end() ||
+      GetView(index.contents, it->id_offset, it->id_length) != gametdb_id)
+  {
+    return nullptr;
+  }
+
+  return &index.names
+              .emplace(gametdb_id, GetView(index.contents, it->name_offset, it->name_length))
+              .first->second;
+}
+
 TitleDatabase::TitleDatabase()
 {
   // User database
@@ -77,7 +145,7 @@ TitleDatabase::TitleDatabase()
   AddLazyMap(DiscIO::Language::SimplifiedChinese, "zh_CN");
   AddLazyMap(DiscIO::Language::TraditionalChinese, "zh_TW");
   AddLazyMap(DiscIO::Language::Korean, "ko");
-  m_title_maps[DiscIO::Language::Unknown] = [] { return Map(); };
+  m_title_maps[DiscIO::Language::Unknown] = [] { return TitleIndex(); };
 
   // Titles that aren't part of the Wii TDB, but common enough to justify having entries for them.
 
@@ -100,17 +168,17 @@ const std::string& TitleDatabase::GetTitleName(const std::string& gametdb_id,
   if (!Config::Get(Config::MAIN_USE_BUILT_IN_TITLE_DATABASE))
     return EMPTY_STRING;
 
-  const Map& map = *m_title_maps.at(language);
-  it = map.find(gametdb_id);
-  if (it != map.end())
-    return it->second;
-
-  if (language != DiscIO::Language::English)
   {
-    const Map& english_map = *m_title_maps.at(DiscIO::Language::English);
-    it = english_map.find(gametdb_id);
-    if (it != english_map.end())
-      return it->second;
+    std::lock_guard lk(m_title_maps_mutex);
+
+    if (const std::string* name = FindBuiltInName(gametdb_id, language))
+      return *name;
+
+    if (language != DiscIO::Language::English)
+    {
+      if (const std::string* name = FindBuiltInName(gametdb_id, DiscIO::Language::English))
+        return *name;
+    }
   }
 
   it = m_base_map.find(gametdb_id);
@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Lazy.h"
@@ -34,10 +36,29 @@ public:
   std::string Describe(const std::string& gametdb_id, DiscIO::Language language) const;
 
 private:
+  // The contents of a built-in database file, along with where each entry is in them, sorted by
+  // GameTDB ID. Names are only copied out of the contents once they are looked up.
+  struct TitleIndex
+  {
+    struct Entry
+    {
+      u32 id_offset;
+      u32 id_length;
+      u32 name_offset;
+      u32 name_length;
+    };
+
+    std::string contents;
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, std::string> names;
+  };
+
   void AddLazyMap(DiscIO::Language language, const std::string& language_code);
+  const std::string* FindBuiltInName(const std::string& gametdb_id,
+                                     DiscIO::Language language) const;
 
-  std::unordered_map<DiscIO::Language, Common::Lazy<std::unordered_map<std::string, std::string>>>
-      m_title_maps;
+  mutable std::mutex m_title_maps_mutex;
+  mutable std::unordered_map<DiscIO::Language, Common::Lazy<TitleIndex>> m_title_maps;
   std::unordered_map<std::string, std::string> m_base_map;
   std::unordered_map<std::string, std::string> m_user_title_map;
 };
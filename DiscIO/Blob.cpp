@@ -20,6 +20,7 @@
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/DriveBlob.h"
 #include "DiscIO/FileBlob.h"
+#include "DiscIO/PrefetchBlob.h"
 #include "DiscIO/TGCBlob.h"
 #include "DiscIO/WIABlob.h"
 #include "DiscIO/WbfsBlob.h"
@@ -233,20 +234,20 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
   case CISO_MAGIC:
     return CISOFileReader::Create(std::move(file));
   case GCZ_MAGIC:
-    return CompressedBlobReader::Create(std::move(file), filename);
+    return PrefetchBlobReader::Create(CompressedBlobReader::Create(std::move(file), filename));
   case TGC_MAGIC:
     return TGCFileReader::Create(std::move(file));
   case WBFS_MAGIC:
-    return WbfsFileReader::Create(std::move(file), filename);
+    return PrefetchBlobReader::Create(WbfsFileReader::Create(std::move(file), filename));
   case WIA_MAGIC:
-    return WIAFileReader::Create(std::move(file), filename);
+    return PrefetchBlobReader::Create(WIAFileReader::Create(std::move(file), filename));
   case RVZ_MAGIC:
-    return RVZFileReader::Create(std::move(file), filename);
+    return PrefetchBlobReader::Create(RVZFileReader::Create(std::move(file), filename));
   default:
     if (auto directory_blob = DirectoryBlobReader::Create(filename))
       return std::move(directory_blob);
 
-    return PlainFileReader::Create(std::move(file));
+    return PlainFileReader::Create(std::move(file), filename);
   }
 }
 
@@ -72,6 +72,11 @@ public:
     return Common::FromBigEndian(temp);
   }
 
+  // Returns a pointer to the data at [offset, offset + size) if the reader has all of it in
+  // memory, or nullptr otherwise. The pointer stays valid for as long as the reader exists.
+  // NOT thread-safe, just like Read.
+  virtual const u8* GetDataPointer(u64 offset, u64 size) { return nullptr; }
+
   virtual bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const
   {
     return false;
@@ -27,6 +27,7 @@
 #include "Core/Boot/DolReader.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/DirectoryScanCache.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/VolumeDisc.h"
 #include "DiscIO/VolumeWii.h"
@@ -1016,7 +1017,7 @@ static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::F
 
 void DirectoryBlobPartition::BuildFSTFromFolder(const std::string& fst_root_path, u64 fst_address)
 {
-  auto nodes = ConvertFSTEntriesToBuilderNodes(File::ScanDirectoryTree(fst_root_path, true));
+  auto nodes = ConvertFSTEntriesToBuilderNodes(ScanDirectoryTreeCached(fst_root_path));
   BuildFST(std::move(nodes), fst_address);
 }
 
@@ -0,0 +1,244 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/DirectoryScanCache.h"
+
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace DiscIO
+{
+// Increment this if the format of the cache files changes
+static constexpr u32 CACHE_REVISION = 1;
+
+namespace
+{
+struct CachedEntry
+{
+  bool is_directory = false;
+  // File length, or for directories, recursive count of children
+  u64 size = 0;
+  std::string physical_name;
+  std::string virtual_name;
+  // Only used for directories
+  s64 modification_time = 0;
+  std::vector<CachedEntry> children;
+
+  void DoState(PointerWrap& p)
+  {
+    p.Do(is_directory);
+    p.Do(size);
+    p.Do(physical_name);
+    p.Do(virtual_name);
+    p.Do(modification_time);
+    p.DoEachElement(children, [](PointerWrap& state, CachedEntry& child) { child.DoState(state); });
+  }
+};
+
+struct CacheFile
+{
+  std::string directory;
+  // When the cache was written. See RefreshEntry for why this is needed.
+  s64 scan_time = 0;
+  CachedEntry root;
+
+  void DoState(PointerWrap& p)
+  {
+    p.Do(directory);
+    p.Do(scan_time);
+    root.DoState(p);
+  }
+};
+}  // namespace
+
+static std::string GetCachePath(const std::string& directory)
+{
+  const u64 hash =
+      Common::HashXXH64(reinterpret_cast<const u8*>(directory.data()), directory.size());
+  return fmt::format("{}DirectoryBlob/{:016x}.cache", File::GetUserPath(D_CACHE_IDX), hash);
+}
+
+static void UpdateDirectorySize(CachedEntry* entry)
+{
+  entry->size = 0;
+  for (const CachedEntry& child : entry->children)
+    entry->size += 1 + (child.is_directory ? child.size : 0);
+}
+
+static CachedEntry ScanDirectory(const std::string& physical_name, std::string virtual_name)
+{
+  CachedEntry entry;
+  entry.is_directory = true;
+  entry.physical_name = physical_name;
+  entry.virtual_name = std::move(virtual_name);
+  // Getting the time before listing the directory means that a change made during the listing
+  // gets noticed the next time
+  entry.modification_time = File::FileInfo(physical_name).GetModificationTime();
+
+  File::FSTEntry listing = File::ScanDirectoryTree(physical_name, false);
+  entry.children.reserve(listing.children.size());
+  for (File::FSTEntry& child : listing.children)
+  {
+    if (child.isDirectory)
+    {
+      entry.children.push_back(ScanDirectory(child.physicalName, std::move(child.virtualName)));
+    }
+    else
+    {
+      CachedEntry& file = entry.children.emplace_back();
+      file.size = child.size;
+      file.physical_name = std::move(child.physicalName);
+      file.virtual_name = std::move(child.virtualName);
+    }
+  }
+
+  UpdateDirectorySize(&entry);
+  return entry;
+}
+
+// Returns true if anything changed
+static bool RefreshEntry(CachedEntry* entry, s64 scan_time)
+{
+  const File::FileInfo info(entry->physical_name);
+
+  if (!entry->is_directory)
+  {
+    // Adding, removing or renaming a file changes its directory, but changing what's in the file
+    // doesn't, so the size has to be checked for every file
+    if (info.GetSize() == entry->size)
+      return false;
+    entry->size = info.GetSize();
+    return true;
+  }
+
+  // Modification times only have a resolution of one second, so a directory that was modified in
+  // the same second as the cache was written might have changed after it was listed
+  const s64 modification_time = info.GetModificationTime();
+  if (!info.IsDirectory() || modification_time != entry->modification_time ||
+      modification_time >= scan_time)
+  {
+    *entry = ScanDirectory(entry->physical_name, std::move(entry->virtual_name));
+    return true;
+  }
+
+  bool changed = false;
+  for (CachedEntry& child : entry->children)
+    changed |= RefreshEntry(&child, scan_time);
+  if (changed)
+    UpdateDirectorySize(entry);
+  return changed;
+}
+
+static File::FSTEntry ToFSTEntry(const CachedEntry& entry)
+{
+  File::FSTEntry fst_entry;
+  fst_entry.isDirectory = entry.is_directory;
+  fst_entry.size = entry.size;
+  fst_entry.physicalName = entry.physical_name;
+  fst_entry.virtualName = entry.virtual_name;
+  fst_entry.children.reserve(entry.children.size());
+  for (const CachedEntry& child : entry.children)
+    fst_entry.children.push_back(ToFSTEntry(child));
+  return fst_entry;
+}
+
+static bool LoadCache(const std::string& path, const std::string& directory, CacheFile* cache)
+{
+  File::IOFile file(path, "rb");
+  std::vector<u8> buffer(file.GetSize());
+  if (buffer.empty() || !file.ReadBytes(buffer.data(), buffer.size()))
+    return false;
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  u32 revision = 0;
+  p.Do(revision);
+  if (revision != CACHE_REVISION)
+    return false;
+  cache->DoState(p);
+
+  return p.IsReadMode() && cache->directory == directory;
+}
+
+static void SaveCache(const std::string& path, CacheFile* cache)
+{
+  u32 revision = CACHE_REVISION;
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  p_measure.Do(revision);
+  cache->DoState(p_measure);
+  const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+
+  std::vector<u8> buffer(buffer_size);
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+  p.Do(revision);
+  cache->DoState(p);
+
+  // Write to a temporary file first, so that another instance never reads a partial cache
+  const std::string temp_path = path + ".tmp";
+  if (!File::CreateFullPath(path))
+    return;
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file.WriteBytes(buffer.data(), buffer.size()))
+      return;
+  }
+  if (!File::Rename(temp_path, path))
+    File::Delete(temp_path);
+}
+
+File::FSTEntry ScanDirectoryTreeCached(const std::string& directory)
+{
+  // Match File::ScanDirectoryTree, which removes a trailing separator
+  std::string trimmed_directory = directory;
+#ifdef _WIN32
+  if (!trimmed_directory.empty() &&
+      (trimmed_directory.back() == '/' || trimmed_directory.back() == '\\'))
+  {
+    trimmed_directory.pop_back();
+  }
+#else
+  if (!trimmed_directory.empty() && trimmed_directory.back() == '/')
+    trimmed_directory.pop_back();
+#endif
+
+  const std::string cache_path = GetCachePath(trimmed_directory);
+  const s64 scan_time = static_cast<s64>(std::time(nullptr));
+
+  CacheFile cache;
+  bool changed;
+  if (LoadCache(cache_path, trimmed_directory, &cache))
+  {
+    changed = RefreshEntry(&cache.root, cache.scan_time);
+    DEBUG_LOG_FMT(DISCIO, "Reused the cached listing of {} ({})", trimmed_directory,
+                  changed ? "updated" : "unchanged");
+  }
+  else
+  {
+    cache.directory = trimmed_directory;
+    cache.root = ScanDirectory(trimmed_directory, {});
+    changed = true;
+  }
+
+  if (changed)
+  {
+    cache.scan_time = scan_time;
+    SaveCache(cache_path, &cache);
+  }
+
+  return ToFSTEntry(cache.root);
+}
+}  // namespace DiscIO
@@ -0,0 +1,17 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/FileUtil.h"
+
+namespace DiscIO
+{
+// Returns the same as File::ScanDirectoryTree(directory, true), but keeps the result in the cache
+// directory so that the next scan of the same directory can reuse it. Directories whose
+// modification time hasn't changed since then aren't listed again, and only the sizes of the
+// files in them are checked.
+File::FSTEntry ScanDirectoryTreeCached(const std::string& directory);
+}  // namespace DiscIO
@@ -4,14 +4,22 @@
 #include "DiscIO/DiscExtractor.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/ThreadPool.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Filesystem.h"
@@ -132,6 +140,225 @@ void ExportDirectory(const Volume& volume, const Partition& partition, const Fil
   }
 }
 
+namespace
+{
+// Files bigger than this are split into ranges of this size, so that one big file doesn't keep
+// the other threads waiting at the end
+constexpr u64 EXPORT_RANGE_SIZE = 0x4000000;
+// The size of the reads and writes done by each thread
+constexpr u64 EXPORT_BUFFER_SIZE = 0x800000;
+
+class ParallelExporter
+{
+public:
+  ParallelExporter(const Partition& partition, std::unique_ptr<Volume> first_volume,
+                   const std::function<std::unique_ptr<Volume>()>& create_volume)
+      : m_partition(partition), m_create_volume(create_volume)
+  {
+    m_max_in_flight = m_pool.GetThreadCount() * 2;
+    m_free_slots.push_back(Slot{std::move(first_volume)});
+  }
+
+  ~ParallelExporter() { m_task_group.Wait(); }
+
+  void Cancel() { m_cancelled = true; }
+
+  void ExportFile(const FileInfo& file_info, const std::string& export_path)
+  {
+    const u64 offset = file_info.GetOffset();
+    const u64 size = file_info.GetSize();
+
+    if (size <= EXPORT_RANGE_SIZE)
+    {
+      Submit(offset, size, export_path, 0, true);
+      return;
+    }
+
+    // Allocate the whole file up front so that the ranges can be written in any order
+    {
+      File::IOFile f(export_path, "wb");
+      if (!f || !f.Resize(size))
+      {
+        ERROR_LOG_FMT(DISCIO, "Could not export {}", export_path);
+        return;
+      }
+    }
+
+    for (u64 position = 0; position < size; position += EXPORT_RANGE_SIZE)
+    {
+      Submit(offset + position, std::min(EXPORT_RANGE_SIZE, size - position), export_path,
+             position, false);
+    }
+  }
+
+private:
+  struct Slot
+  {
+    std::unique_ptr<Volume> volume;
+    std::vector<u8> buffer;
+  };
+
+  void Submit(u64 offset, u64 size, const std::string& export_path, u64 position_in_file,
+              bool create_file)
+  {
+    // Keep the calling thread, which reports progress, from getting far ahead of the exports
+    {
+      std::unique_lock lk(m_mutex);
+      while (m_in_flight >= m_max_in_flight)
+      {
+        lk.unlock();
+        const bool ran_task = m_pool.RunPendingTask();
+        lk.lock();
+        if (!ran_task)
+          m_job_finished.wait_for(lk, std::chrono::milliseconds(1));
+      }
+      ++m_in_flight;
+    }
+
+    m_task_group.Submit(
+        [this, offset, size, export_path, position_in_file, create_file] {
+          if (!m_cancelled &&
+              !ExportRange(offset, size, export_path, position_in_file, create_file))
+          {
+            ERROR_LOG_FMT(DISCIO, "Could not export {}", export_path);
+          }
+
+          std::lock_guard lk(m_mutex);
+          --m_in_flight;
+          m_job_finished.notify_one();
+        },
+        Common::TaskPriority::Low);
+  }
+
+  bool ExportRange(u64 offset, u64 size, const std::string& export_path, u64 position_in_file,
+                   bool create_file)
+  {
+    std::optional<Slot> slot = AcquireSlot();
+    if (!slot)
+      return false;
+
+    File::IOFile f(export_path, create_file ? "wb" : "r+b");
+    bool success = f && f.Seek(position_in_file, File::SeekOrigin::Begin);
+
+    slot->buffer.resize(std::min(size, EXPORT_BUFFER_SIZE));
+    while (success && size > 0 && !m_cancelled)
+    {
+      const size_t read_size = static_cast<size_t>(std::min(size, EXPORT_BUFFER_SIZE));
+      success = slot->volume->Read(offset, read_size, slot->buffer.data(), m_partition) &&
+                f.WriteBytes(slot->buffer.data(), read_size);
+
+      size -= read_size;
+      offset += read_size;
+    }
+
+    ReleaseSlot(std::move(*slot));
+    return success;
+  }
+
+  std::optional<Slot> AcquireSlot()
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      if (!m_free_slots.empty())
+      {
+        Slot slot = std::move(m_free_slots.back());
+        m_free_slots.pop_back();
+        return slot;
+      }
+    }
+
+    std::unique_ptr<Volume> volume = m_create_volume();
+    if (!volume)
+      return std::nullopt;
+    return Slot{std::move(volume)};
+  }
+
+  void ReleaseSlot(Slot slot)
+  {
+    std::lock_guard lk(m_mutex);
+    m_free_slots.push_back(std::move(slot));
+  }
+
+  const Partition& m_partition;
+  const std::function<std::unique_ptr<Volume>()>& m_create_volume;
+
+  Common::ThreadPool& m_pool = Common::GetGlobalThreadPool();
+  Common::TaskGroup m_task_group{m_pool};
+  std::atomic<bool> m_cancelled = false;
+
+  std::mutex m_mutex;
+  std::condition_variable m_job_finished;
+  size_t m_in_flight = 0;
+  size_t m_max_in_flight;
+  std::vector<Slot> m_free_slots;
+};
+}  // namespace
+
+// Returns false if the export was cancelled
+static bool
+ExportDirectoryParallel(ParallelExporter* exporter, const FileInfo& directory, bool recursive,
+                        const std::string& filesystem_path, const std::string& export_folder,
+                        const std::function<bool(const std::string& path)>& update_progress)
+{
+  std::string export_root = export_folder + '/';
+  if (directory.IsDirectory() && !directory.IsRoot())
+    export_root += directory.GetName() + '/';
+
+  File::CreateFullPath(export_root);
+
+  for (const FileInfo& file_info : directory)
+  {
+    const std::string name = file_info.GetName() + (file_info.IsDirectory() ? "/" : "");
+    const std::string path = filesystem_path + name;
+    const std::string export_path = export_root + name;
+
+    if (update_progress(path))
+      return false;
+
+    DEBUG_LOG_FMT(DISCIO, "{}", export_path);
+
+    if (!file_info.IsDirectory())
+    {
+      if (File::Exists(export_path))
+        NOTICE_LOG_FMT(DISCIO, "{} already exists", export_path);
+      else
+        exporter->ExportFile(file_info, export_path);
+    }
+    else if (recursive)
+    {
+      if (!ExportDirectoryParallel(exporter, file_info, recursive, filesystem_path, export_root,
+                                   update_progress))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void ExportDirectoryParallel(const Volume& volume, const Partition& partition,
+                             const FileInfo& directory, bool recursive,
+                             const std::string& filesystem_path, const std::string& export_folder,
+                             const std::function<bool(const std::string& path)>& update_progress,
+                             const std::function<std::unique_ptr<Volume>()>& create_volume)
+{
+  std::unique_ptr<Volume> first_volume = create_volume();
+  if (!first_volume)
+  {
+    ExportDirectory(volume, partition, directory, recursive, filesystem_path, export_folder,
+                    update_progress);
+    return;
+  }
+
+  ParallelExporter exporter(partition, std::move(first_volume), create_volume);
+  if (!ExportDirectoryParallel(&exporter, directory, recursive, filesystem_path, export_folder,
+                               update_progress))
+  {
+    exporter.Cancel();
+  }
+}
+
 bool ExportWiiUnencryptedHeader(const Volume& volume, const std::string& export_filename)
 {
   if (volume.GetVolumeType() != Platform::WiiDisc)
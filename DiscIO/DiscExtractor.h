@@ -4,6 +4,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -35,6 +36,16 @@ void ExportDirectory(const Volume& volume, const Partition& partition, const Fil
                      const std::string& export_folder,
                      const std::function<bool(const std::string& path)>& update_progress);
 
+// Like ExportDirectory, but files are exported on the global thread pool, and big files are split
+// into ranges that are exported separately. Volumes aren't thread-safe, so each thread exporting
+// at once gets its own volume of the same disc from create_volume. update_progress is only called
+// on the calling thread, and this doesn't return until every started export has finished.
+void ExportDirectoryParallel(const Volume& volume, const Partition& partition,
+                             const FileInfo& directory, bool recursive,
+                             const std::string& filesystem_path, const std::string& export_folder,
+                             const std::function<bool(const std::string& path)>& update_progress,
+                             const std::function<std::unique_ptr<Volume>()>& create_volume);
+
 // To export everything listed below, you can use ExportSystemData
 
 bool ExportWiiUnencryptedHeader(const Volume& volume, const std::string& export_filename);
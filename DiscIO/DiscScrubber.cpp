@@ -4,6 +4,7 @@
 #include "DiscIO/DiscScrubber.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <memory>
 #include <optional>
@@ -13,6 +14,7 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Swap.h"
 #include "Common/Logging/Log.h"
 
 #include "DiscIO/DiscUtils.h"
@@ -32,13 +34,11 @@ bool DiscScrubber::SetupScrub(const Volume* disc)
 
   m_file_size = m_disc->GetSize();
 
-  // Round up when diving by CLUSTER_SIZE, otherwise MarkAsUsed might write out of bounds
-  const size_t num_clusters = static_cast<size_t>((m_file_size + CLUSTER_SIZE - 1) / CLUSTER_SIZE);
+  // Round up when diving by CLUSTER_SIZE, otherwise the last partial cluster would be left out
+  m_num_clusters = (m_file_size + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+  m_used_clusters.assign(static_cast<size_t>((m_num_clusters + 63) / 64), 0);
 
-  // Table of free blocks
-  m_free_table.resize(num_clusters, 1);
-
-  // Fill out table of free blocks
+  // Fill out table of used blocks
   const bool success = ParseDisc();
 
   m_is_scrubbing = success;
@@ -47,21 +47,35 @@ bool DiscScrubber::SetupScrub(const Volume* disc)
 
 bool DiscScrubber::CanBlockBeScrubbed(u64 offset) const
 {
-  return m_is_scrubbing && m_free_table[offset / CLUSTER_SIZE];
+  const u64 cluster = offset / CLUSTER_SIZE;
+  return m_is_scrubbing && cluster < m_num_clusters &&
+         (m_used_clusters[cluster / 64] & (u64{1} << (cluster % 64))) == 0;
 }
 
 void DiscScrubber::MarkAsUsed(u64 offset, u64 size)
 {
-  u64 current_offset = Common::AlignDown(offset, CLUSTER_SIZE);
   const u64 end_offset = offset + size;
 
   DEBUG_LOG_FMT(DISCIO, "Marking {:#018x} - {:#018x} as used", offset, end_offset);
 
-  while (current_offset < end_offset && current_offset < m_file_size)
+  u64 first = offset / CLUSTER_SIZE;
+  const u64 last = std::min((end_offset + CLUSTER_SIZE - 1) / CLUSTER_SIZE, m_num_clusters);
+  if (first >= last)
+    return;
+
+  // Whole words at a time, with masks for the partial words at either end
+  const auto mask_from = [](u64 bit) { return ~u64{0} << (bit % 64); };
+  const u64 last_word = (last - 1) / 64;
+  const u64 last_mask = ~u64{0} >> (63 - (last - 1) % 64);
+  if (first / 64 == last_word)
   {
-    m_free_table[current_offset / CLUSTER_SIZE] = 0;
-    current_offset += CLUSTER_SIZE;
+    m_used_clusters[last_word] |= mask_from(first) & last_mask;
+    return;
   }
+  m_used_clusters[first / 64] |= mask_from(first);
+  for (first = first / 64 + 1; first < last_word; ++first)
+    m_used_clusters[first] = ~u64{0};
+  m_used_clusters[last_word] |= last_mask;
 }
 
 void DiscScrubber::MarkAsUsedE(u64 partition_data_offset, u64 offset, u64 size)
@@ -98,62 +112,47 @@ u64 DiscScrubber::ToClusterOffset(u64 offset) const
     return Common::AlignDown(offset, CLUSTER_SIZE);
 }
 
-// Helper functions for reading the BE volume
-bool DiscScrubber::ReadFromVolume(u64 offset, u32& buffer, const Partition& partition)
-{
-  std::optional<u32> value = m_disc->ReadSwapped<u32>(offset, partition);
-  if (value)
-    buffer = *value;
-  return value.has_value();
-}
-
-bool DiscScrubber::ReadFromVolume(u64 offset, u64& buffer, const Partition& partition)
-{
-  std::optional<u64> value = m_disc->ReadSwappedAndShifted(offset, partition);
-  if (value)
-    buffer = *value;
-  return value.has_value();
-}
-
 bool DiscScrubber::ParseDisc()
 {
   if (m_disc->GetPartitions().empty())
-    return ParsePartitionData(PARTITION_NONE);
+    return ParsePartitionData(PARTITION_NONE, 0);
 
   // Mark the header as used - it's mostly 0s anyways
   MarkAsUsed(0, 0x50000);
 
   for (const DiscIO::Partition& partition : m_disc->GetPartitions())
   {
-    u32 tmd_size;
-    u64 tmd_offset;
-    u32 cert_chain_size;
-    u64 cert_chain_offset;
-    u64 h3_offset;
-    // The H3 size is always 0x18000
-
-    if (!ReadFromVolume(partition.offset + WII_PARTITION_TMD_SIZE_ADDRESS, tmd_size,
-                        PARTITION_NONE) ||
-        !ReadFromVolume(partition.offset + WII_PARTITION_TMD_OFFSET_ADDRESS, tmd_offset,
-                        PARTITION_NONE) ||
-        !ReadFromVolume(partition.offset + WII_PARTITION_CERT_CHAIN_SIZE_ADDRESS, cert_chain_size,
-                        PARTITION_NONE) ||
-        !ReadFromVolume(partition.offset + WII_PARTITION_CERT_CHAIN_OFFSET_ADDRESS,
-                        cert_chain_offset, PARTITION_NONE) ||
-        !ReadFromVolume(partition.offset + WII_PARTITION_H3_OFFSET_ADDRESS, h3_offset,
-                        PARTITION_NONE))
+    // Everything needed from the partition header comes after the ticket, read it all at once
+    constexpr u64 HEADER_START = WII_PARTITION_TMD_SIZE_ADDRESS;
+    constexpr u64 HEADER_END = 0x2c0;
+    std::array<u8, HEADER_END - HEADER_START> header;
+    if (!m_disc->Read(partition.offset + HEADER_START, header.size(), header.data(),
+                      PARTITION_NONE))
     {
       return false;
     }
+    const auto read_u32 = [&header](u64 address) {
+      return Common::swap32(&header[address - HEADER_START]);
+    };
+    // Offsets in partition headers are stored divided by 4
+    const auto read_offset = [&read_u32](u64 address) { return u64{read_u32(address)} << 2; };
+
+    const u32 tmd_size = read_u32(WII_PARTITION_TMD_SIZE_ADDRESS);
+    const u64 tmd_offset = read_offset(WII_PARTITION_TMD_OFFSET_ADDRESS);
+    const u32 cert_chain_size = read_u32(WII_PARTITION_CERT_CHAIN_SIZE_ADDRESS);
+    const u64 cert_chain_offset = read_offset(WII_PARTITION_CERT_CHAIN_OFFSET_ADDRESS);
+    const u64 h3_offset = read_offset(WII_PARTITION_H3_OFFSET_ADDRESS);
+    // The H3 size is always 0x18000
+    const u64 data_offset = read_offset(0x2b8);
 
-    MarkAsUsed(partition.offset, 0x2c0);
+    MarkAsUsed(partition.offset, HEADER_END);
 
     MarkAsUsed(partition.offset + tmd_offset, tmd_size);
     MarkAsUsed(partition.offset + cert_chain_offset, cert_chain_size);
     MarkAsUsed(partition.offset + h3_offset, WII_PARTITION_H3_SIZE);
 
     // Parse Data! This is where the big gain is
-    if (!ParsePartitionData(partition))
+    if (!ParsePartitionData(partition, partition.offset + data_offset))
       return false;
   }
 
@@ -161,7 +160,7 @@ bool DiscScrubber::ParseDisc()
 }
 
 // Operations dealing with encrypted space are done here
-bool DiscScrubber::ParsePartitionData(const Partition& partition)
+bool DiscScrubber::ParsePartitionData(const Partition& partition, u64 partition_data_offset)
 {
   const FileSystem* filesystem = m_disc->GetFileSystem(partition);
   if (!filesystem)
@@ -171,29 +170,13 @@ bool DiscScrubber::ParsePartitionData(const Partition& partition)
     return false;
   }
 
-  u64 partition_data_offset;
-  if (partition == PARTITION_NONE)
-  {
-    partition_data_offset = 0;
-  }
-  else
-  {
-    u64 data_offset;
-    if (!ReadFromVolume(partition.offset + 0x2b8, data_offset, PARTITION_NONE))
-      return false;
-
-    partition_data_offset = partition.offset + data_offset;
-  }
-
   // Mark things as used which are not in the filesystem
   // Header, Header Information, Apploader
-  u32 apploader_size;
-  u32 apploader_trailer_size;
-  if (!ReadFromVolume(0x2440 + 0x14, apploader_size, partition) ||
-      !ReadFromVolume(0x2440 + 0x18, apploader_trailer_size, partition))
-  {
+  std::array<u8, 8> apploader_sizes;
+  if (!m_disc->Read(0x2440 + 0x14, apploader_sizes.size(), apploader_sizes.data(), partition))
     return false;
-  }
+  const u32 apploader_size = Common::swap32(&apploader_sizes[0]);
+  const u32 apploader_trailer_size = Common::swap32(&apploader_sizes[4]);
   MarkAsUsedE(partition_data_offset, 0, 0x2440 + apploader_size + apploader_trailer_size);
 
   // DOL
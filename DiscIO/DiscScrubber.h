@@ -40,15 +40,15 @@ private:
   void MarkAsUsed(u64 offset, u64 size);
   void MarkAsUsedE(u64 partition_data_offset, u64 offset, u64 size);
   u64 ToClusterOffset(u64 offset) const;
-  bool ReadFromVolume(u64 offset, u32& buffer, const Partition& partition);
-  bool ReadFromVolume(u64 offset, u64& buffer, const Partition& partition);
   bool ParseDisc();
-  bool ParsePartitionData(const Partition& partition);
+  bool ParsePartitionData(const Partition& partition, u64 partition_data_offset);
   void ParseFileSystemData(u64 partition_data_offset, const FileInfo& directory);
 
   const Volume* m_disc = nullptr;
 
-  std::vector<u8> m_free_table;
+  // One bit per cluster, set for the clusters that are used
+  std::vector<u64> m_used_clusters;
+  u64 m_num_clusters = 0;
   u64 m_file_size = 0;
   bool m_is_scrubbing = false;
 };
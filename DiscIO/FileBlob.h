@@ -9,6 +9,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -16,7 +17,8 @@ namespace DiscIO
 class PlainFileReader : public BlobReader
 {
 public:
-  static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
+  // If possible, the file at path is mapped into memory, and file is only used as a fallback.
+  static std::unique_ptr<PlainFileReader> Create(File::IOFile file, const std::string& path);
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
 
@@ -30,12 +32,22 @@ public:
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  const u8* GetDataPointer(u64 offset, u64 size) override;
 
 private:
-  PlainFileReader(File::IOFile file);
+  PlainFileReader(File::IOFile file, const std::string& path);
+
+  // Hints to the OS how the mapped file is being accessed
+  void TrackAccess(u64 offset, u64 size);
 
   File::IOFile m_file;
+  File::MappedFile m_mapped_file;
   s64 m_size;
+
+  u64 m_last_access_end = 0;
+  u32 m_sequential_accesses = 0;
+  u64 m_prefetched_end = 0;
+  File::MappedFile::AccessPattern m_access_pattern = File::MappedFile::AccessPattern::Normal;
 };
 
 }  // namespace DiscIO
@@ -8,11 +8,56 @@
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Swap.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DiscIO
 {
+#ifdef _M_X86_64
+// Returns how many words were processed. The caller handles the rest.
+FUNCTION_TARGET_AVX2 static size_t XorWordsAVX2(u32* dst, const u32* src, size_t count)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, b));
+  }
+  return i;
+}
+#endif
+
+// dst[i] ^= src[i] for every i below count. The two ranges must not overlap.
+static void XorWords(u32* dst, const u32* src, size_t count)
+{
+  size_t i = 0;
+
+#if defined(_M_X86_64)
+  if (cpu_info.bAVX2)
+    i = XorWordsAVX2(dst, src, count);
+
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a, b));
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 4 <= count; i += 4)
+    vst1q_u32(dst + i, veorq_u32(vld1q_u32(dst + i), vld1q_u32(src + i)));
+#endif
+
+  for (; i < count; ++i)
+    dst[i] ^= src[i];
+}
+
 void LaggedFibonacciGenerator::SetSeed(const u32 seed[SEED_SIZE])
 {
   SetSeed(reinterpret_cast<const u8*>(seed));
@@ -51,12 +96,24 @@ size_t LaggedFibonacciGenerator::GetSeed(const u8* data, size_t size, size_t dat
 
   lfg.m_position_bytes = data_offset % (LFG_K * sizeof(u32));
 
-  const u8* end = data + size;
+  // Compare a whole buffer of generated data at a time, only looking at individual bytes once a
+  // difference has been found
   size_t reconstructed_bytes = 0;
-  while (data < end && lfg.GetByte() == *data)
+  while (reconstructed_bytes < size)
   {
-    ++reconstructed_bytes;
-    ++data;
+    const u8* generated = reinterpret_cast<const u8*>(lfg.m_buffer.data()) + lfg.m_position_bytes;
+    const size_t length =
+        std::min(size - reconstructed_bytes, LFG_K * sizeof(u32) - lfg.m_position_bytes);
+
+    const u8* actual = data + reconstructed_bytes;
+    if (std::memcmp(generated, actual, length) != 0)
+    {
+      const size_t matching = std::mismatch(actual, actual + length, generated).first - actual;
+      return reconstructed_bytes + matching;
+    }
+
+    reconstructed_bytes += length;
+    lfg.Forward(length);
   }
   return reconstructed_bytes;
 }
@@ -142,21 +199,31 @@ void LaggedFibonacciGenerator::Forward(size_t count)
 
 void LaggedFibonacciGenerator::Forward()
 {
-  for (size_t i = 0; i < LFG_J; ++i)
-    m_buffer[i] ^= m_buffer[i + LFG_K - LFG_J];
+  // Each word depends on the word LFG_J words before it, so runs of up to LFG_J words have no
+  // dependencies within them and can be processed with vector instructions
+  XorWords(m_buffer.data(), m_buffer.data() + LFG_K - LFG_J, LFG_J);
 
-  for (size_t i = LFG_J; i < LFG_K; ++i)
-    m_buffer[i] ^= m_buffer[i - LFG_J];
+  for (size_t i = LFG_J; i < LFG_K; i += LFG_J)
+    XorWords(m_buffer.data() + i, m_buffer.data() + i - LFG_J, std::min(LFG_J, LFG_K - i));
 }
 
 void LaggedFibonacciGenerator::Backward(size_t start_word, size_t end_word)
 {
+  // The same as Forward in reverse, so the runs have to be processed from the end
   const size_t loop_end = std::max(LFG_J, start_word);
-  for (size_t i = std::min(end_word, LFG_K); i > loop_end; --i)
-    m_buffer[i - 1] ^= m_buffer[i - 1 - LFG_J];
+  for (size_t i = std::min(end_word, LFG_K); i > loop_end;)
+  {
+    const size_t run_start = std::max(loop_end, i - LFG_J);
+    XorWords(m_buffer.data() + run_start, m_buffer.data() + run_start - LFG_J, i - run_start);
+    i = run_start;
+  }
 
-  for (size_t i = std::min(end_word, LFG_J); i > start_word; --i)
-    m_buffer[i - 1] ^= m_buffer[i - 1 + LFG_K - LFG_J];
+  const size_t run_end = std::min(end_word, LFG_J);
+  if (run_end > start_word)
+  {
+    XorWords(m_buffer.data() + start_word, m_buffer.data() + start_word + LFG_K - LFG_J,
+             run_end - start_word);
+  }
 }
 
 bool LaggedFibonacciGenerator::Reinitialize(u32 seed_out[SEED_SIZE])
@@ -4,16 +4,21 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <map>
 #include <memory>
-#include <thread>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/Assert.h"
-#include "Common/Event.h"
+#include "Common/CommonTypes.h"
 #include "Common/Result.h"
+#include "Common/ThreadPool.h"
 
 namespace DiscIO
 {
@@ -29,12 +34,16 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = Common::Result<ConversionResultCode, T>;
 
-// This class starts a number of compression threads and one output thread.
-// The set_up_compress_thread_state function is called at the start of each compression thread.
-// When CompressAndWrite is called, the compress function will be called on one of the
-// compression threads, and then the output function will be called on the output thread.
-// The output thread handles data in the order that data was submitted using CompressAndWrite,
-// but the compression threads are not guaranteed to handle data in a predictable order.
+// This class compresses data on the global thread pool (Common::GetGlobalThreadPool), which it
+// shares with any other conversions that are running at the same time.
+// When CompressAndWrite is called, the compress function will be called on one of the pool's
+// threads, and then the output function will be called with the result. The output function is
+// never called concurrently with itself, and it handles data in the order that data was
+// submitted using CompressAndWrite, but compression happens in no predictable order.
+// Each call of compress gets a CompressThreadState that no other call is using at the same time.
+// States are reused between calls, and set_up_compress_thread_state is called once per state.
+// CompressAndWrite and Shutdown run queued tasks of the pool while they wait, so they can be called
+// from one of its workers as well.
 // Remember to check GetStatus regularly and cancel if it doesn't return Success,
 // and call Shutdown when you want to ensure that everything finishes.
 template <typename CompressThreadState, typename CompressParameters, typename OutputParameters>
@@ -48,19 +57,8 @@ public:
       std::function<ConversionResultCode(OutputParameters)> output)
       : m_set_up_compress_thread_state(std::move(set_up_compress_thread_state)),
         m_compress(std::move(compress)), m_output(std::move(output)),
-        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
+        m_max_in_flight(2 * m_tasks_pool.GetThreadCount())
   {
-    m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
-
-    for (size_t i = 0; i < m_threads; ++i)
-    {
-      m_compress_threads[i].thread =
-          std::thread(std::mem_fn(&MultithreadedCompressor::CompressThreadFunction), this,
-                      &m_compress_threads[i]);
-    }
-
-    m_output_thread =
-        std::thread(std::mem_fn(&MultithreadedCompressor::OutputThreadFunction), this);
   }
 
   ~MultithreadedCompressor()
@@ -74,15 +72,32 @@ public:
     if (GetStatus() != ConversionResultCode::Success)
       return;
 
-    CompressThread& compress_thread = m_compress_threads[m_current_index];
-
-    compress_thread.compress_ready_event.Wait();
-    compress_thread.compress_parameters = std::move(parameters);
-    compress_thread.compress_event.Set();
+    u64 sequence;
+    {
+      // Limit how far reading can get ahead of writing, since every submission holds its data
+      const auto has_room = [this] { return m_submitted - m_next_output < m_max_in_flight; };
+      std::unique_lock lk(m_mutex);
+      while (!has_room())
+      {
+        // Run queued tasks instead of just blocking. Called from a worker of the pool, this keeps
+        // the tasks that make room from waiting on the very thread that waits for them.
+        lk.unlock();
+        const bool ran_task = m_tasks_pool.RunPendingTask();
+        lk.lock();
+
+        if (!ran_task)
+          m_output_done.wait_for(lk, std::chrono::milliseconds(1), has_room);
+      }
+      sequence = m_submitted++;
+    }
 
-    ++m_current_index;
-    if (m_current_index >= m_threads)
-      m_current_index -= m_threads;
+    // std::function needs a copyable callable, so the parameters are moved into a shared_ptr
+    auto shared_parameters = std::make_shared<CompressParameters>(std::move(parameters));
+    m_tasks.Submit(
+        [this, sequence, shared_parameters] {
+          Compress(sequence, std::move(*shared_parameters));
+        },
+        Common::TaskPriority::Low);
   }
 
   void SetError(ConversionResultCode result)
@@ -98,111 +113,99 @@ public:
 
   void Shutdown()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_ready_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_done_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Wait();
-
-    m_shutting_down.store(true);
-
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_event.Set();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_event.Set();
+    m_tasks.Wait();
 
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].thread.join();
+    // Every task has called WriteFinished by now, and the last one wrote everything
+    ASSERT(m_next_output == m_submitted);
 
-    m_output_thread.join();
+    m_shutting_down.store(true);
   }
 
 private:
-  struct CompressThread
-  {
-    std::thread thread;
-
-    Common::Event compress_ready_event;
-    Common::Event compress_event;
-    Common::Event compress_done_event;
-    Common::Event output_ready_event;
-    Common::Event output_event;
-
-    CompressParameters compress_parameters;
-    OutputParameters output_parameters;
-  };
-
-  void CompressThreadFunction(CompressThread* state)
+  std::unique_ptr<CompressThreadState> AcquireState()
   {
-    CompressThreadState compress_thread_state;
-
-    ConversionResultCode setup_result = m_set_up_compress_thread_state(&compress_thread_state);
-    if (setup_result != ConversionResultCode::Success)
-      SetError(setup_result);
-
-    state->compress_ready_event.Set();
-    state->compress_done_event.Set();
-
-    while (true)
     {
-      state->compress_event.Wait();
-
-      if (m_shutting_down.load())
-        return;
-
-      CompressParameters parameters = std::move(state->compress_parameters);
-
-      state->compress_done_event.Reset();
-      state->compress_ready_event.Set();
-
-      ConversionResult<OutputParameters> result =
-          m_compress(&compress_thread_state, std::move(parameters));
-
-      if (result)
+      std::lock_guard lk(m_states_mutex);
+      if (!m_free_states.empty())
       {
-        state->output_ready_event.Wait();
-        state->output_parameters = std::move(*result);
-        state->output_event.Set();
-      }
-      else
-      {
-        SetError(result.Error());
+        std::unique_ptr<CompressThreadState> state = std::move(m_free_states.back());
+        m_free_states.pop_back();
+        return state;
       }
+    }
 
-      state->compress_done_event.Set();
+    auto state = std::make_unique<CompressThreadState>();
+    const ConversionResultCode setup_result = m_set_up_compress_thread_state(state.get());
+    if (setup_result != ConversionResultCode::Success)
+    {
+      SetError(setup_result);
+      return nullptr;
     }
+    return state;
   }
 
-  void OutputThreadFunction()
+  void ReleaseState(std::unique_ptr<CompressThreadState> state)
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Set();
+    std::lock_guard lk(m_states_mutex);
+    m_free_states.push_back(std::move(state));
+  }
 
-    size_t index = 0;
+  void Compress(u64 sequence, CompressParameters parameters)
+  {
+    std::optional<OutputParameters> output;
 
-    while (true)
+    // Once something has failed, the remaining data only needs to be accounted for
+    if (GetStatus() == ConversionResultCode::Success)
     {
-      CompressThread& compress_thread = m_compress_threads[index];
+      if (std::unique_ptr<CompressThreadState> state = AcquireState())
+      {
+        ConversionResult<OutputParameters> result = m_compress(state.get(), std::move(parameters));
+        if (result)
+          output = std::move(*result);
+        else
+          SetError(result.Error());
 
-      compress_thread.output_event.Wait();
+        ReleaseState(std::move(state));
+      }
+    }
 
-      if (m_shutting_down.load())
-        return;
+    {
+      std::lock_guard lk(m_mutex);
+      m_finished.emplace(sequence, std::move(output));
+    }
 
-      OutputParameters parameters = std::move(compress_thread.output_parameters);
+    WriteFinished();
+  }
 
-      compress_thread.output_ready_event.Set();
+  // Writes finished data in submission order. Whichever task finds nobody else writing does the
+  // writing, including of data that other tasks finish in the meantime.
+  void WriteFinished()
+  {
+    std::unique_lock lk(m_mutex);
+    if (m_writing)
+      return;
+    m_writing = true;
 
-      const ConversionResultCode result = m_output(std::move(parameters));
+    for (auto it = m_finished.find(m_next_output); it != m_finished.end();
+         it = m_finished.find(m_next_output))
+    {
+      std::optional<OutputParameters> output = std::move(it->second);
+      m_finished.erase(it);
+      lk.unlock();
 
-      if (result != ConversionResultCode::Success)
-        SetError(result);
+      if (output)
+      {
+        const ConversionResultCode result = m_output(std::move(*output));
+        if (result != ConversionResultCode::Success)
+          SetError(result);
+      }
 
-      ++index;
-      if (index >= m_threads)
-        index -= m_threads;
+      lk.lock();
+      ++m_next_output;
+      m_output_done.notify_all();
     }
+
+    m_writing = false;
   }
 
   std::function<ConversionResultCode(CompressThreadState*)> m_set_up_compress_thread_state;
@@ -210,12 +213,19 @@ private:
       m_compress;
   std::function<ConversionResultCode(OutputParameters)> m_output;
 
-  // We can't use std::vector for this, because Common::Event is not movable
-  std::unique_ptr<CompressThread[]> m_compress_threads;
-  std::thread m_output_thread;
+  Common::ThreadPool& m_tasks_pool = Common::GetGlobalThreadPool();
+  Common::TaskGroup m_tasks{m_tasks_pool};
+  const u64 m_max_in_flight;
+
+  std::mutex m_states_mutex;
+  std::vector<std::unique_ptr<CompressThreadState>> m_free_states;
 
-  const size_t m_threads;
-  size_t m_current_index = 0;
+  std::mutex m_mutex;
+  std::condition_variable m_output_done;
+  std::map<u64, std::optional<OutputParameters>> m_finished;
+  u64 m_submitted = 0;
+  u64 m_next_output = 0;
+  bool m_writing = false;
 
   std::atomic<ConversionResultCode> m_result = ConversionResultCode::Success;
   std::atomic<bool> m_shutting_down = false;
@@ -5,18 +5,53 @@
 
 #include <algorithm>
 #include <cstring>
+#include <iterator>
+#include <thread>
 
+#include "Common/Align.h"
 #include "Common/Crypto/AES.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/ThreadPool.h"
 #include "Core/IOS/ES/Formats.h"
 
 namespace DiscIO
 {
 constexpr size_t NAND_SIZE = 0x20000000;
 constexpr size_t NAND_KEYS_SIZE = 0x400;
+constexpr size_t NAND_TOTAL_BLOCKS = 0x40000;
+constexpr size_t NAND_BLOCK_SIZE = 0x800;
+constexpr size_t NAND_ECC_BLOCK_SIZE = 0x40;
+constexpr size_t NAND_BIN_SIZE =
+    (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * NAND_TOTAL_BLOCKS;  // 0x21000000
+
+// Reads pages of the NAND image at an offset that doesn't count the ECC data. offset and size
+// must be multiples of the page size. All pages are read at once, and the ECC data after each of
+// them is left behind in buffer.
+static bool ReadNANDPages(File::IOFile& file, u64 offset, u8* out, size_t size,
+                          std::vector<u8>* buffer)
+{
+  if (offset + size > NAND_SIZE)
+    return false;
+
+  const size_t page_count = size / NAND_BLOCK_SIZE;
+  buffer->resize(page_count * (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE));
+  const u64 file_offset = offset / NAND_BLOCK_SIZE * (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE);
+  if (!file.Seek(file_offset, File::SeekOrigin::Begin) ||
+      !file.ReadBytes(buffer->data(), buffer->size()))
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < page_count; ++i)
+  {
+    std::memcpy(out + i * NAND_BLOCK_SIZE,
+                buffer->data() + i * (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE), NAND_BLOCK_SIZE);
+  }
+  return true;
+}
 
 NANDImporter::NANDImporter() : m_nand_root(File::GetUserPath(D_WIIROOT_IDX))
 {
@@ -28,6 +63,7 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
                                  std::function<std::string()> get_otp_dump_path)
 {
   m_update_callback = std::move(update_callback);
+  m_files.clear();
 
   if (!ReadNANDBin(path_to_bin, get_otp_dump_path))
     return;
@@ -36,18 +72,14 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
 
   ExportKeys();
   ProcessEntry(0, "");
+  ExtractFiles();
   ExtractCertificates();
 }
 
 bool NANDImporter::ReadNANDBin(const std::string& path_to_bin,
                                std::function<std::string()> get_otp_dump_path)
 {
-  constexpr size_t NAND_TOTAL_BLOCKS = 0x40000;
-  constexpr size_t NAND_BLOCK_SIZE = 0x800;
-  constexpr size_t NAND_ECC_BLOCK_SIZE = 0x40;
-  constexpr size_t NAND_BIN_SIZE =
-      (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * NAND_TOTAL_BLOCKS;  // 0x21000000
-
+  // The image itself is only read as its files are extracted
   File::IOFile file(path_to_bin, "rb");
   const u64 image_size = file.GetSize();
   if (image_size != NAND_BIN_SIZE + NAND_KEYS_SIZE && image_size != NAND_BIN_SIZE)
@@ -56,21 +88,7 @@ bool NANDImporter::ReadNANDBin(const std::string& path_to_bin,
     return false;
   }
 
-  m_nand.resize(NAND_SIZE);
-
-  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i++)
-  {
-    // Instead of updating on every cycle, we only update every 1000 cycles for a balance between
-    // not updating fast enough vs updating too fast
-    if (i % 1000 == 0)
-      m_update_callback();
-
-    file.ReadBytes(&m_nand[i * NAND_BLOCK_SIZE], NAND_BLOCK_SIZE);
-
-    // We don't care about the ECC blocks
-    file.Seek(NAND_ECC_BLOCK_SIZE, File::SeekOrigin::Current);
-  }
-
+  m_path_to_bin = path_to_bin;
   m_nand_keys.resize(NAND_KEYS_SIZE);
 
   // Read the OTP/SEEPROM dump.
@@ -85,19 +103,27 @@ bool NANDImporter::ReadNANDBin(const std::string& path_to_bin,
   }
 
   // Otherwise, just read the key data from the NAND image.
-  return file.ReadBytes(m_nand_keys.data(), NAND_KEYS_SIZE);
+  return file.Seek(NAND_BIN_SIZE, File::SeekOrigin::Begin) &&
+         file.ReadBytes(m_nand_keys.data(), NAND_KEYS_SIZE);
 }
 
 bool NANDImporter::FindSuperblock()
 {
   constexpr size_t NAND_SUPERBLOCK_START = 0x1fc00000;
 
+  File::IOFile file(m_path_to_bin, "rb");
+  std::vector<u8> buffer;
+
   // There are 16 superblocks, choose the highest/newest version
   for (int i = 0; i < 16; i++)
   {
     auto superblock = std::make_unique<NANDSuperblock>();
-    std::memcpy(superblock.get(), &m_nand[NAND_SUPERBLOCK_START + i * sizeof(NANDSuperblock)],
-                sizeof(NANDSuperblock));
+    if (!ReadNANDPages(file, NAND_SUPERBLOCK_START + i * sizeof(NANDSuperblock),
+                       reinterpret_cast<u8*>(superblock.get()), sizeof(NANDSuperblock), &buffer))
+    {
+      ERROR_LOG_FMT(DISCIO, "Superblock #{} could not be read", i);
+      continue;
+    }
 
     if (std::memcmp(superblock->magic, "SFFS", 4) != 0)
     {
@@ -135,6 +161,13 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
 {
   while (entry_number != 0xffff)
   {
+    if (entry_number >= std::size(m_superblock->fst))
+    {
+      ERROR_LOG_FMT(DISCIO, "Ignoring out of range FST entry {:#x} in {}", entry_number,
+                    parent_path);
+      return;
+    }
+
     const NANDFSTEntry entry = m_superblock->fst[entry_number];
 
     const std::string path = GetPath(entry, parent_path);
@@ -144,9 +177,7 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
     Type type = static_cast<Type>(entry.mode & 3);
     if (type == Type::File)
     {
-      std::vector<u8> data = GetEntryData(entry);
-      File::IOFile file(m_nand_root + path, "wb");
-      file.WriteBytes(data.data(), data.size());
+      m_files.push_back({entry, path});
     }
     else if (type == Type::Directory)
     {
@@ -162,29 +193,59 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
   }
 }
 
-std::vector<u8> NANDImporter::GetEntryData(const NANDFSTEntry& entry)
+void NANDImporter::ExtractFiles()
+{
+  // Every file is read, decrypted and written on its own, so several of them are extracted at
+  // once, each with a handle of its own on the image. Only the calling thread reports progress.
+  const std::thread::id caller = std::this_thread::get_id();
+  Common::ParallelFor(m_files.size(), [&](size_t i) {
+    const FileToExtract& file = m_files[i];
+    File::IOFile nand(m_path_to_bin, "rb");
+    std::vector<u8> data;
+    std::vector<u8> buffer;
+    if (!GetEntryData(nand, file.entry, &data, &buffer))
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to read the data of {}", file.path);
+    }
+    else
+    {
+      File::IOFile out(m_nand_root + file.path, "wb");
+      if (!out.WriteBytes(data.data(), data.size()))
+        ERROR_LOG_FMT(DISCIO, "Failed to write {}", file.path);
+    }
+
+    if (std::this_thread::get_id() == caller)
+      m_update_callback();
+  });
+}
+
+bool NANDImporter::GetEntryData(File::IOFile& file, const NANDFSTEntry& entry,
+                                std::vector<u8>* data, std::vector<u8>* buffer) const
 {
   constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
 
-  u16 sub = entry.sub;
-  size_t remaining_bytes = entry.size;
-  std::vector<u8> data{};
-  data.reserve(remaining_bytes);
+  // Clusters are decrypted in place, so the last one is read whole and cut off afterwards
+  const size_t size = entry.size;
+  data->resize(Common::AlignUp(size, NAND_FAT_BLOCK_SIZE));
 
-  while (remaining_bytes > 0)
+  u16 sub = entry.sub;
+  for (size_t offset = 0; offset < size; offset += NAND_FAT_BLOCK_SIZE)
   {
-    std::array<u8, 16> iv{};
-    std::vector<u8> block = Common::AES::Decrypt(
-        m_aes_key.data(), iv.data(), &m_nand[NAND_FAT_BLOCK_SIZE * sub], NAND_FAT_BLOCK_SIZE);
+    if (sub >= std::size(m_superblock->fat))
+      return false;
 
-    size_t size = std::min(remaining_bytes, block.size());
-    data.insert(data.end(), block.begin(), block.begin() + size);
-    remaining_bytes -= size;
+    u8* cluster = data->data() + offset;
+    if (!ReadNANDPages(file, NAND_FAT_BLOCK_SIZE * sub, cluster, NAND_FAT_BLOCK_SIZE, buffer))
+      return false;
+
+    std::array<u8, 16> iv{};
+    Common::AES::DecryptCBC(m_aes_key.data(), iv.data(), cluster, cluster, NAND_FAT_BLOCK_SIZE);
 
     sub = m_superblock->fat[sub];
   }
 
-  return data;
+  data->resize(size);
+  return true;
 }
 
 bool NANDImporter::ExtractCertificates()
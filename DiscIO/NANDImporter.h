@@ -14,6 +14,11 @@
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
 
+namespace File
+{
+class IOFile;
+}
+
 namespace DiscIO
 {
 class NANDImporter final
@@ -63,19 +68,29 @@ public:
 #pragma pack(pop)
 
 private:
+  struct FileToExtract
+  {
+    NANDFSTEntry entry;
+    std::string path;
+  };
+
   bool ReadNANDBin(const std::string& path_to_bin, std::function<std::string()> get_otp_dump_path);
   bool FindSuperblock();
   std::string GetPath(const NANDFSTEntry& entry, const std::string& parent_path);
   std::string FormatDebugString(const NANDFSTEntry& entry);
   void ProcessEntry(u16 entry_number, const std::string& parent_path);
-  std::vector<u8> GetEntryData(const NANDFSTEntry& entry);
+  void ExtractFiles();
+  bool GetEntryData(File::IOFile& file, const NANDFSTEntry& entry, std::vector<u8>* data,
+                    std::vector<u8>* buffer) const;
   void ExportKeys();
 
   std::string m_nand_root;
-  std::vector<u8> m_nand;
+  std::string m_path_to_bin;
   std::vector<u8> m_nand_keys;
   std::array<u8, 16> m_aes_key;
   std::unique_ptr<NANDSuperblock> m_superblock;
+  // Directories are created while walking the FST, and the files are extracted afterwards
+  std::vector<FileToExtract> m_files;
   std::function<void()> m_update_callback;
 };
 }  // namespace DiscIO
@@ -0,0 +1,232 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/PrefetchBlob.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+// Units smaller than this would make the prefetch thread wake up for almost every read.
+constexpr u64 MIN_UNIT_SIZE = 0x40000;
+// How much data is read ahead of the latest sequential read.
+constexpr u64 PREFETCH_SIZE = 0x800000;
+// How many reads in a row must continue the previous one before prefetching starts.
+constexpr u32 SEQUENTIAL_READS_BEFORE_PREFETCH = 2;
+// Raw reads and reads of each Wii partition are tracked separately.
+constexpr size_t MAX_STREAMS = 4;
+
+PrefetchBlobReader::PrefetchBlobReader(std::unique_ptr<BlobReader> blob_reader)
+    : m_blob_reader(std::move(blob_reader))
+{
+  const u64 block_size = m_blob_reader->GetBlockSize();
+  m_unit_size = Common::AlignUp(std::max(block_size, MIN_UNIT_SIZE), block_size);
+  m_units_ahead = static_cast<u32>(std::max<u64>(PREFETCH_SIZE / m_unit_size, 2));
+
+  m_thread = std::thread(&PrefetchBlobReader::ThreadLoop, this);
+}
+
+PrefetchBlobReader::~PrefetchBlobReader()
+{
+  {
+    std::lock_guard lk(m_cache_mutex);
+    m_exiting = true;
+  }
+  m_work_available.notify_one();
+  m_thread.join();
+}
+
+std::unique_ptr<BlobReader> PrefetchBlobReader::Create(std::unique_ptr<BlobReader> blob_reader)
+{
+  if (!blob_reader || blob_reader->GetBlockSize() == 0)
+    return blob_reader;
+
+  return std::unique_ptr<PrefetchBlobReader>(new PrefetchBlobReader(std::move(blob_reader)));
+}
+
+bool PrefetchBlobReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  return ReadStream(RAW_STREAM, offset, size, out_ptr);
+}
+
+bool PrefetchBlobReader::SupportsReadWiiDecrypted(u64 offset, u64 size,
+                                                  u64 partition_data_offset) const
+{
+  std::lock_guard lk(m_reader_mutex);
+  return m_blob_reader->SupportsReadWiiDecrypted(offset, size, partition_data_offset);
+}
+
+bool PrefetchBlobReader::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
+                                          u64 partition_data_offset)
+{
+  return ReadStream(partition_data_offset, offset, size, out_ptr);
+}
+
+bool PrefetchBlobReader::ReadStream(u64 stream, u64 offset, u64 size, u8* out_ptr)
+{
+  std::unique_lock lk(m_cache_mutex);
+  UpdateReadAhead(stream, offset, offset + size);
+
+  while (size > 0)
+  {
+    const u64 unit_offset = Common::AlignDown(offset, m_unit_size);
+    const u64 offset_in_unit = offset - unit_offset;
+    const u64 bytes_to_read = std::min(m_unit_size - offset_in_unit, size);
+
+    // Entries are loaded in the order they were queued, so waiting for one can't take longer
+    // than the prefetch thread needs to catch up with this read.
+    Entry* entry = FindEntry(stream, unit_offset);
+    while (entry && (entry->state == EntryState::Queued || entry->state == EntryState::Loading))
+    {
+      m_entry_finished.wait(lk);
+      entry = FindEntry(stream, unit_offset);
+    }
+
+    if (entry && entry->state == EntryState::Ready &&
+        entry->data.size() >= offset_in_unit + bytes_to_read)
+    {
+      std::memcpy(out_ptr, entry->data.data() + offset_in_unit, bytes_to_read);
+    }
+    else
+    {
+      lk.unlock();
+      const bool success = ReadDirect(stream, offset, bytes_to_read, out_ptr);
+      lk.lock();
+      if (!success)
+        return false;
+    }
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+  }
+
+  return true;
+}
+
+bool PrefetchBlobReader::ReadDirect(u64 stream, u64 offset, u64 size, u8* out_ptr)
+{
+  std::lock_guard lk(m_reader_mutex);
+  if (stream == RAW_STREAM)
+    return m_blob_reader->Read(offset, size, out_ptr);
+  return m_blob_reader->SupportsReadWiiDecrypted(offset, size, stream) &&
+         m_blob_reader->ReadWiiDecrypted(offset, size, out_ptr, stream);
+}
+
+void PrefetchBlobReader::UpdateReadAhead(u64 stream, u64 offset, u64 end)
+{
+  auto it = std::find_if(m_streams.begin(), m_streams.end(),
+                         [stream](const Stream& s) { return s.stream == stream; });
+  if (it == m_streams.end())
+  {
+    if (m_streams.size() == MAX_STREAMS)
+      m_streams.erase(m_streams.begin());
+    it = m_streams.insert(m_streams.end(), Stream{stream});
+  }
+
+  // Rereading part of the previous read, as happens when a game reads a file header and then
+  // the whole file, doesn't break the sequence.
+  if (offset >= it->last_read_offset && offset <= it->last_read_end)
+    ++it->sequential_reads;
+  else
+    it->sequential_reads = 0;
+  it->last_read_offset = offset;
+  it->last_read_end = std::max(end, it->last_read_end);
+
+  if (it->sequential_reads < SEQUENTIAL_READS_BEFORE_PREFETCH)
+    return;
+
+  const u64 data_size = m_blob_reader->GetDataSize();
+  bool queued = false;
+  u64 unit_offset = Common::AlignDown(it->last_read_end, m_unit_size);
+  for (u32 i = 0; i < m_units_ahead; ++i, unit_offset += m_unit_size)
+  {
+    if (stream == RAW_STREAM && unit_offset >= data_size)
+      break;
+    if (FindEntry(stream, unit_offset))
+      continue;
+    if (!MakeRoomForEntry())
+      break;
+
+    m_cache.push_back(Entry{stream, unit_offset});
+    queued = true;
+  }
+
+  if (queued)
+    m_work_available.notify_one();
+}
+
+PrefetchBlobReader::Entry* PrefetchBlobReader::FindEntry(u64 stream, u64 offset)
+{
+  auto it = std::find_if(m_cache.begin(), m_cache.end(), [stream, offset](const Entry& entry) {
+    return entry.stream == stream && entry.offset == offset;
+  });
+  return it != m_cache.end() ? &*it : nullptr;
+}
+
+bool PrefetchBlobReader::MakeRoomForEntry()
+{
+  // Keep the units just behind the reads around too, in case they get reread
+  const size_t capacity = size_t(m_units_ahead) * 2;
+  if (m_cache.size() < capacity)
+    return true;
+
+  // Only finished entries can be evicted, since the prefetch thread may be filling the others
+  auto it = std::find_if(m_cache.begin(), m_cache.end(), [](const Entry& entry) {
+    return entry.state == EntryState::Ready || entry.state == EntryState::Failed;
+  });
+  if (it == m_cache.end())
+    return false;
+
+  m_cache.erase(it);
+  return true;
+}
+
+void PrefetchBlobReader::ThreadLoop()
+{
+  Common::SetCurrentThreadName("Blob prefetch thread");
+
+  std::unique_lock lk(m_cache_mutex);
+  while (true)
+  {
+    auto it = m_cache.end();
+    m_work_available.wait(lk, [&] {
+      it = std::find_if(m_cache.begin(), m_cache.end(),
+                        [](const Entry& entry) { return entry.state == EntryState::Queued; });
+      return m_exiting || it != m_cache.end();
+    });
+    if (m_exiting)
+      return;
+
+    it->state = EntryState::Loading;
+    const u64 stream = it->stream;
+    const u64 offset = it->offset;
+    lk.unlock();
+
+    u64 size = m_unit_size;
+    if (stream == RAW_STREAM)
+      size = std::min(size, m_blob_reader->GetDataSize() - offset);
+    std::vector<u8> data(size);
+    const bool success = ReadDirect(stream, offset, size, data.data());
+
+    lk.lock();
+    // Loading entries are never evicted, so the entry is still there
+    Entry* entry = FindEntry(stream, offset);
+    entry->state = success ? EntryState::Ready : EntryState::Failed;
+    if (success)
+      entry->data = std::move(data);
+    m_entry_finished.notify_all();
+  }
+}
+
+}  // namespace DiscIO
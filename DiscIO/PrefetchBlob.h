@@ -0,0 +1,114 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+// This class wraps a compressed or WBFS BlobReader. Once a few reads in a row have continued
+// where the previous one ended, the data after them is read (and therefore decompressed) ahead of
+// time on a separate thread, so that the next reads can be served from memory.
+// Reads of decrypted Wii partition data are tracked separately from raw reads.
+class PrefetchBlobReader final : public BlobReader
+{
+public:
+  // Returns blob_reader itself if it doesn't use blocks.
+  static std::unique_ptr<BlobReader> Create(std::unique_ptr<BlobReader> blob_reader);
+
+  ~PrefetchBlobReader();
+
+  BlobType GetBlobType() const override { return m_blob_reader->GetBlobType(); }
+
+  u64 GetRawSize() const override { return m_blob_reader->GetRawSize(); }
+  u64 GetDataSize() const override { return m_blob_reader->GetDataSize(); }
+  bool IsDataSizeAccurate() const override { return m_blob_reader->IsDataSizeAccurate(); }
+
+  u64 GetBlockSize() const override { return m_blob_reader->GetBlockSize(); }
+  bool HasFastRandomAccessInBlock() const override
+  {
+    return m_blob_reader->HasFastRandomAccessInBlock();
+  }
+  std::string GetCompressionMethod() const override
+  {
+    return m_blob_reader->GetCompressionMethod();
+  }
+  std::optional<int> GetCompressionLevel() const override
+  {
+    return m_blob_reader->GetCompressionLevel();
+  }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+  bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override;
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
+
+private:
+  enum class EntryState
+  {
+    Queued,
+    Loading,
+    Ready,
+    Failed,
+  };
+
+  // One unit of prefetched data. stream is RAW_STREAM for raw reads, and the partition data
+  // offset for decrypted reads.
+  struct Entry
+  {
+    u64 stream;
+    u64 offset;
+    EntryState state = EntryState::Queued;
+    std::vector<u8> data;
+  };
+
+  struct Stream
+  {
+    u64 stream;
+    u64 last_read_offset = 0;
+    u64 last_read_end = 0;
+    u32 sequential_reads = 0;
+  };
+
+  explicit PrefetchBlobReader(std::unique_ptr<BlobReader> blob_reader);
+
+  bool ReadStream(u64 stream, u64 offset, u64 size, u8* out_ptr);
+  bool ReadDirect(u64 stream, u64 offset, u64 size, u8* out_ptr);
+
+  // These must be called with m_cache_mutex held.
+  void UpdateReadAhead(u64 stream, u64 offset, u64 end);
+  Entry* FindEntry(u64 stream, u64 offset);
+  bool MakeRoomForEntry();
+
+  void ThreadLoop();
+
+  static constexpr u64 RAW_STREAM = ~u64(0);
+
+  std::unique_ptr<BlobReader> m_blob_reader;
+  u64 m_unit_size;
+  u32 m_units_ahead;
+
+  // BlobReaders aren't thread-safe, so every access to m_blob_reader goes through this.
+  mutable std::mutex m_reader_mutex;
+
+  std::mutex m_cache_mutex;
+  std::condition_variable m_entry_finished;
+  std::condition_variable m_work_available;
+  std::deque<Entry> m_cache;
+  std::vector<Stream> m_streams;
+  bool m_exiting = false;
+
+  std::thread m_thread;
+};
+
+}  // namespace DiscIO
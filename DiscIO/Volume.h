@@ -56,6 +56,12 @@ public:
       return std::nullopt;
     return Common::FromBigEndian(temp);
   }
+  // Returns a pointer to the data if it can be accessed without copying it, or nullptr.
+  // The pointer stays valid for as long as the volume exists.
+  virtual const u8* GetDataPointer(u64 offset, u64 length, const Partition& partition) const
+  {
+    return nullptr;
+  }
   std::optional<u64> ReadSwappedAndShifted(u64 offset, const Partition& partition) const
   {
     const std::optional<u32> temp = ReadSwapped<u32>(offset, partition);
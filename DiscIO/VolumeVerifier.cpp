@@ -4,12 +4,16 @@
 #include "DiscIO/VolumeVerifier.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <future>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
@@ -21,6 +25,7 @@
 #include "Common/Assert.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/HttpRequest.h"
@@ -31,6 +36,8 @@
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "Common/Version.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/ES/ES.h"
@@ -372,6 +379,7 @@ VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
 VolumeVerifier::~VolumeVerifier()
 {
   WaitForAsyncOperations();
+  StopHashThreads();
 }
 
 void VolumeVerifier::Start()
@@ -1041,42 +1049,132 @@ void VolumeVerifier::SetUpHashing()
             [](const GroupToVerify& a, const GroupToVerify& b) { return a.offset < b.offset; });
 
   if (m_hashes_to_calculate.crc32)
+  {
     m_crc32_context = Common::StartCRC32();
+    m_hash_threads.emplace_back(&VolumeVerifier::HashThread, this,
+                                [this](const u8* data, size_t size) {
+                                  m_crc32_context = Common::UpdateCRC32(m_crc32_context, data,
+                                                                        static_cast<u32>(size));
+                                });
+  }
 
   if (m_hashes_to_calculate.md5)
   {
     mbedtls_md5_init(&m_md5_context);
     mbedtls_md5_starts_ret(&m_md5_context);
+    m_hash_threads.emplace_back(&VolumeVerifier::HashThread, this,
+                                [this](const u8* data, size_t size) {
+                                  mbedtls_md5_update_ret(&m_md5_context, data, size);
+                                });
   }
 
   if (m_hashes_to_calculate.sha1)
   {
     mbedtls_sha1_init(&m_sha1_context);
     mbedtls_sha1_starts_ret(&m_sha1_context);
+    m_hash_threads.emplace_back(&VolumeVerifier::HashThread, this,
+                                [this](const u8* data, size_t size) {
+                                  mbedtls_sha1_update_ret(&m_sha1_context, data, size);
+                                });
+  }
+}
+
+void VolumeVerifier::HashThread(const std::function<void(const u8* data, size_t size)>& update)
+{
+  Common::SetCurrentThreadName("Verifier hash thread");
+
+  // Every hash thread goes through every published buffer, in order
+  u64 next_buffer = 0;
+
+  std::unique_lock lk(m_ring_mutex);
+  while (true)
+  {
+    m_ring_changed.wait(lk, [&] {
+      return m_stop_hash_threads || next_buffer < m_buffers_published;
+    });
+    if (next_buffer == m_buffers_published)
+      return;
+
+    RingBuffer& buffer = m_ring[next_buffer % RING_SIZE];
+    lk.unlock();
+    if (buffer.bytes_to_hash > 0)
+      update(buffer.data.data(), buffer.bytes_to_hash);
+    lk.lock();
+
+    --buffer.users;
+    ++next_buffer;
+    m_ring_changed.notify_all();
+  }
+}
+
+void VolumeVerifier::StopHashThreads()
+{
+  {
+    std::lock_guard lk(m_ring_mutex);
+    m_stop_hash_threads = true;
   }
+  m_ring_changed.notify_all();
+
+  for (std::thread& thread : m_hash_threads)
+    thread.join();
+  m_hash_threads.clear();
 }
 
-void VolumeVerifier::WaitForAsyncOperations() const
+void VolumeVerifier::WaitForAsyncOperations()
 {
-  if (m_crc32_future.valid())
-    m_crc32_future.wait();
-  if (m_md5_future.valid())
-    m_md5_future.wait();
-  if (m_sha1_future.valid())
-    m_sha1_future.wait();
   if (m_content_future.valid())
     m_content_future.wait();
   if (m_group_future.valid())
     m_group_future.wait();
+
+  std::unique_lock lk(m_ring_mutex);
+  m_ring_changed.wait(lk, [this] {
+    return std::all_of(m_ring.begin(), m_ring.end(),
+                       [](const RingBuffer& buffer) { return buffer.users == 0; });
+  });
+}
+
+VolumeVerifier::RingBuffer& VolumeVerifier::AcquireBuffer()
+{
+  RingBuffer& buffer = m_ring[m_buffers_published % RING_SIZE];
+
+  std::unique_lock lk(m_ring_mutex);
+  m_ring_changed.wait(lk, [&buffer] { return buffer.users == 0; });
+  return buffer;
 }
 
-bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
+void VolumeVerifier::PublishBuffer(RingBuffer* buffer, u32 users)
 {
-  std::vector<u8> data(bytes_to_read);
+  {
+    std::lock_guard lk(m_ring_mutex);
+    buffer->users = users + static_cast<u32>(m_hash_threads.size());
+    ++m_buffers_published;
+  }
+  m_ring_changed.notify_all();
+
+  m_last_buffer = buffer;
+}
+
+void VolumeVerifier::ReleaseBuffer(RingBuffer* buffer)
+{
+  {
+    std::lock_guard lk(m_ring_mutex);
+    --buffer->users;
+  }
+  m_ring_changed.notify_all();
+}
+
+bool VolumeVerifier::ReadChunk(u64 bytes_to_read, RingBuffer* buffer)
+{
+  std::vector<u8>& data = buffer->data;
+  data.resize(bytes_to_read);
 
   const u64 bytes_to_copy = std::min(m_excess_bytes, bytes_to_read);
   if (bytes_to_copy > 0)
-    std::memcpy(data.data(), m_data.data() + m_data.size() - m_excess_bytes, bytes_to_copy);
+  {
+    const std::vector<u8>& last_data = m_last_buffer->data;
+    std::memcpy(data.data(), last_data.data() + last_data.size() - m_excess_bytes, bytes_to_copy);
+  }
   bytes_to_read -= bytes_to_copy;
 
   if (bytes_to_read > 0)
@@ -1088,8 +1186,6 @@ bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
     }
   }
 
-  WaitForAsyncOperations();
-  m_data = std::move(data);
   return true;
 }
 
@@ -1154,7 +1250,8 @@ void VolumeVerifier::Process()
   }
 
   const bool is_data_needed = m_calculating_any_hash || content_read || group_read;
-  const bool read_succeeded = is_data_needed && ReadChunkAndWaitForAsyncOperations(bytes_to_read);
+  RingBuffer* buffer = is_data_needed ? &AcquireBuffer() : nullptr;
+  const bool read_succeeded = is_data_needed && ReadChunk(bytes_to_read, buffer);
 
   if (!read_succeeded)
   {
@@ -1167,38 +1264,28 @@ void VolumeVerifier::Process()
   m_excess_bytes = excess_bytes;
   const u64 byte_increment = bytes_to_read - excess_bytes;
 
-  if (m_calculating_any_hash)
+  if (buffer)
   {
-    if (m_hashes_to_calculate.crc32)
-    {
-      m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        m_crc32_context =
-            Common::UpdateCRC32(m_crc32_context, m_data.data(), static_cast<u32>(byte_increment));
-      });
-    }
+    // The hash threads skip buffers with nothing to hash, but they still have to release them
+    buffer->bytes_to_hash = m_calculating_any_hash ? byte_increment : 0;
 
-    if (m_hashes_to_calculate.md5)
-    {
-      m_md5_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
-      });
-    }
+    // The integrity checks don't run concurrently with earlier checks of the same kind
+    if (content_read && m_content_future.valid())
+      m_content_future.wait();
+    if (group_read && m_group_future.valid())
+      m_group_future.wait();
 
-    if (m_hashes_to_calculate.sha1)
-    {
-      m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_sha1_update_ret(&m_sha1_context, m_data.data(), byte_increment);
-      });
-    }
+    PublishBuffer(buffer, u32(content_read) + u32(group_read));
   }
 
   if (content_read)
   {
-    m_content_future = std::async(std::launch::async, [this, read_succeeded, content] {
-      if (!read_succeeded || !m_volume.CheckContentIntegrity(content, m_data, m_ticket))
+    m_content_future = std::async(std::launch::async, [this, read_succeeded, content, buffer] {
+      if (!read_succeeded || !m_volume.CheckContentIntegrity(content, buffer->data, m_ticket))
       {
         AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
       }
+      ReleaseBuffer(buffer);
     });
 
     m_content_index++;
@@ -1206,7 +1293,7 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_succeeded,
+    m_group_future = std::async(std::launch::async, [this, read_succeeded, buffer,
                                                      group_index = m_group_index] {
       const GroupToVerify& group = m_groups[group_index];
       u64 offset_in_group = 0;
@@ -1215,8 +1302,9 @@ void VolumeVerifier::Process()
       {
         const u64 block_offset = group.offset + offset_in_group;
 
-        if (read_succeeded && m_volume.CheckBlockIntegrity(
-                                  block_index, m_data.data() + offset_in_group, group.partition))
+        if (read_succeeded &&
+            m_volume.CheckBlockIntegrity(block_index, buffer->data.data() + offset_in_group,
+                                         group.partition))
         {
           m_biggest_verified_offset =
               std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
@@ -1235,6 +1323,7 @@ void VolumeVerifier::Process()
           }
         }
       }
+      ReleaseBuffer(buffer);
     });
 
     m_group_index++;
@@ -1260,6 +1349,7 @@ void VolumeVerifier::Finish()
   m_done = true;
 
   WaitForAsyncOperations();
+  StopHashThreads();
 
   if (m_calculating_any_hash)
   {
@@ -1420,4 +1510,53 @@ void VolumeVerifier::AddProblem(Severity severity, std::string text)
   m_result.problems.emplace_back(Problem{severity, std::move(text)});
 }
 
+std::vector<BatchVerificationResult>
+VerifyDirectory(const std::string& directory, bool recursive, bool redump_verification,
+                Hashes<bool> hashes_to_calculate, u32 thread_budget,
+                const BatchVerificationCallback& callback)
+{
+  const std::vector<std::string> paths = Common::DoFileSearch(
+      {directory}, {".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia", ".rvz", ".wad"},
+      recursive);
+  std::vector<BatchVerificationResult> results(paths.size());
+  if (paths.empty())
+    return results;
+
+  if (thread_budget == 0)
+    thread_budget = std::max(std::thread::hardware_concurrency(), 1u);
+
+  // Each verifier keeps one thread busy calling Process, plus one thread per hash
+  const u32 threads_per_verifier = 1 + u32(hashes_to_calculate.crc32) +
+                                   u32(hashes_to_calculate.md5) + u32(hashes_to_calculate.sha1);
+  const size_t verifier_count =
+      std::clamp<size_t>(thread_budget / threads_per_verifier, 1, paths.size());
+
+  std::mutex callback_mutex;
+  Common::ParallelFor(
+      paths.size(),
+      [&](size_t i) {
+        BatchVerificationResult& result = results[i];
+        result.path = paths[i];
+
+        if (const std::unique_ptr<Volume> volume = CreateVolume(paths[i]))
+        {
+          VolumeVerifier verifier(*volume, redump_verification, hashes_to_calculate);
+          verifier.Start();
+          while (verifier.GetBytesProcessed() != verifier.GetTotalBytes())
+            verifier.Process();
+          verifier.Finish();
+          result.result = verifier.GetResult();
+        }
+
+        if (callback)
+        {
+          std::lock_guard lk(callback_mutex);
+          callback(result);
+        }
+      },
+      verifier_count);
+
+  return results;
+}
+
 }  // namespace DiscIO
@@ -3,10 +3,15 @@
 
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <functional>
 #include <future>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <mbedtls/md5.h>
@@ -154,8 +159,23 @@ private:
   void CheckMisc();
   void CheckSuperPaperMario();
   void SetUpHashing();
-  void WaitForAsyncOperations() const;
-  bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  void HashThread(const std::function<void(const u8* data, size_t size)>& update);
+  void StopHashThreads();
+  void WaitForAsyncOperations();
+
+  struct RingBuffer
+  {
+    std::vector<u8> data;
+    u64 bytes_to_hash = 0;
+    // The hash threads and integrity checks that haven't finished with the data yet.
+    // Guarded by m_ring_mutex.
+    u32 users = 0;
+  };
+
+  RingBuffer& AcquireBuffer();
+  void PublishBuffer(RingBuffer* buffer, u32 users);
+  void ReleaseBuffer(RingBuffer* buffer);
+  bool ReadChunk(u64 bytes_to_read, RingBuffer* buffer);
 
   void AddProblem(Severity severity, std::string text);
 
@@ -177,10 +197,18 @@ private:
   mbedtls_sha1_context m_sha1_context{};
 
   u64 m_excess_bytes = 0;
-  std::vector<u8> m_data;
-  std::future<void> m_crc32_future;
-  std::future<void> m_md5_future;
-  std::future<void> m_sha1_future;
+
+  // Process reads data into a ring of buffers. Each hash is calculated on its own thread, which
+  // can fall up to RING_SIZE buffers behind the reads without holding them up.
+  static constexpr size_t RING_SIZE = 8;
+  std::array<RingBuffer, RING_SIZE> m_ring;
+  RingBuffer* m_last_buffer = nullptr;
+  u64 m_buffers_published = 0;
+  std::mutex m_ring_mutex;
+  std::condition_variable m_ring_changed;
+  bool m_stop_hash_threads = false;
+  std::vector<std::thread> m_hash_threads;
+
   std::future<void> m_content_future;
   std::future<void> m_group_future;
 
@@ -202,4 +230,21 @@ private:
   u64 m_max_progress = 0;
 };
 
+struct BatchVerificationResult
+{
+  std::string path;
+  // std::nullopt if the file couldn't be opened as a volume
+  std::optional<VolumeVerifier::Result> result;
+};
+
+using BatchVerificationCallback = std::function<void(const BatchVerificationResult& result)>;
+
+// Verifies every disc image and WAD file in a directory, running several verifiers at once so
+// that at most thread_budget threads (0 for one per CPU core) are busy reading and hashing.
+// The callback is called once for each file as soon as it has been verified, one call at a time.
+std::vector<BatchVerificationResult>
+VerifyDirectory(const std::string& directory, bool recursive, bool redump_verification,
+                Hashes<bool> hashes_to_calculate, u32 thread_budget,
+                const BatchVerificationCallback& callback = {});
+
 }  // namespace DiscIO
@@ -7,12 +7,10 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
-#include <future>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
-#include <thread>
 #include <utility>
 #include <vector>
 
@@ -22,8 +20,10 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscExtractor.h"
@@ -481,19 +481,22 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
                           HashBlock out[BLOCKS_PER_GROUP],
                           const std::function<bool(size_t block)>& read_function)
 {
-  std::array<std::future<void>, BLOCKS_PER_GROUP> hash_futures;
   bool success = true;
 
-  for (size_t i = 0; i < BLOCKS_PER_GROUP; ++i)
+  // The H0 and H1 hashes of each block only depend on that block, so they are calculated on the
+  // thread pool as soon as the block has been read. The remaining hashes are few and small.
   {
-    if (read_function && success)
-      success = read_function(i);
+    Common::TaskGroup task_group;
+    for (size_t i = 0; i < BLOCKS_PER_GROUP && success; ++i)
+    {
+      if (read_function)
+        success = read_function(i);
+      if (!success)
+        break;
 
-    hash_futures[i] = std::async(std::launch::async, [&in, &out, &hash_futures, success, i]() {
-      const size_t h1_base = Common::AlignDown(i, 8);
+      task_group.Submit([&in, out, i] {
+        const size_t h1_base = Common::AlignDown(i, 8);
 
-      if (success)
-      {
         // H0 hashes
         for (size_t j = 0; j < 31; ++j)
           mbedtls_sha1_ret(in[i].data() + j * 0x400, 0x400, out[i].h0[j]);
@@ -504,50 +507,36 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
         // H1 hash
         mbedtls_sha1_ret(reinterpret_cast<u8*>(out[i].h0), sizeof(HashBlock::h0),
                          out[h1_base].h1[i - h1_base]);
-      }
-
-      if (i % 8 == 7)
-      {
-        for (size_t j = 0; j < 7; ++j)
-          hash_futures[h1_base + j].get();
-
-        if (success)
-        {
-          // H1 padding
-          std::memset(out[h1_base].padding_1, 0, sizeof(HashBlock::padding_1));
-
-          // H1 copies
-          for (size_t j = 1; j < 8; ++j)
-            std::memcpy(out[h1_base + j].h1, out[h1_base].h1, sizeof(HashBlock::h1));
+      });
+    }
+    task_group.Wait();
+  }
 
-          // H2 hash
-          mbedtls_sha1_ret(reinterpret_cast<u8*>(out[i].h1), sizeof(HashBlock::h1),
-                           out[0].h2[h1_base / 8]);
-        }
+  if (!success)
+    return false;
 
-        if (i == BLOCKS_PER_GROUP - 1)
-        {
-          for (size_t j = 0; j < 7; ++j)
-            hash_futures[j * 8 + 7].get();
+  for (size_t h1_base = 0; h1_base < BLOCKS_PER_GROUP; h1_base += 8)
+  {
+    // H1 padding
+    std::memset(out[h1_base].padding_1, 0, sizeof(HashBlock::padding_1));
 
-          if (success)
-          {
-            // H2 padding
-            std::memset(out[0].padding_2, 0, sizeof(HashBlock::padding_2));
+    // H1 copies
+    for (size_t j = 1; j < 8; ++j)
+      std::memcpy(out[h1_base + j].h1, out[h1_base].h1, sizeof(HashBlock::h1));
 
-            // H2 copies
-            for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
-              std::memcpy(out[j].h2, out[0].h2, sizeof(HashBlock::h2));
-          }
-        }
-      }
-    });
+    // H2 hash
+    mbedtls_sha1_ret(reinterpret_cast<u8*>(out[h1_base].h1), sizeof(HashBlock::h1),
+                     out[0].h2[h1_base / 8]);
   }
 
-  // Wait for all the async tasks to finish
-  hash_futures.back().get();
+  // H2 padding
+  std::memset(out[0].padding_2, 0, sizeof(HashBlock::padding_2));
+
+  // H2 copies
+  for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
+    std::memcpy(out[j].h2, out[0].h2, sizeof(HashBlock::h2));
 
-  return success;
+  return true;
 }
 
 bool VolumeWii::EncryptGroup(
@@ -582,37 +571,31 @@ bool VolumeWii::EncryptGroup(
   if (hash_exception_callback)
     hash_exception_callback(unencrypted_hashes.data());
 
-  const unsigned int threads =
-      std::min(BLOCKS_PER_GROUP, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
-
-  std::vector<std::future<void>> encryption_futures(threads);
+  // Each block consists of two CBC streams, where the data's IV is taken from the encrypted
+  // hashes. The blocks are independent, so several of them get encrypted at once by each task.
+  constexpr size_t BLOCKS_PER_TASK = 8;
+  static constexpr std::array<u8, 16> ZERO_IV{};
 
-  mbedtls_aes_context aes_context;
-  mbedtls_aes_setkey_enc(&aes_context, key.data(), 128);
-
-  for (size_t i = 0; i < threads; ++i)
+  Common::TaskGroup task_group;
+  for (size_t start = 0; start < BLOCKS_PER_GROUP; start += BLOCKS_PER_TASK)
   {
-    encryption_futures[i] = std::async(
-        std::launch::async,
-        [&unencrypted_data, &unencrypted_hashes, &aes_context, &out](size_t start, size_t end) {
-          for (size_t j = start; j < end; ++j)
-          {
-            u8* out_ptr = out->data() + j * BLOCK_TOTAL_SIZE;
-
-            u8 iv[16] = {};
-            mbedtls_aes_crypt_cbc(&aes_context, MBEDTLS_AES_ENCRYPT, BLOCK_HEADER_SIZE, iv,
-                                  reinterpret_cast<u8*>(&unencrypted_hashes[j]), out_ptr);
+    task_group.Submit([&unencrypted_data, &unencrypted_hashes, &key, out, start] {
+      std::array<Common::AES::CBCBuffer, BLOCKS_PER_TASK> hashes;
+      std::array<Common::AES::CBCBuffer, BLOCKS_PER_TASK> data;
+      for (size_t i = 0; i < BLOCKS_PER_TASK; ++i)
+      {
+        u8* out_ptr = out->data() + (start + i) * BLOCK_TOTAL_SIZE;
+        hashes[i] = {reinterpret_cast<const u8*>(&unencrypted_hashes[start + i]), out_ptr,
+                     BLOCK_HEADER_SIZE, ZERO_IV.data()};
+        data[i] = {unencrypted_data[start + i].data(), out_ptr + BLOCK_HEADER_SIZE,
+                   BLOCK_DATA_SIZE, out_ptr + 0x3D0};
+      }
 
-            std::memcpy(iv, out_ptr + 0x3D0, sizeof(iv));
-            mbedtls_aes_crypt_cbc(&aes_context, MBEDTLS_AES_ENCRYPT, BLOCK_DATA_SIZE, iv,
-                                  unencrypted_data[j].data(), out_ptr + BLOCK_HEADER_SIZE);
-          }
-        },
-        i * BLOCKS_PER_GROUP / threads, (i + 1) * BLOCKS_PER_GROUP / threads);
+      Common::AES::EncryptCBCMultiple(key.data(), hashes.data(), hashes.size());
+      Common::AES::EncryptCBCMultiple(key.data(), data.data(), data.size());
+    });
   }
-
-  for (std::future<void>& future : encryption_futures)
-    future.get();
+  task_group.Wait();
 
   return true;
 }
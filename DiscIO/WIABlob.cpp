@@ -13,6 +13,7 @@
 #include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <mbedtls/sha1.h>
@@ -27,6 +28,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
@@ -498,6 +500,59 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_offset -= skipped_data;
   data_size += skipped_data;
 
+  struct GroupRead
+  {
+    Chunk* chunk;
+    u64 offset_in_file;
+    u64 offset_in_group;
+    u64 size;
+    u8* out_ptr;
+    u64 total_group_index;
+    u64 group_offset_in_data;
+    bool success = false;
+  };
+  std::vector<GroupRead> batch;
+
+  // Groups can be decompressed independently of each other, so when a read needs more than one
+  // group that hasn't been decompressed yet, the groups are decompressed in parallel.
+  const auto read_batch = [&]() {
+    const size_t pending = std::count_if(batch.begin(), batch.end(), [](const GroupRead& read) {
+      return !read.chunk->IsDecompressed(read.offset_in_group, read.size);
+    });
+
+    Common::ParallelFor(
+        batch.size(),
+        [&](size_t i) {
+          GroupRead& read = batch[i];
+          read.success = read.chunk->Read(read.offset_in_group, read.size, read.out_ptr);
+        },
+        std::max<size_t>(pending, 1));
+
+    bool success = true;
+    for (const GroupRead& read : batch)
+    {
+      if (!read.success)
+      {
+        InvalidateCachedChunk(read.offset_in_file);
+        success = false;
+        continue;
+      }
+
+      if (m_write_to_exception_list && m_exception_list_last_group_index != read.total_group_index)
+      {
+        const u64 exception_list_index = read.offset_in_group / VolumeWii::GROUP_DATA_SIZE;
+        const u16 additional_offset =
+            static_cast<u16>(read.group_offset_in_data % VolumeWii::GROUP_DATA_SIZE /
+                             VolumeWii::BLOCK_DATA_SIZE * VolumeWii::BLOCK_HEADER_SIZE);
+        read.chunk->GetHashExceptions(&m_exception_list, exception_list_index, additional_offset);
+        m_exception_list_last_group_index = read.total_group_index;
+      }
+    }
+
+    batch.clear();
+    return success;
+  };
+
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
   for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
   {
@@ -532,27 +587,25 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     }
     else
     {
+      // Reading another chunk could evict one that the batch is still going to read from
+      if (batch.size() == m_chunk_cache_size && !read_batch())
+        return false;
+
       const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
 
       Chunk& chunk =
           ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
                              exception_lists, rvz_packed_size, group_offset_in_data);
 
-      if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
-      {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+      // Groups with identical contents can share a chunk, which mustn't be read from two threads
+      const bool chunk_in_batch =
+          std::any_of(batch.begin(), batch.end(),
+                      [&chunk](const GroupRead& read) { return read.chunk == &chunk; });
+      if (chunk_in_batch && !read_batch())
         return false;
-      }
 
-      if (m_write_to_exception_list && m_exception_list_last_group_index != total_group_index)
-      {
-        const u64 exception_list_index = offset_in_group / VolumeWii::GROUP_DATA_SIZE;
-        const u16 additional_offset =
-            static_cast<u16>(group_offset_in_data % VolumeWii::GROUP_DATA_SIZE /
-                             VolumeWii::BLOCK_DATA_SIZE * VolumeWii::BLOCK_HEADER_SIZE);
-        chunk.GetHashExceptions(&m_exception_list, exception_list_index, additional_offset);
-        m_exception_list_last_group_index = total_group_index;
-      }
+      batch.push_back(GroupRead{&chunk, group_offset_in_file, offset_in_group, bytes_to_read,
+                                *out_ptr, total_group_index, group_offset_in_data});
     }
 
     *offset += bytes_to_read;
@@ -560,7 +613,7 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     *out_ptr += bytes_to_read;
   }
 
-  return true;
+  return read_batch();
 }
 
 template <bool RVZ>
@@ -570,8 +623,15 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  auto it = std::find_if(m_chunk_cache.begin(), m_chunk_cache.end(),
+                         [offset_in_file](const CachedChunk& cached_chunk) {
+                           return cached_chunk.offset_in_file == offset_in_file;
+                         });
+  if (it != m_chunk_cache.end())
+  {
+    it->last_used = ++m_chunk_cache_tick;
+    return it->chunk;
+  }
 
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
@@ -601,11 +661,41 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
+  if (m_chunk_cache.size() < m_chunk_cache_size)
+  {
+    it = m_chunk_cache.emplace(m_chunk_cache.end());
+  }
+  else
+  {
+    it = std::min_element(m_chunk_cache.begin(), m_chunk_cache.end(),
+                          [](const CachedChunk& a, const CachedChunk& b) {
+                            return a.last_used < b.last_used;
+                          });
+  }
+
+  it->chunk =
       Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
             compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  it->offset_in_file = offset_in_file;
+  it->last_used = ++m_chunk_cache_tick;
+  return it->chunk;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::InvalidateCachedChunk(u64 offset_in_file)
+{
+  for (CachedChunk& cached_chunk : m_chunk_cache)
+  {
+    if (cached_chunk.offset_in_file == offset_in_file)
+      cached_chunk.offset_in_file = std::numeric_limits<u64>::max();
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::SetChunkCacheSize(size_t chunks)
+{
+  m_chunk_cache.clear();
+  m_chunk_cache_size = std::max<size_t>(chunks, 1);
 }
 
 template <bool RVZ>
@@ -689,9 +779,8 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
       return false;
     }
 
-    if (!m_file->Seek(m_offset_in_file, File::SeekOrigin::Begin))
-      return false;
-    if (!m_file->ReadBytes(m_in.data.data() + m_in.bytes_written, bytes_to_read))
+    // Positional reads don't move the file position, so chunks can be read from several threads
+    if (!m_file->ReadAt(m_in.data.data() + m_in.bytes_written, bytes_to_read, m_offset_in_file))
       return false;
 
     m_offset_in_file += bytes_to_read;
@@ -755,6 +844,12 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::IsDecompressed(u64 offset, u64 size) const
+{
+  return offset + size <= GetOutBytesWrittenExcludingExceptions();
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Decompress()
 {
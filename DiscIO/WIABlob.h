@@ -5,6 +5,7 @@
 
 #include <array>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -65,6 +66,10 @@ public:
   bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override;
   bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
 
+  // Sets how many decompressed chunks are kept in memory. Keeping more than one avoids
+  // decompressing chunks again when reads alternate between different parts of the disc.
+  void SetChunkCacheSize(size_t chunks);
+
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
                                       int compression_level, int chunk_size, CompressCB callback);
@@ -192,6 +197,7 @@ private:
           u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
+    bool IsDecompressed(u64 offset, u64 size) const;
 
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
@@ -239,6 +245,7 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  void InvalidateCachedChunk(u64 offset_in_file);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -364,9 +371,20 @@ private:
   bool m_valid;
   WIARVZCompressionType m_compression_type;
 
+  static constexpr size_t DEFAULT_CHUNK_CACHE_SIZE = 4;
+
+  struct CachedChunk
+  {
+    u64 offset_in_file = std::numeric_limits<u64>::max();
+    u64 last_used = 0;
+    Chunk chunk;
+  };
+
   File::IOFile m_file;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  // References to cached chunks stay valid until another chunk is read into their slot.
+  std::list<CachedChunk> m_chunk_cache;
+  size_t m_chunk_cache_size = DEFAULT_CHUNK_CACHE_SIZE;
+  u64 m_chunk_cache_tick = 0;
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -23,6 +23,8 @@ namespace DiscIO
 static const u64 WII_SECTOR_SIZE = 0x8000;
 static const u64 WII_SECTOR_COUNT = 143432 * 2;
 static const u64 WII_DISC_HEADER_SIZE = 256;
+// Reads smaller than this go through the chunk cache
+static const u64 CACHE_CHUNK_SIZE = 0x20000;
 
 WbfsFileReader::WbfsFileReader(File::IOFile file, const std::string& path)
     : m_size(0), m_good(false)
@@ -103,6 +105,7 @@ bool WbfsFileReader::ReadHeader()
 
   if (m_wbfs_sector_size < WII_SECTOR_SIZE)
     return false;
+  m_chunk_size = std::min(CACHE_CHUNK_SIZE, m_wbfs_sector_size);
 
   m_blocks_per_disc =
       (WII_SECTOR_COUNT * WII_SECTOR_SIZE + m_wbfs_sector_size - 1) / m_wbfs_sector_size;
@@ -117,20 +120,69 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   if (offset + nbytes > GetDataSize())
     return false;
 
+  if (nbytes >= m_chunk_size)
+    return ReadUncached(offset, nbytes, out_ptr);
+
   while (nbytes)
   {
-    u64 read_size;
-    File::IOFile& data_file = SeekToCluster(offset, &read_size);
-    if (read_size == 0)
+    const u64 chunk_offset = Common::AlignDown(offset, m_chunk_size);
+    const u64 offset_in_chunk = offset - chunk_offset;
+    const u64 read_size = std::min(m_chunk_size - offset_in_chunk, nbytes);
+
+    // A chunk that runs past the end of the files can still have the requested part in them
+    const u8* chunk = GetCachedChunk(chunk_offset);
+    if (chunk)
+      std::memcpy(out_ptr, chunk + offset_in_chunk, read_size);
+    else if (!ReadUncached(offset, read_size, out_ptr))
       return false;
-    read_size = std::min(read_size, nbytes);
 
-    if (!data_file.ReadBytes(out_ptr, read_size))
+    out_ptr += read_size;
+    nbytes -= read_size;
+    offset += read_size;
+  }
+
+  return true;
+}
+
+const u8* WbfsFileReader::GetCachedChunk(u64 offset)
+{
+  auto it = std::find_if(m_chunk_cache.begin(), m_chunk_cache.end(),
+                         [offset](const CachedChunk& chunk) { return chunk.offset == offset; });
+  if (it == m_chunk_cache.end())
+  {
+    it = std::min_element(m_chunk_cache.begin(), m_chunk_cache.end(),
+                          [](const CachedChunk& a, const CachedChunk& b) {
+                            return a.last_used < b.last_used;
+                          });
+    it->data.resize(m_chunk_size);
+    if (!ReadUncached(offset, m_chunk_size, it->data.data()))
+    {
+      it->offset = std::numeric_limits<u64>::max();
+      it->last_used = 0;
+      return nullptr;
+    }
+    it->offset = offset;
+  }
+
+  it->last_used = ++m_chunk_cache_tick;
+  return it->data.data();
+}
+
+bool WbfsFileReader::ReadUncached(u64 offset, u64 nbytes, u8* out_ptr)
+{
+  while (nbytes)
+  {
+    u64 read_size;
+    const u64 address = GetStoredAddress(offset, nbytes, &read_size);
+    if (read_size == 0)
     {
-      data_file.ClearError();
+      ERROR_LOG_FMT(DISCIO, "Read beyond end of disc");
       return false;
     }
 
+    if (!ReadFromFiles(address, read_size, out_ptr))
+      return false;
+
     out_ptr += read_size;
     nbytes -= read_size;
     offset += read_size;
@@ -139,37 +191,68 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   return true;
 }
 
-File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
+// Returns where in the files the data at offset is stored, along with how much of the data
+// after it (up to max_size) is stored right after it. Blocks that follow each other on the disc
+// tend to be stored one after the other, so reads that cover several of them need only one read.
+u64 WbfsFileReader::GetStoredAddress(u64 offset, u64 max_size, u64* contiguous_size) const
+{
+  u64 block = offset >> m_header.wbfs_sector_shift;
+  if (block >= m_blocks_per_disc)
+  {
+    *contiguous_size = 0;
+    return 0;
+  }
+
+  const u64 offset_in_block = offset & (m_wbfs_sector_size - 1);
+  const u64 address = m_wbfs_sector_size * m_wlba_table[block] + offset_in_block;
+
+  u64 size = m_wbfs_sector_size - offset_in_block;
+  while (size < max_size && block + 1 < m_blocks_per_disc &&
+         m_wlba_table[block + 1] == m_wlba_table[block] + 1)
+  {
+    ++block;
+    size += m_wbfs_sector_size;
+  }
+
+  *contiguous_size = std::min(size, max_size);
+  return address;
+}
+
+// Reads data that is stored back to back, which may continue from one file into the next
+bool WbfsFileReader::ReadFromFiles(u64 address, u64 nbytes, u8* out_ptr)
 {
-  u64 base_cluster = (offset >> m_header.wbfs_sector_shift);
-  if (base_cluster < m_blocks_per_disc)
+  for (FileEntry& file_entry : m_files)
   {
-    u64 cluster_address = m_wbfs_sector_size * m_wlba_table[base_cluster];
-    u64 cluster_offset = offset & (m_wbfs_sector_size - 1);
-    u64 final_address = cluster_address + cluster_offset;
+    if (nbytes == 0)
+      return true;
+    if (address >= file_entry.base_address + file_entry.size)
+      continue;
+
+    const u64 address_in_file = address - file_entry.base_address;
+    const u64 read_size = std::min(file_entry.size - address_in_file, nbytes);
+    if (file_entry.position != address_in_file &&
+        !file_entry.file.Seek(address_in_file, File::SeekOrigin::Begin))
+    {
+      file_entry.position = std::numeric_limits<u64>::max();
+      return false;
+    }
 
-    for (FileEntry& file_entry : m_files)
+    if (!file_entry.file.ReadBytes(out_ptr, read_size))
     {
-      if (final_address < (file_entry.base_address + file_entry.size))
-      {
-        file_entry.file.Seek(final_address - file_entry.base_address, File::SeekOrigin::Begin);
-        if (available)
-        {
-          u64 till_end_of_file = file_entry.size - (final_address - file_entry.base_address);
-          u64 till_end_of_sector = m_wbfs_sector_size - cluster_offset;
-          *available = std::min(till_end_of_file, till_end_of_sector);
-        }
-
-        return file_entry.file;
-      }
+      file_entry.file.ClearError();
+      file_entry.position = std::numeric_limits<u64>::max();
+      return false;
     }
+    file_entry.position = address_in_file + read_size;
+
+    out_ptr += read_size;
+    nbytes -= read_size;
+    address += read_size;
   }
 
-  ERROR_LOG_FMT(DISCIO, "Read beyond end of disc");
-  if (available)
-    *available = 0;
-  m_files[0].file.Seek(0, File::SeekOrigin::Begin);
-  return m_files[0].file;
+  if (nbytes != 0)
+    ERROR_LOG_FMT(DISCIO, "Read beyond end of disc");
+  return nbytes == 0;
 }
 
 std::unique_ptr<WbfsFileReader> WbfsFileReader::Create(File::IOFile file, const std::string& path)
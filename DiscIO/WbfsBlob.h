@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -45,7 +47,10 @@ private:
   bool AddFileToList(File::IOFile file);
   bool ReadHeader();
 
-  File::IOFile& SeekToCluster(u64 offset, u64* available);
+  bool ReadUncached(u64 offset, u64 nbytes, u8* out_ptr);
+  bool ReadFromFiles(u64 address, u64 nbytes, u8* out_ptr);
+  u64 GetStoredAddress(u64 offset, u64 max_size, u64* contiguous_size) const;
+  const u8* GetCachedChunk(u64 offset);
   bool IsGood() { return m_good; }
   struct FileEntry
   {
@@ -57,10 +62,27 @@ private:
     File::IOFile file;
     u64 base_address;
     u64 size;
+    // Where the file was left by the last read, so that reads that continue it skip the seek
+    u64 position = std::numeric_limits<u64>::max();
   };
 
   std::vector<FileEntry> m_files;
 
+  static constexpr size_t CHUNK_CACHE_SIZE = 16;
+
+  struct CachedChunk
+  {
+    u64 offset = std::numeric_limits<u64>::max();
+    u64 last_used = 0;
+    std::vector<u8> data;
+  };
+
+  // Small reads are served from whole chunks of the disc, which are kept for a while, so that
+  // reads that are scattered over a small area only go to the files once
+  std::array<CachedChunk, CHUNK_CACHE_SIZE> m_chunk_cache;
+  u64 m_chunk_size = 0;
+  u64 m_chunk_cache_tick = 0;
+
   u64 m_size;
 
   u64 m_hd_sector_size;
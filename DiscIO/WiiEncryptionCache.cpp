@@ -3,9 +3,12 @@
 
 #include "DiscIO/WiiEncryptionCache.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <iterator>
 #include <limits>
+#include <list>
 #include <memory>
 
 #include "Common/Align.h"
@@ -21,48 +24,69 @@ WiiEncryptionCache::WiiEncryptionCache(BlobReader* blob) : m_blob(blob)
 
 WiiEncryptionCache::~WiiEncryptionCache() = default;
 
+void WiiEncryptionCache::SetCacheSize(size_t groups)
+{
+  m_cache_size = std::max<size_t>(groups, 1);
+  while (m_cache.size() > m_cache_size)
+    m_cache.pop_back();
+}
+
 const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
 WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
                                  u64 partition_data_decrypted_size, const Key& key,
                                  const HashExceptionCallback& hash_exception_callback)
 {
-  // Only allocate memory if this function actually ends up getting called
-  if (!m_cache)
-  {
-    m_cache = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
-    m_cached_offset = std::numeric_limits<u64>::max();
-  }
-
   ASSERT(offset % VolumeWii::GROUP_TOTAL_SIZE == 0);
   const u64 group_offset_in_partition =
       offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
   const u64 group_offset_on_disc = partition_data_offset + offset;
 
-  if (m_cached_offset != group_offset_on_disc)
+  auto it = std::find_if(m_cache.begin(), m_cache.end(), [&](const CachedGroup& group) {
+    return group.offset == group_offset_on_disc;
+  });
+  if (it != m_cache.end())
+  {
+    m_cache.splice(m_cache.begin(), m_cache, it);
+    return m_cache.front().data.get();
+  }
+
+  // Reuse the memory of the least recently used group if the cache is full. Memory is only
+  // allocated if this function actually ends up getting called.
+  if (m_cache.size() < m_cache_size)
+  {
+    m_cache.push_front(
+        CachedGroup{0, std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>()});
+  }
+  else
+  {
+    m_cache.splice(m_cache.begin(), m_cache, std::prev(m_cache.end()));
+  }
+
+  CachedGroup& group = m_cache.front();
+  group.offset = std::numeric_limits<u64>::max();
+
+  std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
+
+  if (hash_exception_callback)
+  {
+    hash_exception_callback_2 =
+        [offset, &hash_exception_callback](
+            VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
+          return hash_exception_callback(hash_blocks, offset);
+        };
+  }
+
+  if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
+                               partition_data_decrypted_size, key, m_blob, group.data.get(),
+                               hash_exception_callback_2))
   {
-    std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
-
-    if (hash_exception_callback)
-    {
-      hash_exception_callback_2 =
-          [offset, &hash_exception_callback](
-              VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
-            return hash_exception_callback(hash_blocks, offset);
-          };
-    }
-
-    if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
-                                 partition_data_decrypted_size, key, m_blob, m_cache.get(),
-                                 hash_exception_callback_2))
-    {
-      m_cached_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
-      return nullptr;
-    }
-
-    m_cached_offset = group_offset_on_disc;
+    // Leave the failed group at the back, where it gets reused first
+    m_cache.splice(m_cache.end(), m_cache, m_cache.begin());
+    return nullptr;
   }
 
-  return m_cache.get();
+  group.offset = group_offset_on_disc;
+  return group.data.get();
 }
 
 bool WiiEncryptionCache::EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
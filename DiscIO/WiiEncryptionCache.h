@@ -5,6 +5,7 @@
 
 #include <array>
 #include <limits>
+#include <list>
 #include <memory>
 
 #include "Common/CommonTypes.h"
@@ -33,6 +34,13 @@ public:
   WiiEncryptionCache(const WiiEncryptionCache&) = delete;
   WiiEncryptionCache& operator=(const WiiEncryptionCache&) = delete;
 
+  // How many encrypted groups are kept around. Re-encrypting a group means reading and hashing
+  // all of its data again, so keeping a few makes random access within a partition cheaper.
+  static constexpr size_t DEFAULT_CACHE_SIZE = 4;
+
+  // Must be at least 1. Shrinking the cache drops the groups that were used least recently.
+  void SetCacheSize(size_t groups);
+
   // Encrypts exactly one group.
   // If the returned pointer is nullptr, reading from the blob failed.
   // If the returned pointer is not nullptr, it is guaranteed to be valid until
@@ -48,9 +56,16 @@ public:
                      const HashExceptionCallback& hash_exception_callback = {});
 
 private:
+  struct CachedGroup
+  {
+    u64 offset;
+    std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> data;
+  };
+
   BlobReader* m_blob;
-  std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> m_cache;
-  u64 m_cached_offset = 0;
+  // The most recently used group is at the front
+  std::list<CachedGroup> m_cache;
+  size_t m_cache_size = DEFAULT_CACHE_SIZE;
 };
 
 }  // namespace DiscIO
@@ -13,6 +13,8 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <optional>
 
@@ -26,6 +28,7 @@
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -97,11 +100,42 @@ constexpr size_t CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE = 37;
 constexpr size_t CONTROLER_OUTPUT_INIT_PAYLOAD_SIZE = 1;
 constexpr size_t CONTROLER_OUTPUT_RUMBLE_PAYLOAD_SIZE = 5;
 
-static std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE> s_controller_payload;
-static std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE> s_controller_payload_swap;
+struct InputSample
+{
+  std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE> payload;
+  int size;
+  // Host time the sample arrived at, and how many samples arrived up to it
+  u64 timestamp_us;
+  u64 sequence;
+};
 
-// Only access with s_mutex held!
-static int s_controller_payload_size = {0};
+// The latest sample is handed over through a triple buffer: the side receiving samples fills the
+// back buffer and swaps it with the middle one, and Input() swaps its front buffer with the middle
+// one when a newer sample is there. Neither side ever has to wait for the other.
+constexpr u8 INPUT_BUFFER_FRESH = 0x4;
+static std::array<InputSample, 3> s_input_buffers{};
+static std::atomic<u8> s_input_middle{1};
+// Only accessed by the side receiving samples
+static u8 s_input_back = 0;
+static u64 s_input_sequence = 0;
+static u64 s_last_input_time_us = 0;
+// Only accessed by Input()
+static u8 s_input_front = 2;
+static u64 s_last_polled_sequence = 0;
+static std::array<u64, SerialInterface::MAX_SI_CHANNELS> s_channel_polled_sequence{};
+
+// How long the adapter takes between samples, on average
+static std::atomic<u64> s_input_interval_us{0};
+static Common::Event s_input_received;
+
+// SI polls wait for the next sample if it's due within this much time, instead of reading a sample
+// they have already seen
+constexpr u64 MAX_POLL_ALIGNMENT_WAIT_US = 2000;
+
+static std::atomic<u64> s_samples_received{0};
+static std::atomic<u64> s_samples_polled{0};
+static std::atomic<u64> s_total_latency_us{0};
+static std::atomic<u64> s_max_latency_us{0};
 
 static std::array<u8, CONTROLER_OUTPUT_RUMBLE_PAYLOAD_SIZE> s_controller_write_payload;
 static std::atomic<int> s_controller_write_payload_size{0};
@@ -112,8 +146,13 @@ static std::thread s_write_adapter_thread;
 static Common::Flag s_write_adapter_thread_running;
 static Common::Event s_write_happened;
 
-static std::mutex s_read_mutex;
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
+// Transfers are kept queued so that the adapter always has one to answer as soon as it has a new
+// sample, instead of waiting for the read thread to get around to asking for one again
+constexpr size_t INPUT_TRANSFER_COUNT = 3;
+static std::atomic<int> s_input_transfers_in_flight{0};
+static Common::Event s_input_transfer_retired;
+
 static std::mutex s_init_mutex;
 #elif GCADAPTER_USE_ANDROID_IMPLEMENTATION
 static std::mutex s_write_mutex;
@@ -148,6 +187,133 @@ static std::optional<size_t> s_config_callback_id = std::nullopt;
 static std::array<SerialInterface::SIDevices, SerialInterface::MAX_SI_CHANNELS>
     s_config_si_device_type{};
 static std::array<bool, SerialInterface::MAX_SI_CHANNELS> s_config_rumble_enabled{};
+static bool s_config_align_polls = false;
+
+static void PublishInput(const u8* payload, int size)
+{
+  const u64 now = Common::Timer::GetTimeUs();
+  if (s_last_input_time_us != 0 && now - s_last_input_time_us < 100000)
+  {
+    const u64 interval = s_input_interval_us.load(std::memory_order_relaxed);
+    const u64 elapsed = now - s_last_input_time_us;
+    s_input_interval_us.store(interval == 0 ? elapsed : (interval * 7 + elapsed) / 8,
+                              std::memory_order_relaxed);
+  }
+  s_last_input_time_us = now;
+
+  InputSample& sample = s_input_buffers[s_input_back];
+  std::copy_n(payload, std::clamp<int>(size, 0, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE),
+              sample.payload.begin());
+  sample.size = size;
+  sample.timestamp_us = now;
+  sample.sequence = ++s_input_sequence;
+  s_input_back = s_input_middle.exchange(s_input_back | INPUT_BUFFER_FRESH,
+                                         std::memory_order_acq_rel) &
+                 ~INPUT_BUFFER_FRESH;
+
+  s_samples_received.fetch_add(1, std::memory_order_relaxed);
+  s_input_received.Set();
+}
+
+static const InputSample& GetLatestInput()
+{
+  if (s_input_middle.load(std::memory_order_relaxed) & INPUT_BUFFER_FRESH)
+  {
+    s_input_front =
+        s_input_middle.exchange(s_input_front, std::memory_order_acq_rel) & ~INPUT_BUFFER_FRESH;
+  }
+  return s_input_buffers[s_input_front];
+}
+
+// Games poll pads at their own pace, which drifts against the adapter's. When a channel would get
+// the same sample as last time and the next one is about to arrive, waiting for it a little saves
+// a whole adapter interval of latency.
+static void WaitForAlignedInput(int chan)
+{
+  const u64 interval = s_input_interval_us.load(std::memory_order_relaxed);
+  if (interval == 0)
+    return;
+
+  s_input_received.Reset();
+  const InputSample& sample = GetLatestInput();
+  if (sample.sequence != s_channel_polled_sequence[chan])
+    return;
+
+  const u64 now = Common::Timer::GetTimeUs();
+  const u64 expected = sample.timestamp_us + interval;
+  if (expected <= now || expected - now > MAX_POLL_ALIGNMENT_WAIT_US)
+    return;
+
+  s_input_received.WaitFor(std::chrono::microseconds(expected - now + interval / 8));
+}
+
+#if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
+// Called on the libusb event thread
+static void LIBUSB_CALL ReadCallback(libusb_transfer* transfer)
+{
+  if (transfer->status == LIBUSB_TRANSFER_COMPLETED)
+  {
+    PublishInput(transfer->buffer, transfer->actual_length);
+
+    if (s_read_adapter_thread_running.IsSet())
+    {
+      const int error = libusb_submit_transfer(transfer);
+      if (error == LIBUSB_SUCCESS)
+        return;
+
+      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_submit_transfer failed: {}",
+                    LibusbUtils::ErrorWrap(error));
+    }
+  }
+  else if (transfer->status != LIBUSB_TRANSFER_CANCELLED)
+  {
+    ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: input transfer failed with status {}",
+                  static_cast<int>(transfer->status));
+  }
+
+  s_input_transfers_in_flight--;
+  s_input_transfer_retired.Set();
+}
+
+static void ReadTransfers()
+{
+  std::array<std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE>, INPUT_TRANSFER_COUNT> buffers;
+  std::array<libusb_transfer*, INPUT_TRANSFER_COUNT> transfers{};
+
+  for (size_t i = 0; i < INPUT_TRANSFER_COUNT; ++i)
+  {
+    transfers[i] = libusb_alloc_transfer(0);
+    if (!transfers[i])
+      break;
+
+    libusb_fill_interrupt_transfer(transfers[i], s_handle, s_endpoint_in, buffers[i].data(),
+                                   CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE, ReadCallback, nullptr, 0);
+    s_input_transfers_in_flight++;
+    const int error = libusb_submit_transfer(transfers[i]);
+    if (error != LIBUSB_SUCCESS)
+    {
+      s_input_transfers_in_flight--;
+      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_submit_transfer failed: {}",
+                    LibusbUtils::ErrorWrap(error));
+    }
+  }
+
+  // Transfers resubmit themselves until the thread is stopped, or until they fail
+  while (s_read_adapter_thread_running.IsSet() && s_input_transfers_in_flight > 0)
+    s_input_transfer_retired.Wait();
+
+  for (libusb_transfer* transfer : transfers)
+  {
+    if (transfer)
+      libusb_cancel_transfer(transfer);
+  }
+  while (s_input_transfers_in_flight > 0)
+    s_input_transfer_retired.Wait();
+
+  for (libusb_transfer* transfer : transfers)
+    libusb_free_transfer(transfer);
+}
+#endif
 
 static void Read()
 {
@@ -185,30 +351,14 @@ static void Read()
   // Reset rumble once on initial reading
   ResetRumble();
 
-  while (s_read_adapter_thread_running.IsSet())
-  {
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
-    int payload_size = 0;
-    const int error =
-        libusb_interrupt_transfer(s_handle, s_endpoint_in, s_controller_payload_swap.data(),
-                                  CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE, &payload_size, 16);
-    if (error != LIBUSB_SUCCESS)
-    {
-      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_interrupt_transfer failed: {}",
-                    LibusbUtils::ErrorWrap(error));
-    }
+  ReadTransfers();
 #elif GCADAPTER_USE_ANDROID_IMPLEMENTATION
+  while (s_read_adapter_thread_running.IsSet())
+  {
     const int payload_size = env->CallStaticIntMethod(s_adapter_class, input_func);
     jbyte* const java_data = env->GetByteArrayElements(*java_controller_payload, nullptr);
-    std::copy(java_data, java_data + CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE,
-              s_controller_payload_swap.begin());
-#endif
-    {
-      std::lock_guard<std::mutex> lk(s_read_mutex);
-      std::swap(s_controller_payload_swap, s_controller_payload);
-      s_controller_payload_size = payload_size;
-    }
-#if GCADAPTER_USE_ANDROID_IMPLEMENTATION
+    PublishInput(reinterpret_cast<const u8*>(java_data), payload_size);
     env->ReleaseByteArrayElements(*java_controller_payload, java_data, 0);
 
     if (first_read)
@@ -216,10 +366,10 @@ static void Read()
       first_read = false;
       s_fd = env->CallStaticIntMethod(s_adapter_class, getfd_func);
     }
-#endif
 
     Common::YieldCPU();
   }
+#endif
 
   // Terminate the write thread on leaving
   if (s_write_adapter_thread_running.TestAndClear())
@@ -388,6 +538,7 @@ static void RefreshConfig()
     s_config_si_device_type[i] = Config::Get(Config::GetInfoForSIDevice(i));
     s_config_rumble_enabled[i] = Config::Get(Config::GetInfoForAdapterRumble(i));
   }
+  s_config_align_polls = Config::Get(Config::MAIN_ADAPTER_ALIGN_POLLS);
 }
 
 void Init()
@@ -671,7 +822,12 @@ static void Reset()
 #endif
 
   if (s_read_adapter_thread_running.TestAndClear())
+  {
+#if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
+    s_input_transfer_retired.Set();
+#endif
     s_read_adapter_thread.join();
+  }
   // The read thread will close the write thread
 
   s_controller_type.fill(ControllerType::None);
@@ -713,25 +869,35 @@ GCPadStatus Input(int chan)
     return {};
 #endif
 
-  int payload_size = 0;
-  std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE> controller_payload_copy{};
+  if (s_config_align_polls)
+    WaitForAlignedInput(chan);
 
+  const InputSample& sample = GetLatestInput();
+  const int payload_size = sample.size;
+  const std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE>& controller_payload =
+      sample.payload;
+
+  if (sample.sequence > s_last_polled_sequence)
   {
-    std::lock_guard<std::mutex> lk(s_read_mutex);
-    controller_payload_copy = s_controller_payload;
-    payload_size = s_controller_payload_size;
+    const u64 latency = Common::Timer::GetTimeUs() - sample.timestamp_us;
+    s_samples_polled.fetch_add(1, std::memory_order_relaxed);
+    s_total_latency_us.fetch_add(latency, std::memory_order_relaxed);
+    if (latency > s_max_latency_us.load(std::memory_order_relaxed))
+      s_max_latency_us.store(latency, std::memory_order_relaxed);
+    s_last_polled_sequence = sample.sequence;
   }
+  s_channel_polled_sequence[chan] = sample.sequence;
 
   GCPadStatus pad = {};
   if (payload_size != CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
-      || controller_payload_copy[0] != LIBUSB_DT_HID
+      || controller_payload[0] != LIBUSB_DT_HID
 #endif
   )
   {
     // This can occur for a few frames on initialization.
     ERROR_LOG_FMT(CONTROLLERINTERFACE, "error reading payload (size: {}, type: {:02x})",
-                  payload_size, controller_payload_copy[0]);
+                  payload_size, controller_payload[0]);
 #if GCADAPTER_USE_ANDROID_IMPLEMENTATION
     Reset();
 #endif
@@ -740,11 +906,11 @@ GCPadStatus Input(int chan)
   {
     bool get_origin = false;
     // TODO: What do the other bits here indicate?  Does casting to an enum like this make sense?
-    const auto type = static_cast<ControllerType>(controller_payload_copy[1 + (9 * chan)] >> 4);
+    const auto type = static_cast<ControllerType>(controller_payload[1 + (9 * chan)] >> 4);
     if (type != ControllerType::None && s_controller_type[chan] == ControllerType::None)
     {
       NOTICE_LOG_FMT(CONTROLLERINTERFACE, "New device connected to Port {} of Type: {:02x}",
-                     chan + 1, controller_payload_copy[1 + (9 * chan)]);
+                     chan + 1, controller_payload[1 + (9 * chan)]);
       get_origin = true;
     }
 
@@ -752,8 +918,8 @@ GCPadStatus Input(int chan)
 
     if (s_controller_type[chan] != ControllerType::None)
     {
-      const u8 b1 = controller_payload_copy[1 + (9 * chan) + 1];
-      const u8 b2 = controller_payload_copy[1 + (9 * chan) + 2];
+      const u8 b1 = controller_payload[1 + (9 * chan) + 1];
+      const u8 b2 = controller_payload[1 + (9 * chan) + 2];
 
       if (b1 & (1 << 0))
         pad.button |= PAD_BUTTON_A;
@@ -785,12 +951,12 @@ GCPadStatus Input(int chan)
       if (get_origin)
         pad.button |= PAD_GET_ORIGIN;
 
-      pad.stickX = controller_payload_copy[1 + (9 * chan) + 3];
-      pad.stickY = controller_payload_copy[1 + (9 * chan) + 4];
-      pad.substickX = controller_payload_copy[1 + (9 * chan) + 5];
-      pad.substickY = controller_payload_copy[1 + (9 * chan) + 6];
-      pad.triggerLeft = controller_payload_copy[1 + (9 * chan) + 7];
-      pad.triggerRight = controller_payload_copy[1 + (9 * chan) + 8];
+      pad.stickX = controller_payload[1 + (9 * chan) + 3];
+      pad.stickY = controller_payload[1 + (9 * chan) + 4];
+      pad.substickX = controller_payload[1 + (9 * chan) + 5];
+      pad.substickY = controller_payload[1 + (9 * chan) + 6];
+      pad.triggerLeft = controller_payload[1 + (9 * chan) + 7];
+      pad.triggerRight = controller_payload[1 + (9 * chan) + 8];
     }
     else if (!Core::WantsDeterminism())
     {
@@ -822,6 +988,14 @@ bool UseAdapter()
   });
 }
 
+InputLatencyStats GetInputLatencyStats()
+{
+  return {s_samples_received.load(std::memory_order_relaxed),
+          s_samples_polled.load(std::memory_order_relaxed),
+          s_total_latency_us.load(std::memory_order_relaxed),
+          s_max_latency_us.load(std::memory_order_relaxed)};
+}
+
 void ResetRumble()
 {
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
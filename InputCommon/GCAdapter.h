@@ -11,6 +11,16 @@ struct GCPadStatus;
 
 namespace GCAdapter
 {
+struct InputLatencyStats
+{
+  // Samples received from the adapter, and how many of them were polled by the game
+  u64 samples_received;
+  u64 samples_polled;
+  // Time from a sample arriving to the game polling it for the first time
+  u64 total_latency_us;
+  u64 max_latency_us;
+};
+
 void Init();
 void ResetRumble();
 void Shutdown();
@@ -23,5 +33,6 @@ bool IsDetected(const char** error_message);
 bool DeviceConnected(int chan);
 void ResetDeviceType(int chan);
 bool UseAdapter();
+InputLatencyStats GetInputLatencyStats();
 
 }  // namespace GCAdapter
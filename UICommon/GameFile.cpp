@@ -115,6 +115,13 @@ GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 {
   m_file_name = PathToFileName(m_file_path);
 
+  // This is checked before the file is read, so that a change made while reading it gets noticed
+  {
+    const File::FileInfo file_info(m_file_path);
+    m_file_size_on_disk = file_info.GetSize();
+    m_file_modification_time = file_info.GetModificationTime();
+  }
+
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolume(m_file_path));
     if (volume != nullptr)
@@ -348,6 +355,8 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_file_name);
 
   p.Do(m_file_size);
+  p.Do(m_file_size_on_disk);
+  p.Do(m_file_modification_time);
   p.Do(m_volume_size);
   p.Do(m_volume_size_is_accurate);
   p.Do(m_is_datel_disc);
@@ -839,6 +848,13 @@ bool GameFile::IsModDescriptor() const
   return m_blob_type == DiscIO::BlobType::MOD_DESCRIPTOR;
 }
 
+bool GameFile::FileChangedOnDisk() const
+{
+  const File::FileInfo file_info(m_file_path);
+  return file_info.GetSize() != m_file_size_on_disk ||
+         file_info.GetModificationTime() != m_file_modification_time;
+}
+
 const GameBanner& GameFile::GetBannerImage() const
 {
   return m_custom_banner.empty() ? m_volume_banner : m_custom_banner;
@@ -103,6 +103,9 @@ public:
   bool ShouldAllowConversion() const;
   const std::string& GetApploaderDate() const { return m_apploader_date; }
   u64 GetFileSize() const { return m_file_size; }
+  // Returns true if the size or modification time of the file on disk is different from when
+  // this GameFile was created, in which case the metadata may be outdated.
+  bool FileChangedOnDisk() const;
   u64 GetVolumeSize() const { return m_volume_size; }
   bool IsVolumeSizeAccurate() const { return m_volume_size_is_accurate; }
   bool IsDatelDisc() const { return m_is_datel_disc; }
@@ -144,6 +147,8 @@ private:
   std::string m_file_name;
 
   u64 m_file_size{};
+  u64 m_file_size_on_disk{};
+  s64 m_file_modification_time{};
   u64 m_volume_size{};
   bool m_volume_size_is_accurate{};
   bool m_is_datel_disc{};
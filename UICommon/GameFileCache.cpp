@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <functional>
 #include <list>
@@ -20,6 +22,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/ThreadPool.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -27,7 +30,55 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 21;  // Last changed in PR 10187
+static constexpr u32 CACHE_REVISION = 22;  // Last changed when adding file modification times
+
+// Runs job(i) for every i below count on the global thread pool, and passes each result to
+// on_result on the calling thread as soon as it's ready.
+template <typename T>
+static void RunInParallel(size_t count, const std::function<T(size_t)>& job,
+                          const std::function<void(size_t, T)>& on_result)
+{
+  std::mutex results_mutex;
+  std::condition_variable result_ready;
+  std::vector<std::pair<size_t, T>> results;
+  size_t pending = count;
+
+  Common::ThreadPool& pool = Common::GetGlobalThreadPool();
+  Common::TaskGroup task_group(pool);
+  for (size_t i = 0; i < count; ++i)
+  {
+    task_group.Submit(
+        [&, i] {
+          T result = job(i);
+          std::lock_guard lk(results_mutex);
+          results.emplace_back(i, std::move(result));
+          --pending;
+          result_ready.notify_one();
+        },
+        Common::TaskPriority::Low);
+  }
+
+  std::unique_lock lk(results_mutex);
+  while (true)
+  {
+    std::vector<std::pair<size_t, T>> ready_results = std::move(results);
+    results.clear();
+    const bool done = pending == 0;
+
+    lk.unlock();
+    for (auto& [index, result] : ready_results)
+      on_result(index, std::move(result));
+
+    if (done)
+      break;
+
+    // Help out instead of just waiting, in case this is running on one of the pool's threads
+    const bool ran_task = pool.RunPendingTask();
+    lk.lock();
+    if (!ran_task && results.empty() && pending != 0)
+      result_ready.wait_for(lk, std::chrono::milliseconds(10));
+  }
+}
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -69,10 +120,16 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
   auto it = std::find_if(
       m_cached_files.begin(), m_cached_files.end(),
       [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
-  const bool found = it != m_cached_files.cend();
+  const bool found = it != m_cached_files.cend() && !(*it)->FileChangedOnDisk();
   if (!found)
   {
     std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
+    // the stale entry of a file that changed on disk goes away even if the file no longer opens
+    if (it != m_cached_files.cend())
+    {
+      m_cached_files.erase(it);
+      *cache_changed = true;
+    }
     if (!game->IsValid())
       return nullptr;
     m_cached_files.emplace_back(std::move(game));
@@ -105,6 +162,8 @@ bool GameFileCache::Update(
 
   // Delete paths that aren't in game_paths from m_cached_files,
   // while simultaneously deleting paths that are in m_cached_files from game_paths.
+  // Files whose size or modification time has changed are deleted from m_cached_files instead,
+  // so that they get read again below. Unchanged files don't need to be opened at all.
   // For the sake of speed, we don't care about maintaining the order of m_cached_files.
   {
     auto it = m_cached_files.begin();
@@ -114,8 +173,10 @@ bool GameFileCache::Update(
       if (processing_halted)
         break;
 
-      if (game_paths.erase((*it)->GetFilePath()))
+      const auto path_it = game_paths.find((*it)->GetFilePath());
+      if (path_it != game_paths.end() && !(*it)->FileChangedOnDisk())
       {
+        game_paths.erase(path_it);
         ++it;
       }
       else
@@ -133,21 +194,25 @@ bool GameFileCache::Update(
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
-  {
-    if (processing_halted)
-      break;
+  // Opening the files is what takes time, so that is done on several threads.
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  RunInParallel<std::shared_ptr<GameFile>>(
+      new_paths.size(),
+      [&](size_t i) -> std::shared_ptr<GameFile> {
+        if (processing_halted)
+          return nullptr;
+        return std::make_shared<GameFile>(new_paths[i]);
+      },
+      [&](size_t, std::shared_ptr<GameFile> file) {
+        if (!file || !file->IsValid())
+          return;
+
+        if (game_added_to_cache)
+          game_added_to_cache(file);
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
-    {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
-
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
-    }
-  }
+        cache_changed = true;
+        m_cached_files.push_back(std::move(file));
+      });
 
   return cache_changed;
 }
@@ -158,16 +223,15 @@ bool GameFileCache::UpdateAdditionalMetadata(
 {
   bool cache_changed = false;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
-  {
-    if (processing_halted)
-      break;
-
-    const bool updated = UpdateAdditionalMetadata(&file);
-    cache_changed |= updated;
-    if (game_updated && updated)
-      game_updated(file);
-  }
+  // Each task only replaces its own element of m_cached_files, so they can run at the same time
+  RunInParallel<bool>(
+      m_cached_files.size(),
+      [&](size_t i) { return !processing_halted && UpdateAdditionalMetadata(&m_cached_files[i]); },
+      [&](size_t i, bool updated) {
+        cache_changed |= updated;
+        if (game_updated && updated)
+          game_updated(m_cached_files[i]);
+      });
 
   return cache_changed;
 }
@@ -9,6 +9,7 @@
 #include "Common/IniFile.h"
 
 #include <algorithm>
+#include <numeric>
 
 namespace ResourcePack
 {
@@ -38,38 +39,34 @@ bool Init()
 
   auto* order = file.GetOrCreateSection("Order");
 
-  struct OrderHelper
-  {
-    size_t pack_list_index;
-    std::string manifest_id;
-  };
+  // Each pack is only opened once, since that's what takes time with many large packs
+  std::vector<ResourcePack> loaded_packs;
+  loaded_packs.reserve(pack_list.size());
+  for (const std::string& path : pack_list)
+    loaded_packs.emplace_back(path);
 
-  std::vector<OrderHelper> pack_list_order;
-  pack_list_order.reserve(pack_list.size());
-  for (size_t i = 0; i < pack_list.size(); ++i)
-  {
-    const ResourcePack pack(pack_list[i]);
-    std::string manifest_id = pack.IsValid() ? pack.GetManifest()->GetID() : pack_list[i];
-    pack_list_order.emplace_back(OrderHelper{i, std::move(manifest_id)});
-  }
+  const auto get_order_id = [&](size_t index) -> const std::string& {
+    const ResourcePack& pack = loaded_packs[index];
+    return pack.IsValid() ? pack.GetManifest()->GetID() : pack_list[index];
+  };
 
-  std::sort(
-      pack_list_order.begin(), pack_list_order.end(),
-      [](const OrderHelper& a, const OrderHelper& b) { return a.manifest_id < b.manifest_id; });
+  std::vector<size_t> pack_list_order(pack_list.size());
+  std::iota(pack_list_order.begin(), pack_list_order.end(), 0);
+  std::sort(pack_list_order.begin(), pack_list_order.end(),
+            [&](size_t a, size_t b) { return get_order_id(a) < get_order_id(b); });
 
   bool error = false;
   for (size_t i = 0; i < pack_list_order.size(); ++i)
   {
-    const auto& path = pack_list[pack_list_order[i].pack_list_index];
-
-    const ResourcePack* const pack = Add(path);
-    if (pack == nullptr)
+    ResourcePack& pack = loaded_packs[pack_list_order[i]];
+    if (!pack.IsValid())
     {
       error = true;
       continue;
     }
 
-    order->Set(pack->GetManifest()->GetID(), static_cast<u64>(i));
+    order->Set(pack.GetManifest()->GetID(), static_cast<u64>(i));
+    packs.push_back(std::move(pack));
   }
 
   file.Save(packs_path);
@@ -4,6 +4,11 @@
 #include "UICommon/ResourcePack/ResourcePack.h"
 
 #include <algorithm>
+#include <fstream>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
 
 #include <mz_compat.h>
 
@@ -85,6 +90,7 @@ ResourcePack::ResourcePack(const std::string& path) : m_path(path)
     unz_file_info texture_info;
     unzGetCurrentFileInfo(file, &texture_info, filename.data(), static_cast<u16>(filename.size()),
                           nullptr, 0, nullptr, 0);
+    filename.erase(std::find(filename.begin(), filename.end(), '\0'), filename.end());
 
     if (filename.compare(0, 9, "textures/") != 0 || texture_info.uncompressed_size == 0)
       continue;
@@ -139,63 +145,114 @@ bool ResourcePack::Install(const std::string& path)
     return false;
   }
 
-  auto file = unzOpen(m_path.c_str());
-  Common::ScopeGuard file_guard{[&] { unzClose(file); }};
+  // Check if a higher priority pack already provides a given texture, don't overwrite it
+  std::unordered_set<std::string_view> provided_by_other_packs;
+  for (const auto& pack : GetHigherPriorityPacks(*this))
+    provided_by_other_packs.insert(pack->GetTextures().begin(), pack->GetTextures().end());
 
+  std::unordered_set<std::string_view> textures;
+  std::set<std::string> directories;
   for (const auto& texture : m_textures)
   {
-    bool provided_by_other_pack = false;
-
-    // Check if a higher priority pack already provides a given texture, don't overwrite it
-    for (const auto& pack : GetHigherPriorityPacks(*this))
-    {
-      if (std::find(pack->GetTextures().begin(), pack->GetTextures().end(), texture) !=
-          pack->GetTextures().end())
-      {
-        provided_by_other_pack = true;
-        break;
-      }
-    }
-
-    if (provided_by_other_pack)
+    if (provided_by_other_packs.count(texture) != 0 || !textures.insert(texture).second)
       continue;
 
-    if (unzLocateFile(file, ("textures/" + texture).c_str(), 0) != UNZ_OK)
+    std::string directory;
+    SplitPath(path + TEXTURE_PATH + texture, &directory, nullptr, nullptr);
+    directories.insert(std::move(directory));
+  }
+
+  for (const std::string& directory : directories)
+  {
+    if (!File::CreateFullPath(directory))
     {
-      m_error = "Failed to locate texture " + texture;
+      m_error = "Failed to create full path " + directory;
       return false;
     }
+  }
 
-    const std::string texture_path = path + TEXTURE_PATH + texture;
-    std::string m_full_dir;
-    SplitPath(texture_path, &m_full_dir, nullptr, nullptr);
+  // Textures are decompressed and written by several threads, which each open the pack on their
+  // own and take turns at the textures in the order the zip has them in
+  const size_t thread_count = std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                                                 std::max<size_t>(textures.size(), 1));
+  std::vector<std::string> errors(thread_count);
+
+  const auto extract = [&](size_t thread_index) {
+    std::string& error = errors[thread_index];
 
-    if (!File::CreateFullPath(m_full_dir))
+    auto file = unzOpen(m_path.c_str());
+    Common::ScopeGuard file_guard{[&] { unzClose(file); }};
+    if (file == nullptr)
     {
-      m_error = "Failed to create full path " + m_full_dir;
-      return false;
+      error = "Failed to open resource pack";
+      return;
     }
 
-    unz_file_info texture_info;
-    unzGetCurrentFileInfo(file, &texture_info, nullptr, 0, nullptr, 0, nullptr, 0);
+    std::unordered_set<std::string_view> found;
+    std::string filename(256, '\0');
+    int status = unzGoToFirstFile(file);
+    for (; status == UNZ_OK && error.empty(); status = unzGoToNextFile(file))
+    {
+      unz_file_info texture_info;
+      unzGetCurrentFileInfo(file, &texture_info, filename.data(),
+                            static_cast<u16>(filename.size()), nullptr, 0, nullptr, 0);
+
+      const std::string_view name = filename.c_str();
+      if (name.compare(0, 9, "textures/") != 0 || texture_info.uncompressed_size == 0)
+        continue;
+
+      const auto texture = textures.find(name.substr(9));
+      if (texture == textures.end() || !found.insert(*texture).second)
+        continue;
+      if ((found.size() - 1) % thread_count != thread_index)
+        continue;
+
+      std::vector<char> data(texture_info.uncompressed_size);
+      if (!Common::ReadFileFromZip(file, &data))
+      {
+        error = "Failed to read texture " + std::string(*texture);
+        return;
+      }
 
-    std::vector<char> data(texture_info.uncompressed_size);
-    if (!Common::ReadFileFromZip(file, &data))
+      std::ofstream out(path + TEXTURE_PATH + std::string(*texture),
+                        std::ios::trunc | std::ios::binary);
+      if (!out.good())
+      {
+        error = "Failed to write " + std::string(*texture);
+        return;
+      }
+
+      out.write(data.data(), data.size());
+      out.flush();
+    }
+
+    if (error.empty() && found.size() != textures.size())
     {
-      m_error = "Failed to read texture " + texture;
-      return false;
+      for (const std::string_view texture : textures)
+      {
+        if (found.count(texture) == 0)
+        {
+          error = "Failed to locate texture " + std::string(texture);
+          break;
+        }
+      }
     }
+  };
 
-    std::ofstream out(texture_path, std::ios::trunc | std::ios::binary);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(extract, i);
+  extract(0);
+  for (std::thread& thread : threads)
+    thread.join();
 
-    if (!out.good())
+  for (const std::string& error : errors)
+  {
+    if (!error.empty())
     {
-      m_error = "Failed to write " + texture;
+      m_error = error;
       return false;
     }
-
-    out.write(data.data(), data.size());
-    out.flush();
   }
 
   SetInstalled(*this, true);
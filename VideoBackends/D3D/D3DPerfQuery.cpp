@@ -130,6 +130,11 @@ void PerfQuery::FlushResults()
     FlushOne();
 }
 
+void PerfQuery::PollResults()
+{
+  WeakFlush();
+}
+
 void PerfQuery::WeakFlush()
 {
   while (!IsFlushed())
@@ -38,21 +38,70 @@ std::vector<BBoxType> D3D12BoundingBox::Read(u32 index, u32 length)
   Renderer::GetInstance()->ExecuteCommandList(true);
 
   // Read back to cached values.
+  return ReadMapped(m_readback_buffer.Get(), sizeof(BBoxType) * index, length);
+}
+
+std::vector<BBoxType> D3D12BoundingBox::ReadMapped(ID3D12Resource* buffer, u32 offset, u32 length)
+{
   std::vector<BBoxType> values(length);
-  static constexpr D3D12_RANGE read_range = {0, BUFFER_SIZE};
+  const D3D12_RANGE read_range = {offset, offset + sizeof(BBoxType) * length};
   void* mapped_pointer;
-  HRESULT hr = m_readback_buffer->Map(0, &read_range, &mapped_pointer);
+  HRESULT hr = buffer->Map(0, &read_range, &mapped_pointer);
   ASSERT_MSG(VIDEO, SUCCEEDED(hr), "Map bounding box CPU buffer failed: {}", DX12HRWrap(hr));
   if (FAILED(hr))
     return values;
 
   // Copy out the values we want
-  std::memcpy(values.data(), reinterpret_cast<const u8*>(mapped_pointer) + sizeof(BBoxType) * index,
+  std::memcpy(values.data(), reinterpret_cast<const u8*>(mapped_pointer) + offset,
               sizeof(BBoxType) * length);
 
   static constexpr D3D12_RANGE write_range = {0, 0};
-  m_readback_buffer->Unmap(0, &write_range);
+  buffer->Unmap(0, &write_range);
+
+  return values;
+}
+
+bool D3D12BoundingBox::QueueReadback()
+{
+  if (!m_queued_readback_buffer || m_queued_readback_count == MAX_QUEUED_BBOX_READBACKS)
+    return false;
+
+  const u32 index = (m_queued_readback_head + m_queued_readback_count) % MAX_QUEUED_BBOX_READBACKS;
+  ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
+                  D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+  g_dx_context->GetCommandList()->CopyBufferRegion(m_queued_readback_buffer.Get(),
+                                                   index * BUFFER_SIZE, m_gpu_buffer.Get(), 0,
+                                                   BUFFER_SIZE);
+  ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
+                  D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+  m_queued_readback_fences[index] = g_dx_context->GetCurrentFenceValue();
+  m_queued_readback_count++;
+  return true;
+}
 
+std::optional<std::vector<BBoxType>> D3D12BoundingBox::PollReadback(bool wait)
+{
+  if (m_queued_readback_count == 0)
+    return std::nullopt;
+
+  const u64 fence_value = m_queued_readback_fences[m_queued_readback_head];
+  if (g_dx_context->GetCompletedFenceValue() < fence_value)
+  {
+    if (!wait)
+      return std::nullopt;
+
+    // The copy may not even have been submitted yet
+    if (fence_value == g_dx_context->GetCurrentFenceValue())
+      Renderer::GetInstance()->ExecuteCommandList(true);
+    else
+      g_dx_context->WaitForFence(fence_value);
+  }
+
+  std::vector<BBoxType> values = ReadMapped(m_queued_readback_buffer.Get(),
+                                            m_queued_readback_head * BUFFER_SIZE, NUM_BBOX_VALUES);
+  m_queued_readback_head = (m_queued_readback_head + 1) % MAX_QUEUED_BBOX_READBACKS;
+  m_queued_readback_count--;
   return values;
 }
 
@@ -123,6 +172,14 @@ bool D3D12BoundingBox::CreateBuffers()
   if (!m_upload_buffer.AllocateBuffer(STREAM_BUFFER_SIZE))
     return false;
 
+  // Only needed for readbacks that are allowed to lag, so reads just block without it
+  buffer_desc.Width = BUFFER_SIZE * MAX_QUEUED_BBOX_READBACKS;
+  hr = g_dx_context->GetDevice()->CreateCommittedResource(
+      &cpu_heap_properties, D3D12_HEAP_FLAG_NONE, &buffer_desc, D3D12_RESOURCE_STATE_COPY_DEST,
+      nullptr, IID_PPV_ARGS(&m_queued_readback_buffer));
+  if (FAILED(hr))
+    m_queued_readback_buffer.Reset();
+
   return true;
 }
 };  // namespace DX12
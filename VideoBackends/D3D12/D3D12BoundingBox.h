@@ -23,18 +23,29 @@ protected:
   std::vector<BBoxType> Read(u32 index, u32 length) override;
   void Write(u32 index, const std::vector<BBoxType>& values) override;
 
+  bool QueueReadback() override;
+  std::optional<std::vector<BBoxType>> PollReadback(bool wait) override;
+
 private:
   static constexpr u32 BUFFER_SIZE = sizeof(BBoxType) * NUM_BBOX_VALUES;
   static constexpr u32 MAX_UPDATES_PER_FRAME = 128;
   static constexpr u32 STREAM_BUFFER_SIZE = BUFFER_SIZE * MAX_UPDATES_PER_FRAME;
 
   bool CreateBuffers();
+  std::vector<BBoxType> ReadMapped(ID3D12Resource* buffer, u32 offset, u32 length);
 
   // Three buffers: GPU for read/write, CPU for reading back, and CPU for staging changes.
   ComPtr<ID3D12Resource> m_gpu_buffer;
   ComPtr<ID3D12Resource> m_readback_buffer;
   StreamBuffer m_upload_buffer;
   DescriptorHandle m_gpu_descriptor{};
+
+  // A CPU buffer holding a ring of copies of the values, each with the fence value of the command
+  // list copying it
+  ComPtr<ID3D12Resource> m_queued_readback_buffer;
+  std::array<u64, MAX_QUEUED_BBOX_READBACKS> m_queued_readback_fences{};
+  u32 m_queued_readback_head = 0;
+  u32 m_queued_readback_count = 0;
 };
 
 }  // namespace DX12
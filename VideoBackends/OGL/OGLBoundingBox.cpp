@@ -10,6 +10,13 @@ namespace OGL
 {
 OGLBoundingBox::~OGLBoundingBox()
 {
+  for (; m_readback_count > 0; m_readback_count--)
+  {
+    glDeleteSync(m_readback_fences[m_readback_head]);
+    m_readback_head = (m_readback_head + 1) % MAX_QUEUED_BBOX_READBACKS;
+  }
+  if (m_readback_buffers[0])
+    glDeleteBuffers(MAX_QUEUED_BBOX_READBACKS, m_readback_buffers.data());
   if (m_buffer_id)
     glDeleteBuffers(1, &m_buffer_id);
 }
@@ -23,6 +30,14 @@ bool OGLBoundingBox::Initialize()
   glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(initial_values), initial_values, GL_DYNAMIC_DRAW);
   glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_buffer_id);
 
+  glGenBuffers(MAX_QUEUED_BBOX_READBACKS, m_readback_buffers.data());
+  for (GLuint buffer : m_readback_buffers)
+  {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, sizeof(initial_values), nullptr, GL_STREAM_READ);
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
   return true;
 }
 
@@ -74,4 +89,54 @@ void OGLBoundingBox::Write(u32 index, const std::vector<BBoxType>& values)
   glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
+bool OGLBoundingBox::QueueReadback()
+{
+  if (m_readback_count == MAX_QUEUED_BBOX_READBACKS)
+    return false;
+
+  const u32 index = (m_readback_head + m_readback_count) % MAX_QUEUED_BBOX_READBACKS;
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+  glBindBuffer(GL_COPY_READ_BUFFER, m_buffer_id);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, m_readback_buffers[index]);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                      sizeof(BBoxType) * NUM_BBOX_VALUES);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  m_readback_fences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  m_readback_count++;
+  return true;
+}
+
+std::optional<std::vector<BBoxType>> OGLBoundingBox::PollReadback(bool wait)
+{
+  if (m_readback_count == 0)
+    return std::nullopt;
+
+  GLsync& fence = m_readback_fences[m_readback_head];
+  const GLenum result =
+      glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+  if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+    return std::nullopt;
+
+  glDeleteSync(fence);
+  fence = nullptr;
+
+  // The copy is done, so mapping it doesn't stall
+  std::vector<BBoxType> values(NUM_BBOX_VALUES);
+  glBindBuffer(GL_COPY_READ_BUFFER, m_readback_buffers[m_readback_head]);
+  void* ptr = glMapBufferRange(GL_COPY_READ_BUFFER, 0, sizeof(BBoxType) * NUM_BBOX_VALUES,
+                               GL_MAP_READ_BIT);
+  if (ptr)
+  {
+    std::memcpy(values.data(), ptr, sizeof(BBoxType) * NUM_BBOX_VALUES);
+    glUnmapBuffer(GL_COPY_READ_BUFFER);
+  }
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+  m_readback_head = (m_readback_head + 1) % MAX_QUEUED_BBOX_READBACKS;
+  m_readback_count--;
+  return values;
+}
+
 }  // namespace OGL
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLUtil.h"
 
@@ -21,8 +23,17 @@ protected:
   std::vector<BBoxType> Read(u32 index, u32 length) override;
   void Write(u32 index, const std::vector<BBoxType>& values) override;
 
+  bool QueueReadback() override;
+  std::optional<std::vector<BBoxType>> PollReadback(bool wait) override;
+
 private:
   GLuint m_buffer_id = 0;
+
+  // A ring of copies of the values, each with the fence that tells when its copy is done
+  std::array<GLuint, MAX_QUEUED_BBOX_READBACKS> m_readback_buffers{};
+  std::array<GLsync, MAX_QUEUED_BBOX_READBACKS> m_readback_fences{};
+  u32 m_readback_head = 0;
+  u32 m_readback_count = 0;
 };
 
 }  // namespace OGL
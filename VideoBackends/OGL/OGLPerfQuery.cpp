@@ -51,6 +51,11 @@ void PerfQuery::FlushResults()
   m_query->FlushResults();
 }
 
+void PerfQuery::PollResults()
+{
+  m_query->PollResults();
+}
+
 void PerfQuery::ResetQuery()
 {
   m_query_count.store(0, std::memory_order_relaxed);
@@ -669,6 +669,9 @@ Renderer::Renderer(std::unique_ptr<GLContext> main_gl_context, float backbuffer_
 
   g_ogl_config.bSupportsShaderThreadShuffleNV =
       GLExtensions::Supports("GL_NV_shader_thread_shuffle");
+  g_ogl_config.bSupportsParallelShaderCompile =
+      GLExtensions::Supports("GL_KHR_parallel_shader_compile") ||
+      GLExtensions::Supports("GL_ARB_parallel_shader_compile");
 
   // We require texel buffers, image load store, and compute shaders to enable GPU texture decoding.
   // If the driver doesn't expose the extensions, but supports GL4.3/GLES3.1, it will still be
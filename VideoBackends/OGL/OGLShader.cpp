@@ -3,6 +3,7 @@
 
 #include "VideoBackends/OGL/OGLShader.h"
 
+#include "VideoBackends/OGL/OGLRender.h"
 #include "VideoBackends/OGL/ProgramShaderCache.h"
 
 #include "VideoCommon/VideoConfig.h"
@@ -56,6 +57,30 @@ OGLShader::~OGLShader()
     glDeleteProgram(m_gl_compute_program_id);
 }
 
+bool OGLShader::IsReady() const
+{
+  if (!m_compile_pending)
+    return true;
+
+  GLint completed = GL_FALSE;
+  glGetShaderiv(m_gl_id, GL_COMPLETION_STATUS, &completed);
+  if (completed != GL_TRUE)
+    return false;
+
+  FinishCompile();
+  return true;
+}
+
+bool OGLShader::FinishCompile() const
+{
+  if (m_compile_pending)
+  {
+    m_compile_pending = false;
+    m_compile_failed = !ProgramShaderCache::CheckShaderCompileResult(m_gl_id, m_type, m_source);
+  }
+  return !m_compile_failed;
+}
+
 std::unique_ptr<OGLShader> OGLShader::CreateFromSource(ShaderStage stage, std::string_view source,
                                                        std::string_view name)
 {
@@ -64,6 +89,16 @@ std::unique_ptr<OGLShader> OGLShader::CreateFromSource(ShaderStage stage, std::s
   if (stage != ShaderStage::Compute)
   {
     GLenum shader_type = GetGLShaderTypeForStage(stage);
+    if (g_ogl_config.bSupportsParallelShaderCompile)
+    {
+      // Errors are reported by FinishCompile() once the driver is done with the shader.
+      GLuint shader_id = ProgramShaderCache::SubmitSingleShader(shader_type, source_str);
+      auto shader = std::make_unique<OGLShader>(stage, shader_type, shader_id,
+                                                std::move(source_str), std::move(name_str));
+      shader->m_compile_pending = true;
+      return shader;
+    }
+
     GLuint shader_id = ProgramShaderCache::CompileSingleShader(shader_type, source_str);
     if (!shader_id)
       return nullptr;
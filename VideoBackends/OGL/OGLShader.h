@@ -28,6 +28,11 @@ public:
   GLuint GetGLComputeProgramID() const { return m_gl_compute_program_id; }
   const std::string& GetSource() const { return m_source; }
 
+  bool IsReady() const override;
+  // Waits for a compile that is still running on the driver's threads, reporting any errors.
+  // Returns false if the shader failed to compile.
+  bool FinishCompile() const;
+
   static std::unique_ptr<OGLShader> CreateFromSource(ShaderStage stage, std::string_view source,
                                                      std::string_view name);
 
@@ -38,6 +43,8 @@ private:
   GLuint m_gl_compute_program_id = 0;
   std::string m_source;
   std::string m_name;
+  mutable bool m_compile_pending = false;
+  mutable bool m_compile_failed = false;
 };
 
 }  // namespace OGL
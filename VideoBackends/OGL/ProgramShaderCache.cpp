@@ -299,6 +299,19 @@ bool ProgramShaderCache::CompileComputeShader(SHADER& shader, std::string_view c
 }
 
 GLuint ProgramShaderCache::CompileSingleShader(GLenum type, std::string_view code)
+{
+  const GLuint result = SubmitSingleShader(type, code);
+  if (!CheckShaderCompileResult(result, type, code))
+  {
+    // Don't try to use this shader
+    glDeleteShader(result);
+    return 0;
+  }
+
+  return result;
+}
+
+GLuint ProgramShaderCache::SubmitSingleShader(GLenum type, std::string_view code)
 {
   const GLuint result = glCreateShader(type);
 
@@ -314,14 +327,6 @@ GLuint ProgramShaderCache::CompileSingleShader(GLenum type, std::string_view cod
 
   glShaderSource(result, num_strings, src.data(), src_sizes.data());
   glCompileShader(result);
-
-  if (!CheckShaderCompileResult(result, type, code))
-  {
-    // Don't try to use this shader
-    glDeleteShader(result);
-    return 0;
-  }
-
   return result;
 }
 
@@ -445,10 +450,19 @@ void ProgramShaderCache::Init()
 
   CreateHeader();
   CreateAttributelessVAO();
+  SetCompilerThreads();
 
   CurrentProgram = 0;
 }
 
+void ProgramShaderCache::SetCompilerThreads()
+{
+  // Lets the driver pick how many threads of its own to compile on. Compiles and links then
+  // return straight away, and only asking for their status waits on them.
+  if (g_ogl_config.bSupportsParallelShaderCompile)
+    glMaxShaderCompilerThreads(0xFFFFFFFF);
+}
+
 void ProgramShaderCache::Shutdown()
 {
   s_buffer.reset();
@@ -564,6 +578,16 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
   }
   else
   {
+    // Shaders compiled on the driver's threads report their errors here, rather than as a failed
+    // link.
+    if ((vertex_shader && !vertex_shader->FinishCompile()) ||
+        (geometry_shader && !geometry_shader->FinishCompile()) ||
+        (pixel_shader && !pixel_shader->FinishCompile()))
+    {
+      prog->shader.Destroy();
+      return nullptr;
+    }
+
     // We temporarily change the vertex array to the pipeline's vertex format.
     // This can prevent the NVIDIA OpenGL driver from recompiling on first use.
     GLuint vao = vertex_format ? vertex_format->VAO : s_attributeless_VAO;
@@ -882,6 +906,7 @@ bool SharedContextAsyncShaderCompiler::WorkerThreadInitWorkerThread(void* param)
   }
   if (g_ActiveConfig.backend_info.bSupportsPrimitiveRestart)
     GLUtil::EnablePrimitiveRestart(context);
+  ProgramShaderCache::SetCompilerThreads();
 
   return true;
 }
@@ -76,6 +76,8 @@ public:
 
   static bool CompileComputeShader(SHADER& shader, std::string_view code);
   static GLuint CompileSingleShader(GLenum type, std::string_view code);
+  // Starts compiling without waiting for the result. CheckShaderCompileResult() waits for it.
+  static GLuint SubmitSingleShader(GLenum type, std::string_view code);
   static bool CheckShaderCompileResult(GLuint id, GLenum type, std::string_view code);
   static bool CheckProgramLinkResult(GLuint id, std::string_view vcode, std::string_view pcode,
                                      std::string_view gcode);
@@ -87,6 +89,8 @@ public:
   static void Init();
   static void Shutdown();
   static void CreateHeader();
+  // Must be called on every context that compiles shaders.
+  static void SetCompilerThreads();
 
   // This counter increments with each shader object allocated, in order to give it a unique ID.
   // Since the shaders can be destroyed after a pipeline is created, we can't use the shader pointer
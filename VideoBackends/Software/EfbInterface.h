@@ -58,5 +58,6 @@ void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>
 
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
-void IncPerfCounterQuadCount(PerfQueryType type);
+// Counts count pixels at once.
+void IncPerfCounterQuadCount(PerfQueryType type, u32 count = 1);
 }  // namespace EfbInterface
@@ -4,11 +4,13 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
@@ -96,19 +98,58 @@ struct Slope
   }
 };
 
+// Everything needed to rasterize a triangle once it has been binned
+struct Triangle
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Half-edge constants and deltas, in 28.4 fixed point
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, clipped to the scissor
+  s32 minx, maxx, miny, maxy;
+};
+
+// Triangles are binned into bands of this many rows, which are drawn in parallel. A pixel is only
+// ever drawn by the band it's in, and each band draws its triangles in the order they were
+// binned, so every pixel still sees the triangles in submission order.
+static constexpr s32 BAND_HEIGHT = 16;
+static constexpr u32 NUM_BANDS = (EFB_HEIGHT + BAND_HEIGHT - 1) / BAND_HEIGHT;
+// Batches covering fewer pixels than this are cheaper to draw on this thread than to hand out
+static constexpr u64 MIN_PARALLEL_PIXELS = 0x4000;
+// Bounds the memory used by the binned triangles of huge batches
+static constexpr size_t MAX_BINNED_TRIANGLES = 0x4000;
+
+struct Band
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  std::vector<u32> triangles;
+  u32 rasterizedPixels = 0;
+  // One more than the index of the last triangle that this band passed a pixel of to the Tev
+  u32 lastTevTriangle = 0;
+};
+
 static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
 
-static Tev tev;
-static RasterBlock rasterBlock;
+static std::vector<Triangle> s_triangles;
+static u64 s_binned_pixels = 0;
+static std::array<Band, NUM_BANDS> s_bands;
+// The Tev of this band drew the last pixel, so it holds the leftover values that the next pixel
+// may read (see Tev::ReadsPreviousPixel). Batches drawn on one thread use it.
+static u32 s_serial_band = 0;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
 void Init()
 {
-  tev.Init();
+  for (Band& band : s_bands)
+    band.tev.Init();
 
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
@@ -144,29 +185,33 @@ static inline int iround(float x)
 
 void SetTevReg(int reg, int comp, s16 color)
 {
-  tev.SetRegColor(reg, comp, color);
+  for (Band& band : s_bands)
+    band.tev.SetRegColor(reg, comp, color);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(Band& band, const Triangle& tri, u32 index, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  Tev& tev = band.tev;
+  const RasterBlock& rasterBlock = band.rasterBlock;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  band.rasterizedPixels++;
+
+  s32 z = (s32)std::clamp<float>(tri.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.UseEarlyDepthTest())
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    tev.PerfQuadCounts[PQ_ZCOMP_INPUT_ZCOMPLOC]++;
     if (bpmem.zmode.testenable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    tev.PerfQuadCounts[PQ_ZCOMP_OUTPUT_ZCOMPLOC]++;
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -177,7 +222,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)tri.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -206,10 +251,12 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     tev.TextureLinear[i] = rasterBlock.TextureLinear[i];
   }
 
+  band.lastTevTriangle = index + 1;
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -220,9 +267,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -260,7 +307,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const Triangle& tri, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -271,19 +318,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / tri.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = tri.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = tri.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = tri.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -296,7 +343,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texcoord = indref & 3;
     indref >>= 3;
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -308,7 +356,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -325,34 +374,22 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+// Draws the part of a binned triangle that lies within rows top to bottom
+static void DrawTriangle(Band& band, u32 index, s32 top, s32 bottom)
 {
-  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
-  // zfreeze depends on it
-  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
+  const Triangle& tri = s_triangles[index];
 
-  // adapted from http://devmaster.net/posts/6145/advanced-rasterization
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
 
-  // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
-  // could also take floor and adjust -8
-  const s32 Y1 = iround(16.0f * (v0->screenPosition.y - scissor.y_off)) - 9;
-  const s32 Y2 = iround(16.0f * (v1->screenPosition.y - scissor.y_off)) - 9;
-  const s32 Y3 = iround(16.0f * (v2->screenPosition.y - scissor.y_off)) - 9;
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
 
-  const s32 X1 = iround(16.0f * (v0->screenPosition.x - scissor.x_off)) - 9;
-  const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
-  const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
-
-  // Deltas
-  const s32 DX12 = X1 - X2;
-  const s32 DX23 = X2 - X3;
-  const s32 DX31 = X3 - X1;
-
-  const s32 DY12 = Y1 - Y2;
-  const s32 DY23 = Y2 - Y3;
-  const s32 DY31 = Y3 - Y1;
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
 
   // Fixed-pos32 deltas
   const s32 FDX12 = DX12 * 16;
@@ -363,68 +400,21 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 FDY23 = DY23 * 16;
   const s32 FDY31 = DY31 * 16;
 
-  // Bounding rectangle
-  s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
-  s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
-  s32 miny = (std::min(std::min(Y1, Y2), Y3) + 0xF) >> 4;
-  s32 maxy = (std::max(std::max(Y1, Y2), Y3) + 0xF) >> 4;
-
-  // scissor
-  ASSERT(scissor.rect.left >= 0);
-  ASSERT(scissor.rect.right <= EFB_WIDTH);
-  ASSERT(scissor.rect.top >= 0);
-  ASSERT(scissor.rect.bottom <= EFB_HEIGHT);
-
-  minx = std::max(minx, scissor.rect.left);
-  maxx = std::min(maxx, scissor.rect.right);
-  miny = std::max(miny, scissor.rect.top);
-  maxy = std::min(maxy, scissor.rect.bottom);
-
-  if (minx >= maxx || miny >= maxy)
-    return;
-
-  // Set up the remaining slopes
-  const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
-                         scissor.y_off);
-
-  float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
-                1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
-
-  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
-  {
-    for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
-  }
-
-  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
-  {
-    for (int comp = 0; comp < 3; comp++)
-    {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
-    }
-  }
-
-  // Half-edge constants
-  s32 C1 = DY12 * X1 - DX12 * Y1;
-  s32 C2 = DY23 * X2 - DX23 * Y2;
-  s32 C3 = DY31 * X3 - DX31 * Y3;
-
-  // Correct for fill convention
-  if (DY12 < 0 || (DY12 == 0 && DX12 > 0))
-    C1++;
-  if (DY23 < 0 || (DY23 == 0 && DX23 > 0))
-    C2++;
-  if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
-    C3++;
+  const s32 minx = tri.minx;
+  const s32 maxx = tri.maxx;
+  const s32 miny = tri.miny;
+  const s32 maxy = tri.maxy;
 
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
 
+  // Bands are made of whole blocks, so this doesn't change which blocks are visited
+  const s32 block_top = std::max(block_miny, top);
+  const s32 block_bottom = std::min(maxy, bottom);
+
   // Loop through blocks
-  for (s32 y = block_miny & ~(BLOCK_SIZE - 1); y < maxy; y += BLOCK_SIZE)
+  for (s32 y = block_top; y < block_bottom; y += BLOCK_SIZE)
   {
     for (s32 x = block_minx; x < maxx; x += BLOCK_SIZE)
     {
@@ -460,7 +450,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(band.rasterBlock, tri, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -470,7 +460,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(band, tri, index, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -493,7 +483,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(band, tri, index, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -510,6 +500,181 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+static void DrawBand(u32 band_index)
+{
+  Band& band = s_bands[band_index];
+  const s32 top = s32(band_index) * BAND_HEIGHT;
+  const s32 bottom = top + BAND_HEIGHT;
+
+  for (u32 index : band.triangles)
+    DrawTriangle(band, index, top, bottom);
+}
+
+void Flush()
+{
+  if (s_triangles.empty())
+    return;
+
+  u32 bands_used = 0;
+  for (const Band& band : s_bands)
+    bands_used += !band.triangles.empty();
+
+  // The TEV stage dumps share one buffer, and the pixels can't be drawn out of order if the TEV
+  // reads what the previous pixel left behind
+  const bool parallel = g_ActiveConfig.bSWParallelRasterization && bands_used > 1 &&
+                        s_binned_pixels >= MIN_PARALLEL_PIXELS &&
+                        !g_ActiveConfig.bDumpTevStages && !g_ActiveConfig.bDumpTevTextureFetches &&
+                        !Tev::ReadsPreviousPixel();
+
+  if (parallel)
+  {
+    Common::TaskGroup group;
+    for (u32 i = 0; i < NUM_BANDS; ++i)
+    {
+      if (!s_bands[i].triangles.empty())
+        group.Submit([i] { DrawBand(i); });
+    }
+    group.Wait();
+
+    // In submission order, the last pixel comes from the last triangle that reached the Tev, and
+    // from the last band it reached the Tev in
+    u32 last_triangle = 0;
+    for (u32 i = 0; i < NUM_BANDS; ++i)
+    {
+      if (s_bands[i].lastTevTriangle != 0 && s_bands[i].lastTevTriangle >= last_triangle)
+      {
+        last_triangle = s_bands[i].lastTevTriangle;
+        s_serial_band = i;
+      }
+    }
+  }
+  else
+  {
+    Band& band = s_bands[s_serial_band];
+    for (u32 index = 0; index < s_triangles.size(); ++index)
+      DrawTriangle(band, index, 0, EFB_HEIGHT);
+  }
+
+  for (Band& band : s_bands)
+  {
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, band.rasterizedPixels);
+    band.rasterizedPixels = 0;
+    band.lastTevTriangle = 0;
+    band.triangles.clear();
+    band.tev.FlushCounters();
+  }
+
+  s_triangles.clear();
+  s_binned_pixels = 0;
+}
+
+static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
+                                  const OutputVertexData* v2,
+                                  const BPFunctions::ScissorRect& scissor)
+{
+  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
+  // zfreeze depends on it
+  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
+
+  // adapted from http://devmaster.net/posts/6145/advanced-rasterization
+
+  // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
+  // could also take floor and adjust -8
+  const s32 Y1 = iround(16.0f * (v0->screenPosition.y - scissor.y_off)) - 9;
+  const s32 Y2 = iround(16.0f * (v1->screenPosition.y - scissor.y_off)) - 9;
+  const s32 Y3 = iround(16.0f * (v2->screenPosition.y - scissor.y_off)) - 9;
+
+  const s32 X1 = iround(16.0f * (v0->screenPosition.x - scissor.x_off)) - 9;
+  const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
+  const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
+
+  // Bounding rectangle
+  s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
+  s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
+  s32 miny = (std::min(std::min(Y1, Y2), Y3) + 0xF) >> 4;
+  s32 maxy = (std::max(std::max(Y1, Y2), Y3) + 0xF) >> 4;
+
+  // scissor
+  ASSERT(scissor.rect.left >= 0);
+  ASSERT(scissor.rect.right <= static_cast<s32>(EFB_WIDTH));
+  ASSERT(scissor.rect.top >= 0);
+  ASSERT(scissor.rect.bottom <= static_cast<s32>(EFB_HEIGHT));
+
+  minx = std::max(minx, scissor.rect.left);
+  maxx = std::min(maxx, scissor.rect.right);
+  miny = std::max(miny, scissor.rect.top);
+  maxy = std::min(maxy, scissor.rect.bottom);
+
+  if (minx >= maxx || miny >= maxy)
+    return;
+
+  const u32 index = static_cast<u32>(s_triangles.size());
+  Triangle& tri = s_triangles.emplace_back();
+  tri.ZSlope = ZSlope;
+
+  tri.minx = minx;
+  tri.maxx = maxx;
+  tri.miny = miny;
+  tri.maxy = maxy;
+
+  // Deltas
+  tri.DX12 = X1 - X2;
+  tri.DX23 = X2 - X3;
+  tri.DX31 = X3 - X1;
+
+  tri.DY12 = Y1 - Y2;
+  tri.DY23 = Y2 - Y3;
+  tri.DY31 = Y3 - Y1;
+
+  // Set up the remaining slopes
+  const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
+                         scissor.y_off);
+
+  float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
+                1.0f / v2->projectedPosition.w};
+  tri.WSlope = Slope(w[0], w[1], w[2], ctx);
+
+  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
+  {
+    for (int comp = 0; comp < 4; comp++)
+    {
+      tri.ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
+  }
+
+  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
+  {
+    for (int comp = 0; comp < 3; comp++)
+    {
+      tri.TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                                     v2->texCoords[i][comp] * w[2], ctx);
+    }
+  }
+
+  // Half-edge constants
+  tri.C1 = tri.DY12 * X1 - tri.DX12 * Y1;
+  tri.C2 = tri.DY23 * X2 - tri.DX23 * Y2;
+  tri.C3 = tri.DY31 * X3 - tri.DX31 * Y3;
+
+  // Correct for fill convention
+  if (tri.DY12 < 0 || (tri.DY12 == 0 && tri.DX12 > 0))
+    tri.C1++;
+  if (tri.DY23 < 0 || (tri.DY23 == 0 && tri.DX23 > 0))
+    tri.C2++;
+  if (tri.DY31 < 0 || (tri.DY31 == 0 && tri.DX31 > 0))
+    tri.C3++;
+
+  // Bin the triangle into every band that its blocks touch
+  const s32 block_miny = miny & ~(BLOCK_SIZE - 1);
+  for (s32 band = block_miny / BAND_HEIGHT; band <= (maxy - 1) / BAND_HEIGHT; ++band)
+    s_bands[band].triangles.push_back(index);
+  s_binned_pixels += u64(maxx - minx) * u64(maxy - miny);
+
+  if (s_triangles.size() >= MAX_BINNED_TRIANGLES)
+    Flush();
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
@@ -14,8 +14,12 @@ void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
                   const OutputVertexData* v2, s32 x_off, s32 y_off);
+// Triangles are only binned here, and drawn by Flush.
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+// Draws the binned triangles. This must be done before the pixel pipeline state that they're
+// drawn with changes, or the EFB is accessed in any other way.
+void Flush();
 
 void SetTevReg(int reg, int comp, s16 color);
 
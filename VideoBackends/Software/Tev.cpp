@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <iterator>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -160,6 +161,79 @@ void Tev::Init()
   m_ScaleRShiftLUT[1] = 0;
   m_ScaleRShiftLUT[2] = 0;
   m_ScaleRShiftLUT[3] = 1;
+
+  ResetCounters();
+}
+
+void Tev::ResetCounters()
+{
+  PixelsIn = 0;
+  PixelsOut = 0;
+  std::fill(std::begin(PerfQuadCounts), std::end(PerfQuadCounts), 0);
+
+  BBox[0] = 0xffff;
+  BBox[1] = 0;
+  BBox[2] = 0xffff;
+  BBox[3] = 0;
+}
+
+void Tev::FlushCounters()
+{
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, PixelsIn);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, PixelsOut);
+
+  for (u32 i = 0; i < PQ_NUM_MEMBERS; ++i)
+  {
+    if (PerfQuadCounts[i] != 0)
+      EfbInterface::IncPerfCounterQuadCount(static_cast<PerfQueryType>(i), PerfQuadCounts[i]);
+  }
+
+  if (PixelsOut != 0)
+    BBoxManager::Update(BBox[0], BBox[1], BBox[2], BBox[3]);
+
+  ResetCounters();
+}
+
+bool Tev::ReadsPreviousPixel()
+{
+  // The indirect texture coordinate of the previous stage is kept from the last pixel
+  if (bpmem.tevind[0].fb_addprev)
+    return true;
+
+  bool tex_color_set = false;
+  for (u32 stage = 0; stage <= bpmem.genMode.numtevstages; ++stage)
+  {
+    // Indirect stages that aren't enabled keep the texel that was sampled for the last pixel
+    const TevStageIndirect& indirect = bpmem.tevind[stage];
+    if (indirect.bt >= bpmem.genMode.numindstages &&
+        (indirect.bs != IndTexBumpAlpha::Off || indirect.matrix_index != IndMtxIndex::Off))
+    {
+      return true;
+    }
+
+    // So do the texture colors of stages that don't sample a texture
+    if (bpmem.tevorders[stage >> 1].getEnable(stage & 1))
+    {
+      tex_color_set = true;
+      continue;
+    }
+    if (tex_color_set)
+      continue;
+
+    const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stage].colorC;
+    const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stage].alphaC;
+    const auto reads_tex_color = [](TevColorArg arg) {
+      return arg == TevColorArg::TexColor || arg == TevColorArg::TexAlpha;
+    };
+    if (reads_tex_color(cc.a) || reads_tex_color(cc.b) || reads_tex_color(cc.c) ||
+        reads_tex_color(cc.d) || ac.a == TevAlphaArg::TexAlpha || ac.b == TevAlphaArg::TexAlpha ||
+        ac.c == TevAlphaArg::TexAlpha || ac.d == TevAlphaArg::TexAlpha)
+    {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 static inline s16 Clamp255(s16 in)
@@ -543,7 +617,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  ++PixelsIn;
 
   // initial color values
   for (int i = 0; i < 4; i++)
@@ -843,18 +917,20 @@ void Tev::Draw()
   if (bpmem.UseLateDepthTest())
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    ++PerfQuadCounts[PQ_ZCOMP_INPUT];
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    ++PerfQuadCounts[PQ_ZCOMP_OUTPUT];
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  BBox[0] = std::min(BBox[0], static_cast<u16>(Position[0] & ~1));
+  BBox[1] = std::max(BBox[1], static_cast<u16>(Position[0] | 1));
+  BBox[2] = std::min(BBox[2], static_cast<u16>(Position[1] & ~1));
+  BBox[3] = std::max(BBox[3], static_cast<u16>(Position[1] | 1));
 
 #if ALLOW_TEV_DUMPS
   if (g_ActiveConfig.bDumpTevStages)
@@ -876,8 +952,8 @@ void Tev::Draw()
   }
 #endif
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  ++PixelsOut;
+  ++PerfQuadCounts[PQ_BLEND_INPUT];
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -65,6 +67,8 @@ class Tev
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
+  void ResetCounters();
+
 public:
   s32 Position[3];
   u8 Color[2][4];  // must be RGBA for correct swap table ordering
@@ -74,6 +78,13 @@ public:
   s32 TextureLod[16];
   bool TextureLinear[16];
 
+  // Several Tevs can draw at once, so Draw counts into these instead of updating the statistics,
+  // perf queries and bounding box directly. FlushCounters applies them and starts over.
+  u32 PixelsIn;
+  u32 PixelsOut;
+  u32 PerfQuadCounts[PQ_NUM_MEMBERS];
+  u16 BBox[4];
+
   enum
   {
     ALP_C,
@@ -85,6 +96,11 @@ public:
   void Init();
 
   void Draw();
+  void FlushCounters();
+
+  // Whether Draw may read values that were left over from the previous pixel it drew, in which
+  // case the pixels have to be drawn in order by a single Tev.
+  static bool ReadsPreviousPixel();
 
   void SetRegColor(int reg, int comp, s16 color);
 };
@@ -3,10 +3,14 @@
 
 #include "VideoBackends/Software/TextureEncoder.h"
 
+#include <cstring>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 
@@ -1418,6 +1422,313 @@ static void EncodeZ24halfscale(u8* dst, const u8* src, EFBCopyFormat format)
   }
 }
 
+#ifdef _M_X86_64
+// Vectorized encoders for the most common copy formats. Each one encodes a whole row of a block at
+// once, with a texel in each 32-bit lane laid out the way the scalar code reads it with *(u32*)src.
+
+// Reads exactly four pixels, so the last row of the EFB doesn't read past its end
+FUNCTION_TARGET_SSSE3
+static inline __m128i LoadBytes12(const u8* src)
+{
+  u32 last;
+  std::memcpy(&last, src + 8, sizeof(last));
+  return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)),
+                            _mm_cvtsi32_si128(last));
+}
+
+FUNCTION_TARGET_SSSE3
+static inline __m128i LoadPixels4(const u8* src)
+{
+  return _mm_shuffle_epi8(LoadBytes12(src),
+                          _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+}
+
+FUNCTION_TARGET_SSSE3
+static inline __m128i Field(__m128i pixels, int shift, int mask)
+{
+  return _mm_and_si128(_mm_srli_epi32(pixels, shift), _mm_set1_epi32(mask));
+}
+
+// Convert6To8 on a 6-bit value in each lane
+FUNCTION_TARGET_SSSE3
+static inline __m128i Expand6To8(__m128i value)
+{
+  return _mm_or_si128(_mm_slli_epi32(value, 2), _mm_srli_epi32(value, 4));
+}
+
+// RGB8_to_I on 8-bit values in each lane. Every product fits in the low half of its lane.
+FUNCTION_TARGET_SSSE3
+static inline __m128i RGB8ToI(__m128i r, __m128i g, __m128i b)
+{
+  __m128i val = _mm_add_epi32(_mm_set1_epi32(4096), _mm_mullo_epi16(r, _mm_set1_epi32(66)));
+  val = _mm_add_epi32(val, _mm_mullo_epi16(g, _mm_set1_epi32(129)));
+  val = _mm_add_epi32(val, _mm_mullo_epi16(b, _mm_set1_epi32(25)));
+  return _mm_srli_epi32(val, 8);
+}
+
+// Stores the low 16 bits of each lane, byteswapped like Common::swap16
+FUNCTION_TARGET_SSSE3
+static inline void StoreSwap16x4(u8* dst, __m128i values)
+{
+  const __m128i packed = _mm_shuffle_epi8(
+      values, _mm_setr_epi8(1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packed);
+}
+
+FUNCTION_TARGET_SSSE3
+static inline void Store16x4(u8* dst, __m128i values)
+{
+  const __m128i packed = _mm_shuffle_epi8(
+      values, _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packed);
+}
+
+// Stores the low 8 bits of each lane of both
+FUNCTION_TARGET_SSSE3
+static inline void Store8x8(u8* dst, __m128i first, __m128i second)
+{
+  const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(first, second), _mm_setzero_si128());
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packed);
+}
+
+// Takes the AR pairs from the low halves and the GB pairs from the high halves of the lanes, and
+// stores them in their halves of the RGBA8 block
+FUNCTION_TARGET_SSSE3
+static inline void StoreRGBA8(u8* dst, __m128i values)
+{
+  const __m128i packed = _mm_shuffle_epi8(
+      values, _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packed);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 32), _mm_srli_si128(packed, 8));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA6ToRGB565(u8* dst, const u8* src)
+{
+  const __m128i pixels = LoadPixels4(src);
+  StoreSwap16x4(dst, _mm_or_si128(Field(pixels, 8, 0xf800), Field(pixels, 7, 0x07ff)));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA6ToRGB5A3(u8* dst, const u8* src)
+{
+  const __m128i pixels = LoadPixels4(src);
+  const __m128i alpha = _mm_and_si128(_mm_slli_epi32(pixels, 9), _mm_set1_epi32(0x7000));
+  const __m128i opaque = _mm_cmpeq_epi32(alpha, _mm_set1_epi32(0x7000));
+
+  const __m128i rgb555 = _mm_or_si128(
+      _mm_or_si128(_mm_set1_epi32(0x8000), Field(pixels, 9, 0x7c00)),
+      _mm_or_si128(Field(pixels, 8, 0x03e0), Field(pixels, 7, 0x001f)));
+  const __m128i rgba4443 =
+      _mm_or_si128(_mm_or_si128(alpha, Field(pixels, 12, 0x0f00)),
+                   _mm_or_si128(Field(pixels, 10, 0x00f0), Field(pixels, 8, 0x000f)));
+  StoreSwap16x4(dst,
+                _mm_or_si128(_mm_and_si128(opaque, rgb555), _mm_andnot_si128(opaque, rgba4443)));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA6ToRGBA8(u8* dst, const u8* src)
+{
+  // Spread a, r, g and b out to a byte each, then expand all of them at once. Shifting the 16-bit
+  // halves left can't carry between bytes, as every value fits in 6 bits.
+  const __m128i pixels = LoadPixels4(src);
+  const __m128i values = _mm_or_si128(
+      _mm_or_si128(Field(pixels, 0, 0x3f), _mm_slli_epi32(Field(pixels, 18, 0x3f), 8)),
+      _mm_or_si128(_mm_slli_epi32(Field(pixels, 12, 0x3f), 16),
+                   _mm_slli_epi32(Field(pixels, 6, 0x3f), 24)));
+  StoreRGBA8(dst, _mm_or_si128(_mm_slli_epi16(values, 2),
+                               _mm_and_si128(_mm_srli_epi16(values, 4), _mm_set1_epi8(0x03))));
+}
+
+FUNCTION_TARGET_SSSE3
+static inline __m128i RGBA6ToI(__m128i pixels)
+{
+  return RGB8ToI(Expand6To8(Field(pixels, 18, 0x3f)), Expand6To8(Field(pixels, 12, 0x3f)),
+                 Expand6To8(Field(pixels, 6, 0x3f)));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA6ToI8(u8* dst, const u8* src)
+{
+  Store8x8(dst, RGBA6ToI(LoadPixels4(src)), RGBA6ToI(LoadPixels4(src + 12)));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA6ToIA8(u8* dst, const u8* src)
+{
+  const __m128i pixels = LoadPixels4(src);
+  const __m128i alpha = Expand6To8(Field(pixels, 0, 0x3f));
+  Store16x4(dst, _mm_or_si128(alpha, _mm_slli_epi32(RGBA6ToI(pixels), 8)));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB8ToRGB565(u8* dst, const u8* src)
+{
+  const __m128i pixels = LoadPixels4(src);
+  StoreSwap16x4(dst, _mm_or_si128(_mm_or_si128(Field(pixels, 8, 0xf800), Field(pixels, 5, 0x07e0)),
+                                  Field(pixels, 3, 0x001f)));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB8ToRGB5A3(u8* dst, const u8* src)
+{
+  const __m128i pixels = LoadPixels4(src);
+  const __m128i red = _mm_or_si128(_mm_set1_epi32(0x8000), Field(pixels, 9, 0x7c00));
+  StoreSwap16x4(dst, _mm_or_si128(red, _mm_or_si128(Field(pixels, 6, 0x03e0),
+                                                    Field(pixels, 3, 0x001f))));
+}
+
+// Also encodes Z24 to RGBA8, with the depth taking the place of the color
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB8ToRGBA8(u8* dst, const u8* src)
+{
+  const __m128i bytes = _mm_shuffle_epi8(
+      LoadBytes12(src), _mm_setr_epi8(-1, 2, -1, 5, -1, 8, -1, 11, 1, 0, 4, 3, 7, 6, 10, 9));
+  const __m128i alpha = _mm_setr_epi8(-1, 0, -1, 0, -1, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i packed = _mm_or_si128(bytes, alpha);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packed);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 32), _mm_srli_si128(packed, 8));
+}
+
+FUNCTION_TARGET_SSSE3
+static inline __m128i RGB8ToI(__m128i pixels)
+{
+  return RGB8ToI(Field(pixels, 16, 0xff), Field(pixels, 8, 0xff), Field(pixels, 0, 0xff));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB8ToI8(u8* dst, const u8* src)
+{
+  Store8x8(dst, RGB8ToI(LoadPixels4(src)), RGB8ToI(LoadPixels4(src + 12)));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB8ToIA8(u8* dst, const u8* src)
+{
+  Store16x4(dst, _mm_or_si128(_mm_set1_epi32(0xff), _mm_slli_epi32(RGB8ToI(LoadPixels4(src)), 8)));
+}
+
+// Also encodes the top 8 bits of Z24
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB8ToR8(u8* dst, const u8* src)
+{
+  const __m128i red = _mm_setr_epi8(2, 5, 8, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i first = _mm_shuffle_epi8(LoadBytes12(src), red);
+  const __m128i second = _mm_shuffle_epi8(LoadBytes12(src + 12), red);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi32(first, second));
+}
+
+// Walks the blocks in the same order as ENCODE_LOOP_BLOCKS. Each row of a block takes up row_size
+// bytes of dst, and block_gap more are skipped after every block.
+template <void (*EncodeRow)(u8* dst, const u8* src)>
+FUNCTION_TARGET_SSSE3 static void EncodeBlockRows(u8* dst, const u8* src, int blkWidthLog2,
+                                                  int blkHeightLog2, u32 row_size, u32 block_gap)
+{
+  u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
+  SetBlockDimensions(blkWidthLog2, blkHeightLog2, &sBlkCount, &tBlkCount, &sBlkSize, &tBlkSize);
+  const s32 writeStride = bpmem.copyMipMapStrideChannels * 32;
+  constexpr u32 readStride = 3;
+  u8* dstBlockStart = dst;
+
+  for (int tBlk = 0; tBlk < tBlkCount; tBlk++)
+  {
+    dst = dstBlockStart;
+    for (int sBlk = 0; sBlk < sBlkCount; sBlk++)
+    {
+      const u8* block = src + (tBlk * tBlkSize * 640 + sBlk * sBlkSize) * readStride;
+      for (int t = 0; t < tBlkSize; t++)
+      {
+        EncodeRow(dst, block + t * 640 * readStride);
+        dst += row_size;
+      }
+      dst += block_gap;
+    }
+    dstBlockStart += writeStride;
+  }
+}
+
+// Returns false if there is no vectorized encoder for the copy
+static bool EncodeSSSE3(u8* dst, const u8* src, PixelFormat efb_format, EFBCopyFormat format,
+                        bool yuv)
+{
+  switch (efb_format)
+  {
+  case PixelFormat::RGBA6_Z24:
+    switch (format)
+    {
+    case EFBCopyFormat::R8_0x1:
+    case EFBCopyFormat::R8:
+      if (!yuv)
+        return false;
+      EncodeBlockRows<EncodeRowRGBA6ToI8>(dst, src, 3, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RA8:
+      if (!yuv)
+        return false;
+      EncodeBlockRows<EncodeRowRGBA6ToIA8>(dst, src, 2, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RGB565:
+      EncodeBlockRows<EncodeRowRGBA6ToRGB565>(dst, src, 2, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RGB5A3:
+      EncodeBlockRows<EncodeRowRGBA6ToRGB5A3>(dst, src, 2, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RGBA8:
+      EncodeBlockRows<EncodeRowRGBA6ToRGBA8>(dst, src, 2, 2, 8, 32);
+      return true;
+    default:
+      return false;
+    }
+
+  case PixelFormat::RGB8_Z24:
+  case PixelFormat::RGB565_Z16:
+    switch (format)
+    {
+    case EFBCopyFormat::R8_0x1:
+    case EFBCopyFormat::R8:
+      if (yuv)
+        EncodeBlockRows<EncodeRowRGB8ToI8>(dst, src, 3, 2, 8, 0);
+      else
+        EncodeBlockRows<EncodeRowRGB8ToR8>(dst, src, 3, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RA8:
+      if (!yuv)
+        return false;
+      EncodeBlockRows<EncodeRowRGB8ToIA8>(dst, src, 2, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RGB565:
+      EncodeBlockRows<EncodeRowRGB8ToRGB565>(dst, src, 2, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RGB5A3:
+      EncodeBlockRows<EncodeRowRGB8ToRGB5A3>(dst, src, 2, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RGBA8:
+      EncodeBlockRows<EncodeRowRGB8ToRGBA8>(dst, src, 2, 2, 8, 32);
+      return true;
+    default:
+      return false;
+    }
+
+  case PixelFormat::Z24:
+    switch (format)
+    {
+    case EFBCopyFormat::R8_0x1:
+    case EFBCopyFormat::R8:
+      EncodeBlockRows<EncodeRowRGB8ToR8>(dst, src, 3, 2, 8, 0);
+      return true;
+    case EFBCopyFormat::RGBA8:
+      EncodeBlockRows<EncodeRowRGB8ToRGBA8>(dst, src, 2, 2, 8, 32);
+      return true;
+    default:
+      return false;
+    }
+
+  default:
+    return false;
+  }
+}
+#endif
+
 namespace
 {
 void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
@@ -1448,6 +1759,11 @@ void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 b
   }
   else
   {
+#ifdef _M_X86_64
+    if (cpu_info.bSSSE3 && EncodeSSSE3(dst, src, params.efb_format, params.copy_format, params.yuv))
+      return;
+#endif
+
     switch (params.efb_format)
     {
     case PixelFormat::RGBA6_Z24:
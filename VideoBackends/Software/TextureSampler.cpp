@@ -5,6 +5,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#if defined(_M_X86) || defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
 
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
@@ -51,6 +55,31 @@ static inline void WrapCoord(int* coordp, WrapMode wrap_mode, int image_size)
   *coordp = coord;
 }
 
+#if defined(_M_X86) || defined(_M_X86_64)
+// Multiplies the channels of texel a by fract_a and those of texel b by fract_b, and adds them up
+// into one 32-bit sum per channel. The fractions must fit in 15 bits.
+static inline __m128i WeightTexels(const u8* a, const u8* b, u32 fract_a, u32 fract_b)
+{
+  u32 a32, b32;
+  std::memcpy(&a32, a, sizeof(u32));
+  std::memcpy(&b32, b, sizeof(u32));
+
+  // Interleaving the channels of both texels lets a single multiply-add do all the work
+  const __m128i texels = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(a32), _mm_cvtsi32_si128(b32)), _mm_setzero_si128());
+  return _mm_madd_epi16(texels, _mm_set1_epi32(static_cast<s32>(fract_b << 16 | fract_a)));
+}
+
+static inline void StoreTexel(__m128i texel, int shift, u8* outTexel)
+{
+  texel = _mm_srl_epi32(texel, _mm_cvtsi32_si128(shift));
+  texel = _mm_packs_epi32(texel, texel);
+  texel = _mm_packus_epi16(texel, texel);
+
+  const u32 value = static_cast<u32>(_mm_cvtsi128_si32(texel));
+  std::memcpy(outTexel, &value, sizeof(u32));
+}
+#else
 static inline void SetTexel(const u8* inTexel, u32* outTexel, u32 fract)
 {
   outTexel[0] = inTexel[0] * fract;
@@ -66,6 +95,7 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[2] += inTexel[2] * fract;
   outTexel[3] += inTexel[3] * fract;
 }
+#endif
 
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 {
@@ -91,19 +121,22 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 
   if (mipLinear)
   {
-    u8 sampledTex[4];
-    u32 texel[4];
+    u8 sampledTex[2][4];
+    SampleMip(s, t, baseMip, linear, texmap, sampledTex[0]);
+    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex[1]);
 
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
-    SetTexel(sampledTex, texel, (16 - lodFract));
-
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
-    AddTexel(sampledTex, texel, lodFract);
+#if defined(_M_X86) || defined(_M_X86_64)
+    StoreTexel(WeightTexels(sampledTex[0], sampledTex[1], 16 - lodFract, lodFract), 4, sample);
+#else
+    u32 texel[4];
+    SetTexel(sampledTex[0], texel, (16 - lodFract));
+    AddTexel(sampledTex[1], texel, lodFract);
 
     sample[0] = (u8)(texel[0] >> 4);
     sample[1] = (u8)(texel[1] >> 4);
     sample[2] = (u8)(texel[2] >> 4);
     sample[3] = (u8)(texel[3] >> 4);
+#endif
   }
   else
 #endif
@@ -188,55 +221,51 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
-
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
     WrapCoord(&imageSPlus1, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageTPlus1, tm0.wrap_t, image_height_minus_1 + 1);
 
+    // Fetch all four texels before filtering them
+    const int tapS[4] = {imageS, imageSPlus1, imageS, imageSPlus1};
+    const int tapT[4] = {imageT, imageT, imageTPlus1, imageTPlus1};
+    u8 sampledTex[4][4];
+
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
     {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
+      for (int i = 0; i < 4; i++)
+      {
+        TexDecoder_DecodeTexel(sampledTex[i], imageSrc, tapS[i], tapT[i], image_width_minus_1,
+                               texfmt, tlut, tlutfmt);
+      }
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
-                                          image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
-                                          imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
+      for (int i = 0; i < 4; i++)
+      {
+        TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[i], imageSrc, imageSrcOdd, tapS[i], tapT[i],
+                                            image_width_minus_1);
+      }
     }
 
+#if defined(_M_X86) || defined(_M_X86_64)
+    const __m128i top = WeightTexels(sampledTex[0], sampledTex[1], (128 - fractS) * (128 - fractT),
+                                     (fractS) * (128 - fractT));
+    const __m128i bottom = WeightTexels(sampledTex[2], sampledTex[3], (128 - fractS) * (fractT),
+                                        (fractS) * (fractT));
+    StoreTexel(_mm_add_epi32(top, bottom), 14, sample);
+#else
+    u32 texel[4];
+    SetTexel(sampledTex[0], texel, (128 - fractS) * (128 - fractT));
+    AddTexel(sampledTex[1], texel, (fractS) * (128 - fractT));
+    AddTexel(sampledTex[2], texel, (128 - fractS) * (fractT));
+    AddTexel(sampledTex[3], texel, (fractS) * (fractT));
+
     sample[0] = (u8)(texel[0] >> 14);
     sample[1] = (u8)(texel[1] >> 14);
     sample[2] = (u8)(texel[2] >> 14);
     sample[3] = (u8)(texel[3] >> 14);
+#endif
   }
   else
   {
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <type_traits>
 
 #include "Common/Assert.h"
@@ -12,6 +13,7 @@
 #include "Common/FileUtil.h"
 #include "Common/LinearDiskCache.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
 
 #include "Core/ConfigManager.h"
 
@@ -25,13 +27,19 @@
 
 namespace Vulkan
 {
+// How often new pipelines are written to disk
+constexpr std::chrono::seconds PIPELINE_CACHE_SAVE_INTERVAL{30};
+
 std::unique_ptr<ObjectCache> g_object_cache;
 
 ObjectCache::ObjectCache() = default;
 
 ObjectCache::~ObjectCache()
 {
+  StopPipelineCacheSaveThread();
   DestroyPipelineCache();
+  for (VkPipelineCache shard : m_retired_pipeline_cache_shards)
+    vkDestroyPipelineCache(g_vulkan_context->GetDevice(), shard, nullptr);
   DestroySamplers();
   DestroyPipelineLayouts();
   DestroyDescriptorSetLayouts();
@@ -62,6 +70,7 @@ bool ObjectCache::Initialize()
   {
     if (!LoadPipelineCache())
       return false;
+    StartPipelineCacheSaveThread();
   }
   else
   {
@@ -74,6 +83,7 @@ bool ObjectCache::Initialize()
 
 void ObjectCache::Shutdown()
 {
+  StopPipelineCacheSaveThread();
   if (g_ActiveConfig.bShaderCache && m_pipeline_cache != VK_NULL_HANDLE)
     SavePipelineCache();
 }
@@ -467,22 +477,7 @@ bool ObjectCache::CreatePipelineCache()
   // This assumes that drivers don't create all pipelines in the cache on load time, only
   // when a lookup occurs that matches a pipeline (or pipeline data) in the cache.
   m_pipeline_cache_filename = GetDiskShaderCacheFileName(APIType::Vulkan, "Pipeline", false, true);
-
-  VkPipelineCacheCreateInfo info = {
-      VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,  // VkStructureType            sType
-      nullptr,                                       // const void*                pNext
-      0,                                             // VkPipelineCacheCreateFlags flags
-      0,                                             // size_t                     initialDataSize
-      nullptr                                        // const void*                pInitialData
-  };
-
-  VkResult res =
-      vkCreatePipelineCache(g_vulkan_context->GetDevice(), &info, nullptr, &m_pipeline_cache);
-  if (res == VK_SUCCESS)
-    return true;
-
-  LOG_VULKAN_ERROR(res, "vkCreatePipelineCache failed: ");
-  return false;
+  return CreatePipelineCaches({});
 }
 
 bool ObjectCache::LoadPipelineCache()
@@ -501,25 +496,74 @@ bool ObjectCache::LoadPipelineCache()
   {
     // Don't use this data. In fact, we should delete it to prevent it from being used next time.
     File::Delete(m_pipeline_cache_filename);
-    return CreatePipelineCache();
+    return CreatePipelineCaches({});
   }
 
+  if (CreatePipelineCaches(disk_data))
+    return true;
+
+  // Failed to create pipeline cache, try with it empty.
+  WARN_LOG_FMT(VIDEO, "Failed to create pipeline cache from disk data, trying empty cache");
+  return CreatePipelineCaches({});
+}
+
+static VkPipelineCache CreatePipelineCacheObject(const std::vector<u8>& initial_data)
+{
   VkPipelineCacheCreateInfo info = {
       VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,  // VkStructureType            sType
       nullptr,                                       // const void*                pNext
       0,                                             // VkPipelineCacheCreateFlags flags
-      disk_data.size(),                              // size_t                     initialDataSize
-      disk_data.data()                               // const void*                pInitialData
+      initial_data.size(),                           // size_t                     initialDataSize
+      initial_data.data()                            // const void*                pInitialData
   };
 
-  VkResult res =
-      vkCreatePipelineCache(g_vulkan_context->GetDevice(), &info, nullptr, &m_pipeline_cache);
-  if (res == VK_SUCCESS)
-    return true;
+  VkPipelineCache cache = VK_NULL_HANDLE;
+  VkResult res = vkCreatePipelineCache(g_vulkan_context->GetDevice(), &info, nullptr, &cache);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreatePipelineCache failed: ");
+    return VK_NULL_HANDLE;
+  }
 
-  // Failed to create pipeline cache, try with it empty.
-  LOG_VULKAN_ERROR(res, "vkCreatePipelineCache failed, trying empty cache: ");
-  return CreatePipelineCache();
+  return cache;
+}
+
+bool ObjectCache::CreatePipelineCaches(const std::vector<u8>& initial_data)
+{
+  m_pipeline_cache = CreatePipelineCacheObject(initial_data);
+  if (m_pipeline_cache == VK_NULL_HANDLE)
+    return false;
+
+  // A pipeline is only looked up in the cache it's created with, so every shard starts out with
+  // what was loaded from disk. The video thread and each compiler thread can have one of their
+  // own, up to a limit, since every shard holds a copy of that data.
+  const u32 compiler_threads = std::max(g_ActiveConfig.GetShaderCompilerThreads(),
+                                        g_ActiveConfig.GetShaderPrecompilerThreads());
+  const size_t shard_count = std::min<size_t>(compiler_threads + 1, MAX_PIPELINE_CACHE_SHARDS);
+  for (size_t i = 0; i < shard_count; ++i)
+  {
+    const VkPipelineCache shard = CreatePipelineCacheObject(initial_data);
+    if (shard == VK_NULL_HANDLE)
+    {
+      DestroyPipelineCache();
+      return false;
+    }
+    m_pipeline_cache_shard_list.push_back(shard);
+  }
+
+  for (size_t i = 0; i < MAX_PIPELINE_CACHE_SHARDS; ++i)
+    m_pipeline_cache_shards[i] = m_pipeline_cache_shard_list[i % shard_count];
+
+  m_saved_pipeline_cache_size = initial_data.size();
+  return true;
+}
+
+VkPipelineCache ObjectCache::GetPipelineCache() const
+{
+  // Threads are handed shards in the order they first ask for one
+  static std::atomic<size_t> s_next_shard{0};
+  thread_local const size_t shard = s_next_shard++ % MAX_PIPELINE_CACHE_SHARDS;
+  return m_pipeline_cache_shards[shard].load(std::memory_order_relaxed);
 }
 
 // Based on Vulkan 1.0 specification,
@@ -590,10 +634,29 @@ void ObjectCache::DestroyPipelineCache()
 {
   vkDestroyPipelineCache(g_vulkan_context->GetDevice(), m_pipeline_cache, nullptr);
   m_pipeline_cache = VK_NULL_HANDLE;
+
+  // Other threads can't be creating pipelines anymore when this is called from the destructor,
+  // but they can when the caches are reloaded
+  m_retired_pipeline_cache_shards.insert(m_retired_pipeline_cache_shards.end(),
+                                         m_pipeline_cache_shard_list.begin(),
+                                         m_pipeline_cache_shard_list.end());
+  m_pipeline_cache_shard_list.clear();
 }
 
 void ObjectCache::SavePipelineCache()
 {
+  std::lock_guard lk(m_pipeline_cache_save_mutex);
+
+  // The shards are only read by merging, so the other threads can keep creating pipelines
+  if (!m_pipeline_cache_shard_list.empty())
+  {
+    VkResult res = vkMergePipelineCaches(
+        g_vulkan_context->GetDevice(), m_pipeline_cache,
+        static_cast<u32>(m_pipeline_cache_shard_list.size()), m_pipeline_cache_shard_list.data());
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkMergePipelineCaches failed: ");
+  }
+
   size_t data_size;
   VkResult res =
       vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size, nullptr);
@@ -603,6 +666,10 @@ void ObjectCache::SavePipelineCache()
     return;
   }
 
+  // Caches only grow, so there's nothing new to save if the size is still the same
+  if (data_size == m_saved_pipeline_cache_size)
+    return;
+
   std::vector<u8> data(data_size);
   res = vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size,
                                data.data());
@@ -612,26 +679,67 @@ void ObjectCache::SavePipelineCache()
     return;
   }
 
-  // Delete the old cache and re-create.
-  File::Delete(m_pipeline_cache_filename);
+  // The new cache is written next to the old one, which it then replaces, so that a crash while
+  // saving doesn't leave a cache that's cut off behind.
+  const std::string temp_filename = m_pipeline_cache_filename + ".tmp";
+  File::Delete(temp_filename, File::IfAbsentBehavior::NoConsoleWarning);
 
   // We write a single key of 1, with the entire pipeline cache data.
   // Not ideal, but our disk cache class does not support just writing a single blob
   // of data without specifying a key.
   LinearDiskCache<u32, u8> disk_cache;
   PipelineCacheReadIgnoreCallback callback;
-  disk_cache.OpenAndRead(m_pipeline_cache_filename, callback);
+  disk_cache.OpenAndRead(temp_filename, callback);
   disk_cache.Append(1, data.data(), static_cast<u32>(data.size()));
   disk_cache.Close();
+
+  if (!File::RenameSync(temp_filename, m_pipeline_cache_filename))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to replace pipeline cache {}", m_pipeline_cache_filename);
+    return;
+  }
+  m_saved_pipeline_cache_size = data_size;
 }
 
 void ObjectCache::ReloadPipelineCache()
 {
+  StopPipelineCacheSaveThread();
   SavePipelineCache();
+  DestroyPipelineCache();
 
   if (g_ActiveConfig.bShaderCache)
+  {
     LoadPipelineCache();
+    StartPipelineCacheSaveThread();
+  }
   else
+  {
     CreatePipelineCache();
+  }
+}
+
+void ObjectCache::StartPipelineCacheSaveThread()
+{
+  if (m_pipeline_cache == VK_NULL_HANDLE)
+    return;
+
+  m_pipeline_cache_save_thread_exit.Reset();
+  m_pipeline_cache_save_thread = std::thread(&ObjectCache::PipelineCacheSaveThread, this);
+}
+
+void ObjectCache::StopPipelineCacheSaveThread()
+{
+  if (!m_pipeline_cache_save_thread.joinable())
+    return;
+
+  m_pipeline_cache_save_thread_exit.Set();
+  m_pipeline_cache_save_thread.join();
+}
+
+void ObjectCache::PipelineCacheSaveThread()
+{
+  Common::SetCurrentThreadName("Vulkan pipeline cache saver");
+  while (!m_pipeline_cache_save_thread_exit.WaitFor(PIPELINE_CACHE_SAVE_INTERVAL))
+    SavePipelineCache();
 }
 }  // namespace Vulkan
@@ -4,14 +4,19 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
 #include "Common/LinearDiskCache.h"
 
 #include "VideoBackends/Vulkan/Constants.h"
@@ -63,13 +68,16 @@ public:
                              VkAttachmentLoadOp load_op);
 
   // Pipeline cache. Used when creating pipelines for drivers to store compiled programs.
-  VkPipelineCache GetPipelineCache() const { return m_pipeline_cache; }
+  // Threads that create pipelines are spread over several caches, so that the compiler threads
+  // don't all contend for one.
+  VkPipelineCache GetPipelineCache() const;
 
   // Clear sampler cache, use when anisotropy mode changes
   // WARNING: Ensure none of the objects from here are in use when calling
   void ClearSamplerCache();
 
-  // Saves the pipeline cache to disk. Call when shutting down.
+  // Merges the pipeline caches and saves them to disk. This also happens periodically while the
+  // shader cache is enabled, so that a crash doesn't lose all pipelines of the session.
   void SavePipelineCache();
 
   // Reload pipeline cache. Call when host config changes.
@@ -85,8 +93,12 @@ private:
   void DestroyRenderPassCache();
   bool CreatePipelineCache();
   bool LoadPipelineCache();
+  bool CreatePipelineCaches(const std::vector<u8>& initial_data);
   bool ValidatePipelineCache(const u8* data, size_t data_length);
   void DestroyPipelineCache();
+  void StartPipelineCacheSaveThread();
+  void StopPipelineCacheSaveThread();
+  void PipelineCacheSaveThread();
 
   std::array<VkDescriptorSetLayout, NUM_DESCRIPTOR_SET_LAYOUTS> m_descriptor_set_layouts = {};
   std::array<VkPipelineLayout, NUM_PIPELINE_LAYOUTS> m_pipeline_layouts = {};
@@ -106,8 +118,21 @@ private:
   std::map<RenderPassCacheKey, VkRenderPass> m_render_pass_cache;
 
   // pipeline cache
+  static constexpr size_t MAX_PIPELINE_CACHE_SHARDS = 4;
+
+  // The cache that is saved, which the shards are merged into. Only saving touches it.
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
+  // Every slot is filled, with shards repeating if fewer were created. Compiler threads can still
+  // be using the shards of the previous host config when the caches are reloaded, so those are
+  // kept until shutdown.
+  std::array<std::atomic<VkPipelineCache>, MAX_PIPELINE_CACHE_SHARDS> m_pipeline_cache_shards{};
+  std::vector<VkPipelineCache> m_pipeline_cache_shard_list;
+  std::vector<VkPipelineCache> m_retired_pipeline_cache_shards;
   std::string m_pipeline_cache_filename;
+  size_t m_saved_pipeline_cache_size = 0;
+  std::mutex m_pipeline_cache_save_mutex;
+  std::thread m_pipeline_cache_save_thread;
+  Common::Event m_pipeline_cache_save_thread_exit;
 };
 
 extern std::unique_ptr<ObjectCache> g_object_cache;
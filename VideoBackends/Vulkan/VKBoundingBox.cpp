@@ -39,6 +39,23 @@ bool VKBoundingBox::Initialize()
 }
 
 std::vector<BBoxType> VKBoundingBox::Read(u32 index, u32 length)
+{
+  CopyToReadbackBuffer(m_readback_buffer.get());
+
+  // Wait until these commands complete.
+  Renderer::GetInstance()->ExecuteCommandBuffer(false, true);
+
+  // Cache is now valid.
+  m_readback_buffer->InvalidateCPUCache();
+
+  // Read out the values and return
+  std::vector<BBoxType> values(length);
+  m_readback_buffer->Read(index * sizeof(BBoxType), values.data(), length * sizeof(BBoxType),
+                          false);
+  return values;
+}
+
+void VKBoundingBox::CopyToReadbackBuffer(StagingBuffer* readback_buffer)
 {
   // Can't be done within a render pass.
   StateTracker::GetInstance()->EndRenderPass();
@@ -48,33 +65,72 @@ std::vector<BBoxType> VKBoundingBox::Read(u32 index, u32 length)
       g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer,
       VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, 0,
       BUFFER_SIZE, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-  m_readback_buffer->PrepareForGPUWrite(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT);
+  readback_buffer->PrepareForGPUWrite(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                                      VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
   // Copy from GPU -> readback buffer.
   VkBufferCopy region = {0, 0, BUFFER_SIZE};
   vkCmdCopyBuffer(g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer,
-                  m_readback_buffer->GetBuffer(), 1, &region);
+                  readback_buffer->GetBuffer(), 1, &region);
 
   // Restore GPU buffer access.
   StagingBuffer::BufferMemoryBarrier(
       g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer, VK_ACCESS_TRANSFER_READ_BIT,
       VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, 0, BUFFER_SIZE,
       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-  m_readback_buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                                   VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+  readback_buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                                 VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+}
 
-  // Wait until these commands complete.
-  Renderer::GetInstance()->ExecuteCommandBuffer(false, true);
+bool VKBoundingBox::QueueReadback()
+{
+  if (m_queued_readback_count == MAX_QUEUED_BBOX_READBACKS)
+    return false;
 
-  // Cache is now valid.
-  m_readback_buffer->InvalidateCPUCache();
+  const u32 index = (m_queued_readback_head + m_queued_readback_count) % MAX_QUEUED_BBOX_READBACKS;
+  std::unique_ptr<StagingBuffer>& readback_buffer = m_queued_readback_buffers[index];
+  if (!readback_buffer)
+  {
+    readback_buffer = StagingBuffer::Create(STAGING_BUFFER_TYPE_READBACK, BUFFER_SIZE,
+                                            VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    if (!readback_buffer || !readback_buffer->Map())
+    {
+      readback_buffer.reset();
+      return false;
+    }
+  }
 
-  // Read out the values and return
-  std::vector<BBoxType> values(length);
-  m_readback_buffer->Read(index * sizeof(BBoxType), values.data(), length * sizeof(BBoxType),
-                          false);
+  CopyToReadbackBuffer(readback_buffer.get());
+  m_queued_readback_fences[index] = g_command_buffer_mgr->GetCurrentFenceCounter();
+  m_queued_readback_count++;
+  return true;
+}
+
+std::optional<std::vector<BBoxType>> VKBoundingBox::PollReadback(bool wait)
+{
+  if (m_queued_readback_count == 0)
+    return std::nullopt;
+
+  const u64 fence_counter = m_queued_readback_fences[m_queued_readback_head];
+  if (g_command_buffer_mgr->GetCompletedFenceCounter() < fence_counter)
+  {
+    if (!wait)
+      return std::nullopt;
+
+    // The copy may not even have been submitted yet
+    if (fence_counter == g_command_buffer_mgr->GetCurrentFenceCounter())
+      Renderer::GetInstance()->ExecuteCommandBuffer(false, true);
+    else
+      g_command_buffer_mgr->WaitForFenceCounter(fence_counter);
+  }
+
+  StagingBuffer* readback_buffer = m_queued_readback_buffers[m_queued_readback_head].get();
+  readback_buffer->InvalidateCPUCache();
+  std::vector<BBoxType> values(NUM_BBOX_VALUES);
+  readback_buffer->Read(0, values.data(), BUFFER_SIZE, false);
+
+  m_queued_readback_head = (m_queued_readback_head + 1) % MAX_QUEUED_BBOX_READBACKS;
+  m_queued_readback_count--;
   return values;
 }
 
@@ -27,9 +27,13 @@ protected:
   std::vector<BBoxType> Read(u32 index, u32 length) override;
   void Write(u32 index, const std::vector<BBoxType>& values) override;
 
+  bool QueueReadback() override;
+  std::optional<std::vector<BBoxType>> PollReadback(bool wait) override;
+
 private:
   bool CreateGPUBuffer();
   bool CreateReadbackBuffer();
+  void CopyToReadbackBuffer(StagingBuffer* readback_buffer);
 
   VkBuffer m_gpu_buffer = VK_NULL_HANDLE;
   VkDeviceMemory m_gpu_memory = VK_NULL_HANDLE;
@@ -37,6 +41,12 @@ private:
   static constexpr size_t BUFFER_SIZE = sizeof(BBoxType) * NUM_BBOX_VALUES;
 
   std::unique_ptr<StagingBuffer> m_readback_buffer;
+
+  // A ring of copies of the values, each with the fence counter of the command buffer copying it
+  std::array<std::unique_ptr<StagingBuffer>, MAX_QUEUED_BBOX_READBACKS> m_queued_readback_buffers;
+  std::array<u64, MAX_QUEUED_BBOX_READBACKS> m_queued_readback_fences{};
+  u32 m_queued_readback_head = 0;
+  u32 m_queued_readback_count = 0;
 };
 
 }  // namespace Vulkan
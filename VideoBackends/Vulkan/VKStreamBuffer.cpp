@@ -6,17 +6,21 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <optional>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
+#include "VideoCommon/Statistics.h"
 
 namespace Vulkan
 {
-StreamBuffer::StreamBuffer(VkBufferUsageFlags usage, u32 size) : m_usage(usage), m_size(size)
+StreamBuffer::StreamBuffer(VkBufferUsageFlags usage, u32 size, u32 max_size)
+    : m_usage(usage), m_size(size), m_max_size(std::max(size, max_size))
 {
 }
 
@@ -31,9 +35,10 @@ StreamBuffer::~StreamBuffer()
     g_command_buffer_mgr->DeferDeviceMemoryDestruction(m_memory);
 }
 
-std::unique_ptr<StreamBuffer> StreamBuffer::Create(VkBufferUsageFlags usage, u32 size)
+std::unique_ptr<StreamBuffer> StreamBuffer::Create(VkBufferUsageFlags usage, u32 size,
+                                                   u32 max_size)
 {
-  std::unique_ptr<StreamBuffer> buffer = std::make_unique<StreamBuffer>(usage, size);
+  std::unique_ptr<StreamBuffer> buffer = std::make_unique<StreamBuffer>(usage, size, max_size);
   if (!buffer->AllocateBuffer())
     return nullptr;
 
@@ -67,9 +72,22 @@ bool StreamBuffer::AllocateBuffer()
   VkMemoryRequirements memory_requirements;
   vkGetBufferMemoryRequirements(g_vulkan_context->GetDevice(), buffer, &memory_requirements);
 
-  // Aim for a coherent mapping if possible.
-  u32 memory_type_index = g_vulkan_context->GetUploadMemoryType(memory_requirements.memoryTypeBits,
-                                                                &m_coherent_mapping);
+  // Writing straight into VRAM saves the GPU from pulling the data over the bus on every draw
+  // that reads it, so take device-local memory where the host can see it. Otherwise aim for a
+  // coherent mapping if possible.
+  u32 memory_type_index;
+  if (const std::optional<u32> device_local_type_index =
+          g_vulkan_context->GetDeviceLocalUploadMemoryType(memory_requirements.memoryTypeBits,
+                                                           memory_requirements.size))
+  {
+    memory_type_index = *device_local_type_index;
+    m_coherent_mapping = true;
+  }
+  else
+  {
+    memory_type_index = g_vulkan_context->GetUploadMemoryType(memory_requirements.memoryTypeBits,
+                                                              &m_coherent_mapping);
+  }
 
   // Allocate memory for backing this buffer
   VkMemoryAllocateInfo memory_allocate_info = {
@@ -181,6 +199,13 @@ bool StreamBuffer::ReserveMemory(u32 num_bytes, u32 alignment)
     }
   }
 
+  // Growing is cheaper than waiting for the GPU to catch up, as long as there is room to grow
+  if (m_size < m_max_size && Grow())
+  {
+    m_last_allocation_size = num_bytes;
+    return true;
+  }
+
   // Can we find a fence to wait on that will give us enough memory?
   if (WaitForClearSpace(required_bytes))
   {
@@ -195,6 +220,24 @@ bool StreamBuffer::ReserveMemory(u32 num_bytes, u32 alignment)
   return false;
 }
 
+bool StreamBuffer::Grow()
+{
+  const u32 old_size = m_size;
+  m_size = std::min(m_size * 2, m_max_size);
+  if (!AllocateBuffer())
+  {
+    // Don't try again, what's there still works with waits
+    WARN_LOG_FMT(VIDEO, "Failed to grow a stream buffer to {} bytes", m_size);
+    m_size = old_size;
+    m_max_size = old_size;
+    return false;
+  }
+
+  INFO_LOG_FMT(VIDEO, "Grew a stream buffer from {} to {} bytes", old_size, m_size);
+  INCSTAT(g_stats.this_frame.num_stream_buffer_grows);
+  return true;
+}
+
 void StreamBuffer::CommitMemory(u32 final_num_bytes)
 {
   ASSERT((m_current_offset + final_num_bytes) <= m_size);
@@ -316,6 +359,7 @@ bool StreamBuffer::WaitForClearSpace(u32 num_bytes)
   }
 
   // Wait until this fence is signaled. This will fire the callback, updating the GPU position.
+  INCSTAT(g_stats.this_frame.num_stream_buffer_fence_waits);
   g_command_buffer_mgr->WaitForFenceCounter(iter->first);
   m_tracked_fences.erase(m_tracked_fences.begin(),
                          m_current_offset == iter->second ? m_tracked_fences.end() : ++iter);
@@ -16,7 +16,7 @@ namespace Vulkan
 class StreamBuffer
 {
 public:
-  StreamBuffer(VkBufferUsageFlags usage, u32 size);
+  StreamBuffer(VkBufferUsageFlags usage, u32 size, u32 max_size);
   ~StreamBuffer();
 
   VkBuffer GetBuffer() const { return m_buffer; }
@@ -28,10 +28,15 @@ public:
   bool ReserveMemory(u32 num_bytes, u32 alignment);
   void CommitMemory(u32 final_num_bytes);
 
-  static std::unique_ptr<StreamBuffer> Create(VkBufferUsageFlags usage, u32 size);
+  // A buffer given a max_size larger than size doubles instead of waiting for the GPU, until it
+  // reaches max_size. This replaces the VkBuffer, so whatever was bound from the old one has to
+  // be bound again, while commands already recorded keep using the old one until they finish.
+  static std::unique_ptr<StreamBuffer> Create(VkBufferUsageFlags usage, u32 size,
+                                              u32 max_size = 0);
 
 private:
   bool AllocateBuffer();
+  bool Grow();
   void UpdateCurrentFencePosition();
   void UpdateGPUPosition();
 
@@ -40,6 +45,7 @@ private:
 
   VkBufferUsageFlags m_usage;
   u32 m_size;
+  u32 m_max_size;
   u32 m_current_offset = 0;
   u32 m_current_gpu_position = 0;
   u32 m_last_allocation_size = 0;
@@ -25,6 +25,9 @@
 
 namespace Vulkan
 {
+// How many times larger than they start the stream buffers may get
+static constexpr u32 MAX_STREAM_BUFFER_GROWTH = 4;
+
 static VkBufferView CreateTexelBufferView(VkBuffer buffer, VkFormat vk_format)
 {
   // Create a view of the whole buffer, we'll offset our texel load into it
@@ -61,12 +64,17 @@ bool VertexManager::Initialize()
   if (!VertexManagerBase::Initialize())
     return false;
 
+  // These grow rather than have the GPU thread wait on the GPU. The texel buffer can't, as its
+  // views are made once.
   m_vertex_stream_buffer =
-      StreamBuffer::Create(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VERTEX_STREAM_BUFFER_SIZE);
+      StreamBuffer::Create(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VERTEX_STREAM_BUFFER_SIZE,
+                           VERTEX_STREAM_BUFFER_SIZE * MAX_STREAM_BUFFER_GROWTH);
   m_index_stream_buffer =
-      StreamBuffer::Create(VK_BUFFER_USAGE_INDEX_BUFFER_BIT, INDEX_STREAM_BUFFER_SIZE);
+      StreamBuffer::Create(VK_BUFFER_USAGE_INDEX_BUFFER_BIT, INDEX_STREAM_BUFFER_SIZE,
+                           INDEX_STREAM_BUFFER_SIZE * MAX_STREAM_BUFFER_GROWTH);
   m_uniform_stream_buffer =
-      StreamBuffer::Create(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, UNIFORM_STREAM_BUFFER_SIZE);
+      StreamBuffer::Create(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, UNIFORM_STREAM_BUFFER_SIZE,
+                           UNIFORM_STREAM_BUFFER_SIZE * MAX_STREAM_BUFFER_GROWTH);
   if (!m_vertex_stream_buffer || !m_index_stream_buffer || !m_uniform_stream_buffer)
   {
     PanicAlertFmt("Failed to allocate streaming buffers");
@@ -149,6 +157,7 @@ void VertexManager::ResetBuffer(u32 vertex_stride)
   {
     // Flush any pending commands first, so that we can wait on the fences
     WARN_LOG_FMT(VIDEO, "Executing command list while waiting for space in vertex/index buffer");
+    INCSTAT(g_stats.this_frame.num_stream_buffer_submits);
     Renderer::GetInstance()->ExecuteCommandBuffer(false);
 
     // Attempt to allocate again, this may cause a fence wait
@@ -245,14 +254,21 @@ void VertexManager::UpdatePixelShaderConstants()
 
 bool VertexManager::ReserveConstantStorage()
 {
+  const VkBuffer buffer = m_uniform_stream_buffer->GetBuffer();
   if (m_uniform_stream_buffer->ReserveMemory(m_uniform_buffer_reserve_size,
                                              g_vulkan_context->GetUniformBufferAlignment()))
   {
-    return true;
+    if (m_uniform_stream_buffer->GetBuffer() == buffer)
+      return true;
+
+    // The buffer grew, which leaves the other stages bound to the old one
+    UploadAllConstants();
+    return false;
   }
 
   // The only places that call constant updates are safe to have state restored.
   WARN_LOG_FMT(VIDEO, "Executing command buffer while waiting for space in uniform buffer");
+  INCSTAT(g_stats.this_frame.num_stream_buffer_submits);
   Renderer::GetInstance()->ExecuteCommandBuffer(false);
 
   // Since we are on a new command buffer, all constants have been invalidated, and we need
@@ -319,6 +335,7 @@ void VertexManager::UploadUtilityUniforms(const void* data, u32 data_size)
                                               g_vulkan_context->GetUniformBufferAlignment()))
   {
     WARN_LOG_FMT(VIDEO, "Executing command buffer while waiting for ext space in uniform buffer");
+    INCSTAT(g_stats.this_frame.num_stream_buffer_submits);
     Renderer::GetInstance()->ExecuteCommandBuffer(false);
   }
 
@@ -340,6 +357,7 @@ bool VertexManager::UploadTexelBuffer(const void* data, u32 data_size, TexelBuff
   {
     // Try submitting cmdbuffer.
     WARN_LOG_FMT(VIDEO, "Submitting command buffer while waiting for space in texel buffer");
+    INCSTAT(g_stats.this_frame.num_stream_buffer_submits);
     Renderer::GetInstance()->ExecuteCommandBuffer(false, false);
     if (!m_texel_stream_buffer->ReserveMemory(data_size, elem_size))
     {
@@ -370,6 +388,7 @@ bool VertexManager::UploadTexelBuffer(const void* data, u32 data_size, TexelBuff
   {
     // Try submitting cmdbuffer.
     WARN_LOG_FMT(VIDEO, "Submitting command buffer while waiting for space in texel buffer");
+    INCSTAT(g_stats.this_frame.num_stream_buffer_submits);
     Renderer::GetInstance()->ExecuteCommandBuffer(false, false);
     if (!m_texel_stream_buffer->ReserveMemory(reserve_size, elem_size))
     {
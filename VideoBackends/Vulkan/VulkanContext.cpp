@@ -815,6 +815,30 @@ u32 VulkanContext::GetUploadMemoryType(u32 bits, bool* is_coherent)
   return 0;
 }
 
+std::optional<u32> VulkanContext::GetDeviceLocalUploadMemoryType(u32 bits, VkDeviceSize size)
+{
+  static constexpr VkMemoryPropertyFlags FLAGS = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+  // Without resizable BAR, only a 256 MiB window of VRAM is host-visible, and the driver needs it
+  // for itself. A heap that large is only taken when it has plenty of room left over.
+  static constexpr VkDeviceSize BAR_WINDOW_SIZE = 256 * 1024 * 1024;
+
+  for (u32 i = 0; i < m_device_memory_properties.memoryTypeCount; i++)
+  {
+    const VkMemoryType& type = m_device_memory_properties.memoryTypes[i];
+    if ((bits & (1 << i)) == 0 || (type.propertyFlags & FLAGS) != FLAGS)
+      continue;
+
+    const VkDeviceSize heap_size = m_device_memory_properties.memoryHeaps[type.heapIndex].size;
+    if (heap_size > BAR_WINDOW_SIZE && heap_size >= size * 8)
+      return i;
+  }
+
+  return std::nullopt;
+}
+
 u32 VulkanContext::GetReadbackMemoryType(u32 bits, bool* is_coherent)
 {
   std::optional<u32> type_index;
@@ -105,6 +105,9 @@ public:
 
   // Finds a memory type for upload or readback buffers.
   u32 GetUploadMemoryType(u32 bits, bool* is_coherent = nullptr);
+  // Finds host-visible device-local memory for a buffer of size bytes the host only writes to,
+  // as with resizable BAR or a unified memory architecture. Always coherent.
+  std::optional<u32> GetDeviceLocalUploadMemoryType(u32 bits, VkDeviceSize size);
   u32 GetReadbackMemoryType(u32 bits, bool* is_coherent = nullptr);
 
   // Returns true if the specified extension is supported and enabled.
@@ -30,6 +30,10 @@ public:
   using BinaryData = std::vector<u8>;
   virtual BinaryData GetBinary() const { return {}; }
 
+  // Backends that leave compiling to the driver's own threads return false until the driver is
+  // done. Never blocks.
+  virtual bool IsReady() const { return true; }
+
 protected:
   ShaderStage m_stage;
 };
@@ -4,9 +4,14 @@
 #include "VideoCommon/AbstractTexture.h"
 
 #include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/Image.h"
+#include "Common/ImageWriter.h"
 #include "Common/MsgHandler.h"
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/RenderBase.h"
@@ -19,7 +24,7 @@ void AbstractTexture::FinishedRendering()
 {
 }
 
-bool AbstractTexture::Save(const std::string& filename, unsigned int level)
+std::unique_ptr<AbstractStagingTexture> AbstractTexture::ReadBack(unsigned int level)
 {
   // We can't dump compressed textures currently (it would mean drawing them to a RGBA8
   // framebuffer, and saving that). TextureCache does not call Save for custom textures
@@ -38,7 +43,7 @@ bool AbstractTexture::Save(const std::string& filename, unsigned int level)
   auto readback_texture =
       g_renderer->CreateStagingTexture(StagingTextureType::Readback, readback_texture_config);
   if (!readback_texture)
-    return false;
+    return nullptr;
 
   // Copy to the readback texture's buffer.
   readback_texture->CopyFromTexture(this, 0, level);
@@ -46,14 +51,47 @@ bool AbstractTexture::Save(const std::string& filename, unsigned int level)
 
   // Map it so we can encode it to the file.
   if (!readback_texture->Map())
+    return nullptr;
+
+  return readback_texture;
+}
+
+bool AbstractTexture::Save(const std::string& filename, unsigned int level)
+{
+  const std::unique_ptr<AbstractStagingTexture> readback_texture = ReadBack(level);
+  if (!readback_texture)
     return false;
 
+  const TextureConfig& config = readback_texture->GetConfig();
   return Common::SavePNG(filename,
                          reinterpret_cast<const u8*>(readback_texture->GetMappedPointer()),
-                         Common::ImageByteFormat::RGBA, level_width, level_height,
+                         Common::ImageByteFormat::RGBA, config.width, config.height,
                          static_cast<int>(readback_texture->GetMappedStride()));
 }
 
+bool AbstractTexture::Save(Common::ImageWriter& writer, const std::string& filename,
+                           unsigned int level, int compression_level)
+{
+  const std::unique_ptr<AbstractStagingTexture> readback_texture = ReadBack(level);
+  if (!readback_texture)
+    return false;
+
+  // The staging texture can't outlive this call, so its rows are copied out tightly packed
+  const TextureConfig& config = readback_texture->GetConfig();
+  const size_t row_size = config.width * sizeof(u32);
+  std::vector<u8> pixels(row_size * config.height);
+  const char* source = readback_texture->GetMappedPointer();
+  for (u32 row = 0; row < config.height; ++row)
+  {
+    std::memcpy(&pixels[row * row_size], source + row * readback_texture->GetMappedStride(),
+                row_size);
+  }
+
+  writer.SavePNG(filename, std::move(pixels), Common::ImageByteFormat::RGBA, config.width,
+                 config.height, static_cast<int>(row_size), compression_level);
+  return true;
+}
+
 bool AbstractTexture::IsCompressedFormat(AbstractTextureFormat format)
 {
   switch (format)
@@ -4,12 +4,19 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/TextureConfig.h"
 
+namespace Common
+{
+class ImageWriter;
+}
+class AbstractStagingTexture;
+
 class AbstractTexture
 {
 public:
@@ -39,6 +46,9 @@ public:
   MathUtil::Rectangle<int> GetMipRect(u32 level) const { return m_config.GetMipRect(level); }
   bool IsMultisampled() const { return m_config.IsMultisampled(); }
   bool Save(const std::string& filename, unsigned int level);
+  // Downloads the level now, but leaves the encoding to the writer
+  bool Save(Common::ImageWriter& writer, const std::string& filename, unsigned int level,
+            int compression_level);
 
   static bool IsCompressedFormat(AbstractTextureFormat format);
   static bool IsDepthFormat(AbstractTextureFormat format);
@@ -53,4 +63,8 @@ public:
 
 protected:
   const TextureConfig m_config;
+
+private:
+  // Copies the level to a mapped RGBA8 staging texture
+  std::unique_ptr<AbstractStagingTexture> ReadBack(unsigned int level);
 };
@@ -6,6 +6,7 @@
 #include <mutex>
 
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameRecords.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -93,6 +94,7 @@ void AsyncRequests::PushEvent(const AsyncRequests::Event& event, bool blocking)
   Fifo::RunGpu();
   if (blocking)
   {
+    FrameRecords::ScopedCPUWait wait;
     m_cond.wait(lock, [this] { return m_queue.empty(); });
   }
 }
@@ -162,6 +164,10 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
     g_perf_query->FlushResults();
     break;
 
+  case Event::PERF_QUERY_POLL:
+    g_perf_query->PollResults();
+    break;
+
   case Event::DO_SAVE_STATE:
     VideoCommon_DoState(*e.do_save_state.p);
     break;
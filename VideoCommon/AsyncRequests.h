@@ -28,6 +28,7 @@ public:
       SWAP_EVENT,
       BBOX_READ,
       PERF_QUERY,
+      PERF_QUERY_POLL,
       DO_SAVE_STATE,
     } type;
     u64 time;
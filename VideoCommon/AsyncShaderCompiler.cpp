@@ -3,6 +3,9 @@
 
 #include "VideoCommon/AsyncShaderCompiler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <thread>
 
 #include "Common/Assert.h"
@@ -22,8 +25,10 @@ AsyncShaderCompiler::~AsyncShaderCompiler()
   ASSERT(!HasWorkerThreads());
 }
 
-void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
+void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority, const void* tag)
 {
+  item->m_tag = tag;
+
   // If no worker threads are available, compile synchronously.
   if (!HasWorkerThreads())
   {
@@ -38,6 +43,24 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   }
 }
 
+void AsyncShaderCompiler::PromoteWorkItems(std::initializer_list<const void*> tags, u32 priority)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  for (auto iter = m_pending_work.upper_bound(priority); iter != m_pending_work.end();)
+  {
+    const void* tag = iter->second->m_tag;
+    auto next = std::next(iter);
+    if (tag && std::find(tags.begin(), tags.end(), tag) != tags.end())
+    {
+      // Promoted items end up before the iterator, so they aren't visited twice
+      auto node = m_pending_work.extract(iter);
+      node.key() = priority;
+      m_pending_work.insert(std::move(node));
+    }
+    iter = next;
+  }
+}
+
 void AsyncShaderCompiler::RetrieveWorkItems()
 {
   std::deque<WorkItemPtr> completed_work;
@@ -195,6 +218,7 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
 {
   Common::SetCurrentThreadName("AsyncShaderCompiler Worker");
+  Common::PlaceCurrentThread(Common::ThreadRole::Worker);
 
   // Initialize worker thread with backend-specific method.
   if (!WorkerThreadInitWorkerThread(param))
@@ -215,12 +239,22 @@ void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
 
 void AsyncShaderCompiler::WorkerThreadRun()
 {
+  // Items whose compile is still running on the driver's threads. Each worker keeps handing the
+  // driver more items while it polls these, and they count as busy until they're done.
+  constexpr size_t MAX_IN_FLIGHT_ITEMS = 8;
+  constexpr auto POLL_INTERVAL = std::chrono::milliseconds(1);
+  std::vector<WorkItemPtr> in_flight;
+
   std::unique_lock<std::mutex> pending_lock(m_pending_work_lock);
   while (!m_exit_flag.IsSet())
   {
-    m_worker_thread_wake.wait(pending_lock);
+    if (in_flight.empty() && m_pending_work.empty())
+      m_worker_thread_wake.wait(pending_lock);
+    else if (m_pending_work.empty() || in_flight.size() >= MAX_IN_FLIGHT_ITEMS)
+      m_worker_thread_wake.wait_for(pending_lock, POLL_INTERVAL);
 
-    while (!m_pending_work.empty() && !m_exit_flag.IsSet())
+    while (!m_pending_work.empty() && in_flight.size() < MAX_IN_FLIGHT_ITEMS &&
+           !m_exit_flag.IsSet())
     {
       m_busy_workers++;
       auto iter = m_pending_work.begin();
@@ -230,6 +264,13 @@ void AsyncShaderCompiler::WorkerThreadRun()
 
       if (item->Compile())
       {
+        if (!item->IsReady())
+        {
+          in_flight.push_back(std::move(item));
+          pending_lock.lock();
+          continue;
+        }
+
         std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
         m_completed_work.push_back(std::move(item));
       }
@@ -237,6 +278,37 @@ void AsyncShaderCompiler::WorkerThreadRun()
       pending_lock.lock();
       m_busy_workers--;
     }
+
+    if (!in_flight.empty())
+    {
+      pending_lock.unlock();
+      RetireReadyWorkItems(in_flight);
+      pending_lock.lock();
+    }
+  }
+
+  // Left at shutdown like the pending work, but destroyed while the worker can still clean up.
+  m_busy_workers -= in_flight.size();
+  pending_lock.unlock();
+  in_flight.clear();
+}
+
+void AsyncShaderCompiler::RetireReadyWorkItems(std::vector<WorkItemPtr>& in_flight)
+{
+  for (auto iter = in_flight.begin(); iter != in_flight.end();)
+  {
+    if (!(*iter)->IsReady())
+    {
+      ++iter;
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
+      m_completed_work.push_back(std::move(*iter));
+    }
+    iter = in_flight.erase(iter);
+    m_busy_workers--;
   }
 }
 
@@ -7,6 +7,7 @@
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <initializer_list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -28,7 +29,15 @@ public:
   public:
     virtual ~WorkItem() = default;
     virtual bool Compile() = 0;
+    // Polled by the worker thread after Compile(), for work it only started. Must not block.
+    virtual bool IsReady() { return true; }
     virtual void Retrieve() = 0;
+
+  private:
+    friend class AsyncShaderCompiler;
+
+    // Identifies the item to PromoteWorkItems, and is never dereferenced.
+    const void* m_tag = nullptr;
   };
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
@@ -44,7 +53,10 @@ public:
 
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
   // this work item will be compiled, relative to the other work items.
-  void QueueWorkItem(WorkItemPtr item, u32 priority);
+  void QueueWorkItem(WorkItemPtr item, u32 priority, const void* tag = nullptr);
+  // Moves the queued work items that were given one of these tags ahead to the given priority,
+  // unless they're already due sooner. Items that are being compiled are left alone.
+  void PromoteWorkItems(std::initializer_list<const void*> tags, u32 priority);
   void RetrieveWorkItems();
   bool HasPendingWork();
   bool HasCompletedWork();
@@ -69,6 +81,7 @@ protected:
 private:
   void WorkerThreadEntryPoint(void* param);
   void WorkerThreadRun();
+  void RetireReadyWorkItems(std::vector<WorkItemPtr>& in_flight);
 
   Common::Flag m_exit_flag;
   Common::Event m_init_event;
@@ -32,6 +32,7 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -267,6 +268,7 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
 
     const u32 copy_width = srcRect.GetWidth();
     const u32 copy_height = srcRect.GetHeight();
+    INCSTAT(g_stats.this_frame.num_efb_copies);
 
     // Check if we are to copy from the EFB or draw to the XFB
     if (PE_copy.copy_to_xfb == 0)
@@ -51,6 +51,9 @@ void BoundingBox::Flush()
 
     Write(start, std::vector<BBoxType>(m_values.begin() + start, m_values.begin() + end));
   }
+
+  // Readbacks from before the write would bring back the old values
+  DiscardReadbacks();
 }
 
 void BoundingBox::Readback()
@@ -58,7 +61,9 @@ void BoundingBox::Readback()
   if (!g_ActiveConfig.backend_info.bSupportsBBox)
     return;
 
-  auto read_values = Read(0, NUM_BBOX_VALUES);
+  std::optional<std::vector<BBoxType>> latest_values = ReadLatest();
+  const std::vector<BBoxType> read_values =
+      latest_values ? std::move(*latest_values) : Read(0, NUM_BBOX_VALUES);
 
   // Preserve dirty values, that way we don't need to sync.
   for (u32 i = 0; i < NUM_BBOX_VALUES; i++)
@@ -70,6 +75,60 @@ void BoundingBox::Readback()
   m_is_valid = true;
 }
 
+std::optional<std::vector<BBoxType>> BoundingBox::ReadLatest()
+{
+  const u32 latency = std::min<u32>(g_ActiveConfig.iReadbackLatency, MAX_QUEUED_BBOX_READBACKS);
+  if (latency == 0)
+    return std::nullopt;
+
+  while (m_queued_readbacks > 0 && RetireReadback(false))
+  {
+  }
+
+  // Values may be up to latency reads old, so the readback the previous read queued is the
+  // newest one this read may skip waiting for
+  while (m_queued_readbacks >= latency && RetireReadback(true))
+  {
+  }
+
+  // Have the next read answered by values from this point on
+  if (m_queued_readbacks < latency && QueueReadback())
+    m_queued_readbacks++;
+
+  // With nothing to answer with, like after the values were written, wait for the readbacks rather
+  // than reading the values directly, which would be newer than the ones the next read gets
+  while (!m_latest_values && m_queued_readbacks > 0 && RetireReadback(true))
+  {
+  }
+
+  return m_latest_values;
+}
+
+bool BoundingBox::RetireReadback(bool wait)
+{
+  std::optional<std::vector<BBoxType>> values = PollReadback(wait);
+  if (!values)
+  {
+    // Nothing will ever come back if waiting didn't help
+    if (wait)
+      m_queued_readbacks = m_discarded_readbacks = 0;
+    return false;
+  }
+
+  m_queued_readbacks--;
+  if (m_discarded_readbacks > 0)
+    m_discarded_readbacks--;
+  else
+    m_latest_values = std::move(values);
+  return true;
+}
+
+void BoundingBox::DiscardReadbacks()
+{
+  m_discarded_readbacks = m_queued_readbacks;
+  m_latest_values.reset();
+}
+
 u16 BoundingBox::Get(u32 index)
 {
   ASSERT(index < NUM_BBOX_VALUES);
@@ -110,6 +169,7 @@ void BoundingBox::DoState(PointerWrap& p)
 
     if (g_ActiveConfig.backend_info.bSupportsBBox)
       Write(0, backend_values);
+    DiscardReadbacks();
   }
   else
   {
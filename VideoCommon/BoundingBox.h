@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <optional>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -12,6 +13,8 @@ class PointerWrap;
 
 using BBoxType = s32;
 constexpr u32 NUM_BBOX_VALUES = 4;
+// The most readbacks a backend has to keep in flight at once, which caps the readback latency
+constexpr u32 MAX_QUEUED_BBOX_READBACKS = 4;
 
 class BoundingBox
 {
@@ -39,12 +42,28 @@ protected:
   // TODO: This can likely use std::span once we're on C++20
   virtual void Write(u32 index, const std::vector<BBoxType>& values) = 0;
 
+  // Used when the readback latency lets reads lag behind the GPU. QueueReadback() starts copying
+  // all the values to where the CPU can read them without stalling, returning false if it can't.
+  // PollReadback() returns the values of the oldest queued readback once the GPU has written
+  // them, and if wait is set, waits for the GPU rather than returning nothing.
+  virtual bool QueueReadback() { return false; }
+  virtual std::optional<std::vector<BBoxType>> PollReadback(bool wait) { return std::nullopt; }
+
 private:
   void Readback();
+  std::optional<std::vector<BBoxType>> ReadLatest();
+  bool RetireReadback(bool wait);
+  void DiscardReadbacks();
 
   bool m_is_active = false;
 
   std::array<BBoxType, NUM_BBOX_VALUES> m_values = {};
   std::array<bool, NUM_BBOX_VALUES> m_dirty = {};
   bool m_is_valid = true;
+
+  // The values of the last readback that completed, readbacks still in flight, and how many of
+  // those were queued before the values were last written and have to be thrown away
+  std::optional<std::vector<BBoxType>> m_latest_values;
+  u32 m_queued_readbacks = 0;
+  u32 m_discarded_readbacks = 0;
 };
@@ -13,6 +13,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Tracing.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -26,6 +27,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/FrameRecords.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -184,7 +186,10 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (s_use_deterministic_gpu_thread)
   {
-    s_gpu_mainloop.Wait();
+    {
+      FrameRecords::ScopedCPUWait wait;
+      s_gpu_mainloop.Wait();
+    }
     if (!s_gpu_mainloop.IsRunning())
       return;
 
@@ -324,6 +329,8 @@ void RunGpuLoop()
 
   s_gpu_mainloop.Run(
       [] {
+        TRACE_SPAN("Fifo::RunGpuLoop");
+
         // Run events from the CPU thread.
         AsyncRequests::GetInstance()->PullEvents();
 
@@ -331,6 +338,8 @@ void RunGpuLoop()
         if (!s_emu_running_state.IsSet())
           return;
 
+        FrameRecords::ScopedGPUWork gpu_work;
+
         if (s_use_deterministic_gpu_thread)
         {
           // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
@@ -488,6 +497,7 @@ static int RunGpuOnCpu(int ticks)
         reset_simd_state = true;
       }
       ReadDataFromFifo(fifo.CPReadPointer.load(std::memory_order_relaxed));
+      FrameRecords::ScopedGPUWork gpu_work;
       u32 cycles = 0;
       s_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
           DataReader(s_video_buffer_read_ptr, s_video_buffer_write_ptr), &cycles);
@@ -588,7 +598,10 @@ static int WaitForGpuThread(int ticks)
 
   // Wait for GPU
   if (now >= s_config_sync_gpu_max_distance)
+  {
+    FrameRecords::ScopedCPUWait wait;
     s_sync_wakeup_event.Wait();
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
@@ -0,0 +1,237 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameRecords.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "VideoCommon/Statistics.h"
+
+namespace FrameRecords
+{
+namespace
+{
+constexpr size_t RECORD_WORDS = sizeof(Record) / sizeof(u64);
+constexpr auto EXPORT_INTERVAL = std::chrono::milliseconds(500);
+
+// Single producer ring. The slots are atomics so that readers can copy them while frames keep
+// being added; a reader throws away any record that may have been overwritten while copying.
+std::array<std::array<std::atomic<u64>, RECORD_WORDS>, RING_SIZE> s_ring{};
+std::atomic<u64> s_written{0};
+
+// The time spent running GPU commands is tracked on the thread that runs them, which is also the
+// thread that adds the frames.
+thread_local u32 t_gpu_work_depth = 0;
+thread_local u64 t_gpu_work_start = 0;
+thread_local u64 t_gpu_busy_ns = 0;
+thread_local u64 t_last_gpu_busy_ns = 0;
+
+std::atomic<u64> s_cpu_wait_ns{0};
+
+u64 s_last_frame_end = 0;
+u64 s_last_cpu_wait_ns = 0;
+
+std::thread s_export_thread;
+std::mutex s_export_mutex;
+std::condition_variable s_export_wake;
+bool s_export_exiting = false;
+
+u64 Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+u32 ToMicroseconds(u64 ns)
+{
+  return static_cast<u32>(std::min<u64>(ns / 1000, UINT32_MAX));
+}
+
+// Copies the records from index begin on, and returns the index after the last one
+u64 CopyRecords(u64 begin, std::vector<Record>* records)
+{
+  const u64 end = s_written.load(std::memory_order_acquire);
+  begin = std::max(begin, end > RING_SIZE ? end - RING_SIZE : 0);
+
+  records->clear();
+  records->reserve(end - begin);
+  for (u64 i = begin; i < end; ++i)
+  {
+    std::array<u64, RECORD_WORDS> words;
+    for (size_t word = 0; word < RECORD_WORDS; ++word)
+      words[word] = s_ring[i % RING_SIZE][word].load(std::memory_order_relaxed);
+
+    Record& record = records->emplace_back();
+    std::memcpy(&record, words.data(), sizeof(Record));
+  }
+
+  // Slots that were reached again while they were being copied, including the one that may be
+  // written right now, hold a mix of two records
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const u64 now_writing = s_written.load(std::memory_order_relaxed) + 1;
+  const u64 overwritten = now_writing > RING_SIZE ? now_writing - RING_SIZE : 0;
+  if (overwritten > begin)
+  {
+    const u64 discarded = std::min(overwritten, end) - begin;
+    records->erase(records->begin(), records->begin() + discarded);
+  }
+
+  return end;
+}
+
+void ExportThread(std::string path)
+{
+  Common::SetCurrentThreadName("Frame records exporter");
+
+  File::IOFile file(path, "ab");
+  if (!file)
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open {} for the frame records", path);
+    return;
+  }
+  if (file.GetSize() == 0)
+  {
+    const FileHeader header{FILE_MAGIC, FILE_VERSION, sizeof(Record), 0};
+    file.WriteBytes(&header, sizeof(header));
+  }
+
+  u64 exported = s_written.load(std::memory_order_acquire);
+  std::vector<Record> records;
+  std::unique_lock lk(s_export_mutex);
+  while (true)
+  {
+    const bool exiting =
+        s_export_wake.wait_for(lk, EXPORT_INTERVAL, [] { return s_export_exiting; });
+
+    exported = CopyRecords(exported, &records);
+    if (!records.empty() && !file.WriteArray(records.data(), records.size()))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to write the frame records to {}", path);
+      return;
+    }
+    file.Flush();
+
+    if (exiting)
+      return;
+  }
+}
+}  // namespace
+
+void Init()
+{
+  s_written.store(0, std::memory_order_relaxed);
+  s_last_frame_end = Now();
+  s_last_cpu_wait_ns = s_cpu_wait_ns.load(std::memory_order_relaxed);
+
+  const std::string path = Config::Get(Config::GFX_FRAME_RECORDS_PATH);
+  if (!path.empty())
+  {
+    s_export_exiting = false;
+    s_export_thread = std::thread(ExportThread, path);
+  }
+}
+
+void Shutdown()
+{
+  if (!s_export_thread.joinable())
+    return;
+
+  {
+    std::lock_guard lk(s_export_mutex);
+    s_export_exiting = true;
+  }
+  s_export_wake.notify_one();
+  s_export_thread.join();
+}
+
+void AddFrame(u64 frame)
+{
+  const u64 now = Now();
+
+  // Count the work that is still going on, i.e. the command that presents this frame
+  if (t_gpu_work_depth != 0)
+  {
+    t_gpu_busy_ns += now - t_gpu_work_start;
+    t_gpu_work_start = now;
+  }
+
+  const u64 frame_time_ns = now - s_last_frame_end;
+  const u64 cpu_wait_ns = s_cpu_wait_ns.load(std::memory_order_relaxed) - s_last_cpu_wait_ns;
+  const Statistics::ThisFrame& stats = g_stats.this_frame;
+
+  Record record{};
+  record.frame = frame;
+  record.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+  record.frame_time_us = ToMicroseconds(frame_time_ns);
+  record.gpu_busy_us = ToMicroseconds(t_gpu_busy_ns - t_last_gpu_busy_ns);
+  record.cpu_busy_us = ToMicroseconds(frame_time_ns - std::min(cpu_wait_ns, frame_time_ns));
+  record.shader_stall_us = ToMicroseconds(stats.shader_stall_ns);
+  record.num_draw_calls = stats.num_draw_calls;
+  record.num_vertices = stats.num_prims + stats.num_dl_prims;
+  record.num_textures_uploaded = stats.num_textures_uploaded;
+  record.num_shader_stalls = stats.num_shader_stalls;
+  record.num_efb_copies = stats.num_efb_copies;
+  record.num_efb_peeks = stats.num_efb_peeks;
+  record.num_efb_pokes = stats.num_efb_pokes;
+
+  s_last_frame_end = now;
+  t_last_gpu_busy_ns = t_gpu_busy_ns;
+  s_last_cpu_wait_ns += cpu_wait_ns;
+
+  std::array<u64, RECORD_WORDS> words;
+  std::memcpy(words.data(), &record, sizeof(Record));
+
+  const u64 index = s_written.load(std::memory_order_relaxed);
+  // Pairs with the fence in CopyRecords, so a reader that sees this record's data also sees the
+  // count from before it
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t word = 0; word < RECORD_WORDS; ++word)
+    s_ring[index % RING_SIZE][word].store(words[word], std::memory_order_relaxed);
+  s_written.store(index + 1, std::memory_order_release);
+}
+
+std::vector<Record> GetRecentFrames(size_t count)
+{
+  const u64 written = s_written.load(std::memory_order_acquire);
+  std::vector<Record> records;
+  CopyRecords(written > count ? written - count : 0, &records);
+  return records;
+}
+
+ScopedGPUWork::ScopedGPUWork()
+{
+  if (t_gpu_work_depth++ == 0)
+    t_gpu_work_start = Now();
+}
+
+ScopedGPUWork::~ScopedGPUWork()
+{
+  if (--t_gpu_work_depth == 0)
+    t_gpu_busy_ns += Now() - t_gpu_work_start;
+}
+
+ScopedCPUWait::ScopedCPUWait() : m_start(Now())
+{
+}
+
+ScopedCPUWait::~ScopedCPUWait()
+{
+  s_cpu_wait_ns.fetch_add(Now() - m_start, std::memory_order_relaxed);
+}
+}  // namespace FrameRecords
@@ -0,0 +1,95 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A record of what each frame consisted of and where its time went, kept in a fixed-size ring so
+// that it can be looked at without the statistics overlay. If GFX_FRAME_RECORDS_PATH is set, the
+// records are also appended to that file in the format described below.
+//
+// The file starts with a FileHeader, followed by Records in the order the frames were presented.
+// Everything is little-endian. Records that were overwritten before the exporter got to them are
+// skipped, which shows as a gap in the frame numbers.
+
+namespace FrameRecords
+{
+constexpr u32 FILE_MAGIC = 0x4D524644;  // "DFRM"
+constexpr u32 FILE_VERSION = 1;
+
+// Frames kept in the ring before the oldest ones are overwritten.
+constexpr size_t RING_SIZE = 1024;
+
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 record_size;
+  u32 reserved;
+};
+static_assert(sizeof(FileHeader) == 16);
+
+struct Record
+{
+  u64 frame;
+  // When the frame was presented, in microseconds since the Unix epoch
+  u64 timestamp_us;
+
+  u32 frame_time_us;
+  // Time spent running GPU commands, on whichever thread runs them
+  u32 gpu_busy_us;
+  // Time the emulated CPU thread didn't spend throttling or waiting for the GPU thread
+  u32 cpu_busy_us;
+  // Time draws spent waiting for pipelines to be compiled
+  u32 shader_stall_us;
+
+  u32 num_draw_calls;
+  u32 num_vertices;
+  u32 num_textures_uploaded;
+  u32 num_shader_stalls;
+  u32 num_efb_copies;
+  u32 num_efb_peeks;
+  u32 num_efb_pokes;
+  u32 reserved;
+};
+static_assert(sizeof(Record) == 64);
+
+void Init();
+void Shutdown();
+
+// Takes the record of the frame that is being presented from g_stats.this_frame. Must be called
+// on the thread that runs the GPU commands, before the statistics are reset.
+void AddFrame(u64 frame);
+
+// Returns the records of up to the last count frames, oldest first.
+std::vector<Record> GetRecentFrames(size_t count = RING_SIZE);
+
+// Counts the time from construction to destruction as time spent running GPU commands.
+class ScopedGPUWork
+{
+public:
+  ScopedGPUWork();
+  ~ScopedGPUWork();
+
+  ScopedGPUWork(const ScopedGPUWork&) = delete;
+  ScopedGPUWork& operator=(const ScopedGPUWork&) = delete;
+};
+
+// Counts the time from construction to destruction as time the CPU thread spent waiting.
+class ScopedCPUWait
+{
+public:
+  ScopedCPUWait();
+  ~ScopedCPUWait();
+
+  ScopedCPUWait(const ScopedCPUWait&) = delete;
+  ScopedCPUWait& operator=(const ScopedCPUWait&) = delete;
+
+private:
+  u64 m_start;
+};
+}  // namespace FrameRecords
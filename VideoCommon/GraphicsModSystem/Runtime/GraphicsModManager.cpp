@@ -7,6 +7,8 @@
 #include <string_view>
 #include <variant>
 
+#include <xxhash.h>
+
 #include "Common/Logging/Log.h"
 #include "Common/VariantUtil.h"
 
@@ -65,6 +67,11 @@ private:
   std::unique_ptr<GraphicsModAction> m_action_impl;
 };
 
+u64 GraphicsModManager::HashTextureName(std::string_view texture_name)
+{
+  return XXH64(texture_name.data(), texture_name.size(), 0);
+}
+
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetProjectionActions(ProjectionType projection_type) const
 {
@@ -79,22 +86,24 @@ GraphicsModManager::GetProjectionActions(ProjectionType projection_type) const
 
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
-                                                const std::string& texture_name) const
+                                                u64 texture_hash) const
 {
-  const auto lookup = fmt::format("{}_{}", texture_name, static_cast<int>(projection_type));
-  if (const auto it = m_projection_texture_target_to_actions.find(lookup);
-      it != m_projection_texture_target_to_actions.end())
+  if (const auto type_it = m_projection_texture_target_to_actions.find(projection_type);
+      type_it != m_projection_texture_target_to_actions.end())
   {
-    return it->second;
+    if (const auto it = type_it->second.find(texture_hash); it != type_it->second.end())
+    {
+      return it->second;
+    }
   }
 
   return m_default;
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
+GraphicsModManager::GetDrawStartedActions(u64 texture_hash) const
 {
-  if (const auto it = m_draw_started_target_to_actions.find(texture_name);
+  if (const auto it = m_draw_started_target_to_actions.find(texture_hash);
       it != m_draw_started_target_to_actions.end())
   {
     return it->second;
@@ -104,9 +113,9 @@ GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetTextureLoadActions(const std::string& texture_name) const
+GraphicsModManager::GetTextureLoadActions(u64 texture_hash) const
 {
-  if (const auto it = m_load_target_to_actions.find(texture_name);
+  if (const auto it = m_load_target_to_actions.find(texture_hash);
       it != m_load_target_to_actions.end())
   {
     return it->second;
@@ -127,7 +136,7 @@ const std::vector<GraphicsModAction*>& GraphicsModManager::GetEFBActions(const F
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetXFBActions(const FBInfo& xfb) const
 {
-  if (const auto it = m_efb_target_to_actions.find(xfb); it != m_efb_target_to_actions.end())
+  if (const auto it = m_xfb_target_to_actions.find(xfb); it != m_xfb_target_to_actions.end())
   {
     return it->second;
   }
@@ -166,6 +175,11 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
 
   for (const auto& mod : mods)
   {
+    // A disabled mod's groups can still be used by other mods, but its own actions would never
+    // do anything
+    if (!mod.m_enabled)
+      continue;
+
     for (const GraphicsModFeatureConfig& feature : mod.m_features)
     {
       const auto create_action = [](const std::string_view& action_name,
@@ -193,12 +207,13 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
         std::visit(
             overloaded{
                 [&](const DrawStartedTextureTarget& the_target) {
-                  m_draw_started_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  m_draw_started_target_to_actions[HashTextureName(
+                                                       the_target.m_texture_info_string)]
+                      .push_back(m_actions.back().get());
                 },
                 [&](const LoadTextureTarget& the_target) {
-                  m_load_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  m_load_target_to_actions[HashTextureName(the_target.m_texture_info_string)]
+                      .push_back(m_actions.back().get());
                 },
                 [&](const EFBTarget& the_target) {
                   FBInfo info;
@@ -217,10 +232,9 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
                 [&](const ProjectionTarget& the_target) {
                   if (the_target.m_texture_info_string)
                   {
-                    const auto lookup = fmt::format("{}_{}", *the_target.m_texture_info_string,
-                                                    static_cast<int>(the_target.m_projection_type));
-                    m_projection_texture_target_to_actions[lookup].push_back(
-                        m_actions.back().get());
+                    const u64 hash = HashTextureName(*the_target.m_texture_info_string);
+                    m_projection_texture_target_to_actions[the_target.m_projection_type][hash]
+                        .push_back(m_actions.back().get());
                   }
                   else
                   {
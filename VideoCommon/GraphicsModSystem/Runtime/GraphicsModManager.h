@@ -6,30 +6,42 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModAction.h"
 #include "VideoCommon/TextureInfo.h"
 #include "VideoCommon/XFMemory.h"
 
 class GraphicsModGroupConfig;
+// Enabled mods are compiled into one hash map per kind of target on load, so looking up the
+// actions for an event costs a single probe, and events that no mod targets find nothing.
+// Textures are looked up by the hash of their name, which the texture cache computes once per
+// entry instead of for every draw.
 class GraphicsModManager
 {
 public:
+  static u64 HashTextureName(std::string_view texture_name);
+
   const std::vector<GraphicsModAction*>& GetProjectionActions(ProjectionType projection_type) const;
   const std::vector<GraphicsModAction*>&
-  GetProjectionTextureActions(ProjectionType projection_type,
-                              const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetDrawStartedActions(const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetTextureLoadActions(const std::string& texture_name) const;
+  GetProjectionTextureActions(ProjectionType projection_type, u64 texture_hash) const;
+  const std::vector<GraphicsModAction*>& GetDrawStartedActions(u64 texture_hash) const;
+  const std::vector<GraphicsModAction*>& GetTextureLoadActions(u64 texture_hash) const;
   const std::vector<GraphicsModAction*>& GetEFBActions(const FBInfo& efb) const;
   const std::vector<GraphicsModAction*>& GetXFBActions(const FBInfo& xfb) const;
 
+  // False if no mod targets draws by texture, so draws don't need their textures' hashes
+  bool HasTextureTargets() const
+  {
+    return !m_draw_started_target_to_actions.empty() ||
+           !m_projection_texture_target_to_actions.empty();
+  }
+
   void Load(const GraphicsModGroupConfig& config);
 
   void EndOfFrame();
@@ -43,10 +55,10 @@ private:
   std::list<std::unique_ptr<GraphicsModAction>> m_actions;
   std::unordered_map<ProjectionType, std::vector<GraphicsModAction*>>
       m_projection_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
+  std::unordered_map<ProjectionType, std::unordered_map<u64, std::vector<GraphicsModAction*>>>
       m_projection_texture_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_load_target_to_actions;
+  std::unordered_map<u64, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
+  std::unordered_map<u64, std::vector<GraphicsModAction*>> m_load_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_efb_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_xfb_target_to_actions;
 
@@ -4,8 +4,11 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <atomic>
+#include <ctime>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -27,6 +30,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "Common/Timer.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -48,6 +52,173 @@ static Common::Flag s_textureCacheAbortLoading;
 
 static std::thread s_prefetcher;
 
+// Walking a large texture pack on every boot takes a while, so the files found under the texture
+// root are remembered in an index along with the modification time of every directory. Adding,
+// removing or renaming a file changes the time of the directory holding it, so the index is still
+// good as long as none of the times changed, and checking that takes one stat per directory.
+//
+// The file is native-endian, strings are a u32 length followed by that many bytes:
+//   u32 magic | u32 version | s64 walk start time | string root
+//   u32 directory count | per directory: string path | s64 modification time
+//   u32 file count | per file: string path
+constexpr u32 PACK_INDEX_MAGIC = 0x58444948;  // "HIDX"
+constexpr u32 PACK_INDEX_VERSION = 1;
+
+struct TexturePackDirectory
+{
+  std::string path;
+  s64 modification_time;
+};
+
+static std::string GetPackIndexPath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "HiresTextures.idx";
+}
+
+static bool HasExtension(std::string_view name, std::string_view extension)
+{
+  return name.size() >= extension.size() &&
+         std::equal(extension.begin(), extension.end(), name.end() - extension.size(),
+                    [](char a, char b) { return Common::ToLower(a) == Common::ToLower(b); });
+}
+
+static bool IsTexturePackFile(std::string_view name)
+{
+  return HasExtension(name, ".png") || HasExtension(name, ".dds") || HasExtension(name, ".txt");
+}
+
+static void WalkTexturePack(const std::string& directory,
+                            std::vector<TexturePackDirectory>* directories,
+                            std::vector<std::string>* files)
+{
+  // The time has to be taken before the directory is read, so that a file added while it's read
+  // changes the time after it was recorded
+  directories->push_back({directory, File::FileInfo(directory).GetModificationTime()});
+  const File::FSTEntry top = File::ScanDirectoryTree(directory, false);
+  for (const File::FSTEntry& entry : top.children)
+  {
+    if (entry.isDirectory)
+      WalkTexturePack(entry.physicalName, directories, files);
+    else if (IsTexturePackFile(entry.virtualName))
+      files->push_back(entry.physicalName);
+  }
+}
+
+static bool WriteIndexString(File::IOFile& file, std::string_view str)
+{
+  const u32 length = static_cast<u32>(str.size());
+  return file.WriteArray(&length, 1) && file.WriteString(str);
+}
+
+static std::optional<std::string> ReadIndexString(File::IOFile& file)
+{
+  u32 length;
+  if (!file.ReadArray(&length, 1) || length > file.GetSize())
+    return std::nullopt;
+  std::string str(length, '\0');
+  if (!file.ReadBytes(str.data(), str.size()))
+    return std::nullopt;
+  return str;
+}
+
+static std::optional<std::vector<std::string>> ReadPackIndex(const std::string& root)
+{
+  File::IOFile file(GetPackIndexPath(), "rb");
+  u32 magic, version;
+  s64 walk_time;
+  if (!file || !file.ReadArray(&magic, 1) || !file.ReadArray(&version, 1) ||
+      !file.ReadArray(&walk_time, 1) || magic != PACK_INDEX_MAGIC ||
+      version != PACK_INDEX_VERSION || ReadIndexString(file) != root)
+  {
+    return std::nullopt;
+  }
+
+  u32 directory_count;
+  if (!file.ReadArray(&directory_count, 1))
+    return std::nullopt;
+  for (u32 i = 0; i < directory_count; ++i)
+  {
+    const std::optional<std::string> path = ReadIndexString(file);
+    s64 modification_time;
+    if (!path || !file.ReadArray(&modification_time, 1))
+      return std::nullopt;
+
+    // Times only have a resolution of a second, so a directory that changed in the second it
+    // was walked might have changed again after it was read without its time moving
+    if (modification_time >= walk_time ||
+        File::FileInfo(*path).GetModificationTime() != modification_time)
+    {
+      return std::nullopt;
+    }
+  }
+
+  u32 file_count;
+  if (!file.ReadArray(&file_count, 1))
+    return std::nullopt;
+  std::vector<std::string> files;
+  files.reserve(std::min<u64>(file_count, file.GetSize()));
+  for (u32 i = 0; i < file_count; ++i)
+  {
+    std::optional<std::string> path = ReadIndexString(file);
+    if (!path)
+      return std::nullopt;
+    files.push_back(std::move(*path));
+  }
+  return files;
+}
+
+static void WritePackIndex(const std::string& root, s64 walk_time,
+                           const std::vector<TexturePackDirectory>& directories,
+                           const std::vector<std::string>& files)
+{
+  const std::string path = GetPackIndexPath();
+  File::CreateFullPath(path);
+  File::IOFile file(path, "wb");
+  bool success = file && file.WriteArray(&PACK_INDEX_MAGIC, 1) &&
+                 file.WriteArray(&PACK_INDEX_VERSION, 1) && file.WriteArray(&walk_time, 1) &&
+                 WriteIndexString(file, root);
+
+  const u32 directory_count = static_cast<u32>(directories.size());
+  success = success && file.WriteArray(&directory_count, 1);
+  for (const TexturePackDirectory& directory : directories)
+  {
+    success = success && WriteIndexString(file, directory.path) &&
+              file.WriteArray(&directory.modification_time, 1);
+  }
+
+  const u32 file_count = static_cast<u32>(files.size());
+  success = success && file.WriteArray(&file_count, 1);
+  for (const std::string& texture_path : files)
+    success = success && WriteIndexString(file, texture_path);
+
+  if (!success)
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to write the texture pack index {}", path);
+    file.Close();
+    File::Delete(path);
+  }
+}
+
+// Every texture, mipmap and game ID file under the root, sorted
+static std::vector<std::string> FindTexturePackFiles(const std::string& root)
+{
+  if (std::optional<std::vector<std::string>> files = ReadPackIndex(root))
+    return std::move(*files);
+
+  std::vector<TexturePackDirectory> directories;
+  std::vector<std::string> files;
+  const s64 walk_time = static_cast<s64>(std::time(nullptr));
+  if (File::IsDirectory(root))
+    WalkTexturePack(root, &directories, &files);
+  std::sort(files.begin(), files.end());
+  WritePackIndex(root, walk_time, directories, files);
+  return files;
+}
+
+static std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_directory,
+                                                             const std::string& game_id,
+                                                             const std::vector<std::string>& files);
+
 void HiresTexture::Init()
 {
   // Note: Update is not called here so that we handle dynamic textures on startup more gracefully
@@ -78,18 +249,23 @@ void HiresTexture::Update()
   }
 
   const std::string& game_id = SConfig::GetInstance().GetGameID();
+  const std::string root_directory = File::GetUserPath(D_HIRESTEXTURES_IDX);
+  const std::vector<std::string> pack_files = FindTexturePackFiles(root_directory);
   const std::set<std::string> texture_directories =
-      GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
+      GetTextureDirectoriesWithGameId(root_directory, game_id, pack_files);
 
   for (const auto& texture_directory : texture_directories)
   {
-    const auto texture_paths =
-        Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
+    const std::string prefix = texture_directory + DIR_SEP;
+    const auto first = std::lower_bound(pack_files.begin(), pack_files.end(), prefix);
 
     bool failed_insert = false;
-    for (auto& path : texture_paths)
+    for (auto it = first; it != pack_files.end() && StringBeginsWith(*it, prefix); ++it)
     {
+      const std::string& path = *it;
+      if (HasExtension(path, ".txt"))
+        continue;
+
       std::string filename;
       SplitPath(path, nullptr, &filename, nullptr);
 
@@ -152,59 +328,76 @@ void HiresTexture::Prefetch()
 {
   Common::SetCurrentThreadName("Prefetcher");
 
-  size_t size_sum = 0;
   const size_t sys_mem = Common::MemPhysical();
   const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
   // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
   const size_t max_mem =
       (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
 
+  // Levels that are uploaded from a mapped file don't count against the limit, since the system
+  // can drop their pages whenever it needs the memory.
+  std::atomic<size_t> size_sum{0};
+  std::atomic<size_t> allocated_sum{0};
+  Common::Flag out_of_memory;
+
   const u32 start_time = Common::Timer::GetTimeMs();
-  for (const auto& entry : s_textureMap)
   {
-    const std::string& base_filename = entry.first;
-
-    if (base_filename.find("_mip") == std::string::npos)
+    // Textures are independent of each other, so they're decoded across the shared pool.
+    // Nothing changes s_textureMap until this thread has been joined.
+    Common::TaskGroup group;
+    for (const auto& entry : s_textureMap)
     {
-      std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+      const std::string& base_filename = entry.first;
+      if (base_filename.find("_mip") != std::string::npos)
+        continue;
 
-      auto iter = s_textureCache.find(base_filename);
-      if (iter == s_textureCache.end())
-      {
-        // unlock while loading a texture. This may result in a race condition where
-        // we'll load a texture twice, but it reduces the stuttering a lot.
-        lk.unlock();
-        std::unique_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
-        lk.lock();
-        if (texture)
-        {
-          std::shared_ptr<HiresTexture> ptr(std::move(texture));
-          iter = s_textureCache.insert(iter, std::make_pair(base_filename, ptr));
-        }
-      }
-      if (iter != s_textureCache.end())
-      {
-        for (const Level& l : iter->second->m_levels)
-          size_sum += l.data.size();
-      }
+      group.Submit(
+          [&base_filename, &size_sum, &allocated_sum, &out_of_memory, max_mem] {
+            if (s_textureCacheAbortLoading.IsSet() || out_of_memory.IsSet())
+              return;
+
+            std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+
+            auto iter = s_textureCache.find(base_filename);
+            if (iter == s_textureCache.end())
+            {
+              // unlock while loading a texture. This may result in a race condition where
+              // we'll load a texture twice, but it reduces the stuttering a lot.
+              lk.unlock();
+              std::unique_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
+              lk.lock();
+              if (!texture)
+                return;
+              iter = s_textureCache.try_emplace(base_filename, std::move(texture)).first;
+            }
+
+            size_t size = 0;
+            size_t allocated = 0;
+            for (const Level& l : iter->second->m_levels)
+            {
+              size += l.GetSize();
+              allocated += l.data.size();
+            }
+            size_sum += size;
+            if ((allocated_sum += allocated) > max_mem)
+              out_of_memory.Set();
+          },
+          Common::TaskPriority::Low);
     }
+  }
 
-    if (s_textureCacheAbortLoading.IsSet())
-    {
-      return;
-    }
+  if (s_textureCacheAbortLoading.IsSet())
+    return;
 
-    if (size_sum > max_mem)
-    {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
-
-      OSD::AddMessage(
-          fmt::format(
-              "Custom Textures prefetching after {:.1f} MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
-          10000);
-      return;
-    }
+  if (out_of_memory.IsSet())
+  {
+    Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
+
+    OSD::AddMessage(
+        fmt::format("Custom Textures prefetching after {:.1f} MB aborted, not enough RAM available",
+                    allocated_sum / (1024.0 * 1024.0)),
+        10000);
+    return;
   }
 
   const u32 stop_time = Common::Timer::GetTimeMs();
@@ -414,6 +607,14 @@ bool HiresTexture::LoadTexture(Level& level, const std::vector<u8>& buffer)
 
 std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_directory,
                                                       const std::string& game_id)
+{
+  return GetTextureDirectoriesWithGameId(root_directory, game_id,
+                                         Common::DoFileSearch({root_directory}, {".txt"}, true));
+}
+
+static std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_directory,
+                                                             const std::string& game_id,
+                                                             const std::vector<std::string>& files)
 {
   std::set<std::string> result;
   const std::string texture_directory = root_directory + game_id;
@@ -440,10 +641,9 @@ std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_di
   };
 
   // Look for any other directories that might be specific to the given gameid
-  const auto files = Common::DoFileSearch({root_directory}, {".txt"}, true);
   for (const auto& file : files)
   {
-    if (match_gameid_or_all(file))
+    if (HasExtension(file, ".txt") && match_gameid_or_all(file))
     {
       // The following code is used to calculate the top directory
       // of a found gameid.txt file
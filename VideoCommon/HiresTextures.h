@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <set>
 #include <string>
@@ -14,6 +15,11 @@
 
 enum class TextureFormat;
 
+namespace File
+{
+class MappedFile;
+}
+
 std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_directory,
                                                       const std::string& game_id);
 
@@ -38,7 +44,15 @@ public:
 
   struct Level
   {
+    const u8* GetData() const { return mapped_data ? mapped_data : data.data(); }
+    size_t GetSize() const { return mapped_data ? mapped_size : data.size(); }
+
     std::vector<u8> data;
+    // DDS levels that need no conversion point straight into the mapped file instead
+    std::shared_ptr<const File::MappedFile> mapping;
+    const u8* mapped_data = nullptr;
+    size_t mapped_size = 0;
+
     AbstractTextureFormat format = AbstractTextureFormat::RGBA8;
     u32 width = 0;
     u32 height = 0;
@@ -8,10 +8,11 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <memory>
 
 #include "Common/Align.h"
-#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
 #include "Common/Swap.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -227,7 +228,55 @@ void ConvertTexture_R8G8B8(HiresTexture::Level* level)
   level->data = std::move(new_data);
 }
 
-bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
+// Reads a DDS file through a mapping of it, so that levels can be used without copying them
+class DDSReader
+{
+public:
+  bool Open(const std::string& filename)
+  {
+    auto mapping = std::make_shared<File::MappedFile>();
+    if (!mapping->Open(filename, File::MappedFile::Mode::ReadOnly))
+      return false;
+    m_mapping = std::move(mapping);
+    return true;
+  }
+
+  const std::shared_ptr<File::MappedFile>& GetMapping() const { return m_mapping; }
+  u64 GetSize() const { return m_mapping->GetSize(); }
+
+  bool Seek(u64 offset)
+  {
+    if (offset > GetSize())
+      return false;
+    m_offset = offset;
+    return true;
+  }
+
+  // Returns the next size bytes of the file, or nullptr if the file is too short
+  const u8* Take(size_t size)
+  {
+    if (size > GetSize() - m_offset)
+      return nullptr;
+    const u8* data = m_mapping->GetData() + m_offset;
+    m_offset += size;
+    return data;
+  }
+
+  bool ReadBytes(void* data, size_t size)
+  {
+    const u8* source = Take(size);
+    if (!source)
+      return false;
+    std::memcpy(data, source, size);
+    return true;
+  }
+
+private:
+  std::shared_ptr<File::MappedFile> m_mapping;
+  u64 m_offset = 0;
+};
+
+bool ParseDDSHeader(DDSReader& file, DDSLoadInfo* info)
 {
   // Exit as early as possible for non-DDS textures, since all extensions are currently
   // passed through this function.
@@ -400,7 +449,7 @@ bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
   return true;
 }
 
-bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::string& filename,
+bool ReadMipLevel(HiresTexture::Level* level, DDSReader& file, const std::string& filename,
                   u32 mip_level, const DDSLoadInfo& info, u32 width, u32 height, u32 row_length,
                   size_t size)
 {
@@ -421,13 +470,24 @@ bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::str
   level->height = height;
   level->format = info.format;
   level->row_length = row_length;
-  level->data.resize(size);
-  if (!file.ReadBytes(level->data.data(), level->data.size()))
+  const u8* data = file.Take(size);
+  if (!data)
     return false;
 
-  // Apply conversion function for uncompressed textures.
+  // Apply conversion function for uncompressed textures. Everything else is uploaded from the
+  // mapping as it is, and the pages are read in now so that the upload doesn't wait on the disk.
   if (info.conversion_function)
+  {
+    level->data.assign(data, data + size);
     info.conversion_function(level);
+  }
+  else
+  {
+    level->mapping = file.GetMapping();
+    level->mapped_data = data;
+    level->mapped_size = size;
+    file.GetMapping()->Prefetch(data - file.GetMapping()->GetData(), size);
+  }
 
   return true;
 }
@@ -436,9 +496,8 @@ bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::str
 
 bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename)
 {
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file.IsOpen())
+  DDSReader file;
+  if (!file.Open(filename))
     return false;
 
   DDSLoadInfo info;
@@ -447,7 +506,7 @@ bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename
 
   // Read first mip level, as it may have a custom pitch.
   Level first_level;
-  if (!file.Seek(info.first_mip_offset, File::SeekOrigin::Begin) ||
+  if (!file.Seek(info.first_mip_offset) ||
       !ReadMipLevel(&first_level, file, filename, 0, info, info.width, info.height,
                     info.first_mip_row_length, info.first_mip_size))
   {
@@ -484,9 +543,8 @@ bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename
 bool HiresTexture::LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level)
 {
   // Only loading a single mip level.
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file.IsOpen())
+  DDSReader file;
+  if (!file.Open(filename))
     return false;
 
   DDSLoadInfo info;
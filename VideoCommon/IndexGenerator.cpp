@@ -6,6 +6,9 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#if defined(_M_X86) || defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -15,6 +18,44 @@
 namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
+constexpr u16 R = s_primitive_restart;
+
+// Writes count repetitions of a pattern of indices relative to index, which moves on by step
+// after every repetition. Restart indices in the pattern are kept as they are.
+template <size_t N>
+u16* WritePattern(u16* index_ptr, u32 count, u32 index, u32 step, const std::array<u16, N>& pattern)
+{
+  static_assert(N % 8 == 0);
+#if defined(_M_X86) || defined(_M_X86_64)
+  __m128i offsets[N / 8];
+  __m128i restarts[N / 8];
+  for (size_t i = 0; i < N / 8; ++i)
+  {
+    offsets[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pattern[i * 8]));
+    restarts[i] = _mm_cmpeq_epi16(offsets[i], _mm_set1_epi16(-1));
+  }
+
+  __m128i base = _mm_set1_epi16(static_cast<s16>(index));
+  const __m128i base_step = _mm_set1_epi16(static_cast<s16>(step));
+  for (u32 n = 0; n < count; ++n)
+  {
+    for (size_t i = 0; i < N / 8; ++i)
+    {
+      const __m128i indices = _mm_or_si128(_mm_add_epi16(base, offsets[i]), restarts[i]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr + i * 8), indices);
+    }
+    index_ptr += N;
+    base = _mm_add_epi16(base, base_step);
+  }
+#else
+  for (u32 n = 0; n < count; ++n, index += step)
+  {
+    for (u16 offset : pattern)
+      *index_ptr++ = offset == s_primitive_restart ? s_primitive_restart : index + offset;
+  }
+#endif
+  return index_ptr;
+}
 
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
@@ -30,7 +71,26 @@ u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 template <bool pr>
 u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 2; i < num_verts; i += 3)
+  u32 i = 2;
+  if constexpr (pr)
+  {
+    // 2 triangles at a time
+    static constexpr std::array<u16, 8> pattern{0, 1, 2, R, 3, 4, 5, R};
+    const u32 count = num_verts / 6;
+    index_ptr = WritePattern(index_ptr, count, index, 6, pattern);
+    i += count * 6;
+  }
+  else
+  {
+    // 8 triangles at a time
+    static constexpr std::array<u16, 24> pattern{0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11,
+                                                 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23};
+    const u32 count = num_verts / 24;
+    index_ptr = WritePattern(index_ptr, count, index, 24, pattern);
+    i += count * 24;
+  }
+
+  for (; i < num_verts; i += 3)
   {
     index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
   }
@@ -42,7 +102,11 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
+    static constexpr std::array<u16, 8> pattern{0, 1, 2, 3, 4, 5, 6, 7};
+    const u32 count = num_verts / 8;
+    index_ptr = WritePattern(index_ptr, count, index, 8, pattern);
+
+    for (u32 i = count * 8; i < num_verts; ++i)
     {
       *index_ptr++ = index + i;
     }
@@ -50,8 +114,14 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   }
   else
   {
+    // 8 triangles at a time, every other one with the winding flipped
+    static constexpr std::array<u16, 24> pattern{0, 1, 2, 1, 3, 2, 2, 3, 4, 3, 5, 4,
+                                                 4, 5, 6, 5, 7, 6, 6, 7, 8, 7, 9, 8};
+    const u32 count = num_verts > 2 ? (num_verts - 2) / 8 : 0;
+    index_ptr = WritePattern(index_ptr, count, index, 8, pattern);
+
     bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    for (u32 i = 2 + count * 8; i < num_verts; ++i)
     {
       index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
 
@@ -135,6 +205,26 @@ template <bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
   u32 i = 3;
+  if constexpr (pr)
+  {
+    // 8 quads at a time
+    static constexpr std::array<u16, 40> pattern{
+        1,  2,  0,  3,  R, 5,  6,  4,  7,  R, 9,  10, 8,  11, R, 13, 14, 12, 15, R,
+        17, 18, 16, 19, R, 21, 22, 20, 23, R, 25, 26, 24, 27, R, 29, 30, 28, 31, R};
+    const u32 count = num_verts / 32;
+    index_ptr = WritePattern(index_ptr, count, index, 32, pattern);
+    i += count * 32;
+  }
+  else
+  {
+    // 4 quads at a time
+    static constexpr std::array<u16, 24> pattern{0, 1,  2,  0, 2,  3,  4,  5,  6,  4,  6,  7,
+                                                 8, 9, 10, 8, 10, 11, 12, 13, 14, 12, 14, 15};
+    const u32 count = num_verts / 16;
+    index_ptr = WritePattern(index_ptr, count, index, 16, pattern);
+    i += count * 16;
+  }
+
   for (; i < num_verts; i += 4)
   {
     if constexpr (pr)
@@ -170,7 +260,11 @@ u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; i += 2)
+  static constexpr std::array<u16, 8> pattern{0, 1, 2, 3, 4, 5, 6, 7};
+  const u32 count = num_verts / 8;
+  index_ptr = WritePattern(index_ptr, count, index, 8, pattern);
+
+  for (u32 i = count * 8 + 1; i < num_verts; i += 2)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -182,7 +276,11 @@ u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 // so converting them to lists
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
+  static constexpr std::array<u16, 8> pattern{0, 1, 1, 2, 2, 3, 3, 4};
+  const u32 count = num_verts > 1 ? (num_verts - 1) / 4 : 0;
+  index_ptr = WritePattern(index_ptr, count, index, 4, pattern);
+
+  for (u32 i = count * 4 + 1; i < num_verts; ++i)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -192,7 +290,11 @@ u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 0; i != num_verts; ++i)
+  static constexpr std::array<u16, 8> pattern{0, 1, 2, 3, 4, 5, 6, 7};
+  const u32 count = num_verts / 8;
+  index_ptr = WritePattern(index_ptr, count, index, 8, pattern);
+
+  for (u32 i = count * 8; i != num_verts; ++i)
   {
     *index_ptr++ = index + i;
   }
@@ -27,6 +27,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 #include "VideoCommon/XFStructs.h"
 
@@ -232,11 +233,85 @@ public:
   bool m_in_display_list = false;
 };
 
-template <bool is_preprocess>
-u8* RunFifo(DataReader src, u32* cycles)
+// Stands in for RunCallback<false> with GFX_HACK_SKIP_GPU. Commands are still decoded to find
+// where the next one starts, and cost as many cycles as they would otherwise, but only what the
+// CPU can wait on is acted on: PE tokens, draw done and their interrupts. Nothing is loaded into
+// XF or BP memory, no vertices are loaded and the texture cache never hears of anything.
+class SkipCallback final : public Callback
+{
+public:
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data)) { m_cycles += 18 + 6 * count; }
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
+  {
+    // Vertex sizes depend on the CP state, so it's the one piece of GPU state that's kept up
+    m_cycles += 12;
+    GetCPState().LoadCPReg(command, value);
+  }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value))
+  {
+    m_cycles += 12;
+
+    // The deterministic GPU thread has already signalled these ahead of time
+    if (!Fifo::UseDeterministicGPUThread())
+      LoadBPRegPreprocess(command, value, m_cycles);
+  }
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size))
+  {
+    m_cycles += 6;
+  }
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
+                                          u32 vertex_size, u16 num_vertices, const u8* vertex_data))
+  {
+    m_cycles += num_vertices * 4 * 3 + 6;
+  }
+  // Display lists can set tokens too, so they're walked all the same
+  OPCODE_CALLBACK_NOINLINE(void OnDisplayList(u32 address, u32 size))
+  {
+    m_cycles += 6;
+
+    if (m_in_display_list)
+    {
+      WARN_LOG_FMT(VIDEO, "recursive display list detected");
+      return;
+    }
+
+    const u8* start_address;
+    if (Fifo::UseDeterministicGPUThread())
+      start_address = static_cast<u8*>(Fifo::PopFifoAuxBuffer(size));
+    else
+      start_address = Memory::GetPointer(address);
+
+    if (start_address != nullptr)
+    {
+      m_in_display_list = true;
+      Run(start_address, size, *this);
+      m_in_display_list = false;
+    }
+  }
+  OPCODE_CALLBACK(void OnNop(u32 count)) { m_cycles += 6 * count; }
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data))
+  {
+    if (static_cast<Opcode>(opcode) == Opcode::GX_CMD_UNKNOWN_METRICS ||
+        static_cast<Opcode>(opcode) == Opcode::GX_CMD_INVL_VC)
+    {
+      m_cycles += 6;
+    }
+    else
+    {
+      CommandProcessor::HandleUnknownOpcode(opcode, data, false);
+      m_cycles += 1;
+    }
+  }
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size)) {}
+  OPCODE_CALLBACK(CPState& GetCPState()) { return g_main_cp_state; }
+
+  u32 m_cycles = 0;
+  bool m_in_display_list = false;
+};
+
+template <typename T>
+static u8* RunFifoWith(DataReader src, u32* cycles, T& callback)
 {
-  using CallbackT = RunCallback<is_preprocess>;
-  auto callback = CallbackT{};
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
 
   if (cycles != nullptr)
@@ -246,6 +321,23 @@ u8* RunFifo(DataReader src, u32* cycles)
   return src.GetPointer();
 }
 
+template <bool is_preprocess>
+u8* RunFifo(DataReader src, u32* cycles)
+{
+  if constexpr (!is_preprocess)
+  {
+    if (g_ActiveConfig.bSkipGPU)
+    {
+      SkipCallback callback;
+      return RunFifoWith(src, cycles, callback);
+    }
+  }
+
+  using CallbackT = RunCallback<is_preprocess>;
+  auto callback = CallbackT{};
+  return RunFifoWith(src, cycles, callback);
+}
+
 template u8* RunFifo<true>(DataReader src, u32* cycles);
 template u8* RunFifo<false>(DataReader src, u32* cycles);
 
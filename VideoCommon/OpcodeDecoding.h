@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <array>
+#include <cstring>
 #include <type_traits>
 
 #include "Common/Assert.h"
+#include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumFormatter.h"
 #include "Common/Inline.h"
@@ -115,6 +118,25 @@ public:
 
 namespace detail
 {
+// Returns the number of GX_NOP bytes at the start of data, checking 8 bytes at a time. NOPs come in
+// long runs, since they are used to pad display lists and the FIFO to 32 bytes.
+static DOLPHIN_FORCE_INLINE u32 CountNops(const u8* data, u32 available)
+{
+  u32 count = 0;
+  while (available - count >= sizeof(u64))
+  {
+    u64 bytes;
+    std::memcpy(&bytes, &data[count], sizeof(bytes));
+    if (bytes != 0)
+      return count + Common::LeastSignificantSetBit(bytes) / 8;
+    count += sizeof(u64);
+  }
+
+  while (count < available && static_cast<Opcode>(data[count]) == Opcode::GX_NOP)
+    count++;
+  return count;
+}
+
 // Main logic; split so that the main RunCommand can call OnCommand with the returned size.
 template <typename T, typename = std::enable_if_t<std::is_base_of_v<Callback, T>>>
 static DOLPHIN_FORCE_INLINE u32 RunCommand(const u8* data, u32 available, T& callback)
@@ -128,9 +150,7 @@ static DOLPHIN_FORCE_INLINE u32 RunCommand(const u8* data, u32 available, T& cal
   {
   case Opcode::GX_NOP:
   {
-    u32 count = 1;
-    while (count < available && static_cast<Opcode>(data[count]) == Opcode::GX_NOP)
-      count++;
+    const u32 count = CountNops(data, available);
     callback.OnNop(count);
     return count;
   }
@@ -245,6 +265,75 @@ static DOLPHIN_FORCE_INLINE u32 RunCommand(const u8* data, u32 available, T& cal
   callback.OnUnknown(static_cast<u8>(cmd), data);
   return 1;
 }
+
+// State setup and draws mostly come in runs of the same command, e.g. the BP loads that set up TEV
+// or the draws of a display list. The Run*Span functions below handle such a run in one loop, so
+// that only the first command of it goes through the opcode switch. They make exactly the same
+// callbacks as RunCommand would, and return 0 if not even the first command is complete.
+
+template <typename T>
+static DOLPHIN_FORCE_INLINE u32 RunBPSpan(const u8* data, u32 available, T& callback)
+{
+  u32 size = 0;
+  while (available - size >= 5 && static_cast<Opcode>(data[size]) == Opcode::GX_LOAD_BP_REG)
+  {
+    const u8* command = &data[size];
+    callback.OnBP(command[1], Common::swap24(&command[2]));
+    callback.OnCommand(command, 5);
+    size += 5;
+  }
+  return size;
+}
+
+template <typename T>
+static DOLPHIN_FORCE_INLINE u32 RunCPSpan(const u8* data, u32 available, T& callback)
+{
+  u32 size = 0;
+  while (available - size >= 6 && static_cast<Opcode>(data[size]) == Opcode::GX_LOAD_CP_REG)
+  {
+    const u8* command = &data[size];
+    callback.OnCP(command[1], Common::swap32(&command[2]));
+    callback.OnCommand(command, 6);
+    size += 6;
+  }
+  return size;
+}
+
+template <typename T>
+static DOLPHIN_FORCE_INLINE u32 RunPrimitiveSpan(const u8* data, u32 available, T& callback)
+{
+  // The CP state can't change within the span, so the vertex size of each VAT is only looked up
+  // once. 0 marks sizes that haven't been looked up yet; a size that really is 0 is just looked
+  // up every time.
+  std::array<u32, CP_NUM_VAT_REG> vertex_sizes{};
+
+  u32 size = 0;
+  while (available - size >= 3 && static_cast<Opcode>(data[size]) >= Opcode::GX_PRIMITIVE_START &&
+         static_cast<Opcode>(data[size]) <= Opcode::GX_PRIMITIVE_END)
+  {
+    const u8* command = &data[size];
+    const OpcodeDecoder::Primitive primitive = static_cast<OpcodeDecoder::Primitive>(
+        (command[0] & OpcodeDecoder::GX_PRIMITIVE_MASK) >> OpcodeDecoder::GX_PRIMITIVE_SHIFT);
+    const u8 vat = command[0] & OpcodeDecoder::GX_VAT_MASK;
+
+    u32& vertex_size = vertex_sizes[vat];
+    if (vertex_size == 0)
+    {
+      vertex_size = VertexLoaderBase::GetVertexSize(callback.GetCPState().vtx_desc,
+                                                    callback.GetCPState().vtx_attr[vat]);
+    }
+    const u16 num_vertices = Common::swap16(&command[1]);
+
+    const u32 command_size = 3 + num_vertices * vertex_size;
+    if (available - size < command_size)
+      break;
+
+    callback.OnPrimitiveCommand(primitive, vat, vertex_size, num_vertices, &command[3]);
+    callback.OnCommand(command, command_size);
+    size += command_size;
+  }
+  return size;
+}
 }  // namespace detail
 
 template <typename T, typename = std::enable_if_t<std::is_base_of_v<Callback, T>>>
@@ -264,7 +353,20 @@ DOLPHIN_FORCE_INLINE u32 Run(const u8* data, u32 available, T& callback)
   u32 size = 0;
   while (size < available)
   {
-    const u32 command_size = RunCommand(&data[size], available - size, callback);
+    const u8* command = &data[size];
+    const u32 remaining = available - size;
+    const Opcode opcode = static_cast<Opcode>(command[0]);
+
+    u32 command_size;
+    if (opcode >= Opcode::GX_PRIMITIVE_START && opcode <= Opcode::GX_PRIMITIVE_END)
+      command_size = detail::RunPrimitiveSpan(command, remaining, callback);
+    else if (opcode == Opcode::GX_LOAD_BP_REG)
+      command_size = detail::RunBPSpan(command, remaining, callback);
+    else if (opcode == Opcode::GX_LOAD_CP_REG)
+      command_size = detail::RunCPSpan(command, remaining, callback);
+    else
+      command_size = RunCommand(command, remaining, callback);
+
     if (command_size == 0)
       break;
     size += command_size;
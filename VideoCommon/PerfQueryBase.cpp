@@ -11,3 +11,15 @@ bool PerfQueryBase::ShouldEmulate()
 {
   return g_ActiveConfig.bPerfQueriesEnable;
 }
+
+bool PerfQueryBase::ShouldWaitForResults()
+{
+  if (m_stale_reads < g_ActiveConfig.iReadbackLatency)
+  {
+    m_stale_reads++;
+    return false;
+  }
+
+  m_stale_reads = 0;
+  return true;
+}
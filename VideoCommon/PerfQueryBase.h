@@ -58,12 +58,21 @@ public:
   // carefully!
   virtual void FlushResults() {}
 
+  // Retire the pending queries the GPU has already finished, without waiting for the rest
+  virtual void PollResults() {}
+
   // True if there are no further pending query results
   // NOTE: Called from CPU thread
   virtual bool IsFlushed() const { return true; }
 
+  // Whether a read has to wait for the pending queries, or may return what has been retired so far
+  // because the reads before it didn't use up the readback latency
+  // NOTE: Called from CPU thread
+  bool ShouldWaitForResults();
+
 protected:
   std::atomic<u32> m_query_count;
+  int m_stale_reads = 0;
   std::array<std::atomic<u32>, PQG_NUM_MEMBERS> m_results;
 };
 
@@ -185,6 +185,8 @@ void PixelShaderManager::SetConstants()
 void PixelShaderManager::SetTevColor(int index, int component, s32 value)
 {
   auto& c = constants.colors[index];
+  if (c[component] == value)
+    return;
   c[component] = value;
   dirty = true;
 
@@ -194,6 +196,8 @@ void PixelShaderManager::SetTevColor(int index, int component, s32 value)
 void PixelShaderManager::SetTevKonstColor(int index, int component, s32 value)
 {
   auto& c = constants.kcolors[index];
+  if (c[component] == value)
+    return;
   c[component] = value;
   dirty = true;
 
@@ -245,10 +249,14 @@ void PixelShaderManager::SetTevIndirectChanged()
 
 void PixelShaderManager::SetAlpha()
 {
-  constants.alpha[0] = bpmem.alpha_test.ref0;
-  constants.alpha[1] = bpmem.alpha_test.ref1;
-  constants.alpha[3] = static_cast<s32>(bpmem.dstalpha.alpha);
-  dirty = true;
+  const int4 alpha = {static_cast<s32>(bpmem.alpha_test.ref0),
+                      static_cast<s32>(bpmem.alpha_test.ref1), constants.alpha[2],
+                      static_cast<s32>(bpmem.dstalpha.alpha)};
+  if (constants.alpha != alpha)
+  {
+    constants.alpha = alpha;
+    dirty = true;
+  }
 }
 
 void PixelShaderManager::SetAlphaTestChanged()
@@ -293,8 +301,11 @@ void PixelShaderManager::SetSamplerState(int texmapid, u32 tm0, u32 tm1)
 
 void PixelShaderManager::SetZTextureBias()
 {
-  constants.zbias[1][3] = bpmem.ztex1.bias;
-  dirty = true;
+  if (constants.zbias[1][3] != static_cast<s32>(bpmem.ztex1.bias))
+  {
+    constants.zbias[1][3] = bpmem.ztex1.bias;
+    dirty = true;
+  }
 }
 
 void PixelShaderManager::SetViewportChanged()
@@ -306,13 +317,18 @@ void PixelShaderManager::SetViewportChanged()
 
 void PixelShaderManager::SetEfbScaleChanged(float scalex, float scaley)
 {
-  constants.efbscale[0] = 1.0f / scalex;
-  constants.efbscale[1] = 1.0f / scaley;
-  dirty = true;
+  const std::array<float, 2> efbscale = {1.0f / scalex, 1.0f / scaley};
+  if (constants.efbscale != efbscale)
+  {
+    constants.efbscale = efbscale;
+    dirty = true;
+  }
 }
 
 void PixelShaderManager::SetZSlope(float dfdx, float dfdy, float f0)
 {
+  if (constants.zslope[0] == dfdx && constants.zslope[1] == dfdy && constants.zslope[2] == f0)
+    return;
   constants.zslope[0] = dfdx;
   constants.zslope[1] = dfdy;
   constants.zslope[2] = f0;
@@ -321,11 +337,15 @@ void PixelShaderManager::SetZSlope(float dfdx, float dfdy, float f0)
 
 void PixelShaderManager::SetIndTexScaleChanged(bool high)
 {
-  constants.indtexscale[high][0] = bpmem.texscale[high].ss0;
-  constants.indtexscale[high][1] = bpmem.texscale[high].ts0;
-  constants.indtexscale[high][2] = bpmem.texscale[high].ss1;
-  constants.indtexscale[high][3] = bpmem.texscale[high].ts1;
-  dirty = true;
+  const int4 scale = {static_cast<s32>(bpmem.texscale[high].ss0),
+                      static_cast<s32>(bpmem.texscale[high].ts0),
+                      static_cast<s32>(bpmem.texscale[high].ss1),
+                      static_cast<s32>(bpmem.texscale[high].ts1)};
+  if (constants.indtexscale[high] != scale)
+  {
+    constants.indtexscale[high] = scale;
+    dirty = true;
+  }
 }
 
 void PixelShaderManager::SetIndMatrixChanged(int matrixidx)
@@ -334,15 +354,16 @@ void PixelShaderManager::SetIndMatrixChanged(int matrixidx)
 
   // xyz - static matrix
   // w - dynamic matrix scale / 128
-  constants.indtexmtx[2 * matrixidx][0] = bpmem.indmtx[matrixidx].col0.ma;
-  constants.indtexmtx[2 * matrixidx][1] = bpmem.indmtx[matrixidx].col1.mc;
-  constants.indtexmtx[2 * matrixidx][2] = bpmem.indmtx[matrixidx].col2.me;
-  constants.indtexmtx[2 * matrixidx][3] = 17 - scale;
-  constants.indtexmtx[2 * matrixidx + 1][0] = bpmem.indmtx[matrixidx].col0.mb;
-  constants.indtexmtx[2 * matrixidx + 1][1] = bpmem.indmtx[matrixidx].col1.md;
-  constants.indtexmtx[2 * matrixidx + 1][2] = bpmem.indmtx[matrixidx].col2.mf;
-  constants.indtexmtx[2 * matrixidx + 1][3] = 17 - scale;
-  dirty = true;
+  const int4 row0 = {bpmem.indmtx[matrixidx].col0.ma, bpmem.indmtx[matrixidx].col1.mc,
+                     bpmem.indmtx[matrixidx].col2.me, 17 - scale};
+  const int4 row1 = {bpmem.indmtx[matrixidx].col0.mb, bpmem.indmtx[matrixidx].col1.md,
+                     bpmem.indmtx[matrixidx].col2.mf, 17 - scale};
+  if (constants.indtexmtx[2 * matrixidx] != row0 || constants.indtexmtx[2 * matrixidx + 1] != row1)
+  {
+    constants.indtexmtx[2 * matrixidx] = row0;
+    constants.indtexmtx[2 * matrixidx + 1] = row1;
+    dirty = true;
+  }
 
   PRIM_LOG("indmtx{}: scale={}, mat=({} {} {}; {} {} {})", matrixidx, scale,
            bpmem.indmtx[matrixidx].col0.ma, bpmem.indmtx[matrixidx].col1.mc,
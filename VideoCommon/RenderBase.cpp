@@ -66,6 +66,7 @@
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/FrameRecords.h"
 #include "VideoCommon/FreeLookCamera.h"
 #include "VideoCommon/GraphicsModSystem/Config/GraphicsModGroup.h"
 #include "VideoCommon/NetPlayChatUI.h"
@@ -648,7 +649,19 @@ void Renderer::DrawDebugText()
   }
 
   if (g_ActiveConfig.bOverlayStats)
+  {
+    VertexLoaderManager::UpdateStatistics();
+    const SystemTimers::PacingErrorHistogram pacing_errors =
+        SystemTimers::GetPacingErrorHistogram();
+    g_stats.pacing_errors.resize(pacing_errors.size());
+    for (size_t i = 0; i < pacing_errors.size(); ++i)
+    {
+      const bool has_limit = i < SystemTimers::PACING_ERROR_LIMITS_US.size();
+      g_stats.pacing_errors[i] = {has_limit ? SystemTimers::PACING_ERROR_LIMITS_US[i] : 0,
+                                  pacing_errors[i]};
+    }
     g_stats.Display();
+  }
 
   if (g_ActiveConfig.bShowNetPlayMessages && g_netplay_chat_ui)
     g_netplay_chat_ui->Display();
@@ -1416,6 +1429,8 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         if (IsFrameDumping())
           DumpCurrentFrame(xfb_entry->texture.get(), xfb_rect, ticks, m_frame_count);
 
+        FrameRecords::AddFrame(m_frame_count);
+
         // Begin new frame
         m_frame_count++;
         g_stats.ResetFrame();
@@ -1512,6 +1527,26 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
                                 const MathUtil::Rectangle<int>& src_rect, u64 ticks,
                                 int frame_number)
 {
+  // The ring only fills up when the dump thread falls behind, since FlushFrameDump maps the
+  // readbacks as soon as the GPU had time to finish them
+  ReleaseEncodedFrameDumpReadbacks();
+  if (m_frame_dump_queued_readbacks + m_frame_dump_copied_readbacks == FRAME_DUMP_READBACK_COUNT)
+  {
+    if (g_ActiveConfig.bFrameDumpDropLateFrames && !m_screenshot_request.IsSet())
+    {
+      ++m_frame_dump_dropped_frames;
+      return;
+    }
+
+    while (m_frame_dump_copied_readbacks != 0)
+      QueueFrameDumpReadback();
+    {
+      std::unique_lock lk(m_frame_dump_mutex);
+      m_frame_dump_encoded.wait(lk, [this] { return m_frame_dump_encoded_frames != 0; });
+    }
+    ReleaseEncodedFrameDumpReadbacks();
+  }
+
   int source_width = src_rect.GetWidth();
   int source_height = src_rect.GetHeight();
   int target_width, target_height;
@@ -1539,13 +1574,16 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  FrameDumpReadback& readback =
+      m_frame_dump_readbacks[(m_frame_dump_first_readback + m_frame_dump_queued_readbacks +
+                              m_frame_dump_copied_readbacks) %
+                             FRAME_DUMP_READBACK_COUNT];
+  if (!CheckFrameDumpReadbackTexture(readback, target_width, target_height))
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_frame_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  readback.texture->CopyFromTexture(src_texture, copy_rect, 0, 0, readback.texture->GetRect());
+  readback.state = m_frame_dump.FetchState(ticks, frame_number);
+  ++m_frame_dump_copied_readbacks;
 }
 
 bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -1575,9 +1613,10 @@ bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
   return true;
 }
 
-bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool Renderer::CheckFrameDumpReadbackTexture(FrameDumpReadback& readback, u32 target_width,
+                                             u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex = readback.texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -1591,90 +1630,128 @@ bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height
   return true;
 }
 
-void Renderer::FlushFrameDump()
+void Renderer::QueueFrameDumpReadback()
 {
-  if (!m_frame_dump_needs_flush)
-    return;
-
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+  const u32 index = (m_frame_dump_first_readback + m_frame_dump_queued_readbacks) %
+                    FRAME_DUMP_READBACK_COUNT;
+  FrameDumpReadback& readback = m_frame_dump_readbacks[index];
+  --m_frame_dump_copied_readbacks;
+  ++m_frame_dump_queued_readbacks;
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  if (!m_frame_dump_thread_running.IsSet())
+  {
+    if (m_frame_dump_thread.joinable())
+      m_frame_dump_thread.join();
+    m_frame_dump_thread_running.Set();
+    m_frame_dump_thread = std::thread(&Renderer::FrameDumpThreadFunc, this);
+  }
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
+  // A readback that fails to map is still queued, with no data, so that the dump thread finishes
+  // the frames in ring order
+  FrameDump::FrameData frame{nullptr, 0, 0, 0, readback.state};
+  readback.texture->Flush();
+  if (readback.texture->Map())
   {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
+    frame.data = reinterpret_cast<u8*>(readback.texture->GetMappedPointer());
+    frame.width = static_cast<int>(readback.texture->GetConfig().width);
+    frame.height = static_cast<int>(readback.texture->GetConfig().height);
+    frame.stride = static_cast<int>(readback.texture->GetMappedStride());
   }
   else
   {
     ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
   }
 
-  m_frame_dump_needs_flush = false;
+  std::lock_guard lk(m_frame_dump_mutex);
+  m_frame_dump_queue.push_back(frame);
+  m_frame_dump_queued.notify_one();
+}
+
+void Renderer::ReleaseEncodedFrameDumpReadbacks()
+{
+  u32 encoded_frames;
+  {
+    std::lock_guard lk(m_frame_dump_mutex);
+    encoded_frames = m_frame_dump_encoded_frames;
+    m_frame_dump_encoded_frames = 0;
+  }
+
+  for (u32 i = 0; i < encoded_frames; ++i)
+  {
+    FrameDumpReadback& readback = m_frame_dump_readbacks[m_frame_dump_first_readback];
+    if (readback.texture->IsMapped())
+      readback.texture->Unmap();
+    m_frame_dump_first_readback = (m_frame_dump_first_readback + 1) % FRAME_DUMP_READBACK_COUNT;
+  }
+  m_frame_dump_queued_readbacks -= encoded_frames;
+}
+
+void Renderer::FlushFrameDump()
+{
+  if (m_frame_dump_queued_readbacks == 0 && m_frame_dump_copied_readbacks == 0)
+    return;
 
   // Shutdown frame dumping if it is no longer active.
   if (!IsFrameDumping())
+  {
     ShutdownFrameDumping();
+    return;
+  }
+
+  ReleaseEncodedFrameDumpReadbacks();
+  while (m_frame_dump_copied_readbacks > FRAME_DUMP_READBACK_LATENCY)
+    QueueFrameDumpReadback();
 }
 
 void Renderer::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
+  // Ensure the queued readbacks have been encoded.
+  FinishFrameData();
+
+  if (m_frame_dump_dropped_frames != 0)
+  {
+    WARN_LOG_FMT(VIDEO, "FrameDump: Dropped {} frames that couldn't be encoded in time.",
+                 m_frame_dump_dropped_frames);
+    m_frame_dump_dropped_frames = 0;
+  }
 
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
-
   // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
+  {
+    std::lock_guard lk(m_frame_dump_mutex);
+    m_frame_dump_thread_running.Clear();
+  }
+  m_frame_dump_queued.notify_one();
   if (m_frame_dump_thread.joinable())
     m_frame_dump_thread.join();
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  for (FrameDumpReadback& readback : m_frame_dump_readbacks)
+    readback.texture.reset();
 }
 
-void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
+void Renderer::FinishFrameData()
 {
-  m_frame_dump_data = FrameDump::FrameData{data, w, h, stride, m_last_frame_state};
+  while (m_frame_dump_copied_readbacks != 0)
+    QueueFrameDumpReadback();
 
-  if (!m_frame_dump_thread_running.IsSet())
+  while (m_frame_dump_queued_readbacks != 0)
   {
-    if (m_frame_dump_thread.joinable())
-      m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
-    m_frame_dump_thread = std::thread(&Renderer::FrameDumpThreadFunc, this);
+    {
+      std::unique_lock lk(m_frame_dump_mutex);
+      m_frame_dump_encoded.wait(lk, [this] { return m_frame_dump_encoded_frames != 0; });
+    }
+    ReleaseEncodedFrameDumpReadbacks();
   }
-
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
-}
-
-void Renderer::FinishFrameData()
-{
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
-
-  m_frame_dump_output_texture->Unmap();
 }
 
 void Renderer::FrameDumpThreadFunc()
 {
   Common::SetCurrentThreadName("FrameDumping");
+  Common::PlaceCurrentThread(Common::ThreadRole::Worker);
 
   bool dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
   bool frame_dump_started = false;
@@ -1689,13 +1766,33 @@ void Renderer::FrameDumpThreadFunc()
   }
 #endif
 
+  // Lets the video thread unmap the frame at the front of the queue
+  const auto finish_frame = [this] {
+    std::lock_guard lk(m_frame_dump_mutex);
+    m_frame_dump_queue.pop_front();
+    ++m_frame_dump_encoded_frames;
+    m_frame_dump_encoded.notify_one();
+  };
+
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+    FrameDump::FrameData frame;
+    {
+      std::unique_lock lk(m_frame_dump_mutex);
+      m_frame_dump_queued.wait(lk, [this] {
+        return !m_frame_dump_queue.empty() || !m_frame_dump_thread_running.IsSet();
+      });
+      if (m_frame_dump_queue.empty())
+        break;
+
+      frame = m_frame_dump_queue.front();
+    }
 
-    auto frame = m_frame_dump_data;
+    if (!frame.data)
+    {
+      finish_frame();
+      continue;
+    }
 
     // Save screenshot
     if (m_screenshot_request.TestAndClear())
@@ -1734,7 +1831,7 @@ void Renderer::FrameDumpThreadFunc()
       }
     }
 
-    m_frame_dump_done.Set();
+    finish_frame();
   }
 
   if (frame_dump_started)
@@ -1859,6 +1956,8 @@ void Renderer::DoState(PointerWrap& p)
   }
 
 #if defined(HAVE_FFMPEG)
+  // The dump thread uses the state of the frame dump while it encodes
+  FinishFrameData();
   m_frame_dump.DoState(p);
 #endif
 }
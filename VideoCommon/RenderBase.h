@@ -14,6 +14,8 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -366,30 +368,39 @@ private:
   std::thread m_frame_dump_thread;
   Common::Flag m_frame_dump_thread_running;
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
-
-  // Set by frame dump thread on frame completion.
-  Common::Event m_frame_dump_done;
-
-  // Holds emulation state during the last swap when dumping.
-  FrameDump::FrameState m_last_frame_state;
-
-  // Communication of frame between video and dump threads.
-  FrameDump::FrameData m_frame_dump_data;
+  // Ring of readback textures, so that the GPU has a few frames to finish each copy before it's
+  // mapped, and the dump thread can fall behind without holding up the renderer. In ring order
+  // from m_frame_dump_first_readback, the first m_frame_dump_queued_readbacks are mapped and
+  // handed to the dump thread, and the next m_frame_dump_copied_readbacks are waiting for the GPU.
+  // Only the video thread touches the ring.
+  static constexpr u32 FRAME_DUMP_READBACK_COUNT = 6;
+  // Readbacks that are left to the GPU before they are mapped.
+  static constexpr u32 FRAME_DUMP_READBACK_LATENCY = 2;
+  struct FrameDumpReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameDump::FrameState state;
+  };
+  std::array<FrameDumpReadback, FRAME_DUMP_READBACK_COUNT> m_frame_dump_readbacks;
+  u32 m_frame_dump_first_readback = 0;
+  u32 m_frame_dump_queued_readbacks = 0;
+  u32 m_frame_dump_copied_readbacks = 0;
+  u32 m_frame_dump_dropped_frames = 0;
+
+  // Communication of frames between video and dump threads.
+  std::mutex m_frame_dump_mutex;
+  // Signalled when a frame is queued, or the thread should exit.
+  std::condition_variable m_frame_dump_queued;
+  // Signalled when the dump thread is done with a frame.
+  std::condition_variable m_frame_dump_encoded;
+  std::deque<FrameDump::FrameData> m_frame_dump_queue;
+  // Frames the dump thread is done with that haven't been unmapped yet.
+  u32 m_frame_dump_encoded_frames = 0;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
-
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
 
@@ -432,16 +443,21 @@ private:
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
   // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  bool CheckFrameDumpReadbackTexture(FrameDumpReadback& readback, u32 target_width,
+                                     u32 target_height);
 
   // Fills the frame dump staging texture with the current XFB texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect, u64 ticks, int frame_number);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Maps the oldest copied readback and queues it for encoding.
+  void QueueFrameDumpReadback();
+
+  // Unmaps the readbacks the dump thread is done with.
+  void ReleaseEncodedFrameDumpReadbacks();
 
-  // Ensures all rendered frames are queued for encoding.
+  // Queues the readbacks that the GPU has had enough time to finish for encoding. If frame
+  // dumping has stopped, queues all of them and shuts down.
   void FlushFrameDump();
 
   // Ensures all encoded frames have been written to the output file.
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <chrono>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
@@ -65,9 +67,16 @@ void ShaderCache::InitializeShaderCache()
   CompileMissingPipelines();
   if (g_ActiveConfig.bWaitForShadersBeforeStarting)
     WaitForAsyncCompiler();
+  SwitchToRuntimeCompilerThreads();
+}
 
-  // Switch to the runtime shader compiler thread configuration.
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+void ShaderCache::SwitchToRuntimeCompilerThreads()
+{
+  // When the precompilation runs in the background, it keeps the precompiler threads until the
+  // pipelines from the UID cache are done. RetrieveAsyncShaders switches over after that.
+  m_background_precompiling = !m_precompiling_pipelines.empty();
+  if (!m_background_precompiling)
+    m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
 }
 
 void ShaderCache::Reload()
@@ -91,12 +100,18 @@ void ShaderCache::Reload()
   CompileMissingPipelines();
   if (g_ActiveConfig.bWaitForShadersBeforeStarting)
     WaitForAsyncCompiler();
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+  SwitchToRuntimeCompilerThreads();
 }
 
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+
+  if (m_background_precompiling && m_precompiling_pipelines.empty())
+  {
+    m_background_precompiling = false;
+    m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+  }
 }
 
 void ShaderCache::Shutdown()
@@ -116,10 +131,15 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
     return it->second.first.get();
 
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
+  const auto stall_start = std::chrono::steady_clock::now();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
     pipeline = g_renderer->CreatePipeline(*pipeline_config);
+  const auto stall_time = std::chrono::steady_clock::now() - stall_start;
+  INCSTAT(g_stats.this_frame.num_shader_stalls);
+  ADDSTAT(g_stats.this_frame.shader_stall_ns,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(stall_time).count());
   if (g_ActiveConfig.bShaderCache && !exists_in_cache)
     AppendGXPipelineUID(uid);
   return InsertGXPipeline(uid, std::move(pipeline));
@@ -133,8 +153,10 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
       return it->second.first.get();
-    else
-      return {};
+
+    // A draw needs the pipeline now, so it shouldn't wait for the rest of the precompilation
+    PromotePipelineCompile(uid);
+    return {};
   }
 
   AppendGXPipelineUID(uid);
@@ -396,6 +418,7 @@ void ShaderCache::ClearCaches()
     pipeline.reset();
   m_texture_reinterpret_pipelines.clear();
   m_texture_decoding_shaders.clear();
+  m_precompiling_pipelines.clear();
 
   SETSTAT(g_stats.num_pixel_shaders_created, 0);
   SETSTAT(g_stats.num_pixel_shaders_alive, 0);
@@ -405,11 +428,24 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  // Queue all uids with a null pipeline for compilation. The ones from the UID cache go first, in
+  // the order the game first used them, since items of equal priority are compiled in the order
+  // they were queued. That way the pipelines for the start of the game are ready soonest.
+  // The uid goes into the set first, since a compile that finishes right away erases it again.
+  const auto queue_pipeline = [this](const GXPipelineUid& uid) {
+    m_precompiling_pipelines.insert(uid);
+    QueuePipelineCompile(uid, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+  };
+  for (const GXPipelineUid& uid : m_gx_pipeline_uid_order)
+  {
+    auto it = m_gx_pipeline_cache.find(uid);
+    if (it != m_gx_pipeline_cache.end() && !it->second.first && !it->second.second)
+      queue_pipeline(uid);
+  }
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
-      QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+    if (!it.second.first && !it.second.second)
+      queue_pipeline(it.first);
   }
   for (auto& it : m_gx_uber_pipeline_cache)
   {
@@ -684,6 +720,7 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
 {
   auto& entry = m_gx_pipeline_cache[config];
   entry.second = false;
+  m_precompiling_pipelines.erase(config);
   if (!entry.first && pipeline)
   {
     entry.first = std::move(pipeline);
@@ -821,6 +858,24 @@ void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
   // Flag it as empty with a null pipeline object, for later compilation.
   auto& entry = m_gx_pipeline_cache[real_uid];
   entry.second = false;
+  m_gx_pipeline_uid_order.push_back(real_uid);
+}
+
+void ShaderCache::PromotePipelineCompile(const GXPipelineUid& uid)
+{
+  if (m_precompiling_pipelines.erase(uid) == 0)
+    return;
+
+  // The pipeline's work item only gets queued for real once its shaders are ready, so those need
+  // to be promoted as well
+  const auto vs_it = m_vs_cache.shader_map.find(uid.vs_uid);
+  PixelShaderUid ps_uid = uid.ps_uid;
+  ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
+  const auto ps_it = m_ps_cache.shader_map.find(ps_uid);
+  m_async_shader_compiler->PromoteWorkItems(
+      {&m_gx_pipeline_cache[uid], vs_it != m_vs_cache.shader_map.end() ? &vs_it->second : nullptr,
+       ps_it != m_ps_cache.shader_map.end() ? &ps_it->second : nullptr},
+      COMPILE_PRIORITY_ONDEMAND_PIPELINE);
 }
 
 void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
@@ -853,6 +908,8 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
       return true;
     }
 
+    bool IsReady() override { return !shader || shader->IsReady(); }
+
     void Retrieve() override { shader_cache->InsertVertexShader(uid, std::move(shader)); }
 
   private:
@@ -861,9 +918,10 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
     VertexShaderUid uid;
   };
 
-  m_vs_cache.shader_map[uid].pending = true;
+  auto& entry = m_vs_cache.shader_map[uid];
+  entry.pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority, &entry);
 }
 
 void ShaderCache::QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority)
@@ -882,6 +940,8 @@ void ShaderCache::QueueVertexUberShaderCompile(const UberShader::VertexShaderUid
       return true;
     }
 
+    bool IsReady() override { return !shader || shader->IsReady(); }
+
     void Retrieve() override { shader_cache->InsertVertexUberShader(uid, std::move(shader)); }
 
   private:
@@ -911,6 +971,8 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
       return true;
     }
 
+    bool IsReady() override { return !shader || shader->IsReady(); }
+
     void Retrieve() override { shader_cache->InsertPixelShader(uid, std::move(shader)); }
 
   private:
@@ -919,9 +981,10 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
     PixelShaderUid uid;
   };
 
-  m_ps_cache.shader_map[uid].pending = true;
+  auto& entry = m_ps_cache.shader_map[uid];
+  entry.pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority, &entry);
 }
 
 void ShaderCache::QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority)
@@ -940,6 +1003,8 @@ void ShaderCache::QueuePixelUberShaderCompile(const UberShader::PixelShaderUid&
       return true;
     }
 
+    bool IsReady() override { return !shader || shader->IsReady(); }
+
     void Retrieve() override { shader_cache->InsertPixelUberShader(uid, std::move(shader)); }
 
   private:
@@ -1002,10 +1067,18 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       }
       else
       {
+        // A draw may have promoted the pipeline since it was queued.
+        if (priority == COMPILE_PRIORITY_SHADERCACHE_PIPELINE &&
+            shader_cache->m_precompiling_pipelines.count(uid) == 0)
+        {
+          priority = COMPILE_PRIORITY_ONDEMAND_PIPELINE;
+        }
+
         // Re-queue for next frame.
         auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
             shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        shader_cache->m_async_shader_compiler->QueueWorkItem(
+            std::move(wi), priority, &shader_cache->m_gx_pipeline_cache[uid]);
       }
     }
 
@@ -1018,9 +1091,10 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     bool stages_ready;
   };
 
+  auto& entry = m_gx_pipeline_cache[uid];
   auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
-  m_gx_pipeline_cache[uid].second = true;
+  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority, &entry);
+  entry.second = true;
 }
 
 void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority)
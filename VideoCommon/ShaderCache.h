@@ -9,9 +9,11 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -122,6 +124,7 @@ private:
   void LoadPipelineUIDCache();
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
+  void SwitchToRuntimeCompilerThreads();
   void QueueUberShaderPipelines();
   bool CompileSharedPipelines();
 
@@ -160,6 +163,7 @@ private:
                                                std::unique_ptr<AbstractPipeline> pipeline);
   void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
   void AppendGXPipelineUID(const GXPipelineUid& config);
+  void PromotePipelineCompile(const GXPipelineUid& uid);
 
   // ASync Compiler Methods
   void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
@@ -228,6 +232,11 @@ private:
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
+  // The UIDs read from the UID cache, in the order they were appended, i.e. first used.
+  std::vector<GXPipelineUid> m_gx_pipeline_uid_order;
+  // Pipelines queued by CompileMissingPipelines that haven't been compiled or promoted yet.
+  std::set<GXPipelineUid> m_precompiling_pipelines;
+  bool m_background_precompiling = false;
   LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/Statistics.h"
 
+#include <algorithm>
 #include <cstring>
 #include <utility>
 
@@ -90,12 +91,39 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Stream buffer grows", "%d", this_frame.num_stream_buffer_grows);
+  draw_statistic("Stream buffer waits", "%d", this_frame.num_stream_buffer_fence_waits);
+  draw_statistic("Stream buffer submits", "%d", this_frame.num_stream_buffer_submits);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
 
   ImGui::Columns(1);
 
+  if (!vertex_loader_usage.empty() && ImGui::CollapsingHeader("Vertex Loader Usage"))
+  {
+    constexpr size_t MAX_SHOWN_LOADERS = 16;
+    for (size_t i = 0; i < std::min(vertex_loader_usage.size(), MAX_SHOWN_LOADERS); ++i)
+    {
+      const VertexLoaderUsage& usage = vertex_loader_usage[i];
+      ImGui::Text("%s: %llu vertices, %.2f ms", usage.description.c_str(),
+                  static_cast<unsigned long long>(usage.num_vertices),
+                  usage.load_time_ns / 1000000.0);
+    }
+  }
+
+  if (!pacing_errors.empty() && ImGui::CollapsingHeader("Frame Pacing Error"))
+  {
+    for (const PacingErrorBucket& bucket : pacing_errors)
+    {
+      if (bucket.max_error_us != 0)
+        ImGui::Text("Up to %u us: %llu", bucket.max_error_us,
+                    static_cast<unsigned long long>(bucket.num_wakeups));
+      else
+        ImGui::Text("More: %llu", static_cast<unsigned long long>(bucket.num_wakeups));
+    }
+  }
+
   ImGui::End();
 }
 
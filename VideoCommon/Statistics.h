@@ -4,8 +4,10 @@
 #pragma once
 
 #include <array>
+#include <string>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPFunctions.h"
 
 struct Statistics
@@ -21,6 +23,24 @@ struct Statistics
 
   int num_vertex_loaders;
 
+  struct VertexLoaderUsage
+  {
+    std::string description;
+    u64 num_vertices;
+    u64 load_time_ns;
+  };
+  // Filled in by VertexLoaderManager::UpdateStatistics, busiest loaders first
+  std::vector<VertexLoaderUsage> vertex_loader_usage;
+
+  struct PacingErrorBucket
+  {
+    // 0 for the last bucket, which has no limit
+    u32 max_error_us;
+    u64 num_wakeups;
+  };
+  // How far off the CPU thread woke up from throttling, filled in from SystemTimers
+  std::vector<PacingErrorBucket> pacing_errors;
+
   std::array<float, 6> proj;
   std::array<float, 16> gproj;
   std::array<float, 16> g2proj;
@@ -57,6 +77,10 @@ struct Statistics
     int bytes_vertex_streamed;
     int bytes_index_streamed;
     int bytes_uniform_streamed;
+    // Times an upload found its stream buffer full, by how it got the space back
+    int num_stream_buffer_grows;
+    int num_stream_buffer_fence_waits;
+    int num_stream_buffer_submits;
 
     int num_triangles_clipped;
     int num_triangles_in;
@@ -71,6 +95,12 @@ struct Statistics
 
     int num_efb_peeks;
     int num_efb_pokes;
+    int num_efb_copies;
+
+    int num_textures_uploaded;
+    // Pipelines that draws had to wait for
+    int num_shader_stalls;
+    u64 shader_stall_ns;
   };
   ThisFrame this_frame;
   void ResetFrame();
@@ -25,6 +25,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -37,6 +38,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
+#include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
 #include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/PixelShaderManager.h"
@@ -72,6 +74,12 @@ TextureCacheBase::TCacheEntry::~TCacheEntry()
     reference->references.erase(this);
 }
 
+void TextureCacheBase::TCacheEntry::SetTextureInfoName(std::string name)
+{
+  texture_info_hash = GraphicsModManager::HashTextureName(name);
+  texture_info_name = std::move(name);
+}
+
 void TextureCacheBase::CheckTempSize(size_t required_size)
 {
   if (required_size <= temp_size)
@@ -94,7 +102,8 @@ TextureCacheBase::TextureCacheBase()
 
   HiresTexture::Init();
 
-  Common::SetHash64Function();
+  Common::SetHash64Function(backup_config.xxh64_hashing ? Common::Hash64Function::XXH64 :
+                                                          Common::Hash64Function::Default);
 
   TMEM::InvalidateAll();
 }
@@ -161,6 +170,7 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 
   // TODO: Invalidating texcache is really stupid in some of these cases
   if (config.iSafeTextureCache_ColorSamples != backup_config.color_samples ||
+      config.bTextureHashXXH64 != backup_config.xxh64_hashing ||
       config.bTexFmtOverlayEnable != backup_config.texfmt_overlay ||
       config.bTexFmtOverlayCenter != backup_config.texfmt_overlay_center ||
       config.bHiresTextures != backup_config.hires_textures ||
@@ -172,6 +182,8 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
   {
     Invalidate();
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
+    Common::SetHash64Function(config.bTextureHashXXH64 ? Common::Hash64Function::XXH64 :
+                                                         Common::Hash64Function::Default);
   }
 
   SetBackupConfig(config);
@@ -254,6 +266,7 @@ bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 r
 void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 {
   backup_config.color_samples = config.iSafeTextureCache_ColorSamples;
+  backup_config.xxh64_hashing = config.bTextureHashXXH64;
   backup_config.texfmt_overlay = config.bTexFmtOverlayEnable;
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
@@ -979,7 +992,13 @@ void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, uns
   if (File::Exists(filename))
     return;
 
-  entry->texture->Save(filename, level);
+  SaveDumpedTexture(entry->texture.get(), filename, level);
+}
+
+void TextureCacheBase::SaveDumpedTexture(AbstractTexture* texture, const std::string& filename,
+                                         u32 level)
+{
+  texture->Save(m_dump_writer, filename, level, Config::Get(Config::GFX_PNG_COMPRESSION_LEVEL));
 }
 
 // Helper for checking if a BPMemory TexMode0 register is set to Point
@@ -1216,6 +1235,93 @@ private:
   std::vector<Level> levels;
 };
 
+namespace
+{
+// A texture level that is decoded on the CPU
+struct SoftwareDecodedLevel
+{
+  u32 level;
+  u32 width;
+  u32 height;
+  u32 expanded_width;
+  u32 expanded_height;
+  const u8* src;
+  u8* dst;
+  size_t size;
+};
+}  // namespace
+
+// Textures that decode to less than this aren't worth handing to other threads.
+constexpr size_t MIN_PARALLEL_DECODE_SIZE = 0x40000;
+// How much decoded data one task produces at most, in whole rows of blocks.
+constexpr size_t PARALLEL_DECODE_STRIPE_SIZE = 0x40000;
+
+static void DecodeTextureLevels(const TextureInfo& texture_info, u32 bytes_per_block,
+                                const std::vector<SoftwareDecodedLevel>& levels)
+{
+  const TextureFormat format = texture_info.GetTextureFormat();
+  const u32 block_width = texture_info.GetBlockWidth();
+  const u32 block_height = texture_info.GetBlockHeight();
+
+  // Only the base level of an RGBA8 texture in TMEM is split between the two TMEM banks
+  const auto is_rgba8_from_tmem = [&](const SoftwareDecodedLevel& level) {
+    return level.level == 0 && format == TextureFormat::RGBA8 && texture_info.IsFromTmem();
+  };
+
+  const auto decode = [&](const SoftwareDecodedLevel& level, u32 first_row, u32 rows) {
+    if (is_rgba8_from_tmem(level))
+    {
+      TexDecoder_DecodeRGBA8FromTmem(level.dst, level.src, texture_info.GetTmemOddAddress(),
+                                     level.expanded_width, level.expanded_height);
+      return;
+    }
+
+    const size_t block_row_size = bytes_per_block * (level.expanded_width / block_width);
+    TexDecoder_Decode(level.dst + size_t(first_row) * level.expanded_width * sizeof(u32),
+                      level.src + first_row / block_height * block_row_size,
+                      level.expanded_width, rows, format, texture_info.GetTlutAddress(),
+                      texture_info.GetTlutFormat());
+  };
+
+  size_t total_size = 0;
+  for (const SoftwareDecodedLevel& level : levels)
+    total_size += level.size;
+
+  // The format overlay is drawn over whatever one call decodes, so it needs whole levels
+  if (!g_ActiveConfig.bParallelTextureDecoding || total_size < MIN_PARALLEL_DECODE_SIZE ||
+      g_ActiveConfig.bTexFmtOverlayEnable)
+  {
+    for (const SoftwareDecodedLevel& level : levels)
+      decode(level, 0, level.expanded_height);
+    return;
+  }
+
+  // The decoders only look at the block rows they are given, so splitting a level between block
+  // rows gives the same result as decoding it in one go
+  const bool can_split = format != TextureFormat::XFB;
+  Common::TaskGroup group;
+  for (const SoftwareDecodedLevel& level : levels)
+  {
+    const size_t row_size = size_t(level.expanded_width) * sizeof(u32);
+    const u32 stripe_rows = Common::AlignUp(
+        std::max<u32>(static_cast<u32>(PARALLEL_DECODE_STRIPE_SIZE / row_size), 1), block_height);
+    if (!can_split || is_rgba8_from_tmem(level) || level.expanded_height <= stripe_rows)
+    {
+      group.Submit([&decode, &level] { decode(level, 0, level.expanded_height); },
+                   Common::TaskPriority::High);
+      continue;
+    }
+
+    for (u32 row = 0; row < level.expanded_height; row += stripe_rows)
+    {
+      const u32 rows = std::min(stripe_rows, level.expanded_height - row);
+      group.Submit([&decode, &level, row, rows] { decode(level, row, rows); },
+                   Common::TaskPriority::High);
+    }
+  }
+  group.Wait();
+}
+
 TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
   // if this stage was not invalidated by changes to texture registers, keep the current texture
@@ -1245,7 +1351,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture
   entry->frameCount = FRAMECOUNT_INVALID;
   if (entry->texture_info_name.empty() && g_ActiveConfig.bGraphicMods)
   {
-    entry->texture_info_name = texture_info.CalculateTextureName().GetFullName();
+    entry->SetTextureInfoName(texture_info.CalculateTextureName().GetFullName());
   }
   bound_textures[texture_info.GetStage()] = entry;
 
@@ -1563,12 +1669,13 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   if (hires_tex)
   {
     const auto& level = hires_tex->m_levels[0];
-    entry->texture->Load(0, level.width, level.height, level.row_length, level.data.data(),
-                         level.data.size());
+    entry->texture->Load(0, level.width, level.height, level.row_length, level.GetData(),
+                         level.GetSize());
   }
 
   // Initialized to null because only software loading uses this buffer
   u8* dst_buffer = nullptr;
+  std::vector<SoftwareDecodedLevel> software_decoded_levels;
 
   if (!hires_tex)
   {
@@ -1599,23 +1706,9 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
 
       CheckTempSize(total_texture_size);
       dst_buffer = temp;
-      if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
-      {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
-      }
-      else
-      {
-        TexDecoder_DecodeRGBA8FromTmem(dst_buffer, texture_info.GetData(),
-                                       texture_info.GetTmemOddAddress(), expanded_width,
-                                       expanded_height);
-      }
-
-      entry->texture->Load(0, width, height, expanded_width, dst_buffer, decoded_texture_size);
-
-      arbitrary_mip_detector.AddLevel(width, height, expanded_width, dst_buffer);
-
+      software_decoded_levels.push_back({0, width, height, expanded_width, expanded_height,
+                                         texture_info.GetData(), dst_buffer,
+                                         decoded_texture_size});
       dst_buffer += decoded_texture_size;
     }
   }
@@ -1649,7 +1742,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
     {
       const auto& level = hires_tex->m_levels[level_index];
       entry->texture->Load(level_index, level.width, level.height, level.row_length,
-                           level.data.data(), level.data.size());
+                           level.GetData(), level.GetSize());
     }
   }
   else
@@ -1671,18 +1764,23 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
-        entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
-                             mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
-
-        arbitrary_mip_detector.AddLevel(mip_level->GetRawWidth(), mip_level->GetRawHeight(),
-                                        mip_level->GetExpandedWidth(), dst_buffer);
-
+        software_decoded_levels.push_back(
+            {level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
+             mip_level->GetExpandedWidth(), mip_level->GetExpandedHeight(), mip_level->GetData(),
+             dst_buffer, decoded_mip_size});
         dst_buffer += decoded_mip_size;
       }
     }
+
+    // All levels are decoded before any of them is uploaded, so that they can be decoded at the
+    // same time. Uploading has to stay on this thread.
+    DecodeTextureLevels(texture_info, bytes_per_block, software_decoded_levels);
+    for (const SoftwareDecodedLevel& level : software_decoded_levels)
+    {
+      entry->texture->Load(level.level, level.width, level.height, level.expanded_width,
+                           level.dst, level.size);
+      arbitrary_mip_detector.AddLevel(level.width, level.height, level.expanded_width, level.dst);
+    }
   }
 
   entry->has_arbitrary_mips = hires_tex ? hires_tex->HasArbitraryMipmaps() :
@@ -1697,6 +1795,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   }
 
   INCSTAT(g_stats.num_textures_uploaded);
+  INCSTAT(g_stats.this_frame.num_textures_uploaded);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
 
   entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
@@ -1777,20 +1876,22 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   textures_by_address.emplace(entry->addr, entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
+  INCSTAT(g_stats.this_frame.num_textures_uploaded);
 
   if (g_ActiveConfig.bDumpXFBTarget || g_ActiveConfig.bGraphicMods)
   {
     const std::string id = fmt::format("{}x{}", width, height);
     if (g_ActiveConfig.bGraphicMods)
     {
-      entry->texture_info_name = fmt::format("{}_{}", XFB_DUMP_PREFIX, id);
+      entry->SetTextureInfoName(fmt::format("{}_{}", XFB_DUMP_PREFIX, id));
     }
 
     if (g_ActiveConfig.bDumpXFBTarget)
     {
-      entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
-                                       XFB_DUMP_PREFIX, xfb_count++, id),
-                           0);
+      SaveDumpedTexture(entry->texture.get(),
+                        fmt::format("{}{}_n{:06}_{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
+                                    XFB_DUMP_PREFIX, xfb_count++, id),
+                        0);
     }
   }
 
@@ -2224,15 +2325,16 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         const std::string id = fmt::format("{}x{}", tex_w, tex_h);
         if (g_ActiveConfig.bGraphicMods)
         {
-          entry->texture_info_name = fmt::format("{}_{}", XFB_DUMP_PREFIX, id);
+          entry->SetTextureInfoName(fmt::format("{}_{}", XFB_DUMP_PREFIX, id));
         }
 
         if (g_ActiveConfig.bDumpXFBTarget)
         {
-          entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png",
-                                           File::GetUserPath(D_DUMPTEXTURES_IDX), XFB_DUMP_PREFIX,
-                                           xfb_count++, id),
-                               0);
+          SaveDumpedTexture(entry->texture.get(),
+                            fmt::format("{}{}_n{:06}_{}.png",
+                                        File::GetUserPath(D_DUMPTEXTURES_IDX), XFB_DUMP_PREFIX,
+                                        xfb_count++, id),
+                            0);
         }
       }
       else if (g_ActiveConfig.bDumpEFBTarget || g_ActiveConfig.bGraphicMods)
@@ -2240,16 +2342,17 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         const std::string id = fmt::format("{}x{}_{}", tex_w, tex_h, static_cast<int>(baseFormat));
         if (g_ActiveConfig.bGraphicMods)
         {
-          entry->texture_info_name = fmt::format("{}_{}", EFB_DUMP_PREFIX, id);
+          entry->SetTextureInfoName(fmt::format("{}_{}", EFB_DUMP_PREFIX, id));
         }
 
         if (g_ActiveConfig.bDumpEFBTarget)
         {
           static int efb_count = 0;
-          entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png",
-                                           File::GetUserPath(D_DUMPTEXTURES_IDX), EFB_DUMP_PREFIX,
-                                           efb_count++, id),
-                               0);
+          SaveDumpedTexture(entry->texture.get(),
+                            fmt::format("{}{}_n{:06}_{}.png",
+                                        File::GetUserPath(D_DUMPTEXTURES_IDX), EFB_DUMP_PREFIX,
+                                        efb_count++, id),
+                            0);
         }
       }
     }
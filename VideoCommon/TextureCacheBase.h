@@ -18,6 +18,7 @@
 
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
+#include "Common/ImageWriter.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
@@ -156,10 +157,14 @@ public:
     bool pending_efb_copy_invalidated = false;
 
     std::string texture_info_name = "";
+    // What graphics mods look the texture up by
+    u64 texture_info_hash = 0;
 
     explicit TCacheEntry(std::unique_ptr<AbstractTexture> tex,
                          std::unique_ptr<AbstractFramebuffer> fb);
 
+    void SetTextureInfoName(std::string name);
+
     ~TCacheEntry();
 
     void SetGeneralParameters(u32 _addr, u32 _size, TextureAndTLUTFormat _format,
@@ -318,6 +323,7 @@ private:
   void StitchXFBCopy(TCacheEntry* entry_to_update);
 
   void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
+  void SaveDumpedTexture(AbstractTexture* texture, const std::string& filename, u32 level);
   void CheckTempSize(size_t required_size);
 
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
@@ -367,6 +373,7 @@ private:
   struct BackupConfig
   {
     int color_samples;
+    bool xxh64_hashing;
     bool texfmt_overlay;
     bool texfmt_overlay_center;
     bool hires_textures;
@@ -400,6 +407,9 @@ private:
   // We store this in the class so that the same staging texture can be used for multiple
   // readbacks, saving the overhead of allocating a new buffer every time.
   std::unique_ptr<AbstractStagingTexture> m_readback_texture;
+
+  // Encodes texture, EFB and XFB dumps, so that dumping doesn't stall the GPU thread
+  Common::ImageWriter m_dump_writer{16};
 };
 
 extern std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -579,6 +579,53 @@ static void TexDecoder_DecodeImpl_IA4(u32* dst, const u8* src, int width, int he
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                           TextureFormat texformat, const u8* tlut,
+                                           TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Decodes two horizontally adjacent blocks at once, the left one in the low lane and the right
+  // one in the high lane, so that each store writes 8 texels of one row
+  const __m256i mask_row0 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(6, 7, 7, 7, 4, 5, 5, 5, 2, 3, 3, 3, 0, 1, 1, 1));
+  const __m256i mask_row1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(14, 15, 15, 15, 12, 13, 13, 13, 10, 11, 11, 11, 8, 9, 9, 9));
+  for (int y = 0; y < height; y += 4)
+  {
+    int x = 0;
+    int yStep = (y / 4) * Wsteps4;
+    for (; x + 8 <= width; x += 8, yStep += 2)
+    {
+      const __m256i left = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+      const __m256i right = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep + 32));
+      const __m256i rows01 = _mm256_permute2x128_si256(left, right, 0x20);
+      const __m256i rows23 = _mm256_permute2x128_si256(left, right, 0x31);
+
+      _mm256_storeu_si256((__m256i*)(dst + (y + 0) * width + x),
+                          _mm256_shuffle_epi8(rows01, mask_row0));
+      _mm256_storeu_si256((__m256i*)(dst + (y + 1) * width + x),
+                          _mm256_shuffle_epi8(rows01, mask_row1));
+      _mm256_storeu_si256((__m256i*)(dst + (y + 2) * width + x),
+                          _mm256_shuffle_epi8(rows23, mask_row0));
+      _mm256_storeu_si256((__m256i*)(dst + (y + 3) * width + x),
+                          _mm256_shuffle_epi8(rows23, mask_row1));
+    }
+
+    // A leftover block at the end of the row
+    if (x < width)
+    {
+      const __m128i rows01 = _mm_loadu_si128((const __m128i*)(src + 32 * yStep));
+      const __m128i rows23 = _mm_loadu_si128((const __m128i*)(src + 32 * yStep + 16));
+      const __m128i mask0 = _mm256_castsi256_si128(mask_row0);
+      const __m128i mask1 = _mm256_castsi256_si128(mask_row1);
+      _mm_storeu_si128((__m128i*)(dst + (y + 0) * width + x), _mm_shuffle_epi8(rows01, mask0));
+      _mm_storeu_si128((__m128i*)(dst + (y + 1) * width + x), _mm_shuffle_epi8(rows01, mask1));
+      _mm_storeu_si128((__m128i*)(dst + (y + 2) * width + x), _mm_shuffle_epi8(rows23, mask0));
+      _mm_storeu_si128((__m128i*)(dst + (y + 3) * width + x), _mm_shuffle_epi8(rows23, mask1));
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_IA8_SSSE3(u32* dst, const u8* src, int width, int height,
                                             TextureFormat texformat, const u8* tlut,
@@ -774,6 +821,71 @@ static void TexDecoder_DecodeImpl_RGB565(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB5A3_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x0000001fL);
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0000000fL);
+  const __m256i kMask_x07 = _mm256_set1_epi32(0x00000007L);
+  const __m256i aVxff00 = _mm256_set1_epi32(0xFF000000L);
+  const __m128i kSwap16 = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+
+  // Two rows of a block are decoded at once, one in each lane. Unlike the SSSE3 version, both
+  // the RGB555 and the RGBA4443 results are always calculated, and each texel picks one of them
+  // depending on its top bit, so blocks that mix the two don't need a scalar fallback.
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy += 2, xStep += 2)
+      {
+        const __m128i rows =
+            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + 8 * xStep)), kSwap16);
+        const __m256i valV = _mm256_cvtepu16_epi32(rows);
+
+        // RGB555: swizzle bits 00012345 -> 12345123, alpha = 0xFF
+        const __m256i tmpr5 = _mm256_and_si256(_mm256_srli_epi32(valV, 10), kMask_x1f);
+        const __m256i tmpg5 = _mm256_and_si256(_mm256_srli_epi32(valV, 5), kMask_x1f);
+        const __m256i tmpb5 = _mm256_and_si256(valV, kMask_x1f);
+        const __m256i r5 =
+            _mm256_or_si256(_mm256_slli_epi32(tmpr5, 3), _mm256_srli_epi32(tmpr5, 2));
+        const __m256i g5 =
+            _mm256_or_si256(_mm256_slli_epi32(tmpg5, 3), _mm256_srli_epi32(tmpg5, 2));
+        const __m256i b5 =
+            _mm256_or_si256(_mm256_slli_epi32(tmpb5, 3), _mm256_srli_epi32(tmpb5, 2));
+        const __m256i rgb555 =
+            _mm256_or_si256(_mm256_or_si256(r5, _mm256_slli_epi32(g5, 8)),
+                            _mm256_or_si256(_mm256_slli_epi32(b5, 16), aVxff00));
+
+        // RGBA4443: swizzle bits 00001234 -> 12341234, alpha 00000123 -> 12312312
+        const __m256i tmpr4 = _mm256_and_si256(_mm256_srli_epi32(valV, 8), kMask_x0f);
+        const __m256i tmpg4 = _mm256_and_si256(_mm256_srli_epi32(valV, 4), kMask_x0f);
+        const __m256i tmpb4 = _mm256_and_si256(valV, kMask_x0f);
+        const __m256i tmpa3 = _mm256_and_si256(_mm256_srli_epi32(valV, 12), kMask_x07);
+        const __m256i r4 = _mm256_or_si256(_mm256_slli_epi32(tmpr4, 4), tmpr4);
+        const __m256i g4 = _mm256_or_si256(_mm256_slli_epi32(tmpg4, 4), tmpg4);
+        const __m256i b4 = _mm256_or_si256(_mm256_slli_epi32(tmpb4, 4), tmpb4);
+        const __m256i a3 = _mm256_or_si256(
+            _mm256_slli_epi32(tmpa3, 5),
+            _mm256_or_si256(_mm256_slli_epi32(tmpa3, 2), _mm256_srli_epi32(tmpa3, 1)));
+        const __m256i rgba4443 =
+            _mm256_or_si256(_mm256_or_si256(r4, _mm256_slli_epi32(g4, 8)),
+                            _mm256_or_si256(_mm256_slli_epi32(b4, 16), _mm256_slli_epi32(a3, 24)));
+
+        // Bit 15 selects the format
+        const __m256i is_rgb555 = _mm256_srai_epi32(_mm256_slli_epi32(valV, 16), 31);
+        const __m256i final = _mm256_blendv_epi8(rgba4443, rgb555, is_rgb555);
+
+        _mm_storeu_si128((__m128i*)(dst + (y + iy) * width + x), _mm256_castsi256_si128(final));
+        _mm_storeu_si128((__m128i*)(dst + (y + iy + 1) * width + x),
+                         _mm256_extracti128_si256(final, 1));
+      }
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_RGB5A3_SSSE3(u32* dst, const u8* src, int width, int height,
                                                TextureFormat texformat, const u8* tlut,
@@ -1001,6 +1113,65 @@ static void TexDecoder_DecodeImpl_RGB5A3(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGBA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                             TextureFormat texformat, const u8* tlut,
+                                             TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Decodes two horizontally adjacent blocks at once, the left one in the low lane and the right
+  // one in the high lane, so that each store writes 8 texels of one row
+  const __m256i mask0312 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(12, 15, 13, 14, 8, 11, 9, 10, 4, 7, 5, 6, 0, 3, 1, 2));
+  for (int y = 0; y < height; y += 4)
+  {
+    int x = 0;
+    int yStep = (y / 4) * Wsteps4;
+    for (; x + 8 <= width; x += 8, yStep += 2)
+    {
+      const u8* src2 = src + 64 * yStep;
+      const __m256i ar_left = _mm256_loadu_si256((const __m256i*)src2);
+      const __m256i gb_left = _mm256_loadu_si256((const __m256i*)src2 + 1);
+      const __m256i ar_right = _mm256_loadu_si256((const __m256i*)src2 + 2);
+      const __m256i gb_right = _mm256_loadu_si256((const __m256i*)src2 + 3);
+
+      const __m256i ar0 = _mm256_permute2x128_si256(ar_left, ar_right, 0x20);
+      const __m256i ar1 = _mm256_permute2x128_si256(ar_left, ar_right, 0x31);
+      const __m256i gb0 = _mm256_permute2x128_si256(gb_left, gb_right, 0x20);
+      const __m256i gb1 = _mm256_permute2x128_si256(gb_left, gb_right, 0x31);
+
+      const __m256i rgba00 = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(ar0, gb0), mask0312);
+      const __m256i rgba01 = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(ar0, gb0), mask0312);
+      const __m256i rgba10 = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(ar1, gb1), mask0312);
+      const __m256i rgba11 = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(ar1, gb1), mask0312);
+
+      _mm256_storeu_si256((__m256i*)(dst + (y + 0) * width + x), rgba00);
+      _mm256_storeu_si256((__m256i*)(dst + (y + 1) * width + x), rgba01);
+      _mm256_storeu_si256((__m256i*)(dst + (y + 2) * width + x), rgba10);
+      _mm256_storeu_si256((__m256i*)(dst + (y + 3) * width + x), rgba11);
+    }
+
+    // A leftover block at the end of the row
+    if (x < width)
+    {
+      const u8* src2 = src + 64 * yStep;
+      const __m128i mask = _mm256_castsi256_si128(mask0312);
+      const __m128i ar0 = _mm_loadu_si128((const __m128i*)src2);
+      const __m128i ar1 = _mm_loadu_si128((const __m128i*)src2 + 1);
+      const __m128i gb0 = _mm_loadu_si128((const __m128i*)src2 + 2);
+      const __m128i gb1 = _mm_loadu_si128((const __m128i*)src2 + 3);
+
+      _mm_storeu_si128((__m128i*)(dst + (y + 0) * width + x),
+                       _mm_shuffle_epi8(_mm_unpacklo_epi8(ar0, gb0), mask));
+      _mm_storeu_si128((__m128i*)(dst + (y + 1) * width + x),
+                       _mm_shuffle_epi8(_mm_unpackhi_epi8(ar0, gb0), mask));
+      _mm_storeu_si128((__m128i*)(dst + (y + 2) * width + x),
+                       _mm_shuffle_epi8(_mm_unpacklo_epi8(ar1, gb1), mask));
+      _mm_storeu_si128((__m128i*)(dst + (y + 3) * width + x),
+                       _mm_shuffle_epi8(_mm_unpackhi_epi8(ar1, gb1), mask));
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_RGBA8_SSSE3(u32* dst, const u8* src, int width, int height,
                                               TextureFormat texformat, const u8* tlut,
@@ -1450,7 +1621,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::IA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_IA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                       Wsteps8);
     else
@@ -1469,7 +1643,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGB5A3:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB5A3_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGB5A3_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                          Wsteps8);
     else
@@ -1478,7 +1655,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGBA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGBA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGBA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                         Wsteps8);
     else
@@ -12,6 +12,7 @@
 #include "VideoCommon/VertexLoader_Color.h"
 #include "VideoCommon/VertexLoader_Normal.h"
 #include "VideoCommon/VertexLoader_Position.h"
+#include "VideoCommon/VertexLoader_Specialized.h"
 #include "VideoCommon/VertexLoader_TextCoord.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -69,6 +70,7 @@ VertexLoader::VertexLoader(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
     : VertexLoaderBase(vtx_desc, vtx_attr)
 {
   CompileVertexTranslator();
+  m_specialized_run = VertexLoader_Specialized::GetFunction(m_VtxDesc, m_VtxAttr);
 
   // generate frac factors
   m_posScale = 1.0f / (1U << m_VtxAttr.g0.PosFrac);
@@ -255,6 +257,9 @@ int VertexLoader::RunVertices(DataReader src, DataReader dst, int count)
   g_video_buffer_read_ptr = src.GetPointer();
 
   m_numLoadedVertices += count;
+  if (m_specialized_run)
+    return m_specialized_run(this, src, dst, count);
+
   m_skippedVertices = 0;
 
   for (m_remaining = count - 1; m_remaining >= 0; m_remaining--)
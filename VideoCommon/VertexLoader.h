@@ -14,6 +14,8 @@
 class DataReader;
 class VertexLoader;
 typedef void (*TPipelineFunction)(VertexLoader* loader);
+// Loads count whole vertices, and returns how many weren't skipped
+typedef int (*TVertexRunFunction)(VertexLoader* loader, DataReader src, DataReader dst, int count);
 
 class VertexLoader : public VertexLoaderBase
 {
@@ -41,6 +43,8 @@ private:
   // Pipeline.
   TPipelineFunction m_PipelineStages[64];  // TODO - figure out real max. it's lower.
   int m_numPipelineStages;
+  // Used instead of the pipeline if the format has one
+  TVertexRunFunction m_specialized_run = nullptr;
 
   void CompileVertexTranslator();
 
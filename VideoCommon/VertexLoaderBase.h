@@ -34,6 +34,9 @@ public:
   bool operator==(const VertexLoaderUID& rh) const { return vid == rh.vid; }
   size_t GetHash() const { return hash; }
 
+  // The raw VCD and VAT values: vtx_desc.low, vtx_desc.high, g0, g1 and g2
+  const std::array<u32, 5>& GetData() const { return vid; }
+
 private:
   size_t CalculateHash() const
   {
@@ -75,7 +78,9 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
+  u64 m_numLoadedVertices = 0;
+  // Only measured while the statistics overlay is shown
+  u64 m_load_time_ns = 0;
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
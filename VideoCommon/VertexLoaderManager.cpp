@@ -4,6 +4,8 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -12,10 +14,15 @@
 #include <utility>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 
+#include "Core/ConfigManager.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
 
@@ -29,6 +36,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace VertexLoaderManager
@@ -49,6 +57,10 @@ static std::mutex s_vertex_loader_map_lock;
 static VertexLoaderMap s_vertex_loader_map;
 // TODO - change into array of pointers. Keep a map of all seen so far.
 
+// The UIDs of every loader the current game has used, so that they can be created on boot
+using VertexLoaderDiskCacheKey = std::array<u32, 5>;
+static LinearDiskCache<VertexLoaderDiskCacheKey, u8> s_disk_cache;
+
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
 
 BitSet8 g_main_vat_dirty;
@@ -58,6 +70,42 @@ u8 g_current_vat;    // Main only
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_main_vertex_loaders;
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_preprocess_vertex_loaders;
 
+static void LoadDiskCache()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id.empty())
+    return;
+
+  class CacheReader : public LinearDiskCacheReader<VertexLoaderDiskCacheKey, u8>
+  {
+  public:
+    void Read(const VertexLoaderDiskCacheKey& key, const u8* value, u32 value_size) override
+    {
+      TVtxDesc vtx_desc;
+      vtx_desc.low.Hex = key[0];
+      vtx_desc.high.Hex = key[1];
+      VAT vtx_attr;
+      vtx_attr.g0.Hex = key[2];
+      vtx_attr.g1.Hex = key[3];
+      vtx_attr.g2.Hex = key[4];
+
+      std::unique_ptr<VertexLoaderBase>& loader =
+          s_vertex_loader_map[VertexLoaderUID(vtx_desc, vtx_attr)];
+      if (!loader)
+      {
+        loader = VertexLoaderBase::CreateVertexLoader(vtx_desc, vtx_attr);
+        INCSTAT(g_stats.num_vertex_loaders);
+      }
+    }
+  };
+
+  const std::string filename = File::GetUserPath(D_CACHE_IDX) + game_id + ".vertexloadercache";
+  CacheReader reader;
+  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  const u32 count = s_disk_cache.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(VIDEO, "Created {} cached vertex loaders from {}", count, filename);
+}
+
 void Init()
 {
   MarkAllDirty();
@@ -66,13 +114,39 @@ void Init()
   for (auto& map_entry : g_preprocess_vertex_loaders)
     map_entry = nullptr;
   SETSTAT(g_stats.num_vertex_loaders, 0);
+
+  LoadDiskCache();
 }
 
 void Clear()
 {
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  s_disk_cache.Sync();
+  s_disk_cache.Close();
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
+  g_stats.vertex_loader_usage.clear();
+}
+
+void UpdateStatistics()
+{
+  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  std::vector<Statistics::VertexLoaderUsage>& usage = g_stats.vertex_loader_usage;
+  usage.clear();
+  for (const auto& [uid, loader] : s_vertex_loader_map)
+  {
+    if (loader->m_numLoadedVertices == 0)
+      continue;
+
+    const VertexLoaderDiskCacheKey& data = uid.GetData();
+    usage.push_back({fmt::format("VCD {:08x} {:08x} VAT {:08x} {:08x} {:08x}", data[0], data[1],
+                                 data[2], data[3], data[4]),
+                     loader->m_numLoadedVertices, loader->m_load_time_ns});
+  }
+
+  std::sort(usage.begin(), usage.end(), [](const auto& a, const auto& b) {
+    return a.num_vertices > b.num_vertices;
+  });
 }
 
 void UpdateVertexArrayPointers()
@@ -226,6 +300,7 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
           VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
       loader = s_vertex_loader_map[uid].get();
       INCSTAT(g_stats.num_vertex_loaders);
+      s_disk_cache.Append(uid.GetData(), nullptr, 0);
     }
     if (check_for_native_format)
     {
@@ -372,7 +447,18 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  if (g_ActiveConfig.bOverlayStats)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    count = loader->RunVertices(src, dst, count);
+    loader->m_load_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+  }
+  else
+  {
+    count = loader->RunVertices(src, dst, count);
+  }
 
   g_vertex_manager->AddIndices(primitive, count);
   g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
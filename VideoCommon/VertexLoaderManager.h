@@ -26,9 +26,14 @@ namespace VertexLoaderManager
 using NativeVertexFormatMap =
     std::unordered_map<PortableVertexDeclaration, std::unique_ptr<NativeVertexFormat>>;
 
+// Also creates the loaders that the current game used in earlier sessions, so that they don't
+// have to be generated in the middle of gameplay.
 void Init();
 void Clear();
 
+// Copies the usage of every vertex loader into g_stats.
+void UpdateStatistics();
+
 void MarkAllDirty();
 
 // Creates or obtains a pointer to a VertexFormat representing decl.
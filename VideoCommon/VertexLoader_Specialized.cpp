@@ -0,0 +1,253 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/VertexLoader_Specialized.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+#include "Common/Inline.h"
+#include "Common/Swap.h"
+
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/VertexLoaderManager.h"
+
+namespace
+{
+using VCF = VertexComponentFormat;
+
+template <typename T>
+constexpr ComponentFormat FormatOf()
+{
+  if constexpr (std::is_same_v<T, u8>)
+    return ComponentFormat::UByte;
+  else if constexpr (std::is_same_v<T, s8>)
+    return ComponentFormat::Byte;
+  else if constexpr (std::is_same_v<T, u16>)
+    return ComponentFormat::UShort;
+  else if constexpr (std::is_same_v<T, s16>)
+    return ComponentFormat::Short;
+  else
+    return ComponentFormat::Float;
+}
+
+// The conversions below must stay in step with the ones in VertexLoader_Position, _Normal and
+// _TextCoord.
+template <typename T>
+DOLPHIN_FORCE_INLINE float Scale(T val, float scale)
+{
+  if constexpr (std::is_same_v<T, float>)
+    return val;
+  else
+    return val * scale;
+}
+
+template <typename T>
+DOLPHIN_FORCE_INLINE float FracAdjust(T val)
+{
+  if constexpr (std::is_same_v<T, float>)
+    return val;
+  else
+    return val / float(1u << (sizeof(T) * 8 - std::is_signed_v<T> - 1));
+}
+
+template <typename T>
+DOLPHIN_FORCE_INLINE T ReadElement(const u8* data, u32 i)
+{
+  T value;
+  std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+// Finds where an attribute's N values of type T are, in the vertex itself if it is direct or in
+// its array otherwise. is_max is set for an index with every bit set, which skips the vertex when
+// it is a position index.
+template <VCF Type, typename T, u32 N>
+DOLPHIN_FORCE_INLINE const u8* GetAttributeData(DataReader& src, CPArray array, bool* is_max)
+{
+  if constexpr (Type == VCF::Direct)
+  {
+    const u8* data = src.GetPointer();
+    src.Skip<T>(N);
+    return data;
+  }
+  else
+  {
+    using I = std::conditional_t<Type == VCF::Index8, u8, u16>;
+    const I index = src.Read<I>();
+    *is_max = index == std::numeric_limits<I>::max();
+    return VertexLoaderManager::cached_arraybases[array] +
+           index * g_main_cp_state.array_strides[array];
+  }
+}
+
+// Positions are always XYZ, normals are N only, and texture coordinates are ST. Unused attributes
+// are NotPresent, and their type is ignored.
+template <bool PosMtx, VCF PosType, typename PosT, VCF NrmType, typename NrmT, VCF ColType,
+          ColorFormat ColFormat, VCF TexType, typename TexT>
+int RunVertices(VertexLoader* loader, DataReader src, DataReader dst, int count)
+{
+  const float pos_scale = loader->m_posScale;
+  const float tc_scale = loader->m_tcScale[0];
+  int skipped = 0;
+  bool is_max = false;
+
+  for (int remaining = count - 1; remaining >= 0; remaining--)
+  {
+    u8* const vertex_start = dst.GetPointer();
+
+    if constexpr (PosMtx)
+    {
+      const u32 posmtx = src.Read<u8>() & 0x3f;
+      if (remaining < 3)
+        VertexLoaderManager::position_matrix_index_cache[remaining] = posmtx;
+      dst.Write(posmtx);
+    }
+
+    bool skip = false;
+    const u8* position = GetAttributeData<PosType, PosT, 3>(src, CPArray::Position, &skip);
+    for (u32 i = 0; i < 3; i++)
+    {
+      const float value = Scale(ReadElement<PosT>(position, i), pos_scale);
+      if (remaining < 3)
+        VertexLoaderManager::position_cache[remaining][i] = value;
+      dst.Write(value);
+    }
+
+    if constexpr (NrmType != VCF::NotPresent)
+    {
+      const u8* normal = GetAttributeData<NrmType, NrmT, 3>(src, CPArray::Normal, &is_max);
+      for (u32 i = 0; i < 3; i++)
+        dst.Write(FracAdjust(ReadElement<NrmT>(normal, i)));
+    }
+
+    if constexpr (ColType != VCF::NotPresent)
+    {
+      static_assert(ColFormat == ColorFormat::RGB888 || ColFormat == ColorFormat::RGBA8888);
+      constexpr u32 size = ColFormat == ColorFormat::RGB888 ? 3 : 4;
+      const u8* color = GetAttributeData<ColType, u8, size>(src, CPArray::Color0, &is_max);
+      u32 value;
+      std::memcpy(&value, color, sizeof(u32));
+      if constexpr (ColFormat == ColorFormat::RGB888)
+        value |= 0xFF000000;
+      dst.Write(value);
+    }
+
+    if constexpr (TexType != VCF::NotPresent)
+    {
+      const u8* texcoord = GetAttributeData<TexType, TexT, 2>(src, CPArray::TexCoord0, &is_max);
+      for (u32 i = 0; i < 2; i++)
+        dst.Write(Scale(ReadElement<TexT>(texcoord, i), tc_scale));
+    }
+
+    if (skip)
+    {
+      dst = vertex_start;
+      skipped++;
+    }
+  }
+
+  return count - skipped;
+}
+
+struct Loader
+{
+  bool pos_mtx;
+  VCF position;
+  ComponentFormat position_format;
+  VCF normal;
+  ComponentFormat normal_format;
+  VCF color;
+  ColorFormat color_format;
+  VCF texcoord;
+  ComponentFormat texcoord_format;
+  TVertexRunFunction function;
+};
+
+template <bool PosMtx, VCF PosType, typename PosT, VCF NrmType, typename NrmT, VCF ColType,
+          ColorFormat ColFormat, VCF TexType, typename TexT>
+constexpr Loader Specialize()
+{
+  return {PosMtx,
+          PosType,
+          FormatOf<PosT>(),
+          NrmType,
+          FormatOf<NrmT>(),
+          ColType,
+          ColFormat,
+          TexType,
+          FormatOf<TexT>(),
+          RunVertices<PosMtx, PosType, PosT, NrmType, NrmT, ColType, ColFormat, TexType, TexT>};
+}
+
+constexpr VCF None = VCF::NotPresent;
+constexpr VCF Direct = VCF::Direct;
+constexpr VCF Index8 = VCF::Index8;
+constexpr VCF Index16 = VCF::Index16;
+constexpr ColorFormat NoColor = ColorFormat::RGBA8888;
+constexpr ColorFormat RGB888 = ColorFormat::RGB888;
+constexpr ColorFormat RGBA8888 = ColorFormat::RGBA8888;
+
+// Direct formats are mostly 2D: menus, HUDs and EFB effects. Indexed ones are models, with the
+// matrix index for skinned ones.
+constexpr std::array s_loaders = {
+    Specialize<false, Direct, float, None, float, Direct, RGBA8888, None, float>(),
+    Specialize<false, Direct, float, None, float, Direct, RGBA8888, Direct, float>(),
+    Specialize<false, Direct, float, None, float, None, NoColor, Direct, float>(),
+    Specialize<false, Direct, s16, None, float, Direct, RGBA8888, Direct, s16>(),
+    Specialize<false, Direct, s16, None, float, None, NoColor, Direct, s16>(),
+    Specialize<false, Index16, float, Index16, float, None, NoColor, Index16, float>(),
+    Specialize<false, Index16, s16, Index16, s16, None, NoColor, Index16, s16>(),
+    Specialize<false, Index16, s16, Index16, s8, None, NoColor, Index16, s16>(),
+    Specialize<false, Index16, float, Index16, float, Index16, RGBA8888, Index16, float>(),
+    Specialize<false, Index16, s16, Index16, s8, Index16, RGBA8888, Index16, s16>(),
+    Specialize<false, Index16, float, None, float, Index16, RGBA8888, Index16, float>(),
+    Specialize<false, Index16, float, None, float, Index16, RGB888, Index16, float>(),
+    Specialize<false, Index16, float, Index16, float, None, NoColor, None, float>(),
+    Specialize<false, Index8, float, Index8, float, None, NoColor, Index8, float>(),
+    Specialize<true, Index16, float, Index16, float, None, NoColor, Index16, float>(),
+    Specialize<true, Index16, s16, Index16, s16, None, NoColor, Index16, s16>(),
+    Specialize<true, Index16, s16, Index16, s8, None, NoColor, Index16, s16>(),
+};
+}  // Anonymous namespace
+
+TVertexRunFunction VertexLoader_Specialized::GetFunction(const TVtxDesc& vtx_desc,
+                                                         const VAT& vtx_attr)
+{
+  // Only the position matrix, position, normal, color 0 and texture coordinate 0 are covered
+  if (vtx_desc.low.Position == VCF::NotPresent || vtx_desc.low.Color1 != VCF::NotPresent ||
+      (vtx_desc.low.Hex & 0x1FE) != 0 || (vtx_desc.high.Hex & ~0x3u) != 0)
+  {
+    return nullptr;
+  }
+
+  const VCF normal = vtx_desc.low.Normal;
+  const VCF color = vtx_desc.low.Color0;
+  const VCF texcoord = vtx_desc.high.Tex0Coord;
+  if (vtx_attr.g0.PosElements != CoordComponentCount::XYZ ||
+      (normal != VCF::NotPresent && vtx_attr.g0.NormalElements != NormalComponentCount::N) ||
+      (texcoord != VCF::NotPresent && vtx_attr.GetTexElements(0) != TexComponentCount::ST))
+  {
+    return nullptr;
+  }
+
+  for (const Loader& loader : s_loaders)
+  {
+    if (loader.pos_mtx == vtx_desc.low.PosMatIdx && loader.position == vtx_desc.low.Position &&
+        loader.position_format == vtx_attr.g0.PosFormat && loader.normal == normal &&
+        (normal == VCF::NotPresent || loader.normal_format == vtx_attr.g0.NormalFormat) &&
+        loader.color == color &&
+        (color == VCF::NotPresent || loader.color_format == vtx_attr.GetColorFormat(0)) &&
+        loader.texcoord == texcoord &&
+        (texcoord == VCF::NotPresent || loader.texcoord_format == vtx_attr.GetTexFormat(0)))
+    {
+      return loader.function;
+    }
+  }
+
+  return nullptr;
+}
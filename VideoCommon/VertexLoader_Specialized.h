@@ -0,0 +1,18 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "VideoCommon/VertexLoader.h"
+
+struct TVtxDesc;
+struct VAT;
+
+// Whole-vertex loaders for the most common vertex formats, with every attribute's conversion known
+// at compile time. The per-attribute pipeline in VertexLoader covers everything else.
+class VertexLoader_Specialized
+{
+public:
+  // Returns nullptr if there is no specialized loader for the format.
+  static TVertexRunFunction GetFunction(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
+};
@@ -453,10 +453,10 @@ void VertexManagerBase::Flush()
   CalculateBinormals(VertexLoaderManager::GetCurrentVertexFormat());
   // Calculate ZSlope for zfreeze
   const auto used_textures = UsedTextures();
-  std::vector<std::string> texture_names;
+  std::vector<u64> texture_hashes;
   if (!m_cull_all)
   {
-    if (!g_ActiveConfig.bGraphicMods)
+    if (!g_ActiveConfig.bGraphicMods || !g_renderer->GetGraphicsModManager().HasTextureTargets())
     {
       for (const u32 i : used_textures)
       {
@@ -470,12 +470,12 @@ void VertexManagerBase::Flush()
         const auto cache_entry = g_texture_cache->Load(TextureInfo::FromStage(i));
         if (cache_entry)
         {
-          texture_names.push_back(cache_entry->texture_info_name);
+          texture_hashes.push_back(cache_entry->texture_info_hash);
         }
       }
     }
   }
-  VertexShaderManager::SetConstants(texture_names);
+  VertexShaderManager::SetConstants(texture_hashes);
   if (!bpmem.genMode.zfreeze)
   {
     // Must be done after VertexShaderManager::SetConstants()
@@ -489,11 +489,11 @@ void VertexManagerBase::Flush()
 
   if (!m_cull_all)
   {
-    for (const auto& texture_name : texture_names)
+    for (const u64 texture_hash : texture_hashes)
     {
       bool skip = false;
       for (const auto action :
-           g_renderer->GetGraphicsModManager().GetDrawStartedActions(texture_name))
+           g_renderer->GetGraphicsModManager().GetDrawStartedActions(texture_hash))
       {
         action->OnDrawStarted(&skip);
       }
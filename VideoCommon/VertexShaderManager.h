@@ -20,7 +20,7 @@ public:
   static void DoState(PointerWrap& p);
 
   // constant management
-  static void SetConstants(const std::vector<std::string>& textures);
+  static void SetConstants(const std::vector<u64>& texture_hashes);
 
   static void InvalidateXFRange(int start, int end);
   static void SetTexMatrixChangedA(u32 value);
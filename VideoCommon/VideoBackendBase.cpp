@@ -41,6 +41,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameRecords.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -146,12 +147,16 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
 
   Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
 
-  AsyncRequests::Event e;
-  e.time = 0;
-  e.type = AsyncRequests::Event::PERF_QUERY;
-
   if (!g_perf_query->IsFlushed())
-    AsyncRequests::GetInstance()->PushEvent(e, true);
+  {
+    // Within the readback latency, only ask for whatever has finished by the time the GPU thread
+    // gets to it and answer with the results retired so far
+    const bool wait = g_perf_query->ShouldWaitForResults();
+    AsyncRequests::Event e;
+    e.time = 0;
+    e.type = wait ? AsyncRequests::Event::PERF_QUERY : AsyncRequests::Event::PERF_QUERY_POLL;
+    AsyncRequests::GetInstance()->PushEvent(e, wait);
+  }
 
   return g_perf_query->GetQueryResult(type);
 }
@@ -315,6 +320,7 @@ void VideoBackendBase::InitializeShared()
   GeometryShaderManager::Init();
   PixelShaderManager::Init();
   TMEM::Init();
+  FrameRecords::Init();
 
   g_Config.VerifyValidity();
   UpdateActiveConfig();
@@ -326,4 +332,5 @@ void VideoBackendBase::ShutdownShared()
 
   VertexLoaderManager::Clear();
   Fifo::Shutdown();
+  FrameRecords::Shutdown();
 }
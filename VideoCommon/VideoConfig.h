@@ -110,8 +110,11 @@ struct VideoConfig final
   std::string sDumpFormat;
   std::string sDumpPath;
   bool bInternalResolutionFrameDumps = false;
+  // Drop frames instead of waiting when encoding can't keep up with dumping
+  bool bFrameDumpDropLateFrames = false;
   bool bBorderlessFullscreen = false;
   bool bEnableGPUTextureDecoding = false;
+  bool bParallelTextureDecoding = false;
   int iBitrateKbps = 0;
   bool bGraphicMods = false;
   std::optional<GraphicsModGroupConfig> graphics_mod_config;
@@ -120,6 +123,7 @@ struct VideoConfig final
   bool bEFBAccessEnable = false;
   bool bEFBAccessDeferInvalidation = false;
   bool bPerfQueriesEnable = false;
+  int iReadbackLatency = 0;
   bool bBBoxEnable = false;
   bool bForceProgressive = false;
 
@@ -132,6 +136,7 @@ struct VideoConfig final
   bool bSkipPresentingDuplicateXFBs = false;
   bool bCopyEFBScaled = false;
   int iSafeTextureCache_ColorSamples = 0;
+  bool bTextureHashXXH64 = false;
   float fAspectRatioHackW = 1;  // Initial value needed for the first frame
   float fAspectRatioHackH = 1;
   bool bEnablePixelLighting = false;
@@ -142,6 +147,7 @@ struct VideoConfig final
   int iSaveTargetId = 0;  // TODO: Should be dropped
   u32 iMissingColorValue = 0;
   bool bFastTextureSampling = false;
+  bool bSkipGPU = false;
 
   // Stereoscopy
   StereoMode stereo_mode{};
@@ -161,6 +167,7 @@ struct VideoConfig final
   bool bDumpObjects = false;
   bool bDumpTevStages = false;
   bool bDumpTevTextureFetches = false;
+  bool bSWParallelRasterization = false;
 
   // Enable API validation layers, currently only supported with Vulkan.
   bool bEnableValidationLayer = false;
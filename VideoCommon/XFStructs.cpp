@@ -3,6 +3,8 @@
 
 #include "VideoCommon/XFStructs.h"
 
+#include <algorithm>
+
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -222,12 +224,27 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(xf_mem_transfer_size, xf_mem_base);
+    // Only the words that actually change are invalidated, so that reloading a matrix with the
+    // values it already holds neither flushes nor re-uploads anything
+    u32* const xf_mem = reinterpret_cast<u32*>(&xfmem) + xf_mem_base;
+    u32 changed_begin = xf_mem_transfer_size;
+    u32 changed_end = 0;
     for (u32 i = 0; i < xf_mem_transfer_size; i++)
     {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
+      if (xf_mem[i] != Common::swap32(data + i * 4))
+      {
+        changed_begin = std::min(changed_begin, i);
+        changed_end = i + 1;
+      }
+    }
+
+    if (changed_begin < changed_end)
+    {
+      XFMemWritten(changed_end - changed_begin, xf_mem_base + changed_begin);
+      for (u32 i = changed_begin; i < changed_end; i++)
+        xf_mem[i] = Common::swap32(data + i * 4);
     }
+    data += xf_mem_transfer_size * 4;
   }
 
   // write to XF regs
@@ -0,0 +1,94 @@
+// Benchmarks for guest memory backed by a MemArena, with and without huge pages. Reads chase a
+// random cycle through the whole segment so nearly every one of them lands on a page the TLB
+// doesn't hold, which is the access pattern huge pages are meant to help.
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/MemArena.h"
+
+namespace {
+
+// MEM1 and MEM2 as a Wii sees them, then a segment far larger than any TLB reaches
+constexpr std::array segment_sizes {
+  std::size_t {0x2000000},
+  std::size_t {0x4000000},
+  std::size_t {0x40000000},
+};
+
+constexpr std::size_t stride = 64;
+
+// A segment and a view of it where every cache line holds the offset of the next one to read
+struct bench_segment {
+  Common::MemArena arena;
+  std::size_t size;
+  std::uint8_t* view;
+
+  bench_segment(std::size_t size_, bool huge_pages) : size {size_} {
+    arena.GrabSHMSegment(size, huge_pages);
+    view = static_cast<std::uint8_t*>(arena.CreateView(0, size));
+    if (!view) return;
+
+    std::vector<std::uint32_t> order(size / stride);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin() + 1, order.end(), std::mt19937 {0});
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      auto next = static_cast<std::uint64_t>(order[(i + 1) % order.size()]) * stride;
+      std::copy_n(reinterpret_cast<std::uint8_t const*>(&next), sizeof(next),
+          view + static_cast<std::uint64_t>(order[i]) * stride);
+    }
+  }
+
+  ~bench_segment() {
+    if (view) arena.ReleaseView(view, size);
+    arena.ReleaseSHMSegment();
+  }
+};
+
+void segment_args(benchmark::internal::Benchmark* bench) {
+  for (auto size : segment_sizes) {
+    for (auto huge_pages : {0, 1}) bench->Args({static_cast<std::int64_t>(size), huge_pages});
+  }
+}
+
+void BM_ChaseView(benchmark::State& state) {
+  bench_segment segment {static_cast<std::size_t>(state.range(0)), state.range(1) != 0};
+  if (!segment.view) {
+    state.SkipWithError("Failed to map the segment");
+    return;
+  }
+
+  std::uint64_t offset = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < 1024; ++i) {
+      std::copy_n(segment.view + offset, sizeof(offset), reinterpret_cast<std::uint8_t*>(&offset));
+    }
+    benchmark::DoNotOptimize(offset);
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_ChaseView)->Apply(segment_args);
+
+void BM_FillView(benchmark::State& state) {
+  bench_segment segment {static_cast<std::size_t>(state.range(0)), state.range(1) != 0};
+  if (!segment.view) {
+    state.SkipWithError("Failed to map the segment");
+    return;
+  }
+
+  for (auto _ : state) {
+    for (std::size_t offset = 0; offset < segment.size; offset += 4096) segment.view[offset] ^= 1;
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * segment.size));
+}
+BENCHMARK(BM_FillView)->Apply(segment_args);
+
+}
+
+BENCHMARK_MAIN();
@@ -1,120 +1,240 @@
 /*----- System Includes -----*/
 
-#include <cstdio>
-#include <random>
-#include <limits>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstdint>
-#include <utility>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <variant>
 
 /*----- Local Includes -----*/
 
 #include "argh.h"
 #include "fmt/include/fmt/core.h"
+#include "fmt/include/fmt/format.h"
+#include "fmt/include/fmt/printf.h"
+#include "Common/BitSet.h"
+#include "Common/Config/Config.h"
+#include "Common/ENetUtil.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "Common/MsgHandler.h"
+#include "Common/Tracing.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigLoaders/HeadlessConfigLoader.h"
+#include "Core/Core.h"
+#include "Core/Host.h"
+#include "Core/HW/CPU.h"
+#include "Core/HW/EXI/EXI.h"
+#include "Core/HW/EXI/EXI_Device.h"
+#include "Core/HW/EXI/EXI_DeviceMemoryCard.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
+#include "Core/HW/GCMemcard/GCMemcardArchive.h"
+#include "Core/HW/GCMemcard/GCMemcardFixups.h"
+#include "Core/HW/GCMemcard/GCMemcardMemory.h"
+#include "Core/HW/GCMemcard/GCMemcardReadWatch.h"
+#include "Core/HW/GCMemcard/GCMemcardSchema.h"
+#include "Core/HW/GCMemcard/GCMemcardUtils.h"
+#include "Core/PowerPC/BreakPoints.h"
+#include "Core/PowerPC/JitCommon/JitCoverage.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
+#include "Core/StateRewind.h"
+#include "DiscIO/DiscExtractor.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/Volume.h"
+#include "UICommon/UICommon.h"
+#include "smashcardloader_common.h"
 
-/*----- Types -----*/
+#include <xxhash.h>
 
-using namespace std::string_literals;
-
-using Memcard::Savefile;
-using Memcard::GCMemcard;
-using Memcard::GCMemcardErrorCode;
-using Memcard::GCMemcardImportFileRetVal;
-using region_map = std::vector<std::vector<std::pair<std::size_t, std::size_t>>>;
+#ifndef _WIN32
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
-struct extract_failed : std::runtime_error {
-  extract_failed(std::string const& msg) : std::runtime_error(msg) {}
-};
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
 
-struct save_failed : std::runtime_error {
-  save_failed(std::string const& msg) : std::runtime_error(msg) {}
-};
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#endif
 
-template <class T, class U>
-using forward_like_t = std::conditional_t<
-  std::is_lvalue_reference_v<T>,
-  std::remove_reference_t<U>&,
-  std::remove_reference_t<U>&&
->;
+using namespace std::string_literals;
 
 /*----- Helpers -----*/
 
-// Monkey patch something I think should exist to start with
-namespace fmt {
-  template <class Ptr, class Str, class... Args>
-  void println(Ptr* stream, Str const& str, Args&&... args) {
-    auto newline = str + "\n"s;
-    print(stream, newline, std::forward<Args>(args)...);
+namespace {
+
+// Calls func(i) for every i in [0, count), spread across jobs threads.
+template <class F>
+void parallel_for(std::size_t count, unsigned jobs, F&& func) {
+  std::atomic<std::size_t> next {0};
+  auto worker = [&] {
+    for (auto i = next++; i < count; i = next++) func(i);
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned i = 1; i < jobs; ++i) workers.emplace_back(worker);
+  worker();
+  for (auto& thread : workers) thread.join();
+}
+
+// Calls func on every item pushed to it on threads of its own, so whoever pushes the items gets
+// on with the next one meanwhile. With one thread the items are processed in order. At most
+// limit items wait or are being processed at once and push blocks while the stage is full, which
+// ties a fast producer to the pace of a slow stage instead of letting it buffer without bound.
+// Every item pushed is processed before the stage is destroyed.
+template <class T>
+class pipeline_stage {
+public:
+  pipeline_stage(std::size_t limit, std::function<void(T)> func, std::size_t threads = 1)
+      : limit_ {std::max<std::size_t>(limit, 1)}, func_ {std::move(func)} {
+    for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i) {
+      threads_.emplace_back([this] { run(); });
+    }
   }
 
-  template <class Str, class... Args>
-  void println(Str const& str, Args&&... args) {
-    println(stdout, str, std::forward<Args>(args)...);
+  ~pipeline_stage() {
+    {
+      std::lock_guard lock {mutex_};
+      done_ = true;
+    }
+    ready_.notify_all();
+    for (auto& thread : threads_) thread.join();
   }
-}
 
-namespace {
+  void push(T item) {
+    {
+      std::unique_lock lock {mutex_};
+      room_.wait(lock, [this] { return items_.size() + busy_ < limit_; });
+      items_.push_back(std::move(item));
+    }
+    ready_.notify_one();
+  }
 
-template <class F, class... Args>
-bool any_of(F&& func, Args&&... args) {
-  return (std::forward<F>(func)(std::forward<Args>(args)) || ...);
-}
+private:
+  void run() {
+    std::unique_lock lock {mutex_};
+    while (true) {
+      ready_.wait(lock, [this] { return done_ || !items_.empty(); });
+      if (items_.empty()) return;
+      auto item = std::move(items_.front());
+      items_.pop_front();
+      ++busy_;
+      lock.unlock();
+      func_(std::move(item));
+      lock.lock();
+      --busy_;
+      room_.notify_all();
+    }
+  }
 
-template <class F, class... Args>
-bool none_of(F&& func, Args&&... args) {
-  return !any_of(std::forward<F>(func), std::forward<Args>(args)...);
-}
+  std::size_t limit_;
+  std::function<void(T)> func_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::condition_variable room_;
+  std::deque<T> items_;
+  std::size_t busy_ = 0;
+  bool done_ = false;
+  std::vector<std::thread> threads_;
+};
 
-template <class F, class... Args>
-bool all_of(F&& func, Args&&... args) {
-  return (std::forward<F>(func)(std::forward<Args>(args)) && ...);
-}
+// Writes the spans recorded until it goes out of scope as Chrome trace JSON, for --trace
+struct trace_writer {
+  std::string path;
 
-template <class F, class... Args>
-bool some_of(F&& func, Args&&... args) {
-  return !all_of(std::forward<F>(func), std::forward<Args>(args)...);
-}
+  ~trace_writer() {
+    if (!path.empty() && !Common::Tracing::WriteChromeTrace(path))
+      fmt::print(stderr, "Couldn't write trace to {}\n", path);
+  }
+};
 
-template <class T, class U>
-forward_like_t<T, U> forward_like(U&& val) noexcept {
-  return static_cast<forward_like_t<T, U>>(val);
+// The most memory this process and, separately, any of its finished children ever held.
+std::pair<std::uint64_t, std::uint64_t> peak_rss_bytes() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters {};
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return {0, 0};
+  return {counters.PeakWorkingSetSize, 0};
+#else
+  rusage self {}, children {};
+  getrusage(RUSAGE_SELF, &self);
+  getrusage(RUSAGE_CHILDREN, &children);
+#ifdef __APPLE__
+  std::uint64_t unit = 1;
+#else
+  std::uint64_t unit = 1024;
+#endif
+  return {self.ru_maxrss * unit, children.ru_maxrss * unit};
+#endif
 }
 
-template <class F, class C, class... Cs>
-void for_all(F&& func, C&& container, Cs&&... cs) {
-  // Make sure everything is the same size.
-  assert(all_of([] (auto& cont) { cont.size() == container.size(); }, cs...));
+// Writes the stage timings as JSON once it goes out of scope, for --stats. Executions are the
+// runs of the game, or the mutants generated when nothing runs.
+struct stats_writer {
+  std::string path;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-  // Collect and explode into iterators
-  std::size_t count = 0;
-  std::tuple iterators {container.begin(), cs.begin()...};
-  while (std::get<0>(iterators) != container.end()) {
-    std::apply([&func, &count] (auto& it, auto&... its) {
-      // Compute whether our callable would like an explicit count
-      constexpr bool takes_count = std::is_invocable_v<
-        F,
-        std::size_t,
-        forward_like_t<C, decltype(*it)>,
-        forward_like_t<Cs, decltype(*its)>...
-      >;
-
-      // Deference everything and call
-      if constexpr (takes_count) {
-        std::forward<F>(func)(count, forward_like<C>(*it), forward_like<Cs>(*its)...);
-      } else {
-        std::forward<F>(func)(forward_like<C>(*it), forward_like<Cs>(*its)...);
-      }
+  ~stats_writer() {
+    if (path.empty()) return;
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    auto calls = [] (stage which) {
+      return stage_times.calls[static_cast<std::size_t>(which)].load();
+    };
+    auto executions = calls(stage::run) ? calls(stage::run) : calls(stage::mutate);
+    auto [peak_rss, peak_rss_children] = peak_rss_bytes();
 
-      // Increment
-      ++count;
-      ++it, (++its, ...);
-    }, iterators);
+    std::string stages;
+    for (std::size_t i = 0; i < stage_totals::count; ++i) {
+      stages += fmt::format(R"({}"{}": {{"seconds": {:.6f}, "calls": {}}})", i ? ", " : "",
+          stage_name(static_cast<stage>(i)), stage_times.nanoseconds[i].load() / 1e9,
+          stage_times.calls[i].load());
+    }
+    auto json = fmt::format(R"({{"wall_seconds": {:.6f}, "executions": {}, )"
+        R"("executions_per_second": {:.3f}, "peak_rss_bytes": {}, "peak_rss_children_bytes": {}, )"
+        R"("stages": {{{}}}}})",
+        wall.count(), executions, wall.count() > 0 ? executions / wall.count() : 0.0, peak_rss,
+        peak_rss_children, stages);
+    if (!File::WriteStringToFile(path, json + "\n"))
+      fmt::print(stderr, "Couldn't write stats to {}\n", path);
   }
-}
+};
 
 /*----- Application Logic -----*/
 
@@ -141,29 +261,113 @@ void report_error(std::string_view name, GCMemcardErrorCode error) {
   std::abort();
 }
 
-auto extract_save(GCMemcard const& card) {
-  if (card.GetNumFiles() != 1) {
-    throw std::runtime_error("smashcardloader currently only supports cards with a single save file");
+void report_error(std::string_view name, Memcard::ReadSavefileErrorCode error) {
+  switch (error) {
+    case Memcard::ReadSavefileErrorCode::OpenFileFail:
+      fmt::println(stderr, R"(Failed to open save "{}")", name);
+      break;
+    case Memcard::ReadSavefileErrorCode::IOError:
+      fmt::println(stderr, R"(Detected an IO error while reading save "{}")", name);
+      break;
+    case Memcard::ReadSavefileErrorCode::DataCorrupted:
+      fmt::println(stderr, R"(Save "{}" is not a GCI, GCS or SAV file)", name);
+      break;
   }
+  std::abort();
+}
+
+// Whether name is a lone save rather than a whole card, going by its extension
+bool is_savefile(std::string const& name) {
+  auto ext = name.substr(std::min(name.rfind('.'), name.size()));
+  std::transform(ext.begin(), ext.end(), ext.begin(), [] (unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+  return ext == ".gci" || ext == ".gcs" || ext == ".sav";
+}
+
+// Reads a lone save straight from its file, without a card around it.
+Savefile read_save(std::string const& name) {
+  auto result = Memcard::ReadSavefile(name);
+  if (auto* error = std::get_if<Memcard::ReadSavefileErrorCode>(&result)) report_error(name, *error);
+  return std::get<Savefile>(std::move(result));
+}
+
+// Cards packed into an archive are named "<archive>.gcma#<entry>", and open like any other card.
+constexpr std::string_view archive_separator = ".gcma#";
+
+// The archive and entry name of an archived card, or nothing for a card file.
+std::optional<std::pair<std::string, std::string>> split_archived(std::string const& name) {
+  auto at = name.find(archive_separator);
+  if (at == std::string::npos) return std::nullopt;
+  auto entry = at + archive_separator.size();
+  return std::pair {name.substr(0, entry - 1), name.substr(entry)};
+}
+
+// Archives stay open once opened, since a corpus is read out of one card at a time.
+Memcard::GCMemcardArchive* open_archive(std::string const& path) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::unique_ptr<Memcard::GCMemcardArchive>> archives;
+  std::lock_guard lock {mutex};
+  auto& archive = archives[path];
+  if (!archive) archive = Memcard::GCMemcardArchive::Open(path);
+  return archive.get();
+}
+
+// Opens a card file, or decompresses an archived card straight into memory.
+std::pair<GCMemcardErrorCode, std::optional<GCMemcard>> open_card(std::string const& name,
+    GCMemcardOpenOptions const& options) {
+  stage_timer timer {stage::open};
+  auto archived = split_archived(name);
+  if (!archived) return GCMemcard::OpenMapped(name, options);
 
-  auto save = card.ExportFile(0);
-  if (!save) {
-    throw extract_failed("Failed to extract save file");
+  auto* archive = open_archive(archived->first);
+  auto entry = archive ? archive->FindEntry(archived->second) : std::nullopt;
+  auto image = entry ? archive->ReadImage(*entry) : std::nullopt;
+  if (!image) {
+    GCMemcardErrorCode error;
+    error.Set(Memcard::GCMemcardValidityIssues::FAILED_TO_OPEN);
+    return {error, std::nullopt};
   }
-  return *save;
+  return GCMemcard::OpenImage(image->data(), image->size(), options);
 }
 
-void store_save(GCMemcard& card, Savefile const& save) {
-  if (card.GetNumFiles() != 1) {
-    throw std::runtime_error("smashcardloader currently only supports cards with a single save file");
+bool is_archive(std::string const& path) {
+  auto extension = archive_separator.substr(0, archive_separator.size() - 1);
+  return path.size() > extension.size() &&
+      path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+// Adds the card at path to names, or every card in it if it's an archive.
+void add_cards(std::string const& path, std::vector<std::string>& names) {
+  auto* archive = is_archive(path) ? open_archive(path) : nullptr;
+  if (!archive) {
+    names.push_back(path);
+    return;
+  }
+  // Only the last entry of a name can be opened
+  auto& entries = archive->GetEntries();
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    if (archive->FindEntry(entries[i].name) == i) {
+      names.push_back(fmt::format("{}#{}", path, entries[i].name));
+    }
   }
+}
 
-  card.RemoveFile(0);
-  auto res = card.ImportFile(save);
-  if (res != GCMemcardImportFileRetVal::SUCCESS) {
-    throw save_failed("Failed to overwrite original save data");
+// For every save in base, the save in other with the same identity, or nullptr if there's none.
+// Saves that changed size can't be diffed block by block, so unless same_size is false they count
+// as unmatched.
+auto pair_saves(std::vector<Savefile> const& base, std::vector<Savefile> const& other,
+    bool same_size = true) {
+  std::vector<Savefile const*> partners(base.size(), nullptr);
+  for (std::size_t i = 0; i < base.size(); ++i) {
+    auto match = std::find_if(other.begin(), other.end(), [&] (auto& save) {
+      return Memcard::HasSameIdentity(base[i].dir_entry, save.dir_entry);
+    });
+    if (match != other.end() && (!same_size || match->blocks.size() == base[i].blocks.size())) {
+      partners[i] = &*match;
+    }
   }
-  card.FixChecksums();
+  return partners;
 }
 
 auto extract_filename(Savefile const& save) {
@@ -173,153 +377,3650 @@ auto extract_filename(Savefile const& save) {
   return name;
 }
 
-auto calculate_diffs(Savefile const& lhscard, Savefile const& rhscard) {
-  // Iterate over the blocks of both and diff
-  region_map diffs;
-  for_all([&diffs] (auto& lhsblock, auto& rhsblock) {
-    // Setup bookeeping
-    diffs.emplace_back();
-    auto& lhsdata = lhsblock.m_block;
-    auto& rhsdata = rhsblock.m_block;
-    auto lhsptr = lhsdata.begin(), rhsptr = rhsdata.begin();
-    assert(lhsdata.size() == rhsdata.size());
-
-    // Iterate until we've exhausted all data.
-    while (lhsptr != lhsdata.end()) {
-      // Find the next disagreement.
-      std::tie(lhsptr, rhsptr) = std::mismatch(lhsptr, lhsdata.end(), rhsptr);
-
-      // Spin until we hit the end
-      auto start = lhsptr;
-      while (lhsptr != lhsdata.end() && *lhsptr != *rhsptr) ++lhsptr, ++rhsptr;
-
-      // Compute offsets
-      auto base = start - lhsdata.begin();
-      auto diff = lhsptr - start;
-      diffs.back().emplace_back(base, base + diff);
-    }
-  }, lhscard.blocks, rhscard.blocks);
-  return diffs;
+// Diffs every save against the first one in a single pass over the blocks. Blocks are
+// independent, so each worker owns whole blocks and keeps the base block hot in cache
+// while it streams the same block of every other card past it.
+auto calculate_corpus_diffs(std::vector<Savefile const*> const& saves, unsigned jobs) {
+  TRACE_SPAN("calculate_corpus_diffs");
+  stage_timer timer {stage::diff};
+  auto& base = *saves.front();
+  auto block_count = base.blocks.size();
+  for (auto* save : saves) {
+    if (save->blocks.size() != block_count) {
+      throw std::runtime_error("Every card in a corpus must hold a save of the same size");
+    }
+  }
+
+  corpus_diffs corpus;
+  std::vector<diff_mask> masks(block_count);
+  corpus.varies.resize(block_count);
+  corpus.counts.resize(block_count * Memcard::BLOCK_SIZE);
+  parallel_for(block_count, jobs, [&] (std::size_t block) {
+    auto& any = masks[block];
+    diff_mask mask;
+    any.fill(0);
+    auto* counts = &corpus.counts[block * Memcard::BLOCK_SIZE];
+    for (std::size_t card = 1; card < saves.size(); ++card) {
+      mask_block(base.blocks[block], saves[card]->blocks[block], mask);
+      for (std::size_t word = 0; word < mask.size(); ++word) {
+        any[word] |= mask[word];
+        for (auto bits = mask[word]; bits; bits &= bits - 1) {
+          ++counts[word * 64 + Common::LeastSignificantSetBit(bits)];
+        }
+      }
+    }
+    corpus.varies[block] = std::any_of(any.begin(), any.end(), [] (auto bits) { return bits != 0; });
+  });
+
+  // The flat map is built in block order, so runs are only extracted once every worker is done.
+  corpus.regions.reserve(block_count, block_count);
+  for (auto& any : masks) emit_regions(any, corpus.regions);
+  return corpus;
 }
 
-void print_diffs(region_map const& diffs) {
-  int current = 0;
-  for (auto& regions : diffs) {
-    fmt::println("Printing diff ranges for block {}:", current++);
-    std::string region = "[";
-    for (auto& [start, end] : regions) {
-      region += fmt::format(" [{}, {}],", start, end);
+// Expands the positional arguments into card paths, searching any directories given.
+auto collect_cards(argh::parser const& cli) {
+  std::vector<std::string> names;
+  for (std::size_t i = 1; i < cli.size(); ++i) {
+    auto& arg = cli.pos_args()[i];
+    if (File::IsDirectory(arg)) {
+      for (auto& found : Common::DoFileSearch({arg}, {".raw", ".gcp", ".mcr", ".gcma"})) {
+        add_cards(found, names);
+      }
+    } else {
+      add_cards(arg, names);
     }
-    region.pop_back();
-    region += " ]";
-    fmt::println(region);
   }
+  return names;
 }
 
-void scramble_diffs(Savefile& card, region_map const& diffs,
-    std::unordered_set<int> const& targets, int mutations, int chunk_size, int minimum_size) {
-  // Initialize random engine once.
-  std::mt19937 engine(std::random_device {}());
-  std::uniform_int_distribution<std::uint8_t> rand_byte(0, 255);
+void print_counts(corpus_diffs const& corpus) {
+  for (std::size_t block = 0; block < corpus.regions.size(); ++block) {
+    if (!corpus.varies[block]) continue;
 
-  // Mutate the blocks
-  int mutation_count = 0;
-  for_all([&] (auto iteration, auto& block, auto& regions) {
-    // Skip if given targets
-    if (mutation_count >= mutations || !targets.empty() && !targets.count(iteration)) {
-      return;
+    fmt::println("Printing variation counts for block {}:", block);
+    auto* counts = &corpus.counts[block * Memcard::BLOCK_SIZE];
+    std::string line = "[";
+    for (auto& [start, end] : corpus.regions[block]) {
+      for (auto offset = start; offset < end; ++offset) {
+        line += fmt::format(" {}: {},", offset, counts[offset]);
+      }
+    }
+    line.pop_back();
+    line += " ]";
+    fmt::println(line);
+  }
+}
+
+std::string json_escape(std::string_view text) {
+  std::string out;
+  for (char c : text) {
+    switch (c) {
+      case '"': out += R"(\")"; break;
+      case '\\': out += R"(\\)"; break;
+      case '\n': out += R"(\n)"; break;
+      case '\t': out += R"(\t)"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += fmt::format("\\u{:04x}", static_cast<int>(c));
+        } else {
+          out.push_back(c);
+        }
+    }
+  }
+  return out;
+}
+
+enum class report_format { text, json, binary };
+
+std::optional<report_format> parse_report_format(std::string_view name) {
+  if (name == "text") return report_format::text;
+  if (name == "json") return report_format::json;
+  if (name == "binary") return report_format::binary;
+  return std::nullopt;
+}
+
+// Binary diff reports are little endian regardless of host:
+//   "SCLD" | u32 version | u32 record size
+//   then per region: u32 save | u32 block | u32 offset | u32 length | u64 card offset
+// Saves without a card around them have a card offset of all ones.
+constexpr std::uint32_t diff_record_size = 24;
+
+// Streams the diff regions of saves to a file as they're added, through a buffer that's flushed
+// whenever it fills up, so even dense diffs never sit in memory as text.
+class diff_report {
+public:
+  diff_report(std::FILE* out, report_format format) : out_ {out}, format_ {format} {
+    if (format_ == report_format::binary) {
+      append_le(0x444C4353, 4);
+      append_le(1, 4);
+      append_le(diff_record_size, 4);
+    }
+  }
+
+  ~diff_report() {
+    flush();
+    std::fflush(out_);
+  }
+
+  // chain holds the card block of every block of the save, or is null for a lone save. Regions
+  // are split wherever a field of the save starts or ends, and named after the field they're in.
+  void add_save(std::size_t index, std::string_view name, region_map const& diffs,
+      std::vector<std::uint16_t> const* chain, Memcard::SaveFieldMap const& fields) {
+    if (format_ == report_format::text) {
+      fmt::format_to(std::back_inserter(buffer_), "Printing diffs for save \"{}\":\n", name);
+    }
+    for (std::size_t block = 0; block < diffs.size(); ++block) {
+      if (format_ == report_format::text) {
+        fmt::format_to(std::back_inserter(buffer_), "Printing diff ranges for block {}:\n[", block);
+      }
+      auto first = true;
+      auto add_region = [&] (std::uint32_t start, std::uint32_t end,
+          Memcard::SaveField const* field) {
+        auto card_offset = chain ?
+            std::uint64_t {(*chain)[block]} * Memcard::BLOCK_SIZE + start : ~std::uint64_t {0};
+        switch (format_) {
+          case report_format::text:
+            fmt::format_to(std::back_inserter(buffer_), "{} [{}, {}]", first ? "" : ",", start,
+                end);
+            if (field) fmt::format_to(std::back_inserter(buffer_), " {}", field->name);
+            break;
+          case report_format::json:
+            fmt::format_to(std::back_inserter(buffer_), R"({{"save": "{}", "block": {}, )"
+                R"("offset": {}, "length": {}, "card_offset": {}, "field": {}}})" "\n",
+                json_escape(name), block, start, end - start,
+                chain ? fmt::format("{}", card_offset) : "null",
+                field ? fmt::format(R"("{}")", json_escape(field->name)) : "null");
+            break;
+          case report_format::binary: {
+            append_le(index, 4);
+            append_le(block, 4);
+            append_le(start, 4);
+            append_le(end - start, 4);
+            append_le(card_offset, 8);
+            break;
+          }
+        }
+        first = false;
+        if (buffer_.size() >= flush_size) flush();
+      };
+      auto block_offset = static_cast<std::uint32_t>(block * Memcard::BLOCK_SIZE);
+      for (auto [start, end] : diffs[block]) {
+        if (start == end) continue;
+        fields.ForEachPiece(block_offset + start, block_offset + end,
+            [&] (std::uint32_t piece_start, std::uint32_t piece_end,
+                Memcard::SaveField const* field) {
+              add_region(piece_start - block_offset, piece_end - block_offset, field);
+            });
+      }
+      if (format_ == report_format::text) {
+        fmt::format_to(std::back_inserter(buffer_), " ]\n");
+      }
+    }
+  }
+
+private:
+  static constexpr std::size_t flush_size = 1 << 16;
+
+  void append_le(std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) buffer_.push_back(static_cast<char>(value >> (i * 8)));
+  }
+
+  void flush() {
+    std::fwrite(buffer_.data(), 1, buffer_.size(), out_);
+    buffer_.clear();
+  }
+
+  std::FILE* out_;
+  report_format format_;
+  fmt::memory_buffer buffer_;
+};
+
+/*----- Live Bytes -----*/
+
+// Live masks hold a bit per card byte, least significant first, set for the bytes a probe run saw
+// the game read.
+void write_live_mask(std::string const& path, std::vector<bool> const& live) {
+  std::string out((live.size() + 7) / 8, '\0');
+  for (std::size_t i = 0; i < live.size(); ++i) {
+    if (live[i]) out[i / 8] |= static_cast<char>(1 << (i % 8));
+  }
+  if (!File::WriteStringToFile(path, out)) {
+    fmt::println(stderr, R"(Failed to write live mask "{}")", path);
+    std::abort();
+  }
+}
+
+std::string read_live_mask(std::string const& path, std::size_t card_size) {
+  std::string mask;
+  if (!File::ReadFileToString(path, mask) || mask.size() != (card_size + 7) / 8) {
+    fmt::println(stderr, R"(Failed to read live mask "{}" for a {} byte card)", path, card_size);
+    std::abort();
+  }
+  return mask;
+}
+
+// Narrows a save's diff regions down to the bytes the live mask has set. chain holds the card
+// block of every save block.
+region_map restrict_to_live(region_map const& diffs, std::vector<std::uint16_t> const& chain,
+    std::string const& mask) {
+  auto live = [&] (std::size_t offset) { return (mask[offset / 8] >> (offset % 8)) & 1; };
+  region_map restricted;
+  restricted.reserve(diffs.size(), diffs.range_count());
+  for (std::size_t block = 0; block < diffs.size(); ++block) {
+    restricted.push_block();
+    std::size_t card_offset = std::size_t {chain[block]} * Memcard::BLOCK_SIZE;
+    for (auto [start, end] : diffs[block]) {
+      for (std::size_t offset = start; offset < end;) {
+        if (!live(card_offset + offset)) {
+          ++offset;
+          continue;
+        }
+        auto run_start = offset;
+        while (offset < end && live(card_offset + offset)) ++offset;
+        restricted.push_range(run_start, offset);
+      }
+    }
+  }
+  return restricted;
+}
+
+/*----- Save Fields -----*/
+
+// Narrows a save's diff regions down to the bytes of the named fields of its layout.
+region_map restrict_to_fields(region_map const& diffs, Memcard::SaveFieldMap const& fields,
+    std::unordered_set<std::string> const& names) {
+  region_map restricted;
+  restricted.reserve(diffs.size(), diffs.range_count());
+  for (std::size_t block = 0; block < diffs.size(); ++block) {
+    restricted.push_block();
+    auto block_offset = static_cast<std::uint32_t>(block * Memcard::BLOCK_SIZE);
+    for (auto [start, end] : diffs[block]) {
+      fields.ForEachPiece(block_offset + start, block_offset + end,
+          [&] (std::uint32_t piece_start, std::uint32_t piece_end,
+              Memcard::SaveField const* field) {
+            if (field && names.count(std::string {field->name})) {
+              restricted.push_range(piece_start - block_offset, piece_end - block_offset);
+            }
+          });
     }
+  }
+  return restricted;
+}
+
+/*----- Journals -----*/
+
+// Journals are little endian regardless of host:
+//   "SCLJ" | u32 version | u64 seed | u64 index | u32 record count
+//   then per record: u16 save | u16 block | u16 offset | u16 length | length bytes
+// A record with an offset of resize_offset and no bytes resizes the save to block blocks instead,
+// which the records after it can then edit. Version 1 journals predate multi-save cards and have no
+// save field; every edit is to save 0. Version 2 journals have no resizes.
+constexpr std::string_view journal_magic = "SCLJ";
+constexpr std::uint32_t journal_version = 3;
+constexpr std::uint16_t resize_offset = 0xFFFF;
+
+void put_le(std::string& out, std::uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>(value >> (i * 8)));
+}
+
+std::uint64_t get_le(std::string_view& in, int bytes) {
+  if (in.size() < static_cast<std::size_t>(bytes)) {
+    throw journal_failed("Journal is truncated");
+  }
+  std::uint64_t value = 0;
+  for (int i = 0; i < bytes; ++i) value |= std::uint64_t {static_cast<std::uint8_t>(in[i])} << (i * 8);
+  in.remove_prefix(bytes);
+  return value;
+}
+
+std::string encode_journal(mutation_journal const& journal) {
+  std::string out {journal_magic};
+  put_le(out, journal_version, 4);
+  put_le(out, journal.seed, 8);
+  put_le(out, journal.index, 8);
+  put_le(out, journal.records.size(), 4);
+  for (auto& record : journal.records) {
+    put_le(out, record.save, 2);
+    put_le(out, record.block, 2);
+    put_le(out, record.offset, 2);
+    put_le(out, record.bytes.size(), 2);
+    out.append(record.bytes.begin(), record.bytes.end());
+  }
+  return out;
+}
 
-    fmt::println("Will corrupt block {}...", iteration);
-    auto& data = block.m_block;
-    for (auto& [start, end] : regions) {
-      if (end - start < minimum_size) {
+void write_journal(mutation_journal const& journal, std::string const& path) {
+  if (!File::WriteStringToFile(path, encode_journal(journal))) {
+    throw journal_failed(fmt::format(R"(Failed to write journal "{}")", path));
+  }
+}
+
+// name is only for the errors.
+mutation_journal decode_journal(std::string_view in, std::string_view name) {
+  if (in.substr(0, journal_magic.size()) != journal_magic) {
+    throw journal_failed(fmt::format(R"("{}" is not a mutation journal)", name));
+  }
+  in.remove_prefix(journal_magic.size());
+  auto version = get_le(in, 4);
+  if (version < 1 || version > journal_version) {
+    throw journal_failed(fmt::format(R"(Journal "{}" has an unsupported version)", name));
+  }
+
+  mutation_journal journal;
+  journal.seed = get_le(in, 8);
+  journal.index = get_le(in, 8);
+  journal.records.resize(get_le(in, 4));
+  for (auto& record : journal.records) {
+    record.save = version == 1 ? 0 : static_cast<std::uint16_t>(get_le(in, 2));
+    record.block = static_cast<std::uint16_t>(get_le(in, 2));
+    record.offset = static_cast<std::uint16_t>(get_le(in, 2));
+    auto length = get_le(in, 2);
+    if (in.size() < length) throw journal_failed("Journal is truncated");
+    record.bytes.assign(in.begin(), in.begin() + length);
+    in.remove_prefix(length);
+  }
+  return journal;
+}
+
+auto read_journal(std::string const& path) {
+  std::string contents;
+  if (!File::ReadFileToString(path, contents)) {
+    throw journal_failed(fmt::format(R"(Failed to read journal "{}")", path));
+  }
+  return decode_journal(contents, path);
+}
+
+// Appends one record per run of bytes where after differs from before, both copies of save. When
+// after has a different number of blocks, a resize record goes first, and the blocks it adds are
+// diffed against erased ones.
+void record_changes(std::uint16_t save, std::vector<GCMBlock> const& before,
+    std::vector<GCMBlock> const& after, mutation_journal& journal) {
+  if (after.size() != before.size()) {
+    journal.records.push_back({save, static_cast<std::uint16_t>(after.size()), resize_offset, {}});
+  }
+  GCMBlock const erased;
+  for (std::size_t block = 0; block < after.size(); ++block) {
+    auto const& lhs = block < before.size() ? before[block].m_block : erased.m_block;
+    auto const& rhs = after[block].m_block;
+    for (std::size_t start = 0; start < lhs.size();) {
+      if (lhs[start] == rhs[start]) {
+        ++start;
         continue;
       }
+      auto end = start;
+      while (end < lhs.size() && lhs[end] != rhs[end]) ++end;
+      journal.records.push_back({save, static_cast<std::uint16_t>(block),
+          static_cast<std::uint16_t>(start), {rhs.begin() + start, rhs.begin() + end}});
+      start = end;
+    }
+  }
+}
 
-      std::uniform_int_distribution<int> rand_offset(start, end);
-      if (mutation_count < mutations) {
-        fmt::println("Executing a corruption on block {}, between {}-{}...", iteration, start, end);
-        auto base = data.begin() + rand_offset(engine);
-        auto finish = base + chunk_size > data.end() ? data.end() : base + chunk_size;
-        std::generate(base, finish, [&] { return rand_byte(engine); });
-        ++mutation_count;
-      } else {
-        fmt::println("Reached maximum number of corruptions, {}, skipping the rest...", mutations);
-        break;
+void apply_journal(std::vector<Savefile>& saves, mutation_journal const& journal) {
+  for (auto& record : journal.records) {
+    if (record.save < saves.size() && record.offset == resize_offset && record.bytes.empty()) {
+      if (record.block == 0) throw journal_failed("Journal resizes a save to nothing");
+      saves[record.save].blocks.resize(record.block);
+      saves[record.save].dir_entry.m_block_count = record.block;
+      continue;
+    }
+    if (record.save >= saves.size() || record.block >= saves[record.save].blocks.size() ||
+        record.offset + record.bytes.size() > Memcard::BLOCK_SIZE) {
+      throw journal_failed("Journal edits fall outside of the base saves");
+    }
+    auto& data = saves[record.save].blocks[record.block].m_block;
+    std::copy(record.bytes.begin(), record.bytes.end(), data.begin() + record.offset);
+  }
+}
+
+// Rebuilds the exact mutant a journal was recorded from, given the same base card or save.
+void replay(std::string const& basename, std::string const& journalname, std::string const& output,
+    GCMemcardOpenOptions const& open_options) {
+  if (is_savefile(basename)) {
+    auto journal = read_journal(journalname);
+    fmt::println(R"(Replaying {} edits of mutant {} (seed {}) onto "{}"...)",
+        journal.records.size(), journal.index, journal.seed, basename);
+    std::vector saves {read_save(basename)};
+    apply_journal(saves, journal);
+    if (!Memcard::WriteSavefile(output, saves.front(), Memcard::SavefileFormat::GCI)) {
+      throw save_failed(fmt::format(R"(Failed to write replayed save "{}")", output));
+    }
+    return;
+  }
+
+  auto [error, card] = open_card(basename, open_options);
+  if (!card) report_error(basename, error);
+
+  auto journal = read_journal(journalname);
+  fmt::println(R"(Replaying {} edits of mutant {} (seed {}) onto "{}"...)",
+      journal.records.size(), journal.index, journal.seed, basename);
+  auto saves = extract_saves(*card);
+  apply_journal(saves, journal);
+  store_saves(*card, saves);
+  if (!card->Save(output)) {
+    throw save_failed(fmt::format(R"(Failed to write replayed card "{}")", output));
+  }
+}
+
+/*----- Deltas -----*/
+
+// Deltas are little endian regardless of host:
+//   "SCLD" | u32 version | u64 XXH64 of the base image | u32 card size in blocks | u32 record count
+//   then per record: u32 card block index | BLOCK_SIZE bytes of block contents
+constexpr std::string_view delta_magic = "SCLD";
+constexpr std::uint32_t delta_version = 1;
+constexpr std::size_t delta_header_size = 24;
+
+std::uint64_t hash_image(std::string_view image) {
+  return XXH64(image.data(), image.size(), 0);
+}
+
+std::uint64_t hash_card(GCMemcard const& card) {
+  auto* state = XXH64_createState();
+  XXH64_reset(state, 0);
+  for (std::uint32_t block = 0; block < card.GetSizeBlocks(); ++block) {
+    XXH64_update(state, card.GetRawBlock(block), Memcard::BLOCK_SIZE);
+  }
+  auto hash = XXH64_digest(state);
+  XXH64_freeState(state);
+  return hash;
+}
+
+void write_delta(GCMemcard const& basecard, std::uint64_t base_hash, GCMemcard const& card,
+    std::string const& path) {
+  std::string out {delta_magic};
+  put_le(out, delta_version, 4);
+  put_le(out, base_hash, 8);
+  put_le(out, card.GetSizeBlocks(), 4);
+  put_le(out, 0, 4);
+
+  // The mutant is a clone of the base card, so it inherited the base's block hashes and only has
+  // to hash the blocks it wrote. Blocks with matching hashes are taken as unchanged.
+  auto& base_hashes = basecard.GetBlockHashes();
+  auto& hashes = card.GetBlockHashes();
+  std::uint32_t records = 0;
+  for (std::uint32_t block = 0; block < card.GetSizeBlocks(); ++block) {
+    if (hashes[block] == base_hashes[block]) continue;
+    auto* data = card.GetRawBlock(block);
+
+    put_le(out, block, 4);
+    out.append(reinterpret_cast<char const*>(data), Memcard::BLOCK_SIZE);
+    ++records;
+  }
+
+  // Patch the record count in now that we know it
+  std::string count;
+  put_le(count, records, 4);
+  out.replace(delta_header_size - 4, 4, count);
+  if (!File::WriteStringToFile(path, out)) {
+    throw delta_failed(fmt::format(R"(Failed to write delta "{}")", path));
+  }
+}
+
+// Patches a delta onto a base card, either in place or into a new card at output.
+// Refuses to touch anything unless the base image is exactly the one the delta was made from.
+void apply_delta(std::string const& basename, std::string const& deltaname, std::string const& output) {
+  std::string delta, image;
+  if (!File::ReadFileToString(deltaname, delta)) {
+    throw delta_failed(fmt::format(R"(Failed to read delta "{}")", deltaname));
+  }
+  if (!File::ReadFileToString(basename, image)) {
+    throw delta_failed(fmt::format(R"(Failed to read base card "{}")", basename));
+  }
+
+  std::string_view in = delta;
+  if (in.substr(0, delta_magic.size()) != delta_magic) {
+    throw delta_failed(fmt::format(R"("{}" is not a card delta)", deltaname));
+  }
+  in.remove_prefix(delta_magic.size());
+  if (get_le(in, 4) != delta_version) {
+    throw delta_failed(fmt::format(R"(Delta "{}" has an unsupported version)", deltaname));
+  }
+  auto base_hash = get_le(in, 8);
+  auto size_blocks = get_le(in, 4);
+  auto records = get_le(in, 4);
+  if (image.size() != size_blocks * Memcard::BLOCK_SIZE || hash_image(image) != base_hash) {
+    throw delta_failed(fmt::format(R"("{}" is not the base card delta "{}" was made from)",
+        basename, deltaname));
+  }
+
+  // Collect every patch before writing anything, so a damaged delta leaves the base untouched
+  std::vector<std::pair<std::uint64_t, std::string_view>> patches;
+  for (std::uint64_t i = 0; i < records; ++i) {
+    auto block = get_le(in, 4);
+    if (block >= size_blocks || in.size() < Memcard::BLOCK_SIZE) {
+      throw delta_failed(fmt::format(R"(Delta "{}" is damaged)", deltaname));
+    }
+    patches.emplace_back(block, in.substr(0, Memcard::BLOCK_SIZE));
+    in.remove_prefix(Memcard::BLOCK_SIZE);
+  }
+
+  if (output.empty()) {
+    File::IOFile file(basename, "r+b");
+    for (auto& [block, data] : patches) {
+      if (!file.Seek(block * Memcard::BLOCK_SIZE, File::SeekOrigin::Begin) ||
+          !file.WriteBytes(data.data(), data.size())) {
+        throw delta_failed(fmt::format(R"(Failed to patch "{}")", basename));
       }
     }
-  }, card.blocks, diffs);
+    if (!file.Close()) throw delta_failed(fmt::format(R"(Failed to patch "{}")", basename));
+  } else {
+    for (auto& [block, data] : patches) {
+      image.replace(block * Memcard::BLOCK_SIZE, Memcard::BLOCK_SIZE, data);
+    }
+    if (!File::WriteStringToFile(output, image)) {
+      throw delta_failed(fmt::format(R"(Failed to write patched card "{}")", output));
+    }
+  }
+  fmt::println(R"(Applied {} blocks from "{}")", patches.size(), deltaname);
 }
 
+/*----- Mutants -----*/
+
+// Hashes the saves a mutant can differ from the base card in, those with diffs.
+std::uint64_t hash_mutant(std::vector<Savefile> const& saves,
+    std::vector<region_map> const& diffs) {
+  auto* state = XXH64_createState();
+  XXH64_reset(state, 0);
+  for (std::size_t i = 0; i < saves.size(); ++i) {
+    if (diffs[i].size() == 0) continue;
+    XXH64_update(state, &i, sizeof(i));
+    XXH64_update(state, saves[i].blocks.data(), saves[i].blocks.size() * sizeof(GCMBlock));
+  }
+  auto hash = XXH64_digest(state);
+  XXH64_freeState(state);
+  return hash;
 }
 
-/*----- Main -----*/
+// Whether a mutant with the given saves hasn't been generated before, if the run skips
+// duplicates at all.
+bool is_new_mutant(std::vector<Savefile> const& saves, std::vector<region_map> const& diffs,
+    mutant_options const& options, std::string const& name) {
+  if (!options.dedup || options.dedup->insert(hash_mutant(saves, diffs))) return true;
+  fmt::println(progress_out, R"(Skipping mutant "{}", a duplicate of an earlier one)", name);
+  return false;
+}
 
-int main(int argc, char** argv) {
-  // Setup CLI parser
-  argh::parser cli;
-  cli.add_param("scramble");
-  cli.add_param("mutations");
-  cli.add_param("chunk-size");
-  cli.add_param("minimum-size");
-  cli.parse(argc, argv);
+// Scrambles fresh copies of the base saves the way mutant index of seed does. The result lines
+// up with basesaves, so it can be scrambled again in turn. diffs holds one map per base save.
+std::vector<Savefile> scramble_saves(std::vector<Savefile> const& basesaves,
+    std::vector<region_map> const& diffs, std::uint64_t seed, std::uint64_t index,
+    mutant_options const& options, mutation_journal* journal) {
+  mutant_rng engine {seed, index, options.crypto_random};
 
-  std::string lhs, rhs, output;
-  if (any_of([] (auto&& arg) { return !arg; }, cli(1), cli(2))) {
-    fmt::print(stderr, "You must supply at least two files to diff, and an optional one to output to");
-    std::abort();
+  // Saves without a counterpart on the other cards have no diffs, and are left as they are
+  auto saves = basesaves;
+  for (std::size_t i = 0; i < saves.size(); ++i) {
+    if (diffs[i].size() == 0) continue;
+    scramble_diffs(saves[i], diffs[i], engine, options, static_cast<std::uint16_t>(i), journal);
+    if (!options.fixup_header) continue;
+
+    // Fixups rewrite whatever they need to, so the journal picks up their edits by comparison
+    if (!journal) {
+      Memcard::ApplySaveFixups(*options.fixup_header, saves[i].dir_entry, saves[i].blocks);
+      continue;
+    }
+    auto scrambled = saves[i].blocks;
+    if (Memcard::ApplySaveFixups(*options.fixup_header, saves[i].dir_entry, saves[i].blocks)) {
+      record_changes(static_cast<std::uint16_t>(i), scrambled, saves[i].blocks, *journal);
+    }
   }
+  return saves;
+}
 
-  // Read our data
-  cli(1) >> lhs;
-  cli(2) >> rhs;
-  cli(3, "/dev/null") >> output;
-  fmt::println(R"(Diffing files "{}" and {}")", lhs, rhs);
-  auto [lhserror, lhscard] = Memcard::GCMemcard::Open(lhs);
-  auto [rhserror, rhscard] = Memcard::GCMemcard::Open(rhs);
+// A generated mutant on its way to disk.
+struct pending_mutant {
+  std::string output;
+  // Mutants of a lone save have no card, just the save
+  std::optional<GCMemcard> card;
+  Savefile save;
+  mutation_journal journal;
+};
 
-  // Validate
-  std::vector data {
-    std::tie(lhs, lhscard, lhserror),
-    std::tie(rhs, rhscard, rhserror)
-  };
-  for (auto& [name, card, error] : data) {
-    if (!card) report_error(name, error);
+// Writes a mutant out as a card, as a delta against the base card, or for a lone save as a GCI,
+// along with its journal if the run keeps them.
+void write_pending(pending_mutant& mutant, GCMemcard const* basecard,
+    mutant_options const& options) {
+  TRACE_SPAN("write_pending");
+  stage_timer timer {stage::write};
+  if (!mutant.card) {
+    if (!Memcard::WriteSavefile(mutant.output, mutant.save, Memcard::SavefileFormat::GCI)) {
+      throw save_failed(fmt::format(R"(Failed to write mutant "{}")", mutant.output));
+    }
+  } else if (options.delta) {
+    write_delta(*basecard, options.base_hash, *mutant.card, mutant.output);
+  } else if (!mutant.card->Save(mutant.output)) {
+    throw save_failed(fmt::format(R"(Failed to write mutant "{}")", mutant.output));
+  }
+  if (options.journal) write_journal(mutant.journal, mutant.output + ".journal");
+}
+
+// Takes the writes of generated mutants off the jobs generating them, which would otherwise sit
+// idle while the disk catches up. Mutants are written in whatever order their writes finish.
+using mutant_writer = pipeline_stage<pending_mutant>;
+
+// Writes the mutant through writer if there is one, or right away.
+void write_pending(pending_mutant mutant, GCMemcard const* basecard,
+    mutant_options const& options, mutant_writer* writer) {
+  if (writer) {
+    writer->push(std::move(mutant));
+  } else {
+    write_pending(mutant, basecard, options);
+  }
+}
+
+// Scrambles fresh copies of the base saves into a fresh copy of the base card, so every
+// mutant is independent of the ones generated before it. Returns false for a duplicate.
+bool generate_mutant(GCMemcard const& basecard, std::vector<Savefile> const& basesaves,
+    std::vector<region_map> const& diffs, std::uint64_t seed, std::uint64_t index,
+    mutant_options const& options, std::string const& output, mutant_writer* writer = nullptr) {
+  pending_mutant mutant {output, {}, {}, {seed, index, {}}};
+  fmt::println(R"(Generating mutant "{}"...)", output);
+  {
+    stage_timer timer {stage::mutate};
+    auto saves = scramble_saves(basesaves, diffs, seed, index, options, &mutant.journal);
+    if (!is_new_mutant(saves, diffs, options, output)) return false;
+    mutant.card = basecard.Fork();
+    store_saves(*mutant.card, saves);
+  }
+  write_pending(std::move(mutant), &basecard, options, writer);
+  return true;
+}
+
+// Same as generate_mutant for a lone base save, which is written straight out as a GCI. The
+// GCI folder backend loads those as they are, so a mutant is only as large as its save.
+bool generate_save_mutant(std::vector<Savefile> const& basesaves,
+    std::vector<region_map> const& diffs, std::uint64_t seed, std::uint64_t index,
+    mutant_options const& options, std::string const& output, mutant_writer* writer = nullptr) {
+  pending_mutant mutant {output, {}, {}, {seed, index, {}}};
+  fmt::println(R"(Generating mutant "{}"...)", output);
+  {
+    stage_timer timer {stage::mutate};
+    auto saves = scramble_saves(basesaves, diffs, seed, index, options, &mutant.journal);
+    if (!is_new_mutant(saves, diffs, options, output)) return false;
+    mutant.save = std::move(saves.front());
   }
+  write_pending(std::move(mutant), nullptr, options, writer);
+  return true;
+}
 
-  // Extract both saves.
-  auto lhssave = extract_save(*lhscard);
-  auto rhssave = extract_save(*rhscard);
-  auto lhsname = extract_filename(lhssave);
-  auto rhsname = extract_filename(rhssave);
-  fmt::println(R"(Name of first save is "{}" and name of second save is "{}")", lhsname, rhsname);
+/*----- Harness -----*/
 
-  // Compute regions
-  fmt::println("Enumerating regions with diffs...");
-  auto diffs = calculate_diffs(lhssave, rhssave);
+// Shared between the CPU thread, which reports frames and crashes, and the thread polling a run.
+struct harness_state {
+  std::atomic<std::uint64_t> frames {0};
+  std::atomic<std::chrono::steady_clock::rep> last_frame {0};
+  std::mutex mutex;
+  std::optional<run_outcome> outcome;
+  std::string detail;
 
-  // Print diffs
-  if (cli["print"]) {
-    print_diffs(diffs);
+  // Nonzero to pause the CPU once the game finishes that many frames.
+  std::atomic<std::uint64_t> break_at_frame {0};
+
+  // The first problem a run hits is the one it's classified by.
+  void report(run_outcome what, std::string text) {
+    std::lock_guard lock {mutex};
+    if (outcome) return;
+    outcome = what;
+    detail = std::move(text);
   }
 
-  // Collect corruption targets
-  std::unordered_set<int> targets;
-  int mutations, chunk_size, minimum_size;
-  for (auto& param : cli.params("scramble")) {
-    targets.insert(std::stoi(param.second));
+  void reset() {
+    std::lock_guard lock {mutex};
+    frames = 0;
+    last_frame = std::chrono::steady_clock::now().time_since_epoch().count();
+    outcome.reset();
+    detail.clear();
+    JitCoverage::Reset();
+  }
+};
+
+harness_state harness;
+
+// The name the base card is published under with File::SharedMemory, if it is. Cards then boot on
+// top of it, so processes running mutants of the same base share the pages their mutants leave
+// alone.
+std::string shared_base_card;
+
+bool harness_alert(char const* caption, char const* text, bool, Common::MsgType style) {
+  if (style == Common::MsgType::Warning || style == Common::MsgType::Critical) {
+    harness.report(run_outcome::panic, fmt::format("{}: {}", caption, text));
+  }
+  return false;
+}
+
+void harness_exception(std::uint32_t vector, std::uint32_t srr0) {
+  harness.report(run_outcome::exception,
+      fmt::format("Exception {:#x} at {:#010x}", vector, srr0));
+}
+
+// Sets up the emulator once per process; every run afterwards only boots and stops the core.
+void init_harness(std::string const& user_dir) {
+  UICommon::SetUserDirectory(user_dir);
+  UICommon::CreateDirectories();
+  UICommon::Init();
+  Config::AddLayer(ConfigLoaders::GenerateHeadlessThroughputConfigLoader(true));
+  Common::RegisterMsgAlertHandler(harness_alert);
+  PowerPC::SetFatalExceptionCallback(harness_exception);
+  Core::AddOnFrameCallback([] {
+    auto frames = ++harness.frames;
+    harness.last_frame = std::chrono::steady_clock::now().time_since_epoch().count();
+    if (frames == harness.break_at_frame) {
+      harness.break_at_frame = 0;
+      CPU::Break();
+    }
+  });
+}
+
+void shutdown_harness() {
+  PowerPC::SetFatalExceptionCallback(nullptr);
+  UICommon::Shutdown();
+}
+
+// Boots the game with the card image in slot A, entirely in memory, arming the snapshot trigger
+// if asked to. Returns the failure if the game didn't even start.
+std::optional<run_result> boot_card(std::vector<std::uint8_t> image, run_options const& options,
+    bool snapshot) {
+  TRACE_SPAN("boot_card");
+  stage_timer timer {stage::boot};
+  using namespace ExpansionInterface;
+  auto injected = shared_base_card.empty() ?
+      Memcard::InjectCardImage(Slot::A, std::move(image)) :
+      Memcard::InjectSharedCardImage(Slot::A, shared_base_card, std::move(image));
+  if (!injected) {
+    return run_result {run_outcome::boot_failed, 0, "Card image has an invalid size"};
+  }
+
+  // The current run layer is dropped when the core shuts down, so it's set up again every boot
+  Config::SetCurrent(Config::MAIN_SLOT_A, EXIDeviceType::MemoryCard);
+  Config::SetCurrent(Config::MAIN_SKIP_IPL, true);
+  Config::SetCurrent(Config::MAIN_JIT_COVERAGE, options.coverage);
+  // Rewinding to the snapshot for every mutant would otherwise compile the same code every time
+  Config::SetCurrent(Config::MAIN_JIT_KEEP_BLOCKS_ON_STATE_LOAD, true);
+
+  // The JITs only check for breakpoints with debugging enabled
+  if (snapshot && options.snapshot_pc) {
+    Config::SetCurrent(Config::MAIN_ENABLE_DEBUGGING, true);
+    PowerPC::breakpoints.Add(*options.snapshot_pc, true);
+  }
+
+  harness.reset();
+  harness.break_at_frame = snapshot && !options.snapshot_pc ? options.snapshot_frame : 0;
+  auto boot = BootParameters::GenerateFromFile(options.iso);
+  if (!boot || !BootManager::BootCore(std::move(boot), WindowSystemInfo {})) {
+    Memcard::ClearInjectedCardImage(Slot::A);
+    return run_result {run_outcome::boot_failed, 0,
+        fmt::format(R"(Failed to boot "{}")", options.iso)};
   }
-  cli("mutations", 1) >> mutations;
-  cli("chunk-size", 1) >> chunk_size;
-  cli("minimum-size", 1) >> minimum_size;
+  return std::nullopt;
+}
+
+void stop_core() {
+  Core::Stop();
+  Core::Shutdown();
+  PowerPC::breakpoints.ClearAllTemporary();
+  Memcard::ClearInjectedCardImage(ExpansionInterface::Slot::A);
+}
+
+// Polls the running game until it has run the requested number of frames, something went wrong,
+// or done() says to stop. done() is checked first, so reaching it counts as clean.
+template <class F>
+run_result watch_core(run_options const& options, F&& done) {
+  TRACE_SPAN("watch_core");
+  stage_timer timer {stage::run};
+  run_result result;
+  // A second of play between snapshots, as many as fit in 256 MiB, and failures are saved from
+  // rewind_lead snapshots before them
+  constexpr std::uint64_t rewind_interval = 60;
+  constexpr std::size_t rewind_lead = 5;
+  std::optional<State::RewindBuffer> rewind;
+  if (!options.failure_state.empty()) rewind.emplace(std::size_t {256} << 20);
+  std::uint64_t next_capture = 0;
+  auto start = std::chrono::steady_clock::now();
+  while (true) {
+    Core::HostDispatchJobs();
+    if (done()) break;
+    {
+      std::lock_guard lock {harness.mutex};
+      if (harness.outcome) {
+        result.outcome = *harness.outcome;
+        result.detail = harness.detail;
+        break;
+      }
+    }
+    if (harness.frames >= options.frames) {
+      break;
+    }
+    if (Core::GetState() == Core::State::Uninitialized) {
+      result.outcome = run_outcome::boot_failed;
+      result.detail = "Emulation stopped on its own";
+      break;
+    }
 
-  // Corrupt regions randomly
-  fmt::println("Corrupting regions with diffs...");
-  scramble_diffs(lhssave, diffs, targets, mutations, chunk_size, minimum_size);
+    auto last_frame = std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(harness.last_frame.load()));
+    if (std::chrono::steady_clock::now() - last_frame > options.hang_timeout) {
+      result.outcome = run_outcome::hang;
+      result.detail = fmt::format("No frame for {} seconds", options.hang_timeout.count());
+      break;
+    }
+    if (rewind && harness.frames >= next_capture) {
+      rewind->Capture();
+      next_capture = harness.frames + rewind_interval;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  result.frames = harness.frames;
+  auto failed = result.outcome != run_outcome::clean && result.outcome != run_outcome::boot_failed;
+  if (rewind && failed && rewind->GetCount()) {
+    auto count = rewind->GetCount();
+    if (rewind->Rewind(count > rewind_lead ? count - 1 - rewind_lead : 0)) {
+      State::SaveAs(options.failure_state, true);
+      fmt::println(stderr, R"(Saved the state from before the failure to "{}")",
+          options.failure_state);
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  if (elapsed.count() > 0) result.fps = result.frames / elapsed.count();
+  return result;
+}
 
-  // Update and exit
-  fmt::println("Updating save file and writing to disk...");
-  store_save(*lhscard, lhssave);
-  lhscard->Save(output);
+// Boots the game with the card image and watches it until it either runs the requested number
+// of frames or something goes wrong.
+run_result run_card(std::vector<std::uint8_t> image, run_options const& options) {
+  if (auto failure = boot_card(std::move(image), options, false)) return *failure;
+  auto result = watch_core(options, [] { return false; });
+  stop_core();
+  result.coverage = JitCoverage::CountHits();
+  return result;
+}
+
+/*----- Snapshots -----*/
+
+// Everything a mutant's run starts from: the machine paused at the trigger, and the card as the
+// game left it by then.
+struct snapshot {
+  std::vector<std::uint8_t> state;
+  std::vector<std::uint8_t> card;
+};
+
+MemoryCardMemory* injected_card() {
+  auto* device = ExpansionInterface::GetDevice(ExpansionInterface::Slot::A);
+  if (!device || device->m_device_type != ExpansionInterface::EXIDeviceType::MemoryCard) {
+    return nullptr;
+  }
+  auto* card = static_cast<ExpansionInterface::CEXIMemoryCard*>(device)->GetMemoryCard();
+  return dynamic_cast<MemoryCardMemory*>(card);
+}
+
+// The blocks of the card in slot A the game has read so far, each once, in the order it first read
+// them. Has to run on the CPU thread.
+std::vector<std::uint16_t> first_read_blocks() {
+  auto* device = ExpansionInterface::GetDevice(ExpansionInterface::Slot::A);
+  if (!device || device->m_device_type != ExpansionInterface::EXIDeviceType::MemoryCard) {
+    return {};
+  }
+  auto* memory_card = static_cast<ExpansionInterface::CEXIMemoryCard*>(device);
+  auto const& counters = memory_card->GetAccessCounters();
+  std::vector<std::uint16_t> blocks;
+  for (auto const& access : counters.GetBlockAccesses()) {
+    if (access.kind == Memcard::AccessKind::Read &&
+        std::find(blocks.begin(), blocks.end(), access.block) == blocks.end()) {
+      blocks.push_back(access.block);
+    }
+  }
+  return blocks;
+}
+
+// Boots the game with the base card and runs it up to the trigger, a frame number or a breakpoint,
+// leaving it paused there. On failure the core is already stopped and the run's result returned.
+std::variant<snapshot, run_result> take_snapshot(std::vector<std::uint8_t> const& image,
+    run_options const& options) {
+  if (auto failure = boot_card(image, options, true)) return *failure;
+
+  // The trigger pauses the CPU itself, so anything reaching the frame limit first missed it
+  auto result = watch_core(options, [] { return CPU::IsStepping(); });
+  if (!CPU::IsStepping()) {
+    if (result.outcome == run_outcome::clean) {
+      result.outcome = run_outcome::boot_failed;
+      result.detail = "Never reached the snapshot trigger";
+    }
+    stop_core();
+    return result;
+  }
+
+  snapshot snap;
+  State::SaveToBuffer(snap.state);
+  Core::RunAsCPUThread([&] {
+    if (auto* card = injected_card()) {
+      snap.card.assign(card->GetData(), card->GetData() + card->GetSize());
+    }
+  });
+  if (snap.card.empty()) {
+    stop_core();
+    return run_result {run_outcome::boot_failed, 0, "Slot A does not hold the injected card"};
+  }
+  if (snap.card != image) {
+    fmt::println(stderr, "The game wrote to the card before the trigger, mutants will not see it");
+  }
+  fmt::println("Took a {} byte snapshot after {} frames", snap.state.size(), harness.frames.load());
+  return snap;
+}
+
+// Rewinds the paused game to the snapshot with the card swapped for the mutant, then runs it.
+// The game is left paused again, ready for the next mutant.
+run_result run_from_snapshot(snapshot const& snap, std::vector<std::uint8_t> image,
+    run_options const& options) {
+  bool swapped = false;
+  {
+    TRACE_SPAN("restore_snapshot");
+    stage_timer timer {stage::boot};
+    auto state = snap.state;
+    std::size_t blocks_before = 0, blocks_after = 0;
+    Core::RunAsCPUThread([&] { blocks_before = JitInterface::GetBlockCount(); });
+    State::LoadFromBuffer(state);
+    Core::RunAsCPUThread([&] {
+      blocks_after = JitInterface::GetBlockCount();
+      if (auto* card = injected_card()) swapped = card->SwapImage(std::move(image));
+    });
+    // Every mutant would compile the game's code all over again
+    static bool warned = false;
+    if (blocks_before && !blocks_after && !std::exchange(warned, true)) {
+      fmt::println(stderr, "Loading the snapshot threw away all {} JIT blocks", blocks_before);
+    }
+  }
+  if (!swapped) {
+    return {run_outcome::boot_failed, 0, "Mutant does not fit the snapshot's card"};
+  }
+
+  harness.reset();
+  Core::SetState(Core::State::Running);
+  auto result = watch_core(options, [] { return false; });
+  Core::SetState(Core::State::Paused);
+  result.coverage = JitCoverage::CountHits();
+  return result;
+}
+
+// Same as run_card, except that the core is left paused afterwards instead of shutting down. The
+// next run warm reboots it, which only resets the machine to the game's entry point, keeping the
+// disc, the video backend and every JIT block, so only the first run of a process pays for a
+// boot. The core is shut down with stop_core() once the batch is done.
+run_result run_rebooted(std::vector<std::uint8_t> image, run_options const& options) {
+  if (Core::GetState() == Core::State::Uninitialized) {
+    Config::SetCurrent(Config::MAIN_KEEP_BOOT_STATE, true);
+    if (auto failure = boot_card(std::move(image), options, false)) return *failure;
+  } else {
+    bool swapped = false;
+    {
+      TRACE_SPAN("warm_reboot");
+      stage_timer timer {stage::boot};
+      if (!Core::WarmReboot()) {
+        stop_core();
+        return {run_outcome::boot_failed, 0, "The core has no boot state to reboot from"};
+      }
+      Core::RunAsCPUThread([&] {
+        if (auto* card = injected_card()) swapped = card->SwapImage(std::move(image));
+      });
+    }
+    if (!swapped) return {run_outcome::boot_failed, 0, "Mutant does not fit the booted card"};
+    harness.reset();
+    Core::SetState(Core::State::Running);
+  }
+
+  auto result = watch_core(options, [] { return false; });
+  // A game that stopped the core on its own is booted afresh by the next run
+  if (Core::GetState() == Core::State::Uninitialized) {
+    stop_core();
+  } else {
+    Core::SetState(Core::State::Paused);
+  }
+  result.coverage = JitCoverage::CountHits();
+  return result;
+}
+
+// Adds the last run's coverage to what the batch has seen so far, returning how much was new.
+// seen may be shared with other processes, each entry is claimed by exactly one of them.
+std::uint32_t merge_coverage(std::atomic<std::uint8_t>* seen) {
+  auto const* map = JitCoverage::GetMap();
+  std::uint32_t added = 0;
+  for (std::uint32_t i = 0; i < JitCoverage::MAP_SIZE; ++i) {
+    if (map[i] && !seen[i].load(std::memory_order_relaxed) && !seen[i].exchange(1)) ++added;
+  }
+  return added;
+}
+
+std::string_view outcome_name(run_outcome outcome) {
+  switch (outcome) {
+    case run_outcome::clean: return "clean";
+    case run_outcome::panic: return "panic";
+    case run_outcome::exception: return "exception";
+    case run_outcome::hang: return "hang";
+    case run_outcome::boot_failed: return "boot_failed";
+    case run_outcome::crashed: return "crashed";
+  }
+  return "unknown";
+}
+
+// One JSON object per line, so a batch of runs can be consumed as it goes.
+void print_result(std::FILE* out, std::string_view card, run_result const& result,
+    std::size_t parent = 0) {
+  fmt::println(out, R"({{"card": "{}", "outcome": "{}", "frames": {}, "detail": "{}", )"
+      R"("coverage": {}, "new_coverage": {}, "parent": {}, "fps": {:.1f}}})",
+      json_escape(card), outcome_name(result.outcome), result.frames, json_escape(result.detail),
+      result.coverage, result.new_coverage, parent, result.fps);
+  std::fflush(out);
+}
+
+auto parse_run_options(argh::parser const& cli) {
+  run_options options;
+  cli("run", "") >> options.iso;
+  cli("frames", options.frames) >> options.frames;
+  int timeout;
+  cli("hang-timeout", options.hang_timeout.count()) >> timeout;
+  options.hang_timeout = std::chrono::seconds(timeout);
+  cli("snapshot-frame", 0) >> options.snapshot_frame;
+  options.coverage = cli["coverage"] || cli["guided"];
+  cli("failure-state", "") >> options.failure_state;
+  if (cli("snapshot-pc")) {
+    options.snapshot_pc = std::stoul(cli("snapshot-pc").str(), nullptr, 16);
+  }
+  return options;
+}
+
+// Results go to --result if given, stdout otherwise.
+std::FILE* open_results(argh::parser const& cli) {
+  if (!cli("result")) return stdout;
+  std::string path;
+  cli("result") >> path;
+  auto* out = std::fopen(path.c_str(), "w");
+  if (!out) {
+    fmt::println(stderr, R"(Failed to open result file "{}")", path);
+    std::abort();
+  }
+  return out;
+}
+
+/*----- Batches -----*/
+
+// Everything every run of a batch of mutants shares.
+struct fuzz_batch {
+  GCMemcard const& basecard;
+  std::vector<Savefile> const& basesaves;
+  std::vector<region_map> const& diffs;
+  mutant_options const& options;
+  run_options const& run;
+  std::uint64_t seed;
+  std::string output;
+  std::string pattern;
+
+  // Grow a corpus out of the mutants reaching new code, see run_batch.
+  bool guided = false;
+
+  std::string name(std::uint64_t index) const {
+    return pattern.empty() ? output : fmt::sprintf(pattern, index);
+  }
+};
+
+// A guided corpus entry past the base saves: the mutant index that scrambled the entry parent.
+struct corpus_entry {
+  std::uint32_t parent;
+  std::uint32_t index;
+};
+
+// Generates mutant index from the parent saves and writes it out, returning the mutant along with
+// its saves, for adding it to a corpus. Returns nothing for a duplicate.
+std::optional<std::pair<GCMemcard, std::vector<Savefile>>> write_mutant(fuzz_batch const& batch,
+    std::vector<Savefile> const& parent, std::uint64_t index) {
+  auto name = batch.name(index);
+  pending_mutant mutant {name, {}, {}, {batch.seed, index, {}}};
+  fmt::println(R"(Generating mutant "{}"...)", name);
+  std::optional<stage_timer> timer {std::in_place, stage::mutate};
+  auto saves =
+      scramble_saves(parent, batch.diffs, batch.seed, index, batch.options, &mutant.journal);
+  if (!is_new_mutant(saves, batch.diffs, batch.options, name)) return std::nullopt;
+  mutant.card = batch.basecard.Fork();
+  store_saves(*mutant.card, saves);
+  timer.reset();
+  // Written before it runs, since a run that takes the process down with it must leave the
+  // mutant behind
+  write_pending(mutant, &batch.basecard, batch.options);
+  return std::pair {std::move(*mutant.card), std::move(saves)};
+}
+
+// Generates mutant index from the parent saves and runs it, from the snapshot if there is one.
+// Returns the result along with the mutant's saves, for adding it to a corpus, or nothing if the
+// mutant was a duplicate and never ran.
+std::optional<std::pair<run_result, std::vector<Savefile>>> run_mutant(fuzz_batch const& batch,
+    std::vector<Savefile> const& parent, std::uint64_t index, std::optional<snapshot> const& snap,
+    std::atomic<std::uint8_t>* seen) {
+  auto mutant = write_mutant(batch, parent, index);
+  if (!mutant) return std::nullopt;
+  auto& [card, saves] = *mutant;
+  auto result = snap ? run_from_snapshot(*snap, Memcard::GetCardImage(card), batch.run)
+                     : run_rebooted(Memcard::GetCardImage(card), batch.run);
+  if (batch.run.coverage) result.new_coverage = merge_coverage(seen);
+  return std::pair {std::move(result), std::move(saves)};
+}
+
+// Boots once with the base card and rewinds to the trigger for every mutant, if there is one.
+std::optional<snapshot> prepare_snapshot(fuzz_batch const& batch, std::FILE* results) {
+  if (!batch.run.snapshot_frame && !batch.run.snapshot_pc) return std::nullopt;
+  auto taken = take_snapshot(Memcard::GetCardImage(batch.basecard), batch.run);
+  if (auto* failure = std::get_if<run_result>(&taken)) {
+    print_result(results, "base", *failure);
+    std::abort();
+  }
+  return std::move(std::get<snapshot>(taken));
+}
+
+// Crashes are told apart by how the run ended and where.
+std::uint64_t crash_signature(run_outcome outcome, std::string_view detail) {
+  auto hash = XXH64(detail.data(), detail.size(), 0);
+  return hash ^ static_cast<std::uint64_t>(outcome);
+}
+
+// Counts a batch's failed runs by crash_signature, remembering the first mutant of each.
+class crash_tally {
+public:
+  void add(std::string const& name, run_result const& result) {
+    if (result.outcome == run_outcome::clean) return;
+    ++failed_;
+    auto signature = crash_signature(result.outcome, result.detail);
+    auto [found, added] = signatures_.try_emplace(signature, name, 0);
+    ++found->second.second;
+  }
+
+  void print(std::uint32_t count) const {
+    fmt::println(progress_out, "{} of {} mutants failed, with {} distinct signatures", failed_,
+        count, signatures_.size());
+    for (auto const& [signature, first] : signatures_) {
+      fmt::println(progress_out, R"(  {:016x}: {} runs, first "{}")", signature, first.second,
+          first.first);
+    }
+  }
+
+private:
+  std::uint32_t failed_ = 0;
+  std::unordered_map<std::uint64_t, std::pair<std::string, std::uint32_t>> signatures_;
+};
+
+// Runs count mutants in turn. Guided runs mutate from a corpus that starts with the base saves
+// and grows by every clean mutant reaching code no earlier run did, so later mutants build on the
+// ones that got further.
+void run_batch(fuzz_batch const& batch, std::uint32_t count, std::FILE* results) {
+  auto snap = prepare_snapshot(batch, results);
+  std::vector<std::vector<Savefile>> corpus {batch.basesaves};
+  std::vector<std::atomic<std::uint8_t>> seen(JitCoverage::MAP_SIZE);
+  std::mt19937_64 picker {batch.seed};
+  for (std::uint32_t i = 0; i < count; ++i) {
+    std::size_t parent = 0;
+    if (batch.guided) {
+      parent = std::uniform_int_distribution<std::size_t>(0, corpus.size() - 1)(picker);
+    }
+    auto mutant = run_mutant(batch, corpus[parent], i, snap, seen.data());
+    if (!mutant) continue;
+    auto& [result, saves] = *mutant;
+    if (batch.guided && result.outcome == run_outcome::clean && result.new_coverage) {
+      corpus.push_back(std::move(saves));
+    }
+    print_result(results, batch.name(i), result, parent);
+  }
+  stop_core();
+}
+
+/*----- Worker Pool -----*/
+
+#ifndef _WIN32
+// Single producer, single consumer ring living in memory shared between processes, so unlike
+// Common::SPSCQueue it can't allocate. Both ends poll; neither ever blocks on the other.
+template <class T, std::uint32_t capacity>
+struct shared_ring {
+  static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+  alignas(64) std::atomic<std::uint32_t> read {0};
+  alignas(64) std::atomic<std::uint32_t> write {0};
+  std::array<T, capacity> items;
+
+  bool push(T const& item) {
+    auto at = write.load(std::memory_order_relaxed);
+    if (at - read.load(std::memory_order_acquire) == capacity) return false;
+    items[at % capacity] = item;
+    write.store(at + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& item) {
+    auto at = read.load(std::memory_order_relaxed);
+    if (at == write.load(std::memory_order_acquire)) return false;
+    item = items[at % capacity];
+    read.store(at + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Only while neither end is in use.
+  void clear() {
+    read = 0;
+    write = 0;
+  }
+};
+
+// Maps an object into memory that every process forked afterwards shares.
+template <class T>
+T* map_shared() {
+  auto* memory = mmap(nullptr, sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+      -1, 0);
+  if (memory == MAP_FAILED) {
+    fmt::println(stderr, "Failed to map memory shared with the workers");
+    std::abort();
+  }
+  return new (memory) T;
+}
+
+template <class T>
+void unmap_shared(T* object) {
+  object->~T();
+  munmap(object, sizeof(T));
+}
+
+void pin_to_core(unsigned core) {
+#ifdef __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(core % std::max(std::thread::hardware_concurrency(), 1u), &cpus);
+  if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+    fmt::println(stderr, "Failed to pin worker to core {}", core);
+  }
+#endif
+}
+
+constexpr unsigned MAX_WORKERS = 256;
+
+// A run as a worker reports it back, flattened to live in shared memory.
+struct worker_report {
+  run_outcome outcome;
+  std::uint64_t frames;
+  std::uint32_t coverage;
+  std::uint32_t new_coverage;
+  std::uint32_t parent;
+  double fps;
+  std::array<char, 256> detail;
+  // Skipped by the worker's own filter, so only the parent is meaningful.
+  bool duplicate;
+};
+
+worker_report make_report(run_result const& result, std::uint32_t parent = 0) {
+  worker_report report {result.outcome, result.frames, result.coverage, result.new_coverage,
+      parent, result.fps, {}, false};
+  result.detail.copy(report.detail.data(), report.detail.size() - 1);
+  return report;
+}
+
+run_result read_report(worker_report const& report) {
+  return {report.outcome, report.frames, report.detail.data(), report.coverage,
+      report.new_coverage, report.fps};
+}
+
+// Worker processes, each pinned to a core and running its own emulator, that jobs are handed
+// out to as they free up. Everything a worker's functions touch is the worker's own copy from the
+// time it was forked, so state shared with the pool's owner has to be in map_shared memory.
+template <class Job>
+class worker_pool {
+public:
+  // Every worker calls setup once, then work for each job it's handed, then teardown.
+  worker_pool(unsigned workers, std::function<void(unsigned)> setup,
+      std::function<worker_report(Job const&)> work, std::function<void()> teardown)
+      : setup_ {std::move(setup)}, work_ {std::move(work)}, teardown_ {std::move(teardown)},
+        pids_(workers, -1), pending_(workers) {
+    channels_ = map_shared<std::array<channel, MAX_WORKERS>>();
+    for (unsigned id = 0; id < workers; ++id) spawn(id);
+  }
+
+  ~worker_pool() {
+    for (unsigned id = 0; id < pids_.size(); ++id) (*channels_)[id].stop = true;
+    for (auto pid : pids_) waitpid(pid, nullptr, 0);
+    unmap_shared(channels_);
+  }
+
+  worker_pool(worker_pool const&) = delete;
+  worker_pool& operator=(worker_pool const&) = delete;
+
+  // Queues the job on the next worker with room for it. Returns false if every queue is full.
+  bool submit(Job const& job) {
+    for (unsigned i = 0; i < pids_.size(); ++i) {
+      auto id = next_++ % pids_.size();
+      if ((*channels_)[id].jobs.push(job)) {
+        pending_[id].push_back(job);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Jobs submitted but not reported back yet.
+  std::size_t in_flight() const {
+    std::size_t count = 0;
+    for (auto& jobs : pending_) count += jobs.size();
+    return count;
+  }
+
+  // Calls done(job, report) for every job finished since the last poll, in the order each worker
+  // ran them. A dying worker's current job goes to lost(job, status) instead, and its queue to the
+  // worker replacing it. Returns whether anything happened.
+  template <class Done, class Lost>
+  bool poll(Done&& done, Lost&& lost) {
+    bool any = false;
+    for (unsigned id = 0; id < pids_.size(); ++id) {
+      auto& channel = (*channels_)[id];
+
+      // Checked before collecting reports, so a worker dying right after a report isn't blamed
+      // for the job it just finished
+      int status;
+      bool exited = waitpid(pids_[id], &status, WNOHANG) == pids_[id];
+      worker_report report;
+      while (channel.reports.pop(report)) {
+        any = true;
+        auto job = std::move(pending_[id].front());
+        pending_[id].pop_front();
+        done(job, report);
+      }
+      if (!exited) continue;
+
+      any = true;
+      if (!pending_[id].empty()) {
+        auto job = std::move(pending_[id].front());
+        pending_[id].pop_front();
+        lost(job, status);
+      }
+      spawn(id);
+      for (auto& job : pending_[id]) channel.jobs.push(job);
+    }
+    return any;
+  }
+
+private:
+  static constexpr std::uint32_t queue_depth = 16;
+
+  struct channel {
+    shared_ring<Job, queue_depth> jobs;
+    shared_ring<worker_report, queue_depth> reports;
+    std::atomic<bool> stop {false};
+  };
+
+  void spawn(unsigned id) {
+    auto& channel = (*channels_)[id];
+    channel.jobs.clear();
+    channel.reports.clear();
+    channel.stop = false;
+    std::fflush(nullptr);
+    auto pid = fork();
+    if (pid < 0) {
+      fmt::println(stderr, "Failed to fork worker {}", id);
+      std::abort();
+    }
+    if (pid == 0) run(id);
+    pids_[id] = pid;
+  }
+
+  // The body of a worker process. It drains its queue before honouring a stop.
+  [[noreturn]] void run(unsigned id) {
+    auto& channel = (*channels_)[id];
+    pin_to_core(id);
+    setup_(id);
+    Job job;
+    while (true) {
+      if (!channel.jobs.pop(job)) {
+        if (channel.stop) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        continue;
+      }
+      auto report = work_(job);
+      while (!channel.reports.push(report)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    teardown_();
+    std::fflush(nullptr);
+    _exit(0);
+  }
+
+  std::function<void(unsigned)> setup_;
+  std::function<worker_report(Job const&)> work_;
+  std::function<void()> teardown_;
+  std::array<channel, MAX_WORKERS>* channels_ = nullptr;
+  std::vector<pid_t> pids_;
+  std::vector<std::deque<Job>> pending_;
+  std::size_t next_ = 0;
+};
+
+/*----- Orchestrator -----*/
+
+constexpr std::uint32_t MAX_CORPUS = 1 << 14;
+
+// What the orchestrator and its workers share beyond the pool's queues.
+struct orchestrator_state {
+  // Coverage every worker merges its runs into.
+  std::array<std::atomic<std::uint8_t>, JitCoverage::MAP_SIZE> seen;
+
+  // The guided corpus past the base saves, appended to by the orchestrator only.
+  std::atomic<std::uint32_t> corpus_size {0};
+  std::array<corpus_entry, MAX_CORPUS> corpus;
+};
+
+// Rebuilds guided corpus entries from their chain of mutant indices, caching them, since all the
+// workers share is how each entry was scrambled.
+class corpus_cache {
+public:
+  corpus_cache(fuzz_batch const& batch, orchestrator_state const& state)
+      : batch_ {batch}, state_ {state} {}
+
+  // Entry 0 is the base saves.
+  std::vector<Savefile> const& get(std::uint32_t entry) {
+    if (entry == 0) return batch_.basesaves;
+    if (auto found = entries_.find(entry); found != entries_.end()) return found->second;
+    auto const& [parent, index] = state_.corpus[entry - 1];
+    auto saves = scramble_saves(get(parent), batch_.diffs, batch_.seed, index, batch_.options,
+        nullptr);
+    return entries_.emplace(entry, std::move(saves)).first->second;
+  }
+
+  std::uint32_t size() const {
+    return state_.corpus_size.load(std::memory_order_acquire) + 1;
+  }
+
+private:
+  fuzz_batch const& batch_;
+  orchestrator_state const& state_;
+  std::unordered_map<std::uint32_t, std::vector<Savefile>> entries_;
+};
+
+// Hands count mutants out across a pool of workers. Guided corpus additions and coverage are
+// shared by all workers, but which entry a mutant is scrambled from then depends on timing.
+void run_orchestrated(fuzz_batch const& batch, std::uint32_t count, unsigned workers,
+    std::string const& user_dir, std::FILE* results) {
+  auto* state = map_shared<orchestrator_state>();
+
+  // Every worker boots its mutants on top of one copy of the base card, which outlives them all
+  File::SharedMemory shared_base;
+  {
+    auto image = Memcard::GetCardImage(batch.basecard);
+    auto name = fmt::format("smashcardloader-{}", getpid());
+    if (shared_base.Create(name, image.data(), image.size())) {
+      shared_base_card = name;
+    } else {
+      fmt::println(stderr, "Failed to share the base card, every worker keeps a copy of its own");
+    }
+  }
+
+  // Set up by each worker for itself once forked
+  std::optional<snapshot> snap;
+  std::optional<corpus_cache> corpus;
+  std::mt19937_64 picker;
+  std::optional<worker_pool<std::uint32_t>> pool;
+  pool.emplace(workers,
+    [&] (unsigned id) {
+      init_harness(user_dir);
+      snap = prepare_snapshot(batch, stderr);
+      corpus.emplace(batch, *state);
+      picker.seed(batch.seed + id);
+    },
+    [&] (std::uint32_t index) {
+      std::uint32_t parent = 0;
+      if (batch.guided) {
+        parent = std::uniform_int_distribution<std::uint32_t>(0, corpus->size() - 1)(picker);
+      }
+      auto const& saves = corpus->get(parent);
+      auto mutant = run_mutant(batch, saves, index, snap, state->seen.data());
+      if (!mutant) {
+        worker_report report {};
+        report.parent = parent;
+        report.duplicate = true;
+        return report;
+      }
+      return make_report(mutant->first, parent);
+    },
+    [&] {
+      stop_core();
+      shutdown_harness();
+    });
+
+  crash_tally tally;
+  std::uint32_t next = 0, done = 0;
+  auto finish = [&] (std::uint32_t index, std::uint32_t parent, run_result const& result) {
+    ++done;
+    tally.add(batch.name(index), result);
+    if (result.outcome == run_outcome::clean && batch.guided && result.new_coverage) {
+      auto size = state->corpus_size.load(std::memory_order_relaxed);
+      if (size < MAX_CORPUS) {
+        state->corpus[size] = {parent, index};
+        state->corpus_size.store(size + 1, std::memory_order_release);
+      }
+    }
+    print_result(results, batch.name(index), result, parent);
+  };
+
+  while (done < count) {
+    bool busy = false;
+    while (next < count && pool->submit(next)) {
+      ++next;
+      busy = true;
+    }
+    busy |= pool->poll([&] (std::uint32_t index, worker_report const& report) {
+      // Every worker filters the mutants it generates on its own, the counts are kept here
+      if (batch.options.dedup) batch.options.dedup->count(report.duplicate);
+      if (report.duplicate) {
+        ++done;
+        return;
+      }
+      finish(index, report.parent, read_report(report));
+    }, [&] (std::uint32_t index, int status) {
+      finish(index, 0, {run_outcome::crashed, 0,
+          fmt::format("Worker exited with status {:#x}", status)});
+    });
+    if (!busy) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  tally.print(count);
+  pool.reset();
+  shared_base_card.clear();
+  unmap_shared(state);
+}
+#endif
+
+/*----- Distributed -----*/
+
+// Coordinator and workers talk in messages of one reliable ENet packet each, little endian:
+//   hello  (worker)      u8 type | u32 version
+//   setup  (coordinator) u8 type | run options | u32 size | the base card image
+//   job    (coordinator) u8 type | u32 mutant index | the mutant's journal against the base saves
+//   result (worker)      u8 type | u32 mutant index | u8 outcome | u64 frames | u32 coverage
+//                        | u64 fps bits | u32 length | detail | coverage map, with --coverage
+// Workers hold the same base card as the coordinator, so a mutant is only ever its journal.
+constexpr std::uint32_t remote_protocol_version = 1;
+constexpr std::uint16_t default_remote_port = 2637;
+constexpr std::size_t remote_max_workers = 256;
+
+// Jobs queued on each worker, so it has the next one at hand as soon as it reports a run.
+constexpr std::size_t remote_jobs_per_worker = 2;
+
+// How long a worker may go unheard from before its jobs are handed to the others. Workers keep
+// talking while they run mutants, so this only has to cover the network.
+constexpr std::uint32_t remote_peer_timeout_ms = 30000;
+
+// The coverage map goes over the wire as one bit per entry.
+constexpr std::size_t coverage_bitmap_size = JitCoverage::MAP_SIZE / 8;
+
+enum class remote_message : std::uint8_t { hello, setup, job, result };
+
+struct remote_failed : std::runtime_error {
+  remote_failed(std::string const& msg) : std::runtime_error(msg) {}
+};
+
+class message_reader {
+public:
+  explicit message_reader(std::string_view in) : in_ {in} {}
+
+  std::uint64_t le(int bytes) {
+    auto in = this->bytes(bytes);
+    return get_le(in, bytes);
+  }
+
+  std::string_view bytes(std::size_t count) {
+    if (in_.size() < count) throw remote_failed("Message is truncated");
+    auto out = in_.substr(0, count);
+    in_.remove_prefix(count);
+    return out;
+  }
+
+  std::string_view rest() {
+    return bytes(in_.size());
+  }
+
+private:
+  std::string_view in_;
+};
+
+std::string start_message(remote_message type) {
+  return std::string(1, static_cast<char>(type));
+}
+
+void send_message(ENetPeer* peer, std::string const& message) {
+  auto* packet = enet_packet_create(message.data(), message.size(), ENET_PACKET_FLAG_RELIABLE);
+  if (enet_peer_send(peer, 0, packet) != 0) enet_packet_destroy(packet);
+}
+
+std::string peer_name(ENetAddress const& address) {
+  char host[64];
+  if (enet_address_get_host_ip(&address, host, sizeof(host)) != 0) return "unknown";
+  return fmt::format("{}:{}", host, address.port);
+}
+
+void encode_run_options(std::string& out, run_options const& options) {
+  put_le(out, options.iso.size(), 4);
+  out += options.iso;
+  put_le(out, options.frames, 8);
+  put_le(out, options.hang_timeout.count(), 4);
+  put_le(out, options.snapshot_frame, 8);
+  put_le(out, options.snapshot_pc.has_value(), 1);
+  put_le(out, options.snapshot_pc.value_or(0), 4);
+  put_le(out, options.coverage, 1);
+}
+
+run_options decode_run_options(message_reader& in) {
+  run_options options;
+  options.iso = in.bytes(in.le(4));
+  options.frames = in.le(8);
+  options.hang_timeout = std::chrono::seconds(in.le(4));
+  options.snapshot_frame = in.le(8);
+  bool has_pc = in.le(1);
+  auto pc = static_cast<std::uint32_t>(in.le(4));
+  if (has_pc) options.snapshot_pc = pc;
+  options.coverage = in.le(1);
+  return options;
+}
+
+std::string encode_result(std::uint32_t index, run_result const& result, bool coverage) {
+  auto out = start_message(remote_message::result);
+  put_le(out, index, 4);
+  put_le(out, static_cast<std::uint8_t>(result.outcome), 1);
+  put_le(out, result.frames, 8);
+  put_le(out, result.coverage, 4);
+  std::uint64_t fps;
+  std::memcpy(&fps, &result.fps, sizeof(fps));
+  put_le(out, fps, 8);
+  put_le(out, result.detail.size(), 4);
+  out += result.detail;
+  if (coverage) {
+    auto const* map = JitCoverage::GetMap();
+    std::string bitmap(coverage_bitmap_size, '\0');
+    for (std::uint32_t i = 0; i < JitCoverage::MAP_SIZE; ++i) {
+      if (map[i]) bitmap[i / 8] |= static_cast<char>(1 << (i % 8));
+    }
+    out += bitmap;
+  }
+  return out;
+}
+
+// A job handed out but not reported back yet. The saves are only kept for guided runs, to add
+// the mutant to the corpus.
+struct remote_job {
+  std::uint32_t parent;
+  std::vector<Savefile> saves;
+  std::string message;
+};
+
+// Hands count mutants out to every worker connecting to port, for as long as it takes. Mutants
+// are generated here, guided corpus and all, and only their journals sent, so the outcome is the
+// same as run_batch's apart from which results come in first. A worker that drops out has its
+// current job reported as crashed and the rest of its jobs handed to the others.
+void run_distributed(fuzz_batch const& batch, std::uint32_t count, std::uint16_t port,
+    std::FILE* results) {
+  if (enet_initialize() != 0) {
+    fmt::println(stderr, "Failed to initialize ENet");
+    std::abort();
+  }
+  ENetAddress address {ENET_HOST_ANY, port};
+  auto* host = enet_host_create(&address, remote_max_workers, 1, 0, 0);
+  if (!host) {
+    fmt::println(stderr, "Failed to listen for workers on port {}", port);
+    std::abort();
+  }
+
+  auto setup = start_message(remote_message::setup);
+  encode_run_options(setup, batch.run);
+  auto image = Memcard::GetCardImage(batch.basecard);
+  put_le(setup, image.size(), 4);
+  setup.append(image.begin(), image.end());
+  fmt::println(stderr, "Listening for workers on port {}...", port);
+
+  std::vector<std::vector<Savefile>> corpus {batch.basesaves};
+  std::vector<bool> seen(JitCoverage::MAP_SIZE);
+  std::mt19937_64 picker {batch.seed};
+  std::unordered_map<std::uint32_t, remote_job> jobs;
+  std::unordered_map<ENetPeer*, std::deque<std::uint32_t>> workers;
+  std::deque<std::uint32_t> requeued;
+
+  // Returns false for a duplicate mutant, which isn't handed out.
+  auto make_job = [&] (std::uint32_t index) {
+    std::uint32_t parent = 0;
+    if (batch.guided) {
+      parent = std::uniform_int_distribution<std::uint32_t>(0, corpus.size() - 1)(picker);
+    }
+    auto mutant = write_mutant(batch, corpus[parent], index);
+    if (!mutant) return false;
+    auto saves = std::move(mutant->second);
+    mutation_journal journal {batch.seed, index, {}};
+    for (std::size_t i = 0; i < saves.size(); ++i) {
+      record_changes(static_cast<std::uint16_t>(i), batch.basesaves[i].blocks, saves[i].blocks,
+          journal);
+    }
+    auto message = start_message(remote_message::job);
+    put_le(message, index, 4);
+    message += encode_journal(journal);
+    if (!batch.guided) saves.clear();
+    jobs.emplace(index, remote_job {parent, std::move(saves), std::move(message)});
+    return true;
+  };
+
+  crash_tally tally;
+  std::uint32_t next = 0, done = 0;
+  auto finish = [&] (std::uint32_t index, run_result const& result) {
+    auto job = std::move(jobs.at(index));
+    jobs.erase(index);
+    ++done;
+    tally.add(batch.name(index), result);
+    if (result.outcome == run_outcome::clean && batch.guided && result.new_coverage) {
+      corpus.push_back(std::move(job.saves));
+    }
+    print_result(results, batch.name(index), result, job.parent);
+  };
+
+  // A worker that crashed takes the job it was running with it, the rest go to the other workers.
+  auto drop = [&] (ENetPeer* peer, bool crashed) {
+    auto found = workers.find(peer);
+    if (found == workers.end()) return;
+    auto pending = std::move(found->second);
+    workers.erase(found);
+    if (crashed && !pending.empty()) {
+      finish(pending.front(), {run_outcome::crashed, 0, "Worker disconnected"});
+      pending.pop_front();
+    }
+    requeued.insert(requeued.begin(), pending.begin(), pending.end());
+  };
+
+  auto receive = [&] (ENetPeer* peer, message_reader in) {
+    auto type = static_cast<remote_message>(in.le(1));
+    if (type == remote_message::hello) {
+      auto version = in.le(4);
+      if (version != remote_protocol_version) {
+        fmt::println(stderr, "Worker {} speaks protocol version {}, not {}",
+            peer_name(peer->address), version, remote_protocol_version);
+        enet_peer_disconnect(peer, 0);
+        return;
+      }
+      send_message(peer, setup);
+      workers.try_emplace(peer);
+      return;
+    }
+    if (type != remote_message::result) throw remote_failed("Unexpected message from a worker");
+
+    auto index = static_cast<std::uint32_t>(in.le(4));
+    auto found = workers.find(peer);
+    if (found == workers.end()) throw remote_failed("Worker reported a job before saying hello");
+    auto& pending = found->second;
+    auto job = std::find(pending.begin(), pending.end(), index);
+    if (job == pending.end()) throw remote_failed("Worker reported a job it was never given");
+
+    // The whole result is read before the job counts as done, so a malformed one leaves it pending
+    // and drop() hands it to another worker
+    run_result result;
+    auto outcome = in.le(1);
+    if (outcome > static_cast<std::uint8_t>(run_outcome::crashed)) {
+      throw remote_failed(fmt::format("Worker reported an unknown outcome {}", outcome));
+    }
+    result.outcome = static_cast<run_outcome>(outcome);
+    result.frames = in.le(8);
+    result.coverage = static_cast<std::uint32_t>(in.le(4));
+    auto fps = in.le(8);
+    std::memcpy(&result.fps, &fps, sizeof(fps));
+    result.detail = in.bytes(in.le(4));
+    std::string_view bitmap;
+    if (batch.run.coverage) bitmap = in.bytes(coverage_bitmap_size);
+
+    pending.erase(job);
+    for (std::uint32_t i = 0; i < bitmap.size() * 8; ++i) {
+      if ((bitmap[i / 8] >> (i % 8) & 1) && !seen[i]) {
+        seen[i] = true;
+        ++result.new_coverage;
+      }
+    }
+    finish(index, result);
+  };
+
+  while (done < count) {
+    for (auto& [peer, pending] : workers) {
+      while (pending.size() < remote_jobs_per_worker) {
+        std::uint32_t index;
+        if (!requeued.empty()) {
+          index = requeued.front();
+          requeued.pop_front();
+        } else if (next < count) {
+          index = next++;
+          if (!make_job(index)) {
+            ++done;
+            continue;
+          }
+        } else {
+          break;
+        }
+        send_message(peer, jobs.at(index).message);
+        pending.push_back(index);
+      }
+    }
+
+    ENetEvent event;
+    auto serviced = enet_host_service(host, &event, 100);
+    if (serviced < 0) {
+      fmt::println(stderr, "Failed to service the worker connections");
+      std::abort();
+    }
+    if (serviced == 0) continue;
+
+    switch (event.type) {
+      case ENET_EVENT_TYPE_CONNECT:
+        enet_peer_timeout(event.peer, 0, remote_peer_timeout_ms, remote_peer_timeout_ms);
+        fmt::println(stderr, "Worker {} connected", peer_name(event.peer->address));
+        break;
+      case ENET_EVENT_TYPE_RECEIVE:
+        try {
+          receive(event.peer, message_reader {{reinterpret_cast<char const*>(event.packet->data),
+              event.packet->dataLength}});
+        } catch (remote_failed const& e) {
+          fmt::println(stderr, "Dropping worker {}: {}", peer_name(event.peer->address), e.what());
+          drop(event.peer, false);
+          enet_peer_disconnect(event.peer, 0);
+        }
+        enet_packet_destroy(event.packet);
+        break;
+      case ENET_EVENT_TYPE_DISCONNECT:
+        fmt::println(stderr, "Worker {} disconnected", peer_name(event.peer->address));
+        drop(event.peer, true);
+        break;
+      default:
+        break;
+    }
+  }
+
+  tally.print(count);
+  for (auto& [peer, pending] : workers) enet_peer_disconnect(peer, 0);
+  enet_host_flush(host);
+  enet_host_destroy(host);
+  enet_deinitialize();
+}
+
+// A worker's connection to its coordinator, serviced on a thread of its own so that the
+// coordinator keeps hearing from the worker while it runs a mutant.
+class coordinator_link {
+public:
+  // address is host[:port].
+  explicit coordinator_link(std::string const& address) {
+    auto colon = address.rfind(':');
+    ENetAddress coordinator;
+    coordinator.port = default_remote_port;
+    if (colon != std::string::npos) {
+      unsigned long port = 0;
+      try {
+        std::size_t end = 0;
+        port = std::stoul(address.substr(colon + 1), &end);
+        if (end != address.size() - colon - 1) port = 0;
+      } catch (std::logic_error const&) {
+        port = 0;
+      }
+      if (port == 0 || port > std::numeric_limits<std::uint16_t>::max()) {
+        throw remote_failed(fmt::format(R"(Invalid port in coordinator address "{}")", address));
+      }
+      coordinator.port = static_cast<std::uint16_t>(port);
+    }
+    if (enet_address_set_host(&coordinator, address.substr(0, colon).c_str()) != 0) {
+      throw remote_failed(fmt::format(R"(Failed to resolve coordinator "{}")", address));
+    }
+
+    host_ = enet_host_create(nullptr, 1, 1, 0, 0);
+    if (!host_) throw remote_failed("Failed to create the worker's ENet host");
+    host_->intercept = ENetUtil::InterceptCallback;
+    peer_ = enet_host_connect(host_, &coordinator, 1, 0);
+    ENetEvent event;
+    if (!peer_ || enet_host_service(host_, &event, 5000) <= 0 ||
+        event.type != ENET_EVENT_TYPE_CONNECT) {
+      enet_host_destroy(host_);
+      throw remote_failed(fmt::format(R"(Failed to connect to coordinator "{}")", address));
+    }
+    enet_peer_timeout(peer_, 0, remote_peer_timeout_ms, remote_peer_timeout_ms);
+    thread_ = std::thread([this] { run(); });
+  }
+
+  ~coordinator_link() {
+    stop_ = true;
+    ENetUtil::WakeupThread(host_);
+    thread_.join();
+    if (connected_) {
+      enet_peer_disconnect(peer_, 0);
+      enet_host_flush(host_);
+    }
+    enet_host_destroy(host_);
+  }
+
+  coordinator_link(coordinator_link const&) = delete;
+  coordinator_link& operator=(coordinator_link const&) = delete;
+
+  // Blocks until the next message, or returns nothing once the coordinator is gone.
+  std::optional<std::string> receive() {
+    std::unique_lock lock {mutex_};
+    received_.wait(lock, [this] { return !inbox_.empty() || !connected_; });
+    if (inbox_.empty()) return std::nullopt;
+    auto message = std::move(inbox_.front());
+    inbox_.pop_front();
+    return message;
+  }
+
+  void send(std::string message) {
+    {
+      std::lock_guard lock {mutex_};
+      outbox_.push_back(std::move(message));
+    }
+    ENetUtil::WakeupThread(host_);
+  }
+
+private:
+  void run() {
+    while (!stop_) {
+      {
+        std::lock_guard lock {mutex_};
+        for (auto& message : outbox_) send_message(peer_, message);
+        outbox_.clear();
+      }
+
+      ENetEvent event;
+      if (enet_host_service(host_, &event, 1000) <= 0) continue;
+      if (event.type == ENET_EVENT_TYPE_RECEIVE) {
+        std::lock_guard lock {mutex_};
+        inbox_.emplace_back(reinterpret_cast<char const*>(event.packet->data),
+            event.packet->dataLength);
+        enet_packet_destroy(event.packet);
+        received_.notify_one();
+      } else if (event.type == ENET_EVENT_TYPE_DISCONNECT) {
+        std::lock_guard lock {mutex_};
+        connected_ = false;
+        received_.notify_one();
+        return;
+      }
+    }
+  }
+
+  ENetHost* host_ = nullptr;
+  ENetPeer* peer_ = nullptr;
+  std::thread thread_;
+  std::atomic<bool> stop_ {false};
+  std::mutex mutex_;
+  std::condition_variable received_;
+  std::deque<std::string> inbox_;
+  std::deque<std::string> outbox_;
+  bool connected_ = true;
+};
+
+// Runs the jobs of a run_distributed coordinator until it hangs up. iso stands in for the
+// coordinator's game path, for workers keeping it somewhere else.
+void run_remote_worker(std::string const& address, std::string const& iso,
+    std::string const& user_dir, GCMemcardOpenOptions const& open_options) {
+  if (enet_initialize() != 0) {
+    fmt::println(stderr, "Failed to initialize ENet");
+    std::abort();
+  }
+  {
+    coordinator_link link {address};
+    auto hello = start_message(remote_message::hello);
+    put_le(hello, remote_protocol_version, 4);
+    link.send(std::move(hello));
+    init_harness(user_dir);
+
+    run_options run;
+    std::optional<GCMemcard> basecard;
+    std::vector<Savefile> basesaves;
+    std::optional<snapshot> snap;
+    while (auto message = link.receive()) {
+      message_reader in {*message};
+      auto type = static_cast<remote_message>(in.le(1));
+      if (type == remote_message::setup) {
+        run = decode_run_options(in);
+        if (!iso.empty()) run.iso = iso;
+        auto image = in.bytes(in.le(4));
+        auto const* data = reinterpret_cast<std::uint8_t const*>(image.data());
+        auto [error, card] = GCMemcard::OpenImage(data, image.size(), open_options);
+        if (!card) report_error("coordinator's base card", error);
+        basesaves = extract_saves(*card);
+        basecard = std::move(card);
+        fmt::println(progress_out, R"(Running mutants against "{}" for coordinator "{}"...)",
+            run.iso, address);
+
+        if (run.snapshot_frame || run.snapshot_pc) {
+          auto taken = take_snapshot(Memcard::GetCardImage(*basecard), run);
+          if (auto* failure = std::get_if<run_result>(&taken)) {
+            print_result(stderr, "base", *failure);
+            std::abort();
+          }
+          snap = std::move(std::get<snapshot>(taken));
+        }
+        continue;
+      }
+      if (type != remote_message::job || !basecard) {
+        throw remote_failed("Unexpected message from the coordinator");
+      }
+
+      auto index = static_cast<std::uint32_t>(in.le(4));
+      run_result result;
+      try {
+        auto saves = basesaves;
+        apply_journal(saves, decode_journal(in.rest(), fmt::format("job {}", index)));
+        auto card = basecard->Fork();
+        store_saves(card, saves);
+        result = snap ? run_from_snapshot(*snap, Memcard::GetCardImage(card), run)
+                      : run_rebooted(Memcard::GetCardImage(card), run);
+      } catch (journal_failed const& e) {
+        result = {run_outcome::boot_failed, 0, e.what()};
+      }
+      fmt::println(progress_out, "Mutant {} ran {} frames, ending {}", index, result.frames,
+          outcome_name(result.outcome));
+      link.send(encode_result(index, result, run.coverage));
+    }
+
+    stop_core();
+    shutdown_harness();
+  }
+  enet_deinitialize();
+}
+
+/*----- Minimizer -----*/
+
+// Minimizing works on chunks of a mutant's journal records, at most this many.
+constexpr std::size_t MAX_CHUNKS = 4096;
+using chunk_set = std::bitset<MAX_CHUNKS>;
+
+struct minimize_job {
+  std::uint32_t candidate;
+  chunk_set chunks;
+};
+
+// How the mutant failed, which a smaller candidate has to reproduce to replace it.
+struct failure_target {
+  run_outcome outcome;
+  std::uint64_t signature;
+  bool any_failure;
+
+  bool matches(run_result const& result) const {
+    if (result.outcome == run_outcome::clean) return false;
+    if (any_failure) return true;
+    return result.outcome == outcome && crash_signature(result.outcome, result.detail) == signature;
+  }
+};
+
+// The edits turning the base saves into the mutant's, one record per run of differing bytes, plus a
+// resize record for every save the mutant has a different number of blocks of.
+mutation_journal diff_journal(std::vector<Savefile> const& basesaves, GCMemcard const& mutant) {
+  mutation_journal journal;
+  auto saves = extract_saves(mutant);
+  auto partners = pair_saves(basesaves, saves, false);
+  for (std::size_t save = 0; save < basesaves.size(); ++save) {
+    if (!partners[save]) continue;
+    record_changes(static_cast<std::uint16_t>(save), basesaves[save].blocks,
+        partners[save]->blocks, journal);
+  }
+  return journal;
+}
+
+// Where each chunk's records start, with the record count appended. Neighbouring records share a
+// chunk when there are more of them than a chunk_set holds.
+std::vector<std::size_t> chunk_bounds(std::size_t records) {
+  auto chunks = std::min(records, MAX_CHUNKS);
+  std::vector<std::size_t> bounds;
+  for (std::size_t chunk = 0; chunk <= chunks; ++chunk) {
+    bounds.push_back(chunk * records / std::max<std::size_t>(chunks, 1));
+  }
+  return bounds;
+}
+
+mutation_journal select_chunks(mutation_journal const& journal,
+    std::vector<std::size_t> const& bounds, chunk_set const& chunks) {
+  mutation_journal selected {journal.seed, journal.index, {}};
+  for (std::size_t chunk = 0; chunk + 1 < bounds.size(); ++chunk) {
+    if (!chunks[chunk]) continue;
+    selected.records.insert(selected.records.end(), journal.records.begin() + bounds[chunk],
+        journal.records.begin() + bounds[chunk + 1]);
+  }
+  return selected;
+}
+
+GCMemcard build_candidate(GCMemcard const& basecard, std::vector<Savefile> const& basesaves,
+    mutation_journal const& journal) {
+  auto card = basecard.Fork();
+  auto saves = basesaves;
+  apply_journal(saves, journal);
+  store_saves(card, saves);
+  return card;
+}
+
+// Zeller's ddmin: narrows the chunks down to a set that still fails, but no longer does with any
+// single chunk removed. evaluate runs a whole round of candidates at once, so they can go to the
+// workers together; the first failing candidate of a round wins, keeping the result reproducible.
+template <class Evaluate>
+chunk_set ddmin(std::vector<std::uint32_t> current, failure_target const& target,
+    Evaluate&& evaluate) {
+  auto to_set = [] (auto first, auto last) {
+    chunk_set chunks;
+    for (; first != last; ++first) chunks.set(*first);
+    return chunks;
+  };
+
+  std::size_t granularity = 2;
+  while (current.size() >= 2) {
+    granularity = std::min(granularity, current.size());
+    std::vector<chunk_set> candidates;
+    auto subset = [&] (std::size_t i) {
+      return current.begin() + i * current.size() / granularity;
+    };
+    for (std::size_t i = 0; i < granularity; ++i) {
+      candidates.push_back(to_set(subset(i), subset(i + 1)));
+    }
+    // With only two subsets, each one is the other's complement
+    if (granularity > 2) {
+      auto all = to_set(current.begin(), current.end());
+      for (std::size_t i = 0; i < granularity; ++i) candidates.push_back(all & ~candidates[i]);
+    }
+
+    fmt::println("Trying {} candidates over {} chunks...", candidates.size(), current.size());
+    auto results = evaluate(candidates);
+    auto found = std::find_if(results.begin(), results.end(), [&] (auto const& result) {
+      return target.matches(result);
+    });
+    if (found != results.end()) {
+      auto winner = static_cast<std::size_t>(found - results.begin());
+      std::vector<std::uint32_t> next;
+      for (auto chunk : current) {
+        if (candidates[winner][chunk]) next.push_back(chunk);
+      }
+      current = std::move(next);
+      granularity = winner < granularity ? 2 : std::max<std::size_t>(granularity - 1, 2);
+    } else if (granularity < current.size()) {
+      granularity = std::min(granularity * 2, current.size());
+    } else {
+      break;
+    }
+  }
+  return to_set(current.begin(), current.end());
+}
+
+// Shrinks a failing mutant, given as a card or as its journal, down to the fewest edits of the
+// base card that still fail the same way. Writes the minimal card and its journal.
+void minimize(std::string const& basename, std::string const& mutantname,
+    std::string const& output, run_options const& run, unsigned workers,
+    std::string const& user_dir, bool any_failure, GCMemcardOpenOptions const& open_options) {
+  auto [error, basecard] = open_card(basename, open_options);
+  if (!basecard) report_error(basename, error);
+  auto basesaves = extract_saves(*basecard);
+
+  mutation_journal journal;
+  std::string magic(journal_magic.size(), '\0');
+  std::ifstream {mutantname, std::ios::binary}.read(magic.data(), magic.size());
+  if (magic == journal_magic) {
+    journal = read_journal(mutantname);
+  } else {
+    auto [mutant_error, mutant] = open_card(mutantname, open_options);
+    if (!mutant) report_error(mutantname, mutant_error);
+    journal = diff_journal(basesaves, *mutant);
+  }
+  auto bounds = chunk_bounds(journal.records.size());
+  auto chunk_count = static_cast<std::uint32_t>(bounds.size() - 1);
+  if (chunk_count == 0) {
+    fmt::println(stderr, R"("{}" does not differ from the base card)", mutantname);
+    std::abort();
+  }
+
+  auto run_chunks = [&] (chunk_set const& chunks) {
+    auto card = build_candidate(*basecard, basesaves, select_chunks(journal, bounds, chunks));
+    return run_rebooted(Memcard::GetCardImage(card), run);
+  };
+
+  // Candidates of a round run on the workers side by side, or in turn without any
+#ifndef _WIN32
+  std::optional<worker_pool<minimize_job>> pool;
+  if (workers > 1) {
+    pool.emplace(std::min(workers, MAX_WORKERS),
+        [&] (unsigned) { init_harness(user_dir); },
+        [&] (minimize_job const& job) { return make_report(run_chunks(job.chunks)); },
+        [] {
+          stop_core();
+          shutdown_harness();
+        });
+  }
+  bool in_process = !pool;
+#else
+  bool in_process = true;
+#endif
+  if (in_process) init_harness(user_dir);
+  auto evaluate = [&] (std::vector<chunk_set> const& candidates) {
+    std::vector<run_result> results(candidates.size());
+#ifndef _WIN32
+    if (pool) {
+      std::uint32_t next = 0;
+      while (next < candidates.size() || pool->in_flight()) {
+        bool busy = false;
+        while (next < candidates.size() && pool->submit({next, candidates[next]})) {
+          ++next;
+          busy = true;
+        }
+        busy |= pool->poll([&] (minimize_job const& job, worker_report const& report) {
+          results[job.candidate] = read_report(report);
+        }, [&] (minimize_job const& job, int status) {
+          results[job.candidate] = {run_outcome::crashed, 0,
+              fmt::format("Worker exited with status {:#x}", status)};
+        });
+        if (!busy) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return results;
+    }
+#endif
+    std::transform(candidates.begin(), candidates.end(), results.begin(), run_chunks);
+    return results;
+  };
+
+  chunk_set all;
+  for (std::uint32_t chunk = 0; chunk < chunk_count; ++chunk) all.set(chunk);
+  auto original = evaluate({all}).front();
+  if (original.outcome == run_outcome::clean) {
+    fmt::println(stderr, R"("{}" runs clean, there is nothing to minimize)", mutantname);
+    std::abort();
+  }
+  fmt::println(R"(Minimizing {} edits failing with {}: {})", journal.records.size(),
+      outcome_name(original.outcome), original.detail);
+
+  failure_target target {original.outcome, crash_signature(original.outcome, original.detail),
+      any_failure};
+  std::vector<std::uint32_t> chunks(chunk_count);
+  std::iota(chunks.begin(), chunks.end(), 0);
+  auto minimal = select_chunks(journal, bounds, ddmin(std::move(chunks), target, evaluate));
+#ifndef _WIN32
+  pool.reset();
+#endif
+  if (in_process) {
+    stop_core();
+    shutdown_harness();
+  }
+
+  auto card = build_candidate(*basecard, basesaves, minimal);
+  if (!card.Save(output)) {
+    throw save_failed(fmt::format(R"(Failed to write minimized card "{}")", output));
+  }
+  write_journal(minimal, output + ".journal");
+  fmt::println(R"(Reduced to {} of {} edits in "{}")", minimal.records.size(),
+      journal.records.size(), output);
+}
+
+std::optional<Memcard::SavefileFormat> parse_savefile_format(std::string_view name) {
+  if (name == "gci") return Memcard::SavefileFormat::GCI;
+  if (name == "gcs") return Memcard::SavefileFormat::GCS;
+  if (name == "sav") return Memcard::SavefileFormat::SAV;
+  return std::nullopt;
+}
+
+std::string_view batch_error_name(Memcard::BatchSavefileErrorCode error) {
+  switch (error) {
+    case Memcard::BatchSavefileErrorCode::Success: return "success";
+    case Memcard::BatchSavefileErrorCode::OpenFileFail: return "failed to open";
+    case Memcard::BatchSavefileErrorCode::IOError: return "I/O error";
+    case Memcard::BatchSavefileErrorCode::DataCorrupted: return "corrupted save";
+    case Memcard::BatchSavefileErrorCode::OpenCardFail: return "failed to open card";
+    case Memcard::BatchSavefileErrorCode::WriteFail: return "failed to write";
+  }
+  return "unknown error";
+}
+
+// Converts savefiles and exports the saves of cards into output, reporting failures as they
+// happen. Returns how many files failed.
+std::size_t convert_saves(std::vector<std::string> const& inputs, std::string const& output,
+    Memcard::BatchSavefileOptions options) {
+  std::vector<std::string> savefiles, cards;
+  auto is_card = [] (std::string const& name) {
+    auto ext = name.substr(std::min(name.rfind('.'), name.size()));
+    std::transform(ext.begin(), ext.end(), ext.begin(), [] (unsigned char c) {
+      return static_cast<char>(std::tolower(c));
+    });
+    return ext == ".raw" || ext == ".gcp" || ext == ".mcr";
+  };
+  for (auto& input : inputs) {
+    auto found = File::IsDirectory(input) ?
+        Common::DoFileSearch({input}, {".gci", ".gcs", ".sav", ".raw", ".gcp", ".mcr"}) :
+        std::vector {input};
+    for (auto& name : found) (is_card(name) ? cards : savefiles).push_back(name);
+  }
+
+  std::size_t done = 0, failed = 0;
+  options.on_result = [&] (Memcard::BatchSavefileResult const& result) {
+    ++done;
+    if (result.error == Memcard::BatchSavefileErrorCode::Success) return;
+    ++failed;
+    fmt::println(stderr, R"("{}": {})", result.input, batch_error_name(result.error));
+  };
+
+  fmt::println("Converting {} savefiles and exporting {} cards...", savefiles.size(), cards.size());
+  Memcard::ConvertSavefiles(savefiles, output, options);
+  Memcard::ExportSavefiles(cards, output, options);
+  fmt::println("Wrote {} of {} saves", done - failed, done);
+  return failed;
+}
+
+// Defragments every card in place, spread across jobs threads. Returns how many cards failed.
+std::size_t compact_cards(std::vector<std::string> const& cards, unsigned jobs,
+    GCMemcardOpenOptions const& open_options) {
+  std::atomic<std::size_t> failed {0};
+  parallel_for(cards.size(), jobs, [&] (std::size_t i) {
+    auto& name = cards[i];
+    auto [error, card] = Memcard::GCMemcard::OpenMapped(name, open_options);
+    if (!card) {
+      fmt::println(stderr, R"(Failed to open card "{}")", name);
+      ++failed;
+      return;
+    }
+    auto free_blocks = card->GetFreeBlocks();
+    auto result = card->Defragment();
+    if (result == Memcard::GCMemcardDefragmentRetVal::UNCHANGED) {
+      fmt::println(R"("{}" is already compact, {} free blocks at the end)", name, free_blocks);
+    } else if (result != Memcard::GCMemcardDefragmentRetVal::SUCCESS) {
+      fmt::println(stderr, R"(Card "{}" has a broken block chain, left as it is)", name);
+      ++failed;
+    } else if (!card->Save()) {
+      fmt::println(stderr, R"(Failed to write card "{}")", name);
+      ++failed;
+    } else {
+      fmt::println(R"(Compacted "{}", {} free blocks at the end)", name, free_blocks);
+    }
+  });
+  return failed;
+}
+
+std::string_view issue_name(Memcard::GCMemcardValidityIssues issue) {
+  switch (issue) {
+    case Memcard::GCMemcardValidityIssues::FAILED_TO_OPEN: return "failed_to_open";
+    case Memcard::GCMemcardValidityIssues::IO_ERROR: return "io_error";
+    case Memcard::GCMemcardValidityIssues::INVALID_CARD_SIZE: return "invalid_card_size";
+    case Memcard::GCMemcardValidityIssues::INVALID_CHECKSUM: return "invalid_checksum";
+    case Memcard::GCMemcardValidityIssues::MISMATCHED_CARD_SIZE: return "mismatched_card_size";
+    case Memcard::GCMemcardValidityIssues::FREE_BLOCK_MISMATCH: return "free_block_mismatch";
+    case Memcard::GCMemcardValidityIssues::DIR_BAT_INCONSISTENT: return "dir_bat_inconsistent";
+    case Memcard::GCMemcardValidityIssues::DATA_IN_UNUSED_AREA: return "data_in_unused_area";
+    case Memcard::GCMemcardValidityIssues::COUNT: break;
+  }
+  return "unknown";
+}
+
+// The given cards, plus every card anywhere under the given directories.
+std::vector<std::string> find_cards(std::vector<std::string> const& inputs) {
+  std::vector<std::string> cards;
+  for (auto& input : inputs) {
+    auto found = File::IsDirectory(input) ?
+        Common::DoFileSearch({input}, {".raw", ".gcp", ".mcr", ".gcma"}, true) :
+        std::vector {input};
+    for (auto& path : found) add_cards(path, cards);
+  }
+  return cards;
+}
+
+// Packs every card under the inputs into an archive, compressed against the first card if the
+// archive is new, and appended to it otherwise. Returns how many cards were skipped.
+std::size_t archive_cards(std::string const& path, std::vector<std::string> const& inputs,
+    int level, GCMemcardOpenOptions const& open_options) {
+  auto cards = find_cards(inputs);
+  std::unique_ptr<Memcard::GCMemcardArchive> archive;
+  if (File::Exists(path)) {
+    archive = Memcard::GCMemcardArchive::Open(path, level);
+    if (!archive) {
+      fmt::println(stderr, R"(Failed to open archive "{}")", path);
+      std::abort();
+    }
+  }
+
+  std::size_t skipped = 0, archived = 0;
+  std::uint64_t bytes = 0;
+  for (auto& name : cards) {
+    auto [error, card] = open_card(name, open_options);
+    if (!card) {
+      fmt::println(stderr, R"(Skipping card "{}", which failed to open)", name);
+      ++skipped;
+      continue;
+    }
+    auto image = Memcard::GetCardImage(*card);
+    if (!archive) {
+      archive = Memcard::GCMemcardArchive::Create(path, image, level);
+      if (!archive) {
+        fmt::println(stderr, R"(Failed to create archive "{}")", path);
+        std::abort();
+      }
+      fmt::println(progress_out, R"(Compressing against base card "{}")", name);
+    }
+    auto archived_name = split_archived(name);
+    if (!archive->Append(archived_name ? archived_name->second : name, image)) {
+      fmt::println(stderr, R"(Failed to append card "{}" to archive "{}")", name, path);
+      std::abort();
+    }
+    ++archived;
+    bytes += image.size();
+  }
+
+  if (archive) {
+    std::uint64_t compressed = 0;
+    auto& entries = archive->GetEntries();
+    for (auto it = entries.end() - archived; it != entries.end(); ++it) {
+      compressed += it->compressed_size;
+    }
+    fmt::println(progress_out, "Archived {} cards, {} bytes down to {}", archived, bytes,
+        compressed);
+  }
+  return skipped;
+}
+
+// Checks every card under the given cards and directories, one JSON object per card. Only the
+// filesystem blocks are read, unless deep also reads all data and walks every file's chain.
+// Returns how many cards are unusable.
+std::size_t validate_cards(std::vector<std::string> const& inputs, unsigned jobs, bool deep,
+    std::FILE* out) {
+  auto cards = find_cards(inputs);
+
+  std::mutex out_mutex;
+  std::atomic<std::size_t> invalid {0};
+  parallel_for(cards.size(), jobs, [&] (std::size_t i) {
+    auto& name = cards[i];
+    auto [error, card] = deep && !split_archived(name) ?
+        Memcard::GCMemcard::Open(name) : open_card(name, {});
+    if (!card) ++invalid;
+
+    std::vector<std::string> issues;
+    for (std::size_t j = 0; j < static_cast<std::size_t>(Memcard::GCMemcardValidityIssues::COUNT); ++j) {
+      auto issue = static_cast<Memcard::GCMemcardValidityIssues>(j);
+      if (error.Test(issue)) issues.push_back(fmt::format(R"("{}")", issue_name(issue)));
+    }
+
+    auto line = fmt::format(R"({{"card": "{}", "valid": {}, "issues": [{}])", json_escape(name),
+        card.has_value(), fmt::join(issues, ", "));
+    if (card) {
+      line += fmt::format(R"(, "files": {}, "free_blocks": {})", card->GetNumFiles(),
+          card->GetFreeBlocks());
+    }
+    if (card && deep) {
+      // Files whose chain ends early, and blocks claimed by more than one file
+      std::vector<unsigned> broken;
+      std::vector<bool> used(card->GetSizeBlocks());
+      std::size_t cross_linked = 0;
+      for (std::uint8_t j = 0; j < Memcard::DIRLEN; ++j) {
+        auto entry = card->GetDEntry(j);
+        if (!entry || entry->m_gamecode == Memcard::DEntry::UNINITIALIZED_GAMECODE) continue;
+        auto* chain = card->GetBlockChain(j);
+        if (!chain) {
+          broken.push_back(j);
+          continue;
+        }
+        for (auto block : *chain) {
+          if (used[block]) ++cross_linked;
+          used[block] = true;
+        }
+      }
+      line += fmt::format(R"(, "broken_chains": [{}], "cross_linked_blocks": {})",
+          fmt::join(broken, ", "), cross_linked);
+    }
+    line += "}";
+
+    std::lock_guard lock {out_mutex};
+    fmt::println(out, "{}", line);
+  });
+  std::fflush(out);
+  return invalid;
+}
+
+/*----- Corpus Statistics -----*/
+
+// Profiles are little endian regardless of host:
+//   "SCLP" | u32 version | u32 save count
+//   then per save: its 64 byte directory entry | u32 cards | u32 offsets
+//   then per offset: u16 entropy in 1/4096 bits | u8 most common value | u8 distinct values - 1
+constexpr std::string_view profile_magic = "SCLP";
+constexpr std::uint32_t profile_version = 1;
+constexpr std::size_t profile_entry_size = 4;
+
+// The values a save takes at every offset, across every card holding it.
+struct save_stats {
+  Memcard::DEntry dir_entry;
+  std::uint32_t cards = 0;
+  // 256 counts per offset of the save
+  std::vector<std::uint32_t> histograms;
+};
+
+// What the structure-aware mutators read back from a profile.
+struct save_profile {
+  Memcard::DEntry dir_entry;
+  std::vector<std::uint16_t> entropy;
+};
+
+// Offsets whose histograms one worker fills at a time, 64 KiB of counts so they stay in cache
+// while every card of a batch streams past. Tiles never straddle a block.
+constexpr std::size_t stats_tile_size = 64;
+static_assert(Memcard::BLOCK_SIZE % stats_tile_size == 0);
+
+// Cards mapped at once; their pages are only read once per tile, so more buys little.
+constexpr std::size_t stats_batch_size = 256;
+
+// Accumulates the histograms of every save of the first card over every card holding the same
+// save at the same size, in batches of mapped cards, and writes the profile. Cards that fail to
+// open are skipped. Returns how many were.
+std::size_t collect_stats(std::vector<std::string> const& inputs, std::string const& output,
+    unsigned jobs, GCMemcardOpenOptions const& open_options) {
+  auto names = find_cards(inputs);
+  if (names.empty()) throw profile_failed("No cards to profile");
+
+  std::vector<save_stats> stats;
+  std::vector<std::pair<std::size_t, std::size_t>> tiles;
+  std::size_t skipped = 0;
+  for (std::size_t first = 0; first < names.size(); first += stats_batch_size) {
+    auto count = std::min(stats_batch_size, names.size() - first);
+    std::vector<std::optional<GCMemcard>> cards(count);
+    parallel_for(count, jobs, [&] (std::size_t i) {
+      auto [error, card] = open_card(names[first + i], open_options);
+      if (card) {
+        cards[i] = std::move(card);
+      } else {
+        fmt::println(stderr, R"(Skipping card "{}", it failed to open)", names[first + i]);
+      }
+    });
+
+    // The first card that opens decides which saves are profiled
+    if (stats.empty()) {
+      auto base = std::find_if(cards.begin(), cards.end(),
+          [] (auto& card) { return card.has_value(); });
+      if (base != cards.end()) {
+        for (std::uint8_t i = 0; i < (*base)->GetNumFiles(); ++i) {
+          auto entry = (*base)->GetDEntry((*base)->GetFileIndex(i));
+          if (!entry) continue;
+          auto& save = stats.emplace_back();
+          save.dir_entry = *entry;
+          std::size_t offsets = std::size_t {entry->m_block_count} * Memcard::BLOCK_SIZE;
+          save.histograms.resize(offsets * 256);
+          for (std::size_t tile = 0; tile < offsets; tile += stats_tile_size) {
+            tiles.emplace_back(stats.size() - 1, tile);
+          }
+        }
+      }
+    }
+
+    // Every card's views of the profiled saves, or nothing where it doesn't hold them
+    std::vector<std::vector<Memcard::GCMemcardSaveView>> views(stats.size());
+    for (auto& card : cards) {
+      if (!card) {
+        ++skipped;
+        continue;
+      }
+      for (std::size_t i = 0; i < stats.size(); ++i) {
+        auto index = card->TitlePresent(stats[i].dir_entry);
+        if (!index || card->DEntry_BlockCount(*index) != stats[i].dir_entry.m_block_count) continue;
+        auto view = card->GetSaveDataView(*index);
+        if (!view) continue;
+        views[i].push_back(*view);
+        ++stats[i].cards;
+      }
+    }
+
+    parallel_for(tiles.size(), jobs, [&] (std::size_t i) {
+      auto [save, tile] = tiles[i];
+      auto* histograms = &stats[save].histograms[tile * 256];
+      for (auto& view : views[save]) {
+        auto* data = view.GetContiguous(tile, stats_tile_size);
+        for (std::size_t offset = 0; offset < stats_tile_size; ++offset) {
+          ++histograms[offset * 256 + data[offset]];
+        }
+      }
+    });
+  }
+  if (stats.empty()) throw profile_failed("None of the cards could be opened");
+
+  std::string out {profile_magic};
+  put_le(out, profile_version, 4);
+  put_le(out, stats.size(), 4);
+  for (auto& save : stats) {
+    auto offsets = save.histograms.size() / 256;
+    out.append(reinterpret_cast<char const*>(&save.dir_entry), sizeof(save.dir_entry));
+    put_le(out, save.cards, 4);
+    put_le(out, offsets, 4);
+
+    auto start = out.size();
+    out.resize(start + offsets * profile_entry_size);
+    parallel_for((offsets + stats_tile_size - 1) / stats_tile_size, jobs, [&] (std::size_t tile) {
+      auto end = std::min(offsets, (tile + 1) * stats_tile_size);
+      for (auto offset = tile * stats_tile_size; offset < end; ++offset) {
+        auto* histogram = &save.histograms[offset * 256];
+        double entropy = 0;
+        int distinct = 0;
+        auto mode = std::max_element(histogram, histogram + 256) - histogram;
+        for (int value = 0; value < 256; ++value) {
+          if (!histogram[value]) continue;
+          auto p = static_cast<double>(histogram[value]) / save.cards;
+          entropy -= p * std::log2(p);
+          ++distinct;
+        }
+        auto fixed = static_cast<std::uint16_t>(std::lround(entropy * 4096));
+        auto* entry = &out[start + offset * profile_entry_size];
+        entry[0] = static_cast<char>(fixed);
+        entry[1] = static_cast<char>(fixed >> 8);
+        entry[2] = static_cast<char>(mode);
+        entry[3] = static_cast<char>(std::max(distinct, 1) - 1);
+      }
+    });
+  }
+  if (!File::WriteStringToFile(output, out)) {
+    throw profile_failed(fmt::format(R"(Failed to write profile "{}")", output));
+  }
+  return skipped;
+}
+
+std::vector<save_profile> read_profile(std::string const& path) {
+  std::string data;
+  if (!File::ReadFileToString(path, data)) {
+    throw profile_failed(fmt::format(R"(Failed to read profile "{}")", path));
+  }
+  std::string_view in {data};
+  auto take = [&] (std::size_t size) {
+    if (in.size() < size) throw profile_failed(fmt::format(R"(Profile "{}" is truncated)", path));
+    auto taken = in.substr(0, size);
+    in.remove_prefix(size);
+    return taken;
+  };
+  auto take_le = [&] (int bytes) {
+    auto taken = take(bytes);
+    return get_le(taken, bytes);
+  };
+
+  if (take(profile_magic.size()) != profile_magic || take_le(4) != profile_version) {
+    throw profile_failed(fmt::format(R"("{}" is not a version {} profile)", path,
+        profile_version));
+  }
+  std::vector<save_profile> profiles(take_le(4));
+  for (auto& profile : profiles) {
+    auto entry = take(sizeof(profile.dir_entry));
+    std::memcpy(&profile.dir_entry, entry.data(), entry.size());
+    take_le(4);
+    auto offsets = take_le(4);
+    auto entries = take(offsets * profile_entry_size);
+    profile.entropy.resize(offsets);
+    for (std::size_t i = 0; i < offsets; ++i) {
+      auto* bytes = &entries[i * profile_entry_size];
+      profile.entropy[i] = static_cast<std::uint8_t>(bytes[0]) |
+          static_cast<std::uint16_t>(static_cast<std::uint8_t>(bytes[1]) << 8);
+    }
+  }
+  return profiles;
+}
+
+/*----- Watch -----*/
+
+// Waits for files to be written or replaced. The directories holding them are watched rather
+// than the files, since emulators and editors often save by renaming over the old file.
+class file_watcher {
+public:
+  explicit file_watcher(std::vector<std::string> const& paths) {
+    for (auto& path : paths) {
+      paths_.emplace_back(path);
+      auto dir = paths_.back().parent_path();
+      if (dir.empty()) dir = ".";
+#if defined(__linux__)
+      if (fd_ < 0) fd_ = inotify_init1(IN_CLOEXEC);
+      watches_.push_back(inotify_add_watch(fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO));
+      if (watches_.back() < 0) {
+        fmt::println(stderr, R"(Failed to watch "{}")", dir.string());
+        std::abort();
+      }
+#else
+      std::error_code error;
+      times_.push_back(std::filesystem::last_write_time(paths_.back(), error));
+#endif
+#if defined(_WIN32)
+      handles_.push_back(FindFirstChangeNotificationW(dir.c_str(), FALSE,
+          FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME));
+      if (handles_.back() == INVALID_HANDLE_VALUE) {
+        fmt::println(stderr, R"(Failed to watch "{}")", dir.string());
+        std::abort();
+      }
+#endif
+    }
+  }
+
+  ~file_watcher() {
+#if defined(__linux__)
+    if (fd_ >= 0) close(fd_);
+#elif defined(_WIN32)
+    for (auto handle : handles_) FindCloseChangeNotification(handle);
+#endif
+  }
+
+  file_watcher(file_watcher const&) = delete;
+  file_watcher& operator=(file_watcher const&) = delete;
+
+  // Blocks until at least one of the files changed, and returns the indices of all that did.
+  // Changes that land in quick succession, like the writes of a single save, are returned at once.
+  std::vector<std::size_t> wait() {
+    std::vector<std::size_t> changed;
+#if defined(__linux__)
+    alignas(inotify_event) char buffer[4096];
+    auto timeout = -1;
+    while (true) {
+      pollfd fd {fd_, POLLIN, 0};
+      if (poll(&fd, 1, timeout) <= 0) {
+        if (!changed.empty()) break;
+        continue;
+      }
+      auto size = read(fd_, buffer, sizeof(buffer));
+      for (decltype(size) at = 0; at < size;) {
+        auto* event = reinterpret_cast<inotify_event const*>(buffer + at);
+        at += sizeof(inotify_event) + event->len;
+        if (!event->len) continue;
+        for (std::size_t i = 0; i < paths_.size(); ++i) {
+          if (watches_[i] == event->wd && paths_[i].filename() == event->name) changed.push_back(i);
+        }
+      }
+      if (!changed.empty()) timeout = settle_ms;
+    }
+#else
+    while (true) {
+#if defined(_WIN32)
+      WaitForMultipleObjects(static_cast<DWORD>(handles_.size()), handles_.data(), FALSE,
+          INFINITE);
+      for (auto handle : handles_) FindNextChangeNotification(handle);
+#endif
+      std::this_thread::sleep_for(std::chrono::milliseconds(settle_ms));
+      for (std::size_t i = 0; i < paths_.size(); ++i) {
+        std::error_code error;
+        auto time = std::filesystem::last_write_time(paths_[i], error);
+        if (error || time == times_[i]) continue;
+        times_[i] = time;
+        changed.push_back(i);
+      }
+      if (!changed.empty()) break;
+    }
+#endif
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    return changed;
+  }
+
+private:
+  static constexpr int settle_ms = 10;
+
+  std::vector<std::filesystem::path> paths_;
+#if defined(__linux__)
+  int fd_ = -1;
+  std::vector<int> watches_;
+#else
+  std::vector<std::filesystem::file_time_type> times_;
+#endif
+#if defined(_WIN32)
+  std::vector<HANDLE> handles_;
+#endif
+};
+
+// A card as the watch loop last read it, and the hashes of its blocks back then.
+struct watched_card {
+  std::string path;
+  std::optional<GCMemcard> card;
+  std::vector<std::uint64_t> hashes;
+};
+
+// A save on both cards, and its diffs when the watch loop last looked.
+struct watched_save {
+  Memcard::DEntry dir_entry;
+  std::vector<std::uint16_t> lhs_chain;
+  std::vector<std::uint16_t> rhs_chain;
+  region_map diffs;
+};
+
+std::string entry_name(Memcard::DEntry const& entry) {
+  auto* base = reinterpret_cast<char const*>(entry.m_filename.data());
+  return {base, strnlen(base, entry.m_filename.size())};
+}
+
+// Pairs the saves of both cards like pair_saves does, without extracting them.
+std::vector<watched_save> pair_watched_saves(GCMemcard const& lhs, GCMemcard const& rhs) {
+  std::vector<watched_save> saves;
+  for (std::uint8_t i = 0; i < lhs.GetNumFiles(); ++i) {
+    auto lhsindex = lhs.GetFileIndex(i);
+    auto entry = lhs.GetDEntry(lhsindex);
+    auto rhsindex = entry ? rhs.TitlePresent(*entry) : std::nullopt;
+    if (!rhsindex) continue;
+    auto const* lhschain = lhs.GetBlockChain(lhsindex);
+    auto const* rhschain = rhs.GetBlockChain(*rhsindex);
+    if (!lhschain || !rhschain || lhschain->size() != rhschain->size()) continue;
+    saves.push_back({*entry, *lhschain, *rhschain, {}});
+  }
+  return saves;
+}
+
+// Diffs the blocks of the save flagged in changed straight from both cards, and takes every
+// other block's regions from old.
+region_map rediff_save(watched_save const& save, region_map const& old,
+    std::vector<bool> const& changed, GCMemcard const& lhs, GCMemcard const& rhs) {
+  region_map diffs;
+  diffs.reserve(save.lhs_chain.size(), old.range_count());
+  for (std::size_t block = 0; block < save.lhs_chain.size(); ++block) {
+    if (!changed[block]) {
+      diffs.push_block();
+      for (auto [start, end] : old[block]) diffs.push_range(start, end);
+      continue;
+    }
+    diff_mask mask;
+    mask_block(lhs.GetRawBlock(save.lhs_chain[block]), rhs.GetRawBlock(save.rhs_chain[block]),
+        mask);
+    emit_regions(mask, diffs);
+  }
+  return diffs;
+}
+
+// Prints the regions of a block that only one of two diffs holds, prefixed with + if it's the
+// newer one and - if it's the older one.
+void print_region_changes(std::string_view name, std::size_t block,
+    region_map::block_view before, region_map::block_view after) {
+  auto print_missing = [&] (char sign, region_map::block_view from, region_map::block_view in) {
+    for (auto range : from) {
+      if (range.first == range.second || std::find(in.begin(), in.end(), range) != in.end()) {
+        continue;
+      }
+      fmt::println(stdout, R"({} "{}" block {} [{}, {}])", sign, name, block, range.first,
+          range.second);
+    }
+  };
+  print_missing('-', before, after);
+  print_missing('+', after, before);
+}
+
+// Diffs two cards, then keeps their block hashes and diffs resident and, whenever either card is
+// saved over, rediffs just the blocks whose hash changed and prints the regions that appeared or
+// disappeared. Runs until killed.
+void watch_cards(std::string const& lhs, std::string const& rhs,
+    GCMemcardOpenOptions const& open_options) {
+  std::array<watched_card, 2> cards {{{lhs, {}, {}}, {rhs, {}, {}}}};
+  for (auto& watched : cards) {
+    auto [error, card] = GCMemcard::OpenMapped(watched.path, open_options);
+    if (!card) report_error(watched.path, error);
+    watched.card = std::move(card);
+    watched.hashes = watched.card->GetBlockHashes();
+  }
+
+  auto saves = pair_watched_saves(*cards[0].card, *cards[1].card);
+  std::size_t regions = 0;
+  for (auto& save : saves) {
+    save.diffs = rediff_save(save, {}, std::vector<bool>(save.lhs_chain.size(), true),
+        *cards[0].card, *cards[1].card);
+    for (auto block : save.diffs) {
+      regions += std::count_if(block.begin(), block.end(),
+          [] (auto range) { return range.first != range.second; });
+    }
+  }
+  fmt::println(progress_out, R"(Watching "{}" and "{}", {} paired saves with {} diff regions)", lhs,
+      rhs, saves.size(), regions);
+
+  file_watcher watcher {{lhs, rhs}};
+  while (true) {
+    auto changed_cards = watcher.wait();
+    auto start = std::chrono::steady_clock::now();
+
+    // Reopen every changed card before taking any of them, so that a card that fails to reopen
+    // doesn't leave the other one newer than the diffs
+    std::array<std::optional<GCMemcard>, 2> reopened;
+    auto reread = true;
+    for (std::size_t i = 0; i < cards.size(); ++i) {
+      auto& watched = cards[i];
+      if (std::find(changed_cards.begin(), changed_cards.end(), i) == changed_cards.end()) continue;
+
+      auto [error, card] = GCMemcard::OpenMapped(watched.path, open_options);
+      if (!card) {
+        fmt::println(stderr, R"(Failed to reopen card "{}", waiting for it to be saved again)",
+            watched.path);
+        reread = false;
+        break;
+      }
+      if (card->GetBlockHashes().size() != watched.hashes.size()) {
+        fmt::println(stderr, R"(Card "{}" changed size, stopping)", watched.path);
+        return;
+      }
+      reopened[i] = std::move(card);
+    }
+    if (!reread) continue;
+
+    // Which card blocks changed since the last look, and whether any of them is a filesystem block
+    std::array<std::vector<bool>, 2> changed_blocks;
+    auto layout_changed = false;
+    for (std::size_t i = 0; i < cards.size(); ++i) {
+      auto& watched = cards[i];
+      changed_blocks[i].assign(watched.card->GetSizeBlocks(), false);
+      if (!reopened[i]) continue;
+
+      auto& hashes = reopened[i]->GetBlockHashes();
+      for (std::size_t block = 0; block < hashes.size(); ++block) {
+        if (hashes[block] == watched.hashes[block]) continue;
+        changed_blocks[i][block] = true;
+        layout_changed |= block < Memcard::MC_FST_BLOCKS;
+      }
+      watched.hashes = hashes;
+      watched.card = std::move(reopened[i]);
+    }
+
+    auto& lhscard = *cards[0].card;
+    auto& rhscard = *cards[1].card;
+    auto updated = layout_changed ? pair_watched_saves(lhscard, rhscard) : std::move(saves);
+    std::vector<bool> kept(layout_changed ? saves.size() : 0);
+    for (auto& save : updated) {
+      auto name = entry_name(save.dir_entry);
+      auto blocks = save.lhs_chain.size();
+
+      // After a directory change, a save only keeps its old diffs if it's still in the same place
+      watched_save const* old = &save;
+      if (layout_changed) {
+        auto match = std::find_if(saves.begin(), saves.end(), [&] (auto& other) {
+          return Memcard::HasSameIdentity(other.dir_entry, save.dir_entry) &&
+              other.lhs_chain.size() == blocks;
+        });
+        old = match != saves.end() ? &*match : nullptr;
+        if (old) kept[match - saves.begin()] = true;
+      }
+
+      std::vector<bool> changed(blocks);
+      for (std::size_t block = 0; block < blocks; ++block) {
+        changed[block] = !old || old->lhs_chain[block] != save.lhs_chain[block] ||
+            old->rhs_chain[block] != save.rhs_chain[block] ||
+            changed_blocks[0][save.lhs_chain[block]] || changed_blocks[1][save.rhs_chain[block]];
+      }
+      static region_map const no_diffs;
+      auto const& before = old ? old->diffs : no_diffs;
+      auto diffs = rediff_save(save, before, changed, lhscard, rhscard);
+      for (std::size_t block = 0; block < blocks; ++block) {
+        if (!changed[block]) continue;
+        auto was = old ? before[block] : region_map::block_view {nullptr, nullptr};
+        print_region_changes(name, block, was, diffs[block]);
+      }
+      save.diffs = std::move(diffs);
+    }
+
+    // Saves no longer on both cards take all their regions with them
+    for (std::size_t i = 0; i < kept.size(); ++i) {
+      if (kept[i]) continue;
+      auto name = entry_name(saves[i].dir_entry);
+      region_map::block_view none {nullptr, nullptr};
+      for (std::size_t block = 0; block < saves[i].diffs.size(); ++block) {
+        print_region_changes(name, block, saves[i].diffs[block], none);
+      }
+    }
+    saves = std::move(updated);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    fmt::println("Updated in {} us", elapsed.count());
+    std::fflush(stdout);
+  }
+}
+
+/*----- Discs -----*/
+
+// Unpacks the game partition of a disc into a folder Dolphin boots as is through its sys/main.dol,
+// so that runs booting the game over and over don't decompress the image every time.
+bool extract_disc(std::string const& path, std::string const& folder) {
+  auto volume = DiscIO::CreateVolume(path);
+  auto partition = volume ? volume->GetGamePartition() : DiscIO::PARTITION_NONE;
+  auto const* file_system = volume ? volume->GetFileSystem(partition) : nullptr;
+  if (!file_system || !file_system->IsValid()) {
+    fmt::println(stderr, R"(Failed to open the file system of disc "{}")", path);
+    return false;
+  }
+  if (!DiscIO::ExportSystemData(*volume, partition, folder)) {
+    fmt::println(stderr, R"(Failed to extract the system data of "{}")", path);
+    return false;
+  }
+
+  // Volumes can't be shared between threads, so every exporting thread opens the disc again
+  std::size_t entries = 0;
+  DiscIO::ExportDirectoryParallel(*volume, partition, file_system->GetRoot(), true, "",
+      folder + "/files", [&] (std::string const&) { ++entries; return false; },
+      [&] { return DiscIO::CreateVolume(path); });
+  fmt::println(R"(Extracted {} files and folders of "{}" to "{}")", entries, path, folder);
+  return true;
+}
+
+}
+
+/*----- Main -----*/
+
+int main(int argc, char** argv) {
+  // Setup CLI parser
+  argh::parser cli;
+  cli.add_param("scramble");
+  cli.add_param("mutations");
+  cli.add_param("chunk-size");
+  cli.add_param("minimum-size");
+  cli.add_param("jobs");
+  cli.add_param("output");
+  cli.add_param("count");
+  cli.add_param("output-pattern");
+  cli.add_param("seed");
+  cli.add_param("run");
+  cli.add_param("frames");
+  cli.add_param("hang-timeout");
+  cli.add_param("failure-state");
+  cli.add_param("user");
+  cli.add_param("result");
+  cli.add_param("snapshot-frame");
+  cli.add_param("snapshot-pc");
+  cli.add_param("workers");
+  cli.add_param("mutators");
+  cli.add_param("live-mask");
+  cli.add_param("first-reads");
+  cli.add_param("trace");
+  cli.add_param("stats");
+  cli.add_param("in-flight");
+  cli.add_param("format");
+  cli.add_param("report");
+  cli.add_param("field");
+  cli.add_param("profile");
+  cli.add_param("listen");
+  cli.add_param("level");
+  cli.parse(argc, argv);
+
+  // Only builds configured with ENABLE_TRACING record anything
+  trace_writer trace {cli("trace", "").str()};
+  stats_writer stats {cli("stats", "").str()};
+  if (cli("format") && cli("format").str() != "text" && !cli("report")) progress_out = stderr;
+
+  // Cards we generated ourselves don't need to be checked again every time they're opened
+  GCMemcardOpenOptions open_options;
+  open_options.skip_validation = cli["trusted"];
+  // Mutants are cloned from the base card and thrown away by the thousand, so keep reusing their
+  // storage instead of allocating it fresh every time
+  open_options.block_pool = std::make_shared<Memcard::GCMemcardBlockPool>(cli["huge-pages"]);
+
+  // Rebuild a mutant from its base card and journal
+  if (cli(1).str() == "replay") {
+    std::string base, journal, output;
+    if (any_of([] (auto&& arg) { return !arg; }, cli(2), cli(3), cli(4))) {
+      fmt::print(stderr, "Usage: smashcardloader replay <base card> <journal> <output card>");
+      std::abort();
+    }
+    cli(2) >> base;
+    cli(3) >> journal;
+    cli(4) >> output;
+    replay(base, journal, output, open_options);
+    return 0;
+  }
+
+  // Shrink a failing mutant down to the edits it needs to fail
+  if (cli(1).str() == "minimize") {
+    if (!cli(4) || !cli("run")) {
+      fmt::print(stderr, "Usage: smashcardloader minimize <base> <mutant|journal> <output> "
+          "--run <iso> [--workers N] [--any-failure] [--frames N] [--hang-timeout S] "
+          "[--user DIR]");
+      std::abort();
+    }
+    std::string base, mutant, output;
+    cli(2) >> base;
+    cli(3) >> mutant;
+    cli(4) >> output;
+    unsigned workers;
+    cli("workers", 1) >> workers;
+    minimize(base, mutant, output, parse_run_options(cli), workers, cli("user", "").str(),
+        cli["any-failure"], open_options);
+    return 0;
+  }
+
+  // Boot a card and record which of its bytes the game reads, for --live-mask. With --first-reads N
+  // only the bytes of the first N blocks the game read are kept, so mutants target what the game
+  // parses first, like the headers and checksums it checks before anything else.
+  if (cli(1).str() == "probe") {
+    std::string card, mask;
+    if (!cli(3) || !cli("run")) {
+      fmt::print(stderr, "Usage: smashcardloader probe <card> <live mask> --run <iso> "
+          "[--frames N] [--hang-timeout S] [--user DIR] [--first-reads N]");
+      std::abort();
+    }
+    std::size_t first_read_count = 0;
+    if (cli("first-reads") && !(cli("first-reads") >> first_read_count)) {
+      fmt::print(stderr, "--first-reads takes a number of blocks");
+      std::abort();
+    }
+    cli(2) >> card;
+    cli(3) >> mask;
+    auto [error, memcard] = open_card(card, open_options);
+    if (!memcard) report_error(card, error);
+
+    init_harness(cli("user", "").str());
+    auto image = Memcard::GetCardImage(*memcard);
+    Memcard::StartReadWatch(ExpansionInterface::Slot::A, static_cast<std::uint32_t>(image.size()));
+    auto options = parse_run_options(cli);
+    run_result result;
+    std::vector<std::uint16_t> first_reads;
+    if (auto failure = boot_card(std::move(image), options, false)) {
+      result = *failure;
+    } else {
+      result = watch_core(options, [] { return false; });
+      // The device goes away with the core
+      Core::RunAsCPUThread([&] { first_reads = first_read_blocks(); });
+      stop_core();
+    }
+    auto live = Memcard::StopReadWatch();
+    shutdown_harness();
+    fmt::println("First blocks read: {:#x}", fmt::join(first_reads, " "));
+    if (cli("first-reads")) {
+      first_reads.resize(std::min(first_reads.size(), first_read_count));
+      for (std::size_t i = 0; i < live.size(); ++i) {
+        auto block = static_cast<std::uint16_t>(i / Memcard::BLOCK_SIZE);
+        if (std::find(first_reads.begin(), first_reads.end(), block) == first_reads.end()) {
+          live[i] = false;
+        }
+      }
+    }
+    write_live_mask(mask, live);
+    fmt::println(R"(The game read {} of {} card bytes over {} frames, ending {})",
+        std::count(live.begin(), live.end(), true), live.size(), result.frames,
+        outcome_name(result.outcome));
+    return static_cast<int>(result.outcome);
+  }
+
+  // Unpack a disc for runs to boot from
+  if (cli(1).str() == "extract") {
+    if (!cli(2) || !cli(3)) {
+      fmt::print(stderr, "Usage: smashcardloader extract <disc> <folder>");
+      std::abort();
+    }
+    return extract_disc(cli(2).str(), cli(3).str()) ? 0 : 1;
+  }
+
+  // Boot a single card in-process and report how the game fared with it
+  if (cli(1).str() == "run") {
+    std::string card;
+    if (!cli(2) || !cli("run")) {
+      fmt::print(stderr, "Usage: smashcardloader run <card> --run <iso> [--frames N] "
+          "[--hang-timeout S] [--user DIR] [--result FILE] [--coverage] "
+          "[--failure-state FILE]");
+      std::abort();
+    }
+    cli(2) >> card;
+    auto [error, memcard] = open_card(card, open_options);
+    if (!memcard) report_error(card, error);
+
+    auto* results = open_results(cli);
+    init_harness(cli("user", "").str());
+    auto result = run_card(Memcard::GetCardImage(*memcard), parse_run_options(cli));
+    print_result(results, card, result);
+    shutdown_harness();
+    if (results != stdout) std::fclose(results);
+    return static_cast<int>(result.outcome);
+  }
+
+  // Run the mutants a coordinator started with --listen sends over
+  if (cli(1).str() == "worker") {
+    if (!cli(2)) {
+      fmt::print(stderr, "Usage: smashcardloader worker <host[:port]> [--run <iso>] [--user DIR]");
+      std::abort();
+    }
+    try {
+      run_remote_worker(cli(2).str(), cli("run", "").str(), cli("user", "").str(), open_options);
+    } catch (remote_failed const& e) {
+      fmt::println(stderr, "{}", e.what());
+      std::abort();
+    }
+    return 0;
+  }
+
+  // Convert savefiles between formats, or export every save from cards, in bulk
+  if (cli(1).str() == "convert") {
+    std::string format_name, output;
+    if (any_of([] (auto&& arg) { return !arg; }, cli(2), cli(3), cli(4))) {
+      fmt::print(stderr, "Usage: smashcardloader convert <gci|gcs|sav> <output dir> "
+          "<savefile|card|dir>... [--in-flight N]");
+      std::abort();
+    }
+    cli(2) >> format_name;
+    cli(3) >> output;
+    auto format = parse_savefile_format(format_name);
+    if (!format) {
+      fmt::println(stderr, R"(Unknown savefile format "{}", expected gci, gcs or sav)", format_name);
+      std::abort();
+    }
+    Memcard::BatchSavefileOptions options;
+    options.format = *format;
+    cli("in-flight", options.max_in_flight) >> options.max_in_flight;
+    auto& args = cli.pos_args();
+    std::vector<std::string> inputs(args.begin() + 4, args.end());
+    return convert_saves(inputs, output, std::move(options)) == 0 ? 0 : 1;
+  }
+
+  // Check cards for corruption in bulk, without stopping at the first bad one
+  if (cli(1).str() == "validate") {
+    if (!cli(2)) {
+      fmt::print(stderr, "Usage: smashcardloader validate <card|dir>... [--deep] [--jobs N] "
+          "[--result FILE]");
+      std::abort();
+    }
+    unsigned jobs;
+    cli("jobs", std::max(std::thread::hardware_concurrency(), 1u)) >> jobs;
+    auto& args = cli.pos_args();
+    std::vector<std::string> inputs(args.begin() + 2, args.end());
+    auto* results = open_results(cli);
+    auto invalid = validate_cards(inputs, jobs, cli["deep"], results);
+    if (results != stdout) std::fclose(results);
+    return invalid == 0 ? 0 : 1;
+  }
+
+  // Profile the values of every save offset across a corpus, for --profile
+  if (cli(1).str() == "stats") {
+    if (!cli(3)) {
+      fmt::print(stderr, "Usage: smashcardloader stats <profile> <card|dir>... [--jobs N]");
+      std::abort();
+    }
+    std::string profile;
+    cli(2) >> profile;
+    unsigned jobs;
+    cli("jobs", std::max(std::thread::hardware_concurrency(), 1u)) >> jobs;
+    auto& args = cli.pos_args();
+    std::vector<std::string> inputs(args.begin() + 3, args.end());
+    try {
+      auto skipped = collect_stats(inputs, profile, jobs, open_options);
+      if (skipped) fmt::println("Skipped {} cards that failed to open", skipped);
+    } catch (profile_failed const& e) {
+      fmt::println(stderr, "{}", e.what());
+      std::abort();
+    }
+    return 0;
+  }
+
+  // Pack cards into an archive, or add them to one
+  if (cli(1).str() == "archive") {
+    if (!cli(3) || !is_archive(cli(2).str())) {
+      fmt::print(stderr, "Usage: smashcardloader archive <archive.gcma> <card|dir>... [--level N]");
+      std::abort();
+    }
+    int level;
+    cli("level", Memcard::ARCHIVE_DEFAULT_LEVEL) >> level;
+    auto& args = cli.pos_args();
+    std::vector<std::string> inputs(args.begin() + 3, args.end());
+    return archive_cards(cli(2).str(), inputs, level, open_options) == 0 ? 0 : 1;
+  }
+
+  // Relay the files of cards contiguously, in place
+  if (cli(1).str() == "compact") {
+    if (!cli(2)) {
+      fmt::print(stderr, "Usage: smashcardloader compact <card>... [--jobs N]");
+      std::abort();
+    }
+    unsigned jobs;
+    cli("jobs", std::max(std::thread::hardware_concurrency(), 1u)) >> jobs;
+    auto& args = cli.pos_args();
+    std::vector<std::string> cards(args.begin() + 2, args.end());
+    return compact_cards(cards, jobs, open_options) == 0 ? 0 : 1;
+  }
+
+  // Patch a delta onto its base card, in place unless an output card is given
+  if (cli(1).str() == "apply") {
+    std::string base, delta, output;
+    if (any_of([] (auto&& arg) { return !arg; }, cli(2), cli(3))) {
+      fmt::print(stderr, "Usage: smashcardloader apply <base card> <delta> [output card]");
+      std::abort();
+    }
+    cli(2) >> base;
+    cli(3) >> delta;
+    cli(4, "") >> output;
+    apply_delta(base, delta, output);
+    return 0;
+  }
+
+  // Keep diffing two cards every time either is saved over
+  if (cli["watch"]) {
+    if (!cli(2) || is_savefile(cli(1).str())) {
+      fmt::print(stderr, "Usage: smashcardloader <card> <card> --watch");
+      std::abort();
+    }
+    watch_cards(cli(1).str(), cli(2).str(), open_options);
+    return 0;
+  }
+
+  unsigned jobs;
+  cli("jobs", std::max(std::thread::hardware_concurrency(), 1u)) >> jobs;
+
+  std::string output;
+  std::optional<GCMemcard> basecard;
+  std::vector<Savefile> basesaves;
+  std::vector<region_map> diffs;
+  std::vector<std::vector<std::uint32_t>> counts;
+  std::vector<std::vector<Savefile>> donors;
+  if (cli["corpus"]) {
+    // Diff any number of cards against the first one
+    auto names = collect_cards(cli);
+    if (names.size() < 2) {
+      fmt::print(stderr, "You must supply at least two cards, or directories of cards, to diff");
+      std::abort();
+    }
+    cli("output", "/dev/null") >> output;
+    fmt::println(R"(Diffing {} cards against base card "{}")", names.size(), names.front());
+
+    // Only the saves are kept around, except for the base card we write back into. Opening the
+    // next card overlaps extracting the saves of the ones before it.
+    std::vector<std::vector<Savefile>> cards(names.size());
+    {
+      pipeline_stage<std::pair<std::size_t, GCMemcard>> extract {jobs, [&] (auto opened) {
+        cards[opened.first] = extract_saves(opened.second);
+      }};
+      for (std::size_t i = 0; i < names.size(); ++i) {
+        auto [error, card] = open_card(names[i], open_options);
+        if (!card) report_error(names[i], error);
+        if (basecard) {
+          extract.push({i, std::move(*card)});
+        } else {
+          cards[i] = extract_saves(*card);
+          basecard = std::move(card);
+        }
+      }
+    }
+
+    // Match every other card's saves up with the base card's
+    std::vector<std::vector<Savefile const*>> partners;
+    for (std::size_t card = 1; card < cards.size(); ++card) {
+      partners.push_back(pair_saves(cards.front(), cards[card]));
+    }
+
+    // Compute regions
+    fmt::println("Enumerating regions with diffs across the corpus...");
+    auto& saves = cards.front();
+    diffs.resize(saves.size());
+    counts.resize(saves.size());
+    donors.resize(saves.size());
+    for (std::size_t i = 0; i < saves.size(); ++i) {
+      std::vector<Savefile const*> matched {&saves[i]};
+      for (auto& card : partners) {
+        if (card[i]) matched.push_back(card[i]);
+      }
+
+      auto name = extract_filename(saves[i]);
+      if (matched.size() < 2) {
+        fmt::println(R"(Save "{}" is only on the base card, leaving it untouched)", name);
+        continue;
+      }
+      auto corpus = calculate_corpus_diffs(matched, jobs);
+      auto varying = std::count(corpus.varies.begin(), corpus.varies.end(), 1);
+      fmt::println(R"({} of {} blocks of save "{}" vary across {} cards)",
+          varying, corpus.varies.size(), name, matched.size());
+      if (cli["print-counts"]) {
+        print_counts(corpus);
+      }
+      diffs[i] = std::move(corpus.regions);
+      counts[i] = std::move(corpus.counts);
+      for (auto it = matched.begin() + 1; it != matched.end(); ++it) donors[i].push_back(**it);
+    }
+    basesaves = std::move(saves);
+  } else if (cli(2) && is_savefile(cli(1).str())) {
+    // Lone saves skip the card entirely, and their mutants are written as GCIs
+    std::string lhs, rhs;
+    cli(1) >> lhs;
+    cli(2) >> rhs;
+    cli(3, "/dev/null") >> output;
+    fmt::println(R"(Diffing saves "{}" and "{}")", lhs, rhs);
+    auto lhssave = read_save(lhs);
+    auto rhssave = read_save(rhs);
+    if (!Memcard::HasSameIdentity(lhssave.dir_entry, rhssave.dir_entry) ||
+        lhssave.blocks.size() != rhssave.blocks.size()) {
+      fmt::print(stderr, "Both saves must be the same save, with the same number of blocks");
+      std::abort();
+    }
+
+    fmt::println("Enumerating regions with diffs...");
+    diffs.push_back(calculate_diffs(lhssave, rhssave));
+    basesaves.push_back(std::move(lhssave));
+  } else {
+    std::string lhs, rhs;
+    if (any_of([] (auto&& arg) { return !arg; }, cli(1), cli(2))) {
+      fmt::print(stderr, "You must supply at least two files to diff, and an optional one to output to");
+      std::abort();
+    }
+
+    // Read our data
+    cli(1) >> lhs;
+    cli(2) >> rhs;
+    cli(3, "/dev/null") >> output;
+    fmt::println(R"(Diffing files "{}" and {}")", lhs, rhs);
+    auto [lhserror, lhscard] = open_card(lhs, open_options);
+    auto [rhserror, rhscard] = open_card(rhs, open_options);
+
+    // Validate
+    std::vector data {
+      std::tie(lhs, lhscard, lhserror),
+      std::tie(rhs, rhscard, rhserror)
+    };
+    for (auto& [name, card, error] : data) {
+      if (!card) report_error(name, error);
+    }
+
+    // Extract and pair up the saves of both.
+    auto lhssaves = extract_saves(*lhscard);
+    auto rhssaves = extract_saves(*rhscard);
+    auto partners = pair_saves(lhssaves, rhssaves);
+    for (std::size_t i = 0; i < lhssaves.size(); ++i) {
+      auto name = extract_filename(lhssaves[i]);
+      if (partners[i]) {
+        fmt::println(R"(Pairing save "{}" across both cards)", name);
+      } else {
+        fmt::println(R"(Save "{}" is only on the first card, leaving it untouched)", name);
+      }
+    }
+
+    // Compute regions, one pair of saves per job
+    fmt::println("Enumerating regions with diffs...");
+    diffs.resize(lhssaves.size());
+    parallel_for(lhssaves.size(), jobs, [&] (std::size_t i) {
+      if (partners[i]) calculate_diffs(lhssaves[i], *partners[i], diffs[i]);
+    });
+    basecard = std::move(lhscard);
+    basesaves = std::move(lhssaves);
+  }
+
+  // Print diffs, as text or for other tools to consume
+  if (cli["print"] || cli("format")) {
+    auto format = parse_report_format(cli("format", "text").str());
+    if (!format) {
+      fmt::println(stderr, R"(Unknown report format "{}", expected text, json or binary)",
+          cli("format").str());
+      std::abort();
+    }
+    auto* out = stdout;
+    if (cli("report")) {
+      out = std::fopen(cli("report").str().c_str(), "wb");
+      if (!out) {
+        fmt::println(stderr, R"(Failed to open report "{}")", cli("report").str());
+        std::abort();
+      }
+    }
+    {
+      diff_report report {out, *format};
+      for (std::size_t i = 0; i < basesaves.size(); ++i) {
+        if (diffs[i].size() == 0) continue;
+        auto index = basecard ? basecard->TitlePresent(basesaves[i].dir_entry) : std::nullopt;
+        report.add_save(i, extract_filename(basesaves[i]), diffs[i],
+            index ? basecard->GetBlockChain(*index) : nullptr,
+            Memcard::SaveFieldMap {basesaves[i].dir_entry});
+      }
+    }
+    if (out != stdout) std::fclose(out);
+  }
+
+  // Everything else works on the card around the saves
+  if (!basecard && (cli("live-mask") || cli["fixups"] || cli["delta"] || cli("run"))) {
+    fmt::print(stderr, "--live-mask, --fixups, --delta and --run need a card, not a lone save");
+    std::abort();
+  }
+
+  // Only mutate what a probe saw the game read
+  if (cli("live-mask")) {
+    std::string path;
+    cli("live-mask") >> path;
+    auto mask = read_live_mask(path, basecard->GetSizeBlocks() * std::size_t {Memcard::BLOCK_SIZE});
+    for (std::size_t i = 0; i < basesaves.size(); ++i) {
+      if (diffs[i].size() == 0) continue;
+      auto index = basecard->GetFileIndex(static_cast<std::uint8_t>(i));
+      auto const* chain = basecard->GetBlockChain(index);
+      if (!chain) {
+        fmt::println(stderr, R"(Save "{}" has a broken block chain, not narrowing it)",
+            extract_filename(basesaves[i]));
+        continue;
+      }
+      diffs[i] = restrict_to_live(diffs[i], *chain, mask);
+    }
+  }
+
+  // Only mutate the named fields of the saves' layouts
+  if (cli("field")) {
+    std::unordered_set<std::string> names;
+    for (auto& param : cli.params("field")) names.insert(param.second);
+    for (std::size_t i = 0; i < basesaves.size(); ++i) {
+      if (diffs[i].size() == 0) continue;
+      diffs[i] = restrict_to_fields(diffs[i], Memcard::SaveFieldMap {basesaves[i].dir_entry},
+          names);
+    }
+  }
+
+  // Collect corruption targets
+  mutant_options options;
+  for (auto& param : cli.params("scramble")) {
+    options.targets.insert(std::stoi(param.second));
+  }
+  cli("mutations", 1) >> options.mutations;
+  cli("chunk-size", 1) >> options.chunk_size;
+  cli("minimum-size", 1) >> options.minimum_size;
+  if (cli("mutators")) {
+    options.mutators.clear();
+    std::string names = cli("mutators").str();
+    for (std::size_t start = 0; start <= names.size();) {
+      auto end = std::min(names.find(',', start), names.size());
+      auto name = std::string_view {names}.substr(start, end - start);
+      auto kind = parse_mutator(name);
+      if (!kind) {
+        fmt::println(stderr, R"(Unknown mutator "{}", expected one of random, bit-flip, )"
+            "interesting, length or splice", name);
+        std::abort();
+      }
+      options.mutators.push_back(*kind);
+      start = end + 1;
+    }
+  }
+  options.weighted = cli["weighted"];
+  if (cli["fixups"]) options.fixup_header = &basecard->GetHeader();
+
+  // Weigh sites by how much their bytes vary across the profiled corpus instead
+  if (cli("profile")) {
+    std::vector<save_profile> profiles;
+    try {
+      profiles = read_profile(cli("profile").str());
+    } catch (profile_failed const& e) {
+      fmt::println(stderr, "{}", e.what());
+      std::abort();
+    }
+    counts.resize(basesaves.size());
+    for (std::size_t i = 0; i < basesaves.size(); ++i) {
+      auto match = std::find_if(profiles.begin(), profiles.end(), [&] (auto& profile) {
+        return Memcard::HasSameIdentity(profile.dir_entry, basesaves[i].dir_entry) &&
+            profile.entropy.size() == basesaves[i].blocks.size() * Memcard::BLOCK_SIZE;
+      });
+      if (match == profiles.end()) continue;
+      // Even offsets that never varied keep a sliver of weight, so they aren't ruled out
+      counts[i].assign(match->entropy.begin(), match->entropy.end());
+      for (auto& weight : counts[i]) ++weight;
+    }
+    options.weighted = true;
+  }
+  options.counts = std::move(counts);
+  options.donors = std::move(donors);
+  options.crypto_random = cli["crypto-random"];
+  options.journal = cli["journal"];
+  mutant_filter dedup;
+  if (!cli["allow-duplicates"]) options.dedup = &dedup;
+  options.delta = cli["delta"];
+  if (options.delta) {
+    options.base_hash = hash_card(*basecard);
+    // Fill the base card's hash cache up front, the workers only read it
+    basecard->GetBlockHashes();
+  }
+
+  // Without an explicit seed pick one, but report it so the run can be reproduced
+  std::uint64_t seed;
+  if (cli("seed")) {
+    cli("seed") >> seed;
+  } else {
+    std::random_device device;
+    seed = (std::uint64_t {device()} << 32) | device();
+  }
+  fmt::println("Using master seed {}", seed);
+
+  // Batch mode reuses the parsed base card and diffs for every mutant
+  int count;
+  cli("count", 1) >> count;
+  if (count < 0) {
+    fmt::print(stderr, "--count must not be negative");
+    std::abort();
+  }
+  if (cli("run")) {
+    // The emulator only runs one game per process, so a process boots its mutants in turn
+    if (count > 1 && !cli("output-pattern")) {
+      fmt::print(stderr, "Generating more than one mutant requires an --output-pattern");
+      std::abort();
+    }
+    auto run = parse_run_options(cli);
+    fuzz_batch batch {*basecard, basesaves, diffs, options, run, seed, output, {}, cli["guided"]};
+    cli("output-pattern", "") >> batch.pattern;
+    auto* results = open_results(cli);
+    std::string user_dir;
+    cli("user", "") >> user_dir;
+    unsigned workers;
+    cli("workers", 1) >> workers;
+    if (cli("listen")) {
+      std::uint16_t port;
+      cli("listen", default_remote_port) >> port;
+      fmt::println(stderr, R"(Running {} mutants against "{}" across remote workers...)", count,
+          run.iso);
+      run_distributed(batch, count, port, results);
+    } else if (workers > 1) {
+#ifndef _WIN32
+      workers = std::min({workers, MAX_WORKERS, static_cast<unsigned>(count)});
+      fmt::println(stderr, R"(Running {} mutants against "{}" across {} workers...)", count,
+          run.iso, workers);
+      run_orchestrated(batch, count, workers, user_dir, results);
+#else
+      fmt::print(stderr, "Running mutants across worker processes requires a POSIX host");
+      std::abort();
+#endif
+    } else {
+      init_harness(user_dir);
+      fmt::println(stderr, R"(Running {} mutants against "{}"...)", count, run.iso);
+      run_batch(batch, count, results);
+      shutdown_harness();
+    }
+    if (results != stdout) std::fclose(results);
+    dedup.print_summary();
+  } else if (cli("output-pattern")) {
+    std::string pattern;
+    cli("output-pattern") >> pattern;
+    fmt::println("Generating {} mutants across {} jobs...", count, jobs);
+    {
+      // A couple of mutants per job can wait to be written, enough to ride out a slow write
+      // without holding on to much, and as many writes as jobs can be in flight to keep up with
+      // them
+      auto const* base = basecard ? &*basecard : nullptr;
+      mutant_writer writer {2 * std::size_t {jobs}, [&] (pending_mutant mutant) {
+        write_pending(mutant, base, options);
+      }, jobs};
+      parallel_for(count, jobs, [&] (std::size_t i) {
+        auto name = fmt::sprintf(pattern, i);
+        if (basecard) {
+          generate_mutant(*basecard, basesaves, diffs, seed, i, options, name, &writer);
+        } else {
+          generate_save_mutant(basesaves, diffs, seed, i, options, name, &writer);
+        }
+      });
+    }
+    dedup.print_summary();
+  } else if (count == 1) {
+    fmt::println("Corrupting regions with diffs...");
+    if (basecard) {
+      generate_mutant(*basecard, basesaves, diffs, seed, 0, options, output);
+    } else {
+      generate_save_mutant(basesaves, diffs, seed, 0, options, output);
+    }
+  } else {
+    fmt::print(stderr, "Generating more than one mutant requires an --output-pattern");
+    std::abort();
+  }
 }
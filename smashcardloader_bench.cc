@@ -0,0 +1,176 @@
+// Benchmarks for the memcard pipeline smashcardloader is built on, across every card size and
+// with both sparse and dense diffs.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "smashcardloader_common.h"
+
+#include "Common/FileUtil.h"
+#include "Core/HW/GCMemcard/GCMemcard.h"
+
+namespace {
+
+constexpr std::array card_sizes {
+  Memcard::MBIT_SIZE_MEMORY_CARD_59,
+  Memcard::MBIT_SIZE_MEMORY_CARD_123,
+  Memcard::MBIT_SIZE_MEMORY_CARD_251,
+  Memcard::MBIT_SIZE_MEMORY_CARD_507,
+  Memcard::MBIT_SIZE_MEMORY_CARD_1019,
+  Memcard::MBIT_SIZE_MEMORY_CARD_2043,
+};
+
+// sparse changes one byte per KiB, dense changes every byte
+enum class diff_pattern { sparse, dense };
+
+// A freshly formatted card holding a single save that fills it, written to a file of its own, and
+// a copy of that save with the diff pattern applied.
+struct bench_card {
+  std::string path;
+  GCMemcard card;
+  Savefile save;
+  Savefile changed;
+  region_map diffs;
+
+  bench_card(std::uint16_t size_mbits, diff_pattern pattern)
+      : path {(std::filesystem::temp_directory_path() /
+            fmt::format("smashcardloader_bench_{}.raw", size_mbits)).string()},
+        card {GCMemcard::CreateInMemory({}, size_mbits, false, 0, 0, 0)} {
+    save.dir_entry.m_gamecode = {'B', 'N', 'C', 'H'};
+    save.dir_entry.m_makercode = {'0', '1'};
+    save.dir_entry.m_filename.fill(0);
+    std::copy_n("bench", 5, save.dir_entry.m_filename.begin());
+    save.dir_entry.m_block_count = card.GetFreeBlocks();
+    save.blocks.resize(card.GetFreeBlocks());
+
+    mutant_rng engine {0, 0};
+    for (auto& block : save.blocks) engine.Generate(block.m_block.data(), block.m_block.size());
+    changed = save;
+    auto stride = pattern == diff_pattern::sparse ? 1024 : 1;
+    for (auto& block : changed.blocks) {
+      for (std::size_t i = 0; i < block.m_block.size(); i += stride) block.m_block[i] ^= 0xFF;
+    }
+    calculate_diffs(save, changed, diffs);
+
+    if (card.ImportFile(save) != Memcard::GCMemcardImportFileRetVal::SUCCESS ||
+        !card.Save(path)) {
+      throw save_failed(fmt::format(R"(Failed to write benchmark card "{}")", path));
+    }
+  }
+
+  ~bench_card() { File::Delete(path); }
+};
+
+void card_args(benchmark::internal::Benchmark* bench) {
+  for (auto size : card_sizes) bench->Arg(size);
+}
+
+void diff_args(benchmark::internal::Benchmark* bench) {
+  for (auto size : card_sizes) {
+    for (auto pattern : {diff_pattern::sparse, diff_pattern::dense}) {
+      bench->Args({size, static_cast<std::int64_t>(pattern)});
+    }
+  }
+}
+
+auto size_arg(benchmark::State const& state) {
+  return static_cast<std::uint16_t>(state.range(0));
+}
+
+auto pattern_arg(benchmark::State const& state) {
+  return state.range(1) == 0 ? diff_pattern::sparse : diff_pattern::dense;
+}
+
+void card_bytes(benchmark::State& state, GCMemcard const& card) {
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * card.GetSizeBlocks() *
+      Memcard::BLOCK_SIZE);
+}
+
+void BM_Open(benchmark::State& state) {
+  bench_card bench {size_arg(state), diff_pattern::sparse};
+  for (auto _ : state) {
+    auto [error, card] = GCMemcard::Open(bench.path);
+    benchmark::DoNotOptimize(card);
+  }
+  card_bytes(state, bench.card);
+}
+BENCHMARK(BM_Open)->Apply(card_args);
+
+void BM_OpenMapped(benchmark::State& state) {
+  bench_card bench {size_arg(state), diff_pattern::sparse};
+  for (auto _ : state) {
+    auto [error, card] = GCMemcard::OpenMapped(bench.path);
+    benchmark::DoNotOptimize(card);
+  }
+  card_bytes(state, bench.card);
+}
+BENCHMARK(BM_OpenMapped)->Apply(card_args);
+
+void BM_ExportFile(benchmark::State& state) {
+  bench_card bench {size_arg(state), diff_pattern::sparse};
+  for (auto _ : state) benchmark::DoNotOptimize(bench.card.ExportFile(0));
+  card_bytes(state, bench.card);
+}
+BENCHMARK(BM_ExportFile)->Apply(card_args);
+
+void BM_CalculateDiffs(benchmark::State& state) {
+  bench_card bench {size_arg(state), pattern_arg(state)};
+  region_map diffs;
+  for (auto _ : state) {
+    calculate_diffs(bench.save, bench.changed, diffs);
+    benchmark::DoNotOptimize(diffs);
+  }
+  card_bytes(state, bench.card);
+}
+BENCHMARK(BM_CalculateDiffs)->Apply(diff_args);
+
+void BM_ScrambleDiffs(benchmark::State& state) {
+  bench_card bench {size_arg(state), pattern_arg(state)};
+  mutant_options options;
+  options.mutations = 64;
+  mutant_rng engine {0, 0};
+  for (auto _ : state) {
+    scramble_diffs(bench.save, bench.diffs, engine, options);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * options.mutations);
+}
+BENCHMARK(BM_ScrambleDiffs)->Apply(diff_args);
+
+void BM_StoreSaves(benchmark::State& state) {
+  bench_card bench {size_arg(state), diff_pattern::sparse};
+  std::vector saves {bench.changed};
+  for (auto _ : state) {
+    store_saves(bench.card, saves);
+    benchmark::ClobberMemory();
+  }
+  card_bytes(state, bench.card);
+}
+BENCHMARK(BM_StoreSaves)->Apply(card_args);
+
+void BM_FixChecksums(benchmark::State& state) {
+  bench_card bench {size_arg(state), diff_pattern::sparse};
+  for (auto _ : state) benchmark::DoNotOptimize(bench.card.FixChecksums());
+}
+BENCHMARK(BM_FixChecksums)->Apply(card_args);
+
+void BM_Save(benchmark::State& state) {
+  bench_card bench {size_arg(state), diff_pattern::sparse};
+  auto output = bench.path + ".out";
+  for (auto _ : state) {
+    if (!bench.card.Save(output)) state.SkipWithError("Failed to write the card");
+  }
+  File::Delete(output);
+  card_bytes(state, bench.card);
+}
+BENCHMARK(BM_Save)->Apply(card_args);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,429 @@
+/*----- System Includes -----*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*----- Local Includes -----*/
+
+#include "smashcardloader_common.h"
+
+#include "Common/BitSet.h"
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#include "Common/Tracing.h"
+#include "Core/Host.h"
+#include "Core/HW/GCMemcard/GCMemcard.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+/*----- Types -----*/
+
+std::FILE* progress_out = stdout;
+
+/*----- Stage Timings -----*/
+
+std::string_view stage_name(stage which) {
+  switch (which) {
+    case stage::open: return "open";
+    case stage::diff: return "diff";
+    case stage::mutate: return "mutate";
+    case stage::write: return "write";
+    case stage::boot: return "boot";
+    case stage::run: return "run";
+    default: return "unknown";
+  }
+}
+
+stage_totals stage_times;
+
+/*----- Diff Kernels -----*/
+
+namespace {
+
+// Reference implementation, and the fallback for hosts without a vector unit.
+void mask_block_scalar(std::uint8_t const* lhs, std::uint8_t const* rhs, diff_mask& mask) {
+  for (std::size_t word = 0; word < mask.size(); ++word) {
+    std::uint64_t bits = 0;
+    for (std::size_t bit = 0; bit < 64; ++bit) {
+      auto offset = word * 64 + bit;
+      bits |= std::uint64_t {lhs[offset] != rhs[offset]} << bit;
+    }
+    mask[word] = bits;
+  }
+}
+
+#ifdef _M_X86
+void mask_block_sse2(std::uint8_t const* lhs, std::uint8_t const* rhs, diff_mask& mask) {
+  for (std::size_t word = 0; word < mask.size(); ++word) {
+    std::uint64_t bits = 0;
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+      auto offset = word * 64 + lane * 16;
+      auto lhsvec = _mm_loadu_si128(reinterpret_cast<__m128i const*>(lhs + offset));
+      auto rhsvec = _mm_loadu_si128(reinterpret_cast<__m128i const*>(rhs + offset));
+      auto equal = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhsvec, rhsvec)));
+      bits |= std::uint64_t {~equal & 0xFFFF} << (lane * 16);
+    }
+    mask[word] = bits;
+  }
+}
+
+FUNCTION_TARGET_AVX2
+void mask_block_avx2(std::uint8_t const* lhs, std::uint8_t const* rhs, diff_mask& mask) {
+  for (std::size_t word = 0; word < mask.size(); ++word) {
+    std::uint64_t bits = 0;
+    for (std::size_t lane = 0; lane < 2; ++lane) {
+      auto offset = word * 64 + lane * 32;
+      auto lhsvec = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(lhs + offset));
+      auto rhsvec = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(rhs + offset));
+      auto equal = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhsvec, rhsvec)));
+      bits |= std::uint64_t {~equal} << (lane * 32);
+    }
+    mask[word] = bits;
+  }
+}
+#endif
+
+#ifdef _M_ARM_64
+void mask_block_neon(std::uint8_t const* lhs, std::uint8_t const* rhs, diff_mask& mask) {
+  // NEON has no movemask, so weight each lane by its bit and fold with pairwise adds.
+  static constexpr std::uint8_t weights[16] {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  auto const bitvec = vld1q_u8(weights);
+
+  for (std::size_t word = 0; word < mask.size(); ++word) {
+    uint8x16_t lanes[4];
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+      auto offset = word * 64 + lane * 16;
+      auto differs = vmvnq_u8(vceqq_u8(vld1q_u8(lhs + offset), vld1q_u8(rhs + offset)));
+      lanes[lane] = vandq_u8(differs, bitvec);
+    }
+    auto folded = vpaddq_u8(vpaddq_u8(lanes[0], lanes[1]), vpaddq_u8(lanes[2], lanes[3]));
+    folded = vpaddq_u8(folded, folded);
+    mask[word] = vgetq_lane_u64(vreinterpretq_u64_u8(folded), 0);
+  }
+}
+#endif
+
+diff_kernel select_diff_kernel() {
+#if defined(_M_X86)
+  if (cpu_info.bAVX2) return mask_block_avx2;
+  if (cpu_info.bSSE2) return mask_block_sse2;
+#elif defined(_M_ARM_64)
+  if (cpu_info.bASIMD) return mask_block_neon;
+#endif
+  return mask_block_scalar;
+}
+
+// Finds the first bit at or after pos that is set (or clear, if !set).
+std::size_t find_next(diff_mask const& mask, std::size_t pos, bool set) {
+  for (auto word = pos / 64; word < mask.size(); ++word) {
+    auto bits = set ? mask[word] : ~mask[word];
+    if (word == pos / 64) bits &= ~std::uint64_t {0} << (pos % 64);
+    if (bits) return word * 64 + Common::LeastSignificantSetBit(bits);
+  }
+  return Memcard::BLOCK_SIZE;
+}
+
+}
+
+void mask_block(std::uint8_t const* lhs, std::uint8_t const* rhs, diff_mask& mask) {
+  static diff_kernel const kernel = select_diff_kernel();
+  kernel(lhs, rhs, mask);
+}
+
+void mask_block(GCMBlock const& lhs, GCMBlock const& rhs, diff_mask& mask) {
+  mask_block(lhs.m_block.data(), rhs.m_block.data(), mask);
+}
+
+// Appends a block holding the half-open runs of disagreeing bytes in a difference
+// mask. Matches the original std::mismatch walk exactly, including the empty
+// [BLOCK_SIZE, BLOCK_SIZE] range it left behind whenever a block ended in agreement.
+void emit_regions(diff_mask const& mask, region_map& regions) {
+  regions.push_block();
+  std::size_t pos = 0;
+  while (pos != Memcard::BLOCK_SIZE) {
+    auto start = find_next(mask, pos, true);
+    pos = find_next(mask, start, false);
+    regions.push_range(start, pos);
+  }
+}
+/*----- Saves -----*/
+
+// Every save on the card, in directory order.
+std::vector<Savefile> extract_saves(GCMemcard const& card) {
+  if (card.GetNumFiles() == 0) {
+    throw extract_failed("Card does not hold any save files");
+  }
+
+  std::vector<Savefile> saves;
+  saves.reserve(card.GetNumFiles());
+  for (std::uint8_t i = 0; i < card.GetNumFiles(); ++i) {
+    auto save = card.ExportFile(card.GetFileIndex(i));
+    if (!save) {
+      throw extract_failed("Failed to extract save file");
+    }
+    saves.push_back(std::move(*save));
+  }
+  return saves;
+}
+
+// Scrambling never resizes a save, so its blocks go straight back into the existing chain and
+// neither the directory nor the BAT has to be touched. Only a save a journal resized is removed
+// and imported again.
+void store_saves(GCMemcard& card, std::vector<Savefile> const& saves) {
+  for (auto& save : saves) {
+    auto index = card.TitlePresent(save.dir_entry);
+    if (!index) {
+      throw save_failed("Failed to find original save on the card");
+    }
+    if (card.DEntry_BlockCount(*index) != save.blocks.size()) {
+      if (card.RemoveFile(*index) != Memcard::GCMemcardRemoveFileRetVal::SUCCESS ||
+          card.ImportFile(save) != Memcard::GCMemcardImportFileRetVal::SUCCESS) {
+        throw save_failed("Failed to replace resized save");
+      }
+      continue;
+    }
+    auto res = card.OverwriteFileData(*index, save.blocks);
+    if (res != Memcard::GCMemcardOverwriteFileRetVal::SUCCESS) {
+      throw save_failed("Failed to overwrite original save data");
+    }
+  }
+}
+
+// Diffs into an existing map, reusing whatever storage it already holds.
+void calculate_diffs(Savefile const& lhscard, Savefile const& rhscard, region_map& diffs) {
+  TRACE_SPAN("calculate_diffs");
+  stage_timer timer {stage::diff};
+  // Iterate over the blocks of both and diff
+  diffs.clear();
+  diffs.reserve(lhscard.blocks.size(), lhscard.blocks.size());
+  for_all([&diffs] (auto& lhsblock, auto& rhsblock) {
+    diff_mask mask;
+    mask_block(lhsblock, rhsblock, mask);
+    emit_regions(mask, diffs);
+  }, lhscard.blocks, rhscard.blocks);
+}
+
+region_map calculate_diffs(Savefile const& lhscard, Savefile const& rhscard) {
+  region_map diffs;
+  calculate_diffs(lhscard, rhscard, diffs);
+  return diffs;
+}
+
+/*----- Mutants -----*/
+
+std::optional<mutator> parse_mutator(std::string_view name) {
+  if (name == "random") return mutator::random;
+  if (name == "bit-flip") return mutator::bit_flip;
+  if (name == "interesting") return mutator::interesting;
+  if (name == "length") return mutator::length;
+  if (name == "splice") return mutator::splice;
+  return std::nullopt;
+}
+
+namespace {
+
+// Writes the low width bytes of value big endian at offset, as far as the block goes.
+void put_be(GCMBlock& block, std::size_t offset, std::uint32_t value, std::size_t width) {
+  for (std::size_t i = 0; i < width && offset + i < block.m_block.size(); ++i) {
+    block.m_block[offset + i] = static_cast<std::uint8_t>(value >> ((width - 1 - i) * 8));
+  }
+}
+
+std::uint32_t get_be(GCMBlock const& block, std::size_t offset, std::size_t width) {
+  std::uint32_t value = 0;
+  for (std::size_t i = 0; i < width; ++i) {
+    auto at = offset + i;
+    value = value << 8 | (at < block.m_block.size() ? block.m_block[at] : 0);
+  }
+  return value;
+}
+
+// Applies one mutation at offset of the save's block, returning the range of the block it
+// rewrote. donors are the corpus' other copies of the save, for splicing.
+std::pair<std::size_t, std::size_t> apply_mutator(mutator kind, Savefile& save, std::size_t block,
+    std::size_t offset, std::vector<Savefile> const& donors, int chunk_size,
+    mutant_rng& engine) {
+  auto& data = save.blocks[block];
+  auto size = data.m_block.size();
+  if (offset >= size) return {offset, offset};
+  auto pick = [&] (std::size_t count) {
+    return std::uniform_int_distribution<std::size_t>(0, count - 1)(engine);
+  };
+  auto width = [&] { return std::size_t {2} << pick(2); };
+
+  switch (kind) {
+    case mutator::bit_flip:
+      data.m_block[offset] ^= static_cast<std::uint8_t>(1 << pick(8));
+      return {offset, offset + 1};
+
+    case mutator::interesting: {
+      static constexpr std::array<std::uint32_t, 13> values {
+        0, 1, 0x7f, 0x80, 0xff, 0x100, 0x7fff, 0x8000, 0xffff, 0x10000,
+        0x7fffffff, 0x80000000, 0xffffffff
+      };
+      auto bytes = width();
+      put_be(data, offset, values[pick(values.size())], bytes);
+      return {offset, std::min(offset + bytes, size)};
+    }
+
+    case mutator::length: {
+      auto bytes = width();
+      auto value = get_be(data, offset, bytes);
+      auto save_size = static_cast<std::uint32_t>(save.blocks.size() * Memcard::BLOCK_SIZE);
+      std::array<std::uint32_t, 8> boundaries {
+        0, value - 1, value + 1, value * 2, Memcard::BLOCK_SIZE, save_size, save_size + 1,
+        ~std::uint32_t {0}
+      };
+      put_be(data, offset, boundaries[pick(boundaries.size())], bytes);
+      return {offset, std::min(offset + bytes, size)};
+    }
+
+    case mutator::splice:
+      if (!donors.empty()) {
+        auto& donor = donors[pick(donors.size())].blocks[block].m_block;
+        auto end = std::min(offset + chunk_size, size);
+        std::copy(donor.begin() + offset, donor.begin() + end, data.m_block.begin() + offset);
+        return {offset, end};
+      }
+      // Saves only on the base card have no one to splice from
+      [[fallthrough]];
+
+    case mutator::random:
+      break;
+  }
+
+  auto end = std::min(offset + chunk_size, size);
+  engine.Generate(data.m_block.data() + offset, end - offset);
+  return {offset, end};
+}
+
+}
+
+// Mutates save number save of the base card, at sites within the regions its diffs hold.
+void scramble_diffs(Savefile& card, region_map const& diffs, mutant_rng& engine,
+    mutant_options const& options, std::uint16_t save, mutation_journal* journal) {
+  TRACE_SPAN("scramble_diffs");
+  static std::vector<Savefile> const no_donors;
+  auto const& donors = save < options.donors.size() ? options.donors[save] : no_donors;
+  auto mutate = [&] (std::size_t block, std::size_t offset) {
+    auto kind = options.mutators.front();
+    if (options.mutators.size() > 1) {
+      kind = options.mutators[std::uniform_int_distribution<std::size_t>(
+          0, options.mutators.size() - 1)(engine)];
+    }
+    auto [start, end] = apply_mutator(kind, card, block, offset, donors, options.chunk_size,
+        engine);
+    if (journal) {
+      auto& data = card.blocks[block].m_block;
+      journal->records.push_back({save, static_cast<std::uint16_t>(block),
+          static_cast<std::uint16_t>(start), {data.begin() + start, data.begin() + end}});
+    }
+  };
+
+  if (options.weighted) {
+    // Every byte of an eligible region is a site, weighted by how many corpus cards differ there
+    auto const* counts = save < options.counts.size() && !options.counts[save].empty() ?
+        options.counts[save].data() : nullptr;
+    std::vector<std::pair<std::uint32_t, std::uint16_t>> sites;
+    std::vector<std::uint32_t> weights;
+    for_all([&] (auto iteration, auto&, auto& regions) {
+      if (!options.targets.empty() && !options.targets.count(iteration)) return;
+      for (auto& [start, end] : regions) {
+        if (end - start < options.minimum_size) continue;
+        for (auto offset = start; offset < end; ++offset) {
+          sites.emplace_back(static_cast<std::uint32_t>(iteration), offset);
+          weights.push_back(counts ? counts[iteration * Memcard::BLOCK_SIZE + offset] : 1);
+        }
+      }
+    }, card.blocks, diffs);
+    if (sites.empty()) return;
+
+    std::discrete_distribution<std::size_t> pick_site(weights.begin(), weights.end());
+    for (int i = 0; i < options.mutations; ++i) {
+      auto [block, offset] = sites[pick_site(engine)];
+      fmt::println("Executing a weighted corruption on block {}, at {}...", block, offset);
+      mutate(block, offset);
+    }
+    return;
+  }
+
+  // Mutate the blocks
+  int mutation_count = 0;
+  std::uniform_int_distribution<int> rand_offset;
+  using offset_range = std::uniform_int_distribution<int>::param_type;
+  for_all([&] (auto iteration, auto&, auto& regions) {
+    // Skip if given targets
+    if (mutation_count >= options.mutations ||
+        !options.targets.empty() && !options.targets.count(iteration)) {
+      return;
+    }
+
+    fmt::println("Will corrupt block {}...", iteration);
+    for (auto& [start, end] : regions) {
+      if (end - start < options.minimum_size) {
+        continue;
+      }
+
+      if (mutation_count < options.mutations) {
+        fmt::println("Executing a corruption on block {}, between {}-{}...", iteration, start, end);
+        mutate(iteration, rand_offset(engine, offset_range {start, end}));
+        ++mutation_count;
+      } else {
+        fmt::println(progress_out,
+            "Reached maximum number of corruptions, {}, skipping the rest...", options.mutations);
+        break;
+      }
+    }
+  }, card.blocks, diffs);
+}
+
+/*----- Host -----*/
+
+// The core calls back into its frontend through these; the harness has no UI to forward them to.
+std::vector<std::string> Host_GetPreferredLocales() {
+  return {};
+}
+
+bool Host_UIBlocksControllerState() {
+  return false;
+}
+
+bool Host_RendererHasFocus() {
+  return false;
+}
+
+bool Host_RendererHasFullFocus() {
+  return false;
+}
+
+bool Host_RendererIsFullscreen() {
+  return false;
+}
+
+void Host_Message(HostMessageID) {}
+void Host_NotifyMapLoaded() {}
+void Host_RefreshDSPDebuggerWindow() {}
+void Host_RequestRenderWindowSize(int, int) {}
+void Host_UpdateDisasmDialog() {}
+void Host_UpdateMainFrame() {}
+void Host_UpdateTitle(std::string const&) {}
+void Host_YieldToUI() {}
+void Host_TitleChanged() {}
+
+std::unique_ptr<GBAHostInterface> Host_CreateGBAHost(std::weak_ptr<HW::GBA::Core>) {
+  return nullptr;
+}
@@ -0,0 +1,579 @@
+// The memcard pipeline smashcardloader is built on, from opening and diffing saves to scrambling
+// and storing them, and the types the rest of the tool shares. The smashcardloader_common library
+// holds it, so smashcardloader_bench can link against the same code instead of including the tool.
+
+#pragma once
+
+/*----- System Includes -----*/
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/*----- Local Includes -----*/
+
+#include "fmt/include/fmt/core.h"
+#include "fmt/include/fmt/format.h"
+#include "Common/Random.h"
+#include "Core/HW/GCMemcard/GCMemcard.h"
+
+/*----- Types -----*/
+
+// Where progress goes. A machine-readable report written to stdout moves it to stderr, so the
+// report stays parseable.
+extern std::FILE* progress_out;
+
+using Memcard::GCMBlock;
+using Memcard::Savefile;
+using Memcard::GCMemcard;
+using Memcard::GCMemcardErrorCode;
+using Memcard::GCMemcardOpenOptions;
+// Half-open runs of differing bytes for every block of a save, stored flat: one
+// contiguous array of ranges, and an offset per block into it. Offsets inside a
+// block never exceed BLOCK_SIZE, so a range fits in four bytes.
+class region_map {
+public:
+  using range = std::pair<std::uint16_t, std::uint16_t>;
+
+  class block_view {
+  public:
+    block_view(range const* first, range const* last) : first_(first), last_(last) {}
+
+    range const* begin() const { return first_; }
+    range const* end() const { return last_; }
+    std::size_t size() const { return last_ - first_; }
+    bool empty() const { return first_ == last_; }
+
+  private:
+    range const* first_;
+    range const* last_;
+  };
+
+  class iterator {
+  public:
+    iterator(region_map const* map, std::size_t block) : map_(map), block_(block) {}
+
+    block_view operator*() const { return (*map_)[block_]; }
+    iterator& operator++() { ++block_; return *this; }
+    bool operator==(iterator const& other) const { return block_ == other.block_; }
+    bool operator!=(iterator const& other) const { return block_ != other.block_; }
+
+  private:
+    region_map const* map_;
+    std::size_t block_;
+  };
+
+  region_map() : offsets_ {0} {}
+
+  // Drops every block but keeps the storage, so a map can be reused across diffs.
+  void clear() {
+    ranges_.clear();
+    offsets_.resize(1);
+  }
+
+  void reserve(std::size_t blocks, std::size_t ranges) {
+    offsets_.reserve(blocks + 1);
+    ranges_.reserve(ranges);
+  }
+
+  // Opens a new block; ranges pushed afterwards belong to it.
+  void push_block() { offsets_.push_back(ranges_.size()); }
+
+  void push_range(std::size_t start, std::size_t end) {
+    ranges_.emplace_back(static_cast<std::uint16_t>(start), static_cast<std::uint16_t>(end));
+    ++offsets_.back();
+  }
+
+  std::size_t size() const { return offsets_.size() - 1; }
+  std::size_t range_count() const { return ranges_.size(); }
+
+  block_view operator[](std::size_t block) const {
+    auto* base = ranges_.data();
+    return {base + offsets_[block], base + offsets_[block + 1]};
+  }
+
+  iterator begin() const { return {this, 0}; }
+  iterator end() const { return {this, size()}; }
+
+private:
+  std::vector<range> ranges_;
+  std::vector<std::uint32_t> offsets_;
+};
+
+// One bit per byte of a block, set wherever the two blocks disagree.
+using diff_mask = std::array<std::uint64_t, Memcard::BLOCK_SIZE / 64>;
+using diff_kernel = void (*)(std::uint8_t const*, std::uint8_t const*, diff_mask&);
+
+struct corpus_diffs {
+  // Union of every card's differences from the base card, per block.
+  region_map regions;
+
+  // Per block, whether any card in the corpus disagrees with the base card.
+  std::vector<std::uint8_t> varies;
+
+  // How many cards disagree with the base card at each offset, BLOCK_SIZE entries per block.
+  std::vector<std::uint32_t> counts;
+};
+
+struct extract_failed : std::runtime_error {
+  extract_failed(std::string const& msg) : std::runtime_error(msg) {}
+};
+
+struct save_failed : std::runtime_error {
+  save_failed(std::string const& msg) : std::runtime_error(msg) {}
+};
+
+struct journal_failed : std::runtime_error {
+  journal_failed(std::string const& msg) : std::runtime_error(msg) {}
+};
+
+struct delta_failed : std::runtime_error {
+  delta_failed(std::string const& msg) : std::runtime_error(msg) {}
+};
+
+struct profile_failed : std::runtime_error {
+  profile_failed(std::string const& msg) : std::runtime_error(msg) {}
+};
+
+// One corruption scramble_diffs applied: the bytes written at an offset of a save block.
+// Saves are numbered in the base card's directory order.
+struct mutation_record {
+  std::uint16_t save;
+  std::uint16_t block;
+  std::uint16_t offset;
+  std::vector<std::uint8_t> bytes;
+};
+
+// Everything needed to rebuild a mutant from its base card, in a few bytes per edit.
+struct mutation_journal {
+  std::uint64_t seed = 0;
+  std::uint64_t index = 0;
+  std::vector<mutation_record> records;
+};
+
+// What a single mutation does to the site scramble_diffs picked.
+enum class mutator {
+  // Overwrite chunk_size bytes with random ones.
+  random,
+  // Flip a single bit.
+  bit_flip,
+  // Write a big endian u16 or u32 from the values parsers tend to mishandle.
+  interesting,
+  // Read a big endian u16 or u32 as a length, and push it to a boundary.
+  length,
+  // Copy chunk_size bytes from the same place of another corpus card's copy of the save.
+  splice
+};
+
+// Remembers the hash of every mutant generated so far, so that duplicates can be skipped. Nearly
+// every mutant is new, and a scalable Bloom filter, small enough to stay in cache, tells so
+// without touching the much larger set of exact hashes. The set only settles the filter's false
+// positives, so a new mutant is never skipped. Shared by every thread generating mutants.
+class mutant_filter {
+public:
+  // Returns whether the hash is new, remembering it if it is.
+  bool insert(std::uint64_t hash) {
+    std::lock_guard lock {mutex_};
+    ++checked_;
+    if (maybe_contains(hash) && exact_.count(hash)) {
+      ++duplicates_;
+      return false;
+    }
+    if (layers_.empty() || layers_.back().size == layers_.back().capacity) grow();
+    auto& layer = layers_.back();
+    for_each_bit(layer, hash, [&] (std::size_t bit) {
+      layer.words[bit / 64] |= std::uint64_t {1} << (bit % 64);
+    });
+    ++layer.size;
+    exact_.insert(hash);
+    return true;
+  }
+
+  // For filters elsewhere, like in the worker processes, whose decisions are tallied here.
+  void count(bool duplicate) {
+    std::lock_guard lock {mutex_};
+    ++checked_;
+    duplicates_ += duplicate;
+  }
+
+  void print_summary() const {
+    std::lock_guard lock {mutex_};
+    if (checked_ == 0) return;
+    fmt::print(progress_out, "Skipped {} of {} mutants as duplicates ({:.1f}%)\n", duplicates_,
+        checked_, 100.0 * duplicates_ / checked_);
+  }
+
+private:
+  // Every layer has twice the bits of the one before and probes one more of them per hash, so
+  // the false positive rate stays bounded however many mutants there are.
+  struct layer {
+    std::vector<std::uint64_t> words;
+    unsigned probes;
+    std::size_t capacity;
+    std::size_t size = 0;
+  };
+
+  static constexpr std::size_t first_layer_bits = 1 << 20;
+  static constexpr std::size_t bits_per_hash = 16;
+  static constexpr unsigned first_layer_probes = 8;
+
+  void grow() {
+    auto bits = layers_.empty() ? first_layer_bits : layers_.back().words.size() * 128;
+    auto probes = first_layer_probes + static_cast<unsigned>(layers_.size());
+    layers_.push_back({std::vector<std::uint64_t>(bits / 64), probes, bits / bits_per_hash});
+  }
+
+  // Double hashing, with the hash as the start and its upper half, made odd, as the stride.
+  template <class F>
+  static void for_each_bit(layer const& layer, std::uint64_t hash, F&& func) {
+    auto mask = layer.words.size() * 64 - 1;
+    auto stride = (hash >> 32) | 1;
+    for (unsigned i = 0; i < layer.probes; ++i, hash += stride) func(hash & mask);
+  }
+
+  bool maybe_contains(std::uint64_t hash) const {
+    for (auto& layer : layers_) {
+      bool all = true;
+      for_each_bit(layer, hash, [&] (std::size_t bit) {
+        all &= (layer.words[bit / 64] >> (bit % 64) & 1) != 0;
+      });
+      if (all) return true;
+    }
+    return false;
+  }
+
+  mutable std::mutex mutex_;
+  std::vector<layer> layers_;
+  std::unordered_set<std::uint64_t> exact_;
+  std::uint64_t checked_ = 0;
+  std::uint64_t duplicates_ = 0;
+};
+
+// How every mutant of a run is produced and written.
+struct mutant_options {
+  std::unordered_set<int> targets;
+
+  // Every save is scrambled on its own, so each gets the full budget.
+  int mutations = 1;
+  int chunk_size = 1;
+  int minimum_size = 1;
+
+  // Each mutation picks one of these uniformly.
+  std::vector<mutator> mutators {mutator::random};
+
+  // Draw sites in proportion to how many corpus cards differ there, instead of walking the
+  // regions in order.
+  bool weighted = false;
+
+  // Per base save, its corpus_diffs counts and the other corpus cards' copies of it. Both are
+  // empty without a corpus.
+  std::vector<std::vector<std::uint32_t>> counts;
+  std::vector<std::vector<Savefile>> donors;
+
+  // Draw from Common::Random::PRNG instead of the fast generator, for a cryptographic stream
+  // that's still reproducible from the seed.
+  bool crypto_random = false;
+
+  // Also write "<output>.journal" next to each mutant.
+  bool journal = false;
+
+  // Write only the card blocks that differ from the base card, whose image hashes to base_hash.
+  bool delta = false;
+  std::uint64_t base_hash = 0;
+
+  // Run the registered save fixups over every scrambled save, for a card with this header, so
+  // mutants get past the game's own integrity checks.
+  Memcard::Header const* fixup_header = nullptr;
+
+  // Skip mutants identical to one generated before, neither writing nor running them again.
+  mutant_filter* dedup = nullptr;
+};
+
+// How a card is booted and judged by the in-process harness.
+struct run_options {
+  std::string iso;
+  std::uint64_t frames = 3600;
+
+  // Wall clock time the game may go without finishing a frame before it counts as hung.
+  std::chrono::seconds hang_timeout {10};
+
+  // Where snapshot runs pause the game to snapshot it: after a number of frames, or at the
+  // first time the CPU reaches an address. frames then counts from the snapshot.
+  std::uint64_t snapshot_frame = 0;
+  std::optional<std::uint32_t> snapshot_pc;
+
+  // Have the JIT record which blocks each run executes.
+  bool coverage = false;
+
+  // Where to save the state from a few seconds before the game failed, to watch the failure
+  // happen in Dolphin. Nothing is kept to rewind to without one.
+  std::string failure_state;
+};
+
+// Ordered by severity; the value doubles as the exit code of the run command.
+enum class run_outcome {
+  clean,
+  panic,
+  exception,
+  hang,
+  boot_failed,
+  // The worker process running the mutant died, taking the harness with it.
+  crashed
+};
+
+struct run_result {
+  run_outcome outcome = run_outcome::clean;
+  std::uint64_t frames = 0;
+  std::string detail;
+
+  // Coverage map entries the run hit, and how many of those no earlier run of the batch did.
+  std::uint32_t coverage = 0;
+  std::uint32_t new_coverage = 0;
+
+  // Emulated frames per wall-clock second while the game ran.
+  double fps = 0;
+};
+
+template <class T, class U>
+using forward_like_t = std::conditional_t<
+  std::is_lvalue_reference_v<T>,
+  std::remove_reference_t<U>&,
+  std::remove_reference_t<U>&&
+>;
+
+/*----- Helpers -----*/
+
+// Monkey patch something I think should exist to start with
+namespace fmt {
+  template <class Ptr, class Str, class... Args>
+  void println(Ptr* stream, Str const& str, Args&&... args) {
+    auto newline = str + std::string {"\n"};
+    print(stream, newline, std::forward<Args>(args)...);
+  }
+
+  template <class Str, class... Args>
+  void println(Str const& str, Args&&... args) {
+    println(progress_out, str, std::forward<Args>(args)...);
+  }
+}
+
+template <class F, class... Args>
+bool any_of(F&& func, Args&&... args) {
+  return (std::forward<F>(func)(std::forward<Args>(args)) || ...);
+}
+
+template <class F, class... Args>
+bool none_of(F&& func, Args&&... args) {
+  return !any_of(std::forward<F>(func), std::forward<Args>(args)...);
+}
+
+template <class F, class... Args>
+bool all_of(F&& func, Args&&... args) {
+  return (std::forward<F>(func)(std::forward<Args>(args)) && ...);
+}
+
+template <class F, class... Args>
+bool some_of(F&& func, Args&&... args) {
+  return !all_of(std::forward<F>(func), std::forward<Args>(args)...);
+}
+
+template <class T, class U>
+forward_like_t<T, U> forward_like(U&& val) noexcept {
+  return static_cast<forward_like_t<T, U>>(val);
+}
+
+template <class F, class C, class... Cs>
+void for_all(F&& func, C&& container, Cs&&... cs) {
+  // Make sure everything is the same size.
+  assert(all_of([] (auto& cont) { cont.size() == container.size(); }, cs...));
+
+  // Collect and explode into iterators
+  std::size_t count = 0;
+  std::tuple iterators {container.begin(), cs.begin()...};
+  while (std::get<0>(iterators) != container.end()) {
+    std::apply([&func, &count] (auto& it, auto&... its) {
+      // Compute whether our callable would like an explicit count
+      constexpr bool takes_count = std::is_invocable_v<
+        F,
+        std::size_t,
+        forward_like_t<C, decltype(*it)>,
+        forward_like_t<Cs, decltype(*its)>...
+      >;
+
+      // Deference everything and call
+      if constexpr (takes_count) {
+        std::forward<F>(func)(count, forward_like<C>(*it), forward_like<Cs>(*its)...);
+      } else {
+        std::forward<F>(func)(forward_like<C>(*it), forward_like<Cs>(*its)...);
+      }
+
+      // Increment
+      ++count;
+      ++it, (++its, ...);
+    }, iterators);
+  }
+}
+
+/*----- Stage Timings -----*/
+
+// The stages a mutant goes through, from opening the base card to running the game with it.
+enum class stage { open, diff, mutate, write, boot, run, count };
+
+std::string_view stage_name(stage which);
+
+// Time spent in each stage by this process, for --stats. Stages running on several jobs at once
+// add up across them, so they can exceed the wall time.
+struct stage_totals {
+  static constexpr auto count = static_cast<std::size_t>(stage::count);
+  std::array<std::atomic<std::uint64_t>, count> nanoseconds {};
+  std::array<std::atomic<std::uint64_t>, count> calls {};
+};
+
+extern stage_totals stage_times;
+
+// Adds the time until it goes out of scope to a stage.
+class stage_timer {
+public:
+  explicit stage_timer(stage which) : which_ {which}, start_ {std::chrono::steady_clock::now()} {}
+
+  ~stage_timer() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    auto index = static_cast<std::size_t>(which_);
+    stage_times.nanoseconds[index].fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+        std::memory_order_relaxed);
+    stage_times.calls[index].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  stage_timer(stage_timer const&) = delete;
+  stage_timer& operator=(stage_timer const&) = delete;
+
+private:
+  stage which_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/*----- Diff Kernels -----*/
+
+// Sets the bits of mask wherever the blocks disagree, with the fastest kernel the host has.
+void mask_block(std::uint8_t const* lhs, std::uint8_t const* rhs, diff_mask& mask);
+void mask_block(GCMBlock const& lhs, GCMBlock const& rhs, diff_mask& mask);
+
+// Appends a block holding the half-open runs of disagreeing bytes in a difference
+// mask. Matches the original std::mismatch walk exactly, including the empty
+// [BLOCK_SIZE, BLOCK_SIZE] range it left behind whenever a block ended in agreement.
+void emit_regions(diff_mask const& mask, region_map& regions);
+
+/*----- Saves -----*/
+
+// Every save on the card, in directory order.
+std::vector<Savefile> extract_saves(GCMemcard const& card);
+
+// Scrambling never resizes a save, so its blocks go straight back into the existing chain and
+// neither the directory nor the BAT has to be touched. Only a save a journal resized is removed
+// and imported again.
+void store_saves(GCMemcard& card, std::vector<Savefile> const& saves);
+
+// Diffs into an existing map, reusing whatever storage it already holds.
+void calculate_diffs(Savefile const& lhscard, Savefile const& rhscard, region_map& diffs);
+region_map calculate_diffs(Savefile const& lhscard, Savefile const& rhscard);
+
+/*----- Mutants -----*/
+
+// The random stream of a mutant: xoshiro256++, which is cheap enough for the scrambler's hot loop
+// and fills eight bytes per draw, or Common::Random::PRNG when a cryptographic stream is asked
+// for. Either way it's a standard random bit generator, so it works with the distributions.
+class mutant_rng {
+public:
+  using result_type = std::uint64_t;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  // Every mutant draws from its own stream derived from the master seed and its index,
+  // so output never depends on how mutants were spread across threads.
+  mutant_rng(std::uint64_t seed, std::uint64_t index, bool crypto = false)
+      : state_ {seed_state(seed, index)} {
+    if (!crypto) return;
+    std::array<std::uint64_t, 2> key {seed, index};
+    crypto_ = std::make_unique<Common::Random::PRNG>(key.data(), sizeof(key));
+  }
+
+  result_type operator()() {
+    if (crypto_) return crypto_->GenerateValue<result_type>();
+
+    auto result = rotl(state_[0] + state_[3], 23) + state_[0];
+    auto t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+  // Fills size bytes with random ones.
+  void Generate(void* buffer, std::size_t size) {
+    if (crypto_) {
+      crypto_->Generate(buffer, size);
+      return;
+    }
+    auto* bytes = static_cast<std::uint8_t*>(buffer);
+    for (; size >= sizeof(result_type); bytes += sizeof(result_type), size -= sizeof(result_type)) {
+      auto value = (*this)();
+      std::memcpy(bytes, &value, sizeof(value));
+    }
+    if (size) {
+      auto value = (*this)();
+      std::memcpy(bytes, &value, size);
+    }
+  }
+
+private:
+  static std::array<std::uint64_t, 4> seed_state(std::uint64_t seed, std::uint64_t index) {
+    std::seed_seq sequence {
+      static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+      static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32)
+    };
+    std::array<std::uint32_t, 8> words;
+    sequence.generate(words.begin(), words.end());
+    std::array<std::uint64_t, 4> state;
+    for (std::size_t i = 0; i < state.size(); ++i) {
+      state[i] = std::uint64_t {words[i * 2]} << 32 | words[i * 2 + 1];
+    }
+    // The all zero state would never leave zero
+    if (std::all_of(state.begin(), state.end(), [] (auto word) { return word == 0; })) state[0] = 1;
+    return state;
+  }
+
+  static std::uint64_t rotl(std::uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+  std::array<std::uint64_t, 4> state_;
+  std::unique_ptr<Common::Random::PRNG> crypto_;
+};
+
+std::optional<mutator> parse_mutator(std::string_view name);
+
+// Mutates save number save of the base card, at sites within the regions its diffs hold.
+void scramble_diffs(Savefile& card, region_map const& diffs, mutant_rng& engine,
+    mutant_options const& options, std::uint16_t save = 0, mutation_journal* journal = nullptr);